@@ -3,6 +3,26 @@
  */
 #include "../demo.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the pair type for checking the stable sort
+typedef struct __tb_sort_pair_t
+{
+    // the key
+    tb_size_t       key;
+
+    // the inserted index
+    tb_size_t       index;
+
+}tb_sort_pair_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * declaration
+ */
+TB_TYPED_SORT_DECL(tb_sort_typed_long, tb_long_t, tb_typed_less)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * test
  */
@@ -35,6 +55,218 @@ static tb_void_t tb_sort_int_test_perf(tb_size_t n)
     // free
     tb_free(data);
 }
+static tb_void_t tb_sort_int_test_perf_typed(tb_size_t n)
+{
+    __tb_volatile__ tb_size_t i = 0;
+
+    // init data
+    tb_long_t* data = (tb_long_t*)tb_nalloc0(n, sizeof(tb_long_t));
+    tb_assert_and_check_return(data);
+
+    // make
+    for (i = 0; i < n; i++) data[i] = tb_random_range(TB_MINS16, TB_MAXS16);
+
+    // sort
+    tb_hong_t time = tb_mclock();
+    tb_sort_typed_long_sort(data, n);
+    time = tb_mclock() - time;
+
+    // time
+    tb_trace_i("tb_sort_typed_long: %lld ms", time);
+
+    // check
+    for (i = 1; i < n; i++) tb_assert_and_check_break(data[i - 1] <= data[i]);
+
+    // free
+    tb_free(data);
+}
+static tb_void_t tb_sort_int_test_func_typed()
+{
+    // init
+    __tb_volatile__ tb_size_t i = 0;
+    __tb_volatile__ tb_size_t n = 1000;
+
+    // init data
+    tb_long_t* data = (tb_long_t*)tb_nalloc0(n, sizeof(tb_long_t));
+    tb_assert_and_check_return(data);
+
+    // the sorted, reversed, equal and random data
+    for (i = 0; i < n; i++) data[i] = i;
+    tb_sort_typed_long_sort(data, n);
+    for (i = 1; i < n; i++) tb_assert_and_check_break(data[i - 1] <= data[i]);
+    for (i = 0; i < n; i++) data[i] = n - i;
+    tb_sort_typed_long_sort(data, n);
+    for (i = 1; i < n; i++) tb_assert_and_check_break(data[i - 1] <= data[i]);
+    for (i = 0; i < n; i++) data[i] = 7;
+    tb_sort_typed_long_sort(data, n);
+    for (i = 1; i < n; i++) tb_assert_and_check_break(data[i - 1] <= data[i]);
+    for (i = 0; i < n; i++) data[i] = tb_random_range(0, 10);
+    tb_sort_typed_long_sort(data, n);
+    for (i = 1; i < n; i++) tb_assert_and_check_break(data[i - 1] <= data[i]);
+
+    // trace
+    for (i = 0; i < 20; i++) tb_trace_i("data[%lu]: %ld", i, data[i]);
+
+    // free
+    tb_free(data);
+}
+static tb_void_t tb_sort_int_test_perf_intro(tb_size_t n)
+{
+    __tb_volatile__ tb_size_t i = 0;
+
+    // init data
+    tb_long_t* data = (tb_long_t*)tb_nalloc0(n, sizeof(tb_long_t));
+    tb_assert_and_check_return(data);
+    
+    // init iterator
+    tb_array_iterator_t array_iterator;
+    tb_iterator_ref_t   iterator = tb_iterator_make_for_long(&array_iterator, data, n);
+
+    // make
+    for (i = 0; i < n; i++) data[i] = tb_random_range(TB_MINS16, TB_MAXS16);
+
+    // sort
+    tb_hong_t time = tb_mclock();
+    tb_intro_sort_all(iterator, tb_null);
+    time = tb_mclock() - time;
+
+    // time
+    tb_trace_i("tb_intro_sort_int_all: %lld ms", time);
+
+    // check
+    for (i = 1; i < n; i++) tb_assert_and_check_break(data[i - 1] <= data[i]);
+
+    // sort the sorted and reversed data
+    time = tb_mclock();
+    tb_intro_sort_all(iterator, tb_null);
+    for (i = 0; i < (n >> 1); i++) 
+    {
+        tb_long_t t = data[i];
+        data[i] = data[n - i - 1];
+        data[n - i - 1] = t;
+    }
+    tb_intro_sort_all(iterator, tb_null);
+    time = tb_mclock() - time;
+
+    // time
+    tb_trace_i("tb_intro_sort_int_all: sorted and reversed: %lld ms", time);
+
+    // check
+    for (i = 1; i < n; i++) tb_assert_and_check_break(data[i - 1] <= data[i]);
+
+    // free
+    tb_free(data);
+}
+static tb_void_t tb_sort_int_test_perf_parallel(tb_size_t n)
+{
+    __tb_volatile__ tb_size_t i = 0;
+
+    // init data
+    tb_long_t* data = (tb_long_t*)tb_nalloc0(n, sizeof(tb_long_t));
+    tb_assert_and_check_return(data);
+    
+    // init iterator
+    tb_array_iterator_t array_iterator;
+    tb_iterator_ref_t   iterator = tb_iterator_make_for_long(&array_iterator, data, n);
+
+    // make
+    for (i = 0; i < n; i++) data[i] = tb_random_range(TB_MINS16, TB_MAXS16);
+
+    // sort
+    tb_hong_t time = tb_mclock();
+    tb_parallel_sort_all(iterator, tb_null, tb_null);
+    time = tb_mclock() - time;
+
+    // time
+    tb_trace_i("tb_parallel_sort_int_all: %lld ms, processors: %lu", time, tb_processor_count());
+
+    // check
+    for (i = 1; i < n; i++) tb_assert_and_check_break(data[i - 1] <= data[i]);
+
+    // free
+    tb_free(data);
+}
+static tb_void_t tb_sort_int_test_perf_list(tb_size_t n)
+{
+    __tb_volatile__ tb_size_t i = 0;
+
+    // init list
+    tb_list_ref_t list = tb_list_init(0, tb_element_long());
+    tb_assert_and_check_return(list);
+
+    // make
+    for (i = 0; i < n; i++) tb_list_insert_tail(list, (tb_pointer_t)tb_random_range(TB_MINS16, TB_MAXS16));
+
+    // sort
+    tb_hong_t time = tb_mclock();
+    tb_sort_all(list, tb_null);
+    time = tb_mclock() - time;
+
+    // time
+    tb_trace_i("tb_sort_list_int_all: %lld ms", time);
+
+    // check
+    tb_long_t prev = TB_MINS32;
+    tb_for_all (tb_long_t, item, list)
+    {
+        tb_assert_and_check_break(prev <= item);
+        prev = item;
+    }
+
+    // exit list
+    tb_list_exit(list);
+}
+static tb_long_t tb_sort_pair_comp(tb_iterator_ref_t iterator, tb_cpointer_t litem, tb_cpointer_t ritem)
+{
+    // check
+    tb_assert(litem && ritem);
+
+    // only compare the key
+    tb_size_t lkey = ((tb_sort_pair_t const*)litem)->key;
+    tb_size_t rkey = ((tb_sort_pair_t const*)ritem)->key;
+    return lkey < rkey? -1 : (lkey > rkey);
+}
+static tb_void_t tb_sort_int_test_func_merge()
+{
+    // init
+    __tb_volatile__ tb_size_t i = 0;
+    __tb_volatile__ tb_size_t n = 1000;
+
+    // init list
+    tb_single_list_ref_t list = tb_single_list_init(0, tb_element_mem(sizeof(tb_sort_pair_t), tb_null, tb_null));
+    tb_assert_and_check_return(list);
+
+    // make
+    tb_sort_pair_t pair;
+    for (i = 0; i < n; i++) 
+    {
+        pair.key    = tb_random_range(0, 10);
+        pair.index  = i;
+        tb_single_list_insert_tail(list, &pair);
+    }
+
+    // sort
+    tb_merge_sort_all(list, tb_sort_pair_comp);
+
+    // check: the items with the same key are kept in the inserted order
+    tb_sort_pair_t const* prev = tb_null;
+    tb_for_all (tb_sort_pair_t const*, item, list)
+    {
+        tb_assert_and_check_break(!prev || prev->key < item->key || (prev->key == item->key && prev->index < item->index));
+        prev = item;
+    }
+
+    // trace
+    i = 0;
+    tb_for_all (tb_sort_pair_t const*, sorted, list)
+    {
+        tb_trace_i("key: %lu, index: %lu", sorted->key, sorted->index);
+        if (++i >= 20) break;
+    }
+
+    // exit list
+    tb_single_list_exit(list);
+}
 static tb_void_t tb_sort_int_test_perf_bubble(tb_size_t n)
 {
     __tb_volatile__ tb_size_t i = 0;
@@ -485,6 +717,8 @@ tb_int_t tb_demo_algorithm_sort_main(tb_int_t argc, tb_char_t** argv)
     tb_sort_int_test_func_quick();
     tb_sort_int_test_func_bubble();
     tb_sort_int_test_func_insert();
+    tb_sort_int_test_func_typed();
+    tb_sort_int_test_func_merge();
 
     // perf
     tb_sort_int_test_perf(1000);
@@ -492,6 +726,11 @@ tb_int_t tb_demo_algorithm_sort_main(tb_int_t argc, tb_char_t** argv)
     tb_sort_int_test_perf_quick(1000);
     tb_sort_int_test_perf_bubble(1000);
     tb_sort_int_test_perf_insert(1000);
+    tb_sort_int_test_perf(1000000);
+    tb_sort_int_test_perf_typed(1000000);
+    tb_sort_int_test_perf_intro(1000000);
+    tb_sort_int_test_perf_parallel(1000000);
+    tb_sort_int_test_perf_list(1000000);
     tb_sort_str_test_perf(1000);
     tb_sort_str_test_perf_heap(1000);
     tb_sort_str_test_perf_quick(1000);
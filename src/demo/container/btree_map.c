@@ -0,0 +1,408 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+#ifdef __tb_debug__
+#   define tb_btree_map_test_dump(h)         tb_btree_map_dump(h)
+#else
+#   define tb_btree_map_test_dump(h)
+#endif
+
+// the test items count
+#define TB_BTREE_MAP_TEST_MAXN              (4096)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_bool_t tb_btree_map_test_check(tb_btree_map_ref_t tree, tb_byte_t const* exists, tb_size_t maxn)
+{
+    // check the items order and count
+    tb_size_t i = 0;
+    tb_size_t size = 0;
+    tb_for_all_if (tb_btree_map_item_ref_t, item, tree, item)
+    {
+        // skip the removed names
+        tb_size_t name = (tb_size_t)item->name;
+        while (i < maxn && !exists[i]) i++;
+        if (name != i || (tb_size_t)item->data != name * 10) return tb_false;
+        i++;
+        size++;
+    }
+    while (i < maxn && !exists[i]) i++;
+    if (i != maxn || size != tb_btree_map_size(tree)) return tb_false;
+
+    // check the reverse order
+    tb_size_t last = maxn;
+    tb_rfor_all (tb_btree_map_item_ref_t, ritem, tree)
+    {
+        if ((tb_size_t)ritem->name >= last) return tb_false;
+        last = (tb_size_t)ritem->name;
+        size--;
+    }
+    return !size;
+}
+static tb_bool_t tb_btree_map_test_pred(tb_iterator_ref_t iterator, tb_cpointer_t item, tb_cpointer_t value)
+{
+    return !((tb_size_t)((tb_btree_map_item_ref_t)item)->name % (tb_size_t)value);
+}
+static tb_size_t tb_btree_map_test_vector_bound(tb_vector_ref_t vector, tb_long_t name)
+{
+    // find the first item which is not less than the given name
+    tb_long_t const*    data = (tb_long_t const*)tb_vector_data(vector);
+    tb_size_t           l = 0;
+    tb_size_t           r = tb_vector_size(vector);
+    while (l < r)
+    {
+        tb_size_t m = (l + r) >> 1;
+        if (data[m] < name) l = m + 1;
+        else r = m;
+    }
+    return l;
+}
+static tb_void_t tb_btree_map_test_i2i_func(tb_size_t node_size)
+{
+    // init tree
+    tb_btree_map_ref_t tree = tb_btree_map_init(node_size, tb_element_size(), tb_element_size());
+    tb_assert_and_check_return(tree);
+
+    // init exists
+    tb_byte_t exists[TB_BTREE_MAP_TEST_MAXN] = {0};
+
+    // done
+    tb_bool_t ok = tb_false;
+    do
+    {
+        // insert the random items
+        tb_size_t i = 0;
+        tb_random_seed(0x1234);
+        for (i = 0; i < TB_BTREE_MAP_TEST_MAXN * 2; i++)
+        {
+            tb_size_t name = (tb_size_t)tb_random_range(0, TB_BTREE_MAP_TEST_MAXN);
+            tb_size_t itor = tb_btree_map_insert(tree, (tb_pointer_t)name, (tb_pointer_t)(name * 10));
+            tb_assert_and_check_break(itor && (tb_size_t)((tb_btree_map_item_ref_t)tb_iterator_item(tree, itor))->name == name);
+            exists[name] = 1;
+        }
+        tb_assert_and_check_break(i == TB_BTREE_MAP_TEST_MAXN * 2);
+        tb_assert_and_check_break(tb_btree_map_test_check(tree, exists, TB_BTREE_MAP_TEST_MAXN));
+
+        // get and bound
+        for (i = 0; i < TB_BTREE_MAP_TEST_MAXN; i++)
+        {
+            tb_size_t lower = tb_btree_map_lower_bound(tree, (tb_pointer_t)i);
+            tb_size_t upper = tb_btree_map_upper_bound(tree, (tb_pointer_t)i);
+            if (exists[i])
+            {
+                tb_assert_and_check_break((tb_size_t)tb_btree_map_get(tree, (tb_pointer_t)i) == i * 10);
+                tb_assert_and_check_break(lower == tb_btree_map_find(tree, (tb_pointer_t)i) && upper == tb_iterator_next(tree, lower));
+            }
+            else
+            {
+                tb_assert_and_check_break(!tb_btree_map_find(tree, (tb_pointer_t)i) && lower == upper);
+                tb_assert_and_check_break(lower == tb_iterator_tail(tree) || (tb_size_t)((tb_btree_map_item_ref_t)tb_iterator_item(tree, lower))->name > i);
+            }
+        }
+        tb_assert_and_check_break(i == TB_BTREE_MAP_TEST_MAXN);
+
+        // remove the random items
+        for (i = 0; i < TB_BTREE_MAP_TEST_MAXN; i++)
+        {
+            tb_size_t name = (tb_size_t)tb_random_range(0, TB_BTREE_MAP_TEST_MAXN);
+            tb_btree_map_remove(tree, (tb_pointer_t)name);
+            exists[name] = 0;
+        }
+        tb_assert_and_check_break(tb_btree_map_test_check(tree, exists, TB_BTREE_MAP_TEST_MAXN));
+
+        // remove range
+        tb_size_t removed = 0;
+        for (i = 1000; i < 3000; i++) if (exists[i]) { exists[i] = 0; removed++; }
+        tb_assert_and_check_break(tb_btree_map_remove_range(tree, (tb_pointer_t)1000, (tb_pointer_t)3000) == removed);
+        tb_assert_and_check_break(tb_btree_map_test_check(tree, exists, TB_BTREE_MAP_TEST_MAXN));
+
+        // remove items by the iterator
+        tb_remove_if(tree, tb_btree_map_test_pred, (tb_cpointer_t)3);
+        for (i = 0; i < TB_BTREE_MAP_TEST_MAXN; i += 3) exists[i] = 0;
+        tb_assert_and_check_break(tb_btree_map_test_check(tree, exists, TB_BTREE_MAP_TEST_MAXN));
+
+        // load the sorted items
+        tb_btree_map_item_t items[TB_BTREE_MAP_TEST_MAXN];
+        for (i = 0; i < TB_BTREE_MAP_TEST_MAXN; i++)
+        {
+            items[i].name = (tb_pointer_t)i;
+            items[i].data = (tb_pointer_t)(i * 10);
+            exists[i] = 1;
+        }
+        tb_assert_and_check_break(tb_btree_map_load(tree, items, TB_BTREE_MAP_TEST_MAXN));
+        tb_assert_and_check_break(tb_btree_map_test_check(tree, exists, TB_BTREE_MAP_TEST_MAXN));
+
+        // remove all items one by one
+        for (i = 0; i < TB_BTREE_MAP_TEST_MAXN; i += 2) tb_btree_map_remove(tree, (tb_pointer_t)i);
+        for (i = 1; i < TB_BTREE_MAP_TEST_MAXN; i += 2) tb_btree_map_remove(tree, (tb_pointer_t)i);
+        tb_assert_and_check_break(!tb_btree_map_size(tree) && !tb_btree_map_height(tree) && tb_iterator_head(tree) == tb_iterator_tail(tree));
+
+        // append items
+        for (i = 0; i < TB_BTREE_MAP_TEST_MAXN; i++) tb_btree_map_insert(tree, (tb_pointer_t)i, (tb_pointer_t)(i * 10));
+        tb_assert_and_check_break(tb_btree_map_test_check(tree, exists, TB_BTREE_MAP_TEST_MAXN));
+        tb_assert_and_check_break(tb_btree_map_maxn(tree) - tb_btree_map_size(tree) < tb_btree_map_maxn(tree) / 8);
+
+        // remove all items
+        tb_assert_and_check_break(tb_btree_map_remove_range(tree, (tb_pointer_t)0, (tb_pointer_t)TB_BTREE_MAP_TEST_MAXN) == TB_BTREE_MAP_TEST_MAXN);
+        tb_assert_and_check_break(!tb_btree_map_size(tree) && !tb_btree_map_height(tree));
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // trace
+    tb_trace_i("i2i: node: %lu: %s", node_size, ok? "ok" : "failed");
+
+    // exit tree
+    tb_btree_map_exit(tree);
+}
+static tb_void_t tb_btree_map_test_s2i_func()
+{
+    // init tree
+    tb_btree_map_ref_t tree = tb_btree_map_init(64, tb_element_str(tb_true), tb_element_long());
+    tb_assert_and_check_return(tree);
+
+    // insert items
+    tb_size_t i = 0;
+    tb_char_t name[64];
+    for (i = 0; i < 1000; i++)
+    {
+        tb_snprintf(name, sizeof(name), "name_%04lu", (i * 7) % 1000);
+        tb_btree_map_insert(tree, name, (tb_pointer_t)((i * 7) % 1000));
+    }
+    tb_btree_map_insert(tree, "name_0500", (tb_pointer_t)500);
+
+    // remove items
+    tb_btree_map_remove(tree, "name_0100");
+    tb_btree_map_remove_range(tree, "name_0200", "name_0800");
+
+    // check items
+    tb_size_t count = 0;
+    tb_size_t last = 0;
+    tb_for_all (tb_btree_map_item_ref_t, item, tree)
+    {
+        tb_size_t data = (tb_size_t)item->data;
+        tb_snprintf(name, sizeof(name), "name_%04lu", data);
+        tb_check_break(!tb_strcmp(name, (tb_char_t const*)item->name));
+        tb_check_break(!count || data > last);
+        tb_check_break(data != 100 && (data < 200 || data >= 800));
+        last = data;
+        count++;
+    }
+    tb_btree_map_test_dump(tree);
+
+    // trace
+    tb_bool_t ok = count == 399 && count == tb_btree_map_size(tree) && (tb_size_t)tb_btree_map_get(tree, "name_0999") == 999;
+    tb_trace_i("s2i: %s", ok? "ok" : "failed");
+
+    // exit tree
+    tb_btree_map_exit(tree);
+}
+static tb_void_t tb_btree_map_test_insert_perf(tb_size_t n)
+{
+    // init
+    tb_vector_ref_t     vector = tb_vector_init(n, tb_element_long());
+    tb_btree_map_ref_t  tree = tb_btree_map_init(0, tb_element_long(), tb_element_long());
+    tb_check_goto(vector && tree, end);
+
+    // insert the random items to the sorted vector
+    tb_size_t i = 0;
+    tb_random_seed(0x1234);
+    tb_hong_t t = tb_mclock();
+    for (i = 0; i < n; i++)
+    {
+        tb_long_t name = tb_random_range(0, n << 4);
+        tb_size_t itor = tb_btree_map_test_vector_bound(vector, name);
+        if (itor == tb_vector_size(vector) || ((tb_long_t*)tb_vector_data(vector))[itor] != name)
+            tb_vector_insert_prev(vector, itor, (tb_pointer_t)name);
+    }
+    t = tb_mclock() - t;
+    tb_trace_i("insert: vector: %lu items, time: %lld ms", tb_vector_size(vector), t);
+
+    // insert the random items to the tree
+    tb_random_seed(0x1234);
+    t = tb_mclock();
+    for (i = 0; i < n; i++) 
+    {
+        tb_long_t name = tb_random_range(0, n << 4);
+        tb_btree_map_insert(tree, (tb_pointer_t)name, (tb_pointer_t)name);
+    }
+    t = tb_mclock() - t;
+    tb_trace_i("insert: btree: %lu items, height: %lu, time: %lld ms", tb_btree_map_size(tree), tb_btree_map_height(tree), t);
+    tb_assert(tb_btree_map_size(tree) == tb_vector_size(vector));
+
+    // find the random items
+    tb_size_t found = 0;
+    tb_random_seed(0x5678);
+    t = tb_mclock();
+    for (i = 0; i < n; i++) 
+    {
+        tb_long_t name = tb_random_range(0, n << 4);
+        if (tb_binary_find_all(vector, (tb_cpointer_t)name) != tb_iterator_tail(vector)) found++;
+    }
+    t = tb_mclock() - t;
+    tb_trace_i("find: vector: %lu found, time: %lld ms", found, t);
+
+    found = 0;
+    tb_random_seed(0x5678);
+    t = tb_mclock();
+    for (i = 0; i < n; i++) 
+    {
+        tb_long_t name = tb_random_range(0, n << 4);
+        if (tb_btree_map_find(tree, (tb_pointer_t)name)) found++;
+    }
+    t = tb_mclock() - t;
+    tb_trace_i("find: btree: %lu found, time: %lld ms", found, t);
+
+    // walk the range queries
+    tb_long_t sum = 0;
+    t = tb_mclock();
+    for (i = 0; i < n; i += 16)
+    {
+        tb_size_t itor = tb_btree_map_test_vector_bound(vector, i << 4);
+        tb_size_t tail = tb_btree_map_test_vector_bound(vector, (i << 4) + 1024);
+        for (; itor < tail; itor++) sum += ((tb_long_t*)tb_vector_data(vector))[itor];
+    }
+    t = tb_mclock() - t;
+    tb_trace_i("range: vector: sum: %ld, time: %lld ms", sum, t);
+
+    sum = 0;
+    t = tb_mclock();
+    for (i = 0; i < n; i += 16)
+    {
+        tb_size_t itor = tb_btree_map_lower_bound(tree, (tb_pointer_t)(i << 4));
+        tb_size_t tail = tb_btree_map_lower_bound(tree, (tb_pointer_t)((i << 4) + 1024));
+        for (; itor != tail; itor = tb_iterator_next(tree, itor)) sum += (tb_long_t)((tb_btree_map_item_ref_t)tb_iterator_item(tree, itor))->data;
+    }
+    t = tb_mclock() - t;
+    tb_trace_i("range: btree: sum: %ld, time: %lld ms", sum, t);
+
+    // remove the random items
+    tb_random_seed(0x1234);
+    t = tb_mclock();
+    for (i = 0; i < n; i += 2)
+    {
+        tb_long_t name = tb_random_range(0, n << 4);
+        tb_size_t itor = tb_btree_map_test_vector_bound(vector, name);
+        if (itor < tb_vector_size(vector) && ((tb_long_t*)tb_vector_data(vector))[itor] == name)
+            tb_vector_remove(vector, itor);
+        tb_random_range(0, n << 4);
+    }
+    t = tb_mclock() - t;
+    tb_trace_i("remove: vector: %lu items, time: %lld ms", tb_vector_size(vector), t);
+
+    tb_random_seed(0x1234);
+    t = tb_mclock();
+    for (i = 0; i < n; i += 2)
+    {
+        tb_long_t name = tb_random_range(0, n << 4);
+        tb_btree_map_remove(tree, (tb_pointer_t)name);
+        tb_random_range(0, n << 4);
+    }
+    t = tb_mclock() - t;
+    tb_trace_i("remove: btree: %lu items, time: %lld ms", tb_btree_map_size(tree), t);
+    tb_assert(tb_btree_map_size(tree) == tb_vector_size(vector));
+
+end:
+    // exit
+    if (tree) tb_btree_map_exit(tree);
+    if (vector) tb_vector_exit(vector);
+}
+static tb_void_t tb_btree_map_test_series_perf(tb_size_t node_size, tb_size_t n)
+{
+    // init tree
+    tb_btree_map_ref_t tree = tb_btree_map_init(node_size, tb_element_long(), tb_element_long());
+    tb_assert_and_check_return(tree);
+
+    // append the time series
+    tb_size_t i = 0;
+    tb_hong_t t = tb_mclock();
+    for (i = 0; i < n; i++) tb_btree_map_insert(tree, (tb_pointer_t)i, (tb_pointer_t)i);
+    t = tb_mclock() - t;
+    tb_trace_i("series: node: %lu: append: %lu items, height: %lu, usage: %lu%%, time: %lld ms", node_size, tb_btree_map_size(tree), tb_btree_map_height(tree), tb_btree_map_size(tree) * 100 / tb_btree_map_maxn(tree), t);
+
+    // find items
+    tb_size_t found = 0;
+    tb_random_seed(0x1234);
+    t = tb_mclock();
+    for (i = 0; i < n; i++) 
+    {
+        tb_long_t name = tb_random_range(0, n);
+        if ((tb_long_t)tb_btree_map_get(tree, (tb_pointer_t)name) == name) found++;
+    }
+    t = tb_mclock() - t;
+    tb_trace_i("series: node: %lu: find: %lu found, time: %lld ms", node_size, found, t);
+
+    // remove the old items
+    t = tb_mclock();
+    tb_size_t removed = tb_btree_map_remove_range(tree, (tb_pointer_t)0, (tb_pointer_t)(n >> 1));
+    t = tb_mclock() - t;
+    tb_trace_i("series: node: %lu: remove range: %lu items, time: %lld ms", node_size, removed, t);
+
+    // exit tree
+    tb_btree_map_exit(tree);
+}
+static tb_void_t tb_btree_map_test_load_perf(tb_size_t n)
+{
+    // init
+    tb_btree_map_item_ref_t items = tb_nalloc_type(n, tb_btree_map_item_t);
+    tb_btree_map_ref_t      tree = tb_btree_map_init(0, tb_element_long(), tb_element_long());
+    tb_check_goto(items && tree, end);
+
+    // init items
+    tb_size_t i = 0;
+    for (i = 0; i < n; i++)
+    {
+        items[i].name = (tb_pointer_t)(i << 1);
+        items[i].data = (tb_pointer_t)i;
+    }
+
+    // load items
+    tb_hong_t t = tb_mclock();
+    tb_btree_map_load(tree, items, n);
+    t = tb_mclock() - t;
+    tb_trace_i("load: %lu items, height: %lu, usage: %lu%%, time: %lld ms", tb_btree_map_size(tree), tb_btree_map_height(tree), tb_btree_map_size(tree) * 100 / tb_btree_map_maxn(tree), t);
+
+    // insert items one by one
+    tb_btree_map_clear(tree);
+    t = tb_mclock();
+    for (i = 0; i < n; i++) tb_btree_map_insert(tree, items[i].name, items[i].data);
+    t = tb_mclock() - t;
+    tb_trace_i("load: insert: %lu items, time: %lld ms", tb_btree_map_size(tree), t);
+
+end:
+    // exit
+    if (tree) tb_btree_map_exit(tree);
+    if (items) tb_free(items);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_container_btree_map_main(tb_int_t argc, tb_char_t** argv)
+{
+#if 1
+    tb_btree_map_test_i2i_func(16);
+    tb_btree_map_test_i2i_func(TB_BTREE_MAP_NODE_SIZE_SMALL);
+    tb_btree_map_test_i2i_func(TB_BTREE_MAP_NODE_SIZE_PAGE);
+    tb_btree_map_test_s2i_func();
+#endif
+
+#if 1
+    tb_btree_map_test_insert_perf(100000);
+    tb_btree_map_test_series_perf(TB_BTREE_MAP_NODE_SIZE_SMALL, 1000000);
+    tb_btree_map_test_series_perf(TB_BTREE_MAP_NODE_SIZE_DEFAULT, 1000000);
+    tb_btree_map_test_series_perf(TB_BTREE_MAP_NODE_SIZE_PAGE, 1000000);
+    tb_btree_map_test_load_perf(1000000);
+#endif
+
+    return 0;
+}
@@ -0,0 +1,333 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */ 
+
+// the max threads count of producers or consumers
+#define TB_DEMO_THREAD_MAXN         (16)
+
+// the items count of the benchmark
+#define TB_DEMO_ITEM_COUNT          (1000000)
+
+// the items count of each batch for put_n and get_n
+#define TB_DEMO_BATCH_SIZE          (16)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */ 
+
+// the demo context type
+typedef struct __tb_demo_context_t
+{
+    // the concurrent queue, uses the circle queue with lock if be null
+    tb_concurrent_circle_queue_ref_t    queue;
+
+    // the circle queue with lock
+    tb_circle_queue_ref_t               locked_queue;
+
+    // the lock of the circle queue
+    tb_spinlock_t                       lock;
+
+    // the producers count
+    tb_size_t                           producers;
+
+    // the items count of each producer
+    tb_size_t                           count;
+
+    // put and get the items in batch?
+    tb_bool_t                           batch;
+
+    // the next producer index
+    tb_atomic_t                         index;
+
+    // the consumed items count
+    tb_atomic_t                         consumed;
+
+    // the sum of all consumed items
+    tb_atomic_t                         sum;
+
+    // the items are out of order for one producer?
+    tb_bool_t                           disorder;
+
+}tb_demo_context_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * func test
+ */ 
+static tb_size_t g_freed = 0;
+static tb_void_t tb_demo_item_free(tb_element_ref_t element, tb_pointer_t buff)
+{
+    if (buff && *((tb_pointer_t*)buff)) g_freed++;
+}
+static tb_void_t tb_demo_func()
+{
+    // init queue
+    tb_concurrent_circle_queue_ref_t queue = tb_concurrent_circle_queue_init(8, tb_element_ptr(tb_demo_item_free, tb_null), TB_CONCURRENT_CIRCLE_QUEUE_MODE_MPMC);
+    tb_assert_and_check_return(queue);
+
+    // put items until it is full
+    tb_size_t i = 0;
+    for (i = 0; i < 8; i++) 
+    {
+        if (!tb_concurrent_circle_queue_put(queue, (tb_cpointer_t)(i + 1))) break;
+    }
+    tb_assert(i == 8);
+    tb_assert(!tb_concurrent_circle_queue_put(queue, (tb_cpointer_t)9));
+    tb_assert(tb_concurrent_circle_queue_size(queue) == 8);
+
+    // get the half items
+    tb_pointer_t data = tb_null;
+    for (i = 0; i < 4; i++) 
+    {
+        if (!tb_concurrent_circle_queue_get(queue, &data) || (tb_size_t)data != i + 1) break;
+    }
+    tb_assert(i == 4);
+
+    // put and get items in batch with wrapping around
+    tb_size_t       n = 0;
+    tb_cpointer_t   items[8];
+    tb_pointer_t    results[8];
+    for (i = 0; i < 8; i++) items[i] = (tb_cpointer_t)(i + 9);
+    n = tb_concurrent_circle_queue_put_n(queue, items, 8);
+    tb_assert(n == 4);
+    n = tb_concurrent_circle_queue_get_n(queue, results, 8);
+    tb_assert(n == 8);
+    for (i = 0; i < n; i++) 
+    {
+        tb_assert_and_check_break((tb_size_t)results[i] == i + 5);
+    }
+    tb_assert(!tb_concurrent_circle_queue_get(queue, &data));
+    tb_assert(!tb_concurrent_circle_queue_size(queue));
+
+    // the left items will be freed
+    tb_concurrent_circle_queue_put_n(queue, items, 3);
+    tb_concurrent_circle_queue_clear(queue);
+    tb_assert(g_freed == 3);
+    tb_concurrent_circle_queue_put_n(queue, items, 2);
+    tb_concurrent_circle_queue_exit(queue);
+    tb_assert(g_freed == 5);
+
+    // trace
+    tb_trace_i("func: freed: %lu", g_freed);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * benchmark
+ */ 
+static tb_bool_t tb_demo_put(tb_demo_context_t* context, tb_cpointer_t const* items, tb_size_t size)
+{
+    // put it to the concurrent queue
+    if (context->queue) 
+    {
+        // put all items
+        while (size)
+        {
+            tb_size_t n = context->batch? tb_concurrent_circle_queue_put_n(context->queue, items, size) : (tb_size_t)tb_concurrent_circle_queue_put(context->queue, items[0]);
+            if (n)
+            {
+                items += n;
+                size -= n;
+            }
+            else tb_sched_yield();
+        }
+        return tb_true;
+    }
+
+    // put it to the circle queue with lock
+    while (size)
+    {
+        tb_bool_t ok = tb_false;
+        tb_spinlock_enter(&context->lock);
+        if (!tb_circle_queue_full(context->locked_queue))
+        {
+            tb_circle_queue_put(context->locked_queue, items[0]);
+            ok = tb_true;
+        }
+        tb_spinlock_leave(&context->lock);
+        if (ok) 
+        {
+            items++;
+            size--;
+        }
+        else tb_sched_yield();
+    }
+    return tb_true;
+}
+static tb_size_t tb_demo_get(tb_demo_context_t* context, tb_pointer_t* items, tb_size_t maxn)
+{
+    // get it from the concurrent queue
+    if (context->queue)
+    {
+        if (context->batch) return tb_concurrent_circle_queue_get_n(context->queue, items, maxn);
+        return tb_concurrent_circle_queue_get(context->queue, items)? 1 : 0;
+    }
+
+    // get it from the circle queue with lock
+    tb_size_t n = 0;
+    tb_spinlock_enter(&context->lock);
+    if (!tb_circle_queue_null(context->locked_queue))
+    {
+        items[n++] = tb_circle_queue_get(context->locked_queue);
+        tb_circle_queue_pop(context->locked_queue);
+    }
+    tb_spinlock_leave(&context->lock);
+    return n;
+}
+static tb_int_t tb_demo_producer(tb_cpointer_t priv)
+{
+    // the context
+    tb_demo_context_t* context = (tb_demo_context_t*)priv;
+    tb_assert_and_check_return_val(context, -1);
+
+    // the producer index
+    tb_size_t index = (tb_size_t)tb_atomic_fetch_and_inc(&context->index);
+
+    // put items: (count * index + 1) ... (count * index + count)
+    tb_size_t       i = 0;
+    tb_size_t       n = 0;
+    tb_cpointer_t   items[TB_DEMO_BATCH_SIZE];
+    for (i = 0; i < context->count; i += n)
+    {
+        n = tb_min(context->count - i, TB_DEMO_BATCH_SIZE);
+        tb_size_t j = 0;
+        for (j = 0; j < n; j++) items[j] = (tb_cpointer_t)(context->count * index + i + j + 1);
+        tb_demo_put(context, items, n);
+    }
+    return 0;
+}
+static tb_int_t tb_demo_consumer(tb_cpointer_t priv)
+{
+    // the context
+    tb_demo_context_t* context = (tb_demo_context_t*)priv;
+    tb_assert_and_check_return_val(context, -1);
+
+    // get items
+    tb_size_t       i = 0;
+    tb_size_t       n = 0;
+    tb_size_t       sum = 0;
+    tb_size_t       total = context->producers * context->count;
+    tb_size_t       last[TB_DEMO_THREAD_MAXN] = {0};
+    tb_pointer_t    items[TB_DEMO_BATCH_SIZE];
+    while ((tb_size_t)context->consumed < total)
+    {
+        // get some items
+        n = tb_demo_get(context, items, TB_DEMO_BATCH_SIZE);
+        if (!n) 
+        {
+            tb_sched_yield();
+            continue ;
+        }
+
+        // the items of the same producer must be in order
+        for (i = 0; i < n; i++)
+        {
+            tb_size_t value = (tb_size_t)items[i];
+            tb_size_t index = (value - 1) / context->count;
+            if (index >= TB_DEMO_THREAD_MAXN || value <= last[index]) context->disorder = tb_true;
+            else last[index] = value;
+            sum += value;
+        }
+        tb_atomic_fetch_and_add(&context->consumed, n);
+    }
+
+    // save the sum
+    tb_atomic_fetch_and_add(&context->sum, sum);
+    return 0;
+}
+static tb_size_t tb_demo_bench(tb_concurrent_circle_queue_ref_t queue, tb_size_t maxn, tb_bool_t batch, tb_size_t producers, tb_size_t consumers)
+{
+    // init context
+    tb_demo_context_t context;
+    tb_memset(&context, 0, sizeof(tb_demo_context_t));
+    context.queue       = queue;
+    context.producers   = producers;
+    context.count       = TB_DEMO_ITEM_COUNT / producers;
+    context.batch       = batch;
+    if (!queue) 
+    {
+        context.locked_queue = tb_circle_queue_init(maxn, tb_element_ptr(tb_null, tb_null));
+        tb_spinlock_init(&context.lock);
+    }
+
+    // start producers and consumers
+    tb_size_t       i = 0;
+    tb_thread_ref_t threads[TB_DEMO_THREAD_MAXN << 1] = {0};
+    tb_hong_t       time = tb_mclock();
+    for (i = 0; i < consumers; i++) threads[i] = tb_thread_init(tb_null, tb_demo_consumer, &context, 0);
+    for (i = 0; i < producers; i++) threads[consumers + i] = tb_thread_init(tb_null, tb_demo_producer, &context, 0);
+
+    // wait them
+    for (i = 0; i < producers + consumers; i++)
+    {
+        if (threads[i])
+        {
+            tb_thread_wait(threads[i], -1, tb_null);
+            tb_thread_exit(threads[i]);
+        }
+    }
+    time = tb_mclock() - time;
+
+    // check
+    tb_size_t total = context.producers * context.count;
+    if ((tb_size_t)context.sum != total * (total + 1) / 2 || context.disorder || (tb_size_t)context.consumed != total)
+        tb_trace_e("invalid items: consumed: %lu, disorder: %d", (tb_size_t)context.consumed, context.disorder);
+
+    // exit the locked queue
+    if (context.locked_queue) tb_circle_queue_exit(context.locked_queue);
+    tb_spinlock_exit(&context.lock);
+
+    // the items count per millisecond
+    return time > 0? (tb_size_t)(total / time) : 0;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */ 
+tb_int_t tb_demo_container_concurrent_circle_queue_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the max threads count of producers or consumers
+    tb_size_t maxn = argv[1]? tb_atoi(argv[1]) : 4;
+    if (maxn > TB_DEMO_THREAD_MAXN) maxn = TB_DEMO_THREAD_MAXN;
+
+    // func test
+    tb_demo_func();
+
+    // benchmark the spsc, mpsc and mpmc queues
+    tb_size_t count = 1;
+    for (count = 1; count <= maxn; count <<= 1)
+    {
+        // the modes
+        tb_size_t   i = 0;
+        tb_size_t   modes[] = {TB_CONCURRENT_CIRCLE_QUEUE_MODE_SPSC, TB_CONCURRENT_CIRCLE_QUEUE_MODE_MPSC, TB_CONCURRENT_CIRCLE_QUEUE_MODE_MPMC};
+        tb_char_t const* names[] = {"spsc", "mpsc", "mpmc"};
+        for (i = 0; i < tb_arrayn(modes); i++)
+        {
+            // the producers and consumers count
+            tb_size_t producers = (modes[i] & TB_CONCURRENT_CIRCLE_QUEUE_MODE_SP)? 1 : count;
+            tb_size_t consumers = (modes[i] & TB_CONCURRENT_CIRCLE_QUEUE_MODE_SC)? 1 : count;
+            if (count > 1 && modes[i] == TB_CONCURRENT_CIRCLE_QUEUE_MODE_SPSC) continue;
+
+            // init queue
+            tb_concurrent_circle_queue_ref_t queue = tb_concurrent_circle_queue_init(1024, tb_element_ptr(tb_null, tb_null), modes[i]);
+            if (queue)
+            {
+                // benchmark them
+                tb_size_t locked    = tb_demo_bench(tb_null, 1024, tb_false, producers, consumers);
+                tb_size_t single    = tb_demo_bench(queue, 1024, tb_false, producers, consumers);
+                tb_size_t batch     = tb_demo_bench(queue, 1024, tb_true, producers, consumers);
+
+                // trace
+                tb_trace_i("%s: producers: %2lu, consumers: %2lu, circle_queue with lock: %6lu items/ms, concurrent: %6lu items/ms, batch: %6lu items/ms"
+                    , names[i], producers, consumers, locked, single, batch);
+
+                // exit queue
+                tb_concurrent_circle_queue_exit(queue);
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,240 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */ 
+
+// the max threads count
+#define TB_DEMO_THREAD_MAXN         (64)
+
+// the reader threads count of the stress test
+#define TB_DEMO_STRESS_READERS      (4)
+
+// the items count
+#define TB_DEMO_ITEM_MAXN           (65536)
+
+// the benchmark time of each threads count
+#define TB_DEMO_BENCH_TIME          (200)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */ 
+
+// the concurrent hash map
+static tb_concurrent_hash_map_ref_t     g_concurrent_hash = tb_null;
+
+// the hash map with lock
+static tb_hash_map_ref_t                g_locked_hash = tb_null;
+
+// the lock of the hash map
+static tb_spinlock_t                    g_locked_hash_lock = TB_SPINLOCK_INIT;
+
+// stop it?
+static __tb_volatile__ tb_bool_t        g_stop = tb_false;
+
+// the reads count of each thread
+static tb_size_t                        g_reads[TB_DEMO_THREAD_MAXN];
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * stress test
+ */ 
+static tb_int_t tb_demo_stress_reader(tb_cpointer_t priv)
+{
+    // done
+    tb_size_t   count = 0;
+    tb_size_t   rand = (tb_size_t)priv + 1;
+    tb_char_t   name[64];
+    while (!g_stop)
+    {
+        // the random name
+        rand = (rand * 10807 + 1) & 0xffffffff;
+        tb_snprintf(name, sizeof(name), "%lu", rand % TB_DEMO_ITEM_MAXN);
+
+        // the data is being replaced and removed by the writer, but it will not be freed in the read section
+        tb_concurrent_hash_map_enter(g_concurrent_hash);
+        tb_char_t const* data = (tb_char_t const*)tb_concurrent_hash_map_get(g_concurrent_hash, name);
+        if (data && tb_strcmp(data, name))
+        {
+            tb_trace_e("invalid data: %s != %s", data, name);
+            tb_abort();
+        }
+        tb_concurrent_hash_map_leave(g_concurrent_hash);
+        count++;
+    }
+
+    // save the reads count
+    g_reads[(tb_size_t)priv] = count;
+    return 0;
+}
+static tb_void_t tb_demo_stress()
+{
+    // init hash map
+    g_concurrent_hash = tb_concurrent_hash_map_init(TB_DEMO_ITEM_MAXN, tb_element_str(tb_true), tb_element_str(tb_true));
+    tb_assert_and_check_return(g_concurrent_hash);
+
+    // start readers
+    tb_size_t       i = 0;
+    tb_thread_ref_t threads[TB_DEMO_STRESS_READERS] = {0};
+    g_stop = tb_false;
+    for (i = 0; i < TB_DEMO_STRESS_READERS; i++)
+        threads[i] = tb_thread_init(tb_null, tb_demo_stress_reader, (tb_cpointer_t)i, 0);
+
+    // insert, replace and remove items
+    tb_size_t   rand = 12345;
+    tb_size_t   writes = 0;
+    tb_char_t   name[64];
+    tb_hong_t   time = tb_mclock();
+    while (tb_mclock() - time < 1000)
+    {
+        rand = (rand * 10807 + 1) & 0xffffffff;
+        tb_snprintf(name, sizeof(name), "%lu", (rand >> 8) % TB_DEMO_ITEM_MAXN);
+        if (rand & 0x80000000) tb_concurrent_hash_map_insert(g_concurrent_hash, name, name);
+        else tb_concurrent_hash_map_remove(g_concurrent_hash, name);
+        writes++;
+    }
+
+    // wait readers
+    g_stop = tb_true;
+    tb_size_t reads = 0;
+    for (i = 0; i < TB_DEMO_STRESS_READERS; i++)
+    {
+        if (threads[i])
+        {
+            tb_thread_wait(threads[i], -1, tb_null);
+            tb_thread_exit(threads[i]);
+            reads += g_reads[i];
+        }
+    }
+
+    // trace
+    tb_trace_i("stress: writes: %lu, reads: %lu, size: %lu", writes, reads, tb_concurrent_hash_map_size(g_concurrent_hash));
+
+    // clear it
+    tb_concurrent_hash_map_clear(g_concurrent_hash);
+    tb_assert(!tb_concurrent_hash_map_size(g_concurrent_hash));
+
+    // exit hash map
+    tb_concurrent_hash_map_exit(g_concurrent_hash);
+    g_concurrent_hash = tb_null;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * benchmark
+ */ 
+static tb_int_t tb_demo_bench_reader(tb_cpointer_t priv)
+{
+    // done
+    tb_size_t count = 0;
+    tb_size_t found = 0;
+    tb_size_t rand = (tb_size_t)priv + 1;
+    while (!g_stop)
+    {
+        // read the random items
+        tb_size_t i = 0;
+        for (i = 0; i < 256; i++)
+        {
+            rand = (rand * 10807 + 1) & 0xffffffff;
+            tb_size_t name = rand % TB_DEMO_ITEM_MAXN;
+            tb_size_t data;
+            if (g_concurrent_hash) data = (tb_size_t)tb_concurrent_hash_map_get(g_concurrent_hash, (tb_cpointer_t)name);
+            else
+            {
+                tb_spinlock_enter(&g_locked_hash_lock);
+                data = (tb_size_t)tb_hash_map_get(g_locked_hash, (tb_cpointer_t)name);
+                tb_spinlock_leave(&g_locked_hash_lock);
+            }
+            if (data == name + 1) found++;
+        }
+        count += i;
+    }
+
+    // check
+    if (found != count) tb_trace_e("invalid reads: %lu != %lu", found, count);
+
+    // save the reads count
+    g_reads[(tb_size_t)priv] = count;
+    return 0;
+}
+static tb_size_t tb_demo_bench(tb_size_t count)
+{
+    // start readers
+    tb_size_t       i = 0;
+    tb_thread_ref_t threads[TB_DEMO_THREAD_MAXN] = {0};
+    g_stop = tb_false;
+    for (i = 0; i < count; i++)
+        threads[i] = tb_thread_init(tb_null, tb_demo_bench_reader, (tb_cpointer_t)i, 0);
+
+    // wait some time
+    tb_hong_t time = tb_mclock();
+    tb_msleep(TB_DEMO_BENCH_TIME);
+    g_stop = tb_true;
+
+    // wait readers
+    tb_size_t reads = 0;
+    for (i = 0; i < count; i++)
+    {
+        if (threads[i])
+        {
+            tb_thread_wait(threads[i], -1, tb_null);
+            tb_thread_exit(threads[i]);
+            reads += g_reads[i];
+        }
+    }
+    time = tb_mclock() - time;
+
+    // the reads count per millisecond
+    return time > 0? (tb_size_t)(reads / time) : 0;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */ 
+tb_int_t tb_demo_container_concurrent_hash_map_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the max threads count
+    tb_size_t maxn = argv[1]? tb_atoi(argv[1]) : TB_DEMO_THREAD_MAXN;
+    if (maxn > TB_DEMO_THREAD_MAXN) maxn = TB_DEMO_THREAD_MAXN;
+
+    // stress test with the writer and readers
+    tb_demo_stress();
+
+    // init hash maps
+    g_locked_hash = tb_hash_map_init(TB_HASH_MAP_BUCKET_SIZE_LARGE, tb_element_size(), tb_element_size());
+    tb_concurrent_hash_map_ref_t concurrent_hash = tb_concurrent_hash_map_init(TB_DEMO_ITEM_MAXN, tb_element_size(), tb_element_size());
+    if (g_locked_hash && concurrent_hash)
+    {
+        // init items
+        tb_size_t i = 0;
+        for (i = 0; i < TB_DEMO_ITEM_MAXN; i++)
+        {
+            tb_hash_map_insert(g_locked_hash, (tb_cpointer_t)i, (tb_cpointer_t)(i + 1));
+            tb_concurrent_hash_map_insert(concurrent_hash, (tb_cpointer_t)i, (tb_cpointer_t)(i + 1));
+        }
+
+        // benchmark the reads from 1 to maxn threads
+        tb_size_t count = 1;
+        for (count = 1; count <= maxn; count <<= 1)
+        {
+            // the hash map with lock
+            g_concurrent_hash = tb_null;
+            tb_size_t locked = tb_demo_bench(count);
+
+            // the concurrent hash map
+            g_concurrent_hash = concurrent_hash;
+            tb_size_t concurrent = tb_demo_bench(count);
+            g_concurrent_hash = tb_null;
+
+            // trace
+            tb_trace_i("threads: %2lu, hash_map with lock: %8lu reads/ms, concurrent_hash_map: %8lu reads/ms", count, locked, concurrent);
+        }
+    }
+
+    // exit hash maps
+    if (g_locked_hash) tb_hash_map_exit(g_locked_hash);
+    if (concurrent_hash) tb_concurrent_hash_map_exit(concurrent_hash);
+    g_locked_hash = tb_null;
+    return 0;
+}
@@ -580,6 +580,71 @@ static tb_void_t tb_hash_map_test_walk_perf()
     // exit 
     tb_hash_map_exit(hash);
 }
+static tb_void_t tb_hash_map_test_grow_func()
+{
+    // init hash
+    tb_hash_map_ref_t hash = tb_hash_map_init(TB_HASH_MAP_BUCKET_SIZE_MICRO | TB_HASH_MAP_BUCKET_GROW, tb_element_str(tb_true), tb_element_long());
+    tb_assert_and_check_return(hash);
+
+    // insert items, the old buckets are being migrated at the same time
+    tb_size_t i = 0;
+    tb_size_t n = 100000;
+    tb_char_t s[256] = {0};
+    for (i = 0; i < n; i++)
+    {
+        tb_snprintf(s, sizeof(s), "%lu", i);
+        tb_hash_map_insert(hash, s, (tb_pointer_t)i);
+
+        // the inserted items can be found from both of the new and old buckets
+        tb_snprintf(s, sizeof(s), "%lu", i >> 1);
+        tb_assert(tb_hash_map_get(hash, s) == (tb_pointer_t)(i >> 1));
+    }
+    tb_assert(tb_hash_map_size(hash) == n);
+
+    // remove the odd items
+    for (i = 1; i < n; i += 2)
+    {
+        tb_snprintf(s, sizeof(s), "%lu", i);
+        tb_hash_map_remove(hash, s);
+    }
+
+    // walk the even items
+    tb_size_t count = 0;
+    tb_for_all (tb_hash_map_item_ref_t, item, hash)
+    {
+        if (!((tb_size_t)item->data & 0x1)) count++;
+    }
+    tb_assert(count == n >> 1 && tb_hash_map_size(hash) == count);
+    tb_trace_i("grow: size: %lu, maxn: %lu", tb_hash_map_size(hash), tb_hash_map_maxn(hash));
+
+    // exit hash
+    tb_hash_map_exit(hash);
+}
+static tb_void_t tb_hash_map_test_grow_perf(tb_size_t bucket_size)
+{
+    // init hash
+    tb_hash_map_ref_t hash = tb_hash_map_init(bucket_size, tb_element_long(), tb_element_long());
+    tb_assert_and_check_return(hash);
+
+    // insert items and get the maximum latency
+    tb_size_t i = 0;
+    tb_size_t n = 1000000;
+    tb_hong_t m = 0;
+    tb_hong_t t = tb_mclock();
+    for (i = 0; i < n; i++) 
+    {
+        tb_hong_t d = tb_uclock();
+        tb_hash_map_insert(hash, (tb_pointer_t)(i * 7919), (tb_pointer_t)i);
+        d = tb_uclock() - d;
+        if (d > m) m = d;
+    }
+    for (i = 0; i < n; i++) tb_assert(i == (tb_size_t)tb_hash_map_get(hash, (tb_pointer_t)(i * 7919)));
+    t = tb_mclock() - t;
+    tb_trace_i("grow: %s: %lu items, time: %lld ms, max insert: %lld us", (bucket_size & TB_HASH_MAP_BUCKET_GROW)? "growing" : "fixed", tb_hash_map_size(hash), t, m);
+
+    // exit hash
+    tb_hash_map_exit(hash);
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
@@ -592,6 +657,7 @@ tb_int_t tb_demo_container_hash_map_main(tb_int_t argc, tb_char_t** argv)
     tb_hash_map_test_m2m_func();
     tb_hash_map_test_i2i_func();
     tb_hash_map_test_i2t_func();
+    tb_hash_map_test_grow_func();
 #endif
 
 #if 1
@@ -604,6 +670,8 @@ tb_int_t tb_demo_container_hash_map_main(tb_int_t argc, tb_char_t** argv)
 
 #if 1
     tb_hash_map_test_walk_perf();
+    tb_hash_map_test_grow_perf(TB_HASH_MAP_BUCKET_SIZE_LARGE);
+    tb_hash_map_test_grow_perf(TB_HASH_MAP_BUCKET_SIZE_MICRO | TB_HASH_MAP_BUCKET_GROW);
 #endif
 
     return 0;
@@ -0,0 +1,146 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the mem key type
+typedef struct __tb_typed_hash_map_key_t
+{
+    // the data
+    tb_uint32_t     data[4];
+
+}tb_typed_hash_map_key_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * declaration
+ */
+TB_TYPED_HASH_MAP_DECL(tb_typed_hash_map_i2i, tb_size_t, tb_size_t, tb_typed_hash_size, tb_typed_equal)
+TB_TYPED_HASH_MAP_DECL(tb_typed_hash_map_m2i, tb_typed_hash_map_key_t, tb_size_t, tb_typed_hash_mem, tb_typed_equal_mem)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_void_t tb_typed_hash_map_test_i2i_func()
+{
+    // init hash map
+    tb_typed_hash_map_i2i_t hash_map;
+    tb_typed_hash_map_i2i_init(&hash_map, tb_null);
+
+    // insert items
+    tb_size_t i = 0;
+    tb_size_t n = 10000;
+    for (i = 0; i < n; i++) tb_typed_hash_map_i2i_insert(&hash_map, i, i + 1);
+    tb_assert(tb_typed_hash_map_i2i_size(&hash_map) == n);
+
+    // replace items
+    for (i = 0; i < n; i += 3) tb_typed_hash_map_i2i_insert(&hash_map, i, i + 2);
+    tb_assert(tb_typed_hash_map_i2i_size(&hash_map) == n);
+
+    // remove items
+    for (i = 0; i < n; i += 2) tb_typed_hash_map_i2i_remove(&hash_map, i);
+    tb_assert(tb_typed_hash_map_i2i_size(&hash_map) == n / 2);
+
+    // get items
+    for (i = 0; i < n; i++)
+    {
+        tb_size_t* data = tb_typed_hash_map_i2i_get(&hash_map, i);
+        if (i & 1) tb_assert(data && *data == ((i % 3)? i + 1 : i + 2));
+        else tb_assert(!data);
+        tb_used(data);
+    }
+
+    // walk items
+    tb_size_t                   count = 0;
+    tb_typed_hash_map_i2i_item_t* item = tb_null;
+    while ((item = tb_typed_hash_map_i2i_next(&hash_map, item))) 
+    {
+        tb_assert(item->name & 1);
+        count++;
+    }
+    tb_assert(count == n / 2);
+
+    // trace
+    tb_trace_i("i2i: size: %lu, maxn: %lu, walk: %lu", tb_typed_hash_map_i2i_size(&hash_map), tb_typed_hash_map_i2i_maxn(&hash_map), count);
+
+    // exit hash map
+    tb_typed_hash_map_i2i_exit(&hash_map);
+}
+static tb_void_t tb_typed_hash_map_test_m2i_func()
+{
+    // init hash map
+    tb_typed_hash_map_m2i_t hash_map;
+    tb_typed_hash_map_m2i_init(&hash_map, tb_null);
+
+    // insert items
+    tb_size_t               i = 0;
+    tb_size_t               n = 10000;
+    tb_typed_hash_map_key_t key;
+    for (i = 0; i < n; i++) 
+    {
+        key.data[0] = key.data[1] = key.data[2] = key.data[3] = (tb_uint32_t)i;
+        tb_typed_hash_map_m2i_insert(&hash_map, key, i);
+    }
+
+    // get items
+    for (i = 0; i < n; i++) 
+    {
+        key.data[0] = key.data[1] = key.data[2] = key.data[3] = (tb_uint32_t)i;
+        tb_size_t* data = tb_typed_hash_map_m2i_get(&hash_map, key);
+        tb_assert(data && *data == i); tb_used(data);
+    }
+
+    // trace
+    tb_trace_i("m2i: size: %lu, maxn: %lu", tb_typed_hash_map_m2i_size(&hash_map), tb_typed_hash_map_m2i_maxn(&hash_map));
+
+    // exit hash map
+    tb_typed_hash_map_m2i_exit(&hash_map);
+}
+static tb_void_t tb_typed_hash_map_test_perf()
+{
+    // init hash map
+    tb_size_t               i = 0;
+    tb_size_t               n = 1000000;
+    tb_size_t               sum = 0;
+    tb_typed_hash_map_i2i_t typed_hash_map;
+    tb_hash_map_ref_t       hash_map = tb_hash_map_init(TB_HASH_MAP_BUCKET_SIZE_LARGE, tb_element_size(), tb_element_size());
+    tb_typed_hash_map_i2i_init(&typed_hash_map, tb_null);
+    if (hash_map)
+    {
+        // insert and get items for hash map
+        tb_hong_t t = tb_mclock();
+        for (i = 0; i < n; i++) tb_hash_map_insert(hash_map, (tb_pointer_t)(i * 7919), (tb_pointer_t)i);
+        for (i = 0; i < n; i++) sum += (tb_size_t)tb_hash_map_get(hash_map, (tb_pointer_t)(i * 7919));
+        t = tb_mclock() - t;
+        tb_trace_i("perf: hash_map: %lu items, sum: %lu, time: %lld", tb_hash_map_size(hash_map), sum, t);
+
+        // insert and get items for typed hash map
+        sum = 0;
+        t = tb_mclock();
+        for (i = 0; i < n; i++) tb_typed_hash_map_i2i_insert(&typed_hash_map, i * 7919, i);
+        for (i = 0; i < n; i++) sum += *tb_typed_hash_map_i2i_get(&typed_hash_map, i * 7919);
+        t = tb_mclock() - t;
+        tb_trace_i("perf: typed_hash_map: %lu items, %lu slots, sum: %lu, time: %lld", tb_typed_hash_map_i2i_size(&typed_hash_map), tb_typed_hash_map_i2i_maxn(&typed_hash_map), sum, t);
+    }
+
+    // exit hash map
+    if (hash_map) tb_hash_map_exit(hash_map);
+    tb_typed_hash_map_i2i_exit(&typed_hash_map);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_container_typed_hash_map_main(tb_int_t argc, tb_char_t** argv)
+{
+    // func
+    tb_typed_hash_map_test_i2i_func();
+    tb_typed_hash_map_test_m2i_func();
+
+    // perf
+    tb_typed_hash_map_test_perf();
+    return 0;
+}
@@ -0,0 +1,110 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * declaration
+ */
+TB_TYPED_HEAP_DECL(tb_typed_heap_min, tb_uint32_t, tb_typed_less)
+TB_TYPED_HEAP_DECL(tb_typed_heap_max, tb_uint32_t, tb_typed_greater)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_void_t tb_typed_heap_test_func()
+{
+    // init heap
+    tb_typed_heap_min_t heap_min;
+    tb_typed_heap_max_t heap_max;
+    tb_typed_heap_min_init(&heap_min, tb_null);
+    tb_typed_heap_max_init(&heap_max, tb_null);
+
+    // put items
+    tb_size_t i = 0;
+    tb_random_reset(tb_true);
+    for (i = 0; i < 100; i++) 
+    {
+        tb_uint32_t val = (tb_uint32_t)tb_random_range(0, 50);
+        tb_typed_heap_min_put(&heap_min, val);
+        tb_typed_heap_max_put(&heap_max, val);
+    }
+
+    // check order
+    tb_uint32_t p = 0;
+    for (i = 0; tb_typed_heap_min_size(&heap_min); i++) 
+    {
+        tb_uint32_t v = tb_typed_heap_min_top(&heap_min);
+        tb_assert_and_check_break(!i || p <= v);
+        p = v;
+        tb_typed_heap_min_pop(&heap_min);
+    }
+    for (i = 0; tb_typed_heap_max_size(&heap_max); i++) 
+    {
+        tb_uint32_t v = tb_typed_heap_max_top(&heap_max);
+        tb_assert_and_check_break(!i || p >= v);
+        p = v;
+        tb_typed_heap_max_pop(&heap_max);
+    }
+
+    // trace
+    tb_trace_i("func: ok");
+
+    // exit heap
+    tb_typed_heap_min_exit(&heap_min);
+    tb_typed_heap_max_exit(&heap_max);
+}
+static tb_void_t tb_typed_heap_test_perf()
+{
+    // init heap
+    tb_size_t           i = 0;
+    tb_size_t           n = 1000000;
+    tb_size_t           sum = 0;
+    tb_typed_heap_min_t typed_heap;
+    tb_heap_ref_t       heap = tb_heap_init(4096, tb_element_uint32());
+    tb_typed_heap_min_init(&typed_heap, tb_null);
+    if (heap)
+    {
+        // put and pop items for heap
+        tb_random_reset(tb_true);
+        tb_hong_t t = tb_mclock();
+        for (i = 0; i < n; i++) tb_heap_put(heap, (tb_pointer_t)(tb_size_t)tb_random_range(0, 100000));
+        while (tb_heap_size(heap)) 
+        {
+            sum += (tb_size_t)tb_heap_top(heap);
+            tb_heap_pop(heap);
+        }
+        t = tb_mclock() - t;
+        tb_trace_i("perf: heap: sum: %lu, time: %lld", sum, t);
+
+        // put and pop items for typed heap
+        sum = 0;
+        tb_random_reset(tb_true);
+        t = tb_mclock();
+        for (i = 0; i < n; i++) tb_typed_heap_min_put(&typed_heap, (tb_uint32_t)tb_random_range(0, 100000));
+        while (tb_typed_heap_min_size(&typed_heap)) 
+        {
+            sum += tb_typed_heap_min_top(&typed_heap);
+            tb_typed_heap_min_pop(&typed_heap);
+        }
+        t = tb_mclock() - t;
+        tb_trace_i("perf: typed_heap: sum: %lu, time: %lld", sum, t);
+    }
+
+    // exit heap
+    if (heap) tb_heap_exit(heap);
+    tb_typed_heap_min_exit(&typed_heap);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_container_typed_heap_main(tb_int_t argc, tb_char_t** argv)
+{
+    // func
+    tb_typed_heap_test_func();
+
+    // perf
+    tb_typed_heap_test_perf();
+    return 0;
+}
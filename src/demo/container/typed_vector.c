@@ -0,0 +1,126 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the mem item type
+typedef struct __tb_typed_vector_item_t
+{
+    // the data
+    tb_byte_t       data[16];
+
+}tb_typed_vector_item_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * declaration
+ */
+TB_TYPED_VECTOR_DECL(tb_typed_vector_long, tb_long_t, tb_typed_equal)
+TB_TYPED_VECTOR_DECL(tb_typed_vector_mem, tb_typed_vector_item_t, tb_typed_equal_mem)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_void_t tb_typed_vector_test_long_func()
+{
+    // init vector
+    tb_typed_vector_long_t vector;
+    tb_typed_vector_long_init(&vector, tb_null);
+
+    // insert items
+    tb_long_t i = 0;
+    for (i = 0; i < 100; i++) tb_typed_vector_long_insert_tail(&vector, i);
+    tb_typed_vector_long_insert_prev(&vector, 0, -1);
+    tb_typed_vector_long_insert_prev(&vector, 50, -2);
+    tb_assert(tb_typed_vector_long_size(&vector) == 102);
+    tb_assert(tb_typed_vector_long_get(&vector, 0) == -1);
+    tb_assert(tb_typed_vector_long_get(&vector, 50) == -2);
+    tb_assert(tb_typed_vector_long_get(&vector, 51) == 49);
+    tb_assert(tb_typed_vector_long_last(&vector) == 99);
+
+    // find and remove items
+    tb_typed_vector_long_remove(&vector, tb_typed_vector_long_find(&vector, -2));
+    tb_typed_vector_long_remove(&vector, tb_typed_vector_long_find(&vector, -1));
+    tb_typed_vector_long_remove_last(&vector);
+    tb_assert(tb_typed_vector_long_find(&vector, 99) == tb_typed_vector_long_size(&vector));
+    for (i = 0; i < 99; i++) tb_assert(tb_typed_vector_long_get(&vector, i) == i);
+
+    // trace
+    tb_trace_i("long: size: %lu, last: %ld", tb_typed_vector_long_size(&vector), tb_typed_vector_long_last(&vector));
+
+    // exit vector
+    tb_typed_vector_long_exit(&vector);
+}
+static tb_void_t tb_typed_vector_test_mem_func()
+{
+    // init vector
+    tb_typed_vector_mem_t vector;
+    tb_typed_vector_mem_init(&vector, tb_null);
+
+    // insert items
+    tb_size_t               i = 0;
+    tb_typed_vector_item_t  item;
+    for (i = 0; i < 100; i++) 
+    {
+        tb_memset(item.data, (tb_int_t)i, sizeof(item.data));
+        tb_typed_vector_mem_insert_tail(&vector, item);
+    }
+
+    // find item
+    tb_memset(item.data, 42, sizeof(item.data));
+    tb_assert(tb_typed_vector_mem_find(&vector, item) == 42);
+
+    // trace
+    tb_trace_i("mem: size: %lu, find: %lu", tb_typed_vector_mem_size(&vector), tb_typed_vector_mem_find(&vector, item));
+
+    // exit vector
+    tb_typed_vector_mem_exit(&vector);
+}
+static tb_void_t tb_typed_vector_test_perf()
+{
+    // init vector
+    tb_size_t                   i = 0;
+    tb_size_t                   n = 1000000;
+    tb_long_t                   sum = 0;
+    tb_typed_vector_long_t      typed_vector;
+    tb_vector_ref_t             vector = tb_vector_init(0, tb_element_long());
+    tb_typed_vector_long_init(&typed_vector, tb_null);
+    if (vector)
+    {
+        // insert and walk items for vector
+        tb_hong_t t = tb_mclock();
+        for (i = 0; i < n; i++) tb_vector_insert_tail(vector, (tb_pointer_t)i);
+        for (i = 0; i < n; i++) sum += (tb_long_t)tb_iterator_item(vector, i);
+        t = tb_mclock() - t;
+        tb_trace_i("perf: vector: %lu items, sum: %ld, time: %lld", tb_vector_size(vector), sum, t);
+
+        // insert and walk items for typed vector
+        sum = 0;
+        t = tb_mclock();
+        for (i = 0; i < n; i++) tb_typed_vector_long_insert_tail(&typed_vector, (tb_long_t)i);
+        for (i = 0; i < n; i++) sum += tb_typed_vector_long_get(&typed_vector, i);
+        t = tb_mclock() - t;
+        tb_trace_i("perf: typed_vector: %lu items, sum: %ld, time: %lld", tb_typed_vector_long_size(&typed_vector), sum, t);
+    }
+
+    // exit vector
+    if (vector) tb_vector_exit(vector);
+    tb_typed_vector_long_exit(&typed_vector);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_container_typed_vector_main(tb_int_t argc, tb_char_t** argv)
+{
+    // func
+    tb_typed_vector_test_long_func();
+    tb_typed_vector_test_mem_func();
+
+    // perf
+    tb_typed_vector_test_perf();
+    return 0;
+}
@@ -54,26 +54,14 @@ static tb_void_t tb_demo_coroutine_echo(tb_cpointer_t priv)
         // send data
         tb_size_t   send = 0;
         tb_size_t   size = tb_strlen(data) + 1;
-        tb_long_t   wait = 0;
         while (send < size)
         {
-            // read it
-            tb_long_t real = tb_socket_send(sock, (tb_byte_t*)data + send, size - send);
+            // send it, it will be completed by io_uring directly if be supported
+            tb_long_t real = tb_coroutine_send(sock, (tb_byte_t*)data + send, size - send, TB_DEMO_TIMEOUT);
 
             // has data?
-            if (real > 0)
-            {
-                send += real;
-                wait = 0;
-            }
-            // no data? wait it
-            else if (!real && !wait)
-            {
-                // wait it
-                wait = tb_socket_wait(sock, TB_SOCKET_EVENT_SEND, TB_DEMO_TIMEOUT);
-                tb_assert_and_check_break(wait >= 0);
-            }
-            // failed or end?
+            if (real > 0) send += real;
+            // failed or timeout?
             else break;
         }
 
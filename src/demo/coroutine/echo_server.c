@@ -26,27 +26,14 @@ static tb_void_t tb_demo_coroutine_client(tb_cpointer_t priv)
     tb_char_t data[64] = {0};
     tb_size_t read = 0;
     tb_size_t size = sizeof(data) - 1;
-    tb_long_t wait = 0;
     while (read < size)
     {
-        // read it
-        tb_long_t real = tb_socket_recv(sock, (tb_byte_t*)data + read, size - read);
+        // read it, it will be completed by io_uring directly if be supported
+        tb_long_t real = tb_coroutine_recv(sock, (tb_byte_t*)data + read, size - read, TB_DEMO_TIMEOUT);
 
         // has data?
-        if (real > 0) 
-        {
-            read += real;
-            wait = 0;
-        }
-        // no data? wait it
-        else if (!real && !wait)
-        {
-            tb_trace_i("wait ..");
-            // wait it
-            wait = tb_socket_wait(sock, TB_SOCKET_EVENT_RECV, TB_DEMO_TIMEOUT);
-            tb_assert_and_check_break(wait >= 0);
-        }
-        // failed or end?
+        if (real > 0) read += real;
+        // failed, end or timeout?
         else break;
     }
 
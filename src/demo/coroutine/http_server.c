@@ -13,8 +13,8 @@
 // the timeout
 #define TB_DEMO_TIMEOUT     (-1)
 
-// the cpu-core count
-#define TB_DEMO_CPU         (1)
+// the cpu-core count, uses all processors if be zero
+#define TB_DEMO_CPU         (0)
 
 // the stack size
 #define TB_DEMO_STACKSIZE   (8192 << 2)
@@ -44,8 +44,14 @@ typedef struct __tb_demo_http_session_t
     // the file
     tb_file_ref_t   file;
 
-    // the data buffer
-    tb_byte_t       data[8192];
+    // the data buffer, it is borrowed from the io buffer pool only when the request is in flight
+    tb_io_buffer_ref_t buffer;
+
+    // the data
+    tb_byte_t*      data;
+
+    // the data maxn
+    tb_size_t       maxn;
 
     // the resource path
     tb_char_t       path[1024];
@@ -82,6 +88,9 @@ static tb_bool_t tb_demo_http_session_init(tb_demo_http_session_ref_t session, t
     // init 
     session->sock           = sock;
     session->file           = tb_null;
+    session->buffer         = tb_null;
+    session->data           = tb_null;
+    session->maxn           = 0;
     session->line_size      = 0;
     session->line_index     = 0;
     session->keep_alive     = tb_false;
@@ -92,6 +101,31 @@ static tb_bool_t tb_demo_http_session_init(tb_demo_http_session_ref_t session, t
     // ok
     return tb_true;
 }
+static tb_bool_t tb_demo_http_session_buffer_borrow(tb_demo_http_session_ref_t session)
+{
+    // check
+    tb_assert(session && !session->buffer);
+
+    // borrow the data buffer
+    session->buffer = tb_io_buffer_pool_borrow(tb_io_buffer_pool(), 8192);
+    tb_assert_and_check_return_val(session->buffer, tb_false);
+
+    // save data
+    session->data = tb_io_buffer_data(session->buffer);
+    session->maxn = tb_io_buffer_size(session->buffer);
+    return tb_true;
+}
+static tb_void_t tb_demo_http_session_buffer_release(tb_demo_http_session_ref_t session)
+{
+    // check
+    tb_assert(session);
+
+    // release the data buffer
+    if (session->buffer) tb_io_buffer_release(session->buffer);
+    session->buffer = tb_null;
+    session->data   = tb_null;
+    session->maxn   = 0;
+}
 static tb_void_t tb_demo_http_session_exit(tb_demo_http_session_ref_t session)
 {
     // check
@@ -104,6 +138,9 @@ static tb_void_t tb_demo_http_session_exit(tb_demo_http_session_ref_t session)
     // exit file
     if (session->file) tb_file_exit(session->file);
     session->file = tb_null;
+
+    // exit buffer
+    tb_demo_http_session_buffer_release(session);
 }
 static tb_bool_t tb_demo_http_session_data_send(tb_socket_ref_t sock, tb_byte_t* data, tb_size_t size)
 {
@@ -200,7 +237,7 @@ static tb_bool_t tb_demo_http_session_resp_send(tb_demo_http_session_ref_t sessi
 
     // make the response header
     tb_long_t size = tb_snprintf(   (tb_char_t*)session->data
-                                ,   sizeof(session->data)
+                                ,   session->maxn
                                 ,   "HTTP/1.1 %lu %s\r\n"
                                     "Server: %s\r\n"
                                     "Content-Type: text/html\r\n"
@@ -358,13 +395,19 @@ static tb_bool_t tb_demo_http_session_head_recv(tb_demo_http_session_ref_t sessi
     // check
     tb_assert_and_check_return_val(session && session->sock, tb_false);
 
+    // wait the request first, the idle keep-alive connection need not hold the data buffer
+    if (tb_socket_wait(session->sock, TB_SOCKET_EVENT_RECV, TB_DEMO_TIMEOUT) <= 0) return tb_false;
+
+    // borrow the data buffer
+    if (!tb_demo_http_session_buffer_borrow(session)) return tb_false;
+
     // read data
     tb_long_t wait = 0;
     tb_long_t ok = 0;
     while (!ok)
     {
         // read it
-        tb_long_t real = tb_socket_recv(session->sock, session->data, sizeof(session->data));
+        tb_long_t real = tb_socket_recv(session->sock, session->data, session->maxn);
 
         // has data?
         if (real > 0) 
@@ -417,7 +460,7 @@ static tb_void_t tb_demo_coroutine_client(tb_cpointer_t priv)
             else
             {
                 // make full path
-                tb_long_t size = tb_snprintf((tb_char_t*)session.data, sizeof(session.data), "%s%s%s", g_rootdir, session.path[0] != '/'? "/" : "", session.path);
+                tb_long_t size = tb_snprintf((tb_char_t*)session.data, session.maxn, "%s%s%s", g_rootdir, session.path[0] != '/'? "/" : "", session.path);
                 if (size > 0) session.data[size] = 0;
 
                 // init file
@@ -435,6 +478,9 @@ static tb_void_t tb_demo_coroutine_client(tb_cpointer_t priv)
         if (session.file) tb_file_exit(session.file);
         session.file = tb_null;
 
+        // release the data buffer until the next request
+        tb_demo_http_session_buffer_release(&session);
+
         // trace
         tb_trace_d("ok!");
 
@@ -443,89 +489,41 @@ static tb_void_t tb_demo_coroutine_client(tb_cpointer_t priv)
     // exit session
     tb_demo_http_session_exit(&session);
 }
-static tb_void_t tb_demo_coroutine_listen(tb_cpointer_t priv)
-{
-    // TODO: fix thundering herd issues
-    tb_socket_ref_t sock = (tb_socket_ref_t)priv;
-    while (tb_socket_wait(sock, TB_SOCKET_EVENT_ACPT, -1) > 0)
-    {
-        // accept client sockets
-        tb_size_t       count = 0;
-        tb_socket_ref_t client = tb_null;
-        while ((client = tb_socket_accept(sock, tb_null)))
-        {
-            // start client connection
-            if (!tb_coroutine_start(tb_null, tb_demo_coroutine_client, client, TB_DEMO_STACKSIZE)) break;
-            count++;
-        }
-
-        // trace
-        tb_trace_d("[%#x]: listened %lu", tb_thread_self(), count);
-    }
-}
-static tb_int_t tb_demo_coroutine_worker(tb_cpointer_t priv)
-{
-    // init scheduler
-    tb_co_scheduler_ref_t scheduler = tb_co_scheduler_init();
-    if (scheduler)
-    {
-        // start coroutines
-        tb_coroutine_start(scheduler, tb_demo_coroutine_listen, priv, 0);
-
-        // run scheduler, enable exclusive mode if be only one cpu
-        tb_co_scheduler_loop(scheduler, TB_DEMO_CPU == 1);
-
-        // exit scheduler
-        tb_co_scheduler_exit(scheduler);
-    }
-    return 0;
-}
-
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
  */ 
 tb_int_t tb_demo_coroutine_http_server_main(tb_int_t argc, tb_char_t** argv)
 {
-    // done
-    tb_socket_ref_t sock = tb_null;
-    do
+    // init the root directory
+    if (argv[1]) tb_strlcpy(g_rootdir, argv[1], sizeof(g_rootdir));
+    else tb_directory_current(g_rootdir, sizeof(g_rootdir));
+
+    // only data?
+    if (!tb_file_info(g_rootdir, tb_null)) g_onlydata = tb_true;
+
+    // trace
+    tb_trace_i("%s: %s", g_onlydata? "data" : "rootdir", g_rootdir);
+
+    /* init scheduler group
+     *
+     * each worker listens the same port with SO_REUSEPORT, 
+     * and the client coroutines will be run on the accepting worker
+     */
+    tb_co_scheduler_group_ref_t group = tb_co_scheduler_group_init(TB_DEMO_CPU);
+    if (group)
     {
-        // init socket
-        sock = tb_socket_init(TB_SOCKET_TYPE_TCP, TB_IPADDR_FAMILY_IPV4);
-        tb_assert_and_check_break(sock);
-
-        // bind socket
+        // listen on all workers
         tb_ipaddr_t addr;
         tb_ipaddr_set(&addr, tb_null, TB_DEMO_PORT, TB_IPADDR_FAMILY_IPV4);
-        if (!tb_socket_bind(sock, &addr)) break;
-
-        // listen socket
-        if (!tb_socket_listen(sock, 1000)) break;
-
-        // init the root directory
-        if (argv[1]) tb_strlcpy(g_rootdir, argv[1], sizeof(g_rootdir));
-        else tb_directory_current(g_rootdir, sizeof(g_rootdir));
-
-        // only data?
-        if (!tb_file_info(g_rootdir, tb_null)) g_onlydata = tb_true;
-
-        // trace
-        tb_trace_i("%s: %s", g_onlydata? "data" : "rootdir", g_rootdir);
-
-#if TB_DEMO_CPU > 1
-        // start workers for multi-threads
-        tb_size_t count = TB_DEMO_CPU - 1;
-        while (count--) tb_thread_init(tb_null, tb_demo_coroutine_worker, sock, 0);
-#endif
-
-        // start worker
-        tb_demo_coroutine_worker(sock);
-
-    } while (0);
+        if (tb_co_scheduler_group_listen(group, &addr, 1000, tb_demo_coroutine_client, TB_DEMO_STACKSIZE))
+        {
+            // run all workers
+            tb_co_scheduler_group_loop(group);
+        }
 
-    // exit socket
-    if (sock) tb_socket_exit(sock);
-    sock = tb_null;
+        // exit scheduler group
+        tb_co_scheduler_group_exit(group);
+    }
 
     // ok
     return 0;
@@ -0,0 +1,105 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */ 
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the offloaded coroutines count
+#define COUNT           (16)
+
+// the blocking time (ms)
+#define BLOCKING        (100)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the finished count
+static tb_size_t        g_finished = 0;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */ 
+static tb_pointer_t tb_demo_coroutine_offload_blocking(tb_cpointer_t priv)
+{
+    // block the thread of the thread pool
+    tb_msleep(BLOCKING);
+
+    // return the result
+    return (tb_pointer_t)((tb_size_t)priv * 2);
+}
+static tb_pointer_t tb_demo_coroutine_offload_file_info(tb_cpointer_t priv)
+{
+    // get the file info
+    tb_file_info_t info;
+    return tb_file_info((tb_char_t const*)priv, &info)? (tb_pointer_t)(tb_size_t)info.size : tb_null;
+}
+static tb_void_t tb_demo_coroutine_offload_func(tb_cpointer_t priv)
+{
+    // run the blocking function on the thread pool
+    tb_size_t value = (tb_size_t)priv;
+    tb_size_t result = (tb_size_t)tb_coroutine_offload(tb_demo_coroutine_offload_blocking, (tb_cpointer_t)value);
+
+    // trace
+    tb_trace_i("[coroutine: %p]: offload %lu => %lu, %s", tb_coroutine_self(), value, result, result == value * 2? "ok" : "failed");
+
+    // finished
+    g_finished++;
+}
+static tb_void_t tb_demo_coroutine_offload_file(tb_cpointer_t priv)
+{
+    // get the file size on the thread pool
+    tb_char_t const* path = (tb_char_t const*)priv;
+    tb_size_t        size = (tb_size_t)tb_coroutine_offload(tb_demo_coroutine_offload_file_info, path);
+
+    // trace
+    tb_trace_i("[coroutine: %p]: file: %s, size: %lu", tb_coroutine_self(), path, size);
+}
+static tb_void_t tb_demo_coroutine_offload_ticker(tb_cpointer_t priv)
+{
+    // the scheduler is not blocked, so we can continue to tick before all offloaded coroutines are finished
+    tb_size_t ticks = 0;
+    tb_hong_t startime = tb_mclock();
+    while (g_finished < COUNT)
+    {
+        tb_coroutine_sleep(10);
+        ticks++;
+    }
+
+    // trace
+    tb_trace_i("ticker: %lu ticks in %lld ms", ticks, tb_mclock() - startime);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */ 
+tb_int_t tb_demo_coroutine_offload_main(tb_int_t argc, tb_char_t** argv)
+{
+    // init scheduler
+    tb_co_scheduler_ref_t scheduler = tb_co_scheduler_init();
+    if (scheduler)
+    {
+        // start coroutines
+        tb_size_t i = 0;
+        for (i = 0; i < COUNT; i++)
+            tb_coroutine_start(scheduler, tb_demo_coroutine_offload_func, (tb_cpointer_t)(i + 1), 0);
+
+        // start the file coroutine
+        tb_coroutine_start(scheduler, tb_demo_coroutine_offload_file, argv[1]? argv[1] : argv[0], 0);
+
+        // start the ticker coroutine
+        tb_coroutine_start(scheduler, tb_demo_coroutine_offload_ticker, tb_null, 0);
+
+        // run scheduler, we cannot use the exclusive mode for multi-threads
+        tb_co_scheduler_loop(scheduler, tb_false);
+
+        // exit scheduler
+        tb_co_scheduler_exit(scheduler);
+    }
+
+    // end
+    return 0;
+}
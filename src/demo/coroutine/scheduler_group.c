@@ -0,0 +1,75 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */ 
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */ 
+
+// the coroutines count
+#define TB_DEMO_COUNT       (10000)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */ 
+
+// the finished coroutines count
+static tb_atomic_t          g_finished = 0;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */ 
+static tb_void_t tb_demo_coroutine_task(tb_cpointer_t priv)
+{
+    // do some works
+    tb_size_t i = 0;
+    tb_size_t n = 0;
+    for (i = 0; i < 100000; i++) n += i;
+
+    // yield and sleep it
+    tb_coroutine_yield();
+    tb_msleep(1);
+
+    // finished
+    tb_atomic_fetch_and_inc(&g_finished);
+
+    // trace
+    tb_trace_d("[%#lx]: task(%lu) finished: %lu", tb_thread_self(), (tb_size_t)priv, n);
+}
+static tb_void_t tb_demo_coroutine_spawn(tb_cpointer_t priv)
+{
+    // start all tasks on the current worker, the idle workers will steal them
+    tb_size_t i = 0;
+    tb_size_t n = (tb_size_t)priv;
+    for (i = 0; i < n; i++) tb_coroutine_start(tb_null, tb_demo_coroutine_task, (tb_cpointer_t)i, 0);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */ 
+tb_int_t tb_demo_coroutine_scheduler_group_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the workers count
+    tb_size_t count = argv[1]? tb_atoi(argv[1]) : 0;
+
+    // init scheduler group
+    tb_co_scheduler_group_ref_t group = tb_co_scheduler_group_init(count);
+    if (group)
+    {
+        // start the spawn coroutine
+        tb_coroutine_start(tb_co_scheduler_group_next(group), tb_demo_coroutine_spawn, (tb_cpointer_t)TB_DEMO_COUNT, 0);
+
+        // run all workers
+        tb_hong_t time = tb_mclock();
+        tb_co_scheduler_group_loop(group);
+        time = tb_mclock() - time;
+
+        // trace
+        tb_trace_i("workers: %lu, finished: %ld, time: %lld ms", tb_co_scheduler_group_size(group), tb_atomic_get(&g_finished), time);
+
+        // exit scheduler group
+        tb_co_scheduler_group_exit(group);
+    }
+    return 0;
+}
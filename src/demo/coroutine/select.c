@@ -0,0 +1,125 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */ 
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */ 
+
+// the select test type
+typedef struct __tb_demo_coroutine_select_t
+{
+    // the data channels
+    tb_co_channel_ref_t     data[2];
+
+    // the cancel channel
+    tb_co_channel_ref_t     cancel;
+
+}tb_demo_coroutine_select_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */ 
+static tb_void_t tb_demo_coroutine_select_send(tb_cpointer_t priv)
+{
+    // check
+    tb_co_channel_ref_t channel = (tb_co_channel_ref_t)priv;
+
+    // loop
+    tb_size_t count = 10;
+    while (count--)
+    {
+        // send data
+        tb_co_channel_send(channel, (tb_cpointer_t)count);
+
+        // wait some time
+        tb_msleep(10 * (count % 3));
+    }
+}
+static tb_void_t tb_demo_coroutine_select_cancel(tb_cpointer_t priv)
+{
+    // check
+    tb_demo_coroutine_select_t* test = (tb_demo_coroutine_select_t*)priv;
+
+    // wait some time
+    tb_msleep(1500);
+
+    // trace
+    tb_trace_i("[coroutine: %p]: cancel ..", tb_coroutine_self());
+
+    // cancel it
+    tb_co_channel_send(test->cancel, tb_null);
+}
+static tb_void_t tb_demo_coroutine_select_recv(tb_cpointer_t priv)
+{
+    // check
+    tb_demo_coroutine_select_t* test = (tb_demo_coroutine_select_t*)priv;
+
+    // init cases
+    tb_co_channel_case_t cases[3];
+    cases[0].channel    = test->data[0];
+    cases[0].type       = TB_CO_CHANNEL_CASE_RECV;
+    cases[1].channel    = test->data[1];
+    cases[1].type       = TB_CO_CHANNEL_CASE_RECV;
+    cases[2].channel    = test->cancel;
+    cases[2].type       = TB_CO_CHANNEL_CASE_RECV;
+
+    // loop
+    tb_bool_t stop = tb_false;
+    while (!stop)
+    {
+        // select the ready channel
+        tb_long_t ready = tb_co_channel_select(cases, tb_arrayn(cases), 500);
+        switch (ready)
+        {
+        case 0:
+        case 1:
+            tb_trace_i("[coroutine: %p]: recv: %lu from channel[%ld]", tb_coroutine_self(), (tb_size_t)cases[ready].data, ready);
+            break;
+        case 2:
+            tb_trace_i("[coroutine: %p]: cancelled", tb_coroutine_self());
+            stop = tb_true;
+            break;
+        default:
+            tb_trace_i("[coroutine: %p]: timeout", tb_coroutine_self());
+            break;
+        }
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */ 
+tb_int_t tb_demo_coroutine_select_main(tb_int_t argc, tb_char_t** argv)
+{
+    // init scheduler
+    tb_co_scheduler_ref_t scheduler = tb_co_scheduler_init();
+    if (scheduler)
+    {
+        // init channels
+        tb_demo_coroutine_select_t test;
+        test.data[0]    = tb_co_channel_init(0, tb_null, tb_null);
+        test.data[1]    = tb_co_channel_init(5, tb_null, tb_null);
+        test.cancel     = tb_co_channel_init(0, tb_null, tb_null);
+        tb_assert(test.data[0] && test.data[1] && test.cancel);
+
+        // start coroutines
+        tb_coroutine_start(scheduler, tb_demo_coroutine_select_send, test.data[0], 0);
+        tb_coroutine_start(scheduler, tb_demo_coroutine_select_send, test.data[1], 0);
+        tb_coroutine_start(scheduler, tb_demo_coroutine_select_cancel, &test, 0);
+        tb_coroutine_start(scheduler, tb_demo_coroutine_select_recv, &test, 0);
+
+        // run scheduler
+        tb_co_scheduler_loop(scheduler, tb_true);
+
+        // exit channels
+        tb_co_channel_exit(test.data[0]);
+        tb_co_channel_exit(test.data[1]);
+        tb_co_channel_exit(test.cancel);
+
+        // exit scheduler
+        tb_co_scheduler_exit(scheduler);
+    }
+    return 0;
+}
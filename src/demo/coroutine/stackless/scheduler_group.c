@@ -0,0 +1,117 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */ 
+#include "../../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */ 
+
+// the coroutines count
+#define TB_DEMO_COUNT       (1000000)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */ 
+
+// the spawn type
+typedef struct __tb_demo_lo_spawn_t
+{
+    // the index
+    tb_size_t           index;
+
+    // the count
+    tb_size_t           count;
+
+}tb_demo_lo_spawn_t, *tb_demo_lo_spawn_ref_t;
+
+// the task type
+typedef struct __tb_demo_lo_task_t
+{
+    // the task id
+    tb_size_t           id;
+
+    // the result
+    tb_size_t           result;
+
+}tb_demo_lo_task_t, *tb_demo_lo_task_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */ 
+
+// the finished coroutines count
+static tb_atomic_t      g_finished = 0;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */ 
+static tb_void_t tb_demo_lo_coroutine_task(tb_lo_coroutine_ref_t coroutine, tb_cpointer_t priv)
+{
+    // check
+    tb_demo_lo_task_ref_t task = (tb_demo_lo_task_ref_t)priv;
+    tb_assert(task);
+
+    // enter coroutine
+    tb_lo_coroutine_enter(coroutine)
+    {
+        // do some works
+        task->result = task->id * 2;
+
+        // yield it
+        tb_lo_coroutine_yield();
+
+        // finished
+        tb_atomic_fetch_and_inc(&g_finished);
+    }
+}
+static tb_void_t tb_demo_lo_coroutine_spawn(tb_lo_coroutine_ref_t coroutine, tb_cpointer_t priv)
+{
+    // check
+    tb_demo_lo_spawn_ref_t spawn = (tb_demo_lo_spawn_ref_t)priv;
+    tb_assert(spawn);
+
+    // enter coroutine
+    tb_lo_coroutine_enter(coroutine)
+    {
+        // start all tasks on the current worker, the idle workers will steal them
+        for (spawn->index = 0; spawn->index < spawn->count; spawn->index++)
+        {
+            // start task
+            if (!tb_lo_coroutine_start(tb_lo_scheduler_self(), tb_demo_lo_coroutine_task, tb_lo_coroutine_pass1(tb_demo_lo_task_t, id, spawn->index))) break;
+
+            // yield it to run the started tasks and reuse their coroutines and private data
+            if (!(spawn->index & 0xff)) tb_lo_coroutine_yield();
+        }
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */ 
+tb_int_t tb_demo_lo_coroutine_scheduler_group_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the workers count
+    tb_size_t count = argv[1]? tb_atoi(argv[1]) : 0;
+
+    // init scheduler group
+    tb_lo_scheduler_group_ref_t group = tb_lo_scheduler_group_init(count);
+    if (group)
+    {
+        // start the spawn coroutine
+        tb_size_t total = TB_DEMO_COUNT;
+        tb_lo_coroutine_start(tb_lo_scheduler_group_next(group), tb_demo_lo_coroutine_spawn, tb_lo_coroutine_pass1(tb_demo_lo_spawn_t, count, total));
+
+        // run all workers
+        tb_hong_t time = tb_mclock();
+        tb_lo_scheduler_group_loop(group);
+        time = tb_mclock() - time;
+
+        // trace
+        tb_trace_i("workers: %lu, finished: %ld, time: %lld ms", tb_lo_scheduler_group_size(group), tb_atomic_get(&g_finished), time);
+
+        // exit scheduler group
+        tb_lo_scheduler_group_exit(group);
+    }
+    return 0;
+}
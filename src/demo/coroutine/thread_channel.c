@@ -0,0 +1,91 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */ 
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the sender threads count
+#define THREAD_COUNT    (4)
+
+// the sent data count of each thread
+#define COUNT           (1000000)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */ 
+static tb_int_t tb_demo_coroutine_thread_channel_send(tb_cpointer_t priv)
+{
+    // check
+    tb_co_thread_channel_ref_t channel = (tb_co_thread_channel_ref_t)priv;
+
+    // send data from the plain thread
+    tb_size_t count = COUNT;
+    while (count--) tb_co_thread_channel_send(channel, (tb_cpointer_t)(count + 1));
+    return 0;
+}
+static tb_void_t tb_demo_coroutine_thread_channel_recv(tb_cpointer_t priv)
+{
+    // check
+    tb_co_thread_channel_ref_t channel = (tb_co_thread_channel_ref_t)priv;
+
+    // init the start time
+    tb_hong_t startime = tb_mclock();
+
+    // recv data in coroutine
+    tb_size_t count = THREAD_COUNT * COUNT;
+    tb_hize_t total = 0;
+    while (count--) total += (tb_size_t)tb_co_thread_channel_recv(channel);
+
+    // computing time
+    tb_hong_t duration = tb_mclock() - startime;
+
+    // trace
+    tb_trace_i("recv %d items in %lld ms, total: %llu, %s", THREAD_COUNT * COUNT, duration, total, total == (tb_hize_t)THREAD_COUNT * COUNT * (COUNT + 1) / 2? "ok" : "failed");
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */ 
+tb_int_t tb_demo_coroutine_thread_channel_main(tb_int_t argc, tb_char_t** argv)
+{
+    // init scheduler
+    tb_co_scheduler_ref_t scheduler = tb_co_scheduler_init();
+    if (scheduler)
+    {
+        // init channel
+        tb_co_thread_channel_ref_t channel = tb_co_thread_channel_init(1024, tb_null, tb_null);
+        tb_assert(channel);
+
+        // start coroutine
+        tb_coroutine_start(scheduler, tb_demo_coroutine_thread_channel_recv, channel, 0);
+
+        // start threads
+        tb_size_t       i = 0;
+        tb_thread_ref_t threads[THREAD_COUNT];
+        for (i = 0; i < THREAD_COUNT; i++)
+            threads[i] = tb_thread_init(tb_null, tb_demo_coroutine_thread_channel_send, channel, 0);
+
+        // run scheduler, we cannot use the exclusive mode for multi-threads
+        tb_co_scheduler_loop(scheduler, tb_false);
+
+        // exit threads
+        for (i = 0; i < THREAD_COUNT; i++)
+        {
+            if (threads[i])
+            {
+                tb_thread_wait(threads[i], -1, tb_null);
+                tb_thread_exit(threads[i]);
+            }
+        }
+
+        // exit channel 
+        tb_co_thread_channel_exit(channel);
+
+        // exit scheduler
+        tb_co_scheduler_exit(scheduler);
+    }
+    return 0;
+}
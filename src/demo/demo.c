@@ -147,10 +147,14 @@ static tb_demo_t g_demo[] =
     // memory
 ,   TB_DEMO_MAIN_ITEM(memory_check)
 ,   TB_DEMO_MAIN_ITEM(memory_fixed_pool)
+,   TB_DEMO_MAIN_ITEM(memory_concurrent_fixed_pool)
 ,   TB_DEMO_MAIN_ITEM(memory_string_pool)
 ,   TB_DEMO_MAIN_ITEM(memory_large_allocator)
 ,   TB_DEMO_MAIN_ITEM(memory_small_allocator)
 ,   TB_DEMO_MAIN_ITEM(memory_default_allocator)
+,   TB_DEMO_MAIN_ITEM(memory_region_allocator)
+,   TB_DEMO_MAIN_ITEM(memory_heap_profiler)
+,   TB_DEMO_MAIN_ITEM(memory_io_buffer_pool)
 ,   TB_DEMO_MAIN_ITEM(memory_memops)
 ,   TB_DEMO_MAIN_ITEM(memory_buffer)
 ,   TB_DEMO_MAIN_ITEM(memory_queue_buffer)
@@ -205,6 +209,13 @@ static tb_demo_t g_demo[] =
 ,   TB_DEMO_MAIN_ITEM(container_stack)
 ,   TB_DEMO_MAIN_ITEM(container_vector)
 ,   TB_DEMO_MAIN_ITEM(container_hash_map)
+,   TB_DEMO_MAIN_ITEM(container_flat_hash_map)
+,   TB_DEMO_MAIN_ITEM(container_concurrent_hash_map)
+,   TB_DEMO_MAIN_ITEM(container_btree_map)
+,   TB_DEMO_MAIN_ITEM(container_concurrent_circle_queue)
+,   TB_DEMO_MAIN_ITEM(container_typed_vector)
+,   TB_DEMO_MAIN_ITEM(container_typed_hash_map)
+,   TB_DEMO_MAIN_ITEM(container_typed_heap)
 ,   TB_DEMO_MAIN_ITEM(container_hash_set)
 ,   TB_DEMO_MAIN_ITEM(container_queue)
 ,   TB_DEMO_MAIN_ITEM(container_circle_queue)
@@ -225,12 +236,16 @@ static tb_demo_t g_demo[] =
 ,   TB_DEMO_MAIN_ITEM(coroutine_sleep)
 ,   TB_DEMO_MAIN_ITEM(coroutine_switch)
 ,   TB_DEMO_MAIN_ITEM(coroutine_channel)
+,   TB_DEMO_MAIN_ITEM(coroutine_select)
+,   TB_DEMO_MAIN_ITEM(coroutine_thread_channel)
+,   TB_DEMO_MAIN_ITEM(coroutine_offload)
 ,   TB_DEMO_MAIN_ITEM(coroutine_semaphore)
 ,   TB_DEMO_MAIN_ITEM(coroutine_echo_server)
 ,   TB_DEMO_MAIN_ITEM(coroutine_echo_client)
 ,   TB_DEMO_MAIN_ITEM(coroutine_file_server)
 ,   TB_DEMO_MAIN_ITEM(coroutine_file_client)
 ,   TB_DEMO_MAIN_ITEM(coroutine_http_server)
+,   TB_DEMO_MAIN_ITEM(coroutine_scheduler_group)
 #   ifdef TB_CONFIG_MODULE_HAVE_XML
 ,   TB_DEMO_MAIN_ITEM(coroutine_spider)
 #   endif
@@ -245,6 +260,7 @@ static tb_demo_t g_demo[] =
 ,   TB_DEMO_MAIN_ITEM(lo_coroutine_file_server)
 ,   TB_DEMO_MAIN_ITEM(lo_coroutine_file_client)
 ,   TB_DEMO_MAIN_ITEM(lo_coroutine_http_server)
+,   TB_DEMO_MAIN_ITEM(lo_coroutine_scheduler_group)
 #endif
 
 };
@@ -136,10 +136,14 @@ TB_DEMO_MAIN_DECL(string_static_string);
 // memory
 TB_DEMO_MAIN_DECL(memory_check);
 TB_DEMO_MAIN_DECL(memory_fixed_pool);
+TB_DEMO_MAIN_DECL(memory_concurrent_fixed_pool);
 TB_DEMO_MAIN_DECL(memory_string_pool);
 TB_DEMO_MAIN_DECL(memory_large_allocator);
 TB_DEMO_MAIN_DECL(memory_small_allocator);
 TB_DEMO_MAIN_DECL(memory_default_allocator);
+TB_DEMO_MAIN_DECL(memory_region_allocator);
+TB_DEMO_MAIN_DECL(memory_heap_profiler);
+TB_DEMO_MAIN_DECL(memory_io_buffer_pool);
 TB_DEMO_MAIN_DECL(memory_memops);
 TB_DEMO_MAIN_DECL(memory_buffer);
 TB_DEMO_MAIN_DECL(memory_queue_buffer);
@@ -190,6 +194,13 @@ TB_DEMO_MAIN_DECL(container_heap);
 TB_DEMO_MAIN_DECL(container_stack);
 TB_DEMO_MAIN_DECL(container_vector);
 TB_DEMO_MAIN_DECL(container_hash_map);
+TB_DEMO_MAIN_DECL(container_flat_hash_map);
+TB_DEMO_MAIN_DECL(container_concurrent_hash_map);
+TB_DEMO_MAIN_DECL(container_btree_map);
+TB_DEMO_MAIN_DECL(container_concurrent_circle_queue);
+TB_DEMO_MAIN_DECL(container_typed_vector);
+TB_DEMO_MAIN_DECL(container_typed_hash_map);
+TB_DEMO_MAIN_DECL(container_typed_heap);
 TB_DEMO_MAIN_DECL(container_hash_set);
 TB_DEMO_MAIN_DECL(container_queue);
 TB_DEMO_MAIN_DECL(container_circle_queue);
@@ -210,12 +221,16 @@ TB_DEMO_MAIN_DECL(coroutine_sleep);
 TB_DEMO_MAIN_DECL(coroutine_spider);
 TB_DEMO_MAIN_DECL(coroutine_switch);
 TB_DEMO_MAIN_DECL(coroutine_channel);
+TB_DEMO_MAIN_DECL(coroutine_select);
+TB_DEMO_MAIN_DECL(coroutine_thread_channel);
+TB_DEMO_MAIN_DECL(coroutine_offload);
 TB_DEMO_MAIN_DECL(coroutine_semaphore);
 TB_DEMO_MAIN_DECL(coroutine_echo_client);
 TB_DEMO_MAIN_DECL(coroutine_echo_server);
 TB_DEMO_MAIN_DECL(coroutine_file_client);
 TB_DEMO_MAIN_DECL(coroutine_file_server);
 TB_DEMO_MAIN_DECL(coroutine_http_server);
+TB_DEMO_MAIN_DECL(coroutine_scheduler_group);
 
 // stackless coroutine
 TB_DEMO_MAIN_DECL(lo_coroutine_nest);
@@ -227,6 +242,7 @@ TB_DEMO_MAIN_DECL(lo_coroutine_echo_client);
 TB_DEMO_MAIN_DECL(lo_coroutine_file_server);
 TB_DEMO_MAIN_DECL(lo_coroutine_file_client);
 TB_DEMO_MAIN_DECL(lo_coroutine_http_server);
+TB_DEMO_MAIN_DECL(lo_coroutine_scheduler_group);
 
 #endif
 
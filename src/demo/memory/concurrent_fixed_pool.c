@@ -0,0 +1,190 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */ 
+
+// the threads count
+#define TB_DEMO_THREAD_MAXN         (4)
+
+// the exchanged slots count
+#define TB_DEMO_SLOT_MAXN           (1024)
+
+// the loop count of each thread
+#define TB_DEMO_LOOP_MAXN           (1000000)
+
+// the item magic
+#define TB_DEMO_ITEM_MAGIC          (0xbeaf)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */ 
+
+// the demo item type
+typedef struct __tb_demo_item_t
+{
+    // the magic
+    tb_size_t               magic;
+
+    // the producer thread
+    tb_size_t               producer;
+
+    // the data
+    tb_byte_t               data[48];
+
+}tb_demo_item_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */ 
+
+// the exchanged slots, the items will be freed by the other threads
+static tb_atomic_t                      g_slots[TB_DEMO_SLOT_MAXN];
+
+// the concurrent fixed pool
+static tb_concurrent_fixed_pool_ref_t   g_concurrent_pool = tb_null;
+
+// the fixed pool with lock
+static tb_fixed_pool_ref_t              g_locked_pool = tb_null;
+
+// the lock of the fixed pool
+static tb_spinlock_t                    g_locked_pool_lock = TB_SPINLOCK_INIT;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * demo
+ */ 
+static tb_pointer_t tb_demo_item_malloc()
+{
+    if (g_concurrent_pool) return tb_concurrent_fixed_pool_malloc(g_concurrent_pool);
+
+    tb_spinlock_enter(&g_locked_pool_lock);
+    tb_pointer_t data = tb_fixed_pool_malloc(g_locked_pool);
+    tb_spinlock_leave(&g_locked_pool_lock);
+    return data;
+}
+static tb_void_t tb_demo_item_free(tb_pointer_t data)
+{
+    if (g_concurrent_pool) 
+    {
+        tb_concurrent_fixed_pool_free(g_concurrent_pool, data);
+        return ;
+    }
+
+    tb_spinlock_enter(&g_locked_pool_lock);
+    tb_fixed_pool_free(g_locked_pool, data);
+    tb_spinlock_leave(&g_locked_pool_lock);
+}
+static tb_int_t tb_demo_thread_func(tb_cpointer_t priv)
+{
+    // the thread index
+    tb_size_t index = (tb_size_t)priv;
+
+    // done
+    tb_size_t i = 0;
+    tb_size_t rand = index + 1;
+    for (i = 0; i < TB_DEMO_LOOP_MAXN; i++)
+    {
+        // make item
+        tb_demo_item_t* item = (tb_demo_item_t*)tb_demo_item_malloc();
+        tb_assert_and_check_break(item);
+        item->magic     = TB_DEMO_ITEM_MAGIC;
+        item->producer  = index;
+
+        // exchange it with the item of a random slot
+        rand = (rand * 10807 + 1) & 0xffffffff;
+        item = (tb_demo_item_t*)tb_atomic_fetch_and_set(&g_slots[rand % TB_DEMO_SLOT_MAXN], (tb_long_t)item);
+
+        // free the previous item, it may be allocated by other threads
+        if (item)
+        {
+            // check it
+            if (item->magic != TB_DEMO_ITEM_MAGIC || item->producer >= TB_DEMO_THREAD_MAXN)
+            {
+                tb_trace_e("invalid item: %p", item);
+                tb_abort();
+            }
+            item->magic = 0;
+
+            // free it
+            tb_demo_item_free(item);
+        }
+    }
+
+    // end
+    return 0;
+}
+static tb_hong_t tb_demo_perf()
+{
+    // init threads
+    tb_size_t       i = 0;
+    tb_thread_ref_t threads[TB_DEMO_THREAD_MAXN] = {0};
+    tb_hong_t       time = tb_mclock();
+    for (i = 0; i < TB_DEMO_THREAD_MAXN; i++)
+        threads[i] = tb_thread_init(tb_null, tb_demo_thread_func, (tb_cpointer_t)i, 0);
+
+    // wait threads
+    for (i = 0; i < TB_DEMO_THREAD_MAXN; i++)
+    {
+        if (threads[i])
+        {
+            tb_thread_wait(threads[i], -1, tb_null);
+            tb_thread_exit(threads[i]);
+        }
+    }
+    time = tb_mclock() - time;
+
+    // free the left items
+    for (i = 0; i < TB_DEMO_SLOT_MAXN; i++)
+    {
+        tb_pointer_t item = (tb_pointer_t)tb_atomic_fetch_and_set0(&g_slots[i]);
+        if (item) tb_demo_item_free(item);
+    }
+
+    // ok
+    return time;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */ 
+tb_int_t tb_demo_memory_concurrent_fixed_pool_main(tb_int_t argc, tb_char_t** argv)
+{
+    // test the concurrent fixed pool
+    g_concurrent_pool = tb_concurrent_fixed_pool_init(tb_null, 0, sizeof(tb_demo_item_t));
+    if (g_concurrent_pool)
+    {
+        // done
+        tb_hong_t time = tb_demo_perf();
+
+        // trace
+        tb_trace_i("concurrent_fixed_pool: %lld ms", time);
+
+#ifdef __tb_debug__
+        // dump pool
+        tb_concurrent_fixed_pool_dump(g_concurrent_pool);
+#endif
+
+        // exit pool
+        tb_concurrent_fixed_pool_exit(g_concurrent_pool);
+        g_concurrent_pool = tb_null;
+    }
+
+    // test the fixed pool with lock
+    g_locked_pool = tb_fixed_pool_init(tb_null, 0, sizeof(tb_demo_item_t), tb_null, tb_null, tb_null);
+    if (g_locked_pool)
+    {
+        // done
+        tb_hong_t time = tb_demo_perf();
+
+        // trace
+        tb_trace_i("fixed_pool with lock: %lld ms", time);
+
+        // exit pool
+        tb_fixed_pool_exit(g_locked_pool);
+        g_locked_pool = tb_null;
+    }
+    return 0;
+}
@@ -0,0 +1,95 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the data count
+#define TB_DEMO_DATA_MAXN       (100000)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * demo
+ */ 
+static tb_void_t tb_demo_heap_profiler_make_small(tb_pointer_t* list, tb_size_t count)
+{
+    tb_size_t i = 0;
+    for (i = 0; i < count; i++) list[i] = tb_malloc((i & 255) + 1);
+}
+static tb_void_t tb_demo_heap_profiler_make_large(tb_pointer_t* list, tb_size_t count)
+{
+    tb_size_t i = 0;
+    for (i = 0; i < count; i++) list[i] = tb_malloc(4096 + (i & 4095));
+}
+static tb_void_t tb_demo_heap_profiler_stat(tb_allocator_ref_t allocator)
+{
+    // get stat
+    tb_allocator_stat_t stat;
+    if (!tb_allocator_stat(allocator, &stat)) 
+    {
+        tb_trace_i("stat: not supported");
+        return ;
+    }
+
+    // trace
+    tb_trace_i("stat: live: %lu, peak: %lu, malloc: %lu, free: %lu", stat.live_size, stat.peak_size, stat.malloc_count, stat.free_count);
+    tb_size_t i = 0;
+    for (i = 0; i < stat.class_count; i++)
+    {
+        tb_allocator_class_stat_ref_t cstat = &stat.classes[i];
+        tb_trace_i("    [%4lu]: live: %lu/%lu, peak: %lu, malloc: %lu, free: %lu, slots: %lu/%lu, frag: %lu/10000"
+                    , cstat->item_size, cstat->live_count, cstat->live_size, cstat->peak_size
+                    , cstat->malloc_count, cstat->free_count, cstat->slot_count, cstat->slot_size, tb_allocator_class_stat_frag(cstat));
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */ 
+tb_int_t tb_demo_memory_heap_profiler_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the folded stacks file
+    tb_char_t const* path = argc > 1? argv[1] : "/tmp/heap.folded";
+
+    // start the heap profiler
+    if (!tb_heap_profiler_start(64 * 1024)) tb_trace_i("the heap profiler is not supported");
+
+    // make data
+    tb_pointer_t* list = (tb_pointer_t*)tb_native_memory_malloc0(TB_DEMO_DATA_MAXN * sizeof(tb_pointer_t));
+    if (list)
+    {
+        tb_size_t half = TB_DEMO_DATA_MAXN >> 1;
+        tb_demo_heap_profiler_make_small(list, half);
+        tb_demo_heap_profiler_make_large(list + half, half >> 4);
+
+        // trace stat
+        tb_demo_heap_profiler_stat(tb_allocator());
+
+        // free the half of the small data, the slots will be fragmented
+        tb_size_t i = 0;
+        for (i = 0; i < TB_DEMO_DATA_MAXN; i++)
+        {
+            if (list[i] && (i >= half || (i & 1))) 
+            {
+                tb_free(list[i]);
+                list[i] = tb_null;
+            }
+        }
+
+        // trace stat
+        tb_demo_heap_profiler_stat(tb_allocator());
+
+        // free the remaining data
+        for (i = 0; i < TB_DEMO_DATA_MAXN; i++) if (list[i]) tb_free(list[i]);
+        tb_native_memory_free(list);
+    }
+
+    // dump the folded stacks
+    if (tb_heap_profiler_dump(path)) tb_trace_i("dump: %s", path);
+
+    // stop the heap profiler
+    tb_heap_profiler_stop();
+    return 0;
+}
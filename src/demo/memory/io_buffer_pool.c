@@ -0,0 +1,61 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */ 
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */ 
+
+// the buffers count
+#define TB_DEMO_BUFFER_COUNT        (256)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */ 
+tb_int_t tb_demo_memory_io_buffer_pool_main(tb_int_t argc, tb_char_t** argv)
+{
+    // init pool
+    tb_io_buffer_pool_ref_t pool = tb_io_buffer_pool_init();
+    if (pool)
+    {
+        // borrow buffers with the random sizes
+        tb_size_t           i = 0;
+        tb_io_buffer_ref_t  buffers[TB_DEMO_BUFFER_COUNT];
+        for (i = 0; i < TB_DEMO_BUFFER_COUNT; i++)
+        {
+            tb_size_t size = tb_random_range(1, TB_IO_BUFFER_POOL_MAXN);
+            buffers[i] = tb_io_buffer_pool_borrow(pool, size);
+            tb_assert_and_check_break(buffers[i] && tb_io_buffer_size(buffers[i]) >= size);
+
+            // fill data
+            tb_memset(tb_io_buffer_data(buffers[i]), (tb_int_t)i, size);
+        }
+
+        // too large?
+        tb_assert(!tb_io_buffer_pool_borrow(pool, TB_IO_BUFFER_POOL_MAXN + 1));
+
+        // share the half buffers
+        for (i = 0; i < TB_DEMO_BUFFER_COUNT; i += 2) tb_io_buffer_retain(buffers[i]);
+
+#ifdef __tb_debug__
+        // dump pool
+        tb_io_buffer_pool_dump(pool);
+#endif
+
+        // release all buffers
+        for (i = 0; i < TB_DEMO_BUFFER_COUNT; i++) tb_io_buffer_release(buffers[i]);
+
+        // release the shared buffers
+        for (i = 0; i < TB_DEMO_BUFFER_COUNT; i += 2) tb_io_buffer_release(buffers[i]);
+
+#ifdef __tb_debug__
+        // dump pool
+        tb_io_buffer_pool_dump(pool);
+#endif
+
+        // exit pool
+        tb_io_buffer_pool_exit(pool);
+    }
+    return 0;
+}
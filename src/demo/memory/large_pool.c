@@ -226,6 +226,51 @@ tb_void_t tb_demo_large_allocator_perf()
     // exit pool
     if (pool) tb_allocator_exit(pool);
 }
+tb_void_t tb_demo_large_allocator_huge(tb_long_t node);
+tb_void_t tb_demo_large_allocator_huge(tb_long_t node)
+{
+    // done
+    tb_allocator_ref_t pool = tb_null;
+    do
+    {
+        // init pool on the huge pages
+        pool = tb_large_allocator_init_with_option(TB_LARGE_ALLOCATOR_FLAG_HUGEPAGE, node);
+        tb_assert_and_check_break(pool);
+
+        // make a large table
+        tb_size_t   size = 8 * 1024 * 1024;
+        tb_byte_t*  data = (tb_byte_t*)tb_allocator_large_malloc(pool, size, tb_null);
+        tb_assert_and_check_break(data);
+
+        // touch all pages
+        tb_memset(data, 0, size);
+
+        // grow it
+        data = (tb_byte_t*)tb_allocator_large_ralloc(pool, data, size << 1, tb_null);
+        tb_assert_and_check_break(data);
+
+        // make some small data
+        tb_pointer_t small = tb_allocator_large_malloc(pool, 16 * 1024, tb_null);
+        tb_assert_and_check_break(small);
+
+        // trace stat
+        tb_large_allocator_stat_t stat;
+        if (tb_large_allocator_stat(pool, &stat))
+        {
+            tb_trace_i("huge page: %lu, node: %ld", tb_virtual_memory_huge_page_size(), node);
+            tb_trace_i("total: %lu, mapped: %lu, huge: %lu, advised: %lu, bound: %lu"
+                      , stat.total_size, stat.mapped_size, stat.huge_size, stat.huge_advised_size, stat.bound_size);
+        }
+
+        // free data
+        tb_allocator_large_free(pool, small);
+        tb_allocator_large_free(pool, data);
+
+    } while (0);
+
+    // exit pool
+    if (pool) tb_allocator_exit(pool);
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
@@ -252,6 +297,10 @@ tb_int_t tb_demo_memory_large_allocator_main(tb_int_t argc, tb_char_t** argv)
     tb_demo_large_allocator_underflow2();
 #endif
 
+#if 1
+    tb_demo_large_allocator_huge(argv[1]? tb_atoi(argv[1]) : -1);
+#endif
+
 #if 1
     tb_demo_large_allocator_real(16 * 256);
     tb_demo_large_allocator_real(32 * 256);
@@ -0,0 +1,285 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the requests count
+#define TB_DEMO_REQUEST_MAXN        (1000)
+
+// the data count of each request
+#define TB_DEMO_REQUEST_DATA_MAXN   (1000)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * demo
+ */ 
+static tb_hong_t tb_demo_region_allocator_perf(tb_allocator_ref_t allocator, tb_bool_t region)
+{
+    // make data list
+    tb_pointer_t* list = tb_nalloc0_type(TB_DEMO_REQUEST_DATA_MAXN, tb_pointer_t);
+    tb_assert_and_check_return_val(list, 0);
+
+    // done
+    tb_size_t                   indx = 0;
+    tb_size_t                   reqs = 0;
+    __tb_volatile__ tb_hong_t   time = tb_mclock();
+    __tb_volatile__ tb_size_t   rand = 0xbeaf;
+    for (reqs = 0; reqs < TB_DEMO_REQUEST_MAXN; reqs++)
+    {
+        // make many small data for parsing one request
+        for (indx = 0; indx < TB_DEMO_REQUEST_DATA_MAXN; indx++)
+        {
+            // make data
+            list[indx] = tb_allocator_malloc(allocator, (rand & 255) + 1);
+            tb_assert_and_check_break(list[indx]);
+
+            // make rand
+            rand = (rand * 10807 + 1) & 0xffffffff;
+
+            // grow the last data, e.g. appending string
+            if (!(indx & 15)) 
+            {
+                list[indx] = tb_allocator_ralloc(allocator, list[indx], (rand & 1023) + 1);
+                tb_assert_and_check_break(list[indx]);
+            }
+        }
+
+        // free all data of this request
+        if (region) tb_allocator_clear(allocator);
+        else
+        {
+            for (indx = 0; indx < TB_DEMO_REQUEST_DATA_MAXN; indx++)
+            {
+                if (list[indx]) tb_allocator_free(allocator, list[indx]);
+                list[indx] = tb_null;
+            }
+        }
+    }
+    time = tb_mclock() - time;
+
+    // exit list
+    tb_free(list);
+
+    // ok
+    return time;
+}
+static tb_void_t tb_demo_region_allocator_test(tb_noarg_t)
+{
+    // done
+    tb_allocator_ref_t allocator = tb_null;
+    do
+    {
+        // init allocator
+        allocator = tb_region_allocator_init(tb_null, 1024);
+        tb_assert_and_check_break(allocator);
+
+        // make data
+        tb_char_t* data0 = (tb_char_t*)tb_allocator_malloc(allocator, 16);
+        tb_assert_and_check_break(data0);
+        tb_strlcpy(data0, "hello", 16);
+
+        // grow the last data in place
+        data0 = (tb_char_t*)tb_allocator_ralloc(allocator, data0, 64);
+        tb_assert_and_check_break(data0);
+        tb_strcat(data0, " world!");
+
+        // make a large data in the single chunk
+        tb_pointer_t data1 = tb_allocator_malloc(allocator, 4096);
+        tb_assert_and_check_break(data1);
+
+        // free data, it does nothing
+        tb_allocator_free(allocator, data1);
+
+        // trace
+        tb_trace_i("%s", data0);
+
+#ifdef __tb_debug__
+        // dump allocator
+        tb_allocator_dump(allocator);
+#endif
+
+        // free all data
+        tb_allocator_clear(allocator);
+
+    } while (0);
+
+    // exit allocator
+    if (allocator) tb_allocator_exit(allocator);
+    allocator = tb_null;
+}
+
+static tb_void_t tb_demo_region_allocator_container(tb_noarg_t)
+{
+    // done
+    tb_allocator_ref_t  allocator = tb_null;
+    tb_hash_map_ref_t   hash_map = tb_null;
+    do
+    {
+        // init allocator
+        allocator = tb_region_allocator_init(tb_null, 0);
+        tb_assert_and_check_break(allocator);
+
+        // init hash map, the items and the duplicated strings are allocated from the region
+        hash_map = tb_hash_map_init_with_allocator(allocator, TB_HASH_MAP_BUCKET_SIZE_MICRO, tb_element_str(tb_true), tb_element_long());
+        tb_assert_and_check_break(hash_map);
+
+        // insert items
+        tb_size_t i = 0;
+        tb_char_t name[32];
+        for (i = 0; i < 1000; i++)
+        {
+            tb_snprintf(name, sizeof(name), "key_%lu", i);
+            tb_hash_map_insert(hash_map, name, (tb_cpointer_t)i);
+        }
+
+        // trace
+        tb_trace_i("hash_map: size: %lu, key_500: %lu", tb_hash_map_size(hash_map), (tb_size_t)tb_hash_map_get(hash_map, "key_500"));
+
+    } while (0);
+
+    // exit hash map
+    if (hash_map) tb_hash_map_exit(hash_map);
+    hash_map = tb_null;
+
+    // exit allocator, all data will be freed at once
+    if (allocator) tb_allocator_exit(allocator);
+    allocator = tb_null;
+}
+
+#ifdef TB_CONFIG_MODULE_HAVE_OBJECT
+static tb_void_t tb_demo_region_allocator_object(tb_noarg_t)
+{
+    // the json data
+    static tb_char_t const s_json[] = "{\"name\": \"tbox\", \"size\": 10, \"items\": [1, -2, 3.5, \"four\", true, null]}";
+
+    // done
+    tb_allocator_ref_t  allocator = tb_null;
+    tb_stream_ref_t     stream = tb_null;
+    tb_object_ref_t     object = tb_null;
+    do
+    {
+        // init allocator
+        allocator = tb_region_allocator_init(tb_null, 0);
+        tb_assert_and_check_break(allocator);
+
+        // init stream
+        stream = tb_stream_init_from_data((tb_byte_t const*)s_json, sizeof(s_json) - 1);
+        tb_assert_and_check_break(stream);
+
+        // open stream
+        if (!tb_stream_open(stream)) break;
+
+        // read object, all objects of this tree are allocated from the region
+        object = tb_object_read_with_allocator(stream, allocator);
+        tb_assert_and_check_break(object);
+
+        // trace
+        tb_trace_i("object: name: %s", tb_oc_string_cstr(tb_oc_dictionary_value(object, "name")));
+        tb_trace_i("object: items: %lu", tb_oc_array_size(tb_oc_dictionary_value(object, "items")));
+
+    } while (0);
+
+    // exit object
+    if (object) tb_object_exit(object);
+    object = tb_null;
+
+    // exit stream
+    if (stream) tb_stream_exit(stream);
+    stream = tb_null;
+
+    // exit allocator, all objects will be freed at once
+    if (allocator) tb_allocator_exit(allocator);
+    allocator = tb_null;
+}
+static tb_void_t tb_demo_region_allocator_object_bplist(tb_noarg_t)
+{
+    // the json data
+    static tb_char_t const s_json[] = "{\"name\": \"tbox\", \"data\": [1, -2, 3.5, \"four\", true, {\"five\": 5}]}";
+
+    // done
+    tb_allocator_ref_t  allocator = tb_null;
+    tb_stream_ref_t     stream = tb_null;
+    tb_object_ref_t     source = tb_null;
+    tb_object_ref_t     object = tb_null;
+    tb_byte_t           data[4096];
+    do
+    {
+        // make the source object from the global allocator
+        source = tb_object_read_from_data((tb_byte_t const*)s_json, sizeof(s_json) - 1);
+        tb_assert_and_check_break(source);
+
+        // writ it to the bplist data
+        tb_long_t size = tb_object_writ_to_data(source, data, sizeof(data), TB_OBJECT_FORMAT_BPLIST);
+        tb_assert_and_check_break(size > 0);
+
+        // init allocator
+        allocator = tb_region_allocator_init(tb_null, 0);
+        tb_assert_and_check_break(allocator);
+
+        // init stream
+        stream = tb_stream_init_from_data(data, (tb_size_t)size);
+        tb_assert_and_check_break(stream);
+
+        // open stream
+        if (!tb_stream_open(stream)) break;
+
+        // read the bplist object from the region
+        object = tb_object_read_with_allocator(stream, allocator);
+        tb_assert_and_check_break(object);
+
+        // trace
+        tb_trace_i("bplist: name: %s", tb_oc_string_cstr(tb_oc_dictionary_value(object, "name")));
+        tb_trace_i("bplist: data: %lu", tb_oc_array_size(tb_oc_dictionary_value(object, "data")));
+
+    } while (0);
+
+    // exit object
+    if (object) tb_object_exit(object);
+    object = tb_null;
+
+    // exit source
+    if (source) tb_object_exit(source);
+    source = tb_null;
+
+    // exit stream
+    if (stream) tb_stream_exit(stream);
+    stream = tb_null;
+
+    // exit allocator, all objects will be freed at once
+    if (allocator) tb_allocator_exit(allocator);
+    allocator = tb_null;
+}
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */ 
+tb_int_t tb_demo_memory_region_allocator_main(tb_int_t argc, tb_char_t** argv)
+{
+    // test
+    tb_demo_region_allocator_test();
+    tb_demo_region_allocator_container();
+#ifdef TB_CONFIG_MODULE_HAVE_OBJECT
+    tb_demo_region_allocator_object();
+    tb_demo_region_allocator_object_bplist();
+#endif
+
+    // init region allocator
+    tb_allocator_ref_t region_allocator = tb_region_allocator_init(tb_null, 0);
+    if (region_allocator)
+    {
+        // done perf
+        tb_hong_t time0 = tb_demo_region_allocator_perf(region_allocator, tb_true);
+        tb_hong_t time1 = tb_demo_region_allocator_perf(tb_allocator(), tb_false);
+
+        // trace
+        tb_trace_i("region allocator: %lld ms, default allocator: %lld ms", time0, time1);
+
+        // exit region allocator
+        tb_allocator_exit(region_allocator);
+    }
+    return 0;
+}
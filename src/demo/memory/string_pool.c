@@ -3,36 +3,91 @@
  */
 #include "../demo.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */ 
+
+// the threads count
+#define TB_DEMO_THREAD_MAXN         (4)
+
+// the loop count of each thread
+#define TB_DEMO_LOOP_MAXN           (1000000)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * demo
+ */ 
+static tb_int_t tb_demo_thread_func(tb_cpointer_t priv)
+{
+    // the thread index
+    tb_size_t index = (tb_size_t)priv;
+
+    // done
+    tb_char_t s[256] = {0};
+    tb_size_t n = TB_DEMO_LOOP_MAXN;
+    tb_size_t rand = index + 1;
+    while (n--) 
+    {
+        // make string
+        rand = (rand * 10807 + 1) & 0xffffffff;
+        tb_int_t r = tb_snprintf(s, sizeof(s), "%lu", rand % 10000); 
+        s[r] = '\0'; 
+
+        // intern it, the same strings from all threads have the same address
+        tb_char_t const* cstr = tb_string_pool_insert(tb_string_pool(), s); 
+        if (!cstr || tb_strcmp(cstr, s) || tb_string_pool_size(cstr) != (tb_size_t)r)
+        {
+            tb_trace_e("invalid string: %s", s);
+            tb_abort();
+        }
+
+        // remove it 
+        if (n & 15) tb_string_pool_remove(tb_string_pool(), cstr);
+    }
+
+    // end
+    return 0;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
  */ 
 tb_int_t tb_demo_memory_string_pool_main(tb_int_t argc, tb_char_t** argv)
 {
-#if 0
     // hello
     tb_char_t const* hello = tb_string_pool_insert(tb_string_pool(), "hello world");
-    tb_trace_i("hello: %s", hello);
+    tb_trace_i("hello: %s, hash: %lx", hello, tb_string_pool_hash(hello));
+
+    // the interned keys
+    tb_hash_map_ref_t map = tb_hash_map_init(0, tb_element_istr(tb_null), tb_element_long());
+    if (map)
+    {
+        // the key will be compared by the pointer
+        tb_hash_map_insert(map, hello, (tb_pointer_t)1);
+        tb_trace_i("get: %ld", (tb_long_t)tb_hash_map_get(map, tb_string_pool_insert(tb_string_pool(), "hello world")));
+        tb_string_pool_remove(tb_string_pool(), "hello world");
+
+        // exit map
+        tb_hash_map_exit(map);
+    }
 
     // performance
-    tb_char_t s[256] = {0};
-    tb_hong_t t = tb_mclock();
-    __tb_volatile__ tb_size_t n = 1000000;
-    while (n--) 
+    tb_size_t       i = 0;
+    tb_thread_ref_t threads[TB_DEMO_THREAD_MAXN] = {0};
+    tb_hong_t       t = tb_mclock();
+    for (i = 0; i < TB_DEMO_THREAD_MAXN; i++)
+        threads[i] = tb_thread_init(tb_null, tb_demo_thread_func, (tb_cpointer_t)i, 0);
+    for (i = 0; i < TB_DEMO_THREAD_MAXN; i++)
     {
-        tb_int_t r = tb_snprintf(s, 256, "%u", tb_random_range(0, 10000)); 
-        s[r] = '\0'; 
-#if 1
-        tb_string_pool_insert(tb_string_pool(), s); 
-        if (!(n & 15)) tb_string_pool_remove(tb_string_pool(), s);
-#else
-        tb_free(tb_strdup(s));
-#endif
+        if (threads[i])
+        {
+            tb_thread_wait(threads[i], -1, tb_null);
+            tb_thread_exit(threads[i]);
+        }
     }
     t = tb_mclock() - t;
-    tb_trace_i("time: %lld", t);
+    tb_trace_i("time: %lld ms", t);
 
     // del hello
     tb_string_pool_remove(tb_string_pool(), hello);
-#endif
     return 0;
 }
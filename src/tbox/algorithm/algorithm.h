@@ -38,7 +38,11 @@
 #include "rfor_if.h"
 #include "sort.h"
 #include "heap_sort.h"
+#include "typed_sort.h"
 #include "quick_sort.h"
+#include "intro_sort.h"
+#include "merge_sort.h"
+#include "parallel_sort.h"
 #include "insert_sort.h"
 #include "bubble_sort.h"
 #include "find.h"
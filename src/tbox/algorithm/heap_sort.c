@@ -46,11 +46,11 @@ static __tb_inline__ tb_bool_t tb_heap_check(tb_iterator_ref_t iterator, tb_size
         for (root = head; ++head != tail; ++root)
         {
             // root < left?
-            if (tb_iterator_comp(iterator, tb_iterator_item(iterator, root), tb_iterator_item(iterator, head)) < 0) return tb_false;
+            if (comp(iterator, tb_iterator_item(iterator, root), tb_iterator_item(iterator, head)) < 0) return tb_false;
             // end?
             else if (++head == tail) break;
             // root < right?
-            else if (tb_iterator_comp(iterator, tb_iterator_item(iterator, root), tb_iterator_item(iterator, head)) < 0) return tb_false;
+            else if (comp(iterator, tb_iterator_item(iterator, root), tb_iterator_item(iterator, head)) < 0) return tb_false;
         }
     }
 
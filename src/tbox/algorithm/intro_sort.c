@@ -0,0 +1,191 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        intro_sort.c
+ * @ingroup     algorithm
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "intro_sort.h"
+#include "heap_sort.h"
+#include "insert_sort.h"
+#include "../libc/libc.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the max items count of the range for the final insertion sort
+#define TB_INTRO_SORT_INSERT_MAXN           (16)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the intro sort type
+typedef struct __tb_intro_sort_t
+{
+    // the iterator
+    tb_iterator_ref_t       iterator;
+
+    // the comparer
+    tb_iterator_comp_t      comp;
+
+    // the item step
+    tb_size_t               step;
+
+    // the pivot data if the step is larger than the pointer size
+    tb_pointer_t            pivot;
+
+    // the temporary data for swapping if the step is larger than the pointer size
+    tb_pointer_t            temp;
+
+}tb_intro_sort_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_long_t tb_intro_sort_comp(tb_intro_sort_t* sort, tb_size_t litor, tb_size_t ritor)
+{
+    return sort->comp(sort->iterator, tb_iterator_item(sort->iterator, litor), tb_iterator_item(sort->iterator, ritor));
+}
+static __tb_inline__ tb_void_t tb_intro_sort_swap(tb_intro_sort_t* sort, tb_size_t litor, tb_size_t ritor)
+{
+    // save the left item
+    tb_pointer_t temp;
+    if (sort->step <= sizeof(tb_pointer_t)) temp = tb_iterator_item(sort->iterator, litor);
+    else 
+    {
+        temp = sort->temp;
+        tb_memcpy(temp, tb_iterator_item(sort->iterator, litor), sort->step);
+    }
+
+    // swap them
+    tb_iterator_copy(sort->iterator, litor, tb_iterator_item(sort->iterator, ritor));
+    tb_iterator_copy(sort->iterator, ritor, temp);
+}
+static tb_void_t tb_intro_sort_loop(tb_intro_sort_t* sort, tb_size_t head, tb_size_t tail, tb_size_t depth)
+{
+    // the iterator and comparer
+    tb_iterator_ref_t   iterator = sort->iterator;
+    tb_iterator_comp_t  comp = sort->comp;
+
+    // only partition the large range, the small ranges will be sorted by the final insertion sort 
+    while (tail - head > TB_INTRO_SORT_INSERT_MAXN)
+    {
+        // too deep? uses the heap sort
+        if (!depth--)
+        {
+            tb_heap_sort(iterator, head, tail, comp);
+            return ;
+        }
+
+        // sort the head, middle and last items, and uses the middle one as the pivot
+        tb_size_t m = head + ((tail - head) >> 1);
+        tb_size_t l = tail - 1;
+        if (tb_intro_sort_comp(sort, m, head) < 0) tb_intro_sort_swap(sort, m, head);
+        if (tb_intro_sort_comp(sort, l, m) < 0) tb_intro_sort_swap(sort, l, m);
+        if (tb_intro_sort_comp(sort, m, head) < 0) tb_intro_sort_swap(sort, m, head);
+
+        // save the pivot
+        tb_cpointer_t pivot;
+        if (sort->step <= sizeof(tb_pointer_t)) pivot = tb_iterator_item(iterator, m);
+        else
+        {
+            tb_memcpy(sort->pivot, tb_iterator_item(iterator, m), sort->step);
+            pivot = sort->pivot;
+        }
+
+        /* partition: [head, i) <= pivot, (j, tail) >= pivot
+         *
+         * the head and last items are the sentinels, so the scanning will not be out of range
+         */
+        tb_size_t i = head;
+        tb_size_t j = l;
+        while (1)
+        {
+            while (comp(iterator, tb_iterator_item(iterator, i), pivot) < 0) i++;
+            while (comp(iterator, pivot, tb_iterator_item(iterator, j)) < 0) j--;
+            if (i >= j) break;
+            tb_intro_sort_swap(sort, i, j);
+            i++;
+            j--;
+        }
+
+        // sort the smaller part first for limiting the recursive stack 
+        j++;
+        if (j - head < tail - j)
+        {
+            tb_intro_sort_loop(sort, head, j, depth);
+            head = j;
+        }
+        else
+        {
+            tb_intro_sort_loop(sort, j, tail, depth);
+            tail = j;
+        }
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_void_t tb_intro_sort(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail, tb_iterator_comp_t comp)
+{
+    // check
+    tb_assert_and_check_return(iterator && (tb_iterator_mode(iterator) & TB_ITERATOR_MODE_RACCESS));
+    tb_check_return(head != tail);
+
+    // init sort
+    tb_intro_sort_t sort;
+    sort.iterator   = iterator;
+    sort.comp       = comp? comp : tb_iterator_comp;
+    sort.step       = tb_iterator_step(iterator);
+    sort.pivot      = tb_null;
+    sort.temp       = tb_null;
+    if (sort.step > sizeof(tb_pointer_t))
+    {
+        sort.pivot = tb_malloc(sort.step << 1);
+        tb_assert_and_check_return(sort.pivot);
+        sort.temp = (tb_byte_t*)sort.pivot + sort.step;
+    }
+
+    // the max depth: 2 * log2(n)
+    tb_size_t depth = 0;
+    tb_size_t size = tail - head;
+    while (size >>= 1) depth += 2;
+
+    // partition it
+    tb_intro_sort_loop(&sort, head, tail, depth);
+
+    // sort all small ranges
+    tb_insert_sort(iterator, head, tail, sort.comp);
+
+    // exit pivot
+    if (sort.pivot) tb_free(sort.pivot);
+}
+tb_void_t tb_intro_sort_all(tb_iterator_ref_t iterator, tb_iterator_comp_t comp)
+{
+    tb_intro_sort(iterator, tb_iterator_head(iterator), tb_iterator_tail(iterator), comp);
+}
@@ -0,0 +1,146 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        merge_sort.c
+ * @ingroup     algorithm
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "merge_sort.h"
+#include "distance.h"
+#include "../libc/libc.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+
+/* the item in the buffer
+ *
+ * the item value is saved directly if the step is not larger than the pointer size,
+ * otherwise the item data is saved.
+ */
+static __tb_inline__ tb_cpointer_t tb_merge_sort_item(tb_byte_t const* data, tb_size_t step)
+{
+    return step <= sizeof(tb_pointer_t)? *((tb_cpointer_t*)data) : (tb_cpointer_t)data;
+}
+
+// merge the sorted runs: data[head, middle) and data[middle, tail) to the temp
+static tb_void_t tb_merge_sort_merge(tb_iterator_ref_t iterator, tb_byte_t const* data, tb_byte_t* temp, tb_size_t head, tb_size_t middle, tb_size_t tail, tb_size_t step, tb_size_t isize, tb_iterator_comp_t comp)
+{
+    // init
+    tb_size_t l = head;
+    tb_size_t r = middle;
+    tb_byte_t* p = temp + head * isize;
+
+    // merge them, the left item is the first if they are equal for being stable
+    if (r < tail && l < middle && comp(iterator, tb_merge_sort_item(data + r * isize, step), tb_merge_sort_item(data + (r - 1) * isize, step)) < 0)
+    {
+        while (l < middle && r < tail)
+        {
+            if (comp(iterator, tb_merge_sort_item(data + r * isize, step), tb_merge_sort_item(data + l * isize, step)) < 0)
+            {
+                tb_memcpy(p, data + r * isize, isize);
+                r++;
+            }
+            else
+            {
+                tb_memcpy(p, data + l * isize, isize);
+                l++;
+            }
+            p += isize;
+        }
+    }
+
+    // copy the left items
+    if (l < middle) 
+    {
+        tb_memcpy(p, data + l * isize, (middle - l) * isize);
+        p += (middle - l) * isize;
+    }
+    if (r < tail) tb_memcpy(p, data + r * isize, (tail - r) * isize);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_void_t tb_merge_sort(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail, tb_iterator_comp_t comp)
+{
+    // check
+    tb_assert_and_check_return(iterator && (tb_iterator_mode(iterator) & TB_ITERATOR_MODE_FORWARD));
+    tb_check_return(head != tail);
+
+    // the items count
+    tb_size_t size = tb_distance(iterator, head, tail);
+    tb_check_return(size > 1);
+
+    // init buffer for the items and the merged items
+    tb_size_t   step = tb_iterator_step(iterator);
+    tb_size_t   isize = step <= sizeof(tb_pointer_t)? sizeof(tb_pointer_t) : step;
+    tb_byte_t*  buff = (tb_byte_t*)tb_malloc(size * isize * 2);
+    tb_assert_and_check_return(buff);
+
+    // the comparer
+    if (!comp) comp = tb_iterator_comp;
+
+    // save items
+    tb_size_t   itor;
+    tb_byte_t*  data = buff;
+    tb_byte_t*  temp = buff + size * isize;
+    tb_byte_t*  p = data;
+    for (itor = head; itor != tail; itor = tb_iterator_next(iterator, itor), p += isize)
+    {
+        if (step <= sizeof(tb_pointer_t)) *((tb_cpointer_t*)p) = tb_iterator_item(iterator, itor);
+        else tb_memcpy(p, tb_iterator_item(iterator, itor), step);
+    }
+
+    // merge the runs bottom-up: 1 + 1 => 2, 2 + 2 => 4, ...
+    tb_size_t width;
+    for (width = 1; width < size; width <<= 1)
+    {
+        // merge all runs
+        tb_size_t l, m, r;
+        for (l = 0; l < size; l = r)
+        {
+            m = tb_min(l + width, size);
+            r = tb_min(m + width, size);
+            tb_merge_sort_merge(iterator, data, temp, l, m, r, step, isize, comp);
+        }
+
+        // swap the buffers
+        p       = data;
+        data    = temp;
+        temp    = p;
+    }
+
+    // copy items back
+    for (itor = head, p = data; itor != tail; itor = tb_iterator_next(iterator, itor), p += isize)
+        tb_iterator_copy(iterator, itor, tb_merge_sort_item(p, step));
+
+    // exit buffer
+    tb_free(buff);
+}
+tb_void_t tb_merge_sort_all(tb_iterator_ref_t iterator, tb_iterator_comp_t comp)
+{
+    tb_merge_sort(iterator, tb_iterator_head(iterator), tb_iterator_tail(iterator), comp);
+}
@@ -0,0 +1,286 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        parallel_sort.c
+ * @ingroup     algorithm
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "parallel_sort.h"
+#include "sort.h"
+#include "intro_sort.h"
+#include "../libc/libc.h"
+#include "../platform/semaphore.h"
+#include "../platform/processor.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the max chunks count
+#define TB_PARALLEL_SORT_CHUNK_MAXN         (64)
+
+// the min items count of each chunk
+#define TB_PARALLEL_SORT_CHUNK_MINN         (TB_PARALLEL_SORT_MINN >> 2)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the parallel sort type
+typedef struct __tb_parallel_sort_t
+{
+    // the iterator
+    tb_iterator_ref_t           iterator;
+
+    // the comparer
+    tb_iterator_comp_t          comp;
+
+    // the item step
+    tb_size_t                   step;
+
+    // the item size in the buffer
+    tb_size_t                   isize;
+
+    // the head of the whole range
+    tb_size_t                   head;
+
+    // the buffer for the left runs of merging
+    tb_byte_t*                  buffer;
+
+    // the semaphore for the finished tasks
+    tb_semaphore_ref_t          semaphore;
+
+}tb_parallel_sort_t;
+
+// the parallel sort task type
+typedef struct __tb_parallel_sort_task_t
+{
+    // the sort
+    tb_parallel_sort_t*         sort;
+
+    // sort [head, tail) if middle == tail, otherwise merge the sorted runs: [head, middle) and [middle, tail) 
+    tb_size_t                   head;
+    tb_size_t                   middle;
+    tb_size_t                   tail;
+
+    // is finished?
+    tb_bool_t                   finished;
+
+}tb_parallel_sort_task_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_void_t tb_parallel_sort_merge(tb_parallel_sort_t* sort, tb_size_t head, tb_size_t middle, tb_size_t tail)
+{
+    // the iterator and comparer
+    tb_iterator_ref_t   iterator = sort->iterator;
+    tb_iterator_comp_t  comp = sort->comp;
+
+    // be already sorted?
+    tb_check_return(comp(iterator, tb_iterator_item(iterator, middle), tb_iterator_item(iterator, middle - 1)) < 0);
+
+    // save the left run to the buffer
+    tb_size_t   i;
+    tb_size_t   step = sort->step;
+    tb_size_t   isize = sort->isize;
+    tb_byte_t*  data = sort->buffer + (head - sort->head) * isize;
+    tb_byte_t*  p = data;
+    for (i = head; i < middle; i++, p += isize)
+    {
+        if (step <= sizeof(tb_pointer_t)) *((tb_cpointer_t*)p) = tb_iterator_item(iterator, i);
+        else tb_memcpy(p, tb_iterator_item(iterator, i), step);
+    }
+
+    // merge the buffer and the right run to [head, tail), the left item is the first if they are equal
+    tb_byte_t*      e = p;
+    tb_size_t       r = middle;
+    tb_size_t       o = head;
+    tb_cpointer_t   item;
+    for (p = data; p < e && r < tail; o++)
+    {
+        item = step <= sizeof(tb_pointer_t)? *((tb_cpointer_t*)p) : (tb_cpointer_t)p;
+        if (comp(iterator, tb_iterator_item(iterator, r), item) < 0)
+        {
+            tb_iterator_copy(iterator, o, tb_iterator_item(iterator, r));
+            r++;
+        }
+        else
+        {
+            tb_iterator_copy(iterator, o, item);
+            p += isize;
+        }
+    }
+
+    // copy the left items of the buffer, the left items of the right run have been in place
+    for (; p < e; p += isize, o++)
+        tb_iterator_copy(iterator, o, step <= sizeof(tb_pointer_t)? *((tb_cpointer_t*)p) : (tb_cpointer_t)p);
+}
+static tb_void_t tb_parallel_sort_task_done(tb_thread_pool_worker_ref_t worker, tb_cpointer_t priv)
+{
+    // check
+    tb_parallel_sort_task_t* task = (tb_parallel_sort_task_t*)priv;
+    tb_assert_and_check_return(task && task->sort);
+
+    // sort or merge it
+    if (task->middle == task->tail) tb_intro_sort(task->sort->iterator, task->head, task->tail, task->sort->comp);
+    else tb_parallel_sort_merge(task->sort, task->head, task->middle, task->tail);
+
+    // finished
+    task->finished = tb_true;
+}
+static tb_void_t tb_parallel_sort_task_exit(tb_thread_pool_worker_ref_t worker, tb_cpointer_t priv)
+{
+    // check
+    tb_parallel_sort_task_t* task = (tb_parallel_sort_task_t*)priv;
+    tb_assert_and_check_return(task && task->sort);
+
+    // notify the finished or killed task
+    tb_semaphore_post(task->sort->semaphore, 1);
+}
+static tb_void_t tb_parallel_sort_done(tb_parallel_sort_t* sort, tb_thread_pool_ref_t pool, tb_parallel_sort_task_t* tasks, tb_size_t count)
+{
+    // post tasks, the last task is done in the current thread
+    tb_size_t i = 0;
+    tb_size_t posted = 0;
+    for (i = 0; i + 1 < count; i++)
+    {
+        if (tb_thread_pool_task_post(pool, "parallel_sort", tb_parallel_sort_task_done, tb_parallel_sort_task_exit, &tasks[i], tb_false)) 
+            posted++;
+    }
+    tb_parallel_sort_task_done(tb_null, &tasks[count - 1]);
+
+    // wait the posted tasks
+    while (posted)
+    {
+        if (tb_semaphore_wait(sort->semaphore, -1) < 0) break;
+        posted--;
+    }
+
+    // do the failed or killed tasks
+    for (i = 0; i < count; i++)
+    {
+        if (!tasks[i].finished) tb_parallel_sort_task_done(tb_null, &tasks[i]);
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_void_t tb_parallel_sort(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail, tb_iterator_comp_t comp, tb_thread_pool_ref_t pool)
+{
+    // check
+    tb_assert_and_check_return(iterator && (tb_iterator_mode(iterator) & TB_ITERATOR_MODE_RACCESS));
+    tb_check_return(head != tail);
+
+    // the chunks count: about one chunk per processor
+    tb_size_t size = tail - head;
+    tb_size_t maxn = tb_processor_count();
+    tb_size_t chunks = 1;
+    while (chunks < maxn && chunks < TB_PARALLEL_SORT_CHUNK_MAXN && size / (chunks << 1) >= TB_PARALLEL_SORT_CHUNK_MINN) chunks <<= 1;
+
+    // too small? sort it directly
+    if (size < TB_PARALLEL_SORT_MINN || chunks < 2)
+    {
+        tb_sort(iterator, head, tail, comp);
+        return ;
+    }
+
+    // done
+    tb_parallel_sort_t          sort = {0};
+    tb_parallel_sort_task_t*    tasks = tb_null;
+    tb_bool_t                   ok = tb_false;
+    do
+    {
+        // the thread pool
+        if (!pool) pool = tb_thread_pool();
+        tb_assert_and_check_break(pool);
+
+        // init sort
+        sort.iterator   = iterator;
+        sort.comp       = comp? comp : tb_iterator_comp;
+        sort.step       = tb_iterator_step(iterator);
+        sort.isize      = sort.step <= sizeof(tb_pointer_t)? sizeof(tb_pointer_t) : sort.step;
+        sort.head       = head;
+        sort.buffer     = (tb_byte_t*)tb_malloc(size * sort.isize);
+        sort.semaphore  = tb_semaphore_init(0);
+        tb_assert_and_check_break(sort.buffer && sort.semaphore);
+
+        // init tasks
+        tasks = tb_nalloc0_type(chunks, tb_parallel_sort_task_t);
+        tb_assert_and_check_break(tasks);
+
+        // sort all chunks
+        tb_size_t i = 0;
+        tb_size_t n = size / chunks;
+        for (i = 0; i < chunks; i++)
+        {
+            tasks[i].sort       = &sort;
+            tasks[i].head       = head + i * n;
+            tasks[i].tail       = i + 1 < chunks? tasks[i].head + n : tail;
+            tasks[i].middle     = tasks[i].tail;
+        }
+        tb_parallel_sort_done(&sort, pool, tasks, chunks);
+
+        // merge the sorted chunks in pairs: 1 + 1 => 2, 2 + 2 => 4, ...
+        tb_size_t width;
+        tb_size_t count;
+        for (width = 1; width < chunks; width <<= 1)
+        {
+            for (i = 0, count = 0; i + width < chunks; i += width << 1, count++)
+            {
+                tasks[count].sort       = &sort;
+                tasks[count].head       = head + i * n;
+                tasks[count].middle     = head + (i + width) * n;
+                tasks[count].tail       = i + (width << 1) < chunks? head + (i + (width << 1)) * n : tail;
+                tasks[count].finished   = tb_false;
+            }
+            tb_parallel_sort_done(&sort, pool, tasks, count);
+        }
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // exit tasks
+    if (tasks) tb_free(tasks);
+    tasks = tb_null;
+
+    // exit semaphore
+    if (sort.semaphore) tb_semaphore_exit(sort.semaphore);
+    sort.semaphore = tb_null;
+
+    // exit buffer
+    if (sort.buffer) tb_free(sort.buffer);
+    sort.buffer = tb_null;
+
+    // failed? sort it directly
+    if (!ok) tb_sort(iterator, head, tail, comp);
+}
+tb_void_t tb_parallel_sort_all(tb_iterator_ref_t iterator, tb_iterator_comp_t comp, tb_thread_pool_ref_t pool)
+{
+    tb_parallel_sort(iterator, tb_iterator_head(iterator), tb_iterator_tail(iterator), comp, pool);
+}
@@ -0,0 +1,90 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        parallel_sort.h
+ * @ingroup     algorithm
+ *
+ */
+#ifndef TB_ALGORITHM_PARALLEL_SORT_H
+#define TB_ALGORITHM_PARALLEL_SORT_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../platform/thread_pool.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// the min items count for sorting in parallel, uses tb_sort() if the items are less than it
+#define TB_PARALLEL_SORT_MINN           (1 << 16)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! the parallel sorter, O(nlog(n))
+ *
+ * the range is split into some chunks (about one chunk per processor),
+ * the chunks are sorted by tb_intro_sort() in the thread pool, 
+ * and the sorted chunks are merged in pairs by the thread pool too.
+ *
+ * @note the comparer will be called in the multi-threads, 
+ * and it uses tb_sort() directly if the range is too small or there is only one processor.
+ *
+ * @code
+ 
+    // init iterator
+    tb_array_iterator_t array_iterator;
+    tb_iterator_ref_t   iterator = tb_iterator_make_for_long(&array_iterator, data, size);
+
+    // sort it in the global thread pool
+    tb_parallel_sort_all(iterator, tb_null, tb_null);
+ * @endcode
+ *
+ * @param iterator  the random access iterator
+ * @param head      the iterator head
+ * @param tail      the iterator tail
+ * @param comp      the comparer
+ * @param pool      the thread pool, uses the global thread pool if be null
+ */
+tb_void_t           tb_parallel_sort(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail, tb_iterator_comp_t comp, tb_thread_pool_ref_t pool);
+
+/*! the parallel sorter for all
+ *
+ * @param iterator  the random access iterator
+ * @param comp      the comparer
+ * @param pool      the thread pool, uses the global thread pool if be null
+ */
+tb_void_t           tb_parallel_sort_all(tb_iterator_ref_t iterator, tb_iterator_comp_t comp, tb_thread_pool_ref_t pool);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+#endif
@@ -29,10 +29,9 @@
  */
 #include "sort.h"
 #include "distance.h"
-#include "heap_sort.h"
 #include "quick_sort.h"
-#include "insert_sort.h"
-#include "bubble_sort.h"
+#include "intro_sort.h"
+#include "merge_sort.h"
 #include "../libc/libc.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -57,12 +56,8 @@ tb_void_t tb_sort(tb_iterator_ref_t iterator, tb_size_t head, tb_size_t tail, tb
     tb_quick_sort(iterator, head, tail, comp);
 #else
     // random access iterator? 
-    if (tb_iterator_mode(iterator) & TB_ITERATOR_MODE_RACCESS) 
-    {
-        if (tb_distance(iterator, head, tail) > 100000) tb_heap_sort(iterator, head, tail, comp);
-        else tb_quick_sort(iterator, head, tail, comp); //!< @note the recursive stack size is limit
-    }
-    else tb_bubble_sort(iterator, head, tail, comp);
+    if (tb_iterator_mode(iterator) & TB_ITERATOR_MODE_RACCESS) tb_intro_sort(iterator, head, tail, comp);
+    else tb_merge_sort(iterator, head, tail, comp);
 #endif
 }
 tb_void_t tb_sort_all(tb_iterator_ref_t iterator, tb_iterator_comp_t comp)
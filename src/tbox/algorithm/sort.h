@@ -41,6 +41,9 @@ __tb_extern_c_enter__
  */
 
 /*! the sorter
+ *
+ * uses tb_intro_sort() for the random access iterator, 
+ * otherwise uses tb_merge_sort() for the forward iterator, e.g. tb_list, tb_single_list
  *
  * @param iterator  the iterator
  * @param head      the iterator head
@@ -0,0 +1,186 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        typed_sort.h
+ * @ingroup     algorithm
+ *
+ */
+#ifndef TB_ALGORITHM_TYPED_SORT_H
+#define TB_ALGORITHM_TYPED_SORT_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../container/typed_element.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// the max items count for the insertion sort of the typed sort
+#define TB_TYPED_SORT_INSERT_MAXN           (16)
+
+/*! declare the typed sort for the POD type array
+ *
+ * it will generate the inlined sorter: prefix_sort(data, size), 
+ * it is an introsort with the inlined less operation: 
+ *
+ * - the quick sort with the median of three pivot
+ * - the heap sort if the recursion is too deep
+ * - the insertion sort for the small ranges
+ *
+ * @code
+ 
+    // declare the sorter of tb_size_t
+    TB_TYPED_SORT_DECL(tb_size, tb_size_t, tb_typed_less)
+
+    // sort the array
+    tb_size_t data[] = {3, 1, 2};
+    tb_size_sort(data, tb_arrayn(data));
+ * @endcode
+ *
+ * @param prefix        the prefix name of the sorter
+ * @param type          the item type
+ * @param less          the less operation, e.g. tb_typed_less, tb_typed_greater, tb_typed_less_mem
+ */
+#define TB_TYPED_SORT_DECL(prefix, type, less) \
+    \
+    /* the insertion sort for the small range */ \
+    static __tb_inline__ tb_void_t prefix##_sort_insert(type* data, tb_size_t size) \
+    { \
+        tb_size_t i = 1; \
+        for (; i < size; i++) \
+        { \
+            type        value = data[i]; \
+            tb_size_t   j = i; \
+            while (j && less(value, data[j - 1])) \
+            { \
+                data[j] = data[j - 1]; \
+                j--; \
+            } \
+            data[j] = value; \
+        } \
+    } \
+    \
+    /* the heap sort if the quick sort is too deep */ \
+    static __tb_inline__ tb_void_t prefix##_sort_heap_down(type* data, tb_size_t hole, tb_size_t size) \
+    { \
+        type        value = data[hole]; \
+        tb_size_t   child; \
+        while ((child = (hole << 1) + 1) < size) \
+        { \
+            if (child + 1 < size && less(data[child], data[child + 1])) child++; \
+            if (!less(value, data[child])) break; \
+            data[hole] = data[child]; \
+            hole = child; \
+        } \
+        data[hole] = value; \
+    } \
+    static __tb_inline__ tb_void_t prefix##_sort_heap(type* data, tb_size_t size) \
+    { \
+        /* make the max-heap */ \
+        tb_size_t i = size >> 1; \
+        while (i--) prefix##_sort_heap_down(data, i, size); \
+        \
+        /* move the maximum item to the tail */ \
+        for (i = size; i > 1; i--) \
+        { \
+            type value = data[0]; \
+            data[0] = data[i - 1]; \
+            data[i - 1] = value; \
+            prefix##_sort_heap_down(data, 0, i - 1); \
+        } \
+    } \
+    \
+    /* the introsort, recurse the smaller part and loop the larger part */ \
+    static __tb_inline__ tb_void_t prefix##_sort_intro(type* data, tb_size_t size, tb_size_t depth) \
+    { \
+        while (size > TB_TYPED_SORT_INSERT_MAXN) \
+        { \
+            /* too deep? uses the heap sort */ \
+            if (!depth--) \
+            { \
+                prefix##_sort_heap(data, size); \
+                return ; \
+            } \
+            \
+            /* sort the head, middle and last items, and uses the middle one as the pivot */ \
+            type        value; \
+            tb_size_t   m = size >> 1; \
+            tb_size_t   l = size - 1; \
+            if (less(data[m], data[0])) { value = data[m]; data[m] = data[0]; data[0] = value; } \
+            if (less(data[l], data[m])) { value = data[l]; data[l] = data[m]; data[m] = value; } \
+            if (less(data[m], data[0])) { value = data[m]; data[m] = data[0]; data[0] = value; } \
+            type pivot = data[m]; \
+            \
+            /* partition: [0, i) <= pivot, [j + 1, size) >= pivot */ \
+            tb_size_t i = 0; \
+            tb_size_t j = l; \
+            while (1) \
+            { \
+                while (less(data[i], pivot)) i++; \
+                while (less(pivot, data[j])) j--; \
+                if (i >= j) break; \
+                value = data[i]; data[i] = data[j]; data[j] = value; \
+                i++; \
+                j--; \
+            } \
+            \
+            /* sort the smaller part first */ \
+            j++; \
+            if (j < size - j) \
+            { \
+                prefix##_sort_intro(data, j, depth); \
+                data += j; \
+                size -= j; \
+            } \
+            else \
+            { \
+                prefix##_sort_intro(data + j, size - j, depth); \
+                size = j; \
+            } \
+        } \
+        \
+        /* sort the small range */ \
+        prefix##_sort_insert(data, size); \
+    } \
+    \
+    /* sort the array */ \
+    static __tb_inline__ tb_void_t prefix##_sort(type* data, tb_size_t size) \
+    { \
+        tb_size_t depth = 0; \
+        tb_size_t n = size; \
+        while (n >>= 1) depth += 2; \
+        prefix##_sort_intro(data, size, depth); \
+    }
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
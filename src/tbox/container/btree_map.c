@@ -0,0 +1,1333 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        btree_map.c
+ * @ingroup     container
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME                "btree_map"
+#define TB_TRACE_MODULE_DEBUG               (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "btree_map.h"
+#include "../libc/libc.h"
+#include "../math/math.h"
+#include "../utils/utils.h"
+#include "../memory/memory.h"
+#include "../platform/platform.h"
+#include "../algorithm/algorithm.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the tree height maxn, the inner node has three childs at least
+#define TB_BTREE_MAP_HEIGHT_MAXN                    (32)
+
+// the leaf items maxn, the leaf is aligned by the power of two of it for encoding the itor
+#define TB_BTREE_MAP_LEAF_MAXN                      (256)
+
+// the node items minn
+#define TB_BTREE_MAP_NODE_MINN                      (4)
+
+// the leaf name and data
+#define tb_btree_map_leaf_name(tree, leaf, i)       ((tb_byte_t*)&(leaf)[1] + (i) * (tree)->element_name.size)
+#define tb_btree_map_leaf_data(tree, leaf, i)       ((tb_byte_t*)&(leaf)[1] + (tree)->leaf_datas + (i) * (tree)->element_data.size)
+
+// the inner childs and name
+#define tb_btree_map_inner_childs(inner)            ((tb_pointer_t*)&(inner)[1])
+#define tb_btree_map_inner_name(tree, inner, i)     ((tb_byte_t*)&(inner)[1] + (tree)->inner_names + (i) * (tree)->element_name.size)
+
+// the itor: leaf | index
+#define tb_btree_map_itor_make(leaf, i)             ((tb_size_t)(leaf) | (i))
+#define tb_btree_map_itor_leaf(tree, itor)          ((tb_btree_map_leaf_t*)((itor) & ~((tree)->leaf_align - 1)))
+#define tb_btree_map_itor_index(tree, itor)         ((itor) & ((tree)->leaf_align - 1))
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the btree map leaf type, the names and datas follow it
+typedef struct __tb_btree_map_leaf_t
+{
+    // the prev leaf
+    struct __tb_btree_map_leaf_t*   prev;
+
+    // the next leaf
+    struct __tb_btree_map_leaf_t*   next;
+
+    // the items count
+    tb_size_t                       size;
+
+}tb_btree_map_leaf_t;
+
+// the btree map inner type, the childs and names follow it
+typedef struct __tb_btree_map_inner_t
+{
+    // the names count, the childs count is size + 1
+    tb_size_t                       size;
+
+}tb_btree_map_inner_t;
+
+// the btree map path type
+typedef struct __tb_btree_map_path_t
+{
+    // the inner node
+    tb_btree_map_inner_t*           inner;
+
+    // the child index
+    tb_size_t                       index;
+
+}tb_btree_map_path_t;
+
+// the btree map type
+typedef struct __tb_btree_map_t
+{
+    // the itor
+    tb_iterator_t                   itor;
+
+    // the allocator
+    tb_allocator_ref_t              allocator;
+
+    // the element for name
+    tb_element_t                    element_name;
+
+    // the element for data
+    tb_element_t                    element_data;
+
+    // the name type for comparing the integer names directly, the user-defined type if the comp func has been changed
+    tb_size_t                       name_type;
+
+    // the root node
+    tb_pointer_t                    root;
+
+    // the tree height, the root is leaf if be one
+    tb_size_t                       height;
+
+    // the head leaf
+    tb_btree_map_leaf_t*            head;
+
+    // the last leaf
+    tb_btree_map_leaf_t*            last;
+
+    // the items count
+    tb_size_t                       size;
+
+    // the leaves count
+    tb_size_t                       leaf_count;
+
+    // the leaf items maxn
+    tb_size_t                       leaf_maxn;
+
+    // the leaf datas offset
+    tb_size_t                       leaf_datas;
+
+    // the leaf bytes
+    tb_size_t                       leaf_bytes;
+
+    // the leaf alignment
+    tb_size_t                       leaf_align;
+
+    // the inner names maxn
+    tb_size_t                       inner_maxn;
+
+    // the inner names offset
+    tb_size_t                       inner_names;
+
+    // the inner bytes
+    tb_size_t                       inner_bytes;
+
+    // the temporary names for splitting nodes and removing range
+    tb_byte_t*                      names;
+
+    // the item
+    tb_btree_map_item_t             item;
+
+}tb_btree_map_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_btree_map_leaf_t* tb_btree_map_leaf_make(tb_btree_map_t* tree)
+{
+    // make leaf, it is aligned by leaf_align so we can get the leaf from the itor
+    tb_btree_map_leaf_t* leaf = (tb_btree_map_leaf_t*)tb_allocator_align_malloc(tree->allocator, tree->leaf_bytes, tree->leaf_align);
+    tb_assert_and_check_return_val(leaf, tb_null);
+
+    // init leaf
+    leaf->prev = tb_null;
+    leaf->next = tb_null;
+    leaf->size = 0;
+
+    // update the leaves count
+    tree->leaf_count++;
+
+    // ok
+    return leaf;
+}
+static tb_void_t tb_btree_map_leaf_free(tb_btree_map_t* tree, tb_btree_map_leaf_t* leaf)
+{
+    // update the leaves count
+    tb_assert(tree->leaf_count);
+    tree->leaf_count--;
+
+    // free it
+    tb_allocator_align_free(tree->allocator, leaf);
+}
+static tb_void_t tb_btree_map_leaf_exit(tb_btree_map_t* tree, tb_btree_map_leaf_t* leaf)
+{
+    // unlink it
+    if (leaf->prev) leaf->prev->next = leaf->next;
+    else tree->head = leaf->next;
+    if (leaf->next) leaf->next->prev = leaf->prev;
+    else tree->last = leaf->prev;
+
+    // free it
+    tb_btree_map_leaf_free(tree, leaf);
+}
+static tb_btree_map_inner_t* tb_btree_map_inner_make(tb_btree_map_t* tree)
+{
+    // make inner
+    tb_btree_map_inner_t* inner = (tb_btree_map_inner_t*)tb_allocator_malloc(tree->allocator, tree->inner_bytes);
+    tb_assert_and_check_return_val(inner, tb_null);
+
+    // init it
+    inner->size = 0;
+    return inner;
+}
+static tb_void_t tb_btree_map_node_exit(tb_btree_map_t* tree, tb_pointer_t node, tb_size_t height)
+{
+    // inner?
+    tb_size_t i = 0;
+    if (height > 1)
+    {
+        // free names
+        tb_btree_map_inner_t* inner = (tb_btree_map_inner_t*)node;
+        if (tree->element_name.free)
+        {
+            for (i = 0; i < inner->size; i++)
+                tree->element_name.free(&tree->element_name, tb_btree_map_inner_name(tree, inner, i));
+        }
+
+        // exit childs
+        tb_pointer_t* childs = tb_btree_map_inner_childs(inner);
+        for (i = 0; i <= inner->size; i++)
+            tb_btree_map_node_exit(tree, childs[i], height - 1);
+
+        // free it
+        tb_allocator_free(tree->allocator, inner);
+    }
+    else
+    {
+        // free items
+        tb_btree_map_leaf_t* leaf = (tb_btree_map_leaf_t*)node;
+        for (i = 0; i < leaf->size; i++)
+        {
+            if (tree->element_name.free) tree->element_name.free(&tree->element_name, tb_btree_map_leaf_name(tree, leaf, i));
+            if (tree->element_data.free) tree->element_data.free(&tree->element_data, tb_btree_map_leaf_data(tree, leaf, i));
+        }
+
+        // free it
+        tb_btree_map_leaf_free(tree, leaf);
+    }
+}
+static __tb_inline__ tb_long_t tb_btree_map_comp(tb_btree_map_t* tree, tb_cpointer_t buff, tb_cpointer_t name)
+{
+    return tree->element_name.comp(&tree->element_name, tree->element_name.data(&tree->element_name, buff), name);
+}
+static tb_size_t tb_btree_map_bound(tb_btree_map_t* tree, tb_byte_t const* names, tb_size_t size, tb_cpointer_t name, tb_bool_t upper)
+{
+    // find the first name which is not less than (or greater than if upper) the given name
+    tb_size_t l = 0;
+    tb_size_t r = size;
+    tb_size_t step = tree->element_name.size;
+    tb_size_t m;
+    switch (tree->name_type)
+    {
+    // compare the long names directly without calling the element functions
+    case TB_ELEMENT_TYPE_LONG:
+        while (l < r)
+        {
+            m = (l + r) >> 1;
+            if (((tb_long_t const*)names)[m] < (tb_long_t)name || (upper && ((tb_long_t const*)names)[m] == (tb_long_t)name)) l = m + 1;
+            else r = m;
+        }
+        return l;
+    // compare the size names directly without calling the element functions
+    case TB_ELEMENT_TYPE_SIZE:
+        while (l < r)
+        {
+            m = (l + r) >> 1;
+            if (((tb_size_t const*)names)[m] < (tb_size_t)name || (upper && ((tb_size_t const*)names)[m] == (tb_size_t)name)) l = m + 1;
+            else r = m;
+        }
+        return l;
+    default:
+        break;
+    }
+    while (l < r)
+    {
+        m = (l + r) >> 1;
+        tb_long_t c = tb_btree_map_comp(tree, names + m * step, name);
+        if (c < 0 || (upper && !c)) l = m + 1;
+        else r = m;
+    }
+    return l;
+}
+static tb_btree_map_leaf_t* tb_btree_map_leaf_find(tb_btree_map_t* tree, tb_cpointer_t name, tb_btree_map_path_t* path)
+{
+    // check
+    tb_assert(tree->root && tree->height);
+
+    // walk the inner nodes
+    tb_size_t       depth = 0;
+    tb_pointer_t    node = tree->root;
+    for (depth = 0; depth + 1 < tree->height; depth++)
+    {
+        // the child index, all names of the child i are in [name[i - 1], name[i])
+        tb_btree_map_inner_t* inner = (tb_btree_map_inner_t*)node;
+        tb_size_t index = tb_btree_map_bound(tree, tb_btree_map_inner_name(tree, inner, 0), inner->size, name, tb_true);
+
+        // save path
+        if (path)
+        {
+            path[depth].inner = inner;
+            path[depth].index = index;
+        }
+
+        // the child
+        node = tb_btree_map_inner_childs(inner)[index];
+    }
+
+    // the leaf
+    return (tb_btree_map_leaf_t*)node;
+}
+static tb_void_t tb_btree_map_leaf_copy(tb_btree_map_t* tree, tb_btree_map_leaf_t* dst, tb_size_t dpos, tb_btree_map_leaf_t* src, tb_size_t spos, tb_size_t size)
+{
+    tb_memmov(tb_btree_map_leaf_name(tree, dst, dpos), tb_btree_map_leaf_name(tree, src, spos), size * tree->element_name.size);
+    tb_memmov(tb_btree_map_leaf_data(tree, dst, dpos), tb_btree_map_leaf_data(tree, src, spos), size * tree->element_data.size);
+}
+static tb_void_t tb_btree_map_leaf_insert(tb_btree_map_t* tree, tb_btree_map_leaf_t* leaf, tb_size_t pos, tb_cpointer_t name, tb_cpointer_t data)
+{
+    // check
+    tb_assert(pos <= leaf->size && leaf->size < tree->leaf_maxn);
+
+    // move the items after it
+    if (pos < leaf->size) tb_btree_map_leaf_copy(tree, leaf, pos + 1, leaf, pos, leaf->size - pos);
+
+    // dupl item
+    tree->element_name.dupl(&tree->element_name, tb_btree_map_leaf_name(tree, leaf, pos), name);
+    tree->element_data.dupl(&tree->element_data, tb_btree_map_leaf_data(tree, leaf, pos), data);
+
+    // update size
+    leaf->size++;
+    tree->size++;
+}
+static tb_void_t tb_btree_map_leaf_remove(tb_btree_map_t* tree, tb_btree_map_leaf_t* leaf, tb_size_t pos, tb_size_t size)
+{
+    // check
+    tb_assert(pos + size <= leaf->size);
+
+    // free items
+    if (tree->element_name.free || tree->element_data.free)
+    {
+        tb_size_t i = 0;
+        for (i = pos; i < pos + size; i++)
+        {
+            if (tree->element_name.free) tree->element_name.free(&tree->element_name, tb_btree_map_leaf_name(tree, leaf, i));
+            if (tree->element_data.free) tree->element_data.free(&tree->element_data, tb_btree_map_leaf_data(tree, leaf, i));
+        }
+    }
+
+    // move the items after them
+    if (pos + size < leaf->size) tb_btree_map_leaf_copy(tree, leaf, pos, leaf, pos + size, leaf->size - pos - size);
+
+    // update size
+    leaf->size -= size;
+    tree->size -= size;
+}
+static tb_void_t tb_btree_map_inner_insert(tb_btree_map_t* tree, tb_btree_map_inner_t* inner, tb_size_t index, tb_byte_t const* name, tb_pointer_t child)
+{
+    // check
+    tb_assert(index <= inner->size && inner->size < tree->inner_maxn);
+
+    // insert name[index], the name will be moved to this node
+    tb_size_t step = tree->element_name.size;
+    tb_memmov(tb_btree_map_inner_name(tree, inner, index + 1), tb_btree_map_inner_name(tree, inner, index), (inner->size - index) * step);
+    tb_memcpy(tb_btree_map_inner_name(tree, inner, index), name, step);
+
+    // insert child[index + 1]
+    tb_pointer_t* childs = tb_btree_map_inner_childs(inner);
+    tb_memmov(childs + index + 2, childs + index + 1, (inner->size - index) * sizeof(tb_pointer_t));
+    childs[index + 1] = child;
+
+    // update size
+    inner->size++;
+}
+static tb_void_t tb_btree_map_inner_remove(tb_btree_map_t* tree, tb_btree_map_inner_t* inner, tb_size_t index)
+{
+    // check
+    tb_assert(index < inner->size);
+
+    // remove name[index], it has been freed or moved to the other node
+    tb_size_t step = tree->element_name.size;
+    tb_memmov(tb_btree_map_inner_name(tree, inner, index), tb_btree_map_inner_name(tree, inner, index + 1), (inner->size - index - 1) * step);
+
+    // remove child[index + 1]
+    tb_pointer_t* childs = tb_btree_map_inner_childs(inner);
+    tb_memmov(childs + index + 1, childs + index + 2, (inner->size - index - 1) * sizeof(tb_pointer_t));
+
+    // update size
+    inner->size--;
+}
+static tb_void_t tb_btree_map_inner_balance(tb_btree_map_t* tree, tb_btree_map_path_t* path, tb_size_t depth)
+{
+    // done
+    tb_size_t minn = tree->inner_maxn >> 1;
+    tb_size_t step = tree->element_name.size;
+    while (1)
+    {
+        // the inner node
+        tb_btree_map_inner_t*   inner = path[depth].inner;
+        tb_pointer_t*           childs = tb_btree_map_inner_childs(inner);
+
+        // the root? shrink the tree if it has only one child
+        if (!depth)
+        {
+            if (!inner->size)
+            {
+                tree->root = childs[0];
+                tree->height--;
+                tb_allocator_free(tree->allocator, inner);
+            }
+            break;
+        }
+
+        // enough?
+        tb_check_break(inner->size < minn);
+
+        // the parent and siblings
+        tb_btree_map_inner_t*   parent = path[depth - 1].inner;
+        tb_size_t               index = path[depth - 1].index;
+        tb_pointer_t*           pchilds = tb_btree_map_inner_childs(parent);
+        tb_btree_map_inner_t*   left = index? (tb_btree_map_inner_t*)pchilds[index - 1] : tb_null;
+        tb_btree_map_inner_t*   right = index < parent->size? (tb_btree_map_inner_t*)pchilds[index + 1] : tb_null;
+        tb_assert(left || right);
+
+        // borrow the last child from the left sibling
+        if (left && left->size > minn)
+        {
+            tb_pointer_t* lchilds = tb_btree_map_inner_childs(left);
+            tb_memmov(tb_btree_map_inner_name(tree, inner, 1), tb_btree_map_inner_name(tree, inner, 0), inner->size * step);
+            tb_memmov(childs + 1, childs, (inner->size + 1) * sizeof(tb_pointer_t));
+            tb_memcpy(tb_btree_map_inner_name(tree, inner, 0), tb_btree_map_inner_name(tree, parent, index - 1), step);
+            childs[0] = lchilds[left->size];
+            tb_memcpy(tb_btree_map_inner_name(tree, parent, index - 1), tb_btree_map_inner_name(tree, left, left->size - 1), step);
+            left->size--;
+            inner->size++;
+            break;
+        }
+
+        // borrow the first child from the right sibling
+        if (right && right->size > minn)
+        {
+            tb_pointer_t* rchilds = tb_btree_map_inner_childs(right);
+            tb_memcpy(tb_btree_map_inner_name(tree, inner, inner->size), tb_btree_map_inner_name(tree, parent, index), step);
+            childs[inner->size + 1] = rchilds[0];
+            tb_memcpy(tb_btree_map_inner_name(tree, parent, index), tb_btree_map_inner_name(tree, right, 0), step);
+            tb_memmov(tb_btree_map_inner_name(tree, right, 0), tb_btree_map_inner_name(tree, right, 1), (right->size - 1) * step);
+            tb_memmov(rchilds, rchilds + 1, right->size * sizeof(tb_pointer_t));
+            right->size--;
+            inner->size++;
+            break;
+        }
+
+        // merge the right node into the left node with the parent name between them
+        if (left)
+        {
+            right   = inner;
+            index   = index - 1;
+        }
+        else left   = inner;
+        tb_memcpy(tb_btree_map_inner_name(tree, left, left->size), tb_btree_map_inner_name(tree, parent, index), step);
+        tb_memcpy(tb_btree_map_inner_name(tree, left, left->size + 1), tb_btree_map_inner_name(tree, right, 0), right->size * step);
+        tb_memcpy(tb_btree_map_inner_childs(left) + left->size + 1, tb_btree_map_inner_childs(right), (right->size + 1) * sizeof(tb_pointer_t));
+        left->size += right->size + 1;
+        tb_assert(left->size <= tree->inner_maxn);
+        tb_btree_map_inner_remove(tree, parent, index);
+        tb_allocator_free(tree->allocator, right);
+
+        // balance the parent
+        depth--;
+    }
+}
+static tb_void_t tb_btree_map_leaf_balance(tb_btree_map_t* tree, tb_btree_map_leaf_t* leaf, tb_btree_map_path_t* path)
+{
+    // the root leaf? remove it if be empty
+    if (tree->height == 1)
+    {
+        if (!leaf->size)
+        {
+            tb_btree_map_leaf_exit(tree, leaf);
+            tree->root      = tb_null;
+            tree->height    = 0;
+        }
+        return ;
+    }
+
+    // enough?
+    tb_check_return(leaf->size < (tree->leaf_maxn >> 1));
+
+    // the parent
+    tb_size_t               depth = tree->height - 2;
+    tb_btree_map_inner_t*   parent = path[depth].inner;
+    tb_size_t               index = path[depth].index;
+    tb_pointer_t*           childs = tb_btree_map_inner_childs(parent);
+
+    /* we never move the items before the removed items,
+     * so the itor of the previous item is still valid after removing items, e.g. tb_remove_if()
+     *
+     * the empty leaf will be removed directly, 
+     * and the last leaf of the parent may be not half full if it is not empty.
+     */
+    if (!leaf->size && index)
+    {
+        if (tree->element_name.free) tree->element_name.free(&tree->element_name, tb_btree_map_inner_name(tree, parent, index - 1));
+        tb_btree_map_inner_remove(tree, parent, index - 1);
+        tb_btree_map_leaf_exit(tree, leaf);
+        tb_btree_map_inner_balance(tree, path, depth);
+    }
+    // merge the right sibling into it or borrow items from the right sibling
+    else if (index < parent->size)
+    {
+        tb_btree_map_leaf_t* right = (tb_btree_map_leaf_t*)childs[index + 1];
+        if (leaf->size + right->size <= tree->leaf_maxn)
+        {
+            tb_btree_map_leaf_copy(tree, leaf, leaf->size, right, 0, right->size);
+            leaf->size += right->size;
+            if (tree->element_name.free) tree->element_name.free(&tree->element_name, tb_btree_map_inner_name(tree, parent, index));
+            tb_btree_map_inner_remove(tree, parent, index);
+            tb_btree_map_leaf_exit(tree, right);
+            tb_btree_map_inner_balance(tree, path, depth);
+        }
+        else
+        {
+            // move the half different items
+            tb_size_t size = (right->size - leaf->size) >> 1;
+            tb_assert(size && size < right->size);
+            tb_btree_map_leaf_copy(tree, leaf, leaf->size, right, 0, size);
+            tb_btree_map_leaf_copy(tree, right, 0, right, size, right->size - size);
+            leaf->size += size;
+            right->size -= size;
+
+            // update the parent name
+            tb_byte_t* name = tb_btree_map_inner_name(tree, parent, index);
+            if (tree->element_name.free) tree->element_name.free(&tree->element_name, name);
+            tree->element_name.dupl(&tree->element_name, name, tree->element_name.data(&tree->element_name, tb_btree_map_leaf_name(tree, right, 0)));
+        }
+    }
+}
+static tb_size_t tb_btree_map_remove_names(tb_btree_map_t* tree, tb_cpointer_t lower, tb_cpointer_t upper, tb_bool_t bupper)
+{
+    // done
+    tb_size_t               removed = 0;
+    tb_btree_map_path_t     path[TB_BTREE_MAP_HEIGHT_MAXN];
+    while (tree->root)
+    {
+        // find the first item
+        tb_btree_map_leaf_t*    leaf = tb_btree_map_leaf_find(tree, lower, path);
+        tb_size_t               pos = tb_btree_map_bound(tree, tb_btree_map_leaf_name(tree, leaf, 0), leaf->size, lower, tb_false);
+
+        // the first item is in the next leaf? find it again with the first name of the next leaf
+        if (pos == leaf->size)
+        {
+            tb_check_break(leaf->next);
+            tb_memcpy(tree->names, tb_btree_map_leaf_name(tree, leaf->next, 0), tree->element_name.size);
+            lower = tree->element_name.data(&tree->element_name, tree->names);
+            continue ;
+        }
+
+        // find the end item in this leaf
+        tb_size_t end = bupper? pos + tb_btree_map_bound(tree, tb_btree_map_leaf_name(tree, leaf, pos), leaf->size - pos, upper, tb_false) : leaf->size;
+        tb_check_break(end > pos);
+
+        // save the first name of the next leaf before removing items
+        tb_bool_t bmore = (end == leaf->size && leaf->next)? tb_true : tb_false;
+        if (bmore) tb_memcpy(tree->names, tb_btree_map_leaf_name(tree, leaf->next, 0), tree->element_name.size);
+
+        // remove the items of this leaf at once
+        tb_btree_map_leaf_remove(tree, leaf, pos, end - pos);
+        tb_btree_map_leaf_balance(tree, leaf, path);
+        removed += end - pos;
+
+        // continue to remove the items of the next leaf?
+        tb_check_break(bmore);
+        lower = tree->element_name.data(&tree->element_name, tree->names);
+    }
+    return removed;
+}
+static tb_size_t tb_btree_map_itor_size(tb_iterator_ref_t iterator)
+{
+    // check
+    tb_btree_map_t* tree = (tb_btree_map_t*)iterator;
+    tb_assert(tree);
+
+    // the size
+    return tree->size;
+}
+static tb_size_t tb_btree_map_itor_head(tb_iterator_ref_t iterator)
+{
+    // check
+    tb_btree_map_t* tree = (tb_btree_map_t*)iterator;
+    tb_assert(tree);
+
+    // the head, all leaves are not empty
+    return tree->head? tb_btree_map_itor_make(tree->head, 0) : 0;
+}
+static tb_size_t tb_btree_map_itor_last(tb_iterator_ref_t iterator)
+{
+    // check
+    tb_btree_map_t* tree = (tb_btree_map_t*)iterator;
+    tb_assert(tree);
+
+    // the last
+    return tree->last? tb_btree_map_itor_make(tree->last, tree->last->size - 1) : 0;
+}
+static tb_size_t tb_btree_map_itor_tail(tb_iterator_ref_t iterator)
+{
+    return 0;
+}
+static tb_size_t tb_btree_map_itor_next(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_btree_map_t* tree = (tb_btree_map_t*)iterator;
+    tb_assert(tree && itor);
+
+    // the leaf and index
+    tb_btree_map_leaf_t*    leaf = tb_btree_map_itor_leaf(tree, itor);
+    tb_size_t               index = tb_btree_map_itor_index(tree, itor);
+
+    // the next item in this leaf?
+    if (index + 1 < leaf->size) return itor + 1;
+
+    // the first item of the next leaf
+    return leaf->next? tb_btree_map_itor_make(leaf->next, 0) : 0;
+}
+static tb_size_t tb_btree_map_itor_prev(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_btree_map_t* tree = (tb_btree_map_t*)iterator;
+    tb_assert(tree);
+
+    // the tail? return the last item
+    if (!itor) return tb_btree_map_itor_last(iterator);
+
+    // the leaf and index
+    tb_btree_map_leaf_t*    leaf = tb_btree_map_itor_leaf(tree, itor);
+    tb_size_t               index = tb_btree_map_itor_index(tree, itor);
+
+    // the previous item in this leaf?
+    if (index) return itor - 1;
+
+    // the last item of the previous leaf
+    return leaf->prev? tb_btree_map_itor_make(leaf->prev, leaf->prev->size - 1) : 0;
+}
+static tb_pointer_t tb_btree_map_itor_item(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_btree_map_t* tree = (tb_btree_map_t*)iterator;
+    tb_assert(tree && itor);
+
+    // the leaf and index
+    tb_btree_map_leaf_t*    leaf = tb_btree_map_itor_leaf(tree, itor);
+    tb_size_t               index = tb_btree_map_itor_index(tree, itor);
+    tb_assert_and_check_return_val(index < leaf->size, tb_null);
+
+    // get item
+    tree->item.name = tree->element_name.data(&tree->element_name, tb_btree_map_leaf_name(tree, leaf, index));
+    tree->item.data = tree->element_data.data(&tree->element_data, tb_btree_map_leaf_data(tree, leaf, index));
+    return &(tree->item);
+}
+static tb_void_t tb_btree_map_itor_copy(tb_iterator_ref_t iterator, tb_size_t itor, tb_cpointer_t item)
+{
+    // check
+    tb_btree_map_t* tree = (tb_btree_map_t*)iterator;
+    tb_assert(tree && itor);
+
+    // the leaf and index
+    tb_btree_map_leaf_t*    leaf = tb_btree_map_itor_leaf(tree, itor);
+    tb_size_t               index = tb_btree_map_itor_index(tree, itor);
+    tb_check_return(index < leaf->size);
+
+    // note: copy data only, will destroy the order if copy name
+    tree->element_data.copy(&tree->element_data, tb_btree_map_leaf_data(tree, leaf, index), item);
+}
+static tb_long_t tb_btree_map_itor_comp(tb_iterator_ref_t iterator, tb_cpointer_t lelement, tb_cpointer_t relement)
+{
+    // check
+    tb_btree_map_t* tree = (tb_btree_map_t*)iterator;
+    tb_assert(tree && tree->element_name.comp && lelement && relement);
+    
+    // done
+    return tree->element_name.comp(&tree->element_name, ((tb_btree_map_item_ref_t)lelement)->name, ((tb_btree_map_item_ref_t)relement)->name);
+}
+static tb_void_t tb_btree_map_itor_remove(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_btree_map_t* tree = (tb_btree_map_t*)iterator;
+    tb_assert(tree && itor);
+
+    // the leaf and index
+    tb_btree_map_leaf_t*    leaf = tb_btree_map_itor_leaf(tree, itor);
+    tb_size_t               index = tb_btree_map_itor_index(tree, itor);
+    tb_assert_and_check_return(index < leaf->size);
+
+    // remove it from the name, we need the path for balancing nodes
+    tb_btree_map_remove((tb_btree_map_ref_t)tree, tree->element_name.data(&tree->element_name, tb_btree_map_leaf_name(tree, leaf, index)));
+}
+static tb_void_t tb_btree_map_itor_remove_range(tb_iterator_ref_t iterator, tb_size_t prev, tb_size_t next, tb_size_t size)
+{
+    // check
+    tb_btree_map_t* tree = (tb_btree_map_t*)iterator;
+    tb_assert(tree);
+
+    // no size
+    tb_check_return(size);
+
+    // the first itor
+    tb_size_t itor = prev? tb_btree_map_itor_next(iterator, prev) : tb_btree_map_itor_head(iterator);
+    tb_assert_and_check_return(itor);
+
+    // save the lower and upper names, the items will be moved when removing them
+    tb_size_t step = tree->element_name.size;
+    tb_memcpy(tree->names, tb_btree_map_leaf_name(tree, tb_btree_map_itor_leaf(tree, itor), tb_btree_map_itor_index(tree, itor)), step);
+    if (next) tb_memcpy(tree->names + step, tb_btree_map_leaf_name(tree, tb_btree_map_itor_leaf(tree, next), tb_btree_map_itor_index(tree, next)), step);
+
+    // remove the items in the range [lower, upper)
+    tb_size_t removed = tb_btree_map_remove_names(tree, tree->element_name.data(&tree->element_name, tree->names), next? tree->element_name.data(&tree->element_name, tree->names + step) : tb_null, next? tb_true : tb_false);
+    tb_assert(removed == size);
+    tb_used(removed);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_btree_map_ref_t tb_btree_map_init(tb_size_t node_size, tb_element_t element_name, tb_element_t element_data)
+{
+    return tb_btree_map_init_with_allocator(tb_null, node_size, element_name, element_data);
+}
+tb_btree_map_ref_t tb_btree_map_init_with_allocator(tb_allocator_ref_t allocator, tb_size_t node_size, tb_element_t element_name, tb_element_t element_data)
+{
+    // check
+    tb_assert_and_check_return_val(element_name.size && element_name.data && element_name.dupl && element_name.comp, tb_null);
+    tb_assert_and_check_return_val(element_data.data && element_data.dupl && element_data.repl, tb_null);
+
+    // using the default node size
+    if (!node_size) node_size = TB_BTREE_MAP_NODE_SIZE_DEFAULT;
+
+    // done
+    tb_bool_t           ok = tb_false;
+    tb_btree_map_t*     tree = tb_null;
+    do
+    {
+        // duplicate the element data (e.g. string) to the given allocator
+        if (allocator && !element_name.allocator) element_name.allocator = allocator;
+        if (allocator && !element_data.allocator) element_data.allocator = allocator;
+
+        // no allocator? uses the global allocator
+        if (!allocator) allocator = tb_allocator();
+        tb_assert_and_check_break(allocator);
+
+        // make tree
+        tree = (tb_btree_map_t*)tb_allocator_malloc0(allocator, sizeof(tb_btree_map_t));
+        tb_assert_and_check_break(tree);
+
+        // init allocator
+        tree->allocator = allocator;
+
+        // init element
+        tree->element_name = element_name;
+        tree->element_data = element_data;
+
+        // the integer name type?
+        tree->name_type = TB_ELEMENT_TYPE_USER;
+        if (element_name.type == TB_ELEMENT_TYPE_LONG && element_name.comp == tb_element_long().comp) tree->name_type = TB_ELEMENT_TYPE_LONG;
+        else if (element_name.type == TB_ELEMENT_TYPE_SIZE && element_name.comp == tb_element_size().comp) tree->name_type = TB_ELEMENT_TYPE_SIZE;
+
+        // init item itor
+        tree->itor.mode             = TB_ITERATOR_MODE_FORWARD | TB_ITERATOR_MODE_REVERSE | TB_ITERATOR_MODE_MUTABLE;
+        tree->itor.priv             = tb_null;
+        tree->itor.step             = sizeof(tb_btree_map_item_t);
+        tree->itor.size             = tb_btree_map_itor_size;
+        tree->itor.head             = tb_btree_map_itor_head;
+        tree->itor.last             = tb_btree_map_itor_last;
+        tree->itor.tail             = tb_btree_map_itor_tail;
+        tree->itor.prev             = tb_btree_map_itor_prev;
+        tree->itor.next             = tb_btree_map_itor_next;
+        tree->itor.item             = tb_btree_map_itor_item;
+        tree->itor.copy             = tb_btree_map_itor_copy;
+        tree->itor.comp             = tb_btree_map_itor_comp;
+        tree->itor.remove           = tb_btree_map_itor_remove;
+        tree->itor.remove_range     = tb_btree_map_itor_remove_range;
+
+        // init leaf: | leaf | names ... | datas ... |
+        tb_size_t step = element_name.size + element_data.size;
+        tree->leaf_maxn = node_size > sizeof(tb_btree_map_leaf_t)? (node_size - sizeof(tb_btree_map_leaf_t)) / step : 0;
+        if (tree->leaf_maxn < TB_BTREE_MAP_NODE_MINN) tree->leaf_maxn = TB_BTREE_MAP_NODE_MINN;
+        if (tree->leaf_maxn > TB_BTREE_MAP_LEAF_MAXN) tree->leaf_maxn = TB_BTREE_MAP_LEAF_MAXN;
+        tree->leaf_datas = tb_align(tree->leaf_maxn * element_name.size, sizeof(tb_pointer_t));
+        tree->leaf_bytes = sizeof(tb_btree_map_leaf_t) + tree->leaf_datas + tree->leaf_maxn * element_data.size;
+        tree->leaf_align = tb_max(tb_align_pow2(tree->leaf_maxn), sizeof(tb_pointer_t) << 1);
+
+        // init inner: | inner | childs ... | names ... |
+        step = element_name.size + sizeof(tb_pointer_t);
+        tree->inner_maxn = node_size > sizeof(tb_btree_map_inner_t) + sizeof(tb_pointer_t)? (node_size - sizeof(tb_btree_map_inner_t) - sizeof(tb_pointer_t)) / step : 0;
+        if (tree->inner_maxn < TB_BTREE_MAP_NODE_MINN) tree->inner_maxn = TB_BTREE_MAP_NODE_MINN;
+        tree->inner_names = (tree->inner_maxn + 1) * sizeof(tb_pointer_t);
+        tree->inner_bytes = sizeof(tb_btree_map_inner_t) + tree->inner_names + tree->inner_maxn * element_name.size;
+
+        // make the temporary names
+        tree->names = (tb_byte_t*)tb_allocator_malloc0(allocator, element_name.size << 1);
+        tb_assert_and_check_break(tree->names);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (tree) tb_btree_map_exit((tb_btree_map_ref_t)tree);
+        tree = tb_null;
+    }
+
+    // ok?
+    return (tb_btree_map_ref_t)tree;
+}
+tb_void_t tb_btree_map_exit(tb_btree_map_ref_t self)
+{
+    // check
+    tb_btree_map_t* tree = (tb_btree_map_t*)self;
+    tb_assert_and_check_return(tree);
+
+    // clear it
+    tb_btree_map_clear(self);
+
+    // free the temporary names
+    if (tree->names) tb_allocator_free(tree->allocator, tree->names);
+    tree->names = tb_null;
+
+    // free it
+    tb_allocator_free(tree->allocator, tree);
+}
+tb_void_t tb_btree_map_clear(tb_btree_map_ref_t self)
+{
+    // check
+    tb_btree_map_t* tree = (tb_btree_map_t*)self;
+    tb_assert_and_check_return(tree);
+
+    // exit all nodes
+    if (tree->root) tb_btree_map_node_exit(tree, tree->root, tree->height);
+
+    // reset it
+    tree->root      = tb_null;
+    tree->height    = 0;
+    tree->head      = tb_null;
+    tree->last      = tb_null;
+    tree->size      = 0;
+    tb_assert(!tree->leaf_count);
+}
+tb_pointer_t tb_btree_map_get(tb_btree_map_ref_t self, tb_cpointer_t name)
+{
+    // find it
+    tb_size_t itor = tb_btree_map_find(self, name);
+    tb_check_return_val(itor, tb_null);
+
+    // get data
+    tb_btree_map_t* tree = (tb_btree_map_t*)self;
+    return tree->element_data.data(&tree->element_data, tb_btree_map_leaf_data(tree, tb_btree_map_itor_leaf(tree, itor), tb_btree_map_itor_index(tree, itor)));
+}
+tb_size_t tb_btree_map_find(tb_btree_map_ref_t self, tb_cpointer_t name)
+{
+    // check
+    tb_btree_map_t* tree = (tb_btree_map_t*)self;
+    tb_assert_and_check_return_val(tree, 0);
+
+    // empty?
+    tb_check_return_val(tree->root, 0);
+
+    // find it
+    tb_btree_map_leaf_t*    leaf = tb_btree_map_leaf_find(tree, name, tb_null);
+    tb_size_t               pos = tb_btree_map_bound(tree, tb_btree_map_leaf_name(tree, leaf, 0), leaf->size, name, tb_false);
+    return (pos < leaf->size && !tb_btree_map_comp(tree, tb_btree_map_leaf_name(tree, leaf, pos), name))? tb_btree_map_itor_make(leaf, pos) : 0;
+}
+tb_size_t tb_btree_map_lower_bound(tb_btree_map_ref_t self, tb_cpointer_t name)
+{
+    // check
+    tb_btree_map_t* tree = (tb_btree_map_t*)self;
+    tb_assert_and_check_return_val(tree, 0);
+
+    // empty?
+    tb_check_return_val(tree->root, 0);
+
+    // find it
+    tb_btree_map_leaf_t*    leaf = tb_btree_map_leaf_find(tree, name, tb_null);
+    tb_size_t               pos = tb_btree_map_bound(tree, tb_btree_map_leaf_name(tree, leaf, 0), leaf->size, name, tb_false);
+    if (pos < leaf->size) return tb_btree_map_itor_make(leaf, pos);
+
+    // it is the first item of the next leaf
+    return leaf->next? tb_btree_map_itor_make(leaf->next, 0) : 0;
+}
+tb_size_t tb_btree_map_upper_bound(tb_btree_map_ref_t self, tb_cpointer_t name)
+{
+    // check
+    tb_btree_map_t* tree = (tb_btree_map_t*)self;
+    tb_assert_and_check_return_val(tree, 0);
+
+    // empty?
+    tb_check_return_val(tree->root, 0);
+
+    // find it
+    tb_btree_map_leaf_t*    leaf = tb_btree_map_leaf_find(tree, name, tb_null);
+    tb_size_t               pos = tb_btree_map_bound(tree, tb_btree_map_leaf_name(tree, leaf, 0), leaf->size, name, tb_true);
+    if (pos < leaf->size) return tb_btree_map_itor_make(leaf, pos);
+
+    // it is the first item of the next leaf
+    return leaf->next? tb_btree_map_itor_make(leaf->next, 0) : 0;
+}
+tb_size_t tb_btree_map_insert(tb_btree_map_ref_t self, tb_cpointer_t name, tb_cpointer_t data)
+{
+    // check
+    tb_btree_map_t* tree = (tb_btree_map_t*)self;
+    tb_assert_and_check_return_val(tree, 0);
+
+    // make the root leaf if be empty
+    if (!tree->root)
+    {
+        tb_btree_map_leaf_t* leaf = tb_btree_map_leaf_make(tree);
+        tb_assert_and_check_return_val(leaf, 0);
+
+        tree->root      = leaf;
+        tree->height    = 1;
+        tree->head      = leaf;
+        tree->last      = leaf;
+    }
+
+    // find the leaf
+    tb_btree_map_path_t     path[TB_BTREE_MAP_HEIGHT_MAXN];
+    tb_btree_map_leaf_t*    leaf = tb_btree_map_leaf_find(tree, name, path);
+    tb_size_t               pos = tb_btree_map_bound(tree, tb_btree_map_leaf_name(tree, leaf, 0), leaf->size, name, tb_false);
+
+    // exists? replace data
+    if (pos < leaf->size && !tb_btree_map_comp(tree, tb_btree_map_leaf_name(tree, leaf, pos), name))
+    {
+        tree->element_data.repl(&tree->element_data, tb_btree_map_leaf_data(tree, leaf, pos), data);
+        return tb_btree_map_itor_make(leaf, pos);
+    }
+
+    // insert it directly if this leaf is not full
+    if (leaf->size < tree->leaf_maxn)
+    {
+        tb_btree_map_leaf_insert(tree, leaf, pos, name, data);
+        return tb_btree_map_itor_make(leaf, pos);
+    }
+
+    // compute the count of the new nodes, the full inner nodes will be splitted and the root may be grown
+    tb_size_t count = 1;
+    tb_size_t depth = tree->height - 1;
+    while (depth && path[depth - 1].inner->size == tree->inner_maxn)
+    {
+        count++;
+        depth--;
+    }
+    if (!depth) count++;
+    tb_assert_and_check_return_val(tree->height + (depth? 0 : 1) <= TB_BTREE_MAP_HEIGHT_MAXN, 0);
+
+    // make all new nodes first, so we need not restore the tree if no memory
+    tb_size_t       i = 0;
+    tb_pointer_t    nodes[TB_BTREE_MAP_HEIGHT_MAXN + 1];
+    for (i = 0; i < count; i++)
+    {
+        nodes[i] = i? (tb_pointer_t)tb_btree_map_inner_make(tree) : (tb_pointer_t)tb_btree_map_leaf_make(tree);
+        tb_check_break(nodes[i]);
+    }
+    if (i < count)
+    {
+        // free the new nodes
+        while (i--)
+        {
+            if (i) tb_allocator_free(tree->allocator, nodes[i]);
+            else tb_btree_map_leaf_free(tree, (tb_btree_map_leaf_t*)nodes[i]);
+        }
+        return 0;
+    }
+
+    /* split the leaf
+     *
+     * only move the new item to the right leaf if we append it to the last leaf, 
+     * so the leaves will be filled fully for the ascending names (e.g. time series)
+     */
+    tb_size_t               size = leaf->size;
+    tb_size_t               half = (size + 1) >> 1;
+    tb_bool_t               bappend = (pos == size && !leaf->next)? tb_true : tb_false;
+    tb_size_t               split = bappend? size : (pos < half? half - 1 : half);
+    tb_btree_map_leaf_t*    right = (tb_btree_map_leaf_t*)nodes[0];
+    tb_btree_map_leaf_copy(tree, right, 0, leaf, split, size - split);
+    right->size = size - split;
+    leaf->size  = split;
+
+    // link the right leaf
+    right->prev = leaf;
+    right->next = leaf->next;
+    if (leaf->next) leaf->next->prev = right;
+    else tree->last = right;
+    leaf->next = right;
+
+    // insert the new item
+    tb_size_t itor;
+    if (!bappend && pos < half) 
+    {
+        tb_btree_map_leaf_insert(tree, leaf, pos, name, data);
+        itor = tb_btree_map_itor_make(leaf, pos);
+    }
+    else
+    {
+        tb_btree_map_leaf_insert(tree, right, pos - split, name, data);
+        itor = tb_btree_map_itor_make(right, pos - split);
+    }
+
+    // the separator name of the right leaf
+    tb_size_t       step = tree->element_name.size;
+    tb_byte_t*      key = tree->names;
+    tb_byte_t*      key_up = tree->names + step;
+    tb_pointer_t    child = right;
+    tree->element_name.dupl(&tree->element_name, key, tree->element_name.data(&tree->element_name, tb_btree_map_leaf_name(tree, right, 0)));
+
+    // insert the separator name to the parents and split them if be full
+    for (i = 1, depth = tree->height - 1; depth; depth--)
+    {
+        // insert it directly if the parent is not full
+        tb_btree_map_inner_t*   inner = path[depth - 1].inner;
+        tb_size_t               index = path[depth - 1].index;
+        if (inner->size < tree->inner_maxn)
+        {
+            tb_btree_map_inner_insert(tree, inner, index, key, child);
+            child = tb_null;
+            break;
+        }
+
+        /* split the parent, the left node keeps half names and the middle name will be moved up
+         *
+         * names: | 0 | 1 | ... | half - 1 | half | ... | maxn - 1 | + the new name at index
+         */
+        tb_size_t               maxn = tree->inner_maxn;
+        tb_btree_map_inner_t*   inner_right = (tb_btree_map_inner_t*)nodes[i++];
+        tb_pointer_t*           childs = tb_btree_map_inner_childs(inner);
+        tb_pointer_t*           rchilds = tb_btree_map_inner_childs(inner_right);
+        half = (maxn + 1) >> 1;
+        if (index < half)
+        {
+            // the new name is in the left node and name[half - 1] will be moved up
+            tb_memcpy(tb_btree_map_inner_name(tree, inner_right, 0), tb_btree_map_inner_name(tree, inner, half), (maxn - half) * step);
+            tb_memcpy(rchilds, childs + half, (maxn - half + 1) * sizeof(tb_pointer_t));
+            tb_memcpy(key_up, tb_btree_map_inner_name(tree, inner, half - 1), step);
+            inner_right->size   = maxn - half;
+            inner->size         = half - 1;
+            tb_btree_map_inner_insert(tree, inner, index, key, child);
+            tb_swap(tb_byte_t*, key, key_up);
+        }
+        else if (index == half)
+        {
+            // the new name will be moved up
+            tb_memcpy(tb_btree_map_inner_name(tree, inner_right, 0), tb_btree_map_inner_name(tree, inner, half), (maxn - half) * step);
+            rchilds[0] = child;
+            tb_memcpy(rchilds + 1, childs + half + 1, (maxn - half) * sizeof(tb_pointer_t));
+            inner_right->size   = maxn - half;
+            inner->size         = half;
+        }
+        else
+        {
+            // the new name is in the right node and name[half] will be moved up
+            tb_memcpy(tb_btree_map_inner_name(tree, inner_right, 0), tb_btree_map_inner_name(tree, inner, half + 1), (maxn - half - 1) * step);
+            tb_memcpy(rchilds, childs + half + 1, (maxn - half) * sizeof(tb_pointer_t));
+            tb_memcpy(key_up, tb_btree_map_inner_name(tree, inner, half), step);
+            inner_right->size   = maxn - half - 1;
+            inner->size         = half;
+            tb_btree_map_inner_insert(tree, inner_right, index - half - 1, key, child);
+            tb_swap(tb_byte_t*, key, key_up);
+        }
+
+        // insert the right node to the parent
+        child = inner_right;
+    }
+
+    // grow the root
+    if (child)
+    {
+        tb_assert(i + 1 == count);
+        tb_btree_map_inner_t* root = (tb_btree_map_inner_t*)nodes[i];
+        tb_memcpy(tb_btree_map_inner_name(tree, root, 0), key, step);
+        tb_btree_map_inner_childs(root)[0] = tree->root;
+        tb_btree_map_inner_childs(root)[1] = child;
+        root->size = 1;
+        tree->root = root;
+        tree->height++;
+    }
+
+    // ok
+    return itor;
+}
+tb_void_t tb_btree_map_remove(tb_btree_map_ref_t self, tb_cpointer_t name)
+{
+    // check
+    tb_btree_map_t* tree = (tb_btree_map_t*)self;
+    tb_assert_and_check_return(tree);
+
+    // empty?
+    tb_check_return(tree->root);
+
+    // find it
+    tb_btree_map_path_t     path[TB_BTREE_MAP_HEIGHT_MAXN];
+    tb_btree_map_leaf_t*    leaf = tb_btree_map_leaf_find(tree, name, path);
+    tb_size_t               pos = tb_btree_map_bound(tree, tb_btree_map_leaf_name(tree, leaf, 0), leaf->size, name, tb_false);
+    tb_check_return(pos < leaf->size && !tb_btree_map_comp(tree, tb_btree_map_leaf_name(tree, leaf, pos), name));
+
+    // remove it
+    tb_btree_map_leaf_remove(tree, leaf, pos, 1);
+    tb_btree_map_leaf_balance(tree, leaf, path);
+}
+tb_size_t tb_btree_map_remove_range(tb_btree_map_ref_t self, tb_cpointer_t lower, tb_cpointer_t upper)
+{
+    // check
+    tb_btree_map_t* tree = (tb_btree_map_t*)self;
+    tb_assert_and_check_return_val(tree, 0);
+
+    // remove them
+    return tb_btree_map_remove_names(tree, lower, upper, tb_true);
+}
+tb_bool_t tb_btree_map_load(tb_btree_map_ref_t self, tb_btree_map_item_t const* items, tb_size_t size)
+{
+    // check
+    tb_btree_map_t* tree = (tb_btree_map_t*)self;
+    tb_assert_and_check_return_val(tree && (items || !size), tb_false);
+
+    // check order before clearing the old items
+    tb_size_t i = 0;
+    tb_size_t j = 0;
+    tb_size_t k = 0;
+    for (k = 1; k < size; k++)
+    {
+        if (tree->element_name.comp(&tree->element_name, items[k - 1].name, items[k].name) >= 0)
+        {
+            tb_trace_e("the loaded items are not sorted or unique at %lu!", k);
+            return tb_false;
+        }
+    }
+
+    // clear the old items
+    tb_btree_map_clear(self);
+    tb_check_return_val(size, tb_true);
+
+    // compute the nodes count of all levels
+    tb_size_t leaf_count = (size + tree->leaf_maxn - 1) / tree->leaf_maxn;
+    tb_size_t node_count = leaf_count;
+    tb_size_t count = leaf_count;
+    while (count > 1)
+    {
+        count = (count + tree->inner_maxn) / (tree->inner_maxn + 1);
+        node_count += count;
+    }
+
+    // done
+    tb_bool_t       ok = tb_false;
+    tb_size_t       made = 0;
+    tb_pointer_t*   nodes = tb_null;
+    do
+    {
+        // make all nodes first: | leaves ... | inners of level 1 ... | inners of level 2 ... | root |
+        nodes = (tb_pointer_t*)tb_allocator_nalloc(tree->allocator, node_count, sizeof(tb_pointer_t));
+        tb_assert_and_check_break(nodes);
+        for (made = 0; made < node_count; made++)
+        {
+            nodes[made] = made < leaf_count? (tb_pointer_t)tb_btree_map_leaf_make(tree) : (tb_pointer_t)tb_btree_map_inner_make(tree);
+            tb_check_break(nodes[made]);
+        }
+        tb_check_break(made == node_count);
+
+        // fill leaves, the items are distributed evenly, so all leaves are at least half full
+        tb_btree_map_leaf_t* prev = tb_null;
+        for (i = 0, k = 0; i < leaf_count; i++)
+        {
+            // dupl items
+            tb_btree_map_leaf_t*    leaf = (tb_btree_map_leaf_t*)nodes[i];
+            tb_size_t               n = size / leaf_count + (i < size % leaf_count);
+            for (j = 0; j < n; j++, k++)
+            {
+                tree->element_name.dupl(&tree->element_name, tb_btree_map_leaf_name(tree, leaf, j), items[k].name);
+                tree->element_data.dupl(&tree->element_data, tb_btree_map_leaf_data(tree, leaf, j), items[k].data);
+            }
+            leaf->size = n;
+
+            // link it
+            leaf->prev = prev;
+            if (prev) prev->next = leaf;
+            prev = leaf;
+        }
+        tb_assert(k == size);
+        tree->head  = (tb_btree_map_leaf_t*)nodes[0];
+        tree->last  = prev;
+        tree->size  = size;
+
+        // build the inner nodes level by level
+        tb_size_t base = 0;
+        tb_size_t next = leaf_count;
+        tb_size_t height = 1;
+        count = leaf_count;
+        while (count > 1)
+        {
+            tb_size_t inner_count = (count + tree->inner_maxn) / (tree->inner_maxn + 1);
+            for (i = 0, k = base; i < inner_count; i++)
+            {
+                tb_btree_map_inner_t*   inner = (tb_btree_map_inner_t*)nodes[next + i];
+                tb_pointer_t*           childs = tb_btree_map_inner_childs(inner);
+                tb_size_t               n = count / inner_count + (i < count % inner_count);
+                for (j = 0; j < n; j++, k++)
+                {
+                    // save child
+                    childs[j] = nodes[k];
+
+                    // the separator name is the first name of the child
+                    if (j)
+                    {
+                        tb_size_t       l = 1;
+                        tb_pointer_t    node = nodes[k];
+                        for (l = 1; l < height; l++) node = tb_btree_map_inner_childs((tb_btree_map_inner_t*)node)[0];
+                        tree->element_name.dupl(&tree->element_name, tb_btree_map_inner_name(tree, inner, j - 1), tree->element_name.data(&tree->element_name, tb_btree_map_leaf_name(tree, (tb_btree_map_leaf_t*)node, 0)));
+                    }
+                }
+                inner->size = n - 1;
+            }
+
+            // the next level
+            base    = next;
+            next   += inner_count;
+            count   = inner_count;
+            height++;
+        }
+        tb_assert(next == node_count);
+
+        // init root
+        tree->root      = nodes[base];
+        tree->height    = height;
+        tb_assert_and_check_break(height <= TB_BTREE_MAP_HEIGHT_MAXN);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // free the made nodes if failed
+    if (!ok && nodes && !tree->root)
+    {
+        while (made--)
+        {
+            if (made < leaf_count) tb_btree_map_leaf_free(tree, (tb_btree_map_leaf_t*)nodes[made]);
+            else tb_allocator_free(tree->allocator, nodes[made]);
+        }
+    }
+
+    // clear the tree if failed
+    if (!ok && tree->root) tb_btree_map_clear(self);
+
+    // free nodes
+    if (nodes) tb_allocator_free(tree->allocator, nodes);
+
+    // ok?
+    return ok;
+}
+tb_size_t tb_btree_map_size(tb_btree_map_ref_t self)
+{
+    // check
+    tb_btree_map_t* tree = (tb_btree_map_t*)self;
+    tb_assert_and_check_return_val(tree, 0);
+
+    // the size
+    return tree->size;
+}
+tb_size_t tb_btree_map_maxn(tb_btree_map_ref_t self)
+{
+    // check
+    tb_btree_map_t* tree = (tb_btree_map_t*)self;
+    tb_assert_and_check_return_val(tree, 0);
+
+    // the maxn
+    return tree->leaf_count * tree->leaf_maxn;
+}
+tb_size_t tb_btree_map_height(tb_btree_map_ref_t self)
+{
+    // check
+    tb_btree_map_t* tree = (tb_btree_map_t*)self;
+    tb_assert_and_check_return_val(tree, 0);
+
+    // the height
+    return tree->height;
+}
+#ifdef __tb_debug__
+tb_void_t tb_btree_map_dump(tb_btree_map_ref_t self)
+{
+    // check
+    tb_btree_map_t* tree = (tb_btree_map_t*)self;
+    tb_assert_and_check_return(tree);
+
+    // trace
+    tb_trace_i("");
+    tb_trace_i("btree_map: size: %lu, height: %lu, leaves: %lu, leaf: %lu/%lu bytes, inner: %lu/%lu bytes", tree->size, tree->height, tree->leaf_count, tree->leaf_maxn, tree->leaf_bytes, tree->inner_maxn, tree->inner_bytes);
+
+    // done
+    tb_char_t name[4096];
+    tb_char_t data[4096];
+    tb_for_all_if (tb_btree_map_item_ref_t, item, self, item)
+    {
+        // trace
+        if (tree->element_name.cstr && tree->element_data.cstr)
+        {
+            tb_trace_i("    %s => %s", tree->element_name.cstr(&tree->element_name, item->name, name, sizeof(name)), tree->element_data.cstr(&tree->element_data, item->data, data, sizeof(data)));
+        }
+        else if (tree->element_name.cstr) 
+        {
+            tb_trace_i("    %s => %p", tree->element_name.cstr(&tree->element_name, item->name, name, sizeof(name)), item->data);
+        }
+        else if (tree->element_data.cstr) 
+        {
+            tb_trace_i("    %p => %s", item->name, tree->element_data.cstr(&tree->element_data, item->data, data, sizeof(data)));
+        }
+        else tb_trace_i("    %p => %p", item->name, item->data);
+    }
+}
+#endif
@@ -0,0 +1,286 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        btree_map.h
+ * @ingroup     container
+ *
+ */
+#ifndef TB_CONTAINER_BTREE_MAP_H
+#define TB_CONTAINER_BTREE_MAP_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "element.h"
+#include "iterator.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// the node size of eight l1 cache lines, e.g. 256 bytes for the 32 bytes cache line
+#define TB_BTREE_MAP_NODE_SIZE_SMALL                (TB_L1_CACHE_BYTES << 3)
+
+/// the node size of one page
+#define TB_BTREE_MAP_NODE_SIZE_PAGE                 (4096)
+
+/// the default node size
+#define TB_BTREE_MAP_NODE_SIZE_DEFAULT              (512)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the btree map item type
+typedef struct __tb_btree_map_item_t
+{
+    /// the item name
+    tb_pointer_t        name;
+
+    /// the item data
+    tb_pointer_t        data;
+
+}tb_btree_map_item_t, *tb_btree_map_item_ref_t;
+
+/*! the btree map ref type, the ordered map based on the b+tree
+ *
+ * <pre>
+ *
+ *                               inner: | c0 | k0 | c1 | k1 | c2 |
+ *                                         /        |          \
+ *                    ---------------------    ------------     -------------------
+ *                   |                                     |                      |
+ * leaf:      | names ... | datas ... | <=> | names ... | datas ... | <=> | names ... | datas ... |
+ *
+ * </pre>
+ *
+ * the names and datas of one node are stored in the continuous arrays and the node size matches
+ * the cache lines or pages, so we only need to touch a few cache lines for searching one node.
+ *
+ * all items are stored in the doubly linked leaves, so iterating them in order is very fast.
+ *
+ * the appended items (e.g. time series) will fill the leaves fully, 
+ * and the items before the removed items will never be moved, 
+ * so the itor of the previous item is still valid after removing items.
+ *
+ * @note the itor of the same item is mutable
+ */
+typedef tb_iterator_ref_t tb_btree_map_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init btree map
+ *
+ * @param node_size     the node bytes, using the default size if be zero, .e.g TB_BTREE_MAP_NODE_SIZE_PAGE
+ * @param element_name  the item for name, it must be comparable
+ * @param element_data  the item for data
+ *
+ * @return              the btree map
+ */
+tb_btree_map_ref_t      tb_btree_map_init(tb_size_t node_size, tb_element_t element_name, tb_element_t element_data);
+
+/*! init btree map with the given allocator
+ *
+ * the btree map, nodes and the duplicated element data (e.g. string) will be allocated from this allocator
+ *
+ * @param allocator     the allocator, uses the global allocator if be null
+ * @param node_size     the node bytes, using the default size if be zero, .e.g TB_BTREE_MAP_NODE_SIZE_PAGE
+ * @param element_name  the item for name, it must be comparable
+ * @param element_data  the item for data
+ *
+ * @return              the btree map
+ */
+tb_btree_map_ref_t      tb_btree_map_init_with_allocator(tb_allocator_ref_t allocator, tb_size_t node_size, tb_element_t element_name, tb_element_t element_data);
+
+/*! exit btree map
+ *
+ * @param btree_map     the btree map
+ */
+tb_void_t               tb_btree_map_exit(tb_btree_map_ref_t btree_map);
+
+/*! clear btree map
+ *
+ * @param btree_map     the btree map
+ */
+tb_void_t               tb_btree_map_clear(tb_btree_map_ref_t btree_map);
+
+/*! get item data from name
+ *
+ * @note 
+ * the return value may be zero if the item type is integer
+ * so we need call tb_btree_map_find for judging whether to get value successfully
+ *
+ * @param btree_map     the btree map
+ * @param name          the item name
+ *
+ * @return              the item data
+ */
+tb_pointer_t            tb_btree_map_get(tb_btree_map_ref_t btree_map, tb_cpointer_t name);
+
+/*! find item from name
+ *
+ * @code
+ *
+ * // find item
+ * tb_size_t itor = tb_btree_map_find(btree_map, name);
+ * if (itor != tb_iterator_tail(btree_map))
+ * {
+ *      // get item
+ *      tb_btree_map_item_ref_t item = (tb_btree_map_item_ref_t)tb_iterator_item(btree_map, itor);
+ *      tb_assert(item);
+ *
+ *      // remove it
+ *      tb_iterator_remove(btree_map, itor);
+ * }
+ * @endcode
+ *
+ * @param btree_map     the btree map
+ * @param name          the item name
+ *
+ * @return              the item itor, @note: the itor of the same item is mutable
+ */
+tb_size_t               tb_btree_map_find(tb_btree_map_ref_t btree_map, tb_cpointer_t name);
+
+/*! find the first item which is not less than the given name
+ *
+ * @code
+ *
+ * // walk the items in the range [lower, upper)
+ * tb_size_t itor = tb_btree_map_lower_bound(btree_map, lower);
+ * tb_size_t tail = tb_btree_map_lower_bound(btree_map, upper);
+ * for (; itor != tail; itor = tb_iterator_next(btree_map, itor))
+ * {
+ *      tb_btree_map_item_ref_t item = (tb_btree_map_item_ref_t)tb_iterator_item(btree_map, itor);
+ *
+ *      // ...
+ * }
+ * @endcode
+ *
+ * @param btree_map     the btree map
+ * @param name          the item name
+ *
+ * @return              the item itor, return tb_iterator_tail(btree_map) if not found
+ */
+tb_size_t               tb_btree_map_lower_bound(tb_btree_map_ref_t btree_map, tb_cpointer_t name);
+
+/*! find the first item which is greater than the given name
+ *
+ * @param btree_map     the btree map
+ * @param name          the item name
+ *
+ * @return              the item itor, return tb_iterator_tail(btree_map) if not found
+ */
+tb_size_t               tb_btree_map_upper_bound(tb_btree_map_ref_t btree_map, tb_cpointer_t name);
+
+/*! insert item data from name
+ *
+ * @note the pair (name => data) is unique, the old data will be replaced
+ *
+ * @param btree_map     the btree map
+ * @param name          the item name
+ * @param data          the item data
+ *
+ * @return              the item itor, @note: the itor of the same item is mutable
+ */
+tb_size_t               tb_btree_map_insert(tb_btree_map_ref_t btree_map, tb_cpointer_t name, tb_cpointer_t data);
+
+/*! remove item from name
+ *
+ * @param btree_map     the btree map
+ * @param name          the item name
+ */
+tb_void_t               tb_btree_map_remove(tb_btree_map_ref_t btree_map, tb_cpointer_t name);
+
+/*! remove all items in the range [lower, upper)
+ *
+ * the items in the same leaf will be removed at once, 
+ * so it is much faster than removing them one by one.
+ *
+ * @param btree_map     the btree map
+ * @param lower         the lower name, included
+ * @param upper         the upper name, excluded
+ *
+ * @return              the removed items count
+ */
+tb_size_t               tb_btree_map_remove_range(tb_btree_map_ref_t btree_map, tb_cpointer_t lower, tb_cpointer_t upper);
+
+/*! load the sorted items and build the tree from bottom to top
+ *
+ * it is much faster than inserting them one by one and all nodes will be filled fully.
+ *
+ * @note the old items will be cleared and the names of the given items must be sorted and unique,
+ * otherwise it will return tb_false and keep the old items
+ *
+ * @param btree_map     the btree map
+ * @param items         the sorted items
+ * @param size          the items count
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_btree_map_load(tb_btree_map_ref_t btree_map, tb_btree_map_item_t const* items, tb_size_t size);
+
+/*! the btree map size
+ *
+ * @param btree_map     the btree map
+ *
+ * @return              the btree map size
+ */
+tb_size_t               tb_btree_map_size(tb_btree_map_ref_t btree_map);
+
+/*! the btree map maxn
+ *
+ * @param btree_map     the btree map
+ *
+ * @return              the items count of all allocated leaves
+ */
+tb_size_t               tb_btree_map_maxn(tb_btree_map_ref_t btree_map);
+
+/*! the btree map height
+ *
+ * @param btree_map     the btree map
+ *
+ * @return              the tree height, return zero if be empty
+ */
+tb_size_t               tb_btree_map_height(tb_btree_map_ref_t btree_map);
+
+#ifdef __tb_debug__
+/*! dump btree map
+ *
+ * @param btree_map     the btree map
+ */
+tb_void_t               tb_btree_map_dump(tb_btree_map_ref_t btree_map);
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
+
@@ -72,6 +72,9 @@ typedef struct __tb_circle_queue_t
     // the element
     tb_element_t            element;
 
+    // the allocator
+    tb_allocator_ref_t      allocator;
+
 }tb_circle_queue_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -163,6 +166,10 @@ static tb_long_t tb_circle_queue_itor_comp(tb_iterator_ref_t iterator, tb_cpoint
  * implementation
  */
 tb_circle_queue_ref_t tb_circle_queue_init(tb_size_t maxn, tb_element_t element)
+{
+    return tb_circle_queue_init_with_allocator(tb_null, maxn, element);
+}
+tb_circle_queue_ref_t tb_circle_queue_init_with_allocator(tb_allocator_ref_t allocator, tb_size_t maxn, tb_element_t element)
 {
     // check
     tb_assert_and_check_return_val(element.size && element.dupl && element.data, tb_null);
@@ -172,10 +179,20 @@ tb_circle_queue_ref_t tb_circle_queue_init(tb_size_t maxn, tb_element_t element)
     tb_circle_queue_t*  queue = tb_null;
     do
     {
+        // duplicate the element data (e.g. string) to the given allocator
+        if (allocator && !element.allocator) element.allocator = allocator;
+
+        // no allocator? uses the global allocator
+        if (!allocator) allocator = tb_allocator();
+        tb_assert_and_check_break(allocator);
+
         // make queue
-        queue = tb_malloc0_type(tb_circle_queue_t);
+        queue = (tb_circle_queue_t*)tb_allocator_malloc0(allocator, sizeof(tb_circle_queue_t));
         tb_assert_and_check_break(queue);
 
+        // init allocator
+        queue->allocator = allocator;
+
         // using the default maxn
         if (!maxn) maxn = TB_CIRCLE_QUEUE_SIZE_DEFAULT;
 
@@ -198,7 +215,7 @@ tb_circle_queue_ref_t tb_circle_queue_init(tb_size_t maxn, tb_element_t element)
         queue->itor.comp = tb_circle_queue_itor_comp;
 
         // make data
-        queue->data = (tb_byte_t*)tb_nalloc0(queue->maxn, element.size);
+        queue->data = (tb_byte_t*)tb_allocator_nalloc0(queue->allocator, queue->maxn, element.size);
         tb_assert_and_check_break(queue->data);
 
         // ok
@@ -226,10 +243,10 @@ tb_void_t tb_circle_queue_exit(tb_circle_queue_ref_t self)
     tb_circle_queue_clear(self);
 
     // free data
-    if (queue->data) tb_free(queue->data);
+    if (queue->data) tb_allocator_free(queue->allocator, queue->data);
 
     // free it
-    tb_free(queue);
+    tb_allocator_free(queue->allocator, queue);
 }
 tb_void_t tb_circle_queue_clear(tb_circle_queue_ref_t self)
 {
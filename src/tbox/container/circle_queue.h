@@ -81,6 +81,18 @@ typedef tb_iterator_ref_t   tb_circle_queue_ref_t;
  */
 tb_circle_queue_ref_t   tb_circle_queue_init(tb_size_t maxn, tb_element_t element);
 
+/*! init queue with the given allocator
+ *
+ * the queue, items and the duplicated element data (e.g. string) will be allocated from this allocator
+ *
+ * @param allocator     the allocator, uses the global allocator if be null
+ * @param maxn          the item maxn, using the default maxn if be zero
+ * @param element       the element
+ *
+ * @return              the queue
+ */
+tb_circle_queue_ref_t   tb_circle_queue_init_with_allocator(tb_allocator_ref_t allocator, tb_size_t maxn, tb_element_t element);
+
 /*! exit queue
  *
  * @param queue         the queue
@@ -0,0 +1,464 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        concurrent_circle_queue.c
+ * @ingroup     container
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME                        "concurrent_circle_queue"
+#define TB_TRACE_MODULE_DEBUG                       (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "concurrent_circle_queue.h"
+#include "../libc/libc.h"
+#include "../utils/utils.h"
+#include "../memory/memory.h"
+#include "../platform/platform.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default item maxn
+#ifdef __tb_small__
+#   define TB_CONCURRENT_CIRCLE_QUEUE_MAXN_DEFAULT      (256)
+#else
+#   define TB_CONCURRENT_CIRCLE_QUEUE_MAXN_DEFAULT      (4096)
+#endif
+
+// the max item maxn
+#define TB_CONCURRENT_CIRCLE_QUEUE_MAXN                 (1 << 24)
+
+// the padding bytes for separating the head and tail, TB_SMP_CACHE_BYTES may be less than the real cache line size
+#if TB_SMP_CACHE_BYTES > 64
+#   define TB_CONCURRENT_CIRCLE_QUEUE_PADDING           TB_SMP_CACHE_BYTES
+#else
+#   define TB_CONCURRENT_CIRCLE_QUEUE_PADDING           (64)
+#endif
+
+/* the barrier between reading the sequence number and accessing the cell data
+ *
+ * the stores are not reordered with the other stores and loads are not reordered with the other loads on x86,
+ * so it only need prevent the compiler reordering them, tb_barrier() is a full memory fence for gcc.
+ */
+#if (defined(TB_ARCH_x86) || defined(TB_ARCH_x64)) && defined(TB_ASSEMBLER_IS_GAS)
+#   define tb_concurrent_circle_queue_barrier()         __tb_asm__ __tb_volatile__ ("" ::: "memory")
+#else
+#   define tb_concurrent_circle_queue_barrier()         tb_barrier()
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the concurrent circle queue cell type
+typedef struct __tb_concurrent_circle_queue_cell_t
+{
+    /* the sequence number
+     *
+     * seq == pos:              it is free for the producer of pos
+     * seq == pos + 1:          it is full for the consumer of pos
+     * seq == pos + maxn:       it is free for the producer of the next round
+     */
+    __tb_volatile__ tb_size_t       seq;
+
+    // the item data
+    tb_cpointer_t                   data;
+
+}tb_concurrent_circle_queue_cell_t;
+
+// the concurrent circle queue type
+typedef struct __tb_concurrent_circle_queue_t
+{
+    // the padding for the previous data
+    tb_byte_t                               pad0[TB_CONCURRENT_CIRCLE_QUEUE_PADDING];
+
+    // the tail position for the producers
+    tb_atomic_t                             tail;
+
+    // the padding between the tail and head
+    tb_byte_t                               pad1[TB_CONCURRENT_CIRCLE_QUEUE_PADDING - sizeof(tb_atomic_t)];
+
+    // the head position for the consumers
+    tb_atomic_t                             head;
+
+    // the padding between the head and the readonly fields
+    tb_byte_t                               pad2[TB_CONCURRENT_CIRCLE_QUEUE_PADDING - sizeof(tb_atomic_t)];
+
+    // the cells
+    tb_concurrent_circle_queue_cell_t*      cells;
+
+    // the cells mask
+    tb_size_t                               mask;
+
+    // the mode
+    tb_size_t                               mode;
+
+    // the element
+    tb_element_t                            element;
+
+    // the allocator
+    tb_allocator_ref_t                      allocator;
+
+}tb_concurrent_circle_queue_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_concurrent_circle_queue_ref_t tb_concurrent_circle_queue_init(tb_size_t maxn, tb_element_t element, tb_size_t mode)
+{
+    return tb_concurrent_circle_queue_init_with_allocator(tb_null, maxn, element, mode);
+}
+tb_concurrent_circle_queue_ref_t tb_concurrent_circle_queue_init_with_allocator(tb_allocator_ref_t allocator, tb_size_t maxn, tb_element_t element, tb_size_t mode)
+{
+    // check
+    tb_assert_and_check_return_val(element.size && element.size <= sizeof(tb_pointer_t), tb_null);
+
+    // check maxn
+    if (!maxn) maxn = TB_CONCURRENT_CIRCLE_QUEUE_MAXN_DEFAULT;
+    tb_assert_and_check_return_val(maxn <= TB_CONCURRENT_CIRCLE_QUEUE_MAXN, tb_null);
+
+    // done
+    tb_bool_t                       ok = tb_false;
+    tb_concurrent_circle_queue_t*   queue = tb_null;
+    do
+    {
+        // no allocator? uses the global allocator
+        if (!allocator) allocator = tb_allocator();
+        tb_assert_and_check_break(allocator);
+
+        // make queue
+        queue = (tb_concurrent_circle_queue_t*)tb_allocator_malloc0(allocator, sizeof(tb_concurrent_circle_queue_t));
+        tb_assert_and_check_break(queue);
+
+        // init queue, at least two cells for distinguishing the full and free cells of the next round
+        maxn                = tb_align_pow2(tb_max(maxn, 2));
+        queue->mask         = maxn - 1;
+        queue->mode         = mode;
+        queue->element      = element;
+        queue->allocator    = allocator;
+
+        // init cells
+        queue->cells = (tb_concurrent_circle_queue_cell_t*)tb_allocator_nalloc(allocator, maxn, sizeof(tb_concurrent_circle_queue_cell_t));
+        tb_assert_and_check_break(queue->cells);
+
+        // all cells are free for the producers of the first round
+        tb_size_t i = 0;
+        for (i = 0; i < maxn; i++) 
+        {
+            queue->cells[i].seq     = i;
+            queue->cells[i].data    = tb_null;
+        }
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (queue) tb_concurrent_circle_queue_exit((tb_concurrent_circle_queue_ref_t)queue);
+        queue = tb_null;
+    }
+
+    // ok?
+    return (tb_concurrent_circle_queue_ref_t)queue;
+}
+tb_void_t tb_concurrent_circle_queue_exit(tb_concurrent_circle_queue_ref_t self)
+{
+    // check
+    tb_concurrent_circle_queue_t* queue = (tb_concurrent_circle_queue_t*)self;
+    tb_assert_and_check_return(queue);
+
+    // exit cells
+    if (queue->cells)
+    {
+        // free the left items
+        tb_concurrent_circle_queue_clear(self);
+
+        // exit it
+        tb_allocator_free(queue->allocator, queue->cells);
+        queue->cells = tb_null;
+    }
+
+    // exit it
+    tb_allocator_free(queue->allocator, queue);
+}
+tb_void_t tb_concurrent_circle_queue_clear(tb_concurrent_circle_queue_ref_t self)
+{
+    // check
+    tb_concurrent_circle_queue_t* queue = (tb_concurrent_circle_queue_t*)self;
+    tb_assert_and_check_return(queue);
+
+    // get and free all items
+    tb_size_t       i = 0;
+    tb_size_t       n = 0;
+    tb_pointer_t    data[64];
+    while ((n = tb_concurrent_circle_queue_get_n(self, data, tb_arrayn(data))))
+    {
+        if (queue->element.free) 
+        {
+            for (i = 0; i < n; i++) queue->element.free(&queue->element, &data[i]);
+        }
+    }
+}
+tb_size_t tb_concurrent_circle_queue_size(tb_concurrent_circle_queue_ref_t self)
+{
+    // check
+    tb_concurrent_circle_queue_t* queue = (tb_concurrent_circle_queue_t*)self;
+    tb_assert_and_check_return_val(queue, 0);
+
+    // the snapshot of the positions, the head may be changed after reading the tail
+    tb_size_t head = (tb_size_t)queue->head;
+    tb_concurrent_circle_queue_barrier();
+    tb_size_t tail = (tb_size_t)queue->tail;
+    tb_long_t size = (tb_long_t)(tail - head);
+
+    // ok?
+    return size > 0? tb_min((tb_size_t)size, queue->mask + 1) : 0;
+}
+tb_size_t tb_concurrent_circle_queue_maxn(tb_concurrent_circle_queue_ref_t self)
+{
+    // check
+    tb_concurrent_circle_queue_t* queue = (tb_concurrent_circle_queue_t*)self;
+    tb_assert_and_check_return_val(queue, 0);
+
+    // the maxn
+    return queue->mask + 1;
+}
+tb_bool_t tb_concurrent_circle_queue_put(tb_concurrent_circle_queue_ref_t self, tb_cpointer_t data)
+{
+    // check
+    tb_concurrent_circle_queue_t* queue = (tb_concurrent_circle_queue_t*)self;
+    tb_assert_and_check_return_val(queue && queue->cells, tb_false);
+
+    // reserve one free cell from the tail
+    tb_long_t                           dif = 0;
+    tb_concurrent_circle_queue_cell_t*  cell = tb_null;
+    tb_size_t                           pos = (tb_size_t)queue->tail;
+    while (1)
+    {
+        // is free?
+        cell = &queue->cells[pos & queue->mask];
+        dif = (tb_long_t)(cell->seq - pos);
+        if (!dif)
+        {
+            // only one producer? move the tail directly
+            if (queue->mode & TB_CONCURRENT_CIRCLE_QUEUE_MODE_SP)
+            {
+                queue->tail = (tb_long_t)(pos + 1);
+                break;
+            }
+
+            // reserve it, reload the tail if it has been moved by other producers
+            tb_size_t prev = (tb_size_t)tb_atomic_fetch_and_pset(&queue->tail, (tb_long_t)pos, (tb_long_t)(pos + 1));
+            tb_check_break(prev != pos);
+            pos = prev;
+        }
+        // full?
+        else if (dif < 0) return tb_false;
+        // the tail has been moved by other producers, reload it
+        else pos = (tb_size_t)queue->tail;
+    }
+
+    // write item and publish it to the consumers
+    tb_concurrent_circle_queue_barrier();
+    cell->data = data;
+    tb_concurrent_circle_queue_barrier();
+    cell->seq = pos + 1;
+
+    // ok
+    return tb_true;
+}
+tb_size_t tb_concurrent_circle_queue_put_n(tb_concurrent_circle_queue_ref_t self, tb_cpointer_t const* data, tb_size_t size)
+{
+    // check
+    tb_concurrent_circle_queue_t* queue = (tb_concurrent_circle_queue_t*)self;
+    tb_assert_and_check_return_val(queue && queue->cells && data, 0);
+
+    // reserve the free cells from the tail
+    tb_size_t                           n = 0;
+    tb_long_t                           dif = 0;
+    tb_size_t                           mask = queue->mask;
+    tb_concurrent_circle_queue_cell_t*  cells = queue->cells;
+    tb_size_t                           pos = (tb_size_t)queue->tail;
+    while (1)
+    {
+        // count the free cells for this round
+        for (n = 0; n < size; n++)
+        {
+            dif = (tb_long_t)(cells[(pos + n) & mask].seq - (pos + n));
+            tb_check_break(!dif);
+        }
+
+        // no free cells?
+        if (!n)
+        {
+            // full?
+            tb_check_return_val(dif > 0, 0);
+
+            // the tail has been moved by other producers, reload it
+            pos = (tb_size_t)queue->tail;
+            continue ;
+        }
+
+        // only one producer? move the tail directly
+        if (queue->mode & TB_CONCURRENT_CIRCLE_QUEUE_MODE_SP)
+        {
+            queue->tail = (tb_long_t)(pos + n);
+            break;
+        }
+
+        // reserve them, reload the tail if it has been moved by other producers
+        tb_size_t prev = (tb_size_t)tb_atomic_fetch_and_pset(&queue->tail, (tb_long_t)pos, (tb_long_t)(pos + n));
+        tb_check_break(prev != pos);
+        pos = prev;
+    }
+
+    // the cells must be free before writing them
+    tb_concurrent_circle_queue_barrier();
+
+    // write items and publish them to the consumers
+    tb_size_t i = 0;
+    for (i = 0; i < n; i++)
+    {
+        tb_concurrent_circle_queue_cell_t* cell = &cells[(pos + i) & mask];
+        cell->data = data[i];
+        tb_concurrent_circle_queue_barrier();
+        cell->seq = pos + i + 1;
+    }
+
+    // ok
+    return n;
+}
+tb_bool_t tb_concurrent_circle_queue_get(tb_concurrent_circle_queue_ref_t self, tb_pointer_t* pdata)
+{
+    // check
+    tb_concurrent_circle_queue_t* queue = (tb_concurrent_circle_queue_t*)self;
+    tb_assert_and_check_return_val(queue && queue->cells && pdata, tb_false);
+
+    // reserve one full cell from the head
+    tb_long_t                           dif = 0;
+    tb_concurrent_circle_queue_cell_t*  cell = tb_null;
+    tb_size_t                           pos = (tb_size_t)queue->head;
+    while (1)
+    {
+        // is full?
+        cell = &queue->cells[pos & queue->mask];
+        dif = (tb_long_t)(cell->seq - (pos + 1));
+        if (!dif)
+        {
+            // only one consumer? move the head directly
+            if (queue->mode & TB_CONCURRENT_CIRCLE_QUEUE_MODE_SC)
+            {
+                queue->head = (tb_long_t)(pos + 1);
+                break;
+            }
+
+            // reserve it, reload the head if it has been moved by other consumers
+            tb_size_t prev = (tb_size_t)tb_atomic_fetch_and_pset(&queue->head, (tb_long_t)pos, (tb_long_t)(pos + 1));
+            tb_check_break(prev != pos);
+            pos = prev;
+        }
+        // empty?
+        else if (dif < 0) return tb_false;
+        // the head has been moved by other consumers, reload it
+        else pos = (tb_size_t)queue->head;
+    }
+
+    // read item and free the cell for the producer of the next round
+    tb_concurrent_circle_queue_barrier();
+    *pdata = (tb_pointer_t)cell->data;
+    tb_concurrent_circle_queue_barrier();
+    cell->seq = pos + queue->mask + 1;
+
+    // ok
+    return tb_true;
+}
+tb_size_t tb_concurrent_circle_queue_get_n(tb_concurrent_circle_queue_ref_t self, tb_pointer_t* data, tb_size_t maxn)
+{
+    // check
+    tb_concurrent_circle_queue_t* queue = (tb_concurrent_circle_queue_t*)self;
+    tb_assert_and_check_return_val(queue && queue->cells && data, 0);
+
+    // reserve the full cells from the head
+    tb_size_t                           n = 0;
+    tb_long_t                           dif = 0;
+    tb_size_t                           mask = queue->mask;
+    tb_concurrent_circle_queue_cell_t*  cells = queue->cells;
+    tb_size_t                           pos = (tb_size_t)queue->head;
+    while (1)
+    {
+        // count the full cells
+        for (n = 0; n < maxn; n++)
+        {
+            dif = (tb_long_t)(cells[(pos + n) & mask].seq - (pos + n + 1));
+            tb_check_break(!dif);
+        }
+
+        // no full cells?
+        if (!n)
+        {
+            // empty?
+            tb_check_return_val(dif > 0, 0);
+
+            // the head has been moved by other consumers, reload it
+            pos = (tb_size_t)queue->head;
+            continue ;
+        }
+
+        // only one consumer? move the head directly
+        if (queue->mode & TB_CONCURRENT_CIRCLE_QUEUE_MODE_SC)
+        {
+            queue->head = (tb_long_t)(pos + n);
+            break;
+        }
+
+        // reserve them, reload the head if it has been moved by other consumers
+        tb_size_t prev = (tb_size_t)tb_atomic_fetch_and_pset(&queue->head, (tb_long_t)pos, (tb_long_t)(pos + n));
+        tb_check_break(prev != pos);
+        pos = prev;
+    }
+
+    // the cells must be full before reading them
+    tb_concurrent_circle_queue_barrier();
+
+    // read items and free the cells for the producers of the next round
+    tb_size_t i = 0;
+    for (i = 0; i < n; i++)
+    {
+        tb_concurrent_circle_queue_cell_t* cell = &cells[(pos + i) & mask];
+        data[i] = (tb_pointer_t)cell->data;
+        tb_concurrent_circle_queue_barrier();
+        cell->seq = pos + i + mask + 1;
+    }
+
+    // ok
+    return n;
+}
@@ -0,0 +1,208 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        concurrent_circle_queue.h
+ * @ingroup     container
+ *
+ */
+#ifndef TB_CONTAINER_CONCURRENT_CIRCLE_QUEUE_H
+#define TB_CONTAINER_CONCURRENT_CIRCLE_QUEUE_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "element.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the concurrent circle queue mode enum
+typedef enum __tb_concurrent_circle_queue_mode_e
+{
+    TB_CONCURRENT_CIRCLE_QUEUE_MODE_MPMC            = 0     //!< multi-producers and multi-consumers
+,   TB_CONCURRENT_CIRCLE_QUEUE_MODE_SP              = 1     //!< only one producer thread
+,   TB_CONCURRENT_CIRCLE_QUEUE_MODE_SC              = 2     //!< only one consumer thread
+,   TB_CONCURRENT_CIRCLE_QUEUE_MODE_MPSC            = TB_CONCURRENT_CIRCLE_QUEUE_MODE_SC
+,   TB_CONCURRENT_CIRCLE_QUEUE_MODE_SPMC            = TB_CONCURRENT_CIRCLE_QUEUE_MODE_SP
+,   TB_CONCURRENT_CIRCLE_QUEUE_MODE_SPSC            = TB_CONCURRENT_CIRCLE_QUEUE_MODE_SP | TB_CONCURRENT_CIRCLE_QUEUE_MODE_SC
+
+}tb_concurrent_circle_queue_mode_e;
+
+/*! the concurrent circle queue ref type
+ *
+ * <pre>
+ *
+ *         head (consumers)                                 tail (producers)
+ *          |                                                |
+ * cells: | seq: pos + 1 | seq: pos + 2 | ... | seq: pos + n | seq: pos + n | seq: ... | ...
+ *        |     data     |     data     | ... |     data     |    (free)    |  (free)  | ...
+ *
+ * </pre>
+ *
+ * it is a bounded and lock-free queue (dmitry vyukov's mpmc queue), 
+ * each cell has a sequence number which tells the producers and consumers whether it is free or full,
+ * so the producers and consumers only contend the tail and head positions with cas, 
+ * and the single producer or consumer need not cas it.
+ *
+ * the head and tail positions are placed in the different cache lines.
+ */
+typedef __tb_typeref__(concurrent_circle_queue);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init the concurrent circle queue
+ *
+ * the items are passed by the pointer-sized data, e.g. tb_element_ptr(), tb_element_size(), tb_element_str(), ...
+ * the queue does not duplicate the item data, so the item is moved from the producer to the consumer,
+ * and the element free func is only called for the left items when the queue is cleared or exited.
+ *
+ * @code
+ 
+    // init queue
+    tb_concurrent_circle_queue_ref_t queue = tb_concurrent_circle_queue_init(1024, tb_element_ptr(tb_null, tb_null), TB_CONCURRENT_CIRCLE_QUEUE_MODE_MPMC);
+    if (queue)
+    {
+        // put it in the producer threads
+        if (!tb_concurrent_circle_queue_put(queue, message))
+        {
+            // full
+        }
+
+        // get it in the consumer threads
+        tb_pointer_t message = tb_null;
+        if (tb_concurrent_circle_queue_get(queue, &message))
+        {
+            // ...
+        }
+
+        // exit queue after all threads have been finished
+        tb_concurrent_circle_queue_exit(queue);
+    }
+ * @endcode
+ *
+ * @param maxn          the item maxn, it will be aligned by power of 2, using the default maxn if be zero
+ * @param element       the element, the element size cannot be larger than the pointer size
+ * @param mode          the mode, e.g. TB_CONCURRENT_CIRCLE_QUEUE_MODE_MPMC, TB_CONCURRENT_CIRCLE_QUEUE_MODE_SPSC, ...
+ *
+ * @return              the queue
+ */
+tb_concurrent_circle_queue_ref_t    tb_concurrent_circle_queue_init(tb_size_t maxn, tb_element_t element, tb_size_t mode);
+
+/*! init the concurrent circle queue with the given allocator
+ *
+ * @param allocator     the allocator, uses the global allocator if be null
+ * @param maxn          the item maxn, it will be aligned by power of 2, using the default maxn if be zero
+ * @param element       the element, the element size cannot be larger than the pointer size
+ * @param mode          the mode, e.g. TB_CONCURRENT_CIRCLE_QUEUE_MODE_MPMC, TB_CONCURRENT_CIRCLE_QUEUE_MODE_SPSC, ...
+ *
+ * @return              the queue
+ */
+tb_concurrent_circle_queue_ref_t    tb_concurrent_circle_queue_init_with_allocator(tb_allocator_ref_t allocator, tb_size_t maxn, tb_element_t element, tb_size_t mode);
+
+/*! exit the concurrent circle queue and free the left items
+ *
+ * @note it cannot be accessed by other threads now
+ *
+ * @param queue         the queue
+ */
+tb_void_t                           tb_concurrent_circle_queue_exit(tb_concurrent_circle_queue_ref_t queue);
+
+/*! clear the concurrent circle queue and free the left items
+ *
+ * @note it gets all items as a consumer 
+ *
+ * @param queue         the queue
+ */
+tb_void_t                           tb_concurrent_circle_queue_clear(tb_concurrent_circle_queue_ref_t queue);
+
+/*! the items count
+ *
+ * @note it is only a snapshot if the queue is being accessed by other threads
+ *
+ * @param queue         the queue
+ *
+ * @return              the items count
+ */
+tb_size_t                           tb_concurrent_circle_queue_size(tb_concurrent_circle_queue_ref_t queue);
+
+/*! the item maxn
+ *
+ * @param queue         the queue
+ *
+ * @return              the item maxn
+ */
+tb_size_t                           tb_concurrent_circle_queue_maxn(tb_concurrent_circle_queue_ref_t queue);
+
+/*! put the item to the tail
+ *
+ * @param queue         the queue
+ * @param data          the item data
+ *
+ * @return              tb_true or tb_false if the queue is full
+ */
+tb_bool_t                           tb_concurrent_circle_queue_put(tb_concurrent_circle_queue_ref_t queue, tb_cpointer_t data);
+
+/*! put the items to the tail
+ *
+ * the cells are reserved once for all items, so it is faster than putting them one by one
+ *
+ * @param queue         the queue
+ * @param data          the items data
+ * @param size          the items count
+ *
+ * @return              the put items count, it may be less than the size if the queue is full
+ */
+tb_size_t                           tb_concurrent_circle_queue_put_n(tb_concurrent_circle_queue_ref_t queue, tb_cpointer_t const* data, tb_size_t size);
+
+/*! get the item from the head
+ *
+ * @param queue         the queue
+ * @param pdata         the item data pointer
+ *
+ * @return              tb_true or tb_false if the queue is empty
+ */
+tb_bool_t                           tb_concurrent_circle_queue_get(tb_concurrent_circle_queue_ref_t queue, tb_pointer_t* pdata);
+
+/*! get the items from the head
+ *
+ * @param queue         the queue
+ * @param data          the items data
+ * @param maxn          the items maxn
+ *
+ * @return              the gotten items count, it is zero if the queue is empty
+ */
+tb_size_t                           tb_concurrent_circle_queue_get_n(tb_concurrent_circle_queue_ref_t queue, tb_pointer_t* data, tb_size_t maxn);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
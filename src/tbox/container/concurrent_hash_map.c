@@ -0,0 +1,680 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        concurrent_hash_map.c
+ * @ingroup     container
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME                        "concurrent_hash_map"
+#define TB_TRACE_MODULE_DEBUG                       (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "concurrent_hash_map.h"
+#include "../libc/libc.h"
+#include "../utils/utils.h"
+#include "../memory/memory.h"
+#include "../platform/platform.h"
+#include "../platform/impl/thread.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/* enable the epoch records of the readers?
+ *
+ * each thread will get an unique index at the first time and uses the record at this index of all maps,
+ * the index will be released by the thread exit function after the thread has been exited.
+ *
+ * the other threads will be counted by the shared atomic counter of the active readers, 
+ * and the retired nodes will not be freed when they are reading.
+ */
+#ifdef __tb_thread_local__
+#   define TB_CONCURRENT_HASH_MAP_RECORD_ENABLE
+#endif
+
+// the max epoch records count
+#ifdef __tb_small__
+#   define TB_CONCURRENT_HASH_MAP_RECORD_MAXN       (16)
+#else
+#   define TB_CONCURRENT_HASH_MAP_RECORD_MAXN       (128)
+#endif
+
+// the max stripe locks count
+#define TB_CONCURRENT_HASH_MAP_STRIPE_MAXN          (64)
+
+// the padding bytes of the epoch record, TB_SMP_CACHE_BYTES may be less than the real cache line size
+#if TB_SMP_CACHE_BYTES > 64
+#   define TB_CONCURRENT_HASH_MAP_PADDING           TB_SMP_CACHE_BYTES
+#else
+#   define TB_CONCURRENT_HASH_MAP_PADDING           (64)
+#endif
+
+// the default bucket size
+#ifdef __tb_small__
+#   define TB_CONCURRENT_HASH_MAP_BUCKET_SIZE_DEFAULT   TB_CONCURRENT_HASH_MAP_BUCKET_SIZE_SMALL
+#else
+#   define TB_CONCURRENT_HASH_MAP_BUCKET_SIZE_DEFAULT   (4096)
+#endif
+
+// the max bucket size
+#define TB_CONCURRENT_HASH_MAP_BUCKET_MAXN          (1 << 24)
+
+// try to reclaim the retired nodes if the retired nodes count exceeds it
+#define TB_CONCURRENT_HASH_MAP_RECLAIM_BATCH        (64)
+
+// the node data
+#define tb_concurrent_hash_map_node_data(node)      ((tb_byte_t*)&(node)[1])
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the concurrent hash map node type
+typedef struct __tb_concurrent_hash_map_node_t
+{
+    // the next node of the bucket, it may be read by the readers without lock
+    struct __tb_concurrent_hash_map_node_t* __tb_volatile__     next;
+
+    // the next retired node
+    struct __tb_concurrent_hash_map_node_t*                     retired_next;
+
+}tb_concurrent_hash_map_node_t;
+
+// the concurrent hash map epoch record type of the reader thread
+typedef struct __tb_concurrent_hash_map_record_t
+{
+    // the epoch state: (epoch << 1) | active
+    __tb_volatile__ tb_size_t               state;
+
+    // the nested count of the read section, only be accessed by the owner thread
+    tb_size_t                               nest;
+
+    // padding for the cpu cache line
+    tb_byte_t                               pad[TB_CONCURRENT_HASH_MAP_PADDING - sizeof(tb_size_t) * 2];
+
+}tb_concurrent_hash_map_record_t;
+
+// the concurrent hash map type
+typedef struct __tb_concurrent_hash_map_t
+{
+    // the buckets
+    tb_concurrent_hash_map_node_t* __tb_volatile__* buckets;
+
+    // the buckets count
+    tb_size_t                               bucket_size;
+
+    // the current epoch
+    __tb_volatile__ tb_size_t               epoch;
+
+#ifdef TB_CONCURRENT_HASH_MAP_RECORD_ENABLE
+    // the epoch records of the reader threads, aligned by the cpu cache line
+    tb_concurrent_hash_map_record_t*        records;
+
+    // the records data
+    tb_pointer_t                            records_data;
+#endif
+
+    // the active readers count without the epoch records
+    tb_atomic_t                             shared;
+
+    // the element for name
+    tb_element_t                            element_name;
+
+    // the element for data
+    tb_element_t                            element_data;
+
+    // the allocator
+    tb_allocator_ref_t                      allocator;
+
+    // the items count
+    tb_atomic_t                             size;
+
+    // the stripe locks for writers
+    tb_spinlock_t                           locks[TB_CONCURRENT_HASH_MAP_STRIPE_MAXN];
+
+    // the stripe locks mask
+    tb_size_t                               stripe_mask;
+
+    // the reclaim lock
+    tb_spinlock_t                           reclaim_lock;
+
+    // the retired nodes of the last three epochs
+    tb_concurrent_hash_map_node_t*          retired[3];
+
+    // the retired nodes count
+    tb_size_t                               retired_count;
+
+}tb_concurrent_hash_map_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+#ifdef TB_CONCURRENT_HASH_MAP_RECORD_ENABLE
+
+// the used flags of the thread indices
+static tb_atomic_t                          g_concurrent_hash_map_indices[TB_CONCURRENT_HASH_MAP_RECORD_MAXN];
+
+// the thread index of the current thread, 0: not inited, -1: no free index, > 0: index + 1
+static __tb_thread_local__ tb_long_t        g_concurrent_hash_map_index = 0;
+
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+#ifdef TB_CONCURRENT_HASH_MAP_RECORD_ENABLE
+static tb_void_t tb_concurrent_hash_map_exit_thread()
+{
+    // release the index of the current thread
+    tb_long_t index = g_concurrent_hash_map_index;
+    if (index > 0) tb_atomic_set0(&g_concurrent_hash_map_indices[index - 1]);
+    g_concurrent_hash_map_index = 0;
+}
+static tb_concurrent_hash_map_record_t* tb_concurrent_hash_map_record(tb_concurrent_hash_map_t* hash_map)
+{
+    // get the index of the current thread
+    tb_long_t index = g_concurrent_hash_map_index;
+    if (!index)
+    {
+        // find a free index
+        tb_size_t i = 0;
+        index = -1;
+        for (i = 0; i < TB_CONCURRENT_HASH_MAP_RECORD_MAXN; i++)
+        {
+            if (!tb_atomic_get(&g_concurrent_hash_map_indices[i]) && !tb_atomic_fetch_and_pset(&g_concurrent_hash_map_indices[i], 0, 1))
+            {
+                index = (tb_long_t)i + 1;
+                break;
+            }
+        }
+
+        // release this index when the current thread is exited, even if it is not created by tb_thread_init()
+        if (index > 0) tb_thread_exit_attach(tb_concurrent_hash_map_exit_thread);
+
+        // save it
+        g_concurrent_hash_map_index = index;
+    }
+
+    // the record
+    return index > 0? &hash_map->records[index - 1] : tb_null;
+}
+#endif
+static tb_concurrent_hash_map_node_t* tb_concurrent_hash_map_node_init(tb_concurrent_hash_map_t* hash_map, tb_cpointer_t name, tb_cpointer_t data)
+{
+    // make node
+    tb_concurrent_hash_map_node_t* node = (tb_concurrent_hash_map_node_t*)tb_allocator_malloc0(hash_map->allocator, sizeof(tb_concurrent_hash_map_node_t) + hash_map->element_name.size + hash_map->element_data.size);
+    tb_assert_and_check_return_val(node, tb_null);
+
+    // dupl name and data
+    hash_map->element_name.dupl(&hash_map->element_name, tb_concurrent_hash_map_node_data(node), name);
+    hash_map->element_data.dupl(&hash_map->element_data, tb_concurrent_hash_map_node_data(node) + hash_map->element_name.size, data);
+
+    // ok
+    return node;
+}
+static tb_void_t tb_concurrent_hash_map_node_exit(tb_concurrent_hash_map_t* hash_map, tb_concurrent_hash_map_node_t* node)
+{
+    // free name and data
+    if (hash_map->element_name.free) hash_map->element_name.free(&hash_map->element_name, tb_concurrent_hash_map_node_data(node));
+    if (hash_map->element_data.free) hash_map->element_data.free(&hash_map->element_data, tb_concurrent_hash_map_node_data(node) + hash_map->element_name.size);
+
+    // free node
+    tb_allocator_free(hash_map->allocator, node);
+}
+static tb_concurrent_hash_map_node_t* tb_concurrent_hash_map_node_find(tb_concurrent_hash_map_t* hash_map, tb_size_t buck, tb_cpointer_t name)
+{
+    /* find the node with the same name without lock
+     *
+     * the links may be changed by the writers at the same time, 
+     * so we need read each link only once and keep the node
+     */
+    tb_concurrent_hash_map_node_t* node = hash_map->buckets[buck];
+    for (; node; node = node->next)
+    {
+        if (!hash_map->element_name.comp(&hash_map->element_name, name, hash_map->element_name.data(&hash_map->element_name, tb_concurrent_hash_map_node_data(node))))
+            return node;
+    }
+
+    // not found
+    return tb_null;
+}
+static tb_concurrent_hash_map_node_t* __tb_volatile__* tb_concurrent_hash_map_node_link(tb_concurrent_hash_map_t* hash_map, tb_size_t buck, tb_cpointer_t name)
+{
+    // find the link of the node with the same name, it need be called in the stripe lock
+    tb_concurrent_hash_map_node_t* __tb_volatile__* plink = &hash_map->buckets[buck];
+    for (; *plink; plink = &(*plink)->next)
+    {
+        if (!hash_map->element_name.comp(&hash_map->element_name, name, hash_map->element_name.data(&hash_map->element_name, tb_concurrent_hash_map_node_data(*plink))))
+            return plink;
+    }
+
+    // not found
+    return tb_null;
+}
+static tb_void_t tb_concurrent_hash_map_reclaim(tb_concurrent_hash_map_t* hash_map)
+{
+    // make sure the unlinked nodes are visible to all readers before checking them
+    tb_barrier();
+
+    // some readers without records are reading? we cannot advance the epoch now
+    tb_check_return(!tb_atomic_get(&hash_map->shared));
+
+    // all active readers have entered the current epoch?
+    tb_size_t epoch = hash_map->epoch;
+#ifdef TB_CONCURRENT_HASH_MAP_RECORD_ENABLE
+    tb_size_t i = 0;
+    for (i = 0; i < TB_CONCURRENT_HASH_MAP_RECORD_MAXN; i++)
+    {
+        tb_size_t state = hash_map->records[i].state;
+        if ((state & 0x1) && (state >> 1) != (epoch & ((tb_size_t)-1 >> 1))) return ;
+    }
+#endif
+
+    /* free the nodes retired at the epoch - 2
+     *
+     * the readers which may hold them have been left before entering the epoch - 1, 
+     * and all active readers are at the current epoch now.
+     */
+    tb_concurrent_hash_map_node_t* node = hash_map->retired[(epoch + 1) % 3];
+    while (node)
+    {
+        tb_concurrent_hash_map_node_t* next = node->retired_next;
+        tb_concurrent_hash_map_node_exit(hash_map, node);
+        hash_map->retired_count--;
+        node = next;
+    }
+    hash_map->retired[(epoch + 1) % 3] = tb_null;
+
+    // advance the epoch
+    hash_map->epoch = epoch + 1;
+}
+static tb_void_t tb_concurrent_hash_map_retire(tb_concurrent_hash_map_t* hash_map, tb_concurrent_hash_map_node_t* node)
+{
+    // enter lock
+    tb_spinlock_enter(&hash_map->reclaim_lock);
+
+    // retire it at the current epoch
+    tb_size_t epoch = hash_map->epoch;
+    node->retired_next = hash_map->retired[epoch % 3];
+    hash_map->retired[epoch % 3] = node;
+    hash_map->retired_count++;
+
+    // too many retired nodes? try to free some of them
+    if (hash_map->retired_count >= TB_CONCURRENT_HASH_MAP_RECLAIM_BATCH) tb_concurrent_hash_map_reclaim(hash_map);
+
+    // leave lock
+    tb_spinlock_leave(&hash_map->reclaim_lock);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_concurrent_hash_map_ref_t tb_concurrent_hash_map_init(tb_size_t bucket_size, tb_element_t element_name, tb_element_t element_data)
+{
+    return tb_concurrent_hash_map_init_with_allocator(tb_null, bucket_size, element_name, element_data);
+}
+tb_concurrent_hash_map_ref_t tb_concurrent_hash_map_init_with_allocator(tb_allocator_ref_t allocator, tb_size_t bucket_size, tb_element_t element_name, tb_element_t element_data)
+{
+    // check
+    tb_assert_and_check_return_val(element_name.size && element_name.hash && element_name.comp && element_name.data && element_name.dupl, tb_null);
+    tb_assert_and_check_return_val(element_data.data && element_data.dupl, tb_null);
+
+    // check bucket size
+    if (!bucket_size) bucket_size = TB_CONCURRENT_HASH_MAP_BUCKET_SIZE_DEFAULT;
+    tb_assert_and_check_return_val(bucket_size <= TB_CONCURRENT_HASH_MAP_BUCKET_MAXN, tb_null);
+
+    // done
+    tb_bool_t                   ok = tb_false;
+    tb_concurrent_hash_map_t*   hash_map = tb_null;
+    do
+    {
+        // duplicate the element data (e.g. string) to the given allocator
+        if (allocator && !element_name.allocator) element_name.allocator = allocator;
+        if (allocator && !element_data.allocator) element_data.allocator = allocator;
+
+        // no allocator? uses the global allocator
+        if (!allocator) allocator = tb_allocator();
+        tb_assert_and_check_break(allocator);
+
+        // make hash map
+        hash_map = (tb_concurrent_hash_map_t*)tb_allocator_malloc0(allocator, sizeof(tb_concurrent_hash_map_t));
+        tb_assert_and_check_break(hash_map);
+
+        // init hash map
+        hash_map->allocator     = allocator;
+        hash_map->element_name  = element_name;
+        hash_map->element_data  = element_data;
+        hash_map->bucket_size   = tb_align_pow2(bucket_size);
+        hash_map->stripe_mask   = tb_min(hash_map->bucket_size, TB_CONCURRENT_HASH_MAP_STRIPE_MAXN) - 1;
+
+        // init buckets
+        hash_map->buckets = (tb_concurrent_hash_map_node_t* __tb_volatile__*)tb_allocator_nalloc0(allocator, hash_map->bucket_size, sizeof(tb_pointer_t));
+        tb_assert_and_check_break(hash_map->buckets);
+
+#ifdef TB_CONCURRENT_HASH_MAP_RECORD_ENABLE
+        // init records
+        hash_map->records_data = tb_allocator_malloc0(allocator, (TB_CONCURRENT_HASH_MAP_RECORD_MAXN + 1) * sizeof(tb_concurrent_hash_map_record_t));
+        tb_assert_and_check_break(hash_map->records_data);
+        hash_map->records = (tb_concurrent_hash_map_record_t*)tb_align((tb_size_t)hash_map->records_data, TB_CONCURRENT_HASH_MAP_PADDING);
+#endif
+
+        // init locks
+        tb_size_t i = 0;
+        for (i = 0; i < TB_CONCURRENT_HASH_MAP_STRIPE_MAXN; i++)
+        {
+            if (!tb_spinlock_init(&hash_map->locks[i])) break;
+        }
+        tb_assert_and_check_break(i == TB_CONCURRENT_HASH_MAP_STRIPE_MAXN);
+        if (!tb_spinlock_init(&hash_map->reclaim_lock)) break;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (hash_map) tb_concurrent_hash_map_exit((tb_concurrent_hash_map_ref_t)hash_map);
+        hash_map = tb_null;
+    }
+
+    // ok?
+    return (tb_concurrent_hash_map_ref_t)hash_map;
+}
+tb_void_t tb_concurrent_hash_map_exit(tb_concurrent_hash_map_ref_t self)
+{
+    // check
+    tb_concurrent_hash_map_t* hash_map = (tb_concurrent_hash_map_t*)self;
+    tb_assert_and_check_return(hash_map);
+
+    // free all nodes
+    tb_size_t i = 0;
+    if (hash_map->buckets)
+    {
+        for (i = 0; i < hash_map->bucket_size; i++)
+        {
+            tb_concurrent_hash_map_node_t* node = hash_map->buckets[i];
+            while (node)
+            {
+                tb_concurrent_hash_map_node_t* next = node->next;
+                tb_concurrent_hash_map_node_exit(hash_map, node);
+                node = next;
+            }
+        }
+        tb_allocator_free(hash_map->allocator, (tb_pointer_t)hash_map->buckets);
+        hash_map->buckets = tb_null;
+    }
+
+    // free all retired nodes, no readers now
+    for (i = 0; i < tb_arrayn(hash_map->retired); i++)
+    {
+        tb_concurrent_hash_map_node_t* node = hash_map->retired[i];
+        while (node)
+        {
+            tb_concurrent_hash_map_node_t* next = node->retired_next;
+            tb_concurrent_hash_map_node_exit(hash_map, node);
+            node = next;
+        }
+        hash_map->retired[i] = tb_null;
+    }
+
+#ifdef TB_CONCURRENT_HASH_MAP_RECORD_ENABLE
+    // free records
+    if (hash_map->records_data) tb_allocator_free(hash_map->allocator, hash_map->records_data);
+    hash_map->records_data = tb_null;
+    hash_map->records = tb_null;
+#endif
+
+    // exit locks
+    for (i = 0; i < TB_CONCURRENT_HASH_MAP_STRIPE_MAXN; i++) tb_spinlock_exit(&hash_map->locks[i]);
+    tb_spinlock_exit(&hash_map->reclaim_lock);
+
+    // exit it
+    tb_allocator_free(hash_map->allocator, hash_map);
+}
+tb_void_t tb_concurrent_hash_map_clear(tb_concurrent_hash_map_ref_t self)
+{
+    // check
+    tb_concurrent_hash_map_t* hash_map = (tb_concurrent_hash_map_t*)self;
+    tb_assert_and_check_return(hash_map && hash_map->buckets);
+
+    // clear all buckets
+    tb_size_t i = 0;
+    for (i = 0; i < hash_map->bucket_size; i++)
+    {
+        // detach the nodes of this bucket
+        tb_spinlock_ref_t lock = &hash_map->locks[i & hash_map->stripe_mask];
+        tb_spinlock_enter(lock);
+        tb_concurrent_hash_map_node_t* node = hash_map->buckets[i];
+        hash_map->buckets[i] = tb_null;
+        tb_spinlock_leave(lock);
+
+        // retire them, the readers may be walking them now
+        while (node)
+        {
+            tb_concurrent_hash_map_node_t* next = node->next;
+            tb_concurrent_hash_map_retire(hash_map, node);
+            tb_atomic_fetch_and_sub(&hash_map->size, 1);
+            node = next;
+        }
+    }
+}
+tb_void_t tb_concurrent_hash_map_enter(tb_concurrent_hash_map_ref_t self)
+{
+    // check
+    tb_concurrent_hash_map_t* hash_map = (tb_concurrent_hash_map_t*)self;
+    tb_assert_and_check_return(hash_map);
+
+#ifdef TB_CONCURRENT_HASH_MAP_RECORD_ENABLE
+    // announce the current epoch in the record of this thread
+    tb_concurrent_hash_map_record_t* record = tb_concurrent_hash_map_record(hash_map);
+    if (record)
+    {
+        if (!record->nest++)
+        {
+            record->state = (hash_map->epoch << 1) | 0x1;
+
+            // the state must be visible before reading nodes
+            tb_barrier();
+        }
+        return ;
+    }
+#endif
+
+    // count it in the shared readers
+    tb_atomic_fetch_and_add(&hash_map->shared, 1);
+}
+tb_void_t tb_concurrent_hash_map_leave(tb_concurrent_hash_map_ref_t self)
+{
+    // check
+    tb_concurrent_hash_map_t* hash_map = (tb_concurrent_hash_map_t*)self;
+    tb_assert_and_check_return(hash_map);
+
+#ifdef TB_CONCURRENT_HASH_MAP_RECORD_ENABLE
+    // leave the epoch
+    tb_concurrent_hash_map_record_t* record = tb_concurrent_hash_map_record(hash_map);
+    if (record)
+    {
+        tb_assert(record->nest);
+        if (!--record->nest)
+        {
+            // finish reading nodes before clearing the state
+            tb_barrier();
+            record->state = 0;
+        }
+        return ;
+    }
+#endif
+
+    // uncount it
+    tb_atomic_fetch_and_sub(&hash_map->shared, 1);
+}
+tb_pointer_t tb_concurrent_hash_map_get(tb_concurrent_hash_map_ref_t self, tb_cpointer_t name)
+{
+    // check
+    tb_concurrent_hash_map_t* hash_map = (tb_concurrent_hash_map_t*)self;
+    tb_assert_and_check_return_val(hash_map && hash_map->buckets, tb_null);
+
+    // the bucket
+    tb_size_t buck = hash_map->element_name.hash(&hash_map->element_name, name, hash_map->bucket_size - 1, 0);
+    tb_assert_and_check_return_val(buck < hash_map->bucket_size, tb_null);
+
+    // enter the read section
+    tb_concurrent_hash_map_enter(self);
+
+    // find it without lock
+    tb_pointer_t data = tb_null;
+    tb_concurrent_hash_map_node_t* node = tb_concurrent_hash_map_node_find(hash_map, buck, name);
+    if (node) data = hash_map->element_data.data(&hash_map->element_data, tb_concurrent_hash_map_node_data(node) + hash_map->element_name.size);
+
+    // leave the read section
+    tb_concurrent_hash_map_leave(self);
+
+    // ok?
+    return data;
+}
+tb_bool_t tb_concurrent_hash_map_insert(tb_concurrent_hash_map_ref_t self, tb_cpointer_t name, tb_cpointer_t data)
+{
+    // check
+    tb_concurrent_hash_map_t* hash_map = (tb_concurrent_hash_map_t*)self;
+    tb_assert_and_check_return_val(hash_map && hash_map->buckets, tb_false);
+
+    // the bucket
+    tb_size_t buck = hash_map->element_name.hash(&hash_map->element_name, name, hash_map->bucket_size - 1, 0);
+    tb_assert_and_check_return_val(buck < hash_map->bucket_size, tb_false);
+
+    // make the new node, the readers will see the whole node or nothing
+    tb_concurrent_hash_map_node_t* node = tb_concurrent_hash_map_node_init(hash_map, name, data);
+    tb_assert_and_check_return_val(node, tb_false);
+
+    // enter the stripe lock
+    tb_spinlock_ref_t lock = &hash_map->locks[buck & hash_map->stripe_mask];
+    tb_spinlock_enter(lock);
+
+    // replace the old node or insert it to the head of bucket
+    tb_concurrent_hash_map_node_t* __tb_volatile__* plink = tb_concurrent_hash_map_node_link(hash_map, buck, name);
+    tb_concurrent_hash_map_node_t* old = plink? *plink : tb_null;
+    if (old) node->next = old->next;
+    else 
+    {
+        plink = &hash_map->buckets[buck];
+        node->next = *plink;
+    }
+
+    // publish it after the node has been inited
+    tb_barrier();
+    *plink = node;
+
+    // leave the stripe lock
+    tb_spinlock_leave(lock);
+
+    // retire the old node
+    if (old) tb_concurrent_hash_map_retire(hash_map, old);
+    else tb_atomic_fetch_and_add(&hash_map->size, 1);
+
+    // ok
+    return tb_true;
+}
+tb_bool_t tb_concurrent_hash_map_remove(tb_concurrent_hash_map_ref_t self, tb_cpointer_t name)
+{
+    // check
+    tb_concurrent_hash_map_t* hash_map = (tb_concurrent_hash_map_t*)self;
+    tb_assert_and_check_return_val(hash_map && hash_map->buckets, tb_false);
+
+    // the bucket
+    tb_size_t buck = hash_map->element_name.hash(&hash_map->element_name, name, hash_map->bucket_size - 1, 0);
+    tb_assert_and_check_return_val(buck < hash_map->bucket_size, tb_false);
+
+    // enter the stripe lock
+    tb_spinlock_ref_t lock = &hash_map->locks[buck & hash_map->stripe_mask];
+    tb_spinlock_enter(lock);
+
+    // unlink it, the readers at this node can still walk to the next nodes
+    tb_concurrent_hash_map_node_t* __tb_volatile__* plink = tb_concurrent_hash_map_node_link(hash_map, buck, name);
+    tb_concurrent_hash_map_node_t* node = plink? *plink : tb_null;
+    if (node) *plink = node->next;
+
+    // leave the stripe lock
+    tb_spinlock_leave(lock);
+
+    // retire it
+    if (node) 
+    {
+        tb_concurrent_hash_map_retire(hash_map, node);
+        tb_atomic_fetch_and_sub(&hash_map->size, 1);
+    }
+
+    // ok?
+    return node? tb_true : tb_false;
+}
+tb_size_t tb_concurrent_hash_map_size(tb_concurrent_hash_map_ref_t self)
+{
+    // check
+    tb_concurrent_hash_map_t* hash_map = (tb_concurrent_hash_map_t*)self;
+    tb_assert_and_check_return_val(hash_map, 0);
+
+    // the size
+    return (tb_size_t)tb_atomic_get(&hash_map->size);
+}
+#ifdef __tb_debug__
+tb_void_t tb_concurrent_hash_map_dump(tb_concurrent_hash_map_ref_t self)
+{
+    // check
+    tb_concurrent_hash_map_t* hash_map = (tb_concurrent_hash_map_t*)self;
+    tb_assert_and_check_return(hash_map && hash_map->buckets);
+
+    // trace
+    tb_trace_i("");
+    tb_trace_i("self: size: %lu, buckets: %lu, epoch: %lu, retired: %lu", tb_concurrent_hash_map_size(self), hash_map->bucket_size, hash_map->epoch, hash_map->retired_count);
+
+    // dump items
+    tb_size_t i = 0;
+    tb_char_t name[4096];
+    tb_char_t data[4096];
+    tb_concurrent_hash_map_enter(self);
+    for (i = 0; i < hash_map->bucket_size; i++)
+    {
+        tb_concurrent_hash_map_node_t* node = hash_map->buckets[i];
+        for (; node; node = node->next)
+        {
+            // the item name and data
+            tb_pointer_t element_name = hash_map->element_name.data(&hash_map->element_name, tb_concurrent_hash_map_node_data(node));
+            tb_pointer_t element_data = hash_map->element_data.data(&hash_map->element_data, tb_concurrent_hash_map_node_data(node) + hash_map->element_name.size);
+
+            // trace
+            if (hash_map->element_name.cstr && hash_map->element_data.cstr)
+                tb_trace_i("    %s => %s", hash_map->element_name.cstr(&hash_map->element_name, element_name, name, sizeof(name)), hash_map->element_data.cstr(&hash_map->element_data, element_data, data, sizeof(data)));
+            else if (hash_map->element_name.cstr) 
+                tb_trace_i("    %s => %p", hash_map->element_name.cstr(&hash_map->element_name, element_name, name, sizeof(name)), element_data);
+            else tb_trace_i("    %p => %p", element_name, element_data);
+        }
+    }
+    tb_concurrent_hash_map_leave(self);
+}
+#endif
@@ -0,0 +1,215 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        concurrent_hash_map.h
+ * @ingroup     container
+ *
+ */
+#ifndef TB_CONTAINER_CONCURRENT_HASH_MAP_H
+#define TB_CONTAINER_CONCURRENT_HASH_MAP_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "element.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// the small hash bucket size
+#define TB_CONCURRENT_HASH_MAP_BUCKET_SIZE_SMALL      (256)
+
+/// the large hash bucket size
+#define TB_CONCURRENT_HASH_MAP_BUCKET_SIZE_LARGE      (65536)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the concurrent hash map ref type
+ *
+ * <pre>
+ *
+ * stripe locks:  | lock 0 | lock 1 | ... | lock n - 1 |       (only for writers, bucket & (n - 1))
+ *
+ * buckets:       | buck 0 | buck 1 | buck 2 | buck 3 | ... 
+ *                    |                 |
+ *                  node              node  <- readers walk the nodes without locks
+ *                    |                 
+ *                  node  --- removed or replaced ---> retired nodes of the current epoch
+ *                                                         |
+ *                                freed after all active readers have entered the next epochs
+ *
+ * </pre>
+ *
+ * the buckets count is fixed, so the bucket size need be close to the maximum items count.
+ */
+typedef __tb_typeref__(concurrent_hash_map);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init the concurrent hash map for the read-mostly data
+ *
+ * all interfaces are thread-safe, the readers never take locks and only announce their epochs,
+ * the writers lock the stripe of the bucket and retire the removed nodes,
+ * the retired nodes will be freed after all readers which may hold them have been left.
+ *
+ * @note the epoch records are indexed by the thread, 
+ * and the threads exceeding the maximum records count are counted by the shared atomic counter of the active readers,
+ * the retired nodes will not be freed while any of them is reading.
+ *
+ * @code
+ 
+    // init hash map
+    tb_concurrent_hash_map_ref_t hash_map = tb_concurrent_hash_map_init(0, tb_element_str(tb_true), tb_element_long());
+    if (hash_map)
+    {
+        // insert it in the writer thread
+        tb_concurrent_hash_map_insert(hash_map, "key", (tb_pointer_t)1);
+
+        // get it in the reader threads
+        tb_size_t value = (tb_size_t)tb_concurrent_hash_map_get(hash_map, "key");
+
+        // exit hash map
+        tb_concurrent_hash_map_exit(hash_map);
+    }
+ * @endcode
+ *
+ * @param bucket_size   the hash bucket size, using the default size if be zero
+ * @param element_name  the element for name
+ * @param element_data  the element for data
+ *
+ * @return              the hash map
+ */
+tb_concurrent_hash_map_ref_t    tb_concurrent_hash_map_init(tb_size_t bucket_size, tb_element_t element_name, tb_element_t element_data);
+
+/*! init the concurrent hash map with the given allocator
+ *
+ * the hash map, nodes and the duplicated element data (e.g. string) will be allocated from this allocator,
+ * and the allocator need be thread-safe.
+ *
+ * @param allocator     the allocator, uses the global allocator if be null
+ * @param bucket_size   the hash bucket size, using the default size if be zero
+ * @param element_name  the element for name
+ * @param element_data  the element for data
+ *
+ * @return              the hash map
+ */
+tb_concurrent_hash_map_ref_t    tb_concurrent_hash_map_init_with_allocator(tb_allocator_ref_t allocator, tb_size_t bucket_size, tb_element_t element_name, tb_element_t element_data);
+
+/*! exit the concurrent hash map
+ *
+ * @note it cannot be accessed by other threads now
+ *
+ * @param hash_map      the hash map
+ */
+tb_void_t                       tb_concurrent_hash_map_exit(tb_concurrent_hash_map_ref_t hash_map);
+
+/*! clear the concurrent hash map
+ *
+ * @param hash_map      the hash map
+ */
+tb_void_t                       tb_concurrent_hash_map_clear(tb_concurrent_hash_map_ref_t hash_map);
+
+/*! enter the read section
+ *
+ * the data returned by tb_concurrent_hash_map_get() will not be freed until leaving the read section,
+ * it is necessary for the data stored in the node, e.g. str, mem, ..., and it can be nested.
+ *
+ * @code
+ 
+    tb_concurrent_hash_map_enter(hash_map);
+    tb_char_t const* value = (tb_char_t const*)tb_concurrent_hash_map_get(hash_map, "key");
+    if (value) tb_trace_i("%s", value);
+    tb_concurrent_hash_map_leave(hash_map);
+ * @endcode
+ *
+ * @param hash_map      the hash map
+ */
+tb_void_t                       tb_concurrent_hash_map_enter(tb_concurrent_hash_map_ref_t hash_map);
+
+/*! leave the read section
+ *
+ * @param hash_map      the hash map
+ */
+tb_void_t                       tb_concurrent_hash_map_leave(tb_concurrent_hash_map_ref_t hash_map);
+
+/*! get the item data
+ *
+ * @param hash_map      the hash map
+ * @param name          the item name
+ *
+ * @return              the item data, it is only valid in the read section if it is stored in the node
+ */
+tb_pointer_t                    tb_concurrent_hash_map_get(tb_concurrent_hash_map_ref_t hash_map, tb_cpointer_t name);
+
+/*! insert or replace the item 
+ *
+ * the replaced node will be retired and the readers will see the old or new data
+ *
+ * @param hash_map      the hash map
+ * @param name          the item name
+ * @param data          the item data
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t                       tb_concurrent_hash_map_insert(tb_concurrent_hash_map_ref_t hash_map, tb_cpointer_t name, tb_cpointer_t data);
+
+/*! remove the item
+ *
+ * @param hash_map      the hash map
+ * @param name          the item name
+ *
+ * @return              tb_true if the item has been removed
+ */
+tb_bool_t                       tb_concurrent_hash_map_remove(tb_concurrent_hash_map_ref_t hash_map, tb_cpointer_t name);
+
+/*! the items count
+ *
+ * @param hash_map      the hash map
+ *
+ * @return              the items count
+ */
+tb_size_t                       tb_concurrent_hash_map_size(tb_concurrent_hash_map_ref_t hash_map);
+
+#ifdef __tb_debug__
+/*! dump the concurrent hash map
+ *
+ * @param hash_map      the hash map
+ */
+tb_void_t                       tb_concurrent_hash_map_dump(tb_concurrent_hash_map_ref_t hash_map);
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -31,12 +31,20 @@
  */
 #include "prefix.h"
 #include "element.h"
+#include "typed_element.h"
 #include "iterator.h"
 #include "heap.h"
+#include "typed_heap.h"
 #include "stack.h"
 #include "vector.h"
+#include "typed_vector.h"
 #include "hash_set.h"
 #include "hash_map.h"
+#include "flat_hash_map.h"
+#include "concurrent_hash_map.h"
+#include "concurrent_circle_queue.h"
+#include "typed_hash_map.h"
+#include "btree_map.h"
 #include "queue.h"
 #include "circle_queue.h"
 #include "priority_queue.h"
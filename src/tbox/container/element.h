@@ -30,6 +30,8 @@
  * includes
  */
 #include "prefix.h"
+#include "../memory/allocator.h"
+#include "../memory/string_pool.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
@@ -178,7 +180,8 @@ typedef enum __tb_element_type_t
 ,   TB_ELEMENT_TYPE_MEM            = 8     //!< memory
 ,   TB_ELEMENT_TYPE_OBJ            = 9     //!< object
 ,   TB_ELEMENT_TYPE_TRUE           = 10    //!< true
-,   TB_ELEMENT_TYPE_USER           = 11    //!< the user-defined type
+,   TB_ELEMENT_TYPE_ISTR           = 11    //!< interned string
+,   TB_ELEMENT_TYPE_USER           = 12    //!< the user-defined type
 
 }tb_element_type_t;
 
@@ -197,6 +200,9 @@ typedef struct __tb_element_t
     /// the priv data
     tb_cpointer_t               priv;
 
+    /// the allocator of the duplicated data, uses the global allocator if be null
+    tb_allocator_ref_t          allocator;
+
     /// the hash function
     tb_element_hash_func_t      hash;
 
@@ -291,6 +297,31 @@ tb_element_t        tb_element_uint32(tb_noarg_t);
  */
 tb_element_t        tb_element_str(tb_bool_t is_case); 
 
+/*! the interned string element
+ *
+ * the strings will be interned to the given string pool when they are duplicated to the container,
+ * and the interned strings are hashed by the precomputed hash and compared by the pointers.
+ *
+ * @note the data for finding must be the interned string of the same pool, e.g.
+ *
+ * @code
+    tb_hash_map_ref_t map = tb_hash_map_init(0, tb_element_istr(tb_null), tb_element_long());
+    if (map)
+    {
+        tb_char_t const* key = tb_string_pool_insert(tb_string_pool(), "content-length");
+        tb_hash_map_insert(map, key, (tb_pointer_t)1024);
+        tb_long_t size = (tb_long_t)tb_hash_map_get(map, key);
+        tb_string_pool_remove(tb_string_pool(), key);
+        tb_hash_map_exit(map);
+    }
+ * @endcode
+ *
+ * @param pool      the string pool, uses the global string pool if be null
+ *
+ * @return          the element
+ */
+tb_element_t        tb_element_istr(tb_string_pool_ref_t pool); 
+
 /*! the pointer element
  *
  * @note if the free function have been hooked, the nfree need hook too.
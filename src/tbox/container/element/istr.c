@@ -0,0 +1,172 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        istr.c
+ * @ingroup     container
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "hash.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tb_size_t tb_element_istr_hash(tb_element_ref_t element, tb_cpointer_t data, tb_size_t mask, tb_size_t index)
+{
+    // check
+    tb_assert_and_check_return_val(data && mask, 0);
+
+    // uses the precomputed hash of the interned string
+    return index? tb_element_hash_cstr((tb_char_t const*)data, mask, index) : (tb_string_pool_hash((tb_char_t const*)data) & mask);
+}
+static tb_long_t tb_element_istr_comp(tb_element_ref_t element, tb_cpointer_t ldata, tb_cpointer_t rdata)
+{
+    // the same interned strings have the same address
+    return ((tb_size_t)ldata < (tb_size_t)rdata)? -1 : ((tb_size_t)ldata > (tb_size_t)rdata);
+}
+static tb_pointer_t tb_element_istr_data(tb_element_ref_t element, tb_cpointer_t buff)
+{
+    // check
+    tb_assert_and_check_return_val(buff, tb_null);
+
+    // the element data
+    return *((tb_pointer_t*)buff);
+}
+static tb_char_t const* tb_element_istr_cstr(tb_element_ref_t element, tb_cpointer_t data, tb_char_t* cstr, tb_size_t maxn)
+{
+    // the c-string
+    return (tb_char_t const*)data;
+}
+static tb_void_t tb_element_istr_free(tb_element_ref_t element, tb_pointer_t buff)
+{
+    // check
+    tb_assert_and_check_return(element && element->priv && buff);
+
+    // exists?
+    tb_char_t const* cstr = *((tb_char_t const**)buff);
+    if (cstr) 
+    {
+        // remove it from the string pool
+        tb_string_pool_remove((tb_string_pool_ref_t)element->priv, cstr);
+
+        // clear it
+        *((tb_char_t const**)buff) = tb_null;
+    }
+}
+static tb_void_t tb_element_istr_dupl(tb_element_ref_t element, tb_pointer_t buff, tb_cpointer_t data)
+{
+    // check
+    tb_assert_and_check_return(element && element->priv && buff);
+
+    // insert it to the string pool
+    *((tb_char_t const**)buff) = data? tb_string_pool_insert((tb_string_pool_ref_t)element->priv, (tb_char_t const*)data) : tb_null;
+}
+static tb_void_t tb_element_istr_repl(tb_element_ref_t element, tb_pointer_t buff, tb_cpointer_t data)
+{
+    // check
+    tb_assert_and_check_return(element && buff);
+
+    // insert the new string first, the data may be the previous string
+    tb_char_t const* cstr = *((tb_char_t const**)buff);
+    tb_element_istr_dupl(element, buff, data);
+
+    // remove the previous string
+    if (cstr) tb_string_pool_remove((tb_string_pool_ref_t)element->priv, cstr);
+}
+static tb_void_t tb_element_istr_copy(tb_element_ref_t element, tb_pointer_t buff, tb_cpointer_t data)
+{
+    // check
+    tb_assert_and_check_return(buff);
+
+    // copy it
+    *((tb_cpointer_t*)buff) = data;
+}
+static tb_void_t tb_element_istr_nfree(tb_element_ref_t element, tb_pointer_t buff, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return(element && buff);
+
+    // free elements 
+    if (element->free)
+    {
+        tb_size_t n = size;
+        while (n--) element->free(element, (tb_byte_t*)buff + n * sizeof(tb_char_t*));
+    }
+
+    // clear
+    if (size) tb_memset(buff, 0, size * sizeof(tb_char_t*));
+}
+static tb_void_t tb_element_istr_ndupl(tb_element_ref_t element, tb_pointer_t buff, tb_cpointer_t data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return(element && buff);
+
+    // dupl elements
+    if (element->dupl) while (size--) element->dupl(element, (tb_byte_t*)buff + size * sizeof(tb_char_t*), data);
+}
+static tb_void_t tb_element_istr_nrepl(tb_element_ref_t element, tb_pointer_t buff, tb_cpointer_t data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return(element && buff && data);
+
+    // repl elements
+    if (element->repl) while (size--) element->repl(element, (tb_byte_t*)buff + size * sizeof(tb_char_t*), data);
+}
+static tb_void_t tb_element_istr_ncopy(tb_element_ref_t element, tb_pointer_t buff, tb_cpointer_t data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return(buff);
+
+    // fill elements
+    if (size) tb_memset_ptr(buff, data, size);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+tb_element_t tb_element_istr(tb_string_pool_ref_t pool)
+{
+    // init element
+    tb_element_t element = {0};
+    element.type   = TB_ELEMENT_TYPE_ISTR;
+    element.flag   = 0;
+    element.priv   = pool? pool : tb_string_pool();
+    element.hash   = tb_element_istr_hash;
+    element.comp   = tb_element_istr_comp;
+    element.data   = tb_element_istr_data;
+    element.cstr   = tb_element_istr_cstr;
+    element.free   = tb_element_istr_free;
+    element.dupl   = tb_element_istr_dupl;
+    element.repl   = tb_element_istr_repl;
+    element.copy   = tb_element_istr_copy;
+    element.nfree  = tb_element_istr_nfree;
+    element.ndupl  = tb_element_istr_ndupl;
+    element.nrepl  = tb_element_istr_nrepl;
+    element.ncopy  = tb_element_istr_ncopy;
+    element.size   = sizeof(tb_char_t*);
+
+    // ok?
+    return element;
+}
@@ -68,7 +68,8 @@ static tb_void_t tb_element_str_free(tb_element_ref_t element, tb_pointer_t buff
     if (cstr) 
     {
         // free it
-        tb_free(cstr);
+        if (element->allocator) tb_allocator_free(element->allocator, cstr);
+        else tb_free(cstr);
 
         // clear it
         *((tb_pointer_t*)buff) = tb_null;
@@ -79,8 +80,16 @@ static tb_void_t tb_element_str_dupl(tb_element_ref_t element, tb_pointer_t buff
     // check
     tb_assert_and_check_return(element && buff);
 
+    // duplicate it to the given allocator
+    if (data && element->allocator) 
+    {
+        tb_size_t   size = tb_strlen((tb_char_t const*)data);
+        tb_char_t*  cstr = (tb_char_t*)tb_allocator_malloc(element->allocator, size + 1);
+        if (cstr) tb_memcpy(cstr, data, size + 1);
+        *((tb_char_t const**)buff) = cstr;
+    }
     // duplicate it
-    if (data) *((tb_char_t const**)buff) = tb_strdup((tb_char_t const*)data);
+    else if (data) *((tb_char_t const**)buff) = tb_strdup((tb_char_t const*)data);
     // clear it
     else *((tb_char_t const**)buff) = tb_null;
 }
@@ -116,7 +125,7 @@ static tb_void_t tb_element_str_repl(tb_element_ref_t element, tb_pointer_t buff
             tb_size_t copy = p - (tb_char_t*)cstr;
 
             // grow size
-            cstr = tb_ralloc(cstr, copy + left + 1);
+            cstr = element->allocator? tb_allocator_ralloc(element->allocator, cstr, copy + left + 1) : tb_ralloc(cstr, copy + left + 1);
             tb_assert(cstr);
 
             // copy the left data
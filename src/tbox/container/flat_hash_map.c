@@ -0,0 +1,683 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        flat_hash_map.c
+ * @ingroup     container
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME                "flat_hash_map"
+#define TB_TRACE_MODULE_DEBUG               (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "flat_hash_map.h"
+#include "../libc/libc.h"
+#include "../math/math.h"
+#include "../utils/utils.h"
+#include "../memory/memory.h"
+#include "../platform/platform.h"
+#include "../algorithm/algorithm.h"
+#ifdef TB_ARCH_SSE2
+#   include <emmintrin.h>
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the control byte of the empty slot
+#define TB_FLAT_HASH_MAP_CTRL_EMPTY                 (0x80)
+
+// the control byte of the deleted slot
+#define TB_FLAT_HASH_MAP_CTRL_DELETED               (0xfe)
+
+// the minimum slots count
+#define TB_FLAT_HASH_MAP_SLOT_MINN                  (TB_FLAT_HASH_MAP_GROUP_WIDTH)
+
+// the default items count
+#ifdef __tb_small__
+#   define TB_FLAT_HASH_MAP_ITEM_SIZE_DEFAULT       (16)
+#else
+#   define TB_FLAT_HASH_MAP_ITEM_SIZE_DEFAULT       (64)
+#endif
+
+// the control byte is full?
+#define tb_flat_hash_map_ctrl_is_full(ctrl)         (!((ctrl) & 0x80))
+
+// the h1 and h2 of the hash
+#define tb_flat_hash_map_h1(hash)                   ((hash) >> 7)
+#define tb_flat_hash_map_h2(hash)                   ((tb_byte_t)((hash) & 0x7f))
+
+// the maximum items count of the given slots count, the load factor is 7/8
+#define tb_flat_hash_map_growth(slot_maxn)          ((slot_maxn) - ((slot_maxn) >> 3))
+
+// the slot data
+#define tb_flat_hash_map_slot(hash_map, i)          ((hash_map)->slots + (i) * (hash_map)->slot_step)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the flat hash map type
+typedef struct __tb_flat_hash_map_t
+{
+    // the item itor
+    tb_iterator_t                   itor;
+
+    // the control bytes, (slot_maxn + group width) bytes, the first group is cloned to the tail
+    tb_byte_t*                      ctrls;
+
+    // the slots
+    tb_byte_t*                      slots;
+
+    // the slots count, must be power of 2
+    tb_size_t                       slot_maxn;
+
+    // the slot step
+    tb_size_t                       slot_step;
+
+    // the items count
+    tb_size_t                       item_size;
+
+    // the left items count for growing, the deleted slots are not included
+    tb_size_t                       growth_left;
+
+    // the current item for iterator
+    tb_flat_hash_map_item_t         item;
+
+    // the element for name
+    tb_element_t                    element_name;
+
+    // the element for data
+    tb_element_t                    element_data;
+
+    // the allocator
+    tb_allocator_ref_t              allocator;
+
+}tb_flat_hash_map_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+#ifdef TB_ARCH_SSE2
+static __tb_inline__ tb_uint32_t tb_flat_hash_map_group_match(tb_byte_t const* ctrl, tb_byte_t h2)
+{
+    __m128i group = _mm_loadu_si128((__m128i const*)ctrl);
+    return (tb_uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8((tb_char_t)h2), group));
+}
+static __tb_inline__ tb_uint32_t tb_flat_hash_map_group_match_empty(tb_byte_t const* ctrl)
+{
+    return tb_flat_hash_map_group_match(ctrl, TB_FLAT_HASH_MAP_CTRL_EMPTY);
+}
+static __tb_inline__ tb_uint32_t tb_flat_hash_map_group_match_free(tb_byte_t const* ctrl)
+{
+    // the empty and deleted control bytes have the sign bit
+    return (tb_uint32_t)_mm_movemask_epi8(_mm_loadu_si128((__m128i const*)ctrl));
+}
+#else
+static __tb_inline__ tb_uint32_t tb_flat_hash_map_group_match(tb_byte_t const* ctrl, tb_byte_t h2)
+{
+    tb_size_t   i = 0;
+    tb_uint32_t mask = 0;
+    for (i = 0; i < TB_FLAT_HASH_MAP_GROUP_WIDTH; i++)
+        if (ctrl[i] == h2) mask |= (1 << i);
+    return mask;
+}
+static __tb_inline__ tb_uint32_t tb_flat_hash_map_group_match_empty(tb_byte_t const* ctrl)
+{
+    return tb_flat_hash_map_group_match(ctrl, TB_FLAT_HASH_MAP_CTRL_EMPTY);
+}
+static __tb_inline__ tb_uint32_t tb_flat_hash_map_group_match_free(tb_byte_t const* ctrl)
+{
+    tb_size_t   i = 0;
+    tb_uint32_t mask = 0;
+    for (i = 0; i < TB_FLAT_HASH_MAP_GROUP_WIDTH; i++)
+        if (!tb_flat_hash_map_ctrl_is_full(ctrl[i])) mask |= (1 << i);
+    return mask;
+}
+#endif
+static __tb_inline__ tb_size_t tb_flat_hash_map_hash(tb_flat_hash_map_t* hash_map, tb_cpointer_t name)
+{
+    // the element hash, some element hashs are too weak (e.g. long) or only have 32 bits
+    tb_size_t hash = hash_map->element_name.hash(&hash_map->element_name, name, TB_MAXU32, 0);
+
+    // mix all bits for h1 and h2
+#if TB_CPU_BIT64
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ull;
+    hash ^= hash >> 33;
+#else
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6b;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35;
+    hash ^= hash >> 16;
+#endif
+    return hash;
+}
+static __tb_inline__ tb_void_t tb_flat_hash_map_ctrl_set(tb_flat_hash_map_t* hash_map, tb_size_t index, tb_byte_t ctrl)
+{
+    // set it and the cloned control byte at the tail
+    hash_map->ctrls[index] = ctrl;
+    if (index < TB_FLAT_HASH_MAP_GROUP_WIDTH) hash_map->ctrls[hash_map->slot_maxn + index] = ctrl;
+}
+static tb_bool_t tb_flat_hash_map_slot_find(tb_flat_hash_map_t* hash_map, tb_cpointer_t name, tb_size_t hash, tb_size_t* pindex)
+{
+    // check
+    tb_assert(hash_map && pindex);
+
+    // no slots?
+    tb_check_return_val(hash_map->slot_maxn, tb_false);
+
+    // probe groups by the triangular sequence, it will visit all groups because the groups count is power of 2
+    tb_size_t                   mask = hash_map->slot_maxn - 1;
+    tb_size_t                   pos = tb_flat_hash_map_h1(hash) & mask;
+    tb_size_t                   step = 0;
+    tb_byte_t                   h2 = tb_flat_hash_map_h2(hash);
+    tb_element_ref_t            element_name = &hash_map->element_name;
+    while (1)
+    {
+        // match h2 of this group
+        tb_byte_t const*    group = hash_map->ctrls + pos;
+        tb_uint32_t         match = tb_flat_hash_map_group_match(group, h2);
+        while (match)
+        {
+            // compare the name of the matched slot
+            tb_size_t index = (pos + tb_bits_cl0_u32_le(match)) & mask;
+            if (!element_name->comp(element_name, name, element_name->data(element_name, tb_flat_hash_map_slot(hash_map, index))))
+            {
+                *pindex = index;
+                return tb_true;
+            }
+            match &= match - 1;
+        }
+
+        // has empty slot? not found
+        if (tb_flat_hash_map_group_match_empty(group)) break;
+
+        // next group
+        step += TB_FLAT_HASH_MAP_GROUP_WIDTH;
+        tb_assert_and_check_break(step <= hash_map->slot_maxn);
+        pos = (pos + step) & mask;
+    }
+
+    // not found
+    return tb_false;
+}
+static tb_size_t tb_flat_hash_map_slot_find_free(tb_flat_hash_map_t* hash_map, tb_size_t hash)
+{
+    // check
+    tb_assert(hash_map && hash_map->slot_maxn);
+
+    // find the first empty or deleted slot
+    tb_size_t mask = hash_map->slot_maxn - 1;
+    tb_size_t pos = tb_flat_hash_map_h1(hash) & mask;
+    tb_size_t step = 0;
+    while (1)
+    {
+        // has free slot?
+        tb_uint32_t match = tb_flat_hash_map_group_match_free(hash_map->ctrls + pos);
+        if (match) return (pos + tb_bits_cl0_u32_le(match)) & mask;
+
+        // next group
+        step += TB_FLAT_HASH_MAP_GROUP_WIDTH;
+        pos = (pos + step) & mask;
+    }
+
+    // unreachable
+    return 0;
+}
+static tb_bool_t tb_flat_hash_map_resize(tb_flat_hash_map_t* hash_map, tb_size_t slot_maxn)
+{
+    // check
+    tb_assert(hash_map && slot_maxn >= TB_FLAT_HASH_MAP_SLOT_MINN && tb_ispow2(slot_maxn));
+    tb_assert(tb_flat_hash_map_growth(slot_maxn) >= hash_map->item_size);
+
+    // make the new ctrls and slots
+    tb_byte_t* ctrls = (tb_byte_t*)tb_allocator_malloc(hash_map->allocator, slot_maxn + TB_FLAT_HASH_MAP_GROUP_WIDTH);
+    tb_byte_t* slots = (tb_byte_t*)tb_allocator_nalloc(hash_map->allocator, slot_maxn, hash_map->slot_step);
+    if (!ctrls || !slots)
+    {
+        if (ctrls) tb_allocator_free(hash_map->allocator, ctrls);
+        if (slots) tb_allocator_free(hash_map->allocator, slots);
+        return tb_false;
+    }
+    tb_memset(ctrls, TB_FLAT_HASH_MAP_CTRL_EMPTY, slot_maxn + TB_FLAT_HASH_MAP_GROUP_WIDTH);
+
+    // save the old ctrls and slots
+    tb_byte_t*  ctrls_old = hash_map->ctrls;
+    tb_byte_t*  slots_old = hash_map->slots;
+    tb_size_t   slot_maxn_old = hash_map->slot_maxn;
+
+    // switch to the new ctrls and slots
+    hash_map->ctrls         = ctrls;
+    hash_map->slots         = slots;
+    hash_map->slot_maxn     = slot_maxn;
+    hash_map->growth_left   = tb_flat_hash_map_growth(slot_maxn) - hash_map->item_size;
+
+    // move the items to the new slots, the element data need not be duplicated
+    tb_size_t       i = 0;
+    tb_size_t       step = hash_map->slot_step;
+    tb_element_ref_t element_name = &hash_map->element_name;
+    for (i = 0; i < slot_maxn_old; i++)
+    {
+        // full slot?
+        tb_check_continue(tb_flat_hash_map_ctrl_is_full(ctrls_old[i]));
+
+        // move it
+        tb_byte_t const*    slot = slots_old + i * step;
+        tb_size_t           hash = tb_flat_hash_map_hash(hash_map, element_name->data(element_name, slot));
+        tb_size_t           index = tb_flat_hash_map_slot_find_free(hash_map, hash);
+        tb_flat_hash_map_ctrl_set(hash_map, index, tb_flat_hash_map_h2(hash));
+        tb_memcpy(tb_flat_hash_map_slot(hash_map, index), slot, step);
+    }
+
+    // free the old ctrls and slots
+    if (ctrls_old) tb_allocator_free(hash_map->allocator, ctrls_old);
+    if (slots_old) tb_allocator_free(hash_map->allocator, slots_old);
+
+    // ok
+    return tb_true;
+}
+static tb_void_t tb_flat_hash_map_slot_remove(tb_flat_hash_map_t* hash_map, tb_size_t index)
+{
+    // check
+    tb_assert(hash_map && index < hash_map->slot_maxn && tb_flat_hash_map_ctrl_is_full(hash_map->ctrls[index]));
+
+    // free item
+    tb_byte_t* slot = tb_flat_hash_map_slot(hash_map, index);
+    if (hash_map->element_name.free) hash_map->element_name.free(&hash_map->element_name, slot);
+    if (hash_map->element_data.free) hash_map->element_data.free(&hash_map->element_data, slot + hash_map->element_name.size);
+
+    /* we can mark it as empty if no probing sequence passes it,
+     * that is the groups before and after it have the empty slots which are close enough
+     */
+    tb_size_t   mask = hash_map->slot_maxn - 1;
+    tb_uint32_t empty_before = tb_flat_hash_map_group_match_empty(hash_map->ctrls + ((index - TB_FLAT_HASH_MAP_GROUP_WIDTH) & mask));
+    tb_uint32_t empty_after = tb_flat_hash_map_group_match_empty(hash_map->ctrls + index);
+    tb_size_t   before = empty_before? tb_bits_cl0_u32_be(empty_before << 16) : TB_FLAT_HASH_MAP_GROUP_WIDTH;
+    tb_size_t   after = empty_after? tb_bits_cl0_u32_le(empty_after) : TB_FLAT_HASH_MAP_GROUP_WIDTH;
+    if (before + after < TB_FLAT_HASH_MAP_GROUP_WIDTH)
+    {
+        tb_flat_hash_map_ctrl_set(hash_map, index, TB_FLAT_HASH_MAP_CTRL_EMPTY);
+        hash_map->growth_left++;
+    }
+    else tb_flat_hash_map_ctrl_set(hash_map, index, TB_FLAT_HASH_MAP_CTRL_DELETED);
+
+    // update the items count
+    hash_map->item_size--;
+}
+static tb_size_t tb_flat_hash_map_itor_size(tb_iterator_ref_t iterator)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)iterator;
+    tb_assert(hash_map);
+
+    // the size
+    return hash_map->item_size;
+}
+static tb_size_t tb_flat_hash_map_itor_next(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)iterator;
+    tb_assert(hash_map && itor <= hash_map->slot_maxn);
+
+    // find the next full slot, the itor is (index + 1)
+    tb_size_t i = itor;
+    tb_size_t n = hash_map->slot_maxn;
+    for (; i < n; i++)
+    {
+        if (tb_flat_hash_map_ctrl_is_full(hash_map->ctrls[i])) return i + 1;
+    }
+
+    // tail
+    return 0;
+}
+static tb_size_t tb_flat_hash_map_itor_head(tb_iterator_ref_t iterator)
+{
+    return tb_flat_hash_map_itor_next(iterator, 0);
+}
+static tb_size_t tb_flat_hash_map_itor_tail(tb_iterator_ref_t iterator)
+{
+    return 0;
+}
+static tb_pointer_t tb_flat_hash_map_itor_item(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)iterator;
+    tb_assert_and_check_return_val(hash_map && itor && itor <= hash_map->slot_maxn, tb_null);
+
+    // get item
+    tb_byte_t const* slot = tb_flat_hash_map_slot(hash_map, itor - 1);
+    hash_map->item.name = hash_map->element_name.data(&hash_map->element_name, slot);
+    hash_map->item.data = hash_map->element_data.data(&hash_map->element_data, slot + hash_map->element_name.size);
+    return &(hash_map->item);
+}
+static tb_void_t tb_flat_hash_map_itor_copy(tb_iterator_ref_t iterator, tb_size_t itor, tb_cpointer_t item)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)iterator;
+    tb_assert(hash_map && itor && itor <= hash_map->slot_maxn);
+
+    // note: copy data only, will destroy hash_map index if copy name
+    hash_map->element_data.copy(&hash_map->element_data, tb_flat_hash_map_slot(hash_map, itor - 1) + hash_map->element_name.size, item);
+}
+static tb_long_t tb_flat_hash_map_itor_comp(tb_iterator_ref_t iterator, tb_cpointer_t lelement, tb_cpointer_t relement)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)iterator;
+    tb_assert(hash_map && hash_map->element_name.comp && lelement && relement);
+    
+    // done
+    return hash_map->element_name.comp(&hash_map->element_name, ((tb_flat_hash_map_item_ref_t)lelement)->name, ((tb_flat_hash_map_item_ref_t)relement)->name);
+}
+static tb_void_t tb_flat_hash_map_itor_remove(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)iterator;
+    tb_assert(hash_map && itor && itor <= hash_map->slot_maxn);
+
+    // remove it
+    tb_flat_hash_map_slot_remove(hash_map, itor - 1);
+}
+static tb_void_t tb_flat_hash_map_itor_remove_range(tb_iterator_ref_t iterator, tb_size_t prev, tb_size_t next, tb_size_t size)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)iterator;
+    tb_assert(hash_map);
+
+    // no size
+    tb_check_return(size);
+
+    // remove items: (prev, next), the removed slots will not be moved
+    tb_size_t itor = prev? tb_flat_hash_map_itor_next(iterator, prev) : tb_flat_hash_map_itor_head(iterator);
+    while (itor && itor != next && size--)
+    {
+        tb_flat_hash_map_slot_remove(hash_map, itor - 1);
+        itor = tb_flat_hash_map_itor_next(iterator, itor);
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_flat_hash_map_ref_t tb_flat_hash_map_init(tb_size_t item_size, tb_element_t element_name, tb_element_t element_data)
+{
+    return tb_flat_hash_map_init_with_allocator(tb_null, item_size, element_name, element_data);
+}
+tb_flat_hash_map_ref_t tb_flat_hash_map_init_with_allocator(tb_allocator_ref_t allocator, tb_size_t item_size, tb_element_t element_name, tb_element_t element_data)
+{
+    // check
+    tb_assert_and_check_return_val(element_name.size && element_name.hash && element_name.comp && element_name.data && element_name.dupl, tb_null);
+    tb_assert_and_check_return_val(element_data.data && element_data.dupl && element_data.repl, tb_null);
+
+    // done
+    tb_bool_t           ok = tb_false;
+    tb_flat_hash_map_t* hash_map = tb_null;
+    do
+    {
+        // duplicate the element data (e.g. string) to the given allocator
+        if (allocator && !element_name.allocator) element_name.allocator = allocator;
+        if (allocator && !element_data.allocator) element_data.allocator = allocator;
+
+        // no allocator? uses the global allocator
+        if (!allocator) allocator = tb_allocator();
+        tb_assert_and_check_break(allocator);
+
+        // make hash map
+        hash_map = (tb_flat_hash_map_t*)tb_allocator_malloc0(allocator, sizeof(tb_flat_hash_map_t));
+        tb_assert_and_check_break(hash_map);
+
+        // init allocator
+        hash_map->allocator = allocator;
+
+        // init element
+        hash_map->element_name = element_name;
+        hash_map->element_data = element_data;
+        hash_map->slot_step = element_name.size + element_data.size;
+
+        // init item itor
+        hash_map->itor.mode             = TB_ITERATOR_MODE_FORWARD | TB_ITERATOR_MODE_MUTABLE;
+        hash_map->itor.priv             = tb_null;
+        hash_map->itor.step             = sizeof(tb_flat_hash_map_item_t);
+        hash_map->itor.size             = tb_flat_hash_map_itor_size;
+        hash_map->itor.head             = tb_flat_hash_map_itor_head;
+        hash_map->itor.tail             = tb_flat_hash_map_itor_tail;
+        hash_map->itor.prev             = tb_null;
+        hash_map->itor.next             = tb_flat_hash_map_itor_next;
+        hash_map->itor.item             = tb_flat_hash_map_itor_item;
+        hash_map->itor.copy             = tb_flat_hash_map_itor_copy;
+        hash_map->itor.comp             = tb_flat_hash_map_itor_comp;
+        hash_map->itor.remove           = tb_flat_hash_map_itor_remove;
+        hash_map->itor.remove_range     = tb_flat_hash_map_itor_remove_range;
+
+        // init slots for the given items count
+        if (!item_size) item_size = TB_FLAT_HASH_MAP_ITEM_SIZE_DEFAULT;
+        tb_size_t slot_maxn = TB_FLAT_HASH_MAP_SLOT_MINN;
+        while (tb_flat_hash_map_growth(slot_maxn) < item_size) slot_maxn <<= 1;
+        if (!tb_flat_hash_map_resize(hash_map, slot_maxn)) break;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (hash_map) tb_flat_hash_map_exit((tb_flat_hash_map_ref_t)hash_map);
+        hash_map = tb_null;
+    }
+
+    // ok?
+    return (tb_flat_hash_map_ref_t)hash_map;
+}
+tb_void_t tb_flat_hash_map_exit(tb_flat_hash_map_ref_t self)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)self;
+    tb_assert_and_check_return(hash_map);
+
+    // clear it
+    tb_flat_hash_map_clear(self);
+
+    // free ctrls and slots
+    if (hash_map->ctrls) tb_allocator_free(hash_map->allocator, hash_map->ctrls);
+    if (hash_map->slots) tb_allocator_free(hash_map->allocator, hash_map->slots);
+
+    // free it
+    tb_allocator_free(hash_map->allocator, hash_map);
+}
+tb_void_t tb_flat_hash_map_clear(tb_flat_hash_map_ref_t self)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)self;
+    tb_assert_and_check_return(hash_map);
+
+    // no slots?
+    tb_check_return(hash_map->ctrls);
+
+    // free items
+    if (hash_map->item_size && (hash_map->element_name.free || hash_map->element_data.free))
+    {
+        tb_size_t i = 0;
+        tb_size_t n = hash_map->slot_maxn;
+        for (i = 0; i < n; i++)
+        {
+            tb_check_continue(tb_flat_hash_map_ctrl_is_full(hash_map->ctrls[i]));
+
+            tb_byte_t* slot = tb_flat_hash_map_slot(hash_map, i);
+            if (hash_map->element_name.free) hash_map->element_name.free(&hash_map->element_name, slot);
+            if (hash_map->element_data.free) hash_map->element_data.free(&hash_map->element_data, slot + hash_map->element_name.size);
+        }
+    }
+
+    // reset ctrls
+    tb_memset(hash_map->ctrls, TB_FLAT_HASH_MAP_CTRL_EMPTY, hash_map->slot_maxn + TB_FLAT_HASH_MAP_GROUP_WIDTH);
+
+    // reset info
+    hash_map->item_size     = 0;
+    hash_map->growth_left   = tb_flat_hash_map_growth(hash_map->slot_maxn);
+    tb_memset(&hash_map->item, 0, sizeof(tb_flat_hash_map_item_t));
+}
+tb_pointer_t tb_flat_hash_map_get(tb_flat_hash_map_ref_t self, tb_cpointer_t name)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)self;
+    tb_assert_and_check_return_val(hash_map, tb_null);
+
+    // find it
+    tb_size_t index = 0;
+    if (!tb_flat_hash_map_slot_find(hash_map, name, tb_flat_hash_map_hash(hash_map, name), &index)) return tb_null;
+
+    // get data
+    return hash_map->element_data.data(&hash_map->element_data, tb_flat_hash_map_slot(hash_map, index) + hash_map->element_name.size);
+}
+tb_size_t tb_flat_hash_map_find(tb_flat_hash_map_ref_t self, tb_cpointer_t name)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)self;
+    tb_assert_and_check_return_val(hash_map, 0);
+
+    // find it
+    tb_size_t index = 0;
+    return tb_flat_hash_map_slot_find(hash_map, name, tb_flat_hash_map_hash(hash_map, name), &index)? index + 1 : 0;
+}
+tb_size_t tb_flat_hash_map_insert(tb_flat_hash_map_ref_t self, tb_cpointer_t name, tb_cpointer_t data)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)self;
+    tb_assert_and_check_return_val(hash_map && hash_map->slot_maxn, 0);
+
+    // exists? replace data
+    tb_size_t index = 0;
+    tb_size_t hash = tb_flat_hash_map_hash(hash_map, name);
+    if (tb_flat_hash_map_slot_find(hash_map, name, hash, &index))
+    {
+        hash_map->element_data.repl(&hash_map->element_data, tb_flat_hash_map_slot(hash_map, index) + hash_map->element_name.size, data);
+        return index + 1;
+    }
+
+    // find the free slot
+    index = tb_flat_hash_map_slot_find_free(hash_map, hash);
+
+    // no growth left for the empty slot? 
+    if (!hash_map->growth_left && hash_map->ctrls[index] == TB_FLAT_HASH_MAP_CTRL_EMPTY)
+    {
+        /* too many deleted slots? only rehash them in place
+         * otherwise grow the slots
+         */
+        tb_size_t slot_maxn = hash_map->slot_maxn;
+        if (hash_map->item_size >= (tb_flat_hash_map_growth(slot_maxn) >> 1)) slot_maxn <<= 1;
+        if (!tb_flat_hash_map_resize(hash_map, slot_maxn)) return 0;
+
+        // find the free slot again
+        index = tb_flat_hash_map_slot_find_free(hash_map, hash);
+    }
+    tb_assert_and_check_return_val(index < hash_map->slot_maxn, 0);
+
+    // update the growth left if it is empty slot
+    if (hash_map->ctrls[index] == TB_FLAT_HASH_MAP_CTRL_EMPTY) hash_map->growth_left--;
+
+    // dupl item
+    tb_byte_t* slot = tb_flat_hash_map_slot(hash_map, index);
+    tb_flat_hash_map_ctrl_set(hash_map, index, tb_flat_hash_map_h2(hash));
+    hash_map->element_name.dupl(&hash_map->element_name, slot, name);
+    hash_map->element_data.dupl(&hash_map->element_data, slot + hash_map->element_name.size, data);
+
+    // update the items count
+    hash_map->item_size++;
+
+    // ok
+    return index + 1;
+}
+tb_void_t tb_flat_hash_map_remove(tb_flat_hash_map_ref_t self, tb_cpointer_t name)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)self;
+    tb_assert_and_check_return(hash_map);
+
+    // find it and remove it
+    tb_size_t index = 0;
+    if (tb_flat_hash_map_slot_find(hash_map, name, tb_flat_hash_map_hash(hash_map, name), &index))
+        tb_flat_hash_map_slot_remove(hash_map, index);
+}
+tb_size_t tb_flat_hash_map_size(tb_flat_hash_map_ref_t self)
+{
+    // check
+    tb_flat_hash_map_t const* hash_map = (tb_flat_hash_map_t const*)self;
+    tb_assert_and_check_return_val(hash_map, 0);
+
+    // the size
+    return hash_map->item_size;
+}
+tb_size_t tb_flat_hash_map_maxn(tb_flat_hash_map_ref_t self)
+{
+    // check
+    tb_flat_hash_map_t const* hash_map = (tb_flat_hash_map_t const*)self;
+    tb_assert_and_check_return_val(hash_map, 0);
+
+    // the maxn
+    return hash_map->slot_maxn;
+}
+#ifdef __tb_debug__
+tb_void_t tb_flat_hash_map_dump(tb_flat_hash_map_ref_t self)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)self;
+    tb_assert_and_check_return(hash_map);
+
+    // trace
+    tb_trace_i("");
+    tb_trace_i("self: size: %lu, maxn: %lu, growth_left: %lu", hash_map->item_size, hash_map->slot_maxn, hash_map->growth_left);
+
+    // done
+    tb_char_t name[4096];
+    tb_char_t data[4096];
+    tb_for_all_if (tb_flat_hash_map_item_ref_t, item, self, item)
+    {
+        if (hash_map->element_name.cstr && hash_map->element_data.cstr)
+        {
+            tb_trace_i("    %s => %s", hash_map->element_name.cstr(&hash_map->element_name, item->name, name, sizeof(name)), hash_map->element_data.cstr(&hash_map->element_data, item->data, data, sizeof(data)));
+        }
+        else if (hash_map->element_name.cstr) 
+        {
+            tb_trace_i("    %s => %p", hash_map->element_name.cstr(&hash_map->element_name, item->name, name, sizeof(name)), item->data);
+        }
+        else if (hash_map->element_data.cstr) 
+        {
+            tb_trace_i("    %p => %s", item->name, hash_map->element_data.cstr(&hash_map->element_data, item->data, data, sizeof(data)));
+        }
+        else 
+        {
+            tb_trace_i("    %p => %p", item->name, item->data);
+        }
+    }
+}
+#endif
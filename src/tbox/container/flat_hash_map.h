@@ -0,0 +1,193 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        flat_hash_map.h
+ * @ingroup     container
+ *
+ */
+#ifndef TB_CONTAINER_FLAT_HASH_MAP_H
+#define TB_CONTAINER_FLAT_HASH_MAP_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "element.h"
+#include "iterator.h"
+#include "hash_map.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// the group width of the control bytes
+#define TB_FLAT_HASH_MAP_GROUP_WIDTH                  (16)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the flat hash map ref type (open addressing, swiss table)
+ *
+ * <pre>
+ *
+ *          | group 0                     | group 1                     | ...            | cloned group 0 |
+ * ctrls:   | h2 | empty | h2 | deleted | ... | h2 | h2 | empty | ...    | ...            | ...            |
+ *             |           |                     |
+ * slots:   | name data | ........  | name data | ...... | name data | ...
+ *
+ * hash: | h1 (probe position) ............................... | h2 (7 bits) |
+ *
+ * </pre>
+ *
+ * the control byte of each slot caches the low 7 bits of the hash (h2), or marks the slot as empty or deleted.
+ *
+ * we probe the control bytes group by group from the position of h1, 
+ * and match all h2 of one group at once (sse2 if be supported),
+ * so only the slots with the same h2 need be compared by element_name.comp.
+ *
+ * the names and data are stored in the flat slots without the item lists,
+ * so we need only one or two cache misses for finding one item in the most cases.
+ *
+ * the table will be grown if the load factor is larger than 7/8.
+ *
+ * @note the itor of the same item is mutable after inserting the new items
+ */
+typedef tb_iterator_ref_t tb_flat_hash_map_ref_t;
+
+/// the flat hash map item type
+typedef tb_hash_map_item_t tb_flat_hash_map_item_t, *tb_flat_hash_map_item_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init flat hash map
+ *
+ * @param item_size     the initial items count, it will be grown automatically, using the default size if be zero
+ * @param element_name  the item for name
+ * @param element_data  the item for data
+ *
+ * @return              the flat hash map
+ */
+tb_flat_hash_map_ref_t  tb_flat_hash_map_init(tb_size_t item_size, tb_element_t element_name, tb_element_t element_data);
+
+/*! init flat hash map with the given allocator
+ *
+ * the flat hash map, slots and the duplicated element data (e.g. string) will be allocated from this allocator
+ *
+ * @param allocator     the allocator, uses the global allocator if be null
+ * @param item_size     the initial items count, it will be grown automatically, using the default size if be zero
+ * @param element_name  the item for name
+ * @param element_data  the item for data
+ *
+ * @return              the flat hash map
+ */
+tb_flat_hash_map_ref_t  tb_flat_hash_map_init_with_allocator(tb_allocator_ref_t allocator, tb_size_t item_size, tb_element_t element_name, tb_element_t element_data);
+
+/*! exit flat hash map
+ *
+ * @param hash_map      the flat hash map
+ */
+tb_void_t               tb_flat_hash_map_exit(tb_flat_hash_map_ref_t hash_map);
+
+/*! clear flat hash map
+ *
+ * @param hash_map      the flat hash map
+ */
+tb_void_t               tb_flat_hash_map_clear(tb_flat_hash_map_ref_t hash_map);
+
+/*! get item data from name
+ *
+ * @note 
+ * the return value may be zero if the item type is integer
+ * so we need call tb_flat_hash_map_find for judging whether to get value successfully
+ *
+ * @param hash_map      the flat hash map
+ * @param name          the item name
+ *
+ * @return              the item data
+ */
+tb_pointer_t            tb_flat_hash_map_get(tb_flat_hash_map_ref_t hash_map, tb_cpointer_t name);
+
+/*! find item from name
+ *
+ * @param hash_map      the flat hash map
+ * @param name          the item name
+ *
+ * @return              the item itor, @note: the itor of the same item is mutable
+ */
+tb_size_t               tb_flat_hash_map_find(tb_flat_hash_map_ref_t hash_map, tb_cpointer_t name);
+
+/*! insert item data from name
+ *
+ * @note the pair (name => data) is unique
+ *
+ * @param hash_map      the flat hash map
+ * @param name          the item name
+ * @param data          the item data
+ *
+ * @return              the item itor, @note: the itor of the same item is mutable
+ */
+tb_size_t               tb_flat_hash_map_insert(tb_flat_hash_map_ref_t hash_map, tb_cpointer_t name, tb_cpointer_t data);
+
+/*! remove item from name
+ *
+ * @param hash_map      the flat hash map
+ * @param name          the item name
+ */
+tb_void_t               tb_flat_hash_map_remove(tb_flat_hash_map_ref_t hash_map, tb_cpointer_t name);
+
+/*! the flat hash map size
+ *
+ * @param hash_map      the flat hash map
+ *
+ * @return              the flat hash map size
+ */
+tb_size_t               tb_flat_hash_map_size(tb_flat_hash_map_ref_t hash_map);
+
+/*! the flat hash map maxn (the slots count)
+ *
+ * @param hash_map      the flat hash map
+ *
+ * @return              the flat hash map maxn
+ */
+tb_size_t               tb_flat_hash_map_maxn(tb_flat_hash_map_ref_t hash_map);
+
+#ifdef __tb_debug__
+/*! dump flat hash map
+ *
+ * @param hash_map      the flat hash map
+ */
+tb_void_t               tb_flat_hash_map_dump(tb_flat_hash_map_ref_t hash_map);
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -70,6 +70,23 @@
 // the self bucket item maximum size
 #define TB_HASH_MAP_BUCKET_ITEM_MAXN                    (1 << 16)
 
+/* the self bucket maximum size for growing
+ *
+ * the old buckets are placed after the new buckets in the itor index when they are being migrated,
+ * so the new and old buckets count need be less than the bucket maximum index
+ */
+#if TB_CPU_BIT64
+#   define TB_HASH_MAP_BUCKET_GROW_MAXN                 (1 << 24)
+#else
+#   define TB_HASH_MAP_BUCKET_GROW_MAXN                 (1 << 15)
+#endif
+
+// the average items count of one bucket for growing buckets
+#define TB_HASH_MAP_BUCKET_LOAD                         (4)
+
+// the migrated old buckets count for each insertion and removal
+#define TB_HASH_MAP_REHASH_STEP                         (4)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -97,6 +114,18 @@ typedef struct __tb_hash_map_t
     // the hash list size
     tb_size_t                       hash_size;
 
+    // the old hash list which is being migrated to the hash list
+    tb_hash_map_item_list_t**       rehash_list;
+
+    // the old hash list size
+    tb_size_t                       rehash_size;
+
+    // the next bucket index of the old hash list for migrating
+    tb_size_t                       rehash_index;
+
+    // grow the hash list and migrate items incrementally?
+    tb_bool_t                       grow;
+
     // the current item for iterator
     tb_hash_map_item_t              item;
 
@@ -115,72 +144,41 @@ typedef struct __tb_hash_map_t
     // the element for data
     tb_element_t                    element_data;
 
+    // the allocator
+    tb_allocator_ref_t              allocator;
+
 }tb_hash_map_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
-#if 0
-// linear finder
-static tb_bool_t tb_hash_map_item_find(tb_hash_map_t* hash_map, tb_cpointer_t name, tb_size_t* pbuck, tb_size_t* pitem)
+static __tb_inline__ tb_hash_map_item_list_t** tb_hash_map_list_at(tb_hash_map_t* hash_map, tb_size_t buck)
 {
-    tb_assert_and_check_return_val(hash_map && hash_map->hash_list && hash_map->hash_size, tb_false);
-    
-    // get step
-    tb_size_t step = hash_map->element_name.size + hash_map->element_data.size;
-    tb_assert_and_check_return_val(step, tb_false);
-
-    // comupte hash_map from name
-    tb_size_t buck = hash_map->element_name.hash(&hash_map->element_name, name, hash_map->hash_size - 1, 0);
-    tb_assert_and_check_return_val(buck < hash_map->hash_size, tb_false);
-
-    // update buck
-    if (pbuck) *pbuck = buck;
-
-    // get list
-    tb_hash_map_item_list_t* list = hash_map->hash_list[buck];
-    tb_check_return_val(list && list->size, tb_false);
-
-    // find item
-    tb_long_t   r = 1;
-    tb_size_t   i = 0;
-    tb_size_t   n = list->size;
-    for (i = 0; i < n; i++)
-    {
-        // get item
-        tb_byte_t const* item = ((tb_byte_t*)&list[1]) + i * step;
-
-        // compare it
-        r = hash_map->element_name.comp(&hash_map->element_name, name, hash_map->element_name.data(&hash_map->element_name, item));
-        if (r <= 0) break;
-    }
-
-    // update item
-    if (pitem) *pitem = i;
+    // check
+    tb_assert(buck < hash_map->hash_size + hash_map->rehash_size);
 
-    // ok?
-    return !r? tb_true : tb_false;
+    // the old buckets are placed after the new buckets
+    return buck < hash_map->hash_size? &hash_map->hash_list[buck] : &hash_map->rehash_list[buck - hash_map->hash_size];
 }
-#else
 // binary finder
-static tb_bool_t tb_hash_map_item_find(tb_hash_map_t* hash_map, tb_cpointer_t name, tb_size_t* pbuck, tb_size_t* pitem)
+static tb_bool_t tb_hash_map_item_find_from(tb_hash_map_t* hash_map, tb_hash_map_item_list_t** hash_list, tb_size_t hash_size, tb_cpointer_t name, tb_size_t* pbuck, tb_size_t* pitem)
 {
     // check
-    tb_assert_and_check_return_val(hash_map && hash_map->hash_list && hash_map->hash_size, tb_false);
+    tb_assert_and_check_return_val(hash_map && hash_list && hash_size, tb_false);
     
     // get step
     tb_size_t step = hash_map->element_name.size + hash_map->element_data.size;
     tb_assert_and_check_return_val(step, tb_false);
 
     // comupte hash_map from name
-    tb_size_t buck = hash_map->element_name.hash(&hash_map->element_name, name, hash_map->hash_size - 1, 0);
-    tb_assert_and_check_return_val(buck < hash_map->hash_size, tb_false);
+    tb_size_t buck = hash_map->element_name.hash(&hash_map->element_name, name, hash_size - 1, 0);
+    tb_assert_and_check_return_val(buck < hash_size, tb_false);
 
     // update buck
     if (pbuck) *pbuck = buck;
 
     // get list
-    tb_hash_map_item_list_t* list = hash_map->hash_list[buck];
+    tb_hash_map_item_list_t* list = hash_list[buck];
     tb_check_return_val(list && list->size, tb_false);
 
     // find item
@@ -215,18 +213,42 @@ static tb_bool_t tb_hash_map_item_find(tb_hash_map_t* hash_map, tb_cpointer_t na
     // ok?
     return !t? tb_true : tb_false;
 }
-#endif
+static tb_bool_t tb_hash_map_item_find(tb_hash_map_t* hash_map, tb_cpointer_t name, tb_size_t* pbuck, tb_size_t* pitem)
+{
+    // check
+    tb_assert_and_check_return_val(hash_map && hash_map->hash_list && hash_map->hash_size, tb_false);
+
+    // find it from the new buckets first, the buck and item will be the insert position if not found
+    if (tb_hash_map_item_find_from(hash_map, hash_map->hash_list, hash_map->hash_size, name, pbuck, pitem)) return tb_true;
+
+    // find it from the old buckets which are being migrated
+    if (hash_map->rehash_list)
+    {
+        tb_size_t buck = 0;
+        tb_size_t item = 0;
+        if (tb_hash_map_item_find_from(hash_map, hash_map->rehash_list, hash_map->rehash_size, name, &buck, &item))
+        {
+            // the old buckets are placed after the new buckets
+            if (pbuck) *pbuck = hash_map->hash_size + buck;
+            if (pitem) *pitem = item;
+            return tb_true;
+        }
+    }
+
+    // not found
+    return tb_false;
+}
 static tb_bool_t tb_hash_map_item_at(tb_hash_map_t* hash_map, tb_size_t buck, tb_size_t item, tb_pointer_t* pname, tb_pointer_t* pdata)
 {
     // check
-    tb_assert_and_check_return_val(hash_map && hash_map->hash_list && hash_map->hash_size && buck < hash_map->hash_size, tb_false);
+    tb_assert_and_check_return_val(hash_map && hash_map->hash_list && hash_map->hash_size && buck < hash_map->hash_size + hash_map->rehash_size, tb_false);
     
     // get step
     tb_size_t step = hash_map->element_name.size + hash_map->element_data.size;
     tb_assert_and_check_return_val(step, tb_false);
 
     // get list
-    tb_hash_map_item_list_t* list = hash_map->hash_list[buck];
+    tb_hash_map_item_list_t* list = *tb_hash_map_list_at(hash_map, buck);
     tb_check_return_val(list && list->size && item < list->size, tb_false);
 
     // get name
@@ -238,6 +260,168 @@ static tb_bool_t tb_hash_map_item_at(tb_hash_map_t* hash_map, tb_size_t buck, tb
     // ok
     return tb_true;
 }
+static tb_byte_t* tb_hash_map_item_make(tb_hash_map_t* hash_map, tb_size_t buck, tb_size_t item)
+{
+    // check
+    tb_assert_and_check_return_val(hash_map && hash_map->item_grow && buck < hash_map->hash_size, tb_null);
+
+    // the step
+    tb_size_t step = hash_map->element_name.size + hash_map->element_data.size;
+    tb_assert_and_check_return_val(step, tb_null);
+
+    // get list
+    tb_hash_map_item_list_t* list = hash_map->hash_list[buck];
+    
+    // insert item
+    if (list)
+    {
+        // grow?
+        if (list->size >= list->maxn)
+        {
+            // resize maxn
+            tb_size_t maxn = tb_align_pow2(list->maxn + hash_map->item_grow);
+            tb_assert_and_check_return_val(maxn > list->maxn, tb_null);
+
+            // realloc it
+            list = (tb_hash_map_item_list_t*)tb_allocator_ralloc(hash_map->allocator, list, sizeof(tb_hash_map_item_list_t) + maxn * step);  
+            tb_assert_and_check_return_val(list, tb_null);
+
+            // update the hash_map item maxn
+            hash_map->item_maxn += maxn - list->maxn;
+
+            // update maxn
+            list->maxn = maxn;
+
+            // reattach list
+            hash_map->hash_list[buck] = list;
+        }
+        tb_assert_and_check_return_val(item <= list->size && list->size < list->maxn, tb_null);
+
+        // move items
+        if (item != list->size) tb_memmov(((tb_byte_t*)&list[1]) + (item + 1) * step, ((tb_byte_t*)&list[1]) + item * step, (list->size - item) * step);
+
+        // update size
+        list->size++;
+    }
+    // create list for adding item
+    else
+    {
+        // check
+        tb_assert_and_check_return_val(!item, tb_null);
+
+        // make list
+        list = (tb_hash_map_item_list_t*)tb_allocator_malloc0(hash_map->allocator, sizeof(tb_hash_map_item_list_t) + hash_map->item_grow * step);
+        tb_assert_and_check_return_val(list, tb_null);
+
+        // init list
+        list->size = 1;
+        list->maxn = hash_map->item_grow;
+
+        // attach list
+        hash_map->hash_list[buck] = list;
+
+        // update the hash_map item maxn
+        hash_map->item_maxn += list->maxn;
+    }
+
+    // the item data
+    return ((tb_byte_t*)&list[1]) + item * step;
+}
+static tb_void_t tb_hash_map_rehash(tb_hash_map_t* hash_map)
+{
+    // check
+    tb_assert_and_check_return(hash_map && hash_map->hash_list);
+
+    // the step
+    tb_size_t step = hash_map->element_name.size + hash_map->element_data.size;
+    tb_assert_and_check_return(step);
+
+    // no old buckets? 
+    if (!hash_map->rehash_list)
+    {
+        // too many items for each bucket?
+        tb_check_return(hash_map->item_size >= hash_map->hash_size * TB_HASH_MAP_BUCKET_LOAD && hash_map->hash_size < TB_HASH_MAP_BUCKET_GROW_MAXN);
+
+        // make the new buckets, keep the current buckets if no memory
+        tb_hash_map_item_list_t** hash_list = (tb_hash_map_item_list_t**)tb_allocator_nalloc0(hash_map->allocator, hash_map->hash_size << 1, sizeof(tb_size_t));
+        tb_check_return(hash_list);
+
+        /* the current buckets will be migrated to the new buckets incrementally
+         *
+         * each insertion and removal only migrates a few old buckets, 
+         * so we need not rehash all items at once and it will not block the caller for a long time
+         */
+        hash_map->rehash_list   = hash_map->hash_list;
+        hash_map->rehash_size   = hash_map->hash_size;
+        hash_map->rehash_index  = 0;
+        hash_map->hash_list     = hash_list;
+        hash_map->hash_size     <<= 1;
+        return ;
+    }
+
+    // migrate some old buckets
+    tb_size_t count = TB_HASH_MAP_REHASH_STEP;
+    while (count-- && hash_map->rehash_index < hash_map->rehash_size)
+    {
+        // the old list
+        tb_hash_map_item_list_t* list = hash_map->rehash_list[hash_map->rehash_index];
+        if (list)
+        {
+            // move items to the new buckets
+            tb_size_t   i = 0;
+            tb_byte_t*  data = (tb_byte_t*)&list[1];
+            for (i = 0; i < list->size; i++)
+            {
+                // find the insert position from the new buckets
+                tb_size_t buck = 0;
+                tb_size_t item = 0;
+                tb_cpointer_t name = hash_map->element_name.data(&hash_map->element_name, data + i * step);
+                if (tb_hash_map_item_find_from(hash_map, hash_map->hash_list, hash_map->hash_size, name, &buck, &item)) 
+                {
+                    // the same item cannot be in both of the new and old buckets
+                    tb_assert(0);
+                    break;
+                }
+
+                // move item
+                tb_byte_t* pitem = tb_hash_map_item_make(hash_map, buck, item);
+                tb_check_break(pitem);
+                tb_memcpy(pitem, data + i * step, step);
+            }
+
+            // no memory? keep the rest items in the old list and try it again next time
+            if (i < list->size)
+            {
+                if (i) tb_memmov(data, data + i * step, (list->size - i) * step);
+                list->size -= i;
+                break;
+            }
+
+            /* update the hash_map item maxn
+             *
+             * the migrated items have been counted again by the new lists, 
+             * so we need remove the old list from it, otherwise the item maxn will be doubled after each growing
+             */
+            hash_map->item_maxn -= list->maxn;
+
+            // free the old list
+            tb_allocator_free(hash_map->allocator, list);
+            hash_map->rehash_list[hash_map->rehash_index] = tb_null;
+        }
+
+        // next bucket
+        hash_map->rehash_index++;
+    }
+
+    // all old buckets have been migrated? free them
+    if (hash_map->rehash_index >= hash_map->rehash_size)
+    {
+        tb_allocator_free(hash_map->allocator, hash_map->rehash_list);
+        hash_map->rehash_list   = tb_null;
+        hash_map->rehash_size   = 0;
+        hash_map->rehash_index  = 0;
+    }
+}
 static tb_size_t tb_hash_map_itor_size(tb_iterator_ref_t iterator)
 {
     // check
@@ -255,10 +439,10 @@ static tb_size_t tb_hash_map_itor_head(tb_iterator_ref_t iterator)
 
     // find the head
     tb_size_t i = 0;
-    tb_size_t n = hash_map->hash_size;
+    tb_size_t n = hash_map->hash_size + hash_map->rehash_size;
     for (i = 0; i < n; i++)
     {
-        tb_hash_map_item_list_t* list = hash_map->hash_list[i];
+        tb_hash_map_item_list_t* list = *tb_hash_map_list_at(hash_map, i);
         if (list && list->size) return tb_hash_map_index_make(i + 1, 1);
     }
     return 0;
@@ -281,17 +465,18 @@ static tb_size_t tb_hash_map_itor_next(tb_iterator_ref_t iterator, tb_size_t ito
     // compute index
     buck--;
     item--;
-    tb_assert(buck < hash_map->hash_size && (item + 1) < TB_HASH_MAP_BUCKET_ITEM_MAXN);
+    tb_assert(buck < hash_map->hash_size + hash_map->rehash_size && (item + 1) < TB_HASH_MAP_BUCKET_ITEM_MAXN);
 
     // find the next from the current buck first
-    if (hash_map->hash_list[buck] && item + 1 < hash_map->hash_list[buck]->size) return tb_hash_map_index_make(buck + 1, item + 2);
+    tb_hash_map_item_list_t* list = *tb_hash_map_list_at(hash_map, buck);
+    if (list && item + 1 < list->size) return tb_hash_map_index_make(buck + 1, item + 2);
 
     // find the next from the next buckets
     tb_size_t i;
-    tb_size_t n = hash_map->hash_size;
+    tb_size_t n = hash_map->hash_size + hash_map->rehash_size;
     for (i = buck + 1; i < n; i++)
     {
-        tb_hash_map_item_list_t* list = hash_map->hash_list[i];
+        list = *tb_hash_map_list_at(hash_map, i);
         if (list && list->size) return tb_hash_map_index_make(i + 1, 1);
     }
 
@@ -324,14 +509,14 @@ static tb_void_t tb_hash_map_itor_copy(tb_iterator_ref_t iterator, tb_size_t ito
     tb_size_t b = tb_hash_map_index_buck(itor);
     tb_size_t i = tb_hash_map_index_item(itor);
     tb_assert(b && i); b--; i--;
-    tb_assert(b < hash_map->hash_size);
+    tb_assert(b < hash_map->hash_size + hash_map->rehash_size);
 
     // step
     tb_size_t step = hash_map->element_name.size + hash_map->element_data.size;
     tb_assert(step);
 
     // list
-    tb_hash_map_item_list_t* list = hash_map->hash_list[b];
+    tb_hash_map_item_list_t* list = *tb_hash_map_list_at(hash_map, b);
     tb_check_return(list && list->size && i < list->size);
 
     // note: copy data only, will destroy hash_map index if copy name
@@ -356,14 +541,15 @@ static tb_void_t tb_hash_map_itor_remove(tb_iterator_ref_t iterator, tb_size_t i
     tb_size_t buck = tb_hash_map_index_buck(itor);
     tb_size_t item = tb_hash_map_index_item(itor);
     tb_assert(buck && item); buck--; item--;
-    tb_assert(buck < hash_map->hash_size);
+    tb_assert(buck < hash_map->hash_size + hash_map->rehash_size);
 
     // the step
     tb_size_t step = hash_map->element_name.size + hash_map->element_data.size;
     tb_assert(step);
 
     // get list
-    tb_hash_map_item_list_t* list = hash_map->hash_list[buck];
+    tb_hash_map_item_list_t** plist = tb_hash_map_list_at(hash_map, buck);
+    tb_hash_map_item_list_t* list = *plist;
     tb_assert(list && list->size && item < list->size);
 
     // free item
@@ -383,10 +569,10 @@ static tb_void_t tb_hash_map_itor_remove(tb_iterator_ref_t iterator, tb_size_t i
     else 
     {
         // free it
-        tb_free(list);
+        tb_allocator_free(hash_map->allocator, list);
 
         // reset
-        hash_map->hash_list[buck] = tb_null;
+        *plist = tb_null;
     }
 
     // update the hash_map item size
@@ -416,7 +602,7 @@ static tb_void_t tb_hash_map_itor_remove_range(tb_iterator_ref_t iterator, tb_si
     // compute index
     buck_head--;
     item_head--;
-    tb_assert(buck_head < hash_map->hash_size && item_head < TB_HASH_MAP_BUCKET_ITEM_MAXN);
+    tb_assert(buck_head < hash_map->hash_size + hash_map->rehash_size && item_head < TB_HASH_MAP_BUCKET_ITEM_MAXN);
 
     // the last buck and the tail item
     tb_size_t buck_last;
@@ -431,11 +617,11 @@ static tb_void_t tb_hash_map_itor_remove_range(tb_iterator_ref_t iterator, tb_si
         // compute index
         buck_last--;
         item_tail--;
-        tb_assert(buck_last < hash_map->hash_size && item_tail < TB_HASH_MAP_BUCKET_ITEM_MAXN);
+        tb_assert(buck_last < hash_map->hash_size + hash_map->rehash_size && item_tail < TB_HASH_MAP_BUCKET_ITEM_MAXN);
     }
     else 
     {
-        buck_last = hash_map->hash_size - 1;
+        buck_last = hash_map->hash_size + hash_map->rehash_size - 1;
         item_tail = -1;
     }
 
@@ -447,7 +633,7 @@ static tb_void_t tb_hash_map_itor_remove_range(tb_iterator_ref_t iterator, tb_si
     for (buck = buck_head, item = item_head; buck <= buck_last; buck++, item = 0)
     {
         // the list
-        tb_hash_map_item_list_t* list = hash_map->hash_list[buck];
+        tb_hash_map_item_list_t* list = *tb_hash_map_list_at(hash_map, buck);
         tb_check_continue(list && list->size);
 
         // the tail
@@ -481,11 +667,19 @@ static tb_void_t tb_hash_map_itor_remove_range(tb_iterator_ref_t iterator, tb_si
  * implementation
  */
 tb_hash_map_ref_t tb_hash_map_init(tb_size_t bucket_size, tb_element_t element_name, tb_element_t element_data)
+{
+    return tb_hash_map_init_with_allocator(tb_null, bucket_size, element_name, element_data);
+}
+tb_hash_map_ref_t tb_hash_map_init_with_allocator(tb_allocator_ref_t allocator, tb_size_t bucket_size, tb_element_t element_name, tb_element_t element_data)
 {
     // check
     tb_assert_and_check_return_val(element_name.size && element_name.hash && element_name.comp && element_name.data && element_name.dupl, tb_null);
     tb_assert_and_check_return_val(element_data.data && element_data.dupl && element_data.repl, tb_null);
 
+    // grow buckets?
+    tb_bool_t grow = (bucket_size & TB_HASH_MAP_BUCKET_GROW)? tb_true : tb_false;
+    bucket_size &= ~TB_HASH_MAP_BUCKET_GROW;
+
     // check bucket size
     if (!bucket_size) bucket_size = TB_HASH_MAP_BUCKET_SIZE_DEFAULT;
     tb_assert_and_check_return_val(bucket_size <= TB_HASH_MAP_BUCKET_SIZE_LARGE, tb_null);
@@ -495,10 +689,24 @@ tb_hash_map_ref_t tb_hash_map_init(tb_size_t bucket_size, tb_element_t element_n
     tb_hash_map_t*  hash_map = tb_null;
     do
     {
+        // duplicate the element data (e.g. string) to the given allocator
+        if (allocator && !element_name.allocator) element_name.allocator = allocator;
+        if (allocator && !element_data.allocator) element_data.allocator = allocator;
+
+        // no allocator? uses the global allocator
+        if (!allocator) allocator = tb_allocator();
+        tb_assert_and_check_break(allocator);
+
         // make self
-        hash_map = tb_malloc0_type(tb_hash_map_t);
+        hash_map = (tb_hash_map_t*)tb_allocator_malloc0(allocator, sizeof(tb_hash_map_t));
         tb_assert_and_check_break(hash_map);
 
+        // init allocator
+        hash_map->allocator = allocator;
+
+        // grow buckets and migrate items incrementally?
+        hash_map->grow = grow;
+
         // init self func
         hash_map->element_name = element_name;
         hash_map->element_data = element_data;
@@ -523,7 +731,7 @@ tb_hash_map_ref_t tb_hash_map_init(tb_size_t bucket_size, tb_element_t element_n
         tb_assert_and_check_break(hash_map->hash_size <= TB_HASH_MAP_BUCKET_MAXN);
 
         // init self list
-        hash_map->hash_list = (tb_hash_map_item_list_t**)tb_nalloc0(hash_map->hash_size, sizeof(tb_size_t));
+        hash_map->hash_list = (tb_hash_map_item_list_t**)tb_allocator_nalloc0(hash_map->allocator, hash_map->hash_size, sizeof(tb_size_t));
         tb_assert_and_check_break(hash_map->hash_list);
 
         // init item grow
@@ -557,10 +765,10 @@ tb_void_t tb_hash_map_exit(tb_hash_map_ref_t self)
     tb_hash_map_clear(self);
 
     // free hash_map list
-    if (hash_map->hash_list) tb_free(hash_map->hash_list);
+    if (hash_map->hash_list) tb_allocator_free(hash_map->allocator, hash_map->hash_list);
 
     // free it
-    tb_free(hash_map);
+    tb_allocator_free(hash_map->allocator, hash_map);
 }
 tb_void_t tb_hash_map_clear(tb_hash_map_ref_t self)
 {
@@ -572,12 +780,13 @@ tb_void_t tb_hash_map_clear(tb_hash_map_ref_t self)
     tb_size_t step = hash_map->element_name.size + hash_map->element_data.size;
     tb_assert_and_check_return(step);
 
-    // clear hash_map
+    // clear hash_map, the old buckets are cleared too if they are being migrated
     tb_size_t i = 0;
-    tb_size_t n = hash_map->hash_size;
+    tb_size_t n = hash_map->hash_size + hash_map->rehash_size;
     for (i = 0; i < n; i++)
     {
-        tb_hash_map_item_list_t* list = hash_map->hash_list[i];
+        tb_hash_map_item_list_t** plist = tb_hash_map_list_at(hash_map, i);
+        tb_hash_map_item_list_t* list = *plist;
         if (list)
         {
             // free items
@@ -594,11 +803,17 @@ tb_void_t tb_hash_map_clear(tb_hash_map_ref_t self)
             }
 
             // free list
-            tb_free(list);
+            tb_allocator_free(hash_map->allocator, list);
         }
-        hash_map->hash_list[i] = tb_null;
+        *plist = tb_null;
     }
 
+    // free the old buckets
+    if (hash_map->rehash_list) tb_allocator_free(hash_map->allocator, hash_map->rehash_list);
+    hash_map->rehash_list   = tb_null;
+    hash_map->rehash_size   = 0;
+    hash_map->rehash_index  = 0;
+
     // reset info
     hash_map->item_size = 0;
     hash_map->item_maxn = 0;
@@ -610,6 +825,9 @@ tb_pointer_t tb_hash_map_get(tb_hash_map_ref_t self, tb_cpointer_t name)
     tb_hash_map_t* hash_map = (tb_hash_map_t*)self;
     tb_assert_and_check_return_val(hash_map, tb_null);
 
+    // migrate some old buckets first, the migration will not be stalled if there are only lookups
+    if (hash_map->rehash_list) tb_hash_map_rehash(hash_map);
+
     // find it
     tb_size_t buck = 0;
     tb_size_t item = 0;
@@ -625,6 +843,9 @@ tb_size_t tb_hash_map_find(tb_hash_map_ref_t self, tb_cpointer_t name)
     tb_hash_map_t* hash_map = (tb_hash_map_t*)self;
     tb_assert_and_check_return_val(hash_map, 0);
 
+    // migrate some old buckets first, the returned itor is still valid until the next lookup, insertion or removal
+    if (hash_map->rehash_list) tb_hash_map_rehash(hash_map);
+
     // find
     tb_size_t buck = 0;
     tb_size_t item = 0;
@@ -640,16 +861,16 @@ tb_size_t tb_hash_map_insert(tb_hash_map_ref_t self, tb_cpointer_t name, tb_cpoi
     tb_size_t step = hash_map->element_name.size + hash_map->element_data.size;
     tb_assert_and_check_return_val(step, 0);
 
+    // grow buckets or migrate some old buckets first
+    if (hash_map->grow) tb_hash_map_rehash(hash_map);
+
     // find it
     tb_size_t buck = 0;
     tb_size_t item = 0;
     if (tb_hash_map_item_find(hash_map, name, &buck, &item))
     {
-        // check
-        tb_assert_and_check_return_val(buck < hash_map->hash_size, 0);
-
         // get list
-        tb_hash_map_item_list_t* list = hash_map->hash_list[buck];
+        tb_hash_map_item_list_t* list = *tb_hash_map_list_at(hash_map, buck);
         tb_assert_and_check_return_val(list && list->size && item < list->size, 0);
 
         // replace data
@@ -660,68 +881,13 @@ tb_size_t tb_hash_map_insert(tb_hash_map_ref_t self, tb_cpointer_t name, tb_cpoi
         // check
         tb_assert_and_check_return_val(buck < hash_map->hash_size, 0);
 
-        // get list
-        tb_hash_map_item_list_t* list = hash_map->hash_list[buck];
-        
-        // insert item
-        if (list)
-        {
-            // grow?
-            if (list->size >= list->maxn)
-            {
-                // check
-                tb_assert_and_check_return_val(hash_map->item_grow, 0);
-
-                // resize maxn
-                tb_size_t maxn = tb_align_pow2(list->maxn + hash_map->item_grow);
-                tb_assert_and_check_return_val(maxn > list->maxn, 0);
-
-                // realloc it
-                list = (tb_hash_map_item_list_t*)tb_ralloc(list, sizeof(tb_hash_map_item_list_t) + maxn * step);  
-                tb_assert_and_check_return_val(list, 0);
-
-                // update the hash_map item maxn
-                hash_map->item_maxn += maxn - list->maxn;
-
-                // update maxn
-                list->maxn = maxn;
+        // make item
+        tb_byte_t* pitem = tb_hash_map_item_make(hash_map, buck, item);
+        tb_assert_and_check_return_val(pitem, 0);
 
-                // reattach list
-                hash_map->hash_list[buck] = list;
-            }
-            tb_assert_and_check_return_val(item <= list->size && list->size < list->maxn, 0);
-
-            // move items
-            if (item != list->size) tb_memmov(((tb_byte_t*)&list[1]) + (item + 1) * step, ((tb_byte_t*)&list[1]) + item * step, (list->size - item) * step);
-
-            // dupl item
-            list->size++;
-            hash_map->element_name.dupl(&hash_map->element_name, ((tb_byte_t*)&list[1]) + item * step, name);
-            hash_map->element_data.dupl(&hash_map->element_data, ((tb_byte_t*)&list[1]) + item * step + hash_map->element_name.size, data);
-
-        }
-        // create list for adding item
-        else
-        {
-            // check
-            tb_assert_and_check_return_val(hash_map->item_grow, 0);
-
-            // make list
-            list = (tb_hash_map_item_list_t*)tb_malloc0(sizeof(tb_hash_map_item_list_t) + hash_map->item_grow * step);
-            tb_assert_and_check_return_val(list, 0);
-
-            // init list
-            list->size = 1;
-            list->maxn = hash_map->item_grow;
-            hash_map->element_name.dupl(&hash_map->element_name, ((tb_byte_t*)&list[1]), name);
-            hash_map->element_data.dupl(&hash_map->element_data, ((tb_byte_t*)&list[1]) + hash_map->element_name.size, data);
-
-            // attach list
-            hash_map->hash_list[buck] = list;
-
-            // update the hash_map item maxn
-            hash_map->item_maxn += list->maxn;
-        }
+        // dupl item
+        hash_map->element_name.dupl(&hash_map->element_name, pitem, name);
+        hash_map->element_data.dupl(&hash_map->element_data, pitem + hash_map->element_name.size, data);
 
         // update the hash_map item size
         hash_map->item_size++;
@@ -736,6 +902,9 @@ tb_void_t tb_hash_map_remove(tb_hash_map_ref_t self, tb_cpointer_t name)
     tb_hash_map_t* hash_map = (tb_hash_map_t*)self;
     tb_assert_and_check_return(hash_map);
 
+    // migrate some old buckets first
+    if (hash_map->rehash_list) tb_hash_map_rehash(hash_map);
+
     // find it
     tb_size_t buck = 0;
     tb_size_t item = 0;
@@ -773,16 +942,16 @@ tb_void_t tb_hash_map_dump(tb_hash_map_ref_t self)
 
     // trace
     tb_trace_i("");
-    tb_trace_i("self: size: %lu", tb_hash_map_size(self));
+    tb_trace_i("self: size: %lu, buckets: %lu, rehash: %lu/%lu", tb_hash_map_size(self), hash_map->hash_size, hash_map->rehash_index, hash_map->rehash_size);
 
     // done
     tb_size_t i = 0;
     tb_char_t name[4096];
     tb_char_t data[4096];
-    for (i = 0; i < hash_map->hash_size; i++)
+    for (i = 0; i < hash_map->hash_size + hash_map->rehash_size; i++)
     {
         // the list
-        tb_hash_map_item_list_t* list = hash_map->hash_list[i];
+        tb_hash_map_item_list_t* list = *tb_hash_map_list_at(hash_map, i);
         if (list)
         {
             // trace
@@ -51,6 +51,15 @@ __tb_extern_c_enter__
 /// the large hash bucket size
 #define TB_HASH_MAP_BUCKET_SIZE_LARGE                 (65536)
 
+/*! the growing flag of the hash bucket size
+ *
+ * the buckets will be doubled if the average items count of one bucket is too large,
+ * and the old buckets will be migrated to the new buckets incrementally on each insertion, removal and lookup.
+ *
+ * e.g. tb_hash_map_init(TB_HASH_MAP_BUCKET_SIZE_MICRO | TB_HASH_MAP_BUCKET_GROW, ...)
+ */
+#define TB_HASH_MAP_BUCKET_GROW                       (0x40000000)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -93,6 +102,12 @@ typedef struct __tb_hash_map_item_t
  * </pre>
  *
  * @note the itor of the same item is mutable
+ *
+ * if the buckets are growing (TB_HASH_MAP_BUCKET_GROW), the new and old buckets will be kept side by side,
+ * the lookup will find items from both of them and the old buckets will be placed after the new buckets for iterating.
+ *
+ * @note the lookup (tb_hash_map_get and tb_hash_map_find) will also migrate some old buckets while they are growing,
+ * so it will invalidate the itors like the insertion and removal, please do not look up the same hash map when iterating it.
  */
 typedef tb_iterator_ref_t tb_hash_map_ref_t;
 
@@ -102,7 +117,7 @@ typedef tb_iterator_ref_t tb_hash_map_ref_t;
 
 /*! init hash map
  *
- * @param bucket_size   the hash bucket size, using the default size if be zero
+ * @param bucket_size   the hash bucket size, using the default size if be zero, or with TB_HASH_MAP_BUCKET_GROW for growing
  * @param element_name  the item for name
  * @param element_data  the item for data
  *
@@ -110,6 +125,19 @@ typedef tb_iterator_ref_t tb_hash_map_ref_t;
  */
 tb_hash_map_ref_t       tb_hash_map_init(tb_size_t bucket_size, tb_element_t element_name, tb_element_t element_data);
 
+/*! init hash map with the given allocator
+ *
+ * the hash map, items and the duplicated element data (e.g. string) will be allocated from this allocator
+ *
+ * @param allocator     the allocator, uses the global allocator if be null
+ * @param bucket_size   the hash bucket size, using the default size if be zero, or with TB_HASH_MAP_BUCKET_GROW for growing
+ * @param element_name  the item for name
+ * @param element_data  the item for data
+ *
+ * @return              the hash map
+ */
+tb_hash_map_ref_t       tb_hash_map_init_with_allocator(tb_allocator_ref_t allocator, tb_size_t bucket_size, tb_element_t element_name, tb_element_t element_data);
+
 /*! exit hash map
  *
  * @param hash_map      the hash map
@@ -63,9 +63,13 @@ static tb_pointer_t tb_hash_set_itor_item(tb_iterator_ref_t iterator, tb_size_t
  * implementation
  */
 tb_hash_set_ref_t tb_hash_set_init(tb_size_t bucket_size, tb_element_t element)
+{
+    return tb_hash_set_init_with_allocator(tb_null, bucket_size, element);
+}
+tb_hash_set_ref_t tb_hash_set_init_with_allocator(tb_allocator_ref_t allocator, tb_size_t bucket_size, tb_element_t element)
 {
     // init hash set
-    tb_iterator_ref_t hash_set = (tb_iterator_ref_t)tb_hash_map_init(bucket_size, element, tb_element_true());
+    tb_iterator_ref_t hash_set = (tb_iterator_ref_t)tb_hash_map_init_with_allocator(allocator, bucket_size, element, tb_element_true());
 
     // @note the private data of the hash map iterator cannot be used
     tb_assert(!hash_set->priv);
@@ -49,6 +49,9 @@ __tb_extern_c_enter__
 /// the large hash bucket size
 #define TB_HASH_SET_BUCKET_SIZE_LARGE                 TB_HASH_MAP_BUCKET_SIZE_LARGE
 
+/// the growing flag of the hash bucket size, @see TB_HASH_MAP_BUCKET_GROW
+#define TB_HASH_SET_BUCKET_GROW                       TB_HASH_MAP_BUCKET_GROW
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -65,13 +68,25 @@ typedef tb_iterator_ref_t tb_hash_set_ref_t;
 
 /*! init hash set
  *
- * @param bucket_size   the hash bucket size, using the default size if be zero
+ * @param bucket_size   the hash bucket size, using the default size if be zero, or with TB_HASH_SET_BUCKET_GROW for growing
  * @param element       the element
  *
  * @return              the hash set
  */
 tb_hash_set_ref_t       tb_hash_set_init(tb_size_t bucket_size, tb_element_t element);
 
+/*! init hash set with the given allocator
+ *
+ * the hash set, items and the duplicated element data (e.g. string) will be allocated from this allocator
+ *
+ * @param allocator     the allocator, uses the global allocator if be null
+ * @param bucket_size   the hash bucket size, using the default size if be zero, or with TB_HASH_SET_BUCKET_GROW for growing
+ * @param element       the element
+ *
+ * @return              the hash set
+ */
+tb_hash_set_ref_t       tb_hash_set_init_with_allocator(tb_allocator_ref_t allocator, tb_size_t bucket_size, tb_element_t element);
+
 /*! exit hash set
  *
  * @param hash_set      the hash set
@@ -92,6 +92,9 @@ typedef struct __tb_heap_t
     // the element
     tb_element_t            element;
 
+    // the allocator
+    tb_allocator_ref_t      allocator;
+
 }tb_heap_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -474,6 +477,10 @@ static tb_void_t tb_heap_itor_remove(tb_iterator_ref_t iterator, tb_size_t itor)
  * implementation
  */
 tb_heap_ref_t tb_heap_init(tb_size_t grow, tb_element_t element)
+{
+    return tb_heap_init_with_allocator(tb_null, grow, element);
+}
+tb_heap_ref_t tb_heap_init_with_allocator(tb_allocator_ref_t allocator, tb_size_t grow, tb_element_t element)
 {
     // check
     tb_assert_and_check_return_val(element.size && element.data && element.dupl && element.repl, tb_null);
@@ -483,13 +490,23 @@ tb_heap_ref_t tb_heap_init(tb_size_t grow, tb_element_t element)
     tb_heap_t*  heap = tb_null;
     do
     {
+        // duplicate the element data (e.g. string) to the given allocator
+        if (allocator && !element.allocator) element.allocator = allocator;
+
+        // no allocator? uses the global allocator
+        if (!allocator) allocator = tb_allocator();
+        tb_assert_and_check_break(allocator);
+
         // using the default grow
         if (!grow) grow = TB_HEAP_GROW;
 
         // make heap
-        heap = tb_malloc0_type(tb_heap_t);
+        heap = (tb_heap_t*)tb_allocator_malloc0(allocator, sizeof(tb_heap_t));
         tb_assert_and_check_break(heap);
 
+        // init allocator
+        heap->allocator = allocator;
+
         // init heap
         heap->size      = 0;
         heap->grow      = grow;
@@ -513,7 +530,7 @@ tb_heap_ref_t tb_heap_init(tb_size_t grow, tb_element_t element)
         heap->itor.remove   = tb_heap_itor_remove;
 
         // make data
-        heap->data = (tb_byte_t*)tb_nalloc0(heap->maxn, element.size);
+        heap->data = (tb_byte_t*)tb_allocator_nalloc0(heap->allocator, heap->maxn, element.size);
         tb_assert_and_check_break(heap->data);
 
         // ok
@@ -542,11 +559,11 @@ tb_void_t tb_heap_exit(tb_heap_ref_t self)
     tb_heap_clear(self);
 
     // free data
-    if (heap->data) tb_free(heap->data);
+    if (heap->data) tb_allocator_free(heap->allocator, heap->data);
     heap->data = tb_null;
 
     // free it
-    tb_free(heap);
+    tb_allocator_free(heap->allocator, heap);
 }
 tb_void_t tb_heap_clear(tb_heap_ref_t self)
 {   
@@ -597,7 +614,7 @@ tb_void_t tb_heap_put(tb_heap_ref_t self, tb_cpointer_t data)
         tb_assert_and_check_return(maxn < TB_HEAP_MAXN);
 
         // realloc data
-        heap->data = (tb_byte_t*)tb_ralloc(heap->data, maxn * heap->element.size);
+        heap->data = (tb_byte_t*)tb_allocator_ralloc(heap->allocator, heap->data, maxn * heap->element.size);
         tb_assert_and_check_return(heap->data);
 
         // must be align by 4-bytes
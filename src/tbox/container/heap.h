@@ -90,6 +90,18 @@ typedef tb_iterator_ref_t tb_heap_ref_t;
  */
 tb_heap_ref_t       tb_heap_init(tb_size_t grow, tb_element_t element);
 
+/*! init heap with the given allocator
+ *
+ * the heap, items and the duplicated element data (e.g. string) will be allocated from this allocator
+ *
+ * @param allocator the allocator, uses the global allocator if be null
+ * @param grow      the item grow, using the default grow if be zero
+ * @param element   the element
+ *
+ * @return          the heap
+ */
+tb_heap_ref_t       tb_heap_init_with_allocator(tb_allocator_ref_t allocator, tb_size_t grow, tb_element_t element);
+
 /*! exit heap
  *
  * @param heap      the heap
@@ -79,6 +79,9 @@ typedef struct __tb_list_t
     // the element
     tb_element_t                element;
 
+    // the allocator
+    tb_allocator_ref_t          allocator;
+
 }tb_list_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -202,6 +205,10 @@ static tb_void_t tb_list_item_exit(tb_pointer_t data, tb_cpointer_t priv)
  * implementation
  */
 tb_list_ref_t tb_list_init(tb_size_t grow, tb_element_t element)
+{
+    return tb_list_init_with_allocator(tb_null, grow, element);
+}
+tb_list_ref_t tb_list_init_with_allocator(tb_allocator_ref_t allocator, tb_size_t grow, tb_element_t element)
 {
     // check
     tb_assert_and_check_return_val(element.size && element.data && element.dupl && element.repl, tb_null);
@@ -211,13 +218,23 @@ tb_list_ref_t tb_list_init(tb_size_t grow, tb_element_t element)
     tb_list_t*  list = tb_null;
     do
     {
+        // duplicate the element data (e.g. string) to the given allocator
+        if (allocator && !element.allocator) element.allocator = allocator;
+
+        // no allocator? uses the global allocator
+        if (!allocator) allocator = tb_allocator();
+        tb_assert_and_check_break(allocator);
+
         // using the default grow
         if (!grow) grow = TB_LIST_GROW;
 
         // make self
-        list = tb_malloc0_type(tb_list_t);
+        list = (tb_list_t*)tb_allocator_malloc0(allocator, sizeof(tb_list_t));
         tb_assert_and_check_break(list);
 
+        // init allocator
+        list->allocator = allocator;
+
         // init element
         list->element = element;
 
@@ -238,7 +255,7 @@ tb_list_ref_t tb_list_init(tb_size_t grow, tb_element_t element)
         list->itor.remove_range = tb_list_itor_remove_range;
 
         // init pool, item = entry + data
-        list->pool = tb_fixed_pool_init(tb_null, grow, sizeof(tb_list_entry_t) + element.size, tb_null, tb_list_item_exit, (tb_cpointer_t)list);
+        list->pool = tb_fixed_pool_init(allocator, grow, sizeof(tb_list_entry_t) + element.size, tb_null, tb_list_item_exit, (tb_cpointer_t)list);
         tb_assert_and_check_break(list->pool);
 
         // init head
@@ -273,7 +290,7 @@ tb_void_t tb_list_exit(tb_list_ref_t self)
     if (list->pool) tb_fixed_pool_exit(list->pool);
 
     // exit it
-    tb_free(list);
+    tb_allocator_free(list->allocator, list);
 }
 tb_void_t tb_list_clear(tb_list_ref_t self)
 {
@@ -35,6 +35,10 @@ tb_priority_queue_ref_t tb_priority_queue_init(tb_size_t grow, tb_element_t elem
 {
     return (tb_priority_queue_ref_t)tb_heap_init(grow, element);
 }
+tb_priority_queue_ref_t tb_priority_queue_init_with_allocator(tb_allocator_ref_t allocator, tb_size_t grow, tb_element_t element)
+{
+    return (tb_priority_queue_ref_t)tb_heap_init_with_allocator(allocator, grow, element);
+}
 tb_void_t tb_priority_queue_exit(tb_priority_queue_ref_t self)
 {
     tb_heap_exit((tb_heap_ref_t)self);
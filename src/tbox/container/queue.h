@@ -76,6 +76,18 @@ typedef tb_single_list_ref_t   tb_queue_ref_t;
  */
 tb_queue_ref_t      tb_queue_init(tb_size_t grow, tb_element_t element);
 
+/*! init queue with the given allocator
+ *
+ * the queue, items and the duplicated element data (e.g. string) will be allocated from this allocator
+ *
+ * @param allocator the allocator, uses the global allocator if be null
+ * @param grow      the grow size, using the default grow size if be zero
+ * @param element   the element
+ *
+ * @return          the queue
+ */
+tb_queue_ref_t      tb_queue_init_with_allocator(tb_allocator_ref_t allocator, tb_size_t grow, tb_element_t element);
+
 /*! exit queue
  *
  * @param queue     the queue
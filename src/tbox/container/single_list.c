@@ -79,6 +79,9 @@ typedef struct __tb_single_list_t
     // the element
     tb_element_t                    element;
 
+    // the allocator
+    tb_allocator_ref_t              allocator;
+
 }tb_single_list_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -197,6 +200,10 @@ static tb_void_t tb_single_list_item_exit(tb_pointer_t data, tb_cpointer_t priv)
  * implementation
  */
 tb_single_list_ref_t tb_single_list_init(tb_size_t grow, tb_element_t element)
+{
+    return tb_single_list_init_with_allocator(tb_null, grow, element);
+}
+tb_single_list_ref_t tb_single_list_init_with_allocator(tb_allocator_ref_t allocator, tb_size_t grow, tb_element_t element)
 {
     // check
     tb_assert_and_check_return_val(element.size && element.data && element.dupl && element.repl, tb_null);
@@ -206,13 +213,23 @@ tb_single_list_ref_t tb_single_list_init(tb_size_t grow, tb_element_t element)
     tb_single_list_t*   list = tb_null;
     do
     {
+        // duplicate the element data (e.g. string) to the given allocator
+        if (allocator && !element.allocator) element.allocator = allocator;
+
+        // no allocator? uses the global allocator
+        if (!allocator) allocator = tb_allocator();
+        tb_assert_and_check_break(allocator);
+
         // using the default grow
         if (!grow) grow = TB_SINGLE_LIST_GROW;
 
         // make self
-        list = tb_malloc0_type(tb_single_list_t);
+        list = (tb_single_list_t*)tb_allocator_malloc0(allocator, sizeof(tb_single_list_t));
         tb_assert_and_check_break(list);
 
+        // init allocator
+        list->allocator = allocator;
+
         // init element
         list->element = element;
 
@@ -231,7 +248,7 @@ tb_single_list_ref_t tb_single_list_init(tb_size_t grow, tb_element_t element)
         list->itor.remove_range = tb_single_list_itor_remove_range;
 
         // init pool, item = entry + data
-        list->pool = tb_fixed_pool_init(tb_null, grow, sizeof(tb_single_list_entry_t) + element.size, tb_null, tb_single_list_item_exit, (tb_cpointer_t)list);
+        list->pool = tb_fixed_pool_init(allocator, grow, sizeof(tb_single_list_entry_t) + element.size, tb_null, tb_single_list_item_exit, (tb_cpointer_t)list);
         tb_assert_and_check_break(list->pool);
 
         // init head
@@ -266,7 +283,7 @@ tb_void_t tb_single_list_exit(tb_single_list_ref_t self)
     if (list->pool) tb_fixed_pool_exit(list->pool);
 
     // free it
-    tb_free(list);
+    tb_allocator_free(list->allocator, list);
 }
 tb_void_t tb_single_list_clear(tb_single_list_ref_t self)
 {
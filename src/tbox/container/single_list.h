@@ -83,6 +83,18 @@ typedef tb_iterator_ref_t   tb_single_list_ref_t;
  */
 tb_single_list_ref_t    tb_single_list_init(tb_size_t grow, tb_element_t element);
 
+/*! init list with the given allocator
+ *
+ * the list, items and the duplicated element data (e.g. string) will be allocated from this allocator
+ *
+ * @param allocator     the allocator, uses the global allocator if be null
+ * @param grow          the grow size
+ * @param element       the element
+ *
+ * @return              the list
+ */
+tb_single_list_ref_t    tb_single_list_init_with_allocator(tb_allocator_ref_t allocator, tb_size_t grow, tb_element_t element);
+
 /*! exit list
  *
  * @param list          the list
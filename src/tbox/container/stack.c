@@ -40,6 +40,10 @@ tb_stack_ref_t tb_stack_init(tb_size_t grow, tb_element_t element)
 {
     return (tb_stack_ref_t)tb_vector_init(grow, element);
 }
+tb_stack_ref_t tb_stack_init_with_allocator(tb_allocator_ref_t allocator, tb_size_t grow, tb_element_t element)
+{
+    return (tb_stack_ref_t)tb_vector_init_with_allocator(allocator, grow, element);
+}
 tb_void_t tb_stack_exit(tb_stack_ref_t self)
 {
     tb_vector_exit((tb_vector_ref_t)self);
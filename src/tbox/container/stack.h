@@ -78,6 +78,18 @@ typedef tb_vector_ref_t tb_stack_ref_t;
  */
 tb_stack_ref_t      tb_stack_init(tb_size_t grow, tb_element_t element);
 
+/*! init stack with the given allocator
+ *
+ * the stack, items and the duplicated element data (e.g. string) will be allocated from this allocator
+ *
+ * @param allocator the allocator, uses the global allocator if be null
+ * @param grow      the item grow
+ * @param element   the element
+ *
+ * @return          the stack
+ */
+tb_stack_ref_t      tb_stack_init_with_allocator(tb_allocator_ref_t allocator, tb_size_t grow, tb_element_t element);
+
 /*! exit stack
  *
  * @param stack     the stack
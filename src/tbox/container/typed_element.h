@@ -0,0 +1,132 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        typed_element.h
+ * @ingroup     container
+ *
+ */
+#ifndef TB_CONTAINER_TYPED_ELEMENT_H
+#define TB_CONTAINER_TYPED_ELEMENT_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../libc/string/string.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/*! the inlined element operations for the typed containers and algorithms
+ *
+ * the typed containers are generated by the macros, e.g. TB_TYPED_VECTOR_DECL(), TB_TYPED_HASH_MAP_DECL(), ...
+ * and they will call these operations directly instead of the callbacks of tb_element_t.
+ *
+ * - the integer types: long, size, uint32, uint64 and pointer
+ * - the fixed-size mem types: the struct or array types without pointers, e.g. typedef struct {tb_byte_t data[16];} key_t;
+ */
+
+/// the equal operation of the integer and pointer types
+#define tb_typed_equal(a, b)                    ((a) == (b))
+
+/// the less operation of the integer and pointer types
+#define tb_typed_less(a, b)                     ((a) < (b))
+
+/// the greater operation of the integer and pointer types
+#define tb_typed_greater(a, b)                  ((a) > (b))
+
+/// the equal operation of the fixed-size mem types
+#define tb_typed_equal_mem(a, b)                (!tb_memcmp(&(a), &(b), sizeof(a)))
+
+/// the less operation of the fixed-size mem types
+#define tb_typed_less_mem(a, b)                 (tb_memcmp(&(a), &(b), sizeof(a)) < 0)
+
+/// the hash operation of the uint32 type
+#define tb_typed_hash_uint32(value)             tb_typed_hash_mix32((tb_uint32_t)(value))
+
+/// the hash operation of the uint64 type
+#define tb_typed_hash_uint64(value)             ((tb_size_t)tb_typed_hash_mix64((tb_uint64_t)(value)))
+
+/// the hash operation of the long, size and pointer types
+#if TB_CPU_BIT64
+#   define tb_typed_hash_size(value)            tb_typed_hash_uint64((tb_size_t)(value))
+#else
+#   define tb_typed_hash_size(value)            tb_typed_hash_uint32((tb_size_t)(value))
+#endif
+#define tb_typed_hash_long(value)               tb_typed_hash_size(value)
+#define tb_typed_hash_ptr(value)                tb_typed_hash_size(value)
+
+/// the hash operation of the fixed-size mem types
+#define tb_typed_hash_mem(value)                tb_typed_hash_data((tb_byte_t const*)&(value), sizeof(value))
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * inlines
+ */
+
+/* the finalizer of murmurhash3 for 32-bits
+ *
+ * all bits of the value will be mixed, because the typed hash map uses the low bits as the slot index
+ */
+static __tb_inline__ tb_size_t tb_typed_hash_mix32(tb_uint32_t value)
+{
+    value ^= value >> 16;
+    value *= 0x85ebca6b;
+    value ^= value >> 13;
+    value *= 0xc2b2ae35;
+    value ^= value >> 16;
+    return (tb_size_t)value;
+}
+
+// the finalizer of murmurhash3 for 64-bits
+static __tb_inline__ tb_uint64_t tb_typed_hash_mix64(tb_uint64_t value)
+{
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdull;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ull;
+    value ^= value >> 33;
+    return value;
+}
+
+// the fnv-1a hash of the fixed-size data
+static __tb_inline__ tb_size_t tb_typed_hash_data(tb_byte_t const* data, tb_size_t size)
+{
+    tb_uint32_t value = 2166136261u;
+    while (size--) 
+    {
+        value ^= *data++;
+        value *= 16777619u;
+    }
+    return tb_typed_hash_mix32(value);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -0,0 +1,298 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        typed_hash_map.h
+ * @ingroup     container
+ *
+ */
+#ifndef TB_CONTAINER_TYPED_HASH_MAP_H
+#define TB_CONTAINER_TYPED_HASH_MAP_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "typed_element.h"
+#include "../memory/allocator.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/*! declare the typed hash map for the POD types
+ *
+ * it will generate the hash map type: prefix_t, the item type: prefix_item_t 
+ * and the inlined interfaces: prefix_init(), prefix_get(), prefix_insert(), ...
+ *
+ * the items are stored in one slot array with linear probing, and one control byte for each slot (empty, full or deleted),
+ * the hash and equal operations are inlined, so it need not call the callbacks of tb_element_t.
+ *
+ * <pre>
+ * ctrls: | full | empty | full | deleted | full | ... |
+ * items: | name |       | name |         | name | ... |
+ *        | data |       | data |         | data | ... |
+ * </pre>
+ *
+ * @code
+ 
+    // declare the hash map of tb_size_t => tb_uint32_t
+    TB_TYPED_HASH_MAP_DECL(tb_size_hash_map, tb_size_t, tb_uint32_t, tb_typed_hash_size, tb_typed_equal)
+
+    // init hash map
+    tb_size_hash_map_t hash_map;
+    tb_size_hash_map_init(&hash_map, tb_null);
+
+    // insert items
+    tb_size_hash_map_insert(&hash_map, 1, 10);
+    tb_size_hash_map_insert(&hash_map, 2, 20);
+
+    // get item
+    tb_uint32_t* data = tb_size_hash_map_get(&hash_map, 1);
+    if (data) tb_trace_i("%u", *data);
+
+    // walk items
+    tb_size_hash_map_item_t* item = tb_null;
+    while ((item = tb_size_hash_map_next(&hash_map, item))) 
+        tb_trace_i("%lu => %u", item->name, item->data);
+
+    // exit hash map
+    tb_size_hash_map_exit(&hash_map);
+ * @endcode
+ *
+ * @param prefix        the prefix name of the hash map type and interfaces
+ * @param name_type     the item name type
+ * @param data_type     the item data type
+ * @param hash          the hash operation of name, e.g. tb_typed_hash_size, tb_typed_hash_mem
+ * @param equal         the equal operation of name, e.g. tb_typed_equal, tb_typed_equal_mem
+ */
+#define TB_TYPED_HASH_MAP_DECL(prefix, name_type, data_type, hash, equal) \
+    \
+    /* the typed hash map item type */ \
+    typedef struct __##prefix##_item_t \
+    { \
+        /* the item name */ \
+        name_type               name; \
+        \
+        /* the item data */ \
+        data_type               data; \
+    \
+    }prefix##_item_t; \
+    \
+    /* the typed hash map type */ \
+    typedef struct __##prefix##_t \
+    { \
+        /* the slot items */ \
+        prefix##_item_t*        items; \
+        \
+        /* the slot controls, 0: empty, 1: full, 2: deleted */ \
+        tb_byte_t*              ctrls; \
+        \
+        /* the items count */ \
+        tb_size_t               size; \
+        \
+        /* the full and deleted slots count */ \
+        tb_size_t               used; \
+        \
+        /* the slots count, it is zero or power of 2 */ \
+        tb_size_t               maxn; \
+        \
+        /* the allocator */ \
+        tb_allocator_ref_t      allocator; \
+    \
+    }prefix##_t; \
+    \
+    /* init hash map, uses the global allocator if the allocator is null */ \
+    static __tb_inline__ tb_void_t prefix##_init(prefix##_t* hash_map, tb_allocator_ref_t allocator) \
+    { \
+        hash_map->items     = tb_null; \
+        hash_map->ctrls     = tb_null; \
+        hash_map->size      = 0; \
+        hash_map->used      = 0; \
+        hash_map->maxn      = 0; \
+        hash_map->allocator = allocator? allocator : tb_allocator(); \
+    } \
+    \
+    /* exit hash map */ \
+    static __tb_inline__ tb_void_t prefix##_exit(prefix##_t* hash_map) \
+    { \
+        if (hash_map->items) tb_allocator_free(hash_map->allocator, hash_map->items); \
+        hash_map->items = tb_null; \
+        hash_map->ctrls = tb_null; \
+        hash_map->size  = 0; \
+        hash_map->used  = 0; \
+        hash_map->maxn  = 0; \
+    } \
+    \
+    /* clear hash map */ \
+    static __tb_inline__ tb_void_t prefix##_clear(prefix##_t* hash_map) \
+    { \
+        if (hash_map->ctrls) tb_memset(hash_map->ctrls, 0, hash_map->maxn); \
+        hash_map->size = 0; \
+        hash_map->used = 0; \
+    } \
+    \
+    /* the items count */ \
+    static __tb_inline__ tb_size_t prefix##_size(prefix##_t const* hash_map) \
+    { \
+        return hash_map->size; \
+    } \
+    \
+    /* the slots count */ \
+    static __tb_inline__ tb_size_t prefix##_maxn(prefix##_t const* hash_map) \
+    { \
+        return hash_map->maxn; \
+    } \
+    \
+    /* find the slot of the given name, return the slots count if not found */ \
+    static __tb_inline__ tb_size_t prefix##_slot(prefix##_t const* hash_map, name_type name) \
+    { \
+        tb_check_return_val(hash_map->size, hash_map->maxn); \
+        tb_size_t mask = hash_map->maxn - 1; \
+        tb_size_t index = (tb_size_t)hash(name) & mask; \
+        tb_byte_t ctrl; \
+        while ((ctrl = hash_map->ctrls[index])) \
+        { \
+            if (ctrl == 1 && equal(hash_map->items[index].name, name)) return index; \
+            index = (index + 1) & mask; \
+        } \
+        return hash_map->maxn; \
+    } \
+    \
+    /* resize the slots and rehash all items */ \
+    static __tb_inline__ tb_bool_t prefix##_resize(prefix##_t* hash_map, tb_size_t maxn) \
+    { \
+        /* make the new slots */ \
+        prefix##_item_t* items = (prefix##_item_t*)tb_allocator_malloc(hash_map->allocator, maxn * (sizeof(prefix##_item_t) + 1)); \
+        tb_assert_and_check_return_val(items, tb_false); \
+        tb_byte_t* ctrls = (tb_byte_t*)(items + maxn); \
+        tb_memset(ctrls, 0, maxn); \
+        \
+        /* move the full items, the deleted slots are dropped */ \
+        tb_size_t i = 0; \
+        tb_size_t mask = maxn - 1; \
+        for (i = 0; i < hash_map->maxn; i++) \
+        { \
+            if (hash_map->ctrls[i] == 1) \
+            { \
+                tb_size_t index = (tb_size_t)hash(hash_map->items[i].name) & mask; \
+                while (ctrls[index]) index = (index + 1) & mask; \
+                ctrls[index] = 1; \
+                items[index] = hash_map->items[i]; \
+            } \
+        } \
+        \
+        /* update slots */ \
+        if (hash_map->items) tb_allocator_free(hash_map->allocator, hash_map->items); \
+        hash_map->items = items; \
+        hash_map->ctrls = ctrls; \
+        hash_map->maxn  = maxn; \
+        hash_map->used  = hash_map->size; \
+        return tb_true; \
+    } \
+    \
+    /* get the item data, return null if not found */ \
+    static __tb_inline__ data_type* prefix##_get(prefix##_t const* hash_map, name_type name) \
+    { \
+        tb_size_t index = prefix##_slot(hash_map, name); \
+        return index < hash_map->maxn? &hash_map->items[index].data : tb_null; \
+    } \
+    \
+    /* insert or replace the item */ \
+    static __tb_inline__ tb_bool_t prefix##_insert(prefix##_t* hash_map, name_type name, data_type data) \
+    { \
+        /* too many used slots? grow it if there are too many items, otherwise drop the deleted slots */ \
+        if ((hash_map->used + 1) * 4 > hash_map->maxn * 3) \
+        { \
+            tb_size_t maxn = hash_map->maxn? hash_map->maxn : 16; \
+            if ((hash_map->size + 1) * 2 > maxn) maxn <<= 1; \
+            if (!prefix##_resize(hash_map, maxn)) return tb_false; \
+        } \
+        \
+        /* find the same item or the first free slot */ \
+        tb_size_t mask = hash_map->maxn - 1; \
+        tb_size_t index = (tb_size_t)hash(name) & mask; \
+        tb_size_t deleted = hash_map->maxn; \
+        tb_byte_t ctrl; \
+        while ((ctrl = hash_map->ctrls[index])) \
+        { \
+            if (ctrl == 1) \
+            { \
+                if (equal(hash_map->items[index].name, name)) \
+                { \
+                    hash_map->items[index].data = data; \
+                    return tb_true; \
+                } \
+            } \
+            else if (deleted == hash_map->maxn) deleted = index; \
+            index = (index + 1) & mask; \
+        } \
+        \
+        /* reuse the deleted slot first */ \
+        if (deleted != hash_map->maxn) index = deleted; \
+        else hash_map->used++; \
+        \
+        /* insert it */ \
+        hash_map->ctrls[index]      = 1; \
+        hash_map->items[index].name = name; \
+        hash_map->items[index].data = data; \
+        hash_map->size++; \
+        return tb_true; \
+    } \
+    \
+    /* remove the item */ \
+    static __tb_inline__ tb_bool_t prefix##_remove(prefix##_t* hash_map, name_type name) \
+    { \
+        tb_size_t index = prefix##_slot(hash_map, name); \
+        tb_check_return_val(index < hash_map->maxn, tb_false); \
+        \
+        /* mark it as empty if the next slot is empty, because no probing sequence passes it */ \
+        if (!hash_map->ctrls[(index + 1) & (hash_map->maxn - 1)]) \
+        { \
+            hash_map->ctrls[index] = 0; \
+            hash_map->used--; \
+        } \
+        else hash_map->ctrls[index] = 2; \
+        hash_map->size--; \
+        return tb_true; \
+    } \
+    \
+    /* the next item for walking, return the first item if the item is null */ \
+    static __tb_inline__ prefix##_item_t* prefix##_next(prefix##_t const* hash_map, prefix##_item_t const* item) \
+    { \
+        tb_size_t index = item? (tb_size_t)(item - hash_map->items) + 1 : 0; \
+        for (; index < hash_map->maxn; index++) \
+        { \
+            if (hash_map->ctrls[index] == 1) return &hash_map->items[index]; \
+        } \
+        return tb_null; \
+    }
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -0,0 +1,189 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        typed_heap.h
+ * @ingroup     container
+ *
+ */
+#ifndef TB_CONTAINER_TYPED_HEAP_H
+#define TB_CONTAINER_TYPED_HEAP_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "typed_element.h"
+#include "../memory/allocator.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/*! declare the typed binary heap for the POD type
+ *
+ * it will generate the heap type: prefix_t and the inlined interfaces: prefix_init(), prefix_put(), prefix_top(), prefix_pop(), ...
+ * the top item is the minimum item for the given less operation, and it is the maximum item for the greater operation.
+ *
+ * @code
+ 
+    // declare the min-heap of tb_uint32_t
+    TB_TYPED_HEAP_DECL(tb_uint32_heap, tb_uint32_t, tb_typed_less)
+
+    // init heap
+    tb_uint32_heap_t heap;
+    tb_uint32_heap_init(&heap, tb_null);
+
+    // put items
+    tb_uint32_heap_put(&heap, 3);
+    tb_uint32_heap_put(&heap, 1);
+    tb_uint32_heap_put(&heap, 2);
+
+    // pop items: 1, 2, 3
+    while (tb_uint32_heap_size(&heap))
+    {
+        tb_trace_i("%u", tb_uint32_heap_top(&heap));
+        tb_uint32_heap_pop(&heap);
+    }
+
+    // exit heap
+    tb_uint32_heap_exit(&heap);
+ * @endcode
+ *
+ * @param prefix        the prefix name of the heap type and interfaces
+ * @param type          the item type
+ * @param less          the less operation, e.g. tb_typed_less, tb_typed_greater, tb_typed_less_mem
+ */
+#define TB_TYPED_HEAP_DECL(prefix, type, less) \
+    \
+    /* the typed heap type */ \
+    typedef struct __##prefix##_t \
+    { \
+        /* the items */ \
+        type*                   data; \
+        \
+        /* the items count */ \
+        tb_size_t               size; \
+        \
+        /* the items maxn */ \
+        tb_size_t               maxn; \
+        \
+        /* the allocator */ \
+        tb_allocator_ref_t      allocator; \
+    \
+    }prefix##_t; \
+    \
+    /* init heap, uses the global allocator if the allocator is null */ \
+    static __tb_inline__ tb_void_t prefix##_init(prefix##_t* heap, tb_allocator_ref_t allocator) \
+    { \
+        heap->data      = tb_null; \
+        heap->size      = 0; \
+        heap->maxn      = 0; \
+        heap->allocator = allocator? allocator : tb_allocator(); \
+    } \
+    \
+    /* exit heap */ \
+    static __tb_inline__ tb_void_t prefix##_exit(prefix##_t* heap) \
+    { \
+        if (heap->data) tb_allocator_free(heap->allocator, heap->data); \
+        heap->data = tb_null; \
+        heap->size = 0; \
+        heap->maxn = 0; \
+    } \
+    \
+    /* clear heap */ \
+    static __tb_inline__ tb_void_t prefix##_clear(prefix##_t* heap) \
+    { \
+        heap->size = 0; \
+    } \
+    \
+    /* the items count */ \
+    static __tb_inline__ tb_size_t prefix##_size(prefix##_t const* heap) \
+    { \
+        return heap->size; \
+    } \
+    \
+    /* the top item */ \
+    static __tb_inline__ type prefix##_top(prefix##_t const* heap) \
+    { \
+        tb_assert(heap->size); \
+        return heap->data[0]; \
+    } \
+    \
+    /* put the item */ \
+    static __tb_inline__ tb_bool_t prefix##_put(prefix##_t* heap, type value) \
+    { \
+        /* grow it */ \
+        if (heap->size >= heap->maxn) \
+        { \
+            tb_size_t maxn = heap->maxn? (heap->maxn << 1) : 16; \
+            type* data = (type*)tb_allocator_ralloc(heap->allocator, heap->data, maxn * sizeof(type)); \
+            tb_assert_and_check_return_val(data, tb_false); \
+            heap->data = data; \
+            heap->maxn = maxn; \
+        } \
+        \
+        /* shift up the hole from the tail */ \
+        type*       data = heap->data; \
+        tb_size_t   hole = heap->size++; \
+        while (hole) \
+        { \
+            tb_size_t parent = (hole - 1) >> 1; \
+            if (!less(value, data[parent])) break; \
+            data[hole] = data[parent]; \
+            hole = parent; \
+        } \
+        data[hole] = value; \
+        return tb_true; \
+    } \
+    \
+    /* pop the top item */ \
+    static __tb_inline__ tb_void_t prefix##_pop(prefix##_t* heap) \
+    { \
+        tb_assert_and_check_return(heap->size); \
+        \
+        /* shift down the hole from the head with the last item */ \
+        type*       data = heap->data; \
+        tb_size_t   size = --heap->size; \
+        tb_size_t   hole = 0; \
+        tb_size_t   child; \
+        tb_check_return(size); \
+        type        last = data[size]; \
+        while ((child = (hole << 1) + 1) < size) \
+        { \
+            if (child + 1 < size && less(data[child + 1], data[child])) child++; \
+            if (!less(data[child], last)) break; \
+            data[hole] = data[child]; \
+            hole = child; \
+        } \
+        data[hole] = last; \
+    }
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
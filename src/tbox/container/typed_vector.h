@@ -0,0 +1,230 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        typed_vector.h
+ * @ingroup     container
+ *
+ */
+#ifndef TB_CONTAINER_TYPED_VECTOR_H
+#define TB_CONTAINER_TYPED_VECTOR_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "typed_element.h"
+#include "../memory/allocator.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/*! declare the typed vector for the POD type
+ *
+ * it will generate the vector type: prefix_t and the inlined interfaces: prefix_init(), prefix_insert_tail(), ...
+ * the items are copied by assignment and compared by the given equal operation, 
+ * so it need not call the callbacks of tb_element_t and it is faster than tb_vector for the small types.
+ *
+ * @code
+ 
+    // declare the vector of tb_size_t
+    TB_TYPED_VECTOR_DECL(tb_size_vector, tb_size_t, tb_typed_equal)
+
+    // init vector
+    tb_size_vector_t vector;
+    tb_size_vector_init(&vector, tb_null);
+
+    // insert items
+    tb_size_vector_insert_tail(&vector, 1);
+    tb_size_vector_insert_tail(&vector, 2);
+
+    // walk items
+    tb_size_t i = 0;
+    for (i = 0; i < tb_size_vector_size(&vector); i++) 
+        tb_trace_i("%lu", tb_size_vector_get(&vector, i));
+
+    // exit vector
+    tb_size_vector_exit(&vector);
+ * @endcode
+ *
+ * @param prefix        the prefix name of the vector type and interfaces
+ * @param type          the item type
+ * @param equal         the equal operation, e.g. tb_typed_equal, tb_typed_equal_mem
+ */
+#define TB_TYPED_VECTOR_DECL(prefix, type, equal) \
+    \
+    /* the typed vector type */ \
+    typedef struct __##prefix##_t \
+    { \
+        /* the items */ \
+        type*                   data; \
+        \
+        /* the items count */ \
+        tb_size_t               size; \
+        \
+        /* the items maxn */ \
+        tb_size_t               maxn; \
+        \
+        /* the allocator */ \
+        tb_allocator_ref_t      allocator; \
+    \
+    }prefix##_t; \
+    \
+    /* init vector, uses the global allocator if the allocator is null */ \
+    static __tb_inline__ tb_void_t prefix##_init(prefix##_t* vector, tb_allocator_ref_t allocator) \
+    { \
+        vector->data        = tb_null; \
+        vector->size        = 0; \
+        vector->maxn        = 0; \
+        vector->allocator   = allocator? allocator : tb_allocator(); \
+    } \
+    \
+    /* exit vector */ \
+    static __tb_inline__ tb_void_t prefix##_exit(prefix##_t* vector) \
+    { \
+        if (vector->data) tb_allocator_free(vector->allocator, vector->data); \
+        vector->data = tb_null; \
+        vector->size = 0; \
+        vector->maxn = 0; \
+    } \
+    \
+    /* clear vector */ \
+    static __tb_inline__ tb_void_t prefix##_clear(prefix##_t* vector) \
+    { \
+        vector->size = 0; \
+    } \
+    \
+    /* the items count */ \
+    static __tb_inline__ tb_size_t prefix##_size(prefix##_t const* vector) \
+    { \
+        return vector->size; \
+    } \
+    \
+    /* the items data */ \
+    static __tb_inline__ type* prefix##_data(prefix##_t const* vector) \
+    { \
+        return vector->data; \
+    } \
+    \
+    /* reserve the items space */ \
+    static __tb_inline__ tb_bool_t prefix##_reserve(prefix##_t* vector, tb_size_t maxn) \
+    { \
+        /* enough? */ \
+        tb_check_return_val(maxn > vector->maxn, tb_true); \
+        \
+        /* grow it */ \
+        if (maxn < (vector->maxn << 1)) maxn = vector->maxn << 1; \
+        if (maxn < 16) maxn = 16; \
+        type* data = (type*)tb_allocator_ralloc(vector->allocator, vector->data, maxn * sizeof(type)); \
+        tb_assert_and_check_return_val(data, tb_false); \
+        \
+        /* update it */ \
+        vector->data = data; \
+        vector->maxn = maxn; \
+        return tb_true; \
+    } \
+    \
+    /* resize the items count, the new items are not inited */ \
+    static __tb_inline__ tb_bool_t prefix##_resize(prefix##_t* vector, tb_size_t size) \
+    { \
+        if (!prefix##_reserve(vector, size)) return tb_false; \
+        vector->size = size; \
+        return tb_true; \
+    } \
+    \
+    /* get the item at the given index */ \
+    static __tb_inline__ type prefix##_get(prefix##_t const* vector, tb_size_t index) \
+    { \
+        tb_assert(index < vector->size); \
+        return vector->data[index]; \
+    } \
+    \
+    /* set the item at the given index */ \
+    static __tb_inline__ tb_void_t prefix##_set(prefix##_t* vector, tb_size_t index, type value) \
+    { \
+        tb_assert(index < vector->size); \
+        vector->data[index] = value; \
+    } \
+    \
+    /* the last item */ \
+    static __tb_inline__ type prefix##_last(prefix##_t const* vector) \
+    { \
+        tb_assert(vector->size); \
+        return vector->data[vector->size - 1]; \
+    } \
+    \
+    /* insert the item to the tail */ \
+    static __tb_inline__ tb_bool_t prefix##_insert_tail(prefix##_t* vector, type value) \
+    { \
+        if (vector->size >= vector->maxn && !prefix##_reserve(vector, vector->size + 1)) return tb_false; \
+        vector->data[vector->size++] = value; \
+        return tb_true; \
+    } \
+    \
+    /* insert the item before the given index */ \
+    static __tb_inline__ tb_bool_t prefix##_insert_prev(prefix##_t* vector, tb_size_t index, type value) \
+    { \
+        tb_assert_and_check_return_val(index <= vector->size, tb_false); \
+        if (vector->size >= vector->maxn && !prefix##_reserve(vector, vector->size + 1)) return tb_false; \
+        if (index < vector->size) tb_memmov(vector->data + index + 1, vector->data + index, (vector->size - index) * sizeof(type)); \
+        vector->data[index] = value; \
+        vector->size++; \
+        return tb_true; \
+    } \
+    \
+    /* remove the last item */ \
+    static __tb_inline__ tb_void_t prefix##_remove_last(prefix##_t* vector) \
+    { \
+        if (vector->size) vector->size--; \
+    } \
+    \
+    /* remove the item at the given index */ \
+    static __tb_inline__ tb_void_t prefix##_remove(prefix##_t* vector, tb_size_t index) \
+    { \
+        tb_assert_and_check_return(index < vector->size); \
+        if (index + 1 < vector->size) tb_memmov(vector->data + index, vector->data + index + 1, (vector->size - index - 1) * sizeof(type)); \
+        vector->size--; \
+    } \
+    \
+    /* find the index of the item, return the items count if not found */ \
+    static __tb_inline__ tb_size_t prefix##_find(prefix##_t const* vector, type value) \
+    { \
+        tb_size_t i = 0; \
+        tb_size_t n = vector->size; \
+        type const* data = vector->data; \
+        for (i = 0; i < n; i++) \
+        { \
+            if (equal(data[i], value)) break; \
+        } \
+        return i; \
+    }
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
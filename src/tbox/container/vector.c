@@ -84,6 +84,9 @@ typedef struct __tb_vector_t
     // the element
     tb_element_t            element;
 
+    // the allocator
+    tb_allocator_ref_t      allocator;
+
 }tb_vector_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -187,6 +190,10 @@ static tb_void_t tb_vector_itor_remove_range(tb_iterator_ref_t iterator, tb_size
  * implementation
  */
 tb_vector_ref_t tb_vector_init(tb_size_t grow, tb_element_t element)
+{
+    return tb_vector_init_with_allocator(tb_null, grow, element);
+}
+tb_vector_ref_t tb_vector_init_with_allocator(tb_allocator_ref_t allocator, tb_size_t grow, tb_element_t element)
 {
     // check
     tb_assert_and_check_return_val(element.size && element.data && element.dupl && element.repl && element.ndupl && element.nrepl, tb_null);
@@ -196,13 +203,23 @@ tb_vector_ref_t tb_vector_init(tb_size_t grow, tb_element_t element)
     tb_vector_t*    vector = tb_null;
     do
     {
+        // duplicate the element data (e.g. string) to the given allocator
+        if (allocator && !element.allocator) element.allocator = allocator;
+
+        // no allocator? uses the global allocator
+        if (!allocator) allocator = tb_allocator();
+        tb_assert_and_check_break(allocator);
+
         // using the default grow
         if (!grow) grow = TB_VECTOR_GROW;
 
         // make vector
-        vector = tb_malloc0_type(tb_vector_t);
+        vector = (tb_vector_t*)tb_allocator_malloc0(allocator, sizeof(tb_vector_t));
         tb_assert_and_check_break(vector);
 
+        // init allocator
+        vector->allocator = allocator;
+
         // init vector
         vector->size      = 0;
         vector->grow      = grow;
@@ -227,7 +244,7 @@ tb_vector_ref_t tb_vector_init(tb_size_t grow, tb_element_t element)
         vector->itor.remove_range = tb_vector_itor_remove_range;
 
         // make data
-        vector->data = (tb_byte_t*)tb_nalloc0(vector->maxn, element.size);
+        vector->data = (tb_byte_t*)tb_allocator_nalloc0(vector->allocator, vector->maxn, element.size);
         tb_assert_and_check_break(vector->data);
 
         // ok
@@ -256,11 +273,11 @@ tb_void_t tb_vector_exit(tb_vector_ref_t self)
     tb_vector_clear(self);
 
     // free data
-    if (vector->data) tb_free(vector->data);
+    if (vector->data) tb_allocator_free(vector->allocator, vector->data);
     vector->data = tb_null;
 
     // free it
-    tb_free(vector);
+    tb_allocator_free(vector->allocator, vector);
 }
 tb_void_t tb_vector_clear(tb_vector_ref_t self)
 {
@@ -372,7 +389,7 @@ tb_bool_t tb_vector_resize(tb_vector_ref_t self, tb_size_t size)
         tb_assert_and_check_return_val(maxn < TB_VECTOR_MAXN, tb_false);
 
         // realloc data
-        vector->data = (tb_byte_t*)tb_ralloc(vector->data, maxn * vector->element.size);
+        vector->data = (tb_byte_t*)tb_allocator_ralloc(vector->allocator, vector->data, maxn * vector->element.size);
         tb_assert_and_check_return_val(vector->data, tb_false);
 
         // must be align by 4-bytes
@@ -119,6 +119,18 @@ typedef tb_iterator_ref_t tb_vector_ref_t;
  */
 tb_vector_ref_t     tb_vector_init(tb_size_t grow, tb_element_t element);
 
+/*! init vector with the given allocator
+ *
+ * the vector, items and the duplicated element data (e.g. string) will be allocated from this allocator
+ *
+ * @param allocator the allocator, uses the global allocator if be null
+ * @param grow      the item grow
+ * @param element   the element
+ *
+ * @return          the vector
+ */
+tb_vector_ref_t     tb_vector_init_with_allocator(tb_allocator_ref_t allocator, tb_size_t grow, tb_element_t element);
+
 /*! exist vector
  *
  * @param vector    the vector
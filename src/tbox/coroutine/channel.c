@@ -37,6 +37,14 @@
 #include "coroutine.h"
 #include "scheduler.h"
 #include "impl/impl.h"
+#include "../math/random/random.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the waiters count on the stack for select, we need allocate them if be larger
+#define TB_CO_CHANNEL_SELECT_STACK_MAXN         (4)
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
@@ -78,283 +86,277 @@ typedef struct __tb_co_channel_t
     tb_cpointer_t                   priv;
 
     // the waiting send coroutines 
-    tb_single_list_entry_head_t     waiting_send;
+    tb_list_entry_head_t            waiting_send;
 
     // the waiting recv coroutines 
-    tb_single_list_entry_head_t     waiting_recv;
+    tb_list_entry_head_t            waiting_recv;
 
 }tb_co_channel_t;
 
-/* //////////////////////////////////////////////////////////////////////////////////////
- * private implementation
+/* the channel waiter type
+ *
+ * it is placed on the stack of the waiting coroutine
+ * and it will be inserted to the waiting send or recv coroutines of channel
  */
-static tb_bool_t tb_co_channel_send_resume(tb_co_channel_t* channel, tb_pointer_t* pdata)
+typedef struct __tb_co_channel_waiter_t
 {
-    // check
-    tb_assert(channel);
+    // the list entry
+    tb_list_entry_t                 entry;
 
-    // resume the first waiting send coroutine and recv data
-    tb_bool_t ok = tb_false;
-    if (tb_single_list_entry_size(&channel->waiting_send))
-    {
-        // get the next entry from head
-        tb_single_list_entry_ref_t entry = tb_single_list_entry_head(&channel->waiting_send);
-        tb_assert(entry);
+    // the channel
+    tb_co_channel_t*                channel;
 
-        // remove it from the waiting send coroutines
-        tb_single_list_entry_remove_head(&channel->waiting_send);
+    // the wait
+    struct __tb_co_channel_wait_t*  wait;
 
-        // get the waiting send coroutine
-        tb_coroutine_ref_t waiting = (tb_coroutine_ref_t)tb_single_list_entry(&channel->waiting_send, entry);
+    // the sent data or the received data
+    tb_cpointer_t                   data;
 
-        // resume this coroutine and recv data
-        tb_pointer_t data = tb_coroutine_resume(waiting, tb_null);
+    // is send waiter?
+    tb_uint16_t                     is_send : 1;
 
-        // save data
-        if (pdata) *pdata = data;
+    // is waiting now?
+    tb_uint16_t                     waiting : 1;
 
-        // ok
-        ok = tb_true;
-    }
+}tb_co_channel_waiter_t;
 
-    // ok?
-    return ok;
-}
-static tb_void_t tb_co_channel_recv_resume(tb_co_channel_t* channel)
+/* the channel wait type
+ *
+ * all waiters of the suspended coroutine are woken up once at the same time
+ */
+typedef struct __tb_co_channel_wait_t
 {
-    // check
-    tb_assert(channel);
+    // the waiting coroutine
+    tb_coroutine_ref_t              coroutine;
 
-    // resume the first waiting recv coroutine 
-    if (tb_single_list_entry_size(&channel->waiting_recv))
-    {
-        // get the next entry from head
-        tb_single_list_entry_ref_t entry = tb_single_list_entry_head(&channel->waiting_recv);
-        tb_assert(entry);
+    // the waiters
+    tb_co_channel_waiter_t*         waiters;
 
-        // remove it from the waiting recv coroutines
-        tb_single_list_entry_remove_head(&channel->waiting_recv);
+    // the waiters count
+    tb_size_t                       count;
 
-        // get the waiting recv coroutine
-        tb_coroutine_ref_t waiting = (tb_coroutine_ref_t)tb_single_list_entry(&channel->waiting_recv, entry);
+    // the ready waiter index, -1: not ready
+    tb_long_t                       ready;
 
-        // resume this coroutine 
-        tb_coroutine_resume(waiting, tb_null);
-    }
+    // the embedded timer task
+    tb_co_timer_wheel_task_t        task;
+
+}tb_co_channel_wait_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_list_entry_head_ref_t tb_co_channel_waiting(tb_co_channel_waiter_t* waiter)
+{
+    return waiter->is_send? &waiter->channel->waiting_send : &waiter->channel->waiting_recv;
 }
-static tb_void_t tb_co_channel_send_suspend(tb_co_channel_t* channel, tb_cpointer_t data)
+static tb_void_t tb_co_channel_wait_cancel(tb_co_channel_wait_t* wait)
 {
     // check
-    tb_assert(channel);
-
-    // get the running coroutine 
-    tb_coroutine_t* running = (tb_coroutine_t*)tb_coroutine_self();
-    tb_assert(running);
-
-    // save this coroutine to the waiting send coroutines
-    tb_single_list_entry_insert_tail(&channel->waiting_send, &running->rs.single_entry);
+    tb_assert(wait);
 
-    // send data and wait it
-    tb_coroutine_suspend(data);
+    // remove all waiters from the waiting coroutines of channels
+    tb_size_t i = 0;
+    for (i = 0; i < wait->count; i++)
+    {
+        tb_co_channel_waiter_t* waiter = &wait->waiters[i];
+        if (waiter->waiting)
+        {
+            tb_list_entry_remove(tb_co_channel_waiting(waiter), &waiter->entry);
+            waiter->waiting = 0;
+        }
+    }
 }
-static tb_void_t tb_co_channel_recv_suspend(tb_co_channel_t* channel)
+static tb_void_t tb_co_channel_wait_done(tb_co_channel_waiter_t* waiter)
 {
     // check
-    tb_assert(channel);
+    tb_co_channel_wait_t* wait = waiter->wait;
+    tb_assert(wait && wait->ready < 0 && waiter->waiting);
 
-    // get the running coroutine 
-    tb_coroutine_t* running = (tb_coroutine_t*)tb_coroutine_self();
-    tb_assert(running);
+    // trace
+    tb_trace_d("coroutine(%p): %s ready", wait->coroutine, waiter->is_send? "send" : "recv");
 
-    // save this coroutine to the waiting recv coroutines
-    tb_single_list_entry_insert_tail(&channel->waiting_recv, &running->rs.single_entry);
+    // cancel all waiters, we only wake up it once
+    tb_co_channel_wait_cancel(wait);
 
-    // wait data
-    tb_coroutine_suspend(tb_null);
+    // save the ready waiter
+    wait->ready = waiter - wait->waiters;
+
+    // resume this coroutine 
+    tb_coroutine_resume(wait->coroutine, tb_null);
 }
-static tb_void_t tb_co_channel_send_buffer(tb_co_channel_t* channel, tb_cpointer_t data)
+static tb_void_t tb_co_channel_wait_timeout(tb_bool_t killed, tb_cpointer_t priv)
 {
     // check
-    tb_assert_and_check_return(channel && channel->queue.data);
+    tb_co_channel_wait_t* wait = (tb_co_channel_wait_t*)priv;
+    tb_assert(wait);
 
-    // done
-    do
-    {
-        // put data into queue if be not full
-        if (channel->queue.size + 1 < channel->queue.maxn)
-        {
-            // trace
-            tb_trace_d("send[%p]: put data(%p)", tb_coroutine_self(), data);
+    // trace
+    tb_trace_d("coroutine(%p): wait %s", wait->coroutine, killed? "killed" : "timeout");
 
-            // put data
-            channel->queue.data[channel->queue.tail] = data;
-            channel->queue.tail = (channel->queue.tail + 1) % channel->queue.maxn;
-            channel->queue.size++;
+    // cancel all waiters and resume this coroutine if not ready
+    if (wait->ready < 0)
+    {
+        tb_co_channel_wait_cancel(wait);
+        tb_coroutine_resume(wait->coroutine, tb_null);
+    }
+}
+static tb_long_t tb_co_channel_wait(tb_co_channel_wait_t* wait, tb_long_t timeout)
+{
+    // check
+    tb_assert(wait && wait->waiters && wait->count);
 
-            // notify to recv data
-            tb_co_channel_recv_resume(channel);
+    // init wait
+    wait->coroutine = tb_coroutine_self();
+    wait->ready     = -1;
+    tb_assert(wait->coroutine);
 
-            // send ok
-            break;
-        }
-        // wait it if be full
-        else
-        {
-            // trace
-            tb_trace_d("send[%p]: wait ..", tb_coroutine_self());
+    // init the timer task, it is not pending now
+    wait->task.entry.next = tb_null;
+    wait->task.entry.prev = tb_null;
 
-            // wait send
-            tb_co_channel_send_suspend(channel, tb_null);
- 
-            // trace
-            tb_trace_d("send[%p]: wait ok", tb_coroutine_self());
-        }
+    // exists timeout?
+    tb_co_scheduler_io_ref_t scheduler_io = tb_null;
+    if (timeout >= 0)
+    {
+        // get the io scheduler
+        scheduler_io = tb_co_scheduler_io_need((tb_co_scheduler_t*)tb_co_scheduler_self());
+        tb_assert_and_check_return_val(scheduler_io, -1);
 
-    } while (1);
- 
-    // trace
-    tb_trace_d("send[%p]: ok", tb_coroutine_self());
-}
-static tb_pointer_t tb_co_channel_recv_buffer(tb_co_channel_t* channel)
-{
-    // check
-    tb_assert_and_check_return_val(channel && channel->queue.data, tb_null);
+        // post the timer task
+        tb_co_scheduler_io_timer_post(scheduler_io, &wait->task, timeout, tb_co_channel_wait_timeout, wait);
+    }
 
-    // done
-    tb_pointer_t data = tb_null;
-    do
+    // insert all waiters to the waiting coroutines of channels
+    tb_size_t i = 0;
+    for (i = 0; i < wait->count; i++)
     {
-        // recv data from channel if be not null
-        if (channel->queue.size)
+        tb_co_channel_waiter_t* waiter = &wait->waiters[i];
+        if (waiter->channel)
         {
-            // get data
-            data = (tb_pointer_t)channel->queue.data[channel->queue.head];
+            waiter->wait    = wait;
+            waiter->waiting = 1;
+            tb_list_entry_insert_tail(tb_co_channel_waiting(waiter), &waiter->entry);
+        }
+    }
 
-            // pop data
-            channel->queue.head = (channel->queue.head + 1) % channel->queue.maxn;
-            channel->queue.size--;
+    // suspend the current coroutine
+    tb_coroutine_suspend(tb_null);
 
-            // trace
-            tb_trace_d("recv[%p]: get data(%p)", tb_coroutine_self(), data);
+    // cancel all waiters if this scheduler have been stopped
+    tb_co_channel_wait_cancel(wait);
 
-            // notify to send data
-            tb_co_channel_send_resume(channel, tb_null);
+    // cancel the timer task if it is still pending
+    if (scheduler_io) tb_co_scheduler_io_timer_exit(scheduler_io, &wait->task);
 
-            // recv ok
-            break;
-        }
-        // wait it if be null
-        else
-        {
-            // trace
-            tb_trace_d("recv[%p]: wait ..", tb_coroutine_self());
+    // ok?
+    return wait->ready;
+}
+static __tb_inline__ tb_co_channel_waiter_t* tb_co_channel_waiter_head(tb_list_entry_head_ref_t waiting)
+{
+    return tb_list_entry_size(waiting)? (tb_co_channel_waiter_t*)tb_list_entry(waiting, tb_list_entry_head(waiting)) : tb_null;
+}
+static tb_void_t tb_co_channel_queue_put(tb_co_channel_t* channel, tb_cpointer_t data)
+{
+    // check
+    tb_assert(channel->queue.data && channel->queue.size + 1 < channel->queue.maxn);
 
-            // wait recv
-            tb_co_channel_recv_suspend(channel);
+    // put data
+    channel->queue.data[channel->queue.tail] = data;
+    channel->queue.tail = (channel->queue.tail + 1) % channel->queue.maxn;
+    channel->queue.size++;
+}
+static tb_pointer_t tb_co_channel_queue_get(tb_co_channel_t* channel)
+{
+    // check
+    tb_assert(channel->queue.data && channel->queue.size);
 
-            // trace
-            tb_trace_d("recv[%p]: wait ok", tb_coroutine_self());
-        }
+    // get data
+    tb_pointer_t data = (tb_pointer_t)channel->queue.data[channel->queue.head];
 
-    } while (1);
- 
-    // trace
-    tb_trace_d("recv[%p]: ok", tb_coroutine_self());
+    // pop data
+    channel->queue.head = (channel->queue.head + 1) % channel->queue.maxn;
+    channel->queue.size--;
 
-    // get data
+    // ok
     return data;
 }
-static tb_bool_t tb_co_channel_send_buffer_try(tb_co_channel_t* channel, tb_cpointer_t data)
+static tb_bool_t tb_co_channel_send_ready(tb_co_channel_t* channel, tb_cpointer_t data)
 {
     // check
-    tb_assert_and_check_return_val(channel && channel->queue.data, tb_false);
+    tb_assert(channel);
+
+    // pass data to the first waiting recv coroutine directly
+    tb_co_channel_waiter_t* waiter = tb_co_channel_waiter_head(&channel->waiting_recv);
+    if (waiter)
+    {
+        // trace
+        tb_trace_d("send[%p]: pass data(%p) to coroutine(%p)", tb_coroutine_self(), data, waiter->wait->coroutine);
+
+        // pass data
+        waiter->data = data;
+
+        // wake up this recv coroutine
+        tb_co_channel_wait_done(waiter);
+        return tb_true;
+    }
 
     // put data into queue if be not full
-    if (channel->queue.size + 1 < channel->queue.maxn)
+    if (channel->queue.data && channel->queue.size + 1 < channel->queue.maxn)
     {
         // trace
         tb_trace_d("send[%p]: put data(%p)", tb_coroutine_self(), data);
 
         // put data
-        channel->queue.data[channel->queue.tail] = data;
-        channel->queue.tail = (channel->queue.tail + 1) % channel->queue.maxn;
-        channel->queue.size++;
-
-        // notify to recv data
-        tb_co_channel_recv_resume(channel);
-
-        // send ok
+        tb_co_channel_queue_put(channel, data);
         return tb_true;
     }
 
-    // failed
+    // not ready
     return tb_false;
 }
-static tb_bool_t tb_co_channel_recv_buffer_try(tb_co_channel_t* channel, tb_pointer_t* pdata)
+static tb_bool_t tb_co_channel_recv_ready(tb_co_channel_t* channel, tb_pointer_t* pdata)
 {
     // check
-    tb_assert_and_check_return_val(channel && channel->queue.data && pdata, tb_false);
+    tb_assert(channel && pdata);
 
-    // recv data from channel if be not null
-    if (channel->queue.size)
+    // the first waiting send coroutine
+    tb_co_channel_waiter_t* waiter = tb_co_channel_waiter_head(&channel->waiting_send);
+
+    // recv data from queue if be not null
+    if (channel->queue.data && channel->queue.size)
     {
         // get data
-        *pdata = (tb_pointer_t)channel->queue.data[channel->queue.head];
-
-        // pop data
-        channel->queue.head = (channel->queue.head + 1) % channel->queue.maxn;
-        channel->queue.size--;
+        *pdata = tb_co_channel_queue_get(channel);
 
         // trace
         tb_trace_d("recv[%p]: get data(%p)", tb_coroutine_self(), *pdata);
 
-        // notify to send data
-        tb_co_channel_send_resume(channel, tb_null);
-
-        // recv ok
+        // put the data of the first waiting send coroutine into queue and wake up it
+        if (waiter)
+        {
+            tb_co_channel_queue_put(channel, waiter->data);
+            tb_co_channel_wait_done(waiter);
+        }
         return tb_true;
     }
 
-    // failed
-    return tb_false;
-}
-static tb_void_t tb_co_channel_send_buffer0(tb_co_channel_t* channel, tb_cpointer_t data)
-{
-    // check
-    tb_assert(channel);
-
-    // resume one waiting recv coroutine 
-    tb_co_channel_recv_resume(channel);
-
-    // send data and wait it
-    tb_co_channel_send_suspend(channel, data);
-}
-static tb_pointer_t tb_co_channel_recv_buffer0(tb_co_channel_t* channel)
-{
-    // check
-    tb_assert(channel);
-
-    // done
-    tb_pointer_t data = tb_null;
-    do
+    // take data from the first waiting send coroutine directly
+    if (waiter)
     {
-        // resume the first waiting send coroutine and recv data
-        if (tb_co_channel_send_resume(channel, &data))
-        {
-            // recv ok
-            break;
-        }
-        // no data?
-        else
-        {
-            // wait data
-            tb_co_channel_recv_suspend(channel);
-        }
+        // get data
+        *pdata = (tb_pointer_t)waiter->data;
 
-    } while (1);
+        // trace
+        tb_trace_d("recv[%p]: take data(%p) from coroutine(%p)", tb_coroutine_self(), *pdata, waiter->wait->coroutine);
 
-    // ok?
-    return data;
+        // wake up this send coroutine
+        tb_co_channel_wait_done(waiter);
+        return tb_true;
+    }
+
+    // not ready
+    return tb_false;
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -372,10 +374,10 @@ tb_co_channel_ref_t tb_co_channel_init(tb_size_t size, tb_co_channel_free_func_t
         tb_assert_and_check_break(channel);
 
         // init waiting send coroutines
-        tb_single_list_entry_init(&channel->waiting_send, tb_coroutine_t, rs.single_entry, tb_null);
+        tb_list_entry_init(&channel->waiting_send, tb_co_channel_waiter_t, entry, tb_null);
 
         // init waiting recv coroutines
-        tb_single_list_entry_init(&channel->waiting_recv, tb_coroutine_t, rs.single_entry, tb_null);
+        tb_list_entry_init(&channel->waiting_recv, tb_co_channel_waiter_t, entry, tb_null);
 
         // init free function and data
         channel->free = free;
@@ -437,12 +439,12 @@ tb_void_t tb_co_channel_exit(tb_co_channel_ref_t self)
     channel->queue.size = 0;
 
     // check waiting coroutines
-    tb_assert(!tb_single_list_entry_size(&channel->waiting_send));
-    tb_assert(!tb_single_list_entry_size(&channel->waiting_recv));
+    tb_assert(!tb_list_entry_size(&channel->waiting_send));
+    tb_assert(!tb_list_entry_size(&channel->waiting_recv));
 
     // exit waiting coroutines
-    tb_single_list_entry_exit(&channel->waiting_send);
-    tb_single_list_entry_exit(&channel->waiting_recv);
+    tb_list_entry_exit(&channel->waiting_send);
+    tb_list_entry_exit(&channel->waiting_recv);
 
     // exit the channel
     tb_free(channel);
@@ -453,9 +455,25 @@ tb_void_t tb_co_channel_send(tb_co_channel_ref_t self, tb_cpointer_t data)
     tb_co_channel_t* channel = (tb_co_channel_t*)self;
     tb_assert_and_check_return(channel);
 
-    // send it
-    if (channel->queue.data) tb_co_channel_send_buffer(channel, data);
-    else tb_co_channel_send_buffer0(channel, data);
+    // send it directly if be ready
+    tb_check_return(!tb_co_channel_send_ready(channel, data));
+
+    // trace
+    tb_trace_d("send[%p]: wait ..", tb_coroutine_self());
+
+    // wait send
+    tb_co_channel_waiter_t  waiter;
+    tb_co_channel_wait_t    wait;
+    waiter.channel  = channel;
+    waiter.data     = data;
+    waiter.is_send  = 1;
+    waiter.waiting  = 0;
+    wait.waiters    = &waiter;
+    wait.count      = 1;
+    tb_co_channel_wait(&wait, -1);
+ 
+    // trace
+    tb_trace_d("send[%p]: wait ok", tb_coroutine_self());
 }
 tb_pointer_t tb_co_channel_recv(tb_co_channel_ref_t self)
 {
@@ -463,8 +481,29 @@ tb_pointer_t tb_co_channel_recv(tb_co_channel_ref_t self)
     tb_co_channel_t* channel = (tb_co_channel_t*)self;
     tb_assert_and_check_return_val(channel, tb_null);
 
-    // recv it
-    return channel->queue.data? tb_co_channel_recv_buffer(channel) : tb_co_channel_recv_buffer0(channel);
+    // recv it directly if be ready
+    tb_pointer_t data = tb_null;
+    if (tb_co_channel_recv_ready(channel, &data)) return data;
+
+    // trace
+    tb_trace_d("recv[%p]: wait ..", tb_coroutine_self());
+
+    // wait recv
+    tb_co_channel_waiter_t  waiter;
+    tb_co_channel_wait_t    wait;
+    waiter.channel  = channel;
+    waiter.data     = tb_null;
+    waiter.is_send  = 0;
+    waiter.waiting  = 0;
+    wait.waiters    = &waiter;
+    wait.count      = 1;
+    tb_co_channel_wait(&wait, -1);
+
+    // trace
+    tb_trace_d("recv[%p]: wait ok, data(%p)", tb_coroutine_self(), waiter.data);
+
+    // get data
+    return (tb_pointer_t)waiter.data;
 }
 tb_bool_t tb_co_channel_send_try(tb_co_channel_ref_t self, tb_cpointer_t data)
 {
@@ -473,7 +512,7 @@ tb_bool_t tb_co_channel_send_try(tb_co_channel_ref_t self, tb_cpointer_t data)
     tb_assert_and_check_return_val(channel, tb_false);
 
     // try sending it
-    return channel->queue.data? tb_co_channel_send_buffer_try(channel, data) : tb_false;
+    return tb_co_channel_send_ready(channel, data);
 }
 tb_bool_t tb_co_channel_recv_try(tb_co_channel_ref_t self, tb_pointer_t* pdata)
 {
@@ -482,6 +521,68 @@ tb_bool_t tb_co_channel_recv_try(tb_co_channel_ref_t self, tb_pointer_t* pdata)
     tb_assert_and_check_return_val(channel && pdata, tb_false);
 
     // try recving it
-    return channel->queue.data? tb_co_channel_recv_buffer_try(channel, pdata) : tb_false;
+    return tb_co_channel_recv_ready(channel, pdata);
 }
+tb_long_t tb_co_channel_select(tb_co_channel_case_t* cases, tb_size_t count, tb_long_t timeout)
+{
+    // check
+    tb_assert_and_check_return_val(cases && count, -1);
 
+    // try all cases from a random start index first
+    tb_size_t i = 0;
+    tb_size_t start = count > 1? (tb_size_t)tb_random_range(0, count) : 0;
+    for (i = 0; i < count; i++)
+    {
+        // the case
+        tb_size_t               index = (start + i) % count;
+        tb_co_channel_case_t*   item = &cases[index];
+        tb_co_channel_t*        channel = (tb_co_channel_t*)item->channel;
+        tb_check_continue(channel);
+
+        // this case is ready?
+        if (item->type == TB_CO_CHANNEL_CASE_SEND)
+        {
+            if (tb_co_channel_send_ready(channel, item->data)) return index;
+        }
+        else if (tb_co_channel_recv_ready(channel, &item->data)) return index;
+    }
+
+    // no ready cases and no wait?
+    tb_check_return_val(timeout, -1);
+
+    // make waiters
+    tb_co_channel_waiter_t  waiters_stack[TB_CO_CHANNEL_SELECT_STACK_MAXN];
+    tb_co_channel_waiter_t* waiters = count <= TB_CO_CHANNEL_SELECT_STACK_MAXN? waiters_stack : tb_nalloc_type(count, tb_co_channel_waiter_t);
+    tb_assert_and_check_return_val(waiters, -1);
+
+    // init waiters
+    for (i = 0; i < count; i++)
+    {
+        tb_co_channel_waiter_t* waiter = &waiters[i];
+        waiter->channel = (tb_co_channel_t*)cases[i].channel;
+        waiter->data    = cases[i].type == TB_CO_CHANNEL_CASE_SEND? cases[i].data : tb_null;
+        waiter->is_send = cases[i].type == TB_CO_CHANNEL_CASE_SEND? 1 : 0;
+        waiter->waiting = 0;
+    }
+
+    // trace
+    tb_trace_d("select[%p]: wait %lu cases with %ld ms ..", tb_coroutine_self(), count, timeout);
+
+    // wait them
+    tb_co_channel_wait_t wait;
+    wait.waiters    = waiters;
+    wait.count      = count;
+    tb_long_t ready = tb_co_channel_wait(&wait, timeout);
+
+    // save the received data
+    if (ready >= 0 && !waiters[ready].is_send) cases[ready].data = (tb_pointer_t)waiters[ready].data;
+
+    // trace
+    tb_trace_d("select[%p]: wait ok, ready: %ld", tb_coroutine_self(), ready);
+
+    // free waiters
+    if (waiters != waiters_stack) tb_free(waiters);
+
+    // ok?
+    return ready;
+}
@@ -51,6 +51,28 @@ typedef __tb_typeref__(co_channel);
  */
 typedef tb_void_t       (*tb_co_channel_free_func_t)(tb_pointer_t data, tb_cpointer_t priv);
 
+/// the channel select case type enum
+typedef enum __tb_co_channel_case_type_e
+{
+    TB_CO_CHANNEL_CASE_RECV     = 0     //!< recv data from channel
+,   TB_CO_CHANNEL_CASE_SEND     = 1     //!< send data into channel
+
+}tb_co_channel_case_type_e;
+
+/// the channel select case type
+typedef struct __tb_co_channel_case_t
+{
+    /// the channel, this case will be ignored if be null
+    tb_co_channel_ref_t     channel;
+
+    /// the case type
+    tb_size_t               type;
+
+    /// the sent data for the send case or the received data for the recv case
+    tb_pointer_t            data;
+
+}tb_co_channel_case_t;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -90,9 +112,10 @@ tb_void_t               tb_co_channel_send(tb_co_channel_ref_t channel, tb_cpoin
  */
 tb_pointer_t            tb_co_channel_recv(tb_co_channel_ref_t channel);
 
-/*! try sending data into channel only with buffer
+/*! try sending data into channel
  *
- * the current coroutine will be suspend if this channel is full 
+ * the current coroutine will not be suspended, 
+ * it will fail if this channel is full and no waiting recv coroutines
  *
  * @param channel       the channel
  * @param data          the channel data
@@ -101,9 +124,10 @@ tb_pointer_t            tb_co_channel_recv(tb_co_channel_ref_t channel);
  */
 tb_bool_t               tb_co_channel_send_try(tb_co_channel_ref_t channel, tb_cpointer_t data);
 
-/*! try recving data from channel only with buffer
+/*! try recving data from channel
  *
- * the current coroutine will be suspend if no data
+ * the current coroutine will not be suspended, 
+ * it will fail if this channel is empty and no waiting send coroutines
  *
  * @param channel       the channel
  * @param pdata         the channel data pointer
@@ -112,6 +136,48 @@ tb_bool_t               tb_co_channel_send_try(tb_co_channel_ref_t channel, tb_c
  */
 tb_bool_t               tb_co_channel_recv_try(tb_co_channel_ref_t channel, tb_pointer_t* pdata);
 
+/*! select the first ready case from the multiple channels
+ *
+ * the current coroutine will be suspended on all channels until one of cases is ready or timeout,
+ * and only the returned case will be done, the others will not send or recv any data.
+ *
+ * the ready cases are selected from a random start index for fairness if more than one is ready.
+ *
+ * @code
+ 
+    tb_co_channel_case_t cases[3];
+    cases[0].channel    = data_channel;
+    cases[0].type       = TB_CO_CHANNEL_CASE_RECV;
+    cases[1].channel    = cancel_channel;
+    cases[1].type       = TB_CO_CHANNEL_CASE_RECV;
+    cases[2].channel    = result_channel;
+    cases[2].type       = TB_CO_CHANNEL_CASE_SEND;
+    cases[2].data       = result;
+    switch (tb_co_channel_select(cases, 3, 1000))
+    {
+    case 0: 
+        // handle cases[0].data
+        break;
+    case 1:
+        // cancelled
+        break;
+    case 2:
+        // the result have been sent
+        break;
+    default:
+        // timeout
+        break;
+    }
+ * @endcode
+ *
+ * @param cases         the select cases
+ * @param count         the cases count
+ * @param timeout       the timeout (ms), infinity: -1, 0: only try all cases without suspending
+ *
+ * @return              the index of the ready case, -1: timeout or killed
+ */
+tb_long_t               tb_co_channel_select(tb_co_channel_case_t* cases, tb_size_t count, tb_long_t timeout);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
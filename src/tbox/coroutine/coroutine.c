@@ -37,6 +37,116 @@
 #include "scheduler.h"
 #include "impl/impl.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the offloaded job type
+typedef struct __tb_coroutine_offload_t
+{
+    // the blocking function
+    tb_coroutine_offload_func_t     func;
+
+    // the user private data
+    tb_cpointer_t                   priv;
+
+    // the result
+    tb_pointer_t                    result;
+
+    // the waiting coroutine
+    tb_coroutine_t*                 coroutine;
+
+    // the lock
+    tb_spinlock_t                   lock;
+
+    // the reference count, it will be freed by the last one of coroutine and thread pool
+    tb_atomic_t                     refn;
+
+    // is the coroutine still waiting?
+    tb_bool_t                       waiting;
+
+}tb_coroutine_offload_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_void_t tb_coroutine_offload_finish(tb_coroutine_offload_t* offload)
+{
+    // check
+    tb_assert(offload);
+
+    /* wake up the waiting coroutine
+     *
+     * we need hold the lock while waking it up, 
+     * the coroutine will enter this lock again after resuming and then we can release it.
+     */
+    tb_spinlock_enter(&offload->lock);
+    if (offload->waiting)
+    {
+        tb_co_scheduler_wakeup((tb_co_scheduler_t*)tb_coroutine_scheduler(offload->coroutine), offload->coroutine);
+        offload->waiting = tb_false;
+    }
+    tb_spinlock_leave(&offload->lock);
+}
+static tb_void_t tb_coroutine_offload_exit(tb_coroutine_offload_t* offload)
+{
+    // check
+    tb_assert(offload);
+
+    // free it if it is the last reference
+    if (!tb_atomic_dec_and_fetch(&offload->refn))
+    {
+        tb_spinlock_exit(&offload->lock);
+        tb_free(offload);
+    }
+}
+static tb_void_t tb_coroutine_offload_task_done(tb_thread_pool_worker_ref_t worker, tb_cpointer_t priv)
+{
+    // check
+    tb_coroutine_offload_t* offload = (tb_coroutine_offload_t*)priv;
+    tb_assert_and_check_return(offload && offload->func);
+
+    // done the blocking function
+    offload->result = offload->func(offload->priv);
+
+    // resume the coroutine with the result
+    tb_coroutine_offload_finish(offload);
+}
+static tb_void_t tb_coroutine_offload_task_exit(tb_thread_pool_worker_ref_t worker, tb_cpointer_t priv)
+{
+    // check
+    tb_coroutine_offload_t* offload = (tb_coroutine_offload_t*)priv;
+    tb_assert_and_check_return(offload);
+
+    // resume the coroutine if this task have been killed before done
+    tb_coroutine_offload_finish(offload);
+
+    // exit it
+    tb_coroutine_offload_exit(offload);
+}
+static tb_long_t tb_coroutine_post(tb_poller_op_ref_t op, tb_size_t code, tb_handle_t ref, tb_byte_t* data, tb_size_t size, tb_hize_t offset, tb_long_t timeout)
+{
+    // get current scheduler
+    tb_co_scheduler_t* scheduler = (tb_co_scheduler_t*)tb_co_scheduler_self();
+    tb_check_return_val(scheduler, -1);
+
+    // get the io scheduler, only the completion-based poller supports it
+    tb_co_scheduler_io_ref_t scheduler_io = tb_co_scheduler_io_need(scheduler);
+    tb_check_return_val(scheduler_io && tb_poller_support(scheduler_io->poller, TB_POLLER_EVENT_COMP), -1);
+
+    // init operation
+    op->code    = code;
+    op->ref     = ref;
+    op->data    = data;
+    op->size    = size;
+    op->offset  = offset;
+    op->real    = -1;
+    op->priv    = tb_null;
+
+    // post it and wait it
+    return tb_co_scheduler_io_post(scheduler_io, op, timeout);
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -88,6 +198,130 @@ tb_long_t tb_coroutine_waitio(tb_socket_ref_t sock, tb_size_t events, tb_long_t
     // wait events
     return scheduler? tb_co_scheduler_wait(scheduler, sock, events, timeout) : -1;
 }
+tb_long_t tb_coroutine_recv(tb_socket_ref_t sock, tb_byte_t* data, tb_size_t size, tb_long_t timeout)
+{
+    // check
+    tb_assert_and_check_return_val(sock && data && size, -1);
+
+    // post the recv operation, the closed socket will be completed with zero
+    tb_poller_op_t  op;
+    tb_long_t       ok = tb_coroutine_post(&op, TB_POLLER_OP_CODE_RECV, (tb_handle_t)sock, data, size, 0, timeout);
+    if (ok >= 0) return ok? (op.real > 0? op.real : -1) : 0;
+
+    // recv it after waiting the recv event
+    tb_long_t real = 0;
+    tb_long_t wait = 0;
+    while (!(real = tb_socket_recv(sock, data, size)))
+    {
+        // no data after waiting the recv event? it has been closed
+        tb_check_return_val(!wait, -1);
+
+        // wait it
+        wait = tb_socket_wait(sock, TB_SOCKET_EVENT_RECV, timeout);
+        tb_check_return_val(wait > 0, wait);
+    }
+    return real;
+}
+tb_long_t tb_coroutine_send(tb_socket_ref_t sock, tb_byte_t const* data, tb_size_t size, tb_long_t timeout)
+{
+    // check
+    tb_assert_and_check_return_val(sock && data && size, -1);
+
+    // post the send operation
+    tb_poller_op_t  op;
+    tb_long_t       ok = tb_coroutine_post(&op, TB_POLLER_OP_CODE_SEND, (tb_handle_t)sock, (tb_byte_t*)data, size, 0, timeout);
+    if (ok >= 0) return ok? (op.real > 0? op.real : -1) : 0;
+
+    // send it after waiting the send event
+    tb_long_t real = 0;
+    tb_long_t wait = 0;
+    while (!(real = tb_socket_send(sock, data, size)))
+    {
+        // no data after waiting the send event? it has been closed
+        tb_check_return_val(!wait, -1);
+
+        // wait it
+        wait = tb_socket_wait(sock, TB_SOCKET_EVENT_SEND, timeout);
+        tb_check_return_val(wait > 0, wait);
+    }
+    return real;
+}
+tb_long_t tb_coroutine_pread(tb_file_ref_t file, tb_byte_t* data, tb_size_t size, tb_hize_t offset)
+{
+    // check
+    tb_assert_and_check_return_val(file && data, -1);
+
+    // post the read operation
+    tb_poller_op_t op;
+    if (size && tb_coroutine_post(&op, TB_POLLER_OP_CODE_READ, (tb_handle_t)file, data, size, offset, -1) > 0) 
+        return op.real;
+
+    // read it directly
+    return tb_file_pread(file, data, size, offset);
+}
+tb_long_t tb_coroutine_pwrit(tb_file_ref_t file, tb_byte_t const* data, tb_size_t size, tb_hize_t offset)
+{
+    // check
+    tb_assert_and_check_return_val(file && data, -1);
+
+    // post the write operation
+    tb_poller_op_t op;
+    if (size && tb_coroutine_post(&op, TB_POLLER_OP_CODE_WRITE, (tb_handle_t)file, (tb_byte_t*)data, size, offset, -1) > 0) 
+        return op.real;
+
+    // write it directly
+    return tb_file_pwrit(file, data, size, offset);
+}
+tb_pointer_t tb_coroutine_offload(tb_coroutine_offload_func_t func, tb_cpointer_t priv)
+{
+    // check
+    tb_assert_and_check_return_val(func, tb_null);
+
+    // get current scheduler, we need the io scheduler to wake up the coroutine from other threads
+    tb_co_scheduler_t* scheduler = (tb_co_scheduler_t*)tb_co_scheduler_self();
+    if (!scheduler || !tb_co_scheduler_io_need(scheduler)) return func(priv);
+
+    // init the offloaded job
+    tb_coroutine_offload_t* offload = tb_malloc0_type(tb_coroutine_offload_t);
+    tb_assert_and_check_return_val(offload, tb_null);
+
+    // the coroutine and the thread pool will refer to it
+    offload->func       = func;
+    offload->priv       = priv;
+    offload->coroutine  = tb_co_scheduler_running(scheduler);
+    offload->waiting    = tb_true;
+    tb_atomic_set(&offload->refn, 2);
+    tb_spinlock_init(&offload->lock);
+
+    // post it to the thread pool
+    if (!tb_thread_pool_task_post(tb_thread_pool(), "offload", tb_coroutine_offload_task_done, tb_coroutine_offload_task_exit, offload, tb_false))
+    {
+        // trace
+        tb_trace_e("post offloaded job failed, call it directly!");
+
+        // exit it
+        tb_spinlock_exit(&offload->lock);
+        tb_free(offload);
+
+        // call it directly
+        return func(priv);
+    }
+
+    // wait the result, it will be returned directly if the scheduler have been stopped
+    tb_co_scheduler_suspend(scheduler, tb_null);
+
+    // take the result and stop waiting, the thread pool will not access this coroutine after it
+    tb_spinlock_enter(&offload->lock);
+    tb_pointer_t result = offload->waiting? tb_null : offload->result;
+    offload->waiting = tb_false;
+    tb_spinlock_leave(&offload->lock);
+
+    // exit it
+    tb_coroutine_offload_exit(offload);
+
+    // ok
+    return result;
+}
 tb_coroutine_ref_t tb_coroutine_self()
 {
     // get coroutine
@@ -32,7 +32,9 @@
 #include "lock.h"
 #include "channel.h"
 #include "semaphore.h"
+#include "thread_channel.h"
 #include "scheduler.h"
+#include "scheduler_group.h"
 #include "stackless/stackless.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -50,6 +52,9 @@ typedef __tb_typeref__(coroutine);
 /// the coroutine function type
 typedef tb_void_t       (*tb_coroutine_func_t)(tb_cpointer_t priv);
 
+/// the offloaded blocking function type, it will be run on the thread pool
+typedef tb_pointer_t    (*tb_coroutine_offload_func_t)(tb_cpointer_t priv);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -106,6 +111,87 @@ tb_pointer_t            tb_coroutine_sleep(tb_long_t interval);
  */
 tb_long_t               tb_coroutine_waitio(tb_socket_ref_t sock, tb_size_t events, tb_long_t timeout);
 
+/*! recv data from the socket 
+ *
+ * it will post the recv operation to the completion-based poller (e.g. io_uring) and wait it to be completed,
+ * so we need not recv it again after waiting the recv event. 
+ * otherwise, it will wait the recv event and recv it.
+ *
+ * @param sock          the socket
+ * @param data          the data
+ * @param size          the size
+ * @param timeout       the timeout, infinity: -1
+ *
+ * @return              > 0: the real size, 0: timeout, -1: failed or closed
+ */
+tb_long_t               tb_coroutine_recv(tb_socket_ref_t sock, tb_byte_t* data, tb_size_t size, tb_long_t timeout);
+
+/*! send data to the socket, it will post the send operation to the completion-based poller if be supported
+ *
+ * @param sock          the socket
+ * @param data          the data
+ * @param size          the size
+ * @param timeout       the timeout, infinity: -1
+ *
+ * @return              > 0: the real size, 0: timeout, -1: failed
+ */
+tb_long_t               tb_coroutine_send(tb_socket_ref_t sock, tb_byte_t const* data, tb_size_t size, tb_long_t timeout);
+
+/*! read the file data at the given offset
+ *
+ * it will post the read operation to the completion-based poller if be supported, 
+ * so the other coroutines will continue to run before it is completed.
+ * otherwise, it will call tb_file_pread() directly.
+ *
+ * @param file          the file
+ * @param data          the data
+ * @param size          the size
+ * @param offset        the offset
+ *
+ * @return              the real size or -1
+ */
+tb_long_t               tb_coroutine_pread(tb_file_ref_t file, tb_byte_t* data, tb_size_t size, tb_hize_t offset);
+
+/*! write the file data at the given offset, it will post the write operation to the completion-based poller if be supported
+ *
+ * @param file          the file
+ * @param data          the data
+ * @param size          the size
+ * @param offset        the offset
+ *
+ * @return              the real size or -1
+ */
+tb_long_t               tb_coroutine_pwrit(tb_file_ref_t file, tb_byte_t const* data, tb_size_t size, tb_hize_t offset);
+
+/*! run the blocking function on the thread pool and wait the result
+ *
+ * the current coroutine will be suspended and the other coroutines will continue to run,
+ * it will be resumed in the io loop with the result after the function have been finished.
+ *
+ * the finished functions of the same scheduler only spak it's poller once, 
+ * and all of them will be resumed together in the next loop.
+ *
+ * @note it will call the function directly if be not in coroutine
+ *
+ * @code
+
+    static tb_pointer_t file_info_func(tb_cpointer_t priv)
+    {
+        tb_file_info_t info;
+        return tb_file_info((tb_char_t const*)priv, &info)? (tb_pointer_t)(tb_size_t)info.size : tb_null;
+    }
+
+    // get the file size in coroutine
+    tb_size_t size = (tb_size_t)tb_coroutine_offload(file_info_func, "/tmp/file");
+ * @endcode
+ *
+ * @param func          the blocking function
+ * @param priv          the user private data as the argument of function
+ *
+ * @return              the return value of function, tb_null if it have been killed
+ */
+tb_pointer_t            tb_coroutine_offload(tb_coroutine_offload_func_t func, tb_cpointer_t priv);
+
 /*! get the current coroutine
  *
  * @return              the current coroutine
@@ -35,6 +35,7 @@
  */
 #include "coroutine.h"
 #include "scheduler.h"
+#include "stack_pool.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -43,11 +44,14 @@
 // the stack guard magic
 #define TB_COROUTINE_STACK_GUARD            (0xbeef)
 
-// the default stack size
+// the default stack size (include the coroutine header)
 #define TB_COROUTINE_STACK_DEFSIZE          (8192 << 1)
 
+// the aligned coroutine header size at the top of stack
+#define TB_COROUTINE_HEADSIZE               tb_align(sizeof(tb_coroutine_t), 16)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
- * implementation
+ * private implementation
  */
 static tb_void_t tb_coroutine_entry(tb_context_from_t from)
 {
@@ -86,6 +90,28 @@ static tb_void_t tb_coroutine_entry(tb_context_from_t from)
     tb_co_scheduler_finish((tb_co_scheduler_t*)tb_co_scheduler_self());
 }
 
+static tb_bool_t tb_coroutine_stack_make(tb_coroutine_t* coroutine, tb_coroutine_func_t func, tb_cpointer_t priv)
+{
+    // check
+    tb_assert(coroutine && coroutine->stackbase && coroutine->stacksize);
+
+#ifdef __tb_debug__
+    // fill the magic at the stack bottom
+    tb_bits_set_u16_ne(coroutine->stackbase - coroutine->stacksize, TB_COROUTINE_STACK_GUARD);
+#endif
+
+    // init function and user private data
+    coroutine->rs.func.func = func;
+    coroutine->rs.func.priv = priv;
+
+    // make context
+    coroutine->context = tb_context_make(coroutine->stackbase - coroutine->stacksize, coroutine->stacksize, tb_coroutine_entry);
+    tb_assert_and_check_return_val(coroutine->context, tb_false);
+
+    // ok
+    return tb_true;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -107,37 +133,38 @@ tb_coroutine_t* tb_coroutine_init(tb_co_scheduler_ref_t scheduler, tb_coroutine_
         stacksize <<= 1;
 #endif
 
-        /* make coroutine
-         *
-         * TODO: 
-         *
-         * - segment stack 
+        // get the stack pool
+        tb_co_stack_pool_ref_t stack_pool = tb_co_stack_pool();
+        tb_assert_and_check_break(stack_pool);
+
+        // align the stack size to the size class of the stack pool
+        stacksize = tb_co_stack_pool_align(stack_pool, stacksize);
+        tb_assert_and_check_break(stacksize > TB_COROUTINE_HEADSIZE);
+
+        /* make stack from the stack pool and place the coroutine at the top of stack
          *
-         *  -----------------------------------------------
-         * | coroutine | guard | ... stacksize ... | guard |
-         *  -----------------------------------------------
+         *  -----------------------------------------------------
+         * | guard page | ...... stacksize ...... | coroutine |
+         *  -----------------------------------------------------
+         *              |                         |
+         *          stack bottom              stackbase
          */
-        coroutine = (tb_coroutine_t*)tb_malloc_bytes(sizeof(tb_coroutine_t) + stacksize + sizeof(tb_uint16_t));
-        tb_assert_and_check_break(coroutine);
+        tb_byte_t* stack = tb_co_stack_pool_malloc(stack_pool, stacksize);
+        tb_assert_and_check_break(stack);
+
+        // make coroutine
+        coroutine = (tb_coroutine_t*)(stack + stacksize - TB_COROUTINE_HEADSIZE);
+        tb_memset(coroutine, 0, sizeof(tb_coroutine_t));
 
         // save scheduler
         coroutine->scheduler = scheduler;
 
         // init stack
-        coroutine->stackbase = (tb_byte_t*)&(coroutine[1]) + stacksize;
-        coroutine->stacksize = stacksize;
-
-        // fill guard
-        coroutine->guard = TB_COROUTINE_STACK_GUARD;
-        tb_bits_set_u16_ne(coroutine->stackbase, TB_COROUTINE_STACK_GUARD);
-
-        // init function and user private data
-        coroutine->rs.func.func = func;
-        coroutine->rs.func.priv = priv;
+        coroutine->stackbase = (tb_byte_t*)coroutine;
+        coroutine->stacksize = stacksize - TB_COROUTINE_HEADSIZE;
 
-        // make context
-        coroutine->context = tb_context_make(coroutine->stackbase - stacksize, stacksize, tb_coroutine_entry);
-        tb_assert_and_check_break(coroutine->context);
+        // make stack context
+        if (!tb_coroutine_stack_make(coroutine, func, priv)) break;
 
         // ok
         ok = tb_true;
@@ -147,8 +174,8 @@ tb_coroutine_t* tb_coroutine_init(tb_co_scheduler_ref_t scheduler, tb_coroutine_
     // failed?
     if (!ok)
     {
-        // exit it
-        if (coroutine) tb_coroutine_exit(coroutine); 
+        // free the stack and coroutine
+        if (coroutine) tb_co_stack_pool_free(tb_co_stack_pool(), coroutine->stackbase - coroutine->stacksize, coroutine->stacksize + TB_COROUTINE_HEADSIZE);
         coroutine = tb_null;
     }
 
@@ -164,7 +191,8 @@ tb_coroutine_t* tb_coroutine_reinit(tb_coroutine_t* coroutine, tb_coroutine_func
     tb_assert_and_check_return_val(coroutine && func, tb_null);
 
     // done
-    tb_bool_t ok = tb_false;
+    tb_bool_t               ok = tb_false;
+    tb_co_stack_pool_ref_t  stack_pool = tb_null;
     do
     {
         // init stack size
@@ -178,35 +206,51 @@ tb_coroutine_t* tb_coroutine_reinit(tb_coroutine_t* coroutine, tb_coroutine_func
         tb_coroutine_check(coroutine);
 #endif
 
-        // remake coroutine
-        if (stacksize > coroutine->stacksize)
-            coroutine = (tb_coroutine_t*)tb_ralloc_bytes(coroutine, sizeof(tb_coroutine_t) + stacksize + sizeof(tb_uint16_t));
-        else stacksize = coroutine->stacksize;
-        tb_assert_and_check_break(coroutine && coroutine->scheduler);
+        // align the stack size to the size class of the stack pool
+        stack_pool = tb_co_stack_pool();
+        tb_assert_and_check_break(stack_pool);
+        stacksize = tb_co_stack_pool_align(stack_pool, stacksize);
 
-        // init stack
-        coroutine->stackbase = (tb_byte_t*)&(coroutine[1]) + stacksize;
-        coroutine->stacksize = stacksize;
+        // the stack size class has been changed? remake it
+        if (stacksize != coroutine->stacksize + TB_COROUTINE_HEADSIZE)
+        {
+            // save scheduler
+            tb_co_scheduler_ref_t scheduler = coroutine->scheduler;
+
+            // free the old stack
+            tb_co_stack_pool_free(stack_pool, coroutine->stackbase - coroutine->stacksize, coroutine->stacksize + TB_COROUTINE_HEADSIZE);
+            coroutine = tb_null;
+
+            // make a new stack
+            tb_byte_t* stack = tb_co_stack_pool_malloc(stack_pool, stacksize);
+            tb_assert_and_check_break(stack);
 
-        // fill guard
-        coroutine->guard = TB_COROUTINE_STACK_GUARD;
-        tb_bits_set_u16_ne(coroutine->stackbase, TB_COROUTINE_STACK_GUARD);
+            // make coroutine
+            coroutine = (tb_coroutine_t*)(stack + stacksize - TB_COROUTINE_HEADSIZE);
+            tb_memset(coroutine, 0, sizeof(tb_coroutine_t));
 
-        // init function and user private data
-        coroutine->rs.func.func = func;
-        coroutine->rs.func.priv = priv;
+            // restore scheduler
+            coroutine->scheduler = scheduler;
 
-        // make context
-        coroutine->context = tb_context_make(coroutine->stackbase - stacksize, stacksize, tb_coroutine_entry);
-        tb_assert_and_check_break(coroutine->context);
+            // init stack
+            coroutine->stackbase = (tb_byte_t*)coroutine;
+            coroutine->stacksize = stacksize - TB_COROUTINE_HEADSIZE;
+        }
+
+        // make stack context
+        if (!tb_coroutine_stack_make(coroutine, func, priv)) break;
 
         // ok
         ok = tb_true;
 
     } while (0);
 
-    // failed? reset it
-    if (!ok) coroutine = tb_null;
+    // failed? free this coroutine and reset it
+    if (!ok)
+    {
+        if (coroutine && stack_pool) tb_co_stack_pool_free(stack_pool, coroutine->stackbase - coroutine->stacksize, coroutine->stacksize + TB_COROUTINE_HEADSIZE);
+        coroutine = tb_null;
+    }
 
     // trace
     tb_trace_d("reinit %p", coroutine);
@@ -227,8 +271,8 @@ tb_void_t tb_coroutine_exit(tb_coroutine_t* coroutine)
     tb_coroutine_check(coroutine);
 #endif
 
-    // exit it
-    tb_free(coroutine);
+    // free the stack and coroutine to the stack pool
+    tb_co_stack_pool_free(tb_co_stack_pool(), coroutine->stackbase - coroutine->stacksize, coroutine->stacksize + TB_COROUTINE_HEADSIZE);
 }
 #ifdef __tb_debug__
 tb_void_t tb_coroutine_check(tb_coroutine_t* coroutine)
@@ -239,21 +283,8 @@ tb_void_t tb_coroutine_check(tb_coroutine_t* coroutine)
     // this coroutine is original for scheduler?
     tb_check_return(!tb_coroutine_is_original(coroutine));
 
-    // check stack underflow
-    if (coroutine->guard != TB_COROUTINE_STACK_GUARD)
-    {
-        // trace
-        tb_trace_e("this coroutine stack is underflow!");
-
-        // dump stack
-        tb_dump_data(coroutine->stackbase - coroutine->stacksize, coroutine->stacksize);
-
-        // abort
-        tb_abort();
-    }
-
     // check stack overflow
-    if (tb_bits_get_u16_ne(coroutine->stackbase) != TB_COROUTINE_STACK_GUARD)
+    if (tb_bits_get_u16_ne(coroutine->stackbase - coroutine->stacksize) != TB_COROUTINE_STACK_GUARD)
     {
         // trace
         tb_trace_e("this coroutine stack is overflow!");
@@ -30,6 +30,7 @@
  * includes
  */
 #include "prefix.h"
+#include "timer_wheel.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
@@ -64,12 +65,8 @@ typedef struct __tb_coroutine_rs_func_t
 // the coroutine wait type
 typedef struct __tb_coroutine_rs_wait_t
 {
-    /* the timer task pointer for ltimer or timer
-     *
-     * for ltimer:  task
-     * for timer:   task & 0x1
-     */
-    tb_cpointer_t                   task;
+    // the pending timer task of timer wheel, it points to the embedded timer task of coroutine
+    tb_co_timer_wheel_task_ref_t    task;
 
     // the socket
     tb_socket_ref_t                 sock;
@@ -126,8 +123,14 @@ typedef struct __tb_coroutine_t
 
     }                               rs;
 
-    // the guard
-    tb_uint16_t                     guard;
+    // the embedded timer task for sleep and waiting io
+    tb_co_timer_wheel_task_t        timer;
+
+    // is grouped? it will be counted to the alive coroutines of the scheduler group
+    tb_uint16_t                     grouped;
+
+    // is bound? it can only be run on the worker which it was started on and cannot be stolen
+    tb_uint16_t                     bound;
 
 }tb_coroutine_t;
 
@@ -140,7 +143,7 @@ typedef struct __tb_coroutine_t
  * @param scheduler     the scheduler
  * @param func          the coroutine function
  * @param priv          the passed user private data as the argument of function
- * @param stacksize     the stack size, uses the default stack size if be zero
+ * @param stacksize     the stack size (include the coroutine), uses the default stack size if be zero
  *
  * @return              the coroutine 
  */
@@ -151,9 +154,9 @@ tb_coroutine_t*         tb_coroutine_init(tb_co_scheduler_ref_t scheduler, tb_co
  * @param coroutine     the coroutine
  * @param func          the coroutine function
  * @param priv          the passed user private data as the argument of function
- * @param stacksize     the stack size, uses the default stack size if be zero
+ * @param stacksize     the stack size (include the coroutine), uses the default stack size if be zero
  *
- * @return              the coroutine
+ * @return              the coroutine, the given coroutine will be freed if failed
  */
 tb_coroutine_t*         tb_coroutine_reinit(tb_coroutine_t* coroutine, tb_coroutine_func_t func, tb_cpointer_t priv, tb_size_t stacksize);
 
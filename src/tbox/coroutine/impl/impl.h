@@ -32,6 +32,7 @@
 #include "coroutine.h"
 #include "scheduler.h"
 #include "scheduler_io.h"
+#include "scheduler_group.h"
 #include "stackless/stackless.h"
 
 #endif
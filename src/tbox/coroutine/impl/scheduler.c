@@ -36,6 +36,7 @@
 #include "scheduler.h"
 #include "coroutine.h"
 #include "scheduler_io.h"
+#include "scheduler_group.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -51,18 +52,6 @@
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
-static __tb_inline__ tb_bool_t tb_co_scheduler_need_io(tb_co_scheduler_t* scheduler)
-{
-    // check
-    tb_assert(scheduler);
-
-    // init io scheduler first
-    if (!scheduler->scheduler_io) scheduler->scheduler_io = tb_co_scheduler_io_init(scheduler);
-    tb_assert(scheduler->scheduler_io);
-
-    // ok?
-    return scheduler->scheduler_io != tb_null;
-}
 static tb_void_t tb_co_scheduler_make_dead(tb_co_scheduler_t* scheduler, tb_coroutine_t* coroutine)
 {
     // check
@@ -125,10 +114,7 @@ static __tb_inline__ tb_coroutine_t* tb_co_scheduler_next_ready(tb_co_scheduler_
     return (tb_coroutine_t*)tb_list_entry0(entry_next);
 }
 
-/* //////////////////////////////////////////////////////////////////////////////////////
- * implementation
- */
-tb_bool_t tb_co_scheduler_start(tb_co_scheduler_t* scheduler, tb_coroutine_func_t func, tb_cpointer_t priv, tb_size_t stacksize)
+static tb_bool_t tb_co_scheduler_start_impl(tb_co_scheduler_t* scheduler, tb_coroutine_func_t func, tb_cpointer_t priv, tb_size_t stacksize, tb_bool_t bound)
 {
     // check
     tb_assert(func);
@@ -148,8 +134,14 @@ tb_bool_t tb_co_scheduler_start(tb_co_scheduler_t* scheduler, tb_coroutine_func_
         // have been stopped? do not continue to start new coroutines
         tb_check_break(!scheduler->stopped);
 
+        /* we can only access the dead coroutines of the current scheduler
+         *
+         * the worker scheduler of group may be started from other threads
+         */
+        tb_bool_t is_self = !scheduler->group || scheduler == (tb_co_scheduler_t*)tb_co_scheduler_self();
+
         // reuses dead coroutines in init function
-        if (tb_list_entry_size(&scheduler->coroutines_dead))
+        if (is_self && tb_list_entry_size(&scheduler->coroutines_dead))
         {
             // get the next entry from head
             tb_list_entry_ref_t entry = tb_list_entry_head(&scheduler->coroutines_dead);
@@ -161,22 +153,34 @@ tb_bool_t tb_co_scheduler_start(tb_co_scheduler_t* scheduler, tb_coroutine_func_
             // get the dead coroutine
             tb_coroutine_t* coroutine_dead = (tb_coroutine_t*)tb_list_entry0(entry);
 
-            // reinit this coroutine
+            // reinit this coroutine, it will be freed if failed
             coroutine = tb_coroutine_reinit(coroutine_dead, func, priv, stacksize);
-
-            // failed? exit this coroutine
-            if (!coroutine) tb_coroutine_exit(coroutine_dead);
         }
 
         // init coroutine
         if (!coroutine) coroutine = tb_coroutine_init((tb_co_scheduler_ref_t)scheduler, func, priv, stacksize);
         tb_assert_and_check_break(coroutine);
 
-        // ready coroutine
-        tb_co_scheduler_make_ready(scheduler, coroutine);
+        // is the worker scheduler of group?
+        if (scheduler->group)
+        {
+            // mark as grouped coroutine
+            coroutine->grouped = 1;
+            coroutine->bound   = bound? 1 : 0;
+
+            // push it to the pending coroutines, it may be stolen by other idle workers
+            tb_co_scheduler_group_push(scheduler->group, scheduler, coroutine);
+        }
+        else
+        {
+            // ready coroutine
+            coroutine->grouped = 0;
+            coroutine->bound   = 0;
+            tb_co_scheduler_make_ready(scheduler, coroutine);
+        }
 
         // the dead coroutines is too much? free some coroutines
-        while (tb_list_entry_size(&scheduler->coroutines_dead) > TB_SCHEDULER_DEAD_CACHE_MAXN)
+        while (is_self && tb_list_entry_size(&scheduler->coroutines_dead) > TB_SCHEDULER_DEAD_CACHE_MAXN)
         {
             // get the next entry from head
             tb_list_entry_ref_t entry = tb_list_entry_head(&scheduler->coroutines_dead);
@@ -200,6 +204,18 @@ tb_bool_t tb_co_scheduler_start(tb_co_scheduler_t* scheduler, tb_coroutine_func_
     // ok?
     return ok;
 }
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_bool_t tb_co_scheduler_start(tb_co_scheduler_t* scheduler, tb_coroutine_func_t func, tb_cpointer_t priv, tb_size_t stacksize)
+{
+    return tb_co_scheduler_start_impl(scheduler, func, priv, stacksize, tb_false);
+}
+tb_bool_t tb_co_scheduler_start_bound(tb_co_scheduler_t* scheduler, tb_coroutine_func_t func, tb_cpointer_t priv, tb_size_t stacksize)
+{
+    return tb_co_scheduler_start_impl(scheduler, func, priv, stacksize, tb_true);
+}
 tb_bool_t tb_co_scheduler_yield(tb_co_scheduler_t* scheduler)
 {
     // check
@@ -303,6 +319,9 @@ tb_void_t tb_co_scheduler_finish(tb_co_scheduler_t* scheduler)
     // trace
     tb_trace_d("finish coroutine(%p)", scheduler->running);
 
+    // finish the grouped coroutine
+    if (scheduler->running->grouped) tb_co_scheduler_group_done(scheduler->group);
+
     // get the next ready coroutine first
     tb_coroutine_t* coroutine_next = tb_co_scheduler_next_ready(scheduler);
 
@@ -331,7 +350,7 @@ tb_pointer_t tb_co_scheduler_sleep(tb_co_scheduler_t* scheduler, tb_long_t inter
     tb_check_return_val(!scheduler->stopped, tb_null);
 
     // need io scheduler
-    if (!tb_co_scheduler_need_io(scheduler)) return tb_null;
+    if (!tb_co_scheduler_io_need(scheduler)) return tb_null;
 
     // sleep it
     return tb_co_scheduler_io_sleep(scheduler->scheduler_io, interval);
@@ -366,6 +385,65 @@ tb_void_t tb_co_scheduler_switch(tb_co_scheduler_t* scheduler, tb_coroutine_t* c
     // update the context
     coroutine_from->context = from.context;
 }
+tb_size_t tb_co_scheduler_pull(tb_co_scheduler_t* scheduler)
+{
+    // check
+    tb_assert(scheduler && scheduler->group);
+
+    // pull the own pending coroutines first, otherwise steal them from the worker with the most stealable coroutines
+    tb_co_scheduler_t* victim = tb_atomic_get(&scheduler->pending_count)? scheduler : tb_co_scheduler_group_victim(scheduler->group, scheduler);
+    tb_check_return_val(victim, 0);
+
+    // enter lock
+    tb_spinlock_enter(&victim->pending_lock);
+
+    /* pull the half of pending coroutines and leave the others to be stolen
+     *
+     * we only steal the half of the stealable coroutines from other workers
+     */
+    tb_size_t           count = victim == scheduler? tb_list_entry_size(&victim->coroutines_pending) : (tb_size_t)tb_atomic_get(&victim->stealable_count);
+    tb_size_t           pulled = 0;
+    tb_size_t           unbound = 0;
+    count = (count + 1) >> 1;
+    tb_list_entry_ref_t entry = tb_list_entry_head(&victim->coroutines_pending);
+    while (pulled < count && entry != (tb_list_entry_ref_t)&victim->coroutines_pending)
+    {
+        // get the pending coroutine and the next entry
+        tb_coroutine_t*     coroutine = (tb_coroutine_t*)tb_list_entry0(entry);
+        tb_list_entry_ref_t next = tb_list_entry_next(entry);
+
+        // the bound coroutine can only be pulled by its own worker
+        if (!coroutine->bound || victim == scheduler)
+        {
+            // remove it from the pending coroutines
+            tb_list_entry_remove(&victim->coroutines_pending, entry);
+
+            // it has not been started and we can migrate it to the current worker
+            coroutine->scheduler = (tb_co_scheduler_ref_t)scheduler;
+
+            // make it as ready
+            tb_co_scheduler_make_ready(scheduler, coroutine);
+            if (!coroutine->bound) unbound++;
+            pulled++;
+        }
+
+        // the next entry
+        entry = next;
+    }
+
+    // update the pending count
+    tb_atomic_fetch_and_sub(&victim->pending_count, pulled);
+    if (unbound) tb_atomic_fetch_and_sub(&victim->stealable_count, unbound);
+
+    // leave lock
+    tb_spinlock_leave(&victim->pending_lock);
+
+    // trace
+    tb_trace_d("pull %lu coroutines from worker(%p) to worker(%p)", pulled, victim, scheduler);
+
+    // ok
+    return pulled;
+}
 tb_long_t tb_co_scheduler_wait(tb_co_scheduler_t* scheduler, tb_socket_ref_t sock, tb_size_t events, tb_long_t timeout)
 {
     // check
@@ -376,8 +454,68 @@ tb_long_t tb_co_scheduler_wait(tb_co_scheduler_t* scheduler, tb_socket_ref_t soc
     tb_check_return_val(!scheduler->stopped, -1);
 
     // need io scheduler
-    if (!tb_co_scheduler_need_io(scheduler)) return -1;
+    if (!tb_co_scheduler_io_need(scheduler)) return -1;
 
     // sleep it
     return tb_co_scheduler_io_wait(scheduler->scheduler_io, sock, events, timeout);
 }
+tb_void_t tb_co_scheduler_wakeup(tb_co_scheduler_t* scheduler, tb_coroutine_t* coroutine)
+{
+    // check
+    tb_assert(scheduler && coroutine && coroutine->scheduler == (tb_co_scheduler_ref_t)scheduler);
+
+    // push it to the woken coroutines
+    tb_spinlock_enter(&scheduler->waking_lock);
+    tb_single_list_entry_insert_tail(&scheduler->coroutines_waking, &coroutine->rs.single_entry);
+    tb_spinlock_leave(&scheduler->waking_lock);
+
+    // trace
+    tb_trace_d("wakeup coroutine(%p) of scheduler(%p)", coroutine, scheduler);
+
+    // spak the poller only for the first woken coroutine, we need not spak it again before resuming them
+    if (!tb_atomic_fetch_and_pset(&scheduler->waking, 0, 1))
+    {
+        tb_co_scheduler_io_ref_t scheduler_io = tb_co_scheduler_io(scheduler);
+        tb_assert(scheduler_io && scheduler_io->poller);
+        if (scheduler_io && scheduler_io->poller) tb_poller_spak(scheduler_io->poller);
+    }
+}
+tb_size_t tb_co_scheduler_wakeup_resume(tb_co_scheduler_t* scheduler)
+{
+    // check
+    tb_assert(scheduler);
+
+    // no woken coroutines?
+    tb_check_return_val(tb_atomic_get(&scheduler->waking), 0);
+
+    // clear the waking state first, the coroutines woken after it will spak poller again
+    tb_atomic_set0(&scheduler->waking);
+
+    // take all woken coroutines
+    tb_spinlock_enter(&scheduler->waking_lock);
+    tb_single_list_entry_ref_t entry = tb_single_list_entry_head(&scheduler->coroutines_waking);
+    tb_size_t                  count = tb_single_list_entry_size(&scheduler->coroutines_waking);
+    tb_single_list_entry_clear(&scheduler->coroutines_waking);
+    tb_spinlock_leave(&scheduler->waking_lock);
+
+    // resume them
+    tb_size_t i = 0;
+    for (i = 0; i < count && entry; i++)
+    {
+        // get the woken coroutine, we need get the next entry before resuming it
+        tb_coroutine_t*             coroutine = (tb_coroutine_t*)tb_single_list_entry(&scheduler->coroutines_waking, entry);
+        tb_single_list_entry_ref_t  next = entry->next;
+
+        // clear the entry, it is shared with rs.wait.task
+        entry->next = tb_null;
+
+        // resume it
+        tb_co_scheduler_resume(scheduler, coroutine, tb_null);
+
+        // the next entry
+        entry = next;
+    }
+
+    // ok
+    return count;
+}
@@ -60,6 +60,9 @@ __tb_extern_c_enter__
 // the io scheduler type
 struct __tb_co_scheduler_io_t;
 
+// the scheduler group type
+struct __tb_co_scheduler_group_t;
+
 // the scheduler type
 typedef struct __tb_co_scheduler_t
 {   
@@ -92,6 +95,41 @@ typedef struct __tb_co_scheduler_t
     // the suspend coroutines
     tb_list_entry_head_t            coroutines_suspend;
 
+    // the scheduler group, only for the worker scheduler of group
+    struct __tb_co_scheduler_group_t* group;
+
+    // is idle? only waiting io events and timers in the io loop
+    tb_atomic_t                     idle;
+
+    // the pending coroutines count, we can get it without lock
+    tb_atomic_t                     pending_count;
+
+    // the stealable pending coroutines count (not bound), other workers choose the victim by it
+    tb_atomic_t                     stealable_count;
+
+    // the pending lock
+    tb_spinlock_t                   pending_lock;
+
+    /* the pending coroutines
+     *
+     * the started but not yet running coroutines of the worker scheduler in group,
+     * they will be pulled to the ready coroutines or be stolen by other idle workers
+     */
+    tb_list_entry_head_t            coroutines_pending;
+
+    // have the woken coroutines? the poller is only spaked once for all woken coroutines before resuming them
+    tb_atomic_t                     waking;
+
+    // the waking lock
+    tb_spinlock_t                   waking_lock;
+
+    /* the woken coroutines from other threads
+     *
+     * they are suspended and linked by rs.single_entry, 
+     * and they will be resumed in the io loop of this scheduler
+     */
+    tb_single_list_entry_head_t     coroutines_waking;
+
 }tb_co_scheduler_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -109,6 +147,20 @@ typedef struct __tb_co_scheduler_t
  */
 tb_bool_t                   tb_co_scheduler_start(tb_co_scheduler_t* scheduler, tb_coroutine_func_t func, tb_cpointer_t priv, tb_size_t stacksize);
 
+/* start the coroutine function and bind it to the given worker scheduler of group
+ *
+ * the bound coroutine will not be stolen by other idle workers,
+ * it is same as tb_co_scheduler_start() if the scheduler is not the worker of group
+ *
+ * @param scheduler         the scheduler, uses the default scheduler if be null
+ * @param func              the coroutine function
+ * @param priv              the passed user private data as the argument of function
+ * @param stacksize         the stack size
+ *
+ * @return                  tb_true or tb_false
+ */
+tb_bool_t                   tb_co_scheduler_start_bound(tb_co_scheduler_t* scheduler, tb_coroutine_func_t func, tb_cpointer_t priv, tb_size_t stacksize);
+
 /* yield the current coroutine
  *
  * @param scheduler         the scheduler
@@ -158,6 +210,38 @@ tb_pointer_t                tb_co_scheduler_sleep(tb_co_scheduler_t* scheduler,
  */
 tb_void_t                   tb_co_scheduler_switch(tb_co_scheduler_t* scheduler, tb_coroutine_t* coroutine);
 
+/*! pull some pending coroutines to the ready coroutines
+ *
+ * only for the worker scheduler of group, 
+ * it will steal some pending coroutines from other workers if no own pending coroutines,
+ * but the bound coroutines of other workers will be skipped
+ *
+ * @param scheduler         the scheduler
+ *
+ * @return                  the pulled coroutines count
+ */
+tb_size_t                   tb_co_scheduler_pull(tb_co_scheduler_t* scheduler);
+
+/*! wake up the suspended coroutine of the given scheduler from any threads
+ *
+ * the coroutine will be resumed in the io loop of the given scheduler, 
+ * so the io scheduler must have been inited before suspending this coroutine.
+ *
+ * @param scheduler         the scheduler of this coroutine
+ * @param coroutine         the suspended coroutine
+ */
+tb_void_t                   tb_co_scheduler_wakeup(tb_co_scheduler_t* scheduler, tb_coroutine_t* coroutine);
+
+/*! resume all woken coroutines from other threads
+ *
+ * only be called in the io loop of this scheduler
+ *
+ * @param scheduler         the scheduler
+ *
+ * @return                  the resumed coroutines count
+ */
+tb_size_t                   tb_co_scheduler_wakeup_resume(tb_co_scheduler_t* scheduler);
+
 /*! wait io events 
  *
  * @param scheduler         the scheduler
@@ -0,0 +1,141 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        scheduler_group.c
+ * @ingroup     coroutine
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "scheduler_group"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "scheduler_group.h"
+#include "scheduler_io.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_bool_t tb_co_scheduler_group_wakeup(tb_co_scheduler_t* scheduler)
+{
+    // check
+    tb_assert(scheduler);
+
+    /* clear the idle state and spak it if this worker is idle
+     *
+     * we only spak it once for all pushed coroutines before it wakes up
+     */
+    if (!tb_atomic_fetch_and_pset(&scheduler->idle, 1, 0)) return tb_false;
+
+    // spak the poller of this worker
+    tb_co_scheduler_io_ref_t scheduler_io = tb_co_scheduler_io(scheduler);
+    if (scheduler_io && scheduler_io->poller) tb_poller_spak(scheduler_io->poller);
+
+    // ok
+    return tb_true;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_void_t tb_co_scheduler_group_push(tb_co_scheduler_group_t* group, tb_co_scheduler_t* scheduler, tb_coroutine_t* coroutine)
+{
+    // check
+    tb_assert(group && scheduler && coroutine && scheduler->group == group);
+
+    // one more alive coroutine
+    tb_atomic_fetch_and_inc(&group->alive);
+
+    // push it to the pending coroutines
+    tb_spinlock_enter(&scheduler->pending_lock);
+    tb_list_entry_insert_tail(&scheduler->coroutines_pending, (tb_list_entry_ref_t)coroutine);
+    tb_atomic_fetch_and_inc(&scheduler->pending_count);
+    if (!coroutine->bound) tb_atomic_fetch_and_inc(&scheduler->stealable_count);
+    tb_spinlock_leave(&scheduler->pending_lock);
+
+    // trace
+    tb_trace_d("push coroutine(%p) to worker(%p), pending: %ld", coroutine, scheduler, tb_atomic_get(&scheduler->pending_count));
+
+    // wake up this worker if it is idle, the bound coroutine cannot be stolen by other workers
+    if (tb_co_scheduler_group_wakeup(scheduler) || coroutine->bound) return ;
+
+    // this worker is busy now, wake up one of other idle workers to steal it
+    tb_size_t i = 0;
+    tb_size_t n = group->count;
+    for (i = 0; i < n; i++)
+    {
+        tb_co_scheduler_t* worker = group->workers[i];
+        if (worker != scheduler && tb_co_scheduler_group_wakeup(worker)) break;
+    }
+}
+tb_void_t tb_co_scheduler_group_done(tb_co_scheduler_group_t* group)
+{
+    // check
+    tb_assert(group);
+
+    // all coroutines have been finished?
+    if (!tb_atomic_dec_and_fetch(&group->alive))
+    {
+        // trace
+        tb_trace_d("all coroutines have been finished!");
+
+        // spak all workers to finish their loops
+        tb_size_t i = 0;
+        tb_size_t n = group->count;
+        for (i = 0; i < n; i++)
+        {
+            tb_co_scheduler_io_ref_t scheduler_io = tb_co_scheduler_io(group->workers[i]);
+            if (scheduler_io && scheduler_io->poller) tb_poller_spak(scheduler_io->poller);
+        }
+    }
+}
+tb_co_scheduler_t* tb_co_scheduler_group_victim(tb_co_scheduler_group_t* group, tb_co_scheduler_t* scheduler)
+{
+    // check
+    tb_assert(group);
+
+    // find the worker with the most stealable coroutines, the bound coroutines cannot be stolen
+    tb_size_t           i = 0;
+    tb_size_t           n = group->count;
+    tb_long_t           stealable_maxn = 0;
+    tb_co_scheduler_t*  victim = tb_null;
+    for (i = 0; i < n; i++)
+    {
+        tb_co_scheduler_t* worker = group->workers[i];
+        if (worker != scheduler)
+        {
+            tb_long_t stealable = tb_atomic_get(&worker->stealable_count);
+            if (stealable > stealable_maxn)
+            {
+                stealable_maxn  = stealable;
+                victim          = worker;
+            }
+        }
+    }
+
+    // ok?
+    return victim;
+}
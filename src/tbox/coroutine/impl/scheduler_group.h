@@ -0,0 +1,126 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        scheduler_group.h
+ * @ingroup     coroutine
+ *
+ */
+#ifndef TB_COROUTINE_IMPL_SCHEDULER_GROUP_H
+#define TB_COROUTINE_IMPL_SCHEDULER_GROUP_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "scheduler.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// get the alive coroutines count of the scheduler group
+#define tb_co_scheduler_group_alive(group)          tb_atomic_get(&(group)->alive)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the scheduler group listener type
+typedef struct __tb_co_scheduler_group_listener_t
+{
+    // the next listener
+    struct __tb_co_scheduler_group_listener_t*  next;
+
+    // the listening socket of this worker
+    tb_socket_ref_t                 sock;
+
+    // the coroutine function of the accepted connections
+    tb_coroutine_func_t             func;
+
+    // the stack size of the accepted connections
+    tb_size_t                       stacksize;
+
+    // bind the accepted connections to this worker? 
+    tb_bool_t                       bound;
+
+}tb_co_scheduler_group_listener_t;
+
+// the scheduler group type
+typedef struct __tb_co_scheduler_group_t
+{
+    // the worker schedulers
+    tb_co_scheduler_t**             workers;
+
+    // the worker threads, the first worker will be run on the current thread of loop()
+    tb_thread_ref_t*                threads;
+
+    // the workers count
+    tb_size_t                       count;
+
+    // the alive coroutines count of all workers (exclude the io loop coroutines)
+    tb_atomic_t                     alive;
+
+    // the next worker index for starting coroutines
+    tb_atomic_t                     next;
+
+    // the listeners of all workers
+    tb_co_scheduler_group_listener_t* listeners;
+
+}tb_co_scheduler_group_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* push the started coroutine to the pending coroutines of the given worker
+ *
+ * @param group             the scheduler group
+ * @param scheduler         the worker scheduler
+ * @param coroutine         the started coroutine
+ */
+tb_void_t                   tb_co_scheduler_group_push(tb_co_scheduler_group_t* group, tb_co_scheduler_t* scheduler, tb_coroutine_t* coroutine);
+
+/* the grouped coroutine have been finished
+ *
+ * @param group             the scheduler group
+ */
+tb_void_t                   tb_co_scheduler_group_done(tb_co_scheduler_group_t* group);
+
+/* get the busiest worker which have the most pending coroutines for stealing
+ *
+ * @param group             the scheduler group
+ * @param scheduler         the current worker scheduler (thief)
+ *
+ * @return                  the victim worker, return tb_null if no pending coroutines
+ */
+tb_co_scheduler_t*          tb_co_scheduler_group_victim(tb_co_scheduler_group_t* group, tb_co_scheduler_t* scheduler);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -34,44 +34,53 @@
  * includes
  */
 #include "scheduler_io.h"
+#include "scheduler_group.h"
 #include "coroutine.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
- * macros
+ * types
  */
 
-// the ltimer grow
-#ifdef __tb_small__
-#   define TB_SCHEDULER_IO_LTIMER_GROW      (64)
-#else
-#   define TB_SCHEDULER_IO_LTIMER_GROW      (4096)
-#endif
+// the posted io operation of coroutine
+typedef struct __tb_co_scheduler_io_op_t
+{
+    // the list entry of the in-flight operations
+    tb_list_entry_t             entry;
+
+    // the waiting coroutine
+    tb_coroutine_t*             coroutine;
+
+    // the io scheduler
+    tb_co_scheduler_io_ref_t    scheduler_io;
+
+    // the posted io operation
+    tb_poller_op_ref_t          op;
 
-// the timer grow
-#define TB_SCHEDULER_IO_TIMER_GROW          (TB_SCHEDULER_IO_LTIMER_GROW >> 4)
+    // has been timeout? 
+    tb_bool_t                   timeout;
+
+    // has been cancelled?
+    tb_bool_t                   cancelled;
+
+    // has been completed?
+    tb_bool_t                   completed;
+
+}tb_co_scheduler_io_op_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
 static tb_void_t tb_co_scheduler_io_resume(tb_co_scheduler_t* scheduler, tb_coroutine_t* coroutine, tb_cpointer_t priv)
 {
-    // exists the timer task? remove it
-    tb_cpointer_t task = coroutine->rs.wait.task;
-    if (task) 
+    // exists the timer task? cancel it
+    if (coroutine->rs.wait.task) 
     {
         // get io scheduler
         tb_co_scheduler_io_ref_t scheduler_io = tb_co_scheduler_io(scheduler);
         tb_assert(scheduler_io && scheduler_io->poller);
 
-        // is high-precision timer?
-        tb_size_t is_timer = (tb_size_t)(task) & 0x1;
-
-        // check
-        tb_assert((tb_size_t)task & (tb_size_t)~0x1);
-
-        // remove the timer task
-        if (__tb_unlikely__(is_timer)) tb_timer_task_exit(scheduler_io->timer, (tb_timer_task_ref_t)((tb_size_t)task & (tb_size_t)~0x1));
-        else tb_ltimer_task_exit(scheduler_io->ltimer, (tb_ltimer_task_ref_t)task);
+        // cancel the timer task
+        tb_co_scheduler_io_timer_exit(scheduler_io, coroutine->rs.wait.task);
         coroutine->rs.wait.task = tb_null;
     }
 
@@ -97,8 +106,67 @@ static tb_void_t tb_co_scheduler_io_timeout(tb_bool_t killed, tb_cpointer_t priv
     // resume the coroutine 
     tb_co_scheduler_io_resume(scheduler, coroutine, tb_null);
 }
+static tb_void_t tb_co_scheduler_io_op_timeout(tb_bool_t killed, tb_cpointer_t priv)
+{
+    // check
+    tb_co_scheduler_io_op_t* wait = (tb_co_scheduler_io_op_t*)priv;
+    tb_assert(wait && wait->coroutine && wait->scheduler_io && wait->op);
+
+    // trace
+    tb_trace_d("coroutine(%p): op(%lu) %s", wait->coroutine, wait->op->code, killed? "killed" : "timeout");
+
+    // the timer task has been expired
+    wait->timeout = tb_true;
+    wait->coroutine->rs.wait.task = tb_null;
+
+    /* cancel this operation, the coroutine will be resumed after it has been completed
+     *
+     * the kernel may still access the data buffer before completion, so we cannot resume it now
+     */
+    tb_co_scheduler_io_ref_t scheduler_io = wait->scheduler_io;
+    if (scheduler_io->poller && !wait->completed && !tb_poller_post_cancel(scheduler_io->poller, wait->op))
+    {
+        // the submission queue is full? re-arm the timer task and retry it in the next loop
+        tb_co_timer_wheel_task_ref_t task = &wait->coroutine->timer;
+        tb_co_scheduler_io_timer_post(scheduler_io, task, 1, tb_co_scheduler_io_op_timeout, wait);
+        wait->coroutine->rs.wait.task = task;
+    }
+}
+static tb_co_scheduler_io_op_t* tb_co_scheduler_io_op_finish(tb_poller_op_ref_t op)
+{
+    // check
+    tb_co_scheduler_io_op_t* wait = (tb_co_scheduler_io_op_t*)op->priv;
+    tb_assert(wait && wait->coroutine && wait->scheduler_io && !wait->completed);
+
+    // remove it from the in-flight operations
+    tb_list_entry_remove(&wait->scheduler_io->ops, &wait->entry);
+    wait->completed = tb_true;
+    return wait;
+}
+static tb_void_t tb_co_scheduler_io_op_done(tb_poller_op_ref_t op)
+{
+    // finish this operation
+    tb_co_scheduler_io_op_t* wait = tb_co_scheduler_io_op_finish(op);
+
+    // get scheduler
+    tb_co_scheduler_t* scheduler = (tb_co_scheduler_t*)tb_coroutine_scheduler(wait->coroutine);
+    tb_assert(scheduler);
+
+    // trace
+    tb_trace_d("coroutine(%p): op(%lu) done: %ld", wait->coroutine, op->code, op->real);
+
+    // resume the coroutine
+    tb_co_scheduler_io_resume(scheduler, wait->coroutine, tb_null);
+}
 static tb_void_t tb_co_scheduler_io_events(tb_poller_ref_t poller, tb_socket_ref_t sock, tb_size_t events, tb_cpointer_t priv)
 {
+    // the posted io operation has been completed?
+    if (events & TB_POLLER_EVENT_COMP)
+    {
+        tb_co_scheduler_io_op_done((tb_poller_op_ref_t)priv);
+        return ;
+    }
+
     // check
     tb_coroutine_t* coroutine = (tb_coroutine_t*)priv;
     tb_assert(coroutine && poller && sock && priv);
@@ -127,28 +195,77 @@ static tb_void_t tb_co_scheduler_io_events(tb_poller_ref_t poller, tb_socket_ref
     // cache this events
     else coroutine->rs.wait.events_cache = events;
 }
+static tb_void_t tb_co_scheduler_io_drain_events(tb_poller_ref_t poller, tb_socket_ref_t sock, tb_size_t events, tb_cpointer_t priv)
+{
+    // only finish the posted io operations, the scheduler has been stopped and the coroutines will not be resumed
+    tb_check_return(events & TB_POLLER_EVENT_COMP);
+
+    // finish this operation
+    tb_co_scheduler_io_op_t* wait = tb_co_scheduler_io_op_finish((tb_poller_op_ref_t)priv);
+
+    // cancel its timer task
+    if (wait->coroutine->rs.wait.task)
+    {
+        tb_co_scheduler_io_timer_exit(wait->scheduler_io, wait->coroutine->rs.wait.task);
+        wait->coroutine->rs.wait.task = tb_null;
+    }
+}
+static tb_void_t tb_co_scheduler_io_drain(tb_co_scheduler_io_ref_t scheduler_io)
+{
+    // check
+    tb_assert(scheduler_io);
+
+    // no in-flight operations?
+    tb_poller_ref_t poller = scheduler_io->poller;
+    tb_check_return(poller && tb_list_entry_size(&scheduler_io->ops));
+
+    // trace
+    tb_trace_d("drain %lu in-flight operations ..", tb_list_entry_size(&scheduler_io->ops));
+
+    // cancel all in-flight operations and wait their completions
+    tb_size_t failed = 0;
+    while (tb_list_entry_size(&scheduler_io->ops))
+    {
+        // cancel them, we will retry it in the next loop if the submission queue is full
+        tb_list_entry_ref_t entry = tb_list_entry_head(&scheduler_io->ops);
+        while (entry != (tb_list_entry_ref_t)&scheduler_io->ops)
+        {
+            tb_co_scheduler_io_op_t* wait = (tb_co_scheduler_io_op_t*)tb_list_entry(&scheduler_io->ops, entry);
+            if (!wait->cancelled) wait->cancelled = tb_poller_post_cancel(poller, wait->op);
+            entry = tb_list_entry_next(entry);
+        }
+
+        // wait their completions, the poller may be killed once before
+        if (tb_poller_wait(poller, tb_co_scheduler_io_drain_events, 1000) < 0 && ++failed > 3)
+        {
+            // trace
+            tb_trace_e("drain %lu in-flight operations failed!", tb_list_entry_size(&scheduler_io->ops));
+            break;
+        }
+    }
+}
 static tb_bool_t tb_co_scheduler_io_timer_spak(tb_co_scheduler_io_ref_t scheduler_io)
 {
     // check
-    tb_assert(scheduler_io && scheduler_io->timer && scheduler_io->ltimer);
+    tb_assert(scheduler_io && scheduler_io->timer);
+
+    // have been killed?
+    tb_check_return_val(!scheduler_io->stop, tb_false);
 
     // spak ctime
     tb_cache_time_spak();
 
     // spak timer
-    if (!tb_timer_spak(scheduler_io->timer)) return tb_false;
-
-    // spak ltimer
-    if (!tb_ltimer_spak(scheduler_io->ltimer)) return tb_false;
+    tb_co_timer_wheel_spak(scheduler_io->timer);
 
-    // pk
+    // ok
     return tb_true;
 }
 static tb_void_t tb_co_scheduler_io_loop(tb_cpointer_t priv)
 {
     // check
     tb_co_scheduler_io_ref_t scheduler_io = (tb_co_scheduler_io_ref_t)priv;
-    tb_assert_and_check_return(scheduler_io && scheduler_io->timer && scheduler_io->ltimer);
+    tb_assert_and_check_return(scheduler_io && scheduler_io->timer);
 
     // the scheduler
     tb_co_scheduler_t* scheduler = scheduler_io->scheduler;
@@ -161,27 +278,49 @@ static tb_void_t tb_co_scheduler_io_loop(tb_cpointer_t priv)
     // loop
     while (!scheduler->stopped)
     {
+        // resume the woken coroutines from other threads
+        tb_co_scheduler_wakeup_resume(scheduler);
+
         // finish all other ready coroutines first
         while (tb_co_scheduler_yield(scheduler)) 
         {
             // spak timer
             if (!tb_co_scheduler_io_timer_spak(scheduler_io)) break;
+
+            // resume the woken coroutines from other threads
+            tb_co_scheduler_wakeup_resume(scheduler);
         }
 
+        // is the worker scheduler of group?
+        if (scheduler->group)
+        {
+            // mark as idle first, other workers will spak us after pushing new pending coroutines
+            tb_atomic_set(&scheduler->idle, 1);
+
+            // pull some pending coroutines and continue to run them
+            if (tb_co_scheduler_pull(scheduler))
+            {
+                tb_atomic_set0(&scheduler->idle);
+                continue;
+            }
+
+            // all coroutines of group have been finished? loop end
+            tb_check_break(tb_co_scheduler_group_alive(scheduler->group));
+        }
         // no more suspended coroutines? loop end
-        tb_check_break(tb_co_scheduler_suspend_count(scheduler));
+        else tb_check_break(tb_co_scheduler_suspend_count(scheduler));
 
         // the delay
-        tb_size_t delay = tb_timer_delay(scheduler_io->timer);
-
-        // the ldelay
-        tb_size_t ldelay = tb_ltimer_delay(scheduler_io->ltimer);
+        tb_size_t delay = tb_co_timer_wheel_delay(scheduler_io->timer);
 
         // trace
-        tb_trace_d("loop: wait %lu ms ..", tb_min(delay, ldelay));
+        tb_trace_d("loop: wait %ld ms ..", (tb_long_t)delay);
 
         // no more ready coroutines? wait io events and timers
-        if (tb_poller_wait(poller, tb_co_scheduler_io_events, tb_min(delay, ldelay)) < 0) break;
+        if (tb_poller_wait(poller, tb_co_scheduler_io_events, (tb_long_t)delay) < 0) break;
+
+        // clear the idle state
+        if (scheduler->group) tb_atomic_set0(&scheduler->idle);
 
         // spak timer
         if (!tb_co_scheduler_io_timer_spak(scheduler_io)) break;
@@ -205,13 +344,19 @@ tb_co_scheduler_io_ref_t tb_co_scheduler_io_init(tb_co_scheduler_t* scheduler)
         // save scheduler
         scheduler_io->scheduler = (tb_co_scheduler_t*)scheduler;
 
-        // init timer and using cache time
-        scheduler_io->timer = tb_timer_init(TB_SCHEDULER_IO_TIMER_GROW, tb_true);
-        tb_assert_and_check_break(scheduler_io->timer);
+        /* spak the cache time first
+         *
+         * the timer tasks may be posted by the current coroutine before the io loop is running,
+         * and they will be expired immediately if the cache time has not been updated
+         */
+        tb_cache_time_spak();
 
-        // init ltimer and using cache time
-        scheduler_io->ltimer = tb_ltimer_init(TB_SCHEDULER_IO_LTIMER_GROW, TB_LTIMER_TICK_S, tb_true);
-        tb_assert_and_check_break(scheduler_io->ltimer);
+        // init the in-flight operations
+        tb_list_entry_init(&scheduler_io->ops, tb_co_scheduler_io_op_t, entry, tb_null);
+
+        // init timer wheel and using cache time
+        scheduler_io->timer = tb_co_timer_wheel_init();
+        tb_assert_and_check_break(scheduler_io->timer);
 
         // init poller
         scheduler_io->poller = tb_poller_init(tb_null);
@@ -241,21 +386,23 @@ tb_void_t tb_co_scheduler_io_exit(tb_co_scheduler_io_ref_t scheduler_io)
     // check
     tb_assert_and_check_return(scheduler_io);
 
+    // the coroutines will be freed after exiting, so we need finish all in-flight operations first
+    tb_co_scheduler_io_drain(scheduler_io);
+
     // exit poller
     if (scheduler_io->poller) tb_poller_exit(scheduler_io->poller);
     scheduler_io->poller = tb_null;
 
     // exit timer
-    if (scheduler_io->timer) tb_timer_exit(scheduler_io->timer);
+    if (scheduler_io->timer) tb_co_timer_wheel_exit(scheduler_io->timer);
     scheduler_io->timer = tb_null;
 
-    // exit ltimer
-    if (scheduler_io->ltimer) tb_ltimer_exit(scheduler_io->ltimer);
-    scheduler_io->ltimer = tb_null;
-
     // clear scheduler
     scheduler_io->scheduler = tb_null;
 
+    // exit the in-flight operations
+    tb_list_entry_exit(&scheduler_io->ops);
+
     // exit it
     tb_free(scheduler_io);
 }
@@ -267,15 +414,40 @@ tb_void_t tb_co_scheduler_io_kill(tb_co_scheduler_io_ref_t scheduler_io)
     // trace
     tb_trace_d("kill: ..");
 
-    // kill timer
-    if (scheduler_io->timer) tb_timer_kill(scheduler_io->timer);
-
-    // kill ltimer
-    if (scheduler_io->ltimer) tb_ltimer_kill(scheduler_io->ltimer);
+    // stop timer
+    scheduler_io->stop = tb_true;
 
     // kill poller
     if (scheduler_io->poller) tb_poller_kill(scheduler_io->poller);
 }
+tb_co_scheduler_io_ref_t tb_co_scheduler_io_need(tb_co_scheduler_t* scheduler)
+{
+    // check
+    tb_assert(scheduler);
+
+    // init io scheduler first
+    if (!scheduler->scheduler_io) scheduler->scheduler_io = tb_co_scheduler_io_init(scheduler);
+    tb_assert(scheduler->scheduler_io);
+
+    // ok?
+    return scheduler->scheduler_io;
+}
+tb_void_t tb_co_scheduler_io_timer_post(tb_co_scheduler_io_ref_t scheduler_io, tb_co_timer_wheel_task_ref_t task, tb_long_t timeout, tb_timer_task_func_t func, tb_cpointer_t priv)
+{
+    // check
+    tb_assert_and_check_return(scheduler_io && scheduler_io->timer && task && timeout >= 0 && func);
+
+    // post task to the timer wheel
+    tb_co_timer_wheel_post(scheduler_io->timer, task, timeout, func, priv);
+}
+tb_void_t tb_co_scheduler_io_timer_exit(tb_co_scheduler_io_ref_t scheduler_io, tb_co_timer_wheel_task_ref_t task)
+{
+    // check
+    tb_assert_and_check_return(scheduler_io && scheduler_io->timer && task);
+
+    // cancel the timer task
+    tb_co_timer_wheel_cancel(scheduler_io->timer, task);
+}
 tb_pointer_t tb_co_scheduler_io_sleep(tb_co_scheduler_io_ref_t scheduler_io, tb_long_t interval)
 {
     // check
@@ -294,18 +466,9 @@ tb_pointer_t tb_co_scheduler_io_sleep(tb_co_scheduler_io_ref_t scheduler_io, tb_
     // infinity?
     if (interval > 0)
     {
-        // high-precision interval?
-        if (interval % 1000)
-        {
-            // post task to timer
-            tb_timer_task_post(scheduler_io->timer, interval, tb_false, tb_co_scheduler_io_timeout, coroutine);
-        }
-        // low-precision interval?
-        else
-        {
-            // post task to ltimer (faster)
-            tb_ltimer_task_post(scheduler_io->ltimer, interval, tb_false, tb_co_scheduler_io_timeout, coroutine);
-        }
+        // post the embedded timer task, it will be cancelled if this coroutine is resumed by io events
+        tb_co_timer_wheel_post(scheduler_io->timer, &coroutine->timer, interval, tb_co_scheduler_io_timeout, coroutine);
+        coroutine->rs.wait.task = &coroutine->timer;
     }
 
     // suspend it
@@ -355,14 +518,14 @@ tb_long_t tb_co_scheduler_io_wait(tb_co_scheduler_io_ref_t scheduler_io, tb_sock
     }
     else
     {
-        // remove the previous socket first if exists
+        /* remove the previous socket first if exists
+         *
+         * it may have been closed and cancelled by the other coroutine, so we ignore the error
+         */
         if (sock_prev && !tb_poller_remove(scheduler_io->poller, sock_prev))
         {
             // trace
-            tb_trace_e("failed to remove sock(%p) to poller on coroutine(%p)!", sock_prev, coroutine);
-
-            // failed
-            return -1;
+            tb_trace_d("failed to remove sock(%p) to poller on coroutine(%p)!", sock_prev, coroutine);
         }
 
         // insert socket to poller for waiting events
@@ -376,35 +539,16 @@ tb_long_t tb_co_scheduler_io_wait(tb_co_scheduler_io_ref_t scheduler_io, tb_sock
         }
     }
 
-    // exists timeout?
-    tb_cpointer_t   task = tb_null;
-    tb_bool_t       is_ltimer = tb_false;
+    // exists timeout? post the embedded timer task
+    tb_co_timer_wheel_task_ref_t task = tb_null;
     if (timeout >= 0)
     {
-        // high-precision interval?
-        if (timeout % 1000)
-        {
-            // init task for timer
-            task = tb_timer_task_init(scheduler_io->timer, timeout, tb_false, tb_co_scheduler_io_timeout, coroutine);
-            tb_assert_and_check_return_val(task, tb_false);
-        }
-        // low-precision interval?
-        else
-        {
-            // init task for ltimer (faster)
-            task = tb_ltimer_task_init(scheduler_io->ltimer, timeout, tb_false, tb_co_scheduler_io_timeout, coroutine);
-            tb_assert_and_check_return_val(task, tb_false);
-
-            // mark as low-precision timer
-            is_ltimer = tb_true;
-        }
+        task = &coroutine->timer;
+        tb_co_timer_wheel_post(scheduler_io->timer, task, timeout, tb_co_scheduler_io_timeout, coroutine);
     }
 
-    // check
-    tb_assert(!((tb_size_t)(task) & 0x1));
-
     // save the timer task to coroutine
-    coroutine->rs.wait.task = (is_ltimer || !task)? task : (tb_cpointer_t)((tb_size_t)(task) | 0x1);
+    coroutine->rs.wait.task = task;
 
     // save the socket to coroutine for the timer function
     coroutine->rs.wait.sock = sock;
@@ -432,24 +576,101 @@ tb_bool_t tb_co_scheduler_io_cancel(tb_co_scheduler_io_ref_t scheduler_io, tb_so
     tb_trace_d("coroutine(%p): cancel socket(%p) ..", coroutine, sock);
 
     // remove the this socket from poller
+    tb_bool_t ok = tb_false;
     if (coroutine->rs.wait.sock == sock)
     {
         // remove the previous socket first if exists
-        if (!tb_poller_remove(scheduler_io->poller, sock))
+        ok = tb_poller_remove(scheduler_io->poller, sock);
+        if (!ok)
         {
             // trace
             tb_trace_e("failed to remove sock(%p) to poller on coroutine(%p)!", sock, coroutine);
+        }
 
-            // failed
-            return tb_false;
+        // clear the waiting socket
+        coroutine->rs.wait.sock         = tb_null;
+        coroutine->rs.wait.events       = 0;
+        coroutine->rs.wait.events_cache = 0;
+    }
+
+    /* cancel all pending requests of this socket in kernel before closing it
+     *
+     * it may be still waited by the other coroutine, and the completion-based poller (e.g. io_uring) 
+     * will keep this socket open until these requests are finished
+     */
+    tb_poller_cancel(scheduler_io->poller, sock);
+
+    // ok?
+    return ok;
+}
+tb_long_t tb_co_scheduler_io_post(tb_co_scheduler_io_ref_t scheduler_io, tb_poller_op_ref_t op, tb_long_t timeout)
+{
+    // check
+    tb_assert(scheduler_io && op && scheduler_io->poller && scheduler_io->scheduler);
+
+    // get the current coroutine
+    tb_coroutine_t* coroutine = tb_co_scheduler_running(scheduler_io->scheduler);
+    tb_assert(coroutine);
+
+    // trace
+    tb_trace_d("coroutine(%p): post op(%lu) with %ld ms for %p ..", coroutine, op->code, timeout, op->ref);
+
+    /* have been stopped? do not post it
+     *
+     * the coroutine will not be resumed after stopping, and the kernel may write the completion later to its freed stack
+     */
+    tb_check_return_val(!scheduler_io->stop && !scheduler_io->scheduler->stopped, -1);
+
+    // init the waiting operation, it will be kept in the stack until this operation is completed
+    tb_co_scheduler_io_op_t wait;
+    wait.coroutine      = coroutine;
+    wait.scheduler_io   = scheduler_io;
+    wait.op             = op;
+    wait.timeout        = tb_false;
+    wait.cancelled      = tb_false;
+    wait.completed      = tb_false;
+    op->priv            = &wait;
+
+    // post this operation, it is not supported or the submission queue is full?
+    if (!tb_poller_post(scheduler_io->poller, op)) return -1;
+
+    // it is in flight now
+    tb_list_entry_insert_tail(&scheduler_io->ops, &wait.entry);
+
+    // exists timeout? post the embedded timer task
+    tb_co_timer_wheel_task_ref_t task = tb_null;
+    if (timeout >= 0)
+    {
+        task = &coroutine->timer;
+        tb_co_timer_wheel_post(scheduler_io->timer, task, timeout, tb_co_scheduler_io_op_timeout, &wait);
+    }
+
+    /* save the timer task to coroutine
+     *
+     * we do not mark it as waiting state, so it will not be resumed by the poll events of the waited socket
+     */
+    coroutine->rs.wait.task = task;
+
+    // suspend the current coroutine until this operation is completed
+    while (!wait.completed)
+    {
+        /* have been stopped? suspend() will return directly
+         *
+         * we cancel all in-flight operations and wait their completions here, 
+         * because this stack will be freed after returning
+         */
+        if (scheduler_io->scheduler->stopped)
+        {
+            tb_co_scheduler_io_drain(scheduler_io);
+            break;
         }
 
-        // remove ok
-        return tb_true;
+        // suspend it
+        tb_co_scheduler_suspend(scheduler_io->scheduler, tb_null);
     }
 
-    // no this socket
-    return tb_false;
+    // timeout? it may be finished before cancelling
+    return (wait.timeout && op->real < 0)? 0 : 1;
 }
 tb_co_scheduler_io_ref_t tb_co_scheduler_io_self()
 {
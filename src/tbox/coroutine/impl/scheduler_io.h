@@ -52,11 +52,15 @@ typedef struct __tb_co_scheduler_io_t
     // the poller
     tb_poller_ref_t     poller;
 
-    // the timer
-    tb_timer_ref_t      timer;
+    // the timer wheel for sleep and timeout
+    tb_co_timer_wheel_ref_t timer;
 
-    // the low-precision timer (faster)
-    tb_ltimer_ref_t     ltimer;
+    /* the posted io operations in flight
+     *
+     * they hold the buffers and the waiting states in the stacks of coroutines,
+     * so we must cancel them and wait their completions before freeing these coroutines
+     */
+    tb_list_entry_head_t ops;
 
 }tb_co_scheduler_io_t, *tb_co_scheduler_io_ref_t;
 
@@ -82,6 +86,31 @@ tb_void_t                   tb_co_scheduler_io_exit(tb_co_scheduler_io_ref_t sch
  */
 tb_void_t                   tb_co_scheduler_io_kill(tb_co_scheduler_io_ref_t scheduler_io);
 
+/* get the io scheduler of the given scheduler and init it if not exists
+ *
+ * @param scheduler         the scheduler
+ *
+ * @return                  the io scheduler
+ */
+tb_co_scheduler_io_ref_t    tb_co_scheduler_io_need(tb_co_scheduler_t* scheduler);
+
+/* post a timeout task to the timer wheel
+ *
+ * @param scheduler_io      the io scheduler
+ * @param task              the intrusive timer task, it need be embedded in the waiting object
+ * @param timeout           the timeout (ms)
+ * @param func              the timer function
+ * @param priv              the user private data
+ */
+tb_void_t                   tb_co_scheduler_io_timer_post(tb_co_scheduler_io_ref_t scheduler_io, tb_co_timer_wheel_task_ref_t task, tb_long_t timeout, tb_timer_task_func_t func, tb_cpointer_t priv);
+
+/* exit the timeout task, it will be cancelled if not expired
+ *
+ * @param scheduler_io      the io scheduler
+ * @param task              the timer task from tb_co_scheduler_io_timer_post()
+ */
+tb_void_t                   tb_co_scheduler_io_timer_exit(tb_co_scheduler_io_ref_t scheduler_io, tb_co_timer_wheel_task_ref_t task);
+
 /* sleep the current coroutine
  *
  * @param scheduler_io      the io scheduler
@@ -111,6 +140,16 @@ tb_long_t                   tb_co_scheduler_io_wait(tb_co_scheduler_io_ref_t sch
  */
 tb_bool_t                   tb_co_scheduler_io_cancel(tb_co_scheduler_io_ref_t scheduler_io, tb_socket_ref_t sock);
 
+/* post the io operation and wait it to be completed, only for the completion-based poller
+ *
+ * @param scheduler_io      the io scheduler
+ * @param op                the io operation, the result will be saved to op->real after it has been completed
+ * @param timeout           the timeout, infinity: -1, it will be cancelled after timeout
+ *
+ * @return                  1: completed, 0: timeout, -1: not posted
+ */
+tb_long_t                   tb_co_scheduler_io_post(tb_co_scheduler_io_ref_t scheduler_io, tb_poller_op_ref_t op, tb_long_t timeout);
+
 /* get the current io scheduler
  *
  * @return                  the io scheduler
@@ -0,0 +1,323 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        stack_pool.c
+ * @ingroup     coroutine
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "stack_pool"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "stack_pool.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the minimum size class: 16KB
+#define TB_CO_STACK_POOL_CLASS_MINB         (14)
+
+// the size classes count: 16KB, 32KB, .., 8MB
+#define TB_CO_STACK_POOL_CLASS_MAXN         (10)
+
+// the cached stacks maximum count for each size class
+#ifdef __tb_small__
+#   define TB_CO_STACK_POOL_CACHE_MAXN      (16)
+#else
+#   define TB_CO_STACK_POOL_CACHE_MAXN      (256)
+#endif
+
+// the high-water mark of the cached stacks, the pages of the stacks above it will be returned to the system
+#define TB_CO_STACK_POOL_CACHE_HIGH         (TB_CO_STACK_POOL_CACHE_MAXN >> 2)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the cached stack node type, it is placed at the top page of the free stack
+typedef struct __tb_co_stack_pool_node_t
+{
+    // the next node
+    struct __tb_co_stack_pool_node_t*   next;
+
+}tb_co_stack_pool_node_t;
+
+// the stack pool type
+typedef struct __tb_co_stack_pool_t
+{
+    // the lock
+    tb_spinlock_t                       lock;
+
+    // the page size
+    tb_size_t                           pagesize;
+
+    // the cached stacks for each size class
+    tb_co_stack_pool_node_t*            cache[TB_CO_STACK_POOL_CLASS_MAXN];
+
+    // the cached stacks count for each size class
+    tb_size_t                           cache_count[TB_CO_STACK_POOL_CLASS_MAXN];
+
+}tb_co_stack_pool_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_handle_t tb_co_stack_pool_instance_init(tb_cpointer_t* ppriv)
+{
+    return (tb_handle_t)tb_co_stack_pool_init();
+}
+static tb_void_t tb_co_stack_pool_instance_exit(tb_handle_t pool, tb_cpointer_t priv)
+{
+    tb_co_stack_pool_exit((tb_co_stack_pool_ref_t)pool);
+}
+static __tb_inline__ tb_size_t tb_co_stack_pool_class(tb_size_t size)
+{
+    // get the size class index
+    tb_size_t index = 0;
+    while (index < TB_CO_STACK_POOL_CLASS_MAXN && ((tb_size_t)1 << (TB_CO_STACK_POOL_CLASS_MINB + index)) < size) index++;
+    return index;
+}
+static __tb_inline__ tb_size_t tb_co_stack_pool_class_size(tb_co_stack_pool_t* pool, tb_size_t index)
+{
+    // the size of the size class, it will be rounded up to the page size if the page is larger (e.g. 64K pages)
+    tb_size_t size = (tb_size_t)1 << (TB_CO_STACK_POOL_CLASS_MINB + index);
+    return tb_max(size, pool->pagesize);
+}
+static tb_byte_t* tb_co_stack_pool_map(tb_co_stack_pool_t* pool, tb_size_t size)
+{
+    // map the guard page and stack
+    tb_byte_t* base = (tb_byte_t*)tb_virtual_memory_malloc(pool->pagesize + size);
+    tb_assert_and_check_return_val(base, tb_null);
+
+    /* protect the guard page, the stack overflow will be caught immediately
+     *
+     * we only waste this page if it is not supported
+     */
+    if (!tb_virtual_memory_protect(base, pool->pagesize, TB_VIRTUAL_MEMORY_PROT_NONE))
+    {
+        // trace
+        tb_trace_d("protect the guard page failed!");
+    }
+
+    // the stack data
+    return base + pool->pagesize;
+}
+static tb_void_t tb_co_stack_pool_unmap(tb_co_stack_pool_t* pool, tb_byte_t* data, tb_size_t size)
+{
+    // unmap the guard page and stack
+    if (!tb_virtual_memory_free(data - pool->pagesize, pool->pagesize + size))
+    {
+        // trace
+        tb_trace_e("unmap stack(%p) failed!", data);
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_co_stack_pool_ref_t tb_co_stack_pool()
+{
+    return (tb_co_stack_pool_ref_t)tb_singleton_instance(TB_SINGLETON_TYPE_CO_STACK_POOL, tb_co_stack_pool_instance_init, tb_co_stack_pool_instance_exit, tb_null, tb_null);
+}
+tb_co_stack_pool_ref_t tb_co_stack_pool_init()
+{
+    // done
+    tb_bool_t           ok = tb_false;
+    tb_co_stack_pool_t* pool = tb_null;
+    do
+    {
+        // make pool
+        pool = tb_malloc0_type(tb_co_stack_pool_t);
+        tb_assert_and_check_break(pool);
+
+        // init lock
+        if (!tb_spinlock_init(&pool->lock)) break;
+
+        // init page size
+        pool->pagesize = tb_page_size();
+        tb_assert_and_check_break(pool->pagesize && tb_ispow2(pool->pagesize));
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (pool) tb_co_stack_pool_exit((tb_co_stack_pool_ref_t)pool);
+        pool = tb_null;
+    }
+
+    // ok?
+    return (tb_co_stack_pool_ref_t)pool;
+}
+tb_void_t tb_co_stack_pool_exit(tb_co_stack_pool_ref_t self)
+{
+    // check
+    tb_co_stack_pool_t* pool = (tb_co_stack_pool_t*)self;
+    tb_assert_and_check_return(pool);
+
+    // enter
+    tb_spinlock_enter(&pool->lock);
+
+    // free all cached stacks
+    tb_size_t index = 0;
+    for (index = 0; index < TB_CO_STACK_POOL_CLASS_MAXN; index++)
+    {
+        tb_size_t                   size = tb_co_stack_pool_class_size(pool, index);
+        tb_co_stack_pool_node_t*    node = pool->cache[index];
+        while (node)
+        {
+            // the next node
+            tb_co_stack_pool_node_t* next = node->next;
+
+            // unmap this stack
+            tb_co_stack_pool_unmap(pool, (tb_byte_t*)(node + 1) - size, size);
+
+            // the next node
+            node = next;
+        }
+        pool->cache[index]          = tb_null;
+        pool->cache_count[index]    = 0;
+    }
+
+    // leave
+    tb_spinlock_leave(&pool->lock);
+
+    // exit lock
+    tb_spinlock_exit(&pool->lock);
+
+    // exit it
+    tb_free(pool);
+}
+tb_size_t tb_co_stack_pool_align(tb_co_stack_pool_ref_t self, tb_size_t size)
+{
+    // check
+    tb_co_stack_pool_t* pool = (tb_co_stack_pool_t*)self;
+    tb_assert_and_check_return_val(pool && size, 0);
+
+    // the size class
+    tb_size_t index = tb_co_stack_pool_class(size);
+
+    // align to the size class or the page size if be too large
+    return index < TB_CO_STACK_POOL_CLASS_MAXN? tb_co_stack_pool_class_size(pool, index) : tb_align(size, pool->pagesize);
+}
+tb_byte_t* tb_co_stack_pool_malloc(tb_co_stack_pool_ref_t self, tb_size_t size)
+{
+    // check
+    tb_co_stack_pool_t* pool = (tb_co_stack_pool_t*)self;
+    tb_assert_and_check_return_val(pool && size, tb_null);
+
+    // align size
+    size = tb_co_stack_pool_align(self, size);
+
+    // get a cached stack from the size class 
+    tb_byte_t* data = tb_null;
+    tb_size_t  index = tb_co_stack_pool_class(size);
+    if (index < TB_CO_STACK_POOL_CLASS_MAXN)
+    {
+        // enter
+        tb_spinlock_enter(&pool->lock);
+
+        // pop it
+        tb_co_stack_pool_node_t* node = pool->cache[index];
+        if (node)
+        {
+            pool->cache[index] = node->next;
+            pool->cache_count[index]--;
+            data = (tb_byte_t*)(node + 1) - size;
+        }
+
+        // leave
+        tb_spinlock_leave(&pool->lock);
+    }
+
+    // trace
+    tb_trace_d("malloc: %lu bytes, cached: %s", size, data? "ok" : "no");
+
+    // map a new stack if no cached stacks
+    return data? data : tb_co_stack_pool_map(pool, size);
+}
+tb_void_t tb_co_stack_pool_free(tb_co_stack_pool_ref_t self, tb_byte_t* data, tb_size_t size)
+{
+    // check
+    tb_co_stack_pool_t* pool = (tb_co_stack_pool_t*)self;
+    tb_assert_and_check_return(pool && data && size);
+
+    // attempt to cache it
+    tb_size_t index = tb_co_stack_pool_class(size);
+    if (index < TB_CO_STACK_POOL_CLASS_MAXN)
+    {
+        // check
+        tb_assert(size == tb_co_stack_pool_class_size(pool, index));
+
+        // get the cached stacks count
+        tb_spinlock_enter(&pool->lock);
+        tb_size_t count = pool->cache_count[index];
+        tb_spinlock_leave(&pool->lock);
+
+        /* return the physical pages to the system if there are too many cached stacks, 
+         * but keep the top page for the cached node
+         *
+         * the stacks below the high-water mark keep their pages, so we need not call madvise() for each exited coroutine
+         */
+        if (count >= TB_CO_STACK_POOL_CACHE_HIGH && count < TB_CO_STACK_POOL_CACHE_MAXN && size > pool->pagesize)
+        {
+            if (!tb_virtual_memory_reset(data, size - pool->pagesize))
+            {
+                // trace
+                tb_trace_d("reset stack(%p) failed!", data);
+            }
+        }
+
+        // enter
+        tb_spinlock_enter(&pool->lock);
+
+        // push it
+        tb_bool_t cached = tb_false;
+        if (pool->cache_count[index] < TB_CO_STACK_POOL_CACHE_MAXN)
+        {
+            tb_co_stack_pool_node_t* node = (tb_co_stack_pool_node_t*)(data + size) - 1;
+            node->next = pool->cache[index];
+            pool->cache[index] = node;
+            pool->cache_count[index]++;
+            cached = tb_true;
+        }
+
+        // leave
+        tb_spinlock_leave(&pool->lock);
+
+        // cached?
+        tb_check_return(!cached);
+    }
+
+    // unmap it
+    tb_co_stack_pool_unmap(pool, data, size);
+}
@@ -0,0 +1,109 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        stack_pool.h
+ * @ingroup     coroutine
+ *
+ */
+#ifndef TB_COROUTINE_IMPL_STACK_POOL_H
+#define TB_COROUTINE_IMPL_STACK_POOL_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the coroutine stack pool ref type
+typedef __tb_typeref__(co_stack_pool);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* the global coroutine stack pool instance
+ *
+ * @return                  the stack pool
+ */
+tb_co_stack_pool_ref_t      tb_co_stack_pool(tb_noarg_t);
+
+/* init the stack pool
+ *
+ * the stacks are page-aligned virtual memory with a guard page below them,
+ * they are committed lazily and the freed stacks are cached for each size class,
+ * and the physical pages of cached stacks will be returned to the system.
+ *
+ *  -----------------------------------------
+ * | guard page | ......... stack ......... |
+ *  -----------------------------------------
+ *              |                           |
+ *             data                     data + size
+ *
+ * @return                  the stack pool
+ */
+tb_co_stack_pool_ref_t      tb_co_stack_pool_init(tb_noarg_t);
+
+/* exit the stack pool
+ *
+ * @param pool              the stack pool
+ */
+tb_void_t                   tb_co_stack_pool_exit(tb_co_stack_pool_ref_t pool);
+
+/* get the aligned stack size of the size class
+ *
+ * @param pool              the stack pool
+ * @param size              the stack size
+ *
+ * @return                  the aligned stack size
+ */
+tb_size_t                   tb_co_stack_pool_align(tb_co_stack_pool_ref_t pool, tb_size_t size);
+
+/* malloc stack
+ *
+ * @param pool              the stack pool
+ * @param size              the stack size, it will be aligned by tb_co_stack_pool_align()
+ *
+ * @return                  the stack data (the lowest address)
+ */
+tb_byte_t*                  tb_co_stack_pool_malloc(tb_co_stack_pool_ref_t pool, tb_size_t size);
+
+/* free stack
+ *
+ * @param pool              the stack pool
+ * @param data              the stack data
+ * @param size              the aligned stack size
+ */
+tb_void_t                   tb_co_stack_pool_free(tb_co_stack_pool_ref_t pool, tb_byte_t* data, tb_size_t size);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
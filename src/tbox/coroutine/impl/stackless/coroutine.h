@@ -30,6 +30,27 @@
  */
 #include "prefix.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the size class step of the user private data for pass()
+#define TB_LO_COROUTINE_PASS_CLASS_STEP         (16)
+
+// the size class count of the user private data for pass(), larger data will not be cached
+#ifdef __tb_small__
+#   define TB_LO_COROUTINE_PASS_CLASS_MAXN      (8)
+#else
+#   define TB_LO_COROUTINE_PASS_CLASS_MAXN      (16)
+#endif
+
+// the cached user private data maximum count of each size class for pass()
+#ifdef __tb_small__
+#   define TB_LO_COROUTINE_PASS_CACHE_MAXN      (64)
+#else
+#   define TB_LO_COROUTINE_PASS_CACHE_MAXN      (256)
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -39,6 +60,20 @@ __tb_extern_c_enter__
  * types
  */
 
+/* the head type of the user private data for pass()
+ *
+ * head: |-- next --|-- class --|-- data .. --|
+ */
+typedef struct __tb_lo_coroutine_pass_t
+{
+    // the next cached data
+    struct __tb_lo_coroutine_pass_t*    next;
+
+    // the size class index, it will not be cached if be -1
+    tb_size_t                           index;
+
+}tb_lo_coroutine_pass_t;
+
 // the coroutine wait type
 typedef struct __tb_lo_coroutine_rs_wait_t
 {
@@ -89,6 +124,9 @@ typedef struct __tb_lo_coroutine_t
     // the scheduler
     tb_lo_scheduler_ref_t       scheduler;
 
+    // is the coroutine of scheduler group?
+    tb_size_t                   grouped;
+
     // the passed private data between resume() and suspend()
     union 
     {
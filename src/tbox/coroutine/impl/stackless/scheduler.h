@@ -58,6 +58,9 @@ __tb_extern_c_enter__
 // the io scheduler type
 struct __tb_lo_scheduler_io_t;
 
+// the scheduler group type
+struct __tb_lo_scheduler_group_t;
+
 /// the stackless coroutine scheduler type
 typedef struct __tb_lo_scheduler_t
 {
@@ -84,6 +87,35 @@ typedef struct __tb_lo_scheduler_t
     // the suspend coroutines
     tb_list_entry_head_t            coroutines_suspend;
 
+    /* the cached user private data of pass() for each size class
+     *
+     * they are only accessed on the thread of this scheduler,
+     * so we can start coroutines without any global allocation after warming up
+     */
+    tb_lo_coroutine_pass_t*         pass_cache[TB_LO_COROUTINE_PASS_CLASS_MAXN];
+
+    // the cached user private data count for each size class
+    tb_uint16_t                     pass_cache_count[TB_LO_COROUTINE_PASS_CLASS_MAXN];
+
+    // the scheduler group, only for the worker scheduler of group
+    struct __tb_lo_scheduler_group_t* group;
+
+    // is idle? only waiting io events and timers in the io loop
+    tb_atomic_t                     idle;
+
+    // the pending coroutines count, we can get it without lock
+    tb_atomic_t                     pending_count;
+
+    // the pending lock
+    tb_spinlock_t                   pending_lock;
+
+    /* the pending coroutines
+     *
+     * the started but not yet running coroutines of the worker scheduler in group,
+     * they will be pulled to the ready coroutines or be stolen by other idle workers
+     */
+    tb_list_entry_head_t            coroutines_pending;
+
 }tb_lo_scheduler_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -114,6 +146,17 @@ tb_void_t               tb_lo_scheduler_resume(tb_lo_scheduler_t* scheduler, tb_
  */
 tb_lo_scheduler_ref_t   tb_lo_scheduler_self_(tb_noarg_t);
 
+/* pull some pending coroutines to the ready coroutines
+ *
+ * only for the worker scheduler of group,
+ * it will steal some pending coroutines from other workers if no own pending coroutines
+ *
+ * @param scheduler     the scheduler
+ *
+ * @return              the pulled coroutines count
+ */
+tb_size_t               tb_lo_scheduler_pull(tb_lo_scheduler_t* scheduler);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -0,0 +1,296 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        scheduler_group.c
+ * @ingroup     coroutine
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "scheduler_group"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "scheduler_group.h"
+#include "scheduler_io.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the minimum pending coroutines count of the busy worker to wake up the idle workers for stealing
+#ifdef __tb_small__
+#   define TB_LO_SCHEDULER_GROUP_STEAL_MINN     (8)
+#else
+#   define TB_LO_SCHEDULER_GROUP_STEAL_MINN     (32)
+#endif
+
+// the batch count of exchanging the dead coroutines and pass() data with the depot
+#define TB_LO_SCHEDULER_GROUP_DEPOT_BATCH       (64)
+
+// the maximum count of the dead coroutines or pass() data of each size class in the depot
+#ifdef __tb_small__
+#   define TB_LO_SCHEDULER_GROUP_DEPOT_MAXN     (256)
+#else
+#   define TB_LO_SCHEDULER_GROUP_DEPOT_MAXN     (8192)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_bool_t tb_lo_scheduler_group_wakeup(tb_lo_scheduler_t* scheduler)
+{
+    // check
+    tb_assert(scheduler);
+
+    /* clear the idle state and spak it if this worker is idle
+     *
+     * we only spak it once for all pushed coroutines before it wakes up
+     */
+    if (!tb_atomic_fetch_and_pset(&scheduler->idle, 1, 0)) return tb_false;
+
+    // spak the poller of this worker
+    tb_lo_scheduler_io_ref_t scheduler_io = tb_lo_scheduler_io(scheduler);
+    if (scheduler_io && scheduler_io->poller) tb_poller_spak(scheduler_io->poller);
+
+    // ok
+    return tb_true;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_void_t tb_lo_scheduler_group_push(tb_lo_scheduler_group_t* group, tb_lo_scheduler_t* scheduler, tb_lo_coroutine_t* coroutine)
+{
+    // check
+    tb_assert(group && scheduler && coroutine && scheduler->group == group);
+
+    // one more alive coroutine
+    tb_atomic_fetch_and_inc(&group->alive);
+
+    // push it to the pending coroutines
+    tb_spinlock_enter(&scheduler->pending_lock);
+    tb_list_entry_insert_tail(&scheduler->coroutines_pending, &coroutine->entry);
+    tb_atomic_fetch_and_inc(&scheduler->pending_count);
+    tb_spinlock_leave(&scheduler->pending_lock);
+
+    // trace
+    tb_trace_d("push coroutine(%p) to worker(%p), pending: %ld", coroutine, scheduler, tb_atomic_get(&scheduler->pending_count));
+
+    // wake up this worker if it is idle
+    if (tb_lo_scheduler_group_wakeup(scheduler)) return ;
+
+    /* this worker is busy now, wake up one of other idle workers to steal them if there are enough pending coroutines
+     *
+     * the stackless coroutines are very small, waking up the idle worker for each coroutine will cost more than running it,
+     * and this worker will pull the own pending coroutines after each round of the ready coroutines.
+     */
+    tb_check_return(tb_atomic_get(&scheduler->pending_count) >= TB_LO_SCHEDULER_GROUP_STEAL_MINN);
+    tb_size_t i = 0;
+    tb_size_t n = group->count;
+    for (i = 0; i < n; i++)
+    {
+        tb_lo_scheduler_t* worker = group->workers[i];
+        if (worker != scheduler && tb_lo_scheduler_group_wakeup(worker)) break;
+    }
+}
+tb_void_t tb_lo_scheduler_group_done(tb_lo_scheduler_group_t* group)
+{
+    // check
+    tb_assert(group);
+
+    // all coroutines have been finished?
+    if (!tb_atomic_dec_and_fetch(&group->alive))
+    {
+        // trace
+        tb_trace_d("all coroutines have been finished!");
+
+        // spak all workers to finish their loops
+        tb_size_t i = 0;
+        tb_size_t n = group->count;
+        for (i = 0; i < n; i++)
+        {
+            tb_lo_scheduler_io_ref_t scheduler_io = tb_lo_scheduler_io(group->workers[i]);
+            if (scheduler_io && scheduler_io->poller) tb_poller_spak(scheduler_io->poller);
+        }
+    }
+}
+tb_lo_scheduler_t* tb_lo_scheduler_group_victim(tb_lo_scheduler_group_t* group, tb_lo_scheduler_t* scheduler)
+{
+    // check
+    tb_assert(group);
+
+    // find the busiest worker which have enough pending coroutines
+    tb_size_t           i = 0;
+    tb_size_t           n = group->count;
+    tb_long_t           pending_maxn = TB_LO_SCHEDULER_GROUP_STEAL_MINN - 1;
+    tb_lo_scheduler_t*  victim = tb_null;
+    for (i = 0; i < n; i++)
+    {
+        tb_lo_scheduler_t* worker = group->workers[i];
+        if (worker != scheduler)
+        {
+            tb_long_t pending = tb_atomic_get(&worker->pending_count);
+            if (pending > pending_maxn)
+            {
+                pending_maxn    = pending;
+                victim          = worker;
+            }
+        }
+    }
+
+    // ok?
+    return victim;
+}
+tb_void_t tb_lo_scheduler_group_depot_put(tb_lo_scheduler_group_t* group, tb_lo_scheduler_t* scheduler)
+{
+    // check
+    tb_assert(group && scheduler);
+
+    // enter lock
+    tb_spinlock_enter(&group->depot_lock);
+
+    // move a batch of the oldest dead coroutines to the depot
+    tb_size_t count = tb_min(TB_LO_SCHEDULER_GROUP_DEPOT_BATCH, tb_list_entry_size(&scheduler->coroutines_dead));
+    tb_size_t moved = 0;
+    while (moved < count && tb_list_entry_size(&group->depot_coroutines) < TB_LO_SCHEDULER_GROUP_DEPOT_MAXN)
+    {
+        tb_list_entry_ref_t entry = tb_list_entry_head(&scheduler->coroutines_dead);
+        tb_list_entry_remove_head(&scheduler->coroutines_dead);
+        tb_list_entry_insert_tail(&group->depot_coroutines, entry);
+        moved++;
+    }
+
+    // update the depot count
+    tb_atomic_set(&group->depot_coroutines_count, tb_list_entry_size(&group->depot_coroutines));
+
+    // leave lock
+    tb_spinlock_leave(&group->depot_lock);
+
+    // the depot is full? free the others
+    while (moved++ < count)
+    {
+        tb_list_entry_ref_t entry = tb_list_entry_head(&scheduler->coroutines_dead);
+        tb_list_entry_remove_head(&scheduler->coroutines_dead);
+        tb_lo_coroutine_exit((tb_lo_coroutine_t*)tb_list_entry(&scheduler->coroutines_dead, entry));
+    }
+}
+tb_size_t tb_lo_scheduler_group_depot_get(tb_lo_scheduler_group_t* group, tb_lo_scheduler_t* scheduler)
+{
+    // check
+    tb_assert(group && scheduler);
+
+    // the depot is empty? do not enter lock
+    tb_check_return_val(tb_atomic_get(&group->depot_coroutines_count), 0);
+
+    // enter lock
+    tb_spinlock_enter(&group->depot_lock);
+
+    // move a batch of the dead coroutines to this worker
+    tb_size_t count = tb_min(TB_LO_SCHEDULER_GROUP_DEPOT_BATCH, tb_list_entry_size(&group->depot_coroutines));
+    tb_size_t moved = count;
+    while (count--)
+    {
+        tb_list_entry_ref_t entry = tb_list_entry_head(&group->depot_coroutines);
+        tb_list_entry_remove_head(&group->depot_coroutines);
+        tb_list_entry_insert_tail(&scheduler->coroutines_dead, entry);
+    }
+
+    // update the depot count
+    tb_atomic_set(&group->depot_coroutines_count, tb_list_entry_size(&group->depot_coroutines));
+
+    // leave lock
+    tb_spinlock_leave(&group->depot_lock);
+
+    // ok
+    return moved;
+}
+tb_void_t tb_lo_scheduler_group_depot_put_pass(tb_lo_scheduler_group_t* group, tb_lo_scheduler_t* scheduler, tb_size_t index)
+{
+    // check
+    tb_assert(group && scheduler && index < TB_LO_COROUTINE_PASS_CLASS_MAXN);
+
+    // enter lock
+    tb_spinlock_enter(&group->depot_lock);
+
+    // move a batch of the cached data to the depot
+    tb_size_t moved = 0;
+    while (moved < TB_LO_SCHEDULER_GROUP_DEPOT_BATCH && scheduler->pass_cache[index] && tb_atomic_get(&group->depot_pass_count[index]) < TB_LO_SCHEDULER_GROUP_DEPOT_MAXN)
+    {
+        tb_lo_coroutine_pass_t* pass = scheduler->pass_cache[index];
+        scheduler->pass_cache[index] = pass->next;
+        pass->next = group->depot_pass[index];
+        group->depot_pass[index] = pass;
+        tb_atomic_fetch_and_inc(&group->depot_pass_count[index]);
+        moved++;
+    }
+
+    // leave lock
+    tb_spinlock_leave(&group->depot_lock);
+
+    // the depot is full? free the others
+    while (moved < TB_LO_SCHEDULER_GROUP_DEPOT_BATCH && scheduler->pass_cache[index])
+    {
+        tb_lo_coroutine_pass_t* pass = scheduler->pass_cache[index];
+        scheduler->pass_cache[index] = pass->next;
+        tb_free(pass);
+        moved++;
+    }
+
+    // update the cached count
+    scheduler->pass_cache_count[index] -= (tb_uint16_t)moved;
+}
+tb_size_t tb_lo_scheduler_group_depot_get_pass(tb_lo_scheduler_group_t* group, tb_lo_scheduler_t* scheduler, tb_size_t index)
+{
+    // check
+    tb_assert(group && scheduler && index < TB_LO_COROUTINE_PASS_CLASS_MAXN);
+
+    // the depot is empty? do not enter lock
+    tb_check_return_val(tb_atomic_get(&group->depot_pass_count[index]), 0);
+
+    // enter lock
+    tb_spinlock_enter(&group->depot_lock);
+
+    // move a batch of the cached data to this worker
+    tb_size_t moved = 0;
+    while (moved < TB_LO_SCHEDULER_GROUP_DEPOT_BATCH && group->depot_pass[index])
+    {
+        tb_lo_coroutine_pass_t* pass = group->depot_pass[index];
+        group->depot_pass[index] = pass->next;
+        pass->next = scheduler->pass_cache[index];
+        scheduler->pass_cache[index] = pass;
+        moved++;
+    }
+    tb_atomic_fetch_and_sub(&group->depot_pass_count[index], moved);
+
+    // leave lock
+    tb_spinlock_leave(&group->depot_lock);
+
+    // update the cached count
+    scheduler->pass_cache_count[index] += (tb_uint16_t)moved;
+
+    // ok
+    return moved;
+}
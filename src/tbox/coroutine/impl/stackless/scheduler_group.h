@@ -0,0 +1,156 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        scheduler_group.h
+ * @ingroup     coroutine
+ *
+ */
+#ifndef TB_COROUTINE_IMPL_STACKLESS_SCHEDULER_GROUP_H
+#define TB_COROUTINE_IMPL_STACKLESS_SCHEDULER_GROUP_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "scheduler.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// get the alive coroutines count of the scheduler group
+#define tb_lo_scheduler_group_alive(group)          tb_atomic_get(&(group)->alive)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the stackless scheduler group type
+typedef struct __tb_lo_scheduler_group_t
+{
+    // the worker schedulers
+    tb_lo_scheduler_t**             workers;
+
+    // the worker threads, the first worker will be run on the current thread of loop()
+    tb_thread_ref_t*                threads;
+
+    // the workers count
+    tb_size_t                       count;
+
+    // the alive coroutines count of all workers (exclude the io loop coroutines)
+    tb_atomic_t                     alive;
+
+    // the next worker index for starting coroutines
+    tb_atomic_t                     next;
+
+    /* the depot lock
+     *
+     * the coroutines may be finished on the other worker after stealing,
+     * so the workers exchange their dead coroutines and pass() data with the depot in batches
+     */
+    tb_spinlock_t                   depot_lock;
+
+    // the dead coroutines in depot
+    tb_list_entry_head_t            depot_coroutines;
+
+    // the dead coroutines count in depot, we can get it without lock
+    tb_atomic_t                     depot_coroutines_count;
+
+    // the cached pass() data of each size class in depot
+    tb_lo_coroutine_pass_t*         depot_pass[TB_LO_COROUTINE_PASS_CLASS_MAXN];
+
+    // the cached pass() data count of each size class in depot, we can get it without lock
+    tb_atomic_t                     depot_pass_count[TB_LO_COROUTINE_PASS_CLASS_MAXN];
+
+}tb_lo_scheduler_group_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* push the started coroutine to the pending coroutines of the given worker
+ *
+ * @param group             the scheduler group
+ * @param scheduler         the worker scheduler
+ * @param coroutine         the started coroutine
+ */
+tb_void_t                   tb_lo_scheduler_group_push(tb_lo_scheduler_group_t* group, tb_lo_scheduler_t* scheduler, tb_lo_coroutine_t* coroutine);
+
+/* the grouped coroutine have been finished
+ *
+ * @param group             the scheduler group
+ */
+tb_void_t                   tb_lo_scheduler_group_done(tb_lo_scheduler_group_t* group);
+
+/* get the busiest worker which have the most pending coroutines for stealing
+ *
+ * @param group             the scheduler group
+ * @param scheduler         the current worker scheduler (thief)
+ *
+ * @return                  the victim worker, return tb_null if no pending coroutines
+ */
+tb_lo_scheduler_t*          tb_lo_scheduler_group_victim(tb_lo_scheduler_group_t* group, tb_lo_scheduler_t* scheduler);
+
+/* put a batch of the oldest dead coroutines of the given worker to the depot
+ *
+ * @param group             the scheduler group
+ * @param scheduler         the current worker scheduler
+ */
+tb_void_t                   tb_lo_scheduler_group_depot_put(tb_lo_scheduler_group_t* group, tb_lo_scheduler_t* scheduler);
+
+/* get a batch of the dead coroutines from the depot to the given worker
+ *
+ * @param group             the scheduler group
+ * @param scheduler         the current worker scheduler
+ *
+ * @return                  the got coroutines count
+ */
+tb_size_t                   tb_lo_scheduler_group_depot_get(tb_lo_scheduler_group_t* group, tb_lo_scheduler_t* scheduler);
+
+/* put a batch of the cached pass() data of the given worker to the depot
+ *
+ * @param group             the scheduler group
+ * @param scheduler         the current worker scheduler
+ * @param index             the size class index
+ */
+tb_void_t                   tb_lo_scheduler_group_depot_put_pass(tb_lo_scheduler_group_t* group, tb_lo_scheduler_t* scheduler, tb_size_t index);
+
+/* get a batch of the cached pass() data from the depot to the given worker
+ *
+ * @param group             the scheduler group
+ * @param scheduler         the current worker scheduler
+ * @param index             the size class index
+ *
+ * @return                  the got data count
+ */
+tb_size_t                   tb_lo_scheduler_group_depot_get_pass(tb_lo_scheduler_group_t* group, tb_lo_scheduler_t* scheduler, tb_size_t index);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
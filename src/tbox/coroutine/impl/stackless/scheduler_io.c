@@ -34,6 +34,7 @@
  * includes
  */
 #include "scheduler_io.h"
+#include "scheduler_group.h"
 #include "coroutine.h"
 #include "../../stackless/coroutine.h"
 
@@ -177,16 +178,42 @@ static tb_void_t tb_lo_scheduler_io_loop(tb_lo_coroutine_ref_t coroutine, tb_cpo
                 // spak timer
                 if (!tb_lo_scheduler_io_timer_spak(scheduler_io)) break;
 #endif
+
+                /* pull the own pending coroutines once per round of the ready coroutines
+                 *
+                 * the busy worker need run the spawned coroutines as soon as possible to reuse their caches,
+                 * and the other half of them will be left to be stolen by the idle workers
+                 */
+                if (scheduler->group && tb_atomic_get(&scheduler->pending_count)) tb_lo_scheduler_pull(scheduler);
             }
 
+            // is the worker scheduler of group?
+            if (scheduler->group)
+            {
+                // mark as idle first, other workers will spak us after pushing new pending coroutines
+                tb_atomic_set(&scheduler->idle, 1);
+
+                // pull some pending coroutines and continue to run them
+                if (tb_lo_scheduler_pull(scheduler))
+                {
+                    tb_atomic_set0(&scheduler->idle);
+                    continue;
+                }
+
+                // all coroutines of group have been finished? loop end
+                tb_check_break(tb_lo_scheduler_group_alive(scheduler->group));
+            }
             // no more suspended coroutines? loop end
-            tb_check_break(tb_lo_scheduler_suspend_count(scheduler));
+            else tb_check_break(tb_lo_scheduler_suspend_count(scheduler));
 
             // trace
             tb_trace_d("loop: wait %ld ms ..", tb_lo_scheduler_io_timer_delay(scheduler_io));
 
             // no more ready coroutines? wait io events and timers (TODO)
             if (tb_poller_wait(scheduler_io->poller, tb_lo_scheduler_io_events, tb_lo_scheduler_io_timer_delay(scheduler_io)) < 0) break;
+
+            // clear the idle state
+            if (scheduler->group) tb_atomic_set0(&scheduler->idle);
  
 #ifndef TB_CONFIG_MICRO_ENABLE
             // spak timer
@@ -452,26 +479,27 @@ tb_bool_t tb_lo_scheduler_io_cancel(tb_lo_scheduler_io_ref_t scheduler_io, tb_so
     tb_trace_d("coroutine(%p): cancel socket(%p) ..", coroutine, sock);
 
     // remove the this socket from poller
+    tb_bool_t ok = tb_false;
     if (coroutine->rs.wait.sock == sock)
     {
         // remove the previous socket first if exists
-        if (!tb_poller_remove(scheduler_io->poller, sock))
+        ok = tb_poller_remove(scheduler_io->poller, sock);
+        if (!ok)
         {
             // trace
             tb_trace_e("failed to remove sock(%p) to poller on coroutine(%p)!", sock, coroutine);
-
-            // failed
-            coroutine->rs.wait.events_result = -1;
-            return tb_false;
         }
-
-        // remove ok
-        coroutine->rs.wait.events_result = 0;
-        return tb_true;
+        coroutine->rs.wait.events_result = ok? 0 : -1;
     }
 
-    // no this socket
-    return tb_false;
+    /* cancel all pending requests of this socket in kernel before closing it
+     *
+     * the completion-based poller (e.g. io_uring) will keep this socket open until these requests are finished
+     */
+    tb_poller_cancel(scheduler_io->poller, sock);
+
+    // ok?
+    return ok;
 }
 tb_lo_scheduler_io_ref_t tb_lo_scheduler_io_self()
 {
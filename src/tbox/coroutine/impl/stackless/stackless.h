@@ -31,5 +31,6 @@
 #include "coroutine.h"
 #include "scheduler.h"
 #include "scheduler_io.h"
+#include "scheduler_group.h"
 
 #endif
@@ -0,0 +1,333 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        timer_wheel.c
+ * @ingroup     coroutine
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "timer_wheel"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "timer_wheel.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the slot mask of each level
+#define TB_CO_TIMER_WHEEL_MASK              (TB_CO_TIMER_WHEEL_SLOTN - 1)
+
+// the slot index of the overflow list
+#define TB_CO_TIMER_WHEEL_SLOT_OVERFLOW     (TB_CO_TIMER_WHEEL_LEVELS * TB_CO_TIMER_WHEEL_SLOTN)
+
+// the slot index of the expired list
+#define TB_CO_TIMER_WHEEL_SLOT_EXPIRED      (TB_CO_TIMER_WHEEL_SLOT_OVERFLOW + 1)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_void_t tb_co_timer_wheel_list_init(tb_list_entry_ref_t list)
+{
+    list->next = list;
+    list->prev = list;
+}
+static __tb_inline__ tb_bool_t tb_co_timer_wheel_list_empty(tb_list_entry_ref_t list)
+{
+    return list->next == list;
+}
+static __tb_inline__ tb_void_t tb_co_timer_wheel_list_insert(tb_list_entry_ref_t list, tb_list_entry_ref_t entry)
+{
+    // insert it to the tail
+    entry->prev         = list->prev;
+    entry->next         = list;
+    list->prev->next    = entry;
+    list->prev          = entry;
+}
+static __tb_inline__ tb_void_t tb_co_timer_wheel_list_remove(tb_list_entry_ref_t entry)
+{
+    // remove it
+    entry->prev->next   = entry->next;
+    entry->next->prev   = entry->prev;
+
+    // mark as not pending
+    entry->next         = tb_null;
+    entry->prev         = tb_null;
+}
+static __tb_inline__ tb_void_t tb_co_timer_wheel_list_move(tb_list_entry_ref_t list, tb_list_entry_ref_t from)
+{
+    // init the target list
+    tb_co_timer_wheel_list_init(list);
+
+    // move all entries of the given list
+    if (!tb_co_timer_wheel_list_empty(from))
+    {
+        list->next          = from->next;
+        list->prev          = from->prev;
+        list->next->prev    = list;
+        list->prev->next    = list;
+        tb_co_timer_wheel_list_init(from);
+    }
+}
+static tb_void_t tb_co_timer_wheel_add(tb_co_timer_wheel_t* wheel, tb_co_timer_wheel_task_t* task)
+{
+    // check
+    tb_assert(wheel && task && !tb_co_timer_wheel_task_pending(task));
+
+    // expired? 
+    if (task->when <= wheel->now)
+    {
+        // done it in the next spak
+        task->slot = TB_CO_TIMER_WHEEL_SLOT_EXPIRED;
+        tb_co_timer_wheel_list_insert(&wheel->expired, &task->entry);
+    }
+    else
+    {
+        // get the level of the highest different digit between the expired time and the current time
+        tb_size_t level = 0;
+        tb_hize_t diff  = (task->when ^ wheel->now) >> TB_CO_TIMER_WHEEL_BITS;
+        while (diff && level < TB_CO_TIMER_WHEEL_LEVELS)
+        {
+            diff >>= TB_CO_TIMER_WHEEL_BITS;
+            level++;
+        }
+
+        // too far? insert it to the overflow list
+        if (level >= TB_CO_TIMER_WHEEL_LEVELS)
+        {
+            task->slot = TB_CO_TIMER_WHEEL_SLOT_OVERFLOW;
+            tb_co_timer_wheel_list_insert(&wheel->overflow, &task->entry);
+        }
+        else
+        {
+            // insert it to the slot of this level, the slot is always after the current digit
+            tb_size_t slot = (tb_size_t)(task->when >> (level * TB_CO_TIMER_WHEEL_BITS)) & TB_CO_TIMER_WHEEL_MASK;
+            task->slot = (tb_uint16_t)(level * TB_CO_TIMER_WHEEL_SLOTN + slot);
+            tb_co_timer_wheel_list_insert(&wheel->slots[level][slot], &task->entry);
+            wheel->bitmap[level] |= ((tb_uint64_t)1 << slot);
+        }
+    }
+
+    // update count
+    wheel->count++;
+}
+static tb_void_t tb_co_timer_wheel_del(tb_co_timer_wheel_t* wheel, tb_co_timer_wheel_task_t* task)
+{
+    // check
+    tb_assert(wheel && task && tb_co_timer_wheel_task_pending(task) && wheel->count);
+
+    // remove it
+    tb_co_timer_wheel_list_remove(&task->entry);
+
+    // clear the bit of this slot if it becomes empty
+    if (task->slot < TB_CO_TIMER_WHEEL_SLOT_OVERFLOW)
+    {
+        tb_size_t level = task->slot / TB_CO_TIMER_WHEEL_SLOTN;
+        tb_size_t slot  = task->slot & TB_CO_TIMER_WHEEL_MASK;
+        if (tb_co_timer_wheel_list_empty(&wheel->slots[level][slot])) 
+            wheel->bitmap[level] &= ~((tb_uint64_t)1 << slot);
+    }
+
+    // update count
+    wheel->count--;
+}
+static tb_hize_t tb_co_timer_wheel_next(tb_co_timer_wheel_t* wheel, tb_size_t* plevel)
+{
+    // check
+    tb_assert(wheel && plevel);
+
+    /* find the first non-empty slot after the current digit from the lowest level
+     *
+     * the lower levels are always earlier than the higher levels, 
+     * and all slots before or at the current digit are empty.
+     */
+    tb_size_t level = 0;
+    for (level = 0; level < TB_CO_TIMER_WHEEL_LEVELS; level++)
+    {
+        // the current digit of this level
+        tb_size_t   shift = level * TB_CO_TIMER_WHEEL_BITS;
+        tb_size_t   digit = (tb_size_t)(wheel->now >> shift) & TB_CO_TIMER_WHEEL_MASK;
+        tb_uint64_t bits  = digit < TB_CO_TIMER_WHEEL_MASK? (wheel->bitmap[level] & ((tb_uint64_t)-1 << (digit + 1))) : 0;
+        if (bits)
+        {
+            // the time of this slot with the same higher digits
+            tb_size_t slot = tb_bits_fb1_u64_le(bits);
+            *plevel = level;
+            return (((wheel->now >> shift) >> TB_CO_TIMER_WHEEL_BITS) << (shift + TB_CO_TIMER_WHEEL_BITS)) | ((tb_hize_t)slot << shift);
+        }
+    }
+
+    // the overflow tasks will be checked again when the highest digits are changed
+    if (!tb_co_timer_wheel_list_empty(&wheel->overflow))
+    {
+        tb_size_t shift = TB_CO_TIMER_WHEEL_LEVELS * TB_CO_TIMER_WHEEL_BITS;
+        *plevel = TB_CO_TIMER_WHEEL_LEVELS;
+        return ((wheel->now >> shift) + 1) << shift;
+    }
+
+    // no more tasks
+    return 0;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_co_timer_wheel_ref_t tb_co_timer_wheel_init()
+{
+    // make timer wheel
+    tb_co_timer_wheel_t* wheel = tb_malloc0_type(tb_co_timer_wheel_t);
+    tb_assert_and_check_return_val(wheel, tb_null);
+
+    // init slots
+    tb_size_t level = 0;
+    tb_size_t slot = 0;
+    for (level = 0; level < TB_CO_TIMER_WHEEL_LEVELS; level++)
+    {
+        for (slot = 0; slot < TB_CO_TIMER_WHEEL_SLOTN; slot++)
+            tb_co_timer_wheel_list_init(&wheel->slots[level][slot]);
+    }
+
+    // init overflow and expired lists
+    tb_co_timer_wheel_list_init(&wheel->overflow);
+    tb_co_timer_wheel_list_init(&wheel->expired);
+
+    // init the current time
+    wheel->now = (tb_hize_t)tb_cache_time_mclock();
+
+    // ok
+    return wheel;
+}
+tb_void_t tb_co_timer_wheel_exit(tb_co_timer_wheel_ref_t wheel)
+{
+    // check
+    tb_assert_and_check_return(wheel);
+
+    // trace
+    tb_trace_d("exit: %lu pending tasks", wheel->count);
+
+    // exit it, the pending tasks are embedded in their owners
+    tb_free(wheel);
+}
+tb_void_t tb_co_timer_wheel_post(tb_co_timer_wheel_ref_t wheel, tb_co_timer_wheel_task_ref_t task, tb_size_t delay, tb_timer_task_func_t func, tb_cpointer_t priv)
+{
+    // check
+    tb_assert_and_check_return(wheel && task && func);
+
+    // cancel it first if it is pending
+    if (tb_co_timer_wheel_task_pending(task)) tb_co_timer_wheel_del(wheel, task);
+
+    // move to the current time directly if no pending tasks
+    tb_hize_t now = (tb_hize_t)tb_cache_time_mclock();
+    if (!wheel->count && now > wheel->now) wheel->now = now;
+
+    // init task
+    task->when  = tb_max(now, wheel->now) + delay;
+    task->func  = func;
+    task->priv  = priv;
+
+    // add it
+    tb_co_timer_wheel_add(wheel, task);
+}
+tb_void_t tb_co_timer_wheel_cancel(tb_co_timer_wheel_ref_t wheel, tb_co_timer_wheel_task_ref_t task)
+{
+    // check
+    tb_assert_and_check_return(wheel && task);
+
+    // remove it if it is pending
+    if (tb_co_timer_wheel_task_pending(task)) tb_co_timer_wheel_del(wheel, task);
+}
+tb_size_t tb_co_timer_wheel_delay(tb_co_timer_wheel_ref_t wheel)
+{
+    // check
+    tb_assert_and_check_return_val(wheel, -1);
+
+    // exists expired tasks? 
+    if (!tb_co_timer_wheel_list_empty(&wheel->expired)) return 0;
+
+    // get the time of the next expired slot or cascaded slot
+    tb_size_t level = 0;
+    tb_hize_t when = tb_co_timer_wheel_next(wheel, &level);
+    tb_check_return_val(when, -1);
+
+    // the delay
+    tb_hize_t now = (tb_hize_t)tb_cache_time_mclock();
+    return when > now? (tb_size_t)(when - now) : 0;
+}
+tb_void_t tb_co_timer_wheel_spak(tb_co_timer_wheel_ref_t wheel)
+{
+    // check
+    tb_assert_and_check_return(wheel);
+
+    // the target time
+    tb_hize_t now = (tb_hize_t)tb_cache_time_mclock();
+
+    // walk all expired or cascaded slots before the target time
+    tb_list_entry_t list;
+    tb_size_t       level = 0;
+    tb_hize_t       when = 0;
+    while (wheel->count && (when = tb_co_timer_wheel_next(wheel, &level)) && when <= now)
+    {
+        // move to this slot
+        wheel->now = when;
+
+        // the slot list
+        tb_size_t           slot = (tb_size_t)(when >> (level * TB_CO_TIMER_WHEEL_BITS)) & TB_CO_TIMER_WHEEL_MASK;
+        tb_list_entry_ref_t from = level < TB_CO_TIMER_WHEEL_LEVELS? &wheel->slots[level][slot] : &wheel->overflow;
+
+        // trace
+        tb_trace_d("spak: level: %lu, slot: %lu, when: %llu", level, slot, when);
+
+        // take all tasks of this slot
+        tb_co_timer_wheel_list_move(&list, from);
+        if (level < TB_CO_TIMER_WHEEL_LEVELS) wheel->bitmap[level] &= ~((tb_uint64_t)1 << slot);
+
+        // re-add them to the lower levels or the expired list
+        while (!tb_co_timer_wheel_list_empty(&list))
+        {
+            tb_co_timer_wheel_task_t* task = (tb_co_timer_wheel_task_t*)tb_list_entry0(list.next);
+            tb_co_timer_wheel_list_remove(&task->entry);
+            wheel->count--;
+            tb_co_timer_wheel_add(wheel, task);
+        }
+    }
+
+    // update the current time
+    if (now > wheel->now) wheel->now = now;
+
+    // take all expired tasks, the new expired tasks posted by them will be done in the next spak
+    tb_co_timer_wheel_list_move(&list, &wheel->expired);
+    while (!tb_co_timer_wheel_list_empty(&list))
+    {
+        // remove it first, it may be posted again in the timer function
+        tb_co_timer_wheel_task_t* task = (tb_co_timer_wheel_task_t*)tb_list_entry0(list.next);
+        tb_co_timer_wheel_list_remove(&task->entry);
+        wheel->count--;
+
+        // done it
+        task->func(tb_false, task->priv);
+    }
+}
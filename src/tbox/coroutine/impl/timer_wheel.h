@@ -0,0 +1,164 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        timer_wheel.h
+ * @ingroup     coroutine
+ *
+ */
+#ifndef TB_COROUTINE_IMPL_TIMER_WHEEL_H
+#define TB_COROUTINE_IMPL_TIMER_WHEEL_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the slot bits of each wheel level
+#define TB_CO_TIMER_WHEEL_BITS              (6)
+
+// the slots count of each wheel level, we use an uint64 bitmap to find the non-empty slots
+#define TB_CO_TIMER_WHEEL_SLOTN             (1 << TB_CO_TIMER_WHEEL_BITS)
+
+// the wheel levels, 64^6 ms (~795 days), the longer timeouts will be placed in the overflow list
+#define TB_CO_TIMER_WHEEL_LEVELS            (6)
+
+// is this timer task pending?
+#define tb_co_timer_wheel_task_pending(task)    ((task)->entry.next != tb_null)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/* the intrusive timer task type
+ *
+ * it need be embedded in the coroutine or the waiting object, 
+ * so inserting and cancelling the timeout need not allocate memory.
+ */
+typedef struct __tb_co_timer_wheel_task_t
+{
+    // the list entry, it is null if this task is not pending
+    tb_list_entry_t                 entry;
+
+    // the expired time (ms)
+    tb_hize_t                       when;
+
+    // the timer function
+    tb_timer_task_func_t            func;
+
+    // the user private data
+    tb_cpointer_t                   priv;
+
+    // the slot index (level * slotn + slot) in the wheel 
+    tb_uint16_t                     slot;
+
+}tb_co_timer_wheel_task_t, *tb_co_timer_wheel_task_ref_t;
+
+/* the hierarchical timing wheel type
+ *
+ * the level of task is decided by the highest different bits between it's expired time and the current time,
+ * so the task of level n will be cascaded to the lower levels when the n-th digit of the current time reaches it's slot.
+ *
+ * it's not thread-safe and only be used in the io scheduler of the current thread.
+ */
+typedef struct __tb_co_timer_wheel_t
+{
+    // the current time (ms), all tasks before or at it have been expired
+    tb_hize_t                       now;
+
+    // the pending tasks count
+    tb_size_t                       count;
+
+    // the non-empty slots bitmap of each level
+    tb_uint64_t                     bitmap[TB_CO_TIMER_WHEEL_LEVELS];
+
+    // the slots
+    tb_list_entry_t                 slots[TB_CO_TIMER_WHEEL_LEVELS][TB_CO_TIMER_WHEEL_SLOTN];
+
+    // the overflow tasks which are too far from the current time
+    tb_list_entry_t                 overflow;
+
+    // the expired tasks which will be done in the next spak
+    tb_list_entry_t                 expired;
+
+}tb_co_timer_wheel_t, *tb_co_timer_wheel_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* init timer wheel
+ *
+ * @return                  the timer wheel
+ */
+tb_co_timer_wheel_ref_t     tb_co_timer_wheel_init(tb_noarg_t);
+
+/* exit timer wheel, the pending tasks will be dropped directly
+ *
+ * @param wheel             the timer wheel
+ */
+tb_void_t                   tb_co_timer_wheel_exit(tb_co_timer_wheel_ref_t wheel);
+
+/* post the timer task, it will be cancelled first if it is pending
+ *
+ * @param wheel             the timer wheel
+ * @param task              the intrusive timer task
+ * @param delay             the delay time (ms)
+ * @param func              the timer function
+ * @param priv              the user private data
+ */
+tb_void_t                   tb_co_timer_wheel_post(tb_co_timer_wheel_ref_t wheel, tb_co_timer_wheel_task_ref_t task, tb_size_t delay, tb_timer_task_func_t func, tb_cpointer_t priv);
+
+/* cancel the timer task if it is pending
+ *
+ * @param wheel             the timer wheel
+ * @param task              the intrusive timer task
+ */
+tb_void_t                   tb_co_timer_wheel_cancel(tb_co_timer_wheel_ref_t wheel, tb_co_timer_wheel_task_ref_t task);
+
+/* the delay time of the next expired task
+ *
+ * @param wheel             the timer wheel
+ *
+ * @return                  the delay time (ms), (tb_size_t)-1 if no tasks
+ */
+tb_size_t                   tb_co_timer_wheel_delay(tb_co_timer_wheel_ref_t wheel);
+
+/* spak the timer wheel and done all expired tasks
+ *
+ * @param wheel             the timer wheel
+ */
+tb_void_t                   tb_co_timer_wheel_spak(tb_co_timer_wheel_ref_t wheel);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -93,6 +93,18 @@ tb_co_scheduler_ref_t tb_co_scheduler_init()
         // init suspend coroutines
         tb_list_entry_init(&scheduler->coroutines_suspend, tb_coroutine_t, entry, tb_null);
 
+        // init pending coroutines
+        tb_list_entry_init(&scheduler->coroutines_pending, tb_coroutine_t, entry, tb_null);
+
+        // init pending lock
+        if (!tb_spinlock_init(&scheduler->pending_lock)) break;
+
+        // init waking coroutines
+        tb_single_list_entry_init(&scheduler->coroutines_waking, tb_coroutine_t, rs.single_entry, tb_null);
+
+        // init waking lock
+        if (!tb_spinlock_init(&scheduler->waking_lock)) break;
+
         // init original coroutine
         scheduler->original.scheduler = (tb_co_scheduler_ref_t)scheduler;
 
@@ -144,6 +156,9 @@ tb_void_t tb_co_scheduler_exit(tb_co_scheduler_ref_t self)
     // free all suspend coroutines 
     tb_co_scheduler_free(&scheduler->coroutines_suspend);
 
+    // free all pending coroutines 
+    tb_co_scheduler_free(&scheduler->coroutines_pending);
+
     // exit dead coroutines
     tb_list_entry_exit(&scheduler->coroutines_dead);
 
@@ -153,6 +168,18 @@ tb_void_t tb_co_scheduler_exit(tb_co_scheduler_ref_t self)
     // exit suspend coroutines
     tb_list_entry_exit(&scheduler->coroutines_suspend);
 
+    // exit pending coroutines
+    tb_list_entry_exit(&scheduler->coroutines_pending);
+
+    // exit pending lock
+    tb_spinlock_exit(&scheduler->pending_lock);
+
+    // exit waking coroutines, they are also in the suspend coroutines
+    tb_single_list_entry_exit(&scheduler->coroutines_waking);
+
+    // exit waking lock
+    tb_spinlock_exit(&scheduler->waking_lock);
+
     // exit the scheduler
     tb_free(scheduler);
 }
@@ -0,0 +1,381 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        scheduler_group.c
+ * @ingroup     coroutine
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "scheduler_group"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "scheduler_group.h"
+#include "impl/impl.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the workers maximum count
+#ifdef __tb_small__
+#   define TB_SCHEDULER_GROUP_WORKER_MAXN       (16)
+#else
+#   define TB_SCHEDULER_GROUP_WORKER_MAXN       (256)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_int_t tb_co_scheduler_group_worker_loop(tb_cpointer_t priv)
+{
+    // check
+    tb_co_scheduler_ref_t scheduler = (tb_co_scheduler_ref_t)priv;
+    tb_assert_and_check_return_val(scheduler, -1);
+
+    // run the worker scheduler, we cannot use the exclusive mode for multi-threads
+    tb_co_scheduler_loop(scheduler, tb_false);
+
+    // ok
+    return 0;
+}
+
+static tb_void_t tb_co_scheduler_group_listener(tb_cpointer_t priv)
+{
+    // check
+    tb_co_scheduler_group_listener_t* listener = (tb_co_scheduler_group_listener_t*)priv;
+    tb_assert_and_check_return(listener && listener->sock && listener->func);
+
+    // the current worker
+    tb_co_scheduler_t* scheduler = (tb_co_scheduler_t*)tb_co_scheduler_self();
+    tb_assert_and_check_return(scheduler);
+
+    // wait the incoming connections
+    while (tb_socket_wait(listener->sock, TB_SOCKET_EVENT_ACPT, -1) > 0)
+    {
+        // drain the accept backlog, we will not be notified again for the pending connections
+        tb_size_t       count = 0;
+        tb_socket_ref_t client = tb_null;
+        while ((client = tb_socket_accept(listener->sock, tb_null)))
+        {
+            // start the client coroutine on the current worker
+            tb_bool_t ok = listener->bound? tb_co_scheduler_start_bound(scheduler, listener->func, client, listener->stacksize) 
+                                          : tb_co_scheduler_start(scheduler, listener->func, client, listener->stacksize);
+            if (!ok)
+            {
+                // the worker has been stopped? exit this connection
+                tb_socket_exit(client);
+                break;
+            }
+            count++;
+        }
+
+        // trace
+        tb_trace_d("worker(%p): accepted %lu", scheduler, count);
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_co_scheduler_group_ref_t tb_co_scheduler_group_init(tb_size_t count)
+{
+    // done
+    tb_bool_t                   ok = tb_false;
+    tb_co_scheduler_group_t*    group = tb_null;
+    do
+    {
+        // init workers count
+        if (!count) count = tb_processor_count();
+        if (!count) count = 1;
+        tb_assert_and_check_break(count <= TB_SCHEDULER_GROUP_WORKER_MAXN);
+
+        // make scheduler group
+        group = tb_malloc0_type(tb_co_scheduler_group_t);
+        tb_assert_and_check_break(group);
+
+        // make workers
+        group->workers = tb_nalloc0_type(count, tb_co_scheduler_t*);
+        tb_assert_and_check_break(group->workers);
+
+        // make threads
+        group->threads = tb_nalloc0_type(count, tb_thread_ref_t);
+        tb_assert_and_check_break(group->threads);
+
+        // init workers
+        tb_size_t i = 0;
+        for (i = 0; i < count; i++)
+        {
+            // init worker scheduler
+            tb_co_scheduler_t* worker = (tb_co_scheduler_t*)tb_co_scheduler_init();
+            tb_assert_and_check_break(worker);
+
+            // save this worker first
+            group->workers[i] = worker;
+            group->count++;
+
+            /* init io scheduler and start the io loop coroutine before attaching the group
+             *
+             * the io loop coroutine will be ready directly instead of pending,
+             * and we can spak it's poller to wake up the idle worker
+             */
+            worker->scheduler_io = tb_co_scheduler_io_init(worker);
+            tb_assert_and_check_break(worker->scheduler_io);
+
+            // attach the group
+            worker->group = group;
+        }
+        tb_assert_and_check_break(i == count);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (group) tb_co_scheduler_group_exit((tb_co_scheduler_group_ref_t)group);
+        group = tb_null;
+    }
+
+    // ok?
+    return (tb_co_scheduler_group_ref_t)group;
+}
+tb_void_t tb_co_scheduler_group_exit(tb_co_scheduler_group_ref_t self)
+{
+    // check
+    tb_co_scheduler_group_t* group = (tb_co_scheduler_group_t*)self;
+    tb_assert_and_check_return(group);
+
+    // exit all workers
+    tb_size_t i = 0;
+    for (i = 0; i < group->count; i++)
+    {
+        // exit the worker thread if be not finished
+        if (group->threads && group->threads[i])
+        {
+            // wait it
+            tb_long_t wait = 0;
+            if ((wait = tb_thread_wait(group->threads[i], 5000, tb_null)) <= 0)
+            {
+                // trace
+                tb_trace_e("worker[%lu]: wait failed: %ld!", i, wait);
+            }
+
+            // exit it
+            tb_thread_exit(group->threads[i]);
+            group->threads[i] = tb_null;
+        }
+
+        // exit the worker scheduler
+        tb_co_scheduler_t* worker = group->workers[i];
+        if (worker)
+        {
+            // stop it first if this worker have been never run
+            worker->stopped = tb_true;
+
+            // exit it
+            tb_co_scheduler_exit((tb_co_scheduler_ref_t)worker);
+            group->workers[i] = tb_null;
+        }
+    }
+
+    // exit listeners
+    while (group->listeners)
+    {
+        tb_co_scheduler_group_listener_t* listener = group->listeners;
+        group->listeners = listener->next;
+        if (listener->sock) tb_socket_exit(listener->sock);
+        tb_free(listener);
+    }
+
+    // exit threads
+    if (group->threads) tb_free(group->threads);
+    group->threads = tb_null;
+
+    // exit workers
+    if (group->workers) tb_free(group->workers);
+    group->workers = tb_null;
+
+    // exit it
+    tb_free(group);
+}
+tb_void_t tb_co_scheduler_group_kill(tb_co_scheduler_group_ref_t self)
+{
+    // check
+    tb_co_scheduler_group_t* group = (tb_co_scheduler_group_t*)self;
+    tb_assert_and_check_return(group && group->workers);
+
+    // kill all workers
+    tb_size_t i = 0;
+    for (i = 0; i < group->count; i++)
+    {
+        if (group->workers[i]) tb_co_scheduler_kill((tb_co_scheduler_ref_t)group->workers[i]);
+    }
+}
+tb_void_t tb_co_scheduler_group_loop(tb_co_scheduler_group_ref_t self)
+{
+    // check
+    tb_co_scheduler_group_t* group = (tb_co_scheduler_group_t*)self;
+    tb_assert_and_check_return(group && group->workers && group->threads && group->count);
+
+    // start the other workers
+    tb_size_t i = 0;
+    for (i = 1; i < group->count; i++)
+    {
+        group->threads[i] = tb_thread_init(__tb_lstring__("co_worker"), tb_co_scheduler_group_worker_loop, group->workers[i], 0);
+        tb_assert(group->threads[i]);
+    }
+
+    // run the first worker on the current thread
+    tb_co_scheduler_group_worker_loop(group->workers[0]);
+
+    // wait the other workers
+    for (i = 1; i < group->count; i++)
+    {
+        if (group->threads[i])
+        {
+            // wait it
+            tb_thread_wait(group->threads[i], -1, tb_null);
+
+            // exit it
+            tb_thread_exit(group->threads[i]);
+            group->threads[i] = tb_null;
+        }
+    }
+}
+tb_size_t tb_co_scheduler_group_size(tb_co_scheduler_group_ref_t self)
+{
+    // check
+    tb_co_scheduler_group_t* group = (tb_co_scheduler_group_t*)self;
+    tb_assert_and_check_return_val(group, 0);
+
+    // the workers count
+    return group->count;
+}
+tb_co_scheduler_ref_t tb_co_scheduler_group_worker(tb_co_scheduler_group_ref_t self, tb_size_t index)
+{
+    // check
+    tb_co_scheduler_group_t* group = (tb_co_scheduler_group_t*)self;
+    tb_assert_and_check_return_val(group && group->workers && index < group->count, tb_null);
+
+    // the worker
+    return (tb_co_scheduler_ref_t)group->workers[index];
+}
+tb_co_scheduler_ref_t tb_co_scheduler_group_next(tb_co_scheduler_group_ref_t self)
+{
+    // check
+    tb_co_scheduler_group_t* group = (tb_co_scheduler_group_t*)self;
+    tb_assert_and_check_return_val(group && group->workers && group->count, tb_null);
+
+    // the next worker
+    return (tb_co_scheduler_ref_t)group->workers[(tb_size_t)tb_atomic_fetch_and_inc(&group->next) % group->count];
+}
+tb_bool_t tb_co_scheduler_group_listen(tb_co_scheduler_group_ref_t self, tb_ipaddr_ref_t addr, tb_size_t backlog, tb_co_scheduler_group_accept_func_t func, tb_size_t stacksize)
+{
+    // check, each listening socket need bind the same non-zero port
+    tb_co_scheduler_group_t* group = (tb_co_scheduler_group_t*)self;
+    tb_assert_and_check_return_val(group && group->workers && group->count && addr && func, tb_false);
+    tb_assert_and_check_return_val(tb_ipaddr_port(addr), tb_false);
+
+    // open one listening socket per worker, SO_REUSEPORT has been enabled in tb_socket_bind()
+    tb_size_t                           i = 0;
+    tb_size_t                           n = group->count;
+    tb_co_scheduler_group_listener_t*   head = tb_null;
+    for (i = 0; i < n; i++)
+    {
+        // init socket
+        tb_socket_ref_t sock = tb_socket_init(TB_SOCKET_TYPE_TCP, tb_ipaddr_family(addr));
+        tb_assert_and_check_break(sock);
+
+        // bind and listen it, the second binding will be failed if SO_REUSEPORT is not supported
+        if (!tb_socket_bind(sock, addr) || !tb_socket_listen(sock, backlog))
+        {
+            // trace
+            tb_trace_e("worker[%lu]: listen failed!", i);
+
+            // exit it
+            tb_socket_exit(sock);
+            break;
+        }
+
+        // make listener
+        tb_co_scheduler_group_listener_t* listener = tb_malloc0_type(tb_co_scheduler_group_listener_t);
+        if (!listener)
+        {
+            tb_socket_exit(sock);
+            break;
+        }
+
+        // init listener
+        listener->sock      = sock;
+        listener->func      = func;
+        listener->stacksize = stacksize;
+        listener->next      = head;
+        head                = listener;
+    }
+
+    // no listeners? 
+    tb_check_return_val(head, tb_false);
+
+    // trace
+    tb_trace_d("listen %{ipaddr} on %lu/%lu workers", addr, i, n);
+
+    /* start the listener coroutine on each worker
+     *
+     * the connections of each worker are distributed by the kernel,
+     * so we bind them to the accepting worker to keep them local,
+     * otherwise only some workers are listening and we let the idle workers to steal them.
+     */
+    tb_size_t                           k = i;
+    tb_co_scheduler_group_listener_t*   listener = head;
+    while (listener)
+    {
+        // the next listener
+        tb_co_scheduler_group_listener_t* next = listener->next;
+
+        // bind the accepted connections to the current worker if all workers are listening
+        listener->bound = (k == n)? tb_true : tb_false;
+
+        // start the listener coroutine on the given worker
+        tb_co_scheduler_t* worker = group->workers[--i];
+        if (!tb_co_scheduler_start_bound(worker, tb_co_scheduler_group_listener, listener, 0))
+        {
+            tb_socket_exit(listener->sock);
+            listener->sock = tb_null;
+        }
+
+        // attach it to the group, it will be freed in tb_co_scheduler_group_exit()
+        listener->next      = group->listeners;
+        group->listeners    = listener;
+        listener            = next;
+    }
+
+    // ok
+    return tb_true;
+}
@@ -0,0 +1,188 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        scheduler_group.h
+ * @ingroup     coroutine
+ *
+ */
+#ifndef TB_COROUTINE_SCHEDULER_GROUP_H
+#define TB_COROUTINE_SCHEDULER_GROUP_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "scheduler.h"
+#include "../platform/socket.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the coroutine scheduler group ref type
+typedef __tb_typeref__(co_scheduler_group);
+
+/*! the accepted connection func type of the scheduler group listener
+ *
+ * @param priv          the accepted socket
+ */
+typedef tb_void_t       (*tb_co_scheduler_group_accept_func_t)(tb_cpointer_t priv);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init scheduler group
+ *
+ * the scheduler group runs one worker scheduler per thread,
+ * each worker has its own ready coroutines, poller and timers.
+ *
+ * the started coroutines are pending in the run queue of worker first,
+ * and the idle workers will steal them from the busy workers before they are running.
+ *
+ * @note the coroutines will be bound to the current worker after they are running,
+ * and the lock, semaphore and channel can only be used in the coroutines of the same worker.
+ *
+ * @code
+
+    // init scheduler group with tb_processor_count() workers
+    tb_co_scheduler_group_ref_t group = tb_co_scheduler_group_init(0);
+    if (group)
+    {
+        // start coroutine
+        tb_coroutine_start(tb_co_scheduler_group_next(group), listen_func, sock, 0);
+
+        // run all workers until all coroutines have been finished
+        tb_co_scheduler_group_loop(group);
+
+        // exit scheduler group
+        tb_co_scheduler_group_exit(group);
+    }
+ * @endcode
+ *
+ * @param count         the workers count, uses tb_processor_count() if be zero
+ *
+ * @return              the scheduler group
+ */
+tb_co_scheduler_group_ref_t tb_co_scheduler_group_init(tb_size_t count);
+
+/*! exit scheduler group
+ *
+ * @param group         the scheduler group
+ */
+tb_void_t               tb_co_scheduler_group_exit(tb_co_scheduler_group_ref_t group);
+
+/*! kill all workers of the scheduler group
+ *
+ * @param group         the scheduler group
+ */
+tb_void_t               tb_co_scheduler_group_kill(tb_co_scheduler_group_ref_t group);
+
+/*! run the loops of all workers
+ *
+ * the first worker will be run on the current thread,
+ * and it will return after all coroutines have been finished or the group have been killed
+ *
+ * @param group         the scheduler group
+ */
+tb_void_t               tb_co_scheduler_group_loop(tb_co_scheduler_group_ref_t group);
+
+/*! get the workers count
+ *
+ * @param group         the scheduler group
+ *
+ * @return              the workers count
+ */
+tb_size_t               tb_co_scheduler_group_size(tb_co_scheduler_group_ref_t group);
+
+/*! get the given worker scheduler
+ *
+ * @param group         the scheduler group
+ * @param index         the worker index
+ *
+ * @return              the worker scheduler
+ */
+tb_co_scheduler_ref_t   tb_co_scheduler_group_worker(tb_co_scheduler_group_ref_t group, tb_size_t index);
+
+/*! get the next worker scheduler (round-robin) for starting coroutine
+ *
+ * @param group         the scheduler group
+ *
+ * @return              the worker scheduler
+ */
+tb_co_scheduler_ref_t   tb_co_scheduler_group_next(tb_co_scheduler_group_ref_t group);
+
+/*! listen the given address on all workers
+ *
+ * each worker opens its own listening socket with SO_REUSEPORT, 
+ * so the kernel will distribute the incoming connections to all workers.
+ *
+ * the listener coroutine of each worker accepts all pending connections once it is readable,
+ * and starts a coroutine on the same worker with the accepted socket as the argument of func.
+ * these coroutines will not be stolen by other workers, the socket need be exited in func.
+ *
+ * @note it falls back to the shared work stealing if SO_REUSEPORT is not supported,
+ * the listeners never be finished, so we need kill the group to finish loop(),
+ * and it should be called before tb_co_scheduler_group_loop().
+ *
+ * @code
+
+    // the client coroutine
+    static tb_void_t client_func(tb_cpointer_t priv)
+    {
+        tb_socket_ref_t sock = (tb_socket_ref_t)priv;
+
+        // ...
+
+        tb_socket_exit(sock);
+    }
+
+    // listen on all workers
+    tb_ipaddr_t addr;
+    tb_ipaddr_set(&addr, tb_null, 8080, TB_IPADDR_FAMILY_IPV4);
+    if (tb_co_scheduler_group_listen(group, &addr, 1000, client_func, 0))
+    {
+        // run all workers
+        tb_co_scheduler_group_loop(group);
+    }
+ * @endcode
+ *
+ * @param group         the scheduler group
+ * @param addr          the listening address, the port cannot be zero
+ * @param backlog       the backlog of each listening socket
+ * @param func          the coroutine function of the accepted connections
+ * @param stacksize     the stack size of the accepted connections, uses the default size if be zero
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_co_scheduler_group_listen(tb_co_scheduler_group_ref_t group, tb_ipaddr_ref_t addr, tb_size_t backlog, tb_co_scheduler_group_accept_func_t func, tb_size_t stacksize);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -167,6 +167,88 @@ tb_long_t tb_lo_coroutine_events_(tb_lo_coroutine_ref_t self)
     // get events
     return coroutine->rs.wait.events_result;
 }
+tb_pointer_t tb_lo_coroutine_pass_cache_make_(tb_size_t type_size)
+{
+    // check
+    tb_assert(type_size);
+
+    // get the size class index
+    tb_size_t index = (type_size - 1) / TB_LO_COROUTINE_PASS_CLASS_STEP;
+
+    // get the scheduler of the current thread, we can only access it's cache on this thread
+    tb_lo_scheduler_t* scheduler = (tb_lo_scheduler_t*)tb_lo_scheduler_self_();
+
+    // get the cached data first
+    tb_lo_coroutine_pass_t* pass = tb_null;
+    if (index < TB_LO_COROUTINE_PASS_CLASS_MAXN)
+    {
+        // no cached data? get some from the depot of group
+        if (scheduler && scheduler->group && !scheduler->pass_cache[index])
+            tb_lo_scheduler_group_depot_get_pass(scheduler->group, scheduler, index);
+
+        // get the cached data
+        if (scheduler && scheduler->pass_cache[index])
+        {
+            // remove it from the cache
+            pass = scheduler->pass_cache[index];
+            scheduler->pass_cache[index] = pass->next;
+            scheduler->pass_cache_count[index]--;
+        }
+        // make it with the size of this class
+        else pass = (tb_lo_coroutine_pass_t*)tb_malloc_bytes(sizeof(tb_lo_coroutine_pass_t) + (index + 1) * TB_LO_COROUTINE_PASS_CLASS_STEP);
+    }
+    // too large? make it directly and do not cache it
+    else 
+    {
+        pass = (tb_lo_coroutine_pass_t*)tb_malloc_bytes(sizeof(tb_lo_coroutine_pass_t) + type_size);
+        index = (tb_size_t)-1;
+    }
+    tb_check_return_val(pass, tb_null);
+
+    // init it
+    pass->next  = tb_null;
+    pass->index = index;
+    tb_memset(pass + 1, 0, type_size);
+
+    // ok
+    return (tb_pointer_t)(pass + 1);
+}
+tb_void_t tb_lo_coroutine_pass_cache_free_(tb_cpointer_t priv)
+{
+    // check
+    tb_check_return(priv);
+
+    // get the data head
+    tb_lo_coroutine_pass_t* pass = (tb_lo_coroutine_pass_t*)priv - 1;
+
+    /* cache it to the scheduler of the current thread
+     *
+     * the coroutine may be migrated to other worker of group, 
+     * so it may be not the scheduler of pass_cache_make_(), but each size class has the same size
+     */
+    tb_size_t           index = pass->index;
+    tb_lo_scheduler_t*  scheduler = (tb_lo_scheduler_t*)tb_lo_scheduler_self_();
+    if (scheduler && index < TB_LO_COROUTINE_PASS_CLASS_MAXN)
+    {
+        // the cached data is too much? put some to the depot of group or free them
+        if (scheduler->pass_cache_count[index] >= TB_LO_COROUTINE_PASS_CACHE_MAXN)
+        {
+            if (scheduler->group) tb_lo_scheduler_group_depot_put_pass(scheduler->group, scheduler, index);
+            else
+            {
+                tb_free(pass);
+                return ;
+            }
+        }
+
+        // cache it
+        pass->next = scheduler->pass_cache[index];
+        scheduler->pass_cache[index] = pass;
+        scheduler->pass_cache_count[index]++;
+    }
+    // free it
+    else tb_free(pass);
+}
 tb_void_t tb_lo_coroutine_pass_free_(tb_cpointer_t priv)
 {
     if (priv) tb_free(priv);
@@ -183,6 +265,18 @@ tb_pointer_t tb_lo_coroutine_pass1_make_(tb_size_t type_size, tb_cpointer_t valu
     // ok?
     return data;
 }
+tb_pointer_t tb_lo_coroutine_pass1_cache_make_(tb_size_t type_size, tb_cpointer_t value, tb_size_t offset, tb_size_t size)
+{
+    // check
+    tb_assert(type_size && value && offset + size <= type_size);
+
+    // make data
+    tb_byte_t* data = (tb_byte_t*)tb_lo_coroutine_pass_cache_make_(type_size);
+    if (data) tb_memcpy(data + offset, value, size);
+
+    // ok?
+    return data;
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * public implementation
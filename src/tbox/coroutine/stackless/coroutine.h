@@ -219,11 +219,14 @@ do \
  * @code
  
     // start coroutine
-    tb_lo_coroutine_start(scheduler, coroutine_func, tb_malloc0_type(tb_xxxx_priv_t), tb_lo_coroutine_pass_free_);
+    tb_lo_coroutine_start(scheduler, coroutine_func, tb_lo_coroutine_pass_cache_make_(sizeof(tb_xxxx_priv_t)), tb_lo_coroutine_pass_cache_free_);
 
  * @endcode
+ *
+ * @note the private data is cached in the scheduler of the current thread after the coroutine have been finished,
+ * so starting coroutines in the running coroutines will not allocate memory again.
  */
-#define tb_lo_coroutine_pass(type)  tb_malloc0_type(type), tb_lo_coroutine_pass_free_
+#define tb_lo_coroutine_pass(type)  tb_lo_coroutine_pass_cache_make_(sizeof(type)), tb_lo_coroutine_pass_cache_free_
 
 /*! pass the user private data and init one member
  *
@@ -245,18 +248,18 @@ do \
  *
  * @code
  
-    tb_xxxx_priv_t* priv = tb_malloc0_type(tb_xxxx_priv_t);
+    tb_xxxx_priv_t* priv = tb_lo_coroutine_pass_cache_make_(sizeof(tb_xxxx_priv_t));
     if (priv)
     {
         priv->member = value;
     }
  
     // start coroutine
-    tb_lo_coroutine_start(scheduler, coroutine_func, priv, tb_lo_coroutine_pass_free_);
+    tb_lo_coroutine_start(scheduler, coroutine_func, priv, tb_lo_coroutine_pass_cache_free_);
 
  * @endcode
  */
-#define tb_lo_coroutine_pass1(type, member, value)  tb_lo_coroutine_pass1_make_(sizeof(type), &(value), tb_offsetof(type, member), tb_memsizeof(type, member)), tb_lo_coroutine_pass_free_
+#define tb_lo_coroutine_pass1(type, member, value)  tb_lo_coroutine_pass1_cache_make_(sizeof(type), &(value), tb_offsetof(type, member), tb_memsizeof(type, member)), tb_lo_coroutine_pass_cache_free_
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
@@ -301,14 +304,33 @@ tb_bool_t               tb_lo_coroutine_waitio_(tb_lo_coroutine_ref_t coroutine,
  */
 tb_long_t               tb_lo_coroutine_events_(tb_lo_coroutine_ref_t coroutine);
 
-/* free the user private data for pass()
+/* free the user private data
  *
- * @note only be a wrapper of free() for tb_lo_coroutine_pass()
+ * @note only be a wrapper of free(), .e.g tb_malloc0_type(tb_xxxx_priv_t), tb_lo_coroutine_pass_free_
  *
  * @param priv          the user private data
  */
 tb_void_t               tb_lo_coroutine_pass_free_(tb_cpointer_t priv);
 
+/* make the cached user private data for pass()
+ *
+ * it will reuse the cached data of the scheduler on the current thread first
+ *
+ * @param type_size     the data type size
+ *
+ * @return              the user private data (zeroed)
+ */
+tb_pointer_t            tb_lo_coroutine_pass_cache_make_(tb_size_t type_size);
+
+/* free the cached user private data for pass()
+ *
+ * @note it will be cached to the scheduler of the current thread and reused by pass_cache_make_(),
+ * it can only free the data from pass_cache_make_() and pass1_cache_make_()
+ *
+ * @param priv          the user private data from pass_cache_make_()
+ */
+tb_void_t               tb_lo_coroutine_pass_cache_free_(tb_cpointer_t priv);
+
 /* make the user private data for pass1()
  *
  * @param type_size     the data type size
@@ -320,6 +342,17 @@ tb_void_t               tb_lo_coroutine_pass_free_(tb_cpointer_t priv);
  */
 tb_pointer_t            tb_lo_coroutine_pass1_make_(tb_size_t type_size, tb_cpointer_t value, tb_size_t offset, tb_size_t size);
 
+/* make the cached user private data for pass1()
+ *
+ * @param type_size     the data type size
+ * @param value         the value pointer
+ * @param offset        the member offset
+ * @param size          the value size
+ *
+ * @return              the user private data, free it by pass_cache_free_()
+ */
+tb_pointer_t            tb_lo_coroutine_pass1_cache_make_(tb_size_t type_size, tb_cpointer_t value, tb_size_t offset, tb_size_t size);
+
 /* make the user private data for pass2()
  *
  * @param type_size     the data type size
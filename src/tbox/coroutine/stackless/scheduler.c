@@ -115,11 +115,36 @@ static tb_void_t tb_lo_scheduler_make_dead(tb_lo_scheduler_t* scheduler, tb_lo_c
     // free the user private data first
     if (coroutine->free) coroutine->free(coroutine->priv);
 
+    // finish the grouped coroutine
+    if (coroutine->grouped) tb_lo_scheduler_group_done(scheduler->group);
+
     // remove this coroutine from the ready coroutines
     tb_list_entry_remove(&scheduler->coroutines_ready, &coroutine->entry);
 
     // append this coroutine to dead coroutines
     tb_list_entry_insert_tail(&scheduler->coroutines_dead, &coroutine->entry);
+
+    /* the dead coroutines is too much? 
+     *
+     * we only remove the oldest coroutines from head, the finished coroutine may be still the running coroutine
+     */
+    if (tb_list_entry_size(&scheduler->coroutines_dead) > TB_SCHEDULER_DEAD_CACHE_MAXN)
+    {
+        // put some coroutines to the depot of group for the other workers
+        if (scheduler->group) tb_lo_scheduler_group_depot_put(scheduler->group, scheduler);
+        else
+        {
+            // get the next entry from head
+            tb_list_entry_ref_t entry = tb_list_entry_head(&scheduler->coroutines_dead);
+            tb_assert(entry);
+
+            // remove it from the dead coroutines
+            tb_list_entry_remove_head(&scheduler->coroutines_dead);
+
+            // exit this coroutine
+            tb_lo_coroutine_exit((tb_lo_coroutine_t*)tb_list_entry(&scheduler->coroutines_dead, entry));
+        }
+    }
 }
 static tb_void_t tb_lo_scheduler_make_suspend(tb_lo_scheduler_t* scheduler, tb_lo_coroutine_t* coroutine)
 {
@@ -187,42 +212,56 @@ tb_bool_t tb_lo_scheduler_start(tb_lo_scheduler_t* scheduler, tb_lo_coroutine_fu
         // have been stopped? do not continue to start new coroutines
         tb_check_break(!scheduler->stopped);
 
+        /* get the dead coroutines cache of the current thread
+         *
+         * the worker scheduler of group may be started from other threads, 
+         * so we only reuse the dead coroutines of the scheduler running on the current thread,
+         * and the dead coroutine can be started on any other worker.
+         */
+        tb_lo_scheduler_t* cache = scheduler->group? (tb_lo_scheduler_t*)tb_lo_scheduler_self_() : scheduler;
+
+        // no dead coroutines? get some from the depot of group
+        if (cache && cache->group && !tb_list_entry_size(&cache->coroutines_dead))
+            tb_lo_scheduler_group_depot_get(cache->group, cache);
+
         // reuses dead coroutines in init function
-        if (tb_list_entry_size(&scheduler->coroutines_dead))
+        if (cache && tb_list_entry_size(&cache->coroutines_dead))
         {
             // get the next entry from head
-            tb_list_entry_ref_t entry = tb_list_entry_head(&scheduler->coroutines_dead);
+            tb_list_entry_ref_t entry = tb_list_entry_head(&cache->coroutines_dead);
             tb_assert_and_check_break(entry);
 
             // remove it from the ready coroutines
-            tb_list_entry_remove_head(&scheduler->coroutines_dead);
+            tb_list_entry_remove_head(&cache->coroutines_dead);
 
             // get the dead coroutine
-            coroutine = (tb_lo_coroutine_t*)tb_list_entry(&scheduler->coroutines_dead, entry);
+            coroutine = (tb_lo_coroutine_t*)tb_list_entry(&cache->coroutines_dead, entry);
 
             // reinit this coroutine
             tb_lo_coroutine_reinit(coroutine, func, priv, free);
+
+            // attach it to the given scheduler
+            coroutine->scheduler = (tb_lo_scheduler_ref_t)scheduler;
         }
 
         // init coroutine
         if (!coroutine) coroutine = tb_lo_coroutine_init((tb_lo_scheduler_ref_t)scheduler, func, priv, free);
         tb_assert_and_check_break(coroutine);
 
-        // ready coroutine
-        tb_lo_scheduler_make_ready(scheduler, coroutine);
-
-        // the dead coroutines is too much? free some coroutines
-        while (tb_list_entry_size(&scheduler->coroutines_dead) > TB_SCHEDULER_DEAD_CACHE_MAXN)
+        // is the worker scheduler of group?
+        if (scheduler->group)
         {
-            // get the next entry from head
-            tb_list_entry_ref_t entry = tb_list_entry_head(&scheduler->coroutines_dead);
-            tb_assert(entry);
-
-            // remove it from the ready coroutines
-            tb_list_entry_remove_head(&scheduler->coroutines_dead);
+            // mark as grouped coroutine
+            coroutine->grouped = 1;
 
-            // exit this coroutine
-            tb_lo_coroutine_exit((tb_lo_coroutine_t*)tb_list_entry(&scheduler->coroutines_dead, entry));
+            // push it to the pending coroutines, it may be stolen by other idle workers
+            tb_lo_scheduler_group_push(scheduler->group, scheduler, coroutine);
+        }
+        else
+        {
+            // ready coroutine
+            coroutine->grouped = 0;
+            tb_lo_scheduler_make_ready(scheduler, coroutine);
         }
 
         // ok
@@ -248,6 +287,50 @@ tb_void_t tb_lo_scheduler_resume(tb_lo_scheduler_t* scheduler, tb_lo_coroutine_t
     // make it as ready
     tb_lo_scheduler_make_ready(scheduler, coroutine);
 }
+tb_size_t tb_lo_scheduler_pull(tb_lo_scheduler_t* scheduler)
+{
+    // check
+    tb_assert(scheduler && scheduler->group);
+
+    // pull the own pending coroutines first, otherwise steal them from the busiest worker
+    tb_lo_scheduler_t* victim = tb_atomic_get(&scheduler->pending_count)? scheduler : tb_lo_scheduler_group_victim(scheduler->group, scheduler);
+    tb_check_return_val(victim, 0);
+
+    // enter lock
+    tb_spinlock_enter(&victim->pending_lock);
+
+    // pull the half of pending coroutines and leave the others to be stolen
+    tb_size_t count = (tb_list_entry_size(&victim->coroutines_pending) + 1) >> 1;
+    tb_size_t pulled = count;
+    while (count--)
+    {
+        // get the next entry from head
+        tb_list_entry_ref_t entry = tb_list_entry_head(&victim->coroutines_pending);
+        tb_assert(entry);
+
+        // remove it from the pending coroutines
+        tb_list_entry_remove_head(&victim->coroutines_pending);
+
+        // get the pending coroutine, it has not been started and we can migrate it to the current worker
+        tb_lo_coroutine_t* coroutine = (tb_lo_coroutine_t*)tb_list_entry(&victim->coroutines_pending, entry);
+        coroutine->scheduler = (tb_lo_scheduler_ref_t)scheduler;
+
+        // make it as ready
+        tb_lo_scheduler_make_ready(scheduler, coroutine);
+    }
+
+    // update the pending count
+    tb_atomic_fetch_and_sub(&victim->pending_count, pulled);
+
+    // leave lock
+    tb_spinlock_leave(&victim->pending_lock);
+
+    // trace
+    tb_trace_d("pull %lu coroutines from worker(%p) to worker(%p)", pulled, victim, scheduler);
+
+    // ok
+    return pulled;
+}
 tb_lo_scheduler_ref_t tb_lo_scheduler_self_()
 { 
 #ifndef TB_CONFIG_MICRO_ENABLE
@@ -281,6 +364,12 @@ tb_lo_scheduler_ref_t tb_lo_scheduler_init()
         // init suspend coroutines
         tb_list_entry_init(&scheduler->coroutines_suspend, tb_lo_coroutine_t, entry, tb_null);
 
+        // init pending coroutines
+        tb_list_entry_init(&scheduler->coroutines_pending, tb_lo_coroutine_t, entry, tb_null);
+
+        // init pending lock
+        if (!tb_spinlock_init(&scheduler->pending_lock)) break;
+
         // ok
         ok = tb_true;
 
@@ -323,6 +412,36 @@ tb_void_t tb_lo_scheduler_exit(tb_lo_scheduler_ref_t self)
     // free all suspend coroutines 
     tb_lo_scheduler_free(&scheduler->coroutines_suspend);
 
+    // free all pending coroutines which have been never run
+    while (tb_list_entry_size(&scheduler->coroutines_pending))
+    {
+        // get the next entry from head
+        tb_list_entry_ref_t entry = tb_list_entry_head(&scheduler->coroutines_pending);
+        tb_assert(entry);
+
+        // remove it from the pending coroutines
+        tb_list_entry_remove_head(&scheduler->coroutines_pending);
+
+        // free the user private data and exit this coroutine
+        tb_lo_coroutine_t* coroutine = (tb_lo_coroutine_t*)tb_list_entry(&scheduler->coroutines_pending, entry);
+        if (coroutine->free) coroutine->free(coroutine->priv);
+        tb_lo_core_state_set(coroutine, TB_STATE_END);
+        tb_lo_coroutine_exit(coroutine);
+    }
+
+    // free all cached user private data of pass()
+    tb_size_t i = 0;
+    for (i = 0; i < TB_LO_COROUTINE_PASS_CLASS_MAXN; i++)
+    {
+        while (scheduler->pass_cache[i])
+        {
+            tb_lo_coroutine_pass_t* pass = scheduler->pass_cache[i];
+            scheduler->pass_cache[i] = pass->next;
+            tb_free(pass);
+        }
+        scheduler->pass_cache_count[i] = 0;
+    }
+
     // exit dead coroutines
     tb_list_entry_exit(&scheduler->coroutines_dead);
 
@@ -332,6 +451,12 @@ tb_void_t tb_lo_scheduler_exit(tb_lo_scheduler_ref_t self)
     // exit suspend coroutines
     tb_list_entry_exit(&scheduler->coroutines_suspend);
 
+    // exit pending coroutines
+    tb_list_entry_exit(&scheduler->coroutines_pending);
+
+    // exit pending lock
+    tb_spinlock_exit(&scheduler->pending_lock);
+
     // exit the scheduler
     tb_free(scheduler);
 }
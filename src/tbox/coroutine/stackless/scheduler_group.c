@@ -0,0 +1,291 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        scheduler_group.c
+ * @ingroup     coroutine
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "scheduler_group"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "scheduler_group.h"
+#include "../impl/impl.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the workers maximum count
+#ifdef __tb_small__
+#   define TB_SCHEDULER_GROUP_WORKER_MAXN       (16)
+#else
+#   define TB_SCHEDULER_GROUP_WORKER_MAXN       (256)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_int_t tb_lo_scheduler_group_worker_loop(tb_cpointer_t priv)
+{
+    // check
+    tb_lo_scheduler_ref_t scheduler = (tb_lo_scheduler_ref_t)priv;
+    tb_assert_and_check_return_val(scheduler, -1);
+
+    // run the worker scheduler, we cannot use the exclusive mode for multi-threads
+    tb_lo_scheduler_loop(scheduler, tb_false);
+
+    // ok
+    return 0;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_lo_scheduler_group_ref_t tb_lo_scheduler_group_init(tb_size_t count)
+{
+    // done
+    tb_bool_t                   ok = tb_false;
+    tb_lo_scheduler_group_t*    group = tb_null;
+    do
+    {
+        // init workers count
+        if (!count) count = tb_processor_count();
+        if (!count) count = 1;
+        tb_assert_and_check_break(count <= TB_SCHEDULER_GROUP_WORKER_MAXN);
+
+        // make scheduler group
+        group = tb_malloc0_type(tb_lo_scheduler_group_t);
+        tb_assert_and_check_break(group);
+
+        // init the depot of the dead coroutines
+        tb_list_entry_init(&group->depot_coroutines, tb_lo_coroutine_t, entry, tb_null);
+
+        // init the depot lock
+        if (!tb_spinlock_init(&group->depot_lock)) break;
+
+        // make workers
+        group->workers = tb_nalloc0_type(count, tb_lo_scheduler_t*);
+        tb_assert_and_check_break(group->workers);
+
+        // make threads
+        group->threads = tb_nalloc0_type(count, tb_thread_ref_t);
+        tb_assert_and_check_break(group->threads);
+
+        // init workers
+        tb_size_t i = 0;
+        for (i = 0; i < count; i++)
+        {
+            // init worker scheduler
+            tb_lo_scheduler_t* worker = (tb_lo_scheduler_t*)tb_lo_scheduler_init();
+            tb_assert_and_check_break(worker);
+
+            // save this worker first
+            group->workers[i] = worker;
+            group->count++;
+
+            /* init io scheduler and start the io loop coroutine before attaching the group
+             *
+             * the io loop coroutine will be ready directly instead of pending,
+             * and we can spak it's poller to wake up the idle worker
+             */
+            worker->scheduler_io = tb_lo_scheduler_io_init(worker);
+            tb_assert_and_check_break(worker->scheduler_io);
+
+            // attach the group
+            worker->group = group;
+        }
+        tb_assert_and_check_break(i == count);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (group) tb_lo_scheduler_group_exit((tb_lo_scheduler_group_ref_t)group);
+        group = tb_null;
+    }
+
+    // ok?
+    return (tb_lo_scheduler_group_ref_t)group;
+}
+tb_void_t tb_lo_scheduler_group_exit(tb_lo_scheduler_group_ref_t self)
+{
+    // check
+    tb_lo_scheduler_group_t* group = (tb_lo_scheduler_group_t*)self;
+    tb_assert_and_check_return(group);
+
+    // exit all workers
+    tb_size_t i = 0;
+    for (i = 0; i < group->count; i++)
+    {
+        // exit the worker thread if be not finished
+        if (group->threads && group->threads[i])
+        {
+            // wait it
+            tb_long_t wait = 0;
+            if ((wait = tb_thread_wait(group->threads[i], 5000, tb_null)) <= 0)
+            {
+                // trace
+                tb_trace_e("worker[%lu]: wait failed: %ld!", i, wait);
+            }
+
+            // exit it
+            tb_thread_exit(group->threads[i]);
+            group->threads[i] = tb_null;
+        }
+
+        // exit the worker scheduler
+        tb_lo_scheduler_t* worker = group->workers[i];
+        if (worker)
+        {
+            // stop it first if this worker have been never run
+            worker->stopped = tb_true;
+
+            // exit it
+            tb_lo_scheduler_exit((tb_lo_scheduler_ref_t)worker);
+            group->workers[i] = tb_null;
+        }
+    }
+
+    // exit the dead coroutines in depot
+    while (tb_list_entry_size(&group->depot_coroutines))
+    {
+        tb_list_entry_ref_t entry = tb_list_entry_head(&group->depot_coroutines);
+        tb_list_entry_remove_head(&group->depot_coroutines);
+        tb_lo_coroutine_exit((tb_lo_coroutine_t*)tb_list_entry(&group->depot_coroutines, entry));
+    }
+    tb_list_entry_exit(&group->depot_coroutines);
+
+    // exit the cached pass() data in depot
+    for (i = 0; i < TB_LO_COROUTINE_PASS_CLASS_MAXN; i++)
+    {
+        while (group->depot_pass[i])
+        {
+            tb_lo_coroutine_pass_t* pass = group->depot_pass[i];
+            group->depot_pass[i] = pass->next;
+            tb_free(pass);
+        }
+    }
+
+    // exit the depot lock
+    tb_spinlock_exit(&group->depot_lock);
+
+    // exit threads
+    if (group->threads) tb_free(group->threads);
+    group->threads = tb_null;
+
+    // exit workers
+    if (group->workers) tb_free(group->workers);
+    group->workers = tb_null;
+
+    // exit it
+    tb_free(group);
+}
+tb_void_t tb_lo_scheduler_group_kill(tb_lo_scheduler_group_ref_t self)
+{
+    // check
+    tb_lo_scheduler_group_t* group = (tb_lo_scheduler_group_t*)self;
+    tb_assert_and_check_return(group && group->workers);
+
+    // kill all workers
+    tb_size_t i = 0;
+    for (i = 0; i < group->count; i++)
+    {
+        tb_lo_scheduler_t* worker = group->workers[i];
+        if (worker)
+        {
+            // stop it
+            tb_lo_scheduler_kill((tb_lo_scheduler_ref_t)worker);
+
+            // spak the poller to finish the waiting io loop
+            if (worker->scheduler_io && worker->scheduler_io->poller) tb_poller_spak(worker->scheduler_io->poller);
+        }
+    }
+}
+tb_void_t tb_lo_scheduler_group_loop(tb_lo_scheduler_group_ref_t self)
+{
+    // check
+    tb_lo_scheduler_group_t* group = (tb_lo_scheduler_group_t*)self;
+    tb_assert_and_check_return(group && group->workers && group->threads && group->count);
+
+    // start the other workers
+    tb_size_t i = 0;
+    for (i = 1; i < group->count; i++)
+    {
+        group->threads[i] = tb_thread_init(__tb_lstring__("lo_worker"), tb_lo_scheduler_group_worker_loop, group->workers[i], 0);
+        tb_assert(group->threads[i]);
+    }
+
+    // run the first worker on the current thread
+    tb_lo_scheduler_group_worker_loop(group->workers[0]);
+
+    // wait the other workers
+    for (i = 1; i < group->count; i++)
+    {
+        if (group->threads[i])
+        {
+            // wait it
+            tb_thread_wait(group->threads[i], -1, tb_null);
+
+            // exit it
+            tb_thread_exit(group->threads[i]);
+            group->threads[i] = tb_null;
+        }
+    }
+}
+tb_size_t tb_lo_scheduler_group_size(tb_lo_scheduler_group_ref_t self)
+{
+    // check
+    tb_lo_scheduler_group_t* group = (tb_lo_scheduler_group_t*)self;
+    tb_assert_and_check_return_val(group, 0);
+
+    // the workers count
+    return group->count;
+}
+tb_lo_scheduler_ref_t tb_lo_scheduler_group_worker(tb_lo_scheduler_group_ref_t self, tb_size_t index)
+{
+    // check
+    tb_lo_scheduler_group_t* group = (tb_lo_scheduler_group_t*)self;
+    tb_assert_and_check_return_val(group && group->workers && index < group->count, tb_null);
+
+    // the worker
+    return (tb_lo_scheduler_ref_t)group->workers[index];
+}
+tb_lo_scheduler_ref_t tb_lo_scheduler_group_next(tb_lo_scheduler_group_ref_t self)
+{
+    // check
+    tb_lo_scheduler_group_t* group = (tb_lo_scheduler_group_t*)self;
+    tb_assert_and_check_return_val(group && group->workers && group->count, tb_null);
+
+    // the next worker
+    return (tb_lo_scheduler_ref_t)group->workers[(tb_size_t)tb_atomic_fetch_and_inc(&group->next) % group->count];
+}
@@ -0,0 +1,137 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        scheduler_group.h
+ * @ingroup     coroutine
+ *
+ */
+#ifndef TB_COROUTINE_STACKLESS_SCHEDULER_GROUP_H
+#define TB_COROUTINE_STACKLESS_SCHEDULER_GROUP_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "scheduler.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the stackless scheduler group ref type
+typedef __tb_typeref__(lo_scheduler_group);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init the stackless scheduler group
+ *
+ * the scheduler group runs one worker scheduler per thread,
+ * each worker has its own ready coroutines, poller, timers and caches of the dead coroutines and pass() data.
+ *
+ * the started coroutines are pending in the run queue of worker first,
+ * and the idle workers will steal them from the busy workers before they are running.
+ *
+ * @note the coroutines will be bound to the current worker after they are running,
+ * and the lock and semaphore can only be used in the coroutines of the same worker.
+ * we cannot run the exclusive loop of other schedulers at the same time.
+ *
+ * @code
+
+    // init scheduler group with tb_processor_count() workers
+    tb_lo_scheduler_group_ref_t group = tb_lo_scheduler_group_init(0);
+    if (group)
+    {
+        // start coroutine
+        tb_lo_coroutine_start(tb_lo_scheduler_group_next(group), coroutine_func, tb_lo_coroutine_pass(tb_xxxx_priv_t));
+
+        // run all workers until all coroutines have been finished
+        tb_lo_scheduler_group_loop(group);
+
+        // exit scheduler group
+        tb_lo_scheduler_group_exit(group);
+    }
+ * @endcode
+ *
+ * @param count         the workers count, uses tb_processor_count() if be zero
+ *
+ * @return              the scheduler group
+ */
+tb_lo_scheduler_group_ref_t tb_lo_scheduler_group_init(tb_size_t count);
+
+/*! exit the stackless scheduler group
+ *
+ * @param group         the scheduler group
+ */
+tb_void_t               tb_lo_scheduler_group_exit(tb_lo_scheduler_group_ref_t group);
+
+/*! kill all workers of the stackless scheduler group
+ *
+ * @param group         the scheduler group
+ */
+tb_void_t               tb_lo_scheduler_group_kill(tb_lo_scheduler_group_ref_t group);
+
+/*! run the loops of all workers
+ *
+ * the first worker will be run on the current thread,
+ * and it will return after all coroutines have been finished or the group have been killed
+ *
+ * @param group         the scheduler group
+ */
+tb_void_t               tb_lo_scheduler_group_loop(tb_lo_scheduler_group_ref_t group);
+
+/*! get the workers count
+ *
+ * @param group         the scheduler group
+ *
+ * @return              the workers count
+ */
+tb_size_t               tb_lo_scheduler_group_size(tb_lo_scheduler_group_ref_t group);
+
+/*! get the given worker scheduler
+ *
+ * @param group         the scheduler group
+ * @param index         the worker index
+ *
+ * @return              the worker scheduler
+ */
+tb_lo_scheduler_ref_t   tb_lo_scheduler_group_worker(tb_lo_scheduler_group_ref_t group, tb_size_t index);
+
+/*! get the next worker scheduler (round-robin) for starting coroutine
+ *
+ * @param group         the scheduler group
+ *
+ * @return              the worker scheduler
+ */
+tb_lo_scheduler_ref_t   tb_lo_scheduler_group_next(tb_lo_scheduler_group_ref_t group);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -31,6 +31,7 @@
  */
 #include "coroutine.h"
 #include "scheduler.h"
+#include "scheduler_group.h"
 #include "semaphore.h"
 #include "lock.h"
 
@@ -0,0 +1,414 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        thread_channel.c
+ * @ingroup     coroutine
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "thread_channel"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "thread_channel.h"
+#include "coroutine.h"
+#include "scheduler.h"
+#include "impl/impl.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the yield count before sleeping if the channel is full
+#define TB_CO_THREAD_CHANNEL_YIELD_MAXN         (16)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the thread channel slot type
+typedef struct __tb_co_thread_channel_slot_t
+{
+    /* the sequence
+     *
+     * seq == pos:      this slot is empty and can be written at pos
+     * seq == pos + 1:  this slot is full and can be read at pos
+     */
+    tb_atomic_t                     seq;
+
+    // the data
+    tb_cpointer_t                   data;
+
+}tb_co_thread_channel_slot_t;
+
+/* the thread channel waiter type
+ *
+ * it is placed on the stack of the waiting coroutine
+ */
+typedef struct __tb_co_thread_channel_waiter_t
+{
+    // the list entry
+    tb_list_entry_t                 entry;
+
+    // the waiting coroutine
+    tb_coroutine_t*                 coroutine;
+
+    // is waiting? it is protected by the channel lock
+    tb_bool_t                       waiting;
+
+}tb_co_thread_channel_waiter_t;
+
+/* the coroutine thread channel type
+ *
+ * the bounded mpmc queue with the sequence slots
+ */
+typedef struct __tb_co_thread_channel_t
+{
+    // the write position
+    tb_atomic_t                     tail;
+
+    // the padding for avoiding false sharing
+    tb_byte_t                       tail_pad[TB_L1_CACHE_BYTES - sizeof(tb_atomic_t)];
+
+    // the read position
+    tb_atomic_t                     head;
+
+    // the padding for avoiding false sharing
+    tb_byte_t                       head_pad[TB_L1_CACHE_BYTES - sizeof(tb_atomic_t)];
+
+    // the waiting coroutines count, we can get it without lock
+    tb_atomic_t                     waiting_count;
+
+    // the lock of the waiting coroutines
+    tb_spinlock_t                   waiting_lock;
+
+    // the waiting recv coroutines
+    tb_list_entry_head_t            waiting_recv;
+
+    // the slots
+    tb_co_thread_channel_slot_t*    slots;
+
+    // the slots mask
+    tb_size_t                       mask;
+
+    // the free function
+    tb_co_channel_free_func_t       free;
+
+    // the user private data
+    tb_cpointer_t                   priv;
+
+}tb_co_thread_channel_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_bool_t tb_co_thread_channel_put(tb_co_thread_channel_t* channel, tb_cpointer_t data)
+{
+    // get the write position
+    tb_size_t                       pos = (tb_size_t)tb_atomic_get(&channel->tail);
+    tb_co_thread_channel_slot_t*    slot = tb_null;
+    while (1)
+    {
+        // this slot can be written?
+        slot = &channel->slots[pos & channel->mask];
+        tb_long_t diff = tb_atomic_get(&slot->seq) - (tb_long_t)pos;
+        if (!diff)
+        {
+            // acquire this slot
+            tb_size_t prev = (tb_size_t)tb_atomic_fetch_and_pset(&channel->tail, (tb_long_t)pos, (tb_long_t)(pos + 1));
+            if (prev == pos) break;
+
+            // acquire failed, try the new position
+            pos = prev;
+        }
+        // full?
+        else if (diff < 0) return tb_false;
+        // this slot has been written by other threads, get the new position
+        else pos = (tb_size_t)tb_atomic_get(&channel->tail);
+    }
+
+    // write data and publish it
+    slot->data = data;
+    tb_atomic_set(&slot->seq, (tb_long_t)(pos + 1));
+    return tb_true;
+}
+static tb_bool_t tb_co_thread_channel_get(tb_co_thread_channel_t* channel, tb_pointer_t* pdata)
+{
+    // get the read position
+    tb_size_t                       pos = (tb_size_t)tb_atomic_get(&channel->head);
+    tb_co_thread_channel_slot_t*    slot = tb_null;
+    while (1)
+    {
+        // this slot can be read?
+        slot = &channel->slots[pos & channel->mask];
+        tb_long_t diff = tb_atomic_get(&slot->seq) - (tb_long_t)(pos + 1);
+        if (!diff)
+        {
+            // acquire this slot
+            tb_size_t prev = (tb_size_t)tb_atomic_fetch_and_pset(&channel->head, (tb_long_t)pos, (tb_long_t)(pos + 1));
+            if (prev == pos) break;
+
+            // acquire failed, try the new position
+            pos = prev;
+        }
+        // empty?
+        else if (diff < 0) return tb_false;
+        // this slot has been read by other threads, get the new position
+        else pos = (tb_size_t)tb_atomic_get(&channel->head);
+    }
+
+    // read data and release this slot for the next round
+    if (pdata) *pdata = (tb_pointer_t)slot->data;
+    tb_atomic_set(&slot->seq, (tb_long_t)(pos + channel->mask + 1));
+    return tb_true;
+}
+static __tb_inline__ tb_bool_t tb_co_thread_channel_empty(tb_co_thread_channel_t* channel)
+{
+    // the read slot is not written?
+    tb_size_t pos = (tb_size_t)tb_atomic_get(&channel->head);
+    return tb_atomic_get(&channel->slots[pos & channel->mask].seq) != (tb_long_t)(pos + 1);
+}
+static tb_void_t tb_co_thread_channel_notify(tb_co_thread_channel_t* channel)
+{
+    // no waiting coroutines? we need not enter lock
+    tb_check_return(tb_atomic_get(&channel->waiting_count));
+
+    // pop the first waiting coroutine
+    tb_coroutine_t* coroutine = tb_null;
+    tb_spinlock_enter(&channel->waiting_lock);
+    if (tb_list_entry_size(&channel->waiting_recv))
+    {
+        tb_co_thread_channel_waiter_t* waiter = (tb_co_thread_channel_waiter_t*)tb_list_entry(&channel->waiting_recv, tb_list_entry_head(&channel->waiting_recv));
+        tb_list_entry_remove_head(&channel->waiting_recv);
+        tb_atomic_fetch_and_dec(&channel->waiting_count);
+        waiter->waiting = tb_false;
+        coroutine = waiter->coroutine;
+    }
+    tb_spinlock_leave(&channel->waiting_lock);
+
+    // wake up it on it's scheduler, the waiter cannot be accessed now
+    if (coroutine) tb_co_scheduler_wakeup((tb_co_scheduler_t*)tb_coroutine_scheduler(coroutine), coroutine);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_co_thread_channel_ref_t tb_co_thread_channel_init(tb_size_t size, tb_co_channel_free_func_t free, tb_cpointer_t priv)
+{
+    // check
+    tb_assert_and_check_return_val(size && size <= TB_MAXU32, tb_null);
+
+    // done
+    tb_bool_t               ok = tb_false;
+    tb_co_thread_channel_t* channel = tb_null;
+    do
+    {
+        // make channel
+        channel = tb_malloc0_type(tb_co_thread_channel_t);
+        tb_assert_and_check_break(channel);
+
+        // init waiting lock
+        if (!tb_spinlock_init(&channel->waiting_lock)) break;
+
+        // init waiting recv coroutines
+        tb_list_entry_init(&channel->waiting_recv, tb_co_thread_channel_waiter_t, entry, tb_null);
+
+        // init free function and data
+        channel->free = free;
+        channel->priv = priv;
+
+        // make slots
+        size = tb_align_pow2(size);
+        channel->slots = tb_nalloc_type(size, tb_co_thread_channel_slot_t);
+        tb_assert_and_check_break(channel->slots);
+
+        // init slots
+        tb_size_t i = 0;
+        for (i = 0; i < size; i++) channel->slots[i].seq = (tb_long_t)i;
+        channel->mask = size - 1;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (channel) tb_co_thread_channel_exit((tb_co_thread_channel_ref_t)channel);
+        channel = tb_null;
+    }
+
+    // ok?
+    return (tb_co_thread_channel_ref_t)channel;
+}
+tb_void_t tb_co_thread_channel_exit(tb_co_thread_channel_ref_t self)
+{
+    // check
+    tb_co_thread_channel_t* channel = (tb_co_thread_channel_t*)self;
+    tb_assert_and_check_return(channel);
+
+    // exit slots
+    if (channel->slots)
+    {
+        // free the left data
+        tb_pointer_t data = tb_null;
+        while (tb_co_thread_channel_get(channel, &data))
+        {
+            if (channel->free) channel->free(data, channel->priv);
+        }
+
+        // free it
+        tb_free(channel->slots);
+        channel->slots = tb_null;
+    }
+
+    // check waiting coroutines
+    tb_assert(!tb_list_entry_size(&channel->waiting_recv));
+
+    // exit waiting coroutines
+    tb_list_entry_exit(&channel->waiting_recv);
+
+    // exit waiting lock
+    tb_spinlock_exit(&channel->waiting_lock);
+
+    // exit the channel
+    tb_free(channel);
+}
+tb_void_t tb_co_thread_channel_send(tb_co_thread_channel_ref_t self, tb_cpointer_t data)
+{
+    // check
+    tb_co_thread_channel_t* channel = (tb_co_thread_channel_t*)self;
+    tb_assert_and_check_return(channel && channel->slots);
+
+    // put data, wait some time if be full
+    tb_size_t tryn = 0;
+    while (!tb_co_thread_channel_put(channel, data))
+    {
+        // yield the current thread first and sleep it (or the current coroutine) if be still full
+        if (tryn++ < TB_CO_THREAD_CHANNEL_YIELD_MAXN && !tb_coroutine_self()) tb_sched_yield();
+        else tb_msleep(1);
+    }
+
+    // notify the waiting coroutine
+    tb_co_thread_channel_notify(channel);
+}
+tb_pointer_t tb_co_thread_channel_recv(tb_co_thread_channel_ref_t self)
+{
+    // check
+    tb_co_thread_channel_t* channel = (tb_co_thread_channel_t*)self;
+    tb_assert_and_check_return_val(channel && channel->slots, tb_null);
+
+    // get the scheduler, we need it's poller to wake up the current coroutine
+    tb_co_scheduler_t* scheduler = (tb_co_scheduler_t*)tb_co_scheduler_self();
+    tb_assert_and_check_return_val(scheduler && tb_coroutine_self(), tb_null);
+    tb_check_return_val(tb_co_scheduler_io_need(scheduler), tb_null);
+
+    // recv data
+    tb_pointer_t data = tb_null;
+    while (!tb_co_thread_channel_get(channel, &data))
+    {
+        // have been stopped?
+        tb_check_break(!scheduler->stopped);
+
+        // insert the current coroutine to the waiting coroutines
+        tb_co_thread_channel_waiter_t waiter;
+        waiter.coroutine    = (tb_coroutine_t*)tb_coroutine_self();
+        waiter.waiting      = tb_true;
+        tb_spinlock_enter(&channel->waiting_lock);
+        tb_list_entry_insert_tail(&channel->waiting_recv, &waiter.entry);
+        tb_atomic_fetch_and_inc(&channel->waiting_count);
+        tb_spinlock_leave(&channel->waiting_lock);
+
+        /* check it again after inserting the waiting coroutine, 
+         * the sender may have put data before seeing the waiting count
+         */
+        if (!tb_co_thread_channel_empty(channel))
+        {
+            // remove it if be still waiting
+            tb_bool_t waiting = tb_false;
+            tb_spinlock_enter(&channel->waiting_lock);
+            if (waiter.waiting)
+            {
+                tb_list_entry_remove(&channel->waiting_recv, &waiter.entry);
+                tb_atomic_fetch_and_dec(&channel->waiting_count);
+                waiter.waiting = tb_false;
+                waiting = tb_true;
+            }
+            tb_spinlock_leave(&channel->waiting_lock);
+
+            // try recving it again
+            if (waiting) continue;
+        }
+
+        // trace
+        tb_trace_d("recv[%p]: wait ..", waiter.coroutine);
+
+        // wait data, the sender will wake up it if it have been removed from the waiting coroutines
+        tb_coroutine_suspend(tb_null);
+
+        // trace
+        tb_trace_d("recv[%p]: wait ok", waiter.coroutine);
+
+        // remove it if be still waiting (the scheduler have been stopped)
+        if (waiter.waiting)
+        {
+            tb_spinlock_enter(&channel->waiting_lock);
+            if (waiter.waiting)
+            {
+                tb_list_entry_remove(&channel->waiting_recv, &waiter.entry);
+                tb_atomic_fetch_and_dec(&channel->waiting_count);
+            }
+            tb_spinlock_leave(&channel->waiting_lock);
+        }
+    }
+
+    // ok?
+    return data;
+}
+tb_bool_t tb_co_thread_channel_send_try(tb_co_thread_channel_ref_t self, tb_cpointer_t data)
+{
+    // check
+    tb_co_thread_channel_t* channel = (tb_co_thread_channel_t*)self;
+    tb_assert_and_check_return_val(channel && channel->slots, tb_false);
+
+    // put data
+    if (!tb_co_thread_channel_put(channel, data)) return tb_false;
+
+    // notify the waiting coroutine
+    tb_co_thread_channel_notify(channel);
+    return tb_true;
+}
+tb_bool_t tb_co_thread_channel_recv_try(tb_co_thread_channel_ref_t self, tb_pointer_t* pdata)
+{
+    // check
+    tb_co_thread_channel_t* channel = (tb_co_thread_channel_t*)self;
+    tb_assert_and_check_return_val(channel && channel->slots && pdata, tb_false);
+
+    // get data
+    return tb_co_thread_channel_get(channel, pdata);
+}
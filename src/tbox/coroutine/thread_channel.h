@@ -0,0 +1,121 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        thread_channel.h
+ * @ingroup     coroutine
+ *
+ */
+#ifndef TB_COROUTINE_THREAD_CHANNEL_H
+#define TB_COROUTINE_THREAD_CHANNEL_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "channel.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the coroutine thread channel ref type
+typedef __tb_typeref__(co_thread_channel);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init thread channel 
+ *
+ * the thread channel is a bounded lock-free queue which can be used between the different threads.
+ *
+ * - send:  it can be called from any threads and any coroutines
+ * - recv:  it will suspend the current coroutine if no data, 
+ *          and the coroutine will be woken up by the poller of it's scheduler after sending data
+ *
+ * a burst of sent data only wakes up the waiting coroutine once, 
+ * and it will recv all data directly without suspending again.
+ *
+ * @note the scheduler of the recv coroutines cannot be run in the exclusive mode 
+ * if we send data from other threads.
+ *
+ * @param size          the buffer size, it will be aligned by pow2
+ * @param free          the free function
+ * @param priv          the user private data
+ *
+ * @return              the channel 
+ */
+tb_co_thread_channel_ref_t  tb_co_thread_channel_init(tb_size_t size, tb_co_channel_free_func_t free, tb_cpointer_t priv);
+
+/*! exit thread channel
+ *
+ * @param channel       the channel
+ */
+tb_void_t                   tb_co_thread_channel_exit(tb_co_thread_channel_ref_t channel);
+
+/*! send data into channel
+ *
+ * it will yield the current thread or sleep the current coroutine if this channel is full 
+ *
+ * @param channel       the channel
+ * @param data          the channel data
+ */
+tb_void_t                   tb_co_thread_channel_send(tb_co_thread_channel_ref_t channel, tb_cpointer_t data);
+
+/*! recv data from channel
+ *
+ * it only can be called in coroutine and the current coroutine will be suspend if no data
+ *
+ * @param channel       the channel
+ *
+ * @return              the channel data
+ */
+tb_pointer_t                tb_co_thread_channel_recv(tb_co_thread_channel_ref_t channel);
+
+/*! try sending data into channel
+ *
+ * @param channel       the channel
+ * @param data          the channel data
+ *
+ * @return              tb_true or tb_false (full)
+ */
+tb_bool_t                   tb_co_thread_channel_send_try(tb_co_thread_channel_ref_t channel, tb_cpointer_t data);
+
+/*! try recving data from channel
+ *
+ * @param channel       the channel
+ * @param pdata         the channel data pointer
+ *
+ * @return              tb_true or tb_false (empty)
+ */
+tb_bool_t                   tb_co_thread_channel_recv_try(tb_co_thread_channel_ref_t channel, tb_pointer_t* pdata);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
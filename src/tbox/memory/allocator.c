@@ -39,6 +39,23 @@
 #include "../utils/utils.h"
 #include "../platform/platform.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// enter and leave the lock, the allocator with TB_ALLOCATOR_FLAG_NOLOCK will lock itself if necessary
+#define tb_allocator_lock_enter(allocator)      do { if (!((allocator)->flag & TB_ALLOCATOR_FLAG_NOLOCK)) tb_spinlock_enter(&(allocator)->lock); } while (0)
+#define tb_allocator_lock_leave(allocator)      do { if (!((allocator)->flag & TB_ALLOCATOR_FLAG_NOLOCK)) tb_spinlock_leave(&(allocator)->lock); } while (0)
+
+// enter and leave the heap profiler, only the outermost allocation of the nested allocators will be sampled
+#ifndef TB_CONFIG_MICRO_ENABLE
+#   define tb_allocator_profiler_enter()            (g_heap_profiler_rate? tb_heap_profiler_enter() : 0)
+#   define tb_allocator_profiler_leave(state, size) do { if (state) tb_heap_profiler_leave(state, size); } while (0)
+#else
+#   define tb_allocator_profiler_enter()            (0)
+#   define tb_allocator_profiler_leave(state, size) ((tb_void_t)(state))
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * globals
  */
@@ -46,6 +63,17 @@
 // the allocator 
 __tb_extern_c__ tb_allocator_ref_t  g_allocator = tb_null;
 
+#ifndef TB_CONFIG_MICRO_ENABLE
+// the sampling rate of the heap profiler, it is stopped if be zero
+__tb_extern_c__ extern tb_size_t    g_heap_profiler_rate;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * declaration
+ */
+__tb_extern_c__ tb_size_t           tb_heap_profiler_enter(tb_noarg_t);
+__tb_extern_c__ tb_void_t           tb_heap_profiler_leave(tb_size_t state, tb_size_t size);
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -66,8 +94,11 @@ tb_pointer_t tb_allocator_malloc_(tb_allocator_ref_t allocator, tb_size_t size _
     // check
     tb_assert_and_check_return_val(allocator, tb_null);
 
+    // enter the heap profiler
+    tb_size_t profiler = tb_allocator_profiler_enter();
+
     // enter
-    tb_spinlock_enter(&allocator->lock);
+    tb_allocator_lock_enter(allocator);
 
     // malloc it
     tb_pointer_t data = tb_null;
@@ -82,7 +113,10 @@ tb_pointer_t tb_allocator_malloc_(tb_allocator_ref_t allocator, tb_size_t size _
     tb_assertf(!(((tb_size_t)data) & (TB_POOL_DATA_ALIGN - 1)), "malloc(%lu): unaligned data: %p", size, data);
 
     // leave
-    tb_spinlock_leave(&allocator->lock);
+    tb_allocator_lock_leave(allocator);
+
+    // leave the heap profiler and sample it
+    tb_allocator_profiler_leave(profiler, data? size : 0);
 
     // ok?
     return data;
@@ -128,8 +162,11 @@ tb_pointer_t tb_allocator_ralloc_(tb_allocator_ref_t allocator, tb_pointer_t dat
     // check
     tb_assert_and_check_return_val(allocator, tb_null);
 
+    // enter the heap profiler
+    tb_size_t profiler = tb_allocator_profiler_enter();
+
     // enter
-    tb_spinlock_enter(&allocator->lock);
+    tb_allocator_lock_enter(allocator);
 
     // ralloc it
     tb_pointer_t data_new = tb_null;
@@ -158,7 +195,10 @@ tb_pointer_t tb_allocator_ralloc_(tb_allocator_ref_t allocator, tb_pointer_t dat
     tb_assertf(!(((tb_size_t)data_new) & (TB_POOL_DATA_ALIGN - 1)), "ralloc(%lu): unaligned data: %p", size, data);
 
     // leave
-    tb_spinlock_leave(&allocator->lock);
+    tb_allocator_lock_leave(allocator);
+
+    // leave the heap profiler and sample it
+    tb_allocator_profiler_leave(profiler, data_new? size : 0);
 
     // ok?
     return data_new;
@@ -169,7 +209,7 @@ tb_bool_t tb_allocator_free_(tb_allocator_ref_t allocator, tb_pointer_t data __t
     tb_assert_and_check_return_val(allocator, tb_false);
 
     // enter
-    tb_spinlock_enter(&allocator->lock);
+    tb_allocator_lock_enter(allocator);
 
     // trace
     tb_trace_d("free(%p): at %s(): %d, %s", data __tb_debug_args__);
@@ -195,7 +235,7 @@ tb_bool_t tb_allocator_free_(tb_allocator_ref_t allocator, tb_pointer_t data __t
 #endif
 
     // leave
-    tb_spinlock_leave(&allocator->lock);
+    tb_allocator_lock_leave(allocator);
 
     // ok?
     return ok;
@@ -205,8 +245,11 @@ tb_pointer_t tb_allocator_large_malloc_(tb_allocator_ref_t allocator, tb_size_t
     // check
     tb_assert_and_check_return_val(allocator, tb_null);
 
+    // enter the heap profiler
+    tb_size_t profiler = tb_allocator_profiler_enter();
+
     // enter
-    tb_spinlock_enter(&allocator->lock);
+    tb_allocator_lock_enter(allocator);
 
     // malloc it
     tb_pointer_t data = tb_null;
@@ -227,7 +270,10 @@ tb_pointer_t tb_allocator_large_malloc_(tb_allocator_ref_t allocator, tb_size_t
     tb_assert(!real || *real >= size);
 
     // leave
-    tb_spinlock_leave(&allocator->lock);
+    tb_allocator_lock_leave(allocator);
+
+    // leave the heap profiler and sample it
+    tb_allocator_profiler_leave(profiler, data? size : 0);
 
     // ok?
     return data;
@@ -273,8 +319,11 @@ tb_pointer_t tb_allocator_large_ralloc_(tb_allocator_ref_t allocator, tb_pointer
     // check
     tb_assert_and_check_return_val(allocator, tb_null);
 
+    // enter the heap profiler
+    tb_size_t profiler = tb_allocator_profiler_enter();
+
     // enter
-    tb_spinlock_enter(&allocator->lock);
+    tb_allocator_lock_enter(allocator);
 
     // ralloc it
     tb_pointer_t data_new = tb_null;
@@ -309,7 +358,10 @@ tb_pointer_t tb_allocator_large_ralloc_(tb_allocator_ref_t allocator, tb_pointer
     tb_assertf(!(((tb_size_t)data_new) & (TB_POOL_DATA_ALIGN - 1)), "ralloc(%lu): unaligned data: %p", size, data);
 
     // leave
-    tb_spinlock_leave(&allocator->lock);
+    tb_allocator_lock_leave(allocator);
+
+    // leave the heap profiler and sample it
+    tb_allocator_profiler_leave(profiler, data_new? size : 0);
 
     // ok?
     return data_new;
@@ -320,7 +372,7 @@ tb_bool_t tb_allocator_large_free_(tb_allocator_ref_t allocator, tb_pointer_t da
     tb_assert_and_check_return_val(allocator, tb_false);
 
     // enter
-    tb_spinlock_enter(&allocator->lock);
+    tb_allocator_lock_enter(allocator);
 
     // trace
     tb_trace_d("large_free(%p): at %s(): %d, %s", data __tb_debug_args__);
@@ -346,7 +398,7 @@ tb_bool_t tb_allocator_large_free_(tb_allocator_ref_t allocator, tb_pointer_t da
 #endif
 
     // leave
-    tb_spinlock_leave(&allocator->lock);
+    tb_allocator_lock_leave(allocator);
 
     // ok?
     return ok;
@@ -354,15 +406,15 @@ tb_bool_t tb_allocator_large_free_(tb_allocator_ref_t allocator, tb_pointer_t da
 tb_pointer_t tb_allocator_align_malloc_(tb_allocator_ref_t allocator, tb_size_t size, tb_size_t align __tb_debug_decl__)
 {
     // check
-    tb_assertf(!(align & 3), "invalid alignment size: %lu", align);
-    tb_check_return_val(!(align & 3), tb_null);
+    tb_assertf(!(align & 3) && align <= 256, "invalid alignment size: %lu", align);
+    tb_check_return_val(!(align & 3) && align <= 256, tb_null);
 
     // malloc it
     tb_byte_t* data = (tb_byte_t*)tb_allocator_malloc_(allocator, size + align __tb_debug_args__);
     tb_check_return_val(data, tb_null);
 
     // the different bytes
-    tb_byte_t diff = (tb_byte_t)((~(tb_long_t)data) & (align - 1)) + 1;
+    tb_size_t diff = (tb_size_t)((~(tb_long_t)data) & (align - 1)) + 1;
 
     // adjust the address
     data += diff;
@@ -370,8 +422,8 @@ tb_pointer_t tb_allocator_align_malloc_(tb_allocator_ref_t allocator, tb_size_t
     // check
     tb_assert(!((tb_size_t)data & (align - 1)));
 
-    // save the different bytes
-    data[-1] = diff;
+    // save the different bytes, (diff - 1) fits one byte for the alignment <= 256
+    data[-1] = (tb_byte_t)(diff - 1);
 
     // ok?
     return (tb_pointer_t)data;
@@ -407,11 +459,11 @@ tb_pointer_t tb_allocator_align_nalloc0_(tb_allocator_ref_t allocator, tb_size_t
 tb_pointer_t tb_allocator_align_ralloc_(tb_allocator_ref_t allocator, tb_pointer_t data, tb_size_t size, tb_size_t align __tb_debug_decl__)
 {
     // check align
-    tb_assertf(!(align & 3), "invalid alignment size: %lu", align);
-    tb_check_return_val(!(align & 3), tb_null);
+    tb_assertf(!(align & 3) && align <= 256, "invalid alignment size: %lu", align);
+    tb_check_return_val(!(align & 3) && align <= 256, tb_null);
 
     // ralloc?
-    tb_byte_t diff = 0;
+    tb_size_t diff = 0;
     if (data)
     {
         // check address 
@@ -419,7 +471,7 @@ tb_pointer_t tb_allocator_align_ralloc_(tb_allocator_ref_t allocator, tb_pointer
         tb_check_return_val(!((tb_size_t)data & (align - 1)), tb_null);
 
         // the different bytes
-        diff = ((tb_byte_t*)data)[-1];
+        diff = (tb_size_t)((tb_byte_t*)data)[-1] + 1;
 
         // adjust the address
         data = (tb_byte_t*)data - diff;
@@ -437,7 +489,7 @@ tb_pointer_t tb_allocator_align_ralloc_(tb_allocator_ref_t allocator, tb_pointer
     }
 
     // the different bytes
-    diff = (tb_byte_t)((~(tb_long_t)data) & (align - 1)) + 1;
+    diff = (tb_size_t)((~(tb_long_t)data) & (align - 1)) + 1;
 
     // adjust the address
     data = (tb_byte_t*)data + diff;
@@ -445,8 +497,8 @@ tb_pointer_t tb_allocator_align_ralloc_(tb_allocator_ref_t allocator, tb_pointer
     // check
     tb_assert(!((tb_size_t)data & (align - 1)));
 
-    // save the different bytes
-    ((tb_byte_t*)data)[-1] = diff;
+    // save the different bytes, (diff - 1) fits one byte for the alignment <= 256
+    ((tb_byte_t*)data)[-1] = (tb_byte_t)(diff - 1);
 
     // ok?
     return data;
@@ -458,7 +510,7 @@ tb_bool_t tb_allocator_align_free_(tb_allocator_ref_t allocator, tb_pointer_t da
     tb_assert(!((tb_size_t)data & 3));
 
     // the different bytes
-    tb_byte_t diff = ((tb_byte_t*)data)[-1];
+    tb_size_t diff = (tb_size_t)((tb_byte_t*)data)[-1] + 1;
 
     // adjust the address
     data = (tb_byte_t*)data - diff;
@@ -491,6 +543,40 @@ tb_void_t tb_allocator_exit(tb_allocator_ref_t allocator)
     // exit it
     if (allocator->exit) allocator->exit(allocator);
 }
+tb_bool_t tb_allocator_stat(tb_allocator_ref_t allocator, tb_allocator_stat_ref_t stat)
+{
+    // check
+    tb_assert_and_check_return_val(allocator && stat, tb_false);
+
+    // clear it first
+    tb_memset_(stat, 0, sizeof(tb_allocator_stat_t));
+
+    // not supported?
+    tb_check_return_val(allocator->stat, tb_false);
+
+    // enter
+    tb_spinlock_enter(&allocator->lock);
+
+    // get the stat of all size classes
+    tb_bool_t ok = allocator->stat(allocator, stat);
+
+    // leave
+    tb_spinlock_leave(&allocator->lock);
+
+    // compute the total stat
+    tb_size_t i = 0;
+    for (i = 0; ok && i < stat->class_count; i++)
+    {
+        tb_allocator_class_stat_ref_t cstat = &stat->classes[i];
+        stat->live_size     += cstat->live_size;
+        stat->peak_size     += cstat->peak_size;
+        stat->malloc_count  += cstat->malloc_count;
+        stat->free_count    += cstat->free_count;
+    }
+
+    // ok?
+    return ok;
+}
 #ifdef __tb_debug__
 tb_void_t tb_allocator_dump(tb_allocator_ref_t allocator)
 {
@@ -67,6 +67,12 @@ __tb_extern_c_enter__
 #define tb_allocator_align_ralloc(allocator, data, size, align)     tb_allocator_align_ralloc_(allocator, (tb_pointer_t)(data), size, align __tb_debug_vals__)
 #define tb_allocator_align_free(allocator, data)                    tb_allocator_align_free_(allocator, (tb_pointer_t)(data) __tb_debug_vals__)
 
+/// the max count of the size classes in the allocator stat
+#define TB_ALLOCATOR_STAT_CLASS_MAXN                                (16)
+
+/// the fragmentation rate (/10000) of the slots of the given size class stat
+#define tb_allocator_class_stat_frag(stat)                          ((stat)->slot_items? (((stat)->slot_items - (stat)->live_count) * 10000) / (stat)->slot_items : 0)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -80,15 +86,82 @@ typedef enum __tb_allocator_type_e
 ,   TB_ALLOCATOR_STATIC     = 4
 ,   TB_ALLOCATOR_LARGE      = 5
 ,   TB_ALLOCATOR_SMALL      = 6
+,   TB_ALLOCATOR_REGION     = 7
 
 }tb_allocator_type_e;
 
+/// the allocator flag enum
+typedef enum __tb_allocator_flag_e
+{
+    TB_ALLOCATOR_FLAG_NONE      = 0
+,   TB_ALLOCATOR_FLAG_NOLOCK    = 1     //!< the allocator is thread-safe by itself, do not enter the lock for malloc, ralloc and free
+
+}tb_allocator_flag_e;
+
+/// the allocator size class stat type
+typedef struct __tb_allocator_class_stat_t
+{
+    /// the item size of this class, it is zero for the large class
+    tb_size_t               item_size;
+
+    /// the live items count
+    tb_size_t               live_count;
+
+    /// the live bytes, the small item is counted by the item size of its class
+    tb_size_t               live_size;
+
+    /// the peak live bytes
+    tb_size_t               peak_size;
+
+    /// the malloc count
+    tb_size_t               malloc_count;
+
+    /// the free count
+    tb_size_t               free_count;
+
+    /// the slots count of the fixed pool
+    tb_size_t               slot_count;
+
+    /// the items capacity of all slots
+    tb_size_t               slot_items;
+
+    /// the bytes of all slots, or the bytes allocated from the system for the large class
+    tb_size_t               slot_size;
+
+}tb_allocator_class_stat_t, *tb_allocator_class_stat_ref_t;
+
+/// the allocator stat type
+typedef struct __tb_allocator_stat_t
+{
+    /// the live bytes of all classes
+    tb_size_t                   live_size;
+
+    /// the sum of the peak bytes of all classes
+    tb_size_t                   peak_size;
+
+    /// the malloc count of all classes
+    tb_size_t                   malloc_count;
+
+    /// the free count of all classes
+    tb_size_t                   free_count;
+
+    /// the size classes count
+    tb_size_t                   class_count;
+
+    /// the size classes, the small classes are sorted by the item size and the large class is the last one
+    tb_allocator_class_stat_t   classes[TB_ALLOCATOR_STAT_CLASS_MAXN];
+
+}tb_allocator_stat_t, *tb_allocator_stat_ref_t;
+
 /// the allocator type
 typedef struct __tb_allocator_t
 {
     /// the type
     tb_size_t               type;
 
+    /// the flag
+    tb_size_t               flag;
+
     /// the lock
     tb_spinlock_t           lock;
 
@@ -162,6 +235,15 @@ typedef struct __tb_allocator_t
      */
     tb_void_t               (*exit)(struct __tb_allocator_t* allocator);
 
+    /*! get the stat of all size classes, optional
+     *
+     * @param allocator     the allocator 
+     * @param stat          the stat, only need append the size classes to it
+     *
+     * @return              tb_true or tb_false
+     */
+    tb_bool_t               (*stat)(struct __tb_allocator_t* allocator, tb_allocator_stat_ref_t stat);
+
 #ifdef __tb_debug__
     /*! dump allocator
      *
@@ -330,7 +412,7 @@ tb_bool_t               tb_allocator_large_free_(tb_allocator_ref_t allocator, t
  *
  * @param allocator     the allocator 
  * @param size          the size
- * @param align         the alignment bytes
+ * @param align         the alignment bytes, it must be a multiple of 4 and not larger than 256
  *
  * @return              the data address
  */
@@ -399,6 +481,37 @@ tb_void_t               tb_allocator_clear(tb_allocator_ref_t allocator);
  */
 tb_void_t               tb_allocator_exit(tb_allocator_ref_t allocator);
 
+/*! get the allocator stat
+ *
+ * it is always available in the release mode, and the counters are updated without any extra lock.
+ *
+ * the fragmentation of the small class can be computed by tb_allocator_class_stat_frag(), 
+ * it is the rate of the free items in all slots of the fixed pool.
+ *
+ * @note the default allocator counts the user calls of its thread caches, so the cached items are not live items,
+ * but the counters of other threads are merged periodically and may be delayed a little,
+ * and the large class of the default allocator also contains the slots of the small classes.
+ *
+ * @code
+    tb_allocator_stat_t stat;
+    if (tb_allocator_stat(tb_allocator(), &stat))
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < stat.class_count; i++)
+        {
+            tb_allocator_class_stat_ref_t cstat = &stat.classes[i];
+            tb_trace_i("%lu: live: %lu, peak: %lu, frag: %lu/10000", cstat->item_size, cstat->live_size, cstat->peak_size, tb_allocator_class_stat_frag(cstat));
+        }
+    }
+ * @endcode
+ *
+ * @param allocator     the allocator 
+ * @param stat          the stat
+ *
+ * @return              tb_true or tb_false if this allocator does not support it
+ */
+tb_bool_t               tb_allocator_stat(tb_allocator_ref_t allocator, tb_allocator_stat_ref_t stat);
+
 #ifdef __tb_debug__
 /*! dump it
  *
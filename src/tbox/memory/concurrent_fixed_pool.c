@@ -0,0 +1,560 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        concurrent_fixed_pool.c
+ * @ingroup     memory
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "concurrent_fixed_pool"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "concurrent_fixed_pool.h"
+#include "impl/prefix.h"
+#include "../platform/impl/thread.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/* enable the thread cache?
+ *
+ * each thread will get an unique index at the first time and uses the cache at this index of all pools,
+ * the index will be released by the thread exit function after the thread has been exited, 
+ * and the left items in the cache will be reused by the next thread with the same index.
+ */
+#ifdef __tb_thread_local__
+#   define TB_CONCURRENT_FIXED_POOL_CACHE_ENABLE
+#endif
+
+// the max thread caches count, the other threads will use the shared cache with lock
+#define TB_CONCURRENT_FIXED_POOL_CACHE_MAXN         (64)
+
+// the default items count of each batch
+#ifdef __tb_small__
+#   define TB_CONCURRENT_FIXED_POOL_BATCH_SIZE      (16)
+#else
+#   define TB_CONCURRENT_FIXED_POOL_BATCH_SIZE      (32)
+#endif
+
+// the batches count of the first chunk
+#define TB_CONCURRENT_FIXED_POOL_CHUNK_BATCHES      (8)
+
+// the max chunks count, the items count of the chunk at index i is (first chunk items << i)
+#define TB_CONCURRENT_FIXED_POOL_CHUNK_MAXN         (24)
+
+// the padding bytes for avoiding the false sharing, TB_SMP_CACHE_BYTES may be less than the real cache line size
+#if TB_SMP_CACHE_BYTES > 64
+#   define TB_CONCURRENT_FIXED_POOL_PADDING         TB_SMP_CACHE_BYTES
+#else
+#   define TB_CONCURRENT_FIXED_POOL_PADDING         (64)
+#endif
+
+/* the tagged head of the global stack for avoiding the ABA problem
+ *
+ * [item index + 1: 32bits][tag: 32bits]
+ *
+ * we use the item index instead of the pointer, so it does not depend on the address width 
+ * (.e.g the top byte of the pointer may be used on arm64 or the user space may be larger than 2^48 with la57),
+ * and the 32bits tag will take a long time to wrap around.
+ */
+#define tb_concurrent_fixed_pool_tagged(index, tag) ((tb_hong_t)(((tb_hize_t)(tb_uint32_t)(index) << 32) | (tb_uint32_t)(tag)))
+#define tb_concurrent_fixed_pool_tagged_index(t)    ((tb_uint32_t)((tb_hize_t)(t) >> 32))
+#define tb_concurrent_fixed_pool_tagged_tag(t)      ((tb_uint32_t)(tb_hize_t)(t))
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the free item type
+typedef struct __tb_concurrent_fixed_pool_item_t
+{
+    // the next item
+    struct __tb_concurrent_fixed_pool_item_t*   next;
+
+    // the index + 1 of the next batch in the global stack, only for the first item of batch
+    tb_uint32_t                                 batch_next;
+
+}tb_concurrent_fixed_pool_item_t;
+
+// the cache type
+typedef struct __tb_concurrent_fixed_pool_cache_t
+{
+    // the free items
+    tb_concurrent_fixed_pool_item_t*            items;
+
+    // the free items count
+    tb_size_t                                   count;
+
+    // padding for avoiding the false sharing
+    tb_byte_t                                   padding[TB_CONCURRENT_FIXED_POOL_PADDING - sizeof(tb_pointer_t) - sizeof(tb_size_t)];
+
+}tb_concurrent_fixed_pool_cache_t;
+
+// the concurrent fixed pool type
+typedef struct __tb_concurrent_fixed_pool_t
+{
+    // the global stack of the free batches (tagged pointer)
+    tb_atomic64_t                               stack;
+
+    // padding for avoiding the false sharing
+    tb_byte_t                                   padding[TB_CONCURRENT_FIXED_POOL_PADDING - sizeof(tb_atomic64_t)];
+
+    // the allocator
+    tb_allocator_ref_t                          allocator;
+
+    // the item size
+    tb_size_t                                   item_size;
+
+    // the aligned item size
+    tb_size_t                                   item_space;
+
+    // the items count of each batch
+    tb_size_t                                   batch_size;
+
+    // the items count shift of the first chunk
+    tb_size_t                                   chunk_shift;
+
+    // the chunks lock
+    tb_spinlock_t                               lock;
+
+    // the chunks, they will not be moved or freed before exiting pool
+    tb_byte_t*                                  chunks[TB_CONCURRENT_FIXED_POOL_CHUNK_MAXN];
+
+    // the chunks count
+    tb_size_t                                   chunk_count;
+
+    // the shared cache lock
+    tb_spinlock_t                               shared_lock;
+
+    // the shared cache for the threads without index
+    tb_concurrent_fixed_pool_cache_t            shared;
+
+#ifdef TB_CONCURRENT_FIXED_POOL_CACHE_ENABLE
+    // the thread caches
+    tb_concurrent_fixed_pool_cache_t            caches[TB_CONCURRENT_FIXED_POOL_CACHE_MAXN];
+#endif
+
+#ifdef __tb_debug__
+    // the malloc count
+    tb_atomic_t                                 malloc_count;
+
+    // the free count
+    tb_atomic_t                                 free_count;
+#endif
+
+}tb_concurrent_fixed_pool_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+#ifdef TB_CONCURRENT_FIXED_POOL_CACHE_ENABLE
+
+// the used flags of the thread indices
+static tb_atomic_t                          g_concurrent_fixed_pool_indices[TB_CONCURRENT_FIXED_POOL_CACHE_MAXN];
+
+// the thread index of the current thread, 0: not inited, -1: no free index, > 0: index + 1
+static __tb_thread_local__ tb_long_t        g_concurrent_fixed_pool_index = 0;
+
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+#ifdef TB_CONCURRENT_FIXED_POOL_CACHE_ENABLE
+static tb_void_t tb_concurrent_fixed_pool_exit_thread()
+{
+    // release the index of the current thread
+    tb_long_t index = g_concurrent_fixed_pool_index;
+    if (index > 0) tb_atomic_set0(&g_concurrent_fixed_pool_indices[index - 1]);
+    g_concurrent_fixed_pool_index = 0;
+}
+static tb_long_t tb_concurrent_fixed_pool_thread_index()
+{
+    // get the index of the current thread
+    tb_long_t index = g_concurrent_fixed_pool_index;
+    if (!index)
+    {
+        // find a free index
+        tb_size_t i = 0;
+        index = -1;
+        for (i = 0; i < TB_CONCURRENT_FIXED_POOL_CACHE_MAXN; i++)
+        {
+            if (!tb_atomic_get(&g_concurrent_fixed_pool_indices[i]) && !tb_atomic_fetch_and_pset(&g_concurrent_fixed_pool_indices[i], 0, 1))
+            {
+                index = (tb_long_t)i + 1;
+                break;
+            }
+        }
+
+        // release this index when the current thread is exited, even if it is not created by tb_thread_init()
+        if (index > 0) tb_thread_exit_attach(tb_concurrent_fixed_pool_exit_thread);
+
+        // save it
+        g_concurrent_fixed_pool_index = index;
+    }
+
+    // ok?
+    return index > 0? index - 1 : -1;
+}
+#endif
+static tb_concurrent_fixed_pool_item_t* tb_concurrent_fixed_pool_item(tb_concurrent_fixed_pool_t* pool, tb_uint32_t index)
+{
+    /* get the chunk of this item
+     *
+     * chunk: | 0: 1 << shift | 1: 2 << shift | 2: 4 << shift | ... 
+     * first: 0               (1 << shift)    (3 << shift)      ... ((1 << i) - 1) << shift
+     */
+    tb_size_t i = 31 - tb_bits_cl0_u32_be((index >> pool->chunk_shift) + 1);
+    tb_assert(i < pool->chunk_count && pool->chunks[i]);
+
+    // get the item
+    return (tb_concurrent_fixed_pool_item_t*)(pool->chunks[i] + (index - ((((tb_size_t)1 << i) - 1) << pool->chunk_shift)) * pool->item_space);
+}
+static tb_uint32_t tb_concurrent_fixed_pool_index(tb_concurrent_fixed_pool_t* pool, tb_concurrent_fixed_pool_item_t* item)
+{
+    /* find the chunk of this item
+     *
+     * the chunk of this item has been made before the item is allocated,
+     * and the chunks are never moved or freed, so we need not lock it
+     */
+    tb_size_t   i = 0;
+    tb_byte_t*  p = (tb_byte_t*)item;
+    for (i = 0; i < TB_CONCURRENT_FIXED_POOL_CHUNK_MAXN && pool->chunks[i]; i++)
+    {
+        tb_size_t n = ((tb_size_t)1 << i) << pool->chunk_shift;
+        if (p >= pool->chunks[i] && p < pool->chunks[i] + n * pool->item_space)
+            return (tb_uint32_t)(((((tb_size_t)1 << i) - 1) << pool->chunk_shift) + (p - pool->chunks[i]) / pool->item_space);
+    }
+
+    // the item is not in this pool
+    tb_assert(0);
+    return 0;
+}
+static tb_void_t tb_concurrent_fixed_pool_push(tb_concurrent_fixed_pool_t* pool, tb_concurrent_fixed_pool_item_t* batch)
+{
+    // the index of this batch
+    tb_uint32_t index = tb_concurrent_fixed_pool_index(pool, batch);
+
+    // push it to the global stack
+    tb_hong_t head;
+    tb_hong_t tagged;
+    do
+    {
+        head = tb_atomic64_get(&pool->stack);
+        batch->batch_next = tb_concurrent_fixed_pool_tagged_index(head);
+        tagged = tb_concurrent_fixed_pool_tagged(index + 1, tb_concurrent_fixed_pool_tagged_tag(head) + 1);
+
+    } while (tb_atomic64_fetch_and_pset(&pool->stack, head, tagged) != head);
+}
+static tb_concurrent_fixed_pool_item_t* tb_concurrent_fixed_pool_pop(tb_concurrent_fixed_pool_t* pool)
+{
+    /* pop a batch from the global stack
+     *
+     * the batch may have been popped and used by other threads before reading batch_next,
+     * but the chunks are never freed before exiting pool, so it is safe to read it, 
+     * and the tag will be changed and the cmpset will be failed.
+     */
+    tb_hong_t                           head;
+    tb_hong_t                           tagged;
+    tb_uint32_t                         index;
+    tb_concurrent_fixed_pool_item_t*    batch;
+    do
+    {
+        head = tb_atomic64_get(&pool->stack);
+        index = tb_concurrent_fixed_pool_tagged_index(head);
+        tb_check_return_val(index, tb_null);
+
+        batch = tb_concurrent_fixed_pool_item(pool, index - 1);
+        tagged = tb_concurrent_fixed_pool_tagged(batch->batch_next, tb_concurrent_fixed_pool_tagged_tag(head) + 1);
+
+    } while (tb_atomic64_fetch_and_pset(&pool->stack, head, tagged) != head);
+
+    // ok
+    return batch;
+}
+static tb_concurrent_fixed_pool_item_t* tb_concurrent_fixed_pool_grow(tb_concurrent_fixed_pool_t* pool)
+{
+    // enter lock
+    tb_spinlock_enter(&pool->lock);
+
+    // other threads may have grown it
+    tb_concurrent_fixed_pool_item_t* batch = tb_concurrent_fixed_pool_pop(pool);
+    tb_size_t                        index = pool->chunk_count;
+    tb_size_t                        count = ((tb_size_t)1 << index) << pool->chunk_shift;
+
+    /* make a new chunk, the items count is doubled for each chunk
+     *
+     * the total items count must be less than 2^32 for storing the item index + 1 in the tagged head
+     */
+    tb_byte_t* chunk = tb_null;
+    if (!batch && index < TB_CONCURRENT_FIXED_POOL_CHUNK_MAXN && (((((tb_hize_t)1 << (index + 1)) - 1) << pool->chunk_shift) >> 32) == 0)
+        chunk = (tb_byte_t*)tb_allocator_malloc(pool->allocator, count * pool->item_space);
+    if (chunk)
+    {
+        // save the chunk
+        pool->chunks[index] = chunk;
+        pool->chunk_count++;
+
+        // make batches, the left items (less than one batch) are not used
+        tb_size_t   i = 0;
+        tb_size_t   j = 0;
+        tb_size_t   n = count / pool->batch_size;
+        tb_byte_t*  data = chunk;
+        for (i = 0; i < n; i++)
+        {
+            // link all items of this batch
+            tb_concurrent_fixed_pool_item_t* head = (tb_concurrent_fixed_pool_item_t*)data;
+            for (j = 1; j < pool->batch_size; j++, data += pool->item_space)
+                ((tb_concurrent_fixed_pool_item_t*)data)->next = (tb_concurrent_fixed_pool_item_t*)(data + pool->item_space);
+            ((tb_concurrent_fixed_pool_item_t*)data)->next = tb_null;
+            data += pool->item_space;
+
+            // return the first batch and push the others to the global stack
+            if (!batch) batch = head;
+            else tb_concurrent_fixed_pool_push(pool, head);
+        }
+    }
+
+    // leave lock
+    tb_spinlock_leave(&pool->lock);
+
+    // ok?
+    return batch;
+}
+static tb_pointer_t tb_concurrent_fixed_pool_cache_malloc(tb_concurrent_fixed_pool_t* pool, tb_concurrent_fixed_pool_cache_t* cache)
+{
+    // no free items? get a batch from the global stack or make new batches
+    tb_concurrent_fixed_pool_item_t* item = cache->items;
+    if (!item)
+    {
+        item = tb_concurrent_fixed_pool_pop(pool);
+        if (!item) item = tb_concurrent_fixed_pool_grow(pool);
+        tb_check_return_val(item, tb_null);
+        cache->count = pool->batch_size;
+    }
+
+    // pop an item
+    cache->items = item->next;
+    cache->count--;
+
+    // ok
+    return (tb_pointer_t)item;
+}
+static tb_void_t tb_concurrent_fixed_pool_cache_free(tb_concurrent_fixed_pool_t* pool, tb_concurrent_fixed_pool_cache_t* cache, tb_pointer_t data)
+{
+    // push the item
+    tb_concurrent_fixed_pool_item_t* item = (tb_concurrent_fixed_pool_item_t*)data;
+    item->next = cache->items;
+    cache->items = item;
+    cache->count++;
+
+    // too many free items? move a batch to the global stack, we keep another batch for the next malloc
+    if (cache->count >= (pool->batch_size << 1))
+    {
+        // detach the first batch
+        tb_size_t                           n = pool->batch_size;
+        tb_concurrent_fixed_pool_item_t*    last = item;
+        while (--n) last = last->next;
+        cache->items = last->next;
+        cache->count -= pool->batch_size;
+        last->next = tb_null;
+
+        // push it
+        tb_concurrent_fixed_pool_push(pool, item);
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_concurrent_fixed_pool_ref_t tb_concurrent_fixed_pool_init(tb_allocator_ref_t allocator, tb_size_t batch_size, tb_size_t item_size)
+{
+    // check
+    tb_assert_and_check_return_val(item_size, tb_null);
+
+    // done
+    tb_bool_t                   ok = tb_false;
+    tb_concurrent_fixed_pool_t* pool = tb_null;
+    do
+    {
+        // uses the global allocator by default
+        if (!allocator) allocator = tb_allocator();
+
+        // make pool
+        pool = (tb_concurrent_fixed_pool_t*)tb_allocator_malloc0(allocator, sizeof(tb_concurrent_fixed_pool_t));
+        tb_assert_and_check_break(pool);
+
+        // init pool
+        pool->allocator     = allocator;
+        pool->item_size     = item_size;
+        pool->item_space    = tb_align(tb_max(item_size, sizeof(tb_concurrent_fixed_pool_item_t)), TB_POOL_DATA_ALIGN);
+        pool->batch_size    = batch_size? batch_size : TB_CONCURRENT_FIXED_POOL_BATCH_SIZE;
+        tb_assert_and_check_break(pool->batch_size && pool->batch_size <= (1 << 20));
+
+        // the items count of the first chunk is the power of 2 for computing the item index quickly
+        tb_size_t chunk_items = pool->batch_size * TB_CONCURRENT_FIXED_POOL_CHUNK_BATCHES;
+        pool->chunk_shift   = 31 - tb_bits_cl0_u32_be(tb_align_pow2(chunk_items));
+
+        // init lock
+        if (!tb_spinlock_init(&pool->lock)) break;
+        if (!tb_spinlock_init(&pool->shared_lock)) break;
+
+        // register lock profiler
+#ifdef TB_LOCK_PROFILER_ENABLE
+        tb_lock_profiler_register(tb_lock_profiler(), (tb_pointer_t)&pool->shared_lock, TB_TRACE_MODULE_NAME);
+#endif
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (pool) tb_concurrent_fixed_pool_exit((tb_concurrent_fixed_pool_ref_t)pool);
+        pool = tb_null;
+    }
+
+    // ok?
+    return (tb_concurrent_fixed_pool_ref_t)pool;
+}
+tb_void_t tb_concurrent_fixed_pool_exit(tb_concurrent_fixed_pool_ref_t self)
+{
+    // check
+    tb_concurrent_fixed_pool_t* pool = (tb_concurrent_fixed_pool_t*)self;
+    tb_assert_and_check_return(pool);
+
+    // exit all chunks
+    tb_size_t i = 0;
+    for (i = 0; i < pool->chunk_count; i++)
+    {
+        tb_allocator_free(pool->allocator, pool->chunks[i]);
+        pool->chunks[i] = tb_null;
+    }
+    pool->chunk_count = 0;
+
+    // exit lock
+    tb_spinlock_exit(&pool->lock);
+    tb_spinlock_exit(&pool->shared_lock);
+
+    // exit it
+    tb_allocator_free(pool->allocator, pool);
+}
+tb_size_t tb_concurrent_fixed_pool_item_size(tb_concurrent_fixed_pool_ref_t self)
+{
+    // check
+    tb_concurrent_fixed_pool_t* pool = (tb_concurrent_fixed_pool_t*)self;
+    tb_assert_and_check_return_val(pool, 0);
+
+    // the item size
+    return pool->item_size;
+}
+tb_pointer_t tb_concurrent_fixed_pool_malloc(tb_concurrent_fixed_pool_ref_t self)
+{
+    // check
+    tb_concurrent_fixed_pool_t* pool = (tb_concurrent_fixed_pool_t*)self;
+    tb_assert_and_check_return_val(pool, tb_null);
+
+    // malloc it from the thread cache
+    tb_pointer_t data = tb_null;
+#ifdef TB_CONCURRENT_FIXED_POOL_CACHE_ENABLE
+    tb_long_t index = tb_concurrent_fixed_pool_thread_index();
+    if (index >= 0) data = tb_concurrent_fixed_pool_cache_malloc(pool, &pool->caches[index]);
+    else
+#endif
+    {
+        // malloc it from the shared cache
+        tb_spinlock_enter(&pool->shared_lock);
+        data = tb_concurrent_fixed_pool_cache_malloc(pool, &pool->shared);
+        tb_spinlock_leave(&pool->shared_lock);
+    }
+
+#ifdef __tb_debug__
+    // update the malloc count
+    if (data) tb_atomic_fetch_and_inc(&pool->malloc_count);
+#endif
+
+    // ok?
+    return data;
+}
+tb_pointer_t tb_concurrent_fixed_pool_malloc0(tb_concurrent_fixed_pool_ref_t self)
+{
+    // malloc it
+    tb_pointer_t data = tb_concurrent_fixed_pool_malloc(self);
+    tb_check_return_val(data, tb_null);
+
+    // clear it
+    tb_memset_(data, 0, ((tb_concurrent_fixed_pool_t*)self)->item_size);
+
+    // ok
+    return data;
+}
+tb_void_t tb_concurrent_fixed_pool_free(tb_concurrent_fixed_pool_ref_t self, tb_pointer_t data)
+{
+    // check
+    tb_concurrent_fixed_pool_t* pool = (tb_concurrent_fixed_pool_t*)self;
+    tb_assert_and_check_return(pool && data);
+
+#ifdef __tb_debug__
+    // update the free count
+    tb_atomic_fetch_and_inc(&pool->free_count);
+#endif
+
+    // free it to the thread cache
+#ifdef TB_CONCURRENT_FIXED_POOL_CACHE_ENABLE
+    tb_long_t index = tb_concurrent_fixed_pool_thread_index();
+    if (index >= 0) tb_concurrent_fixed_pool_cache_free(pool, &pool->caches[index], data);
+    else
+#endif
+    {
+        // free it to the shared cache
+        tb_spinlock_enter(&pool->shared_lock);
+        tb_concurrent_fixed_pool_cache_free(pool, &pool->shared, data);
+        tb_spinlock_leave(&pool->shared_lock);
+    }
+}
+#ifdef __tb_debug__
+tb_void_t tb_concurrent_fixed_pool_dump(tb_concurrent_fixed_pool_ref_t self)
+{
+    // check
+    tb_concurrent_fixed_pool_t* pool = (tb_concurrent_fixed_pool_t*)self;
+    tb_assert_and_check_return(pool);
+
+    // dump it
+    tb_spinlock_enter(&pool->lock);
+    tb_trace_i("item_size: %lu, batch_size: %lu, chunk_count: %lu, item_maxn: %lu"
+            , pool->item_size
+            , pool->batch_size
+            , pool->chunk_count
+            , ((((tb_size_t)1 << pool->chunk_count) - 1) << pool->chunk_shift));
+    tb_spinlock_leave(&pool->lock);
+    tb_trace_i("malloc_count: %ld, free_count: %ld", tb_atomic_get(&pool->malloc_count), tb_atomic_get(&pool->free_count));
+}
+#endif
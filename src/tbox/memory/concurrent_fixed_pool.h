@@ -0,0 +1,154 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        concurrent_fixed_pool.h
+ * @ingroup     memory
+ *
+ */
+#ifndef TB_MEMORY_CONCURRENT_FIXED_POOL_H
+#define TB_MEMORY_CONCURRENT_FIXED_POOL_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "allocator.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the concurrent fixed pool ref type
+ *
+ * <pre>
+ *
+ * thread 0: cache: item <- item <- item ...    thread 1: cache: item <- item ...   ...   shared cache (lock): item <- ...
+ *                    |                                            |                                          |
+ *                    `-------- move batch items if the cache is full or empty -------------------------------`
+ *                                                    |
+ *                              ---------------------------------------------------- 
+ *  global stack (lock-free):  | batch | <- | batch | <- | batch | <- ... (tagged) |
+ *                              ---------------------------------------------------- 
+ *                                                    |
+ *                                    make new batches from the chunks (lock)
+ *
+ * </pre>
+ *
+ * the items are only returned to the allocator after the pool has been exited.
+ */
+typedef __tb_typeref__(concurrent_fixed_pool);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init the concurrent fixed pool
+ *
+ * all interfaces are thread-safe, and the malloc and free are lock-free in most cases. 
+ *
+ * each thread has its own cache of the free items, 
+ * and moves the batch items between it and the global lock-free stack,
+ * so the items can be allocated in one thread and freed in other threads.
+ *
+ * @code
+ 
+    // init pool
+    tb_concurrent_fixed_pool_ref_t pool = tb_concurrent_fixed_pool_init(tb_null, 0, sizeof(tb_message_t));
+    if (pool)
+    {
+        // the producer thread
+        tb_message_t* message = (tb_message_t*)tb_concurrent_fixed_pool_malloc(pool);
+
+        // ...
+
+        // the consumer thread
+        tb_concurrent_fixed_pool_free(pool, message);
+
+        // exit pool after all threads have been finished
+        tb_concurrent_fixed_pool_exit(pool);
+    }
+ * @endcode
+ *
+ * @param allocator         the allocator of the chunks, uses the global allocator if be null
+ * @param batch_size        the items count of each batch, using the default size if be zero
+ * @param item_size         the item size
+ *
+ * @return                  the pool 
+ */
+tb_concurrent_fixed_pool_ref_t  tb_concurrent_fixed_pool_init(tb_allocator_ref_t allocator, tb_size_t batch_size, tb_size_t item_size);
+
+/*! exit the pool and free all items
+ *
+ * @note it is not thread-safe and all items will be invalid after exiting it
+ *
+ * @param pool              the pool 
+ */
+tb_void_t                       tb_concurrent_fixed_pool_exit(tb_concurrent_fixed_pool_ref_t pool);
+
+/*! the item size
+ *
+ * @param pool              the pool 
+ *
+ * @return                  the item size
+ */
+tb_size_t                       tb_concurrent_fixed_pool_item_size(tb_concurrent_fixed_pool_ref_t pool);
+
+/*! malloc item
+ *
+ * @param pool              the pool 
+ * 
+ * @return                  the item
+ */
+tb_pointer_t                    tb_concurrent_fixed_pool_malloc(tb_concurrent_fixed_pool_ref_t pool);
+
+/*! malloc item and clear it
+ *
+ * @param pool              the pool 
+ *
+ * @return                  the item
+ */
+tb_pointer_t                    tb_concurrent_fixed_pool_malloc0(tb_concurrent_fixed_pool_ref_t pool);
+
+/*! free item, it can be freed in the other thread
+ *
+ * @param pool              the pool 
+ * @param item              the item
+ */
+tb_void_t                       tb_concurrent_fixed_pool_free(tb_concurrent_fixed_pool_ref_t pool, tb_pointer_t item);
+
+#ifdef __tb_debug__
+/*! dump pool
+ *
+ * @param pool              the pool 
+ */
+tb_void_t                       tb_concurrent_fixed_pool_dump(tb_concurrent_fixed_pool_ref_t pool);
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -38,6 +38,29 @@
 #include "large_allocator.h"
 #include "default_allocator.h"
 #include "impl/prefix.h"
+#include "../platform/impl/thread.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/* enable the thread cache for the small data?
+ *
+ * the cached data is still checked and traced in the debug mode,
+ * the thread cache will update the debug info and check the underflow and double free by itself.
+ */
+#ifdef __tb_thread_local__
+#   define TB_DEFAULT_ALLOCATOR_CACHE_ENABLE
+#endif
+
+// the size classes count of the small allocator
+#define TB_DEFAULT_ALLOCATOR_CACHE_CLASS_MAXN       (12)
+
+// the batch bytes of moving items between the thread cache and the small allocator
+#define TB_DEFAULT_ALLOCATOR_CACHE_BATCH_SIZE       (4096)
+
+// the maximum batches count in the remote free list of each size class
+#define TB_DEFAULT_ALLOCATOR_CACHE_REMOTE_MAXN      (8)
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
@@ -55,17 +78,475 @@ typedef struct __tb_default_allocator_t
     // the small allocator
     tb_allocator_ref_t      small_allocator;
 
+#ifdef TB_DEFAULT_ALLOCATOR_CACHE_ENABLE
+    // the unique id for the thread cache, the allocator may be re-inited at the same address
+    tb_size_t               id;
+
+    // the next live allocator
+    struct __tb_default_allocator_t* next;
+
+    /* the remote free list of each size class
+     *
+     * the batches flushed from the thread caches are pushed here without lock 
+     * and the threads which need refill their caches will take them all first.
+     *
+     * the items of each batch are linked by the first pointer of data 
+     * and the batches are linked by the second pointer of the first item.
+     */
+    tb_atomic_t             remote[TB_DEFAULT_ALLOCATOR_CACHE_CLASS_MAXN];
+
+    // the batches count in the remote free list of each size class
+    tb_atomic_t             remote_count[TB_DEFAULT_ALLOCATOR_CACHE_CLASS_MAXN];
+
+    /* the stat of the thread caches for each size class
+     *
+     * the small allocator only knows the batches moved by refill and flush,
+     * so we count the user calls in the thread caches and merge them here periodically.
+     */
+    tb_atomic_t             cache_malloc_count[TB_DEFAULT_ALLOCATOR_CACHE_CLASS_MAXN];
+
+    // the free count of the thread caches
+    tb_atomic_t             cache_free_count[TB_DEFAULT_ALLOCATOR_CACHE_CLASS_MAXN];
+
+    // the peak live count of the thread caches
+    tb_atomic_t             cache_peak_count[TB_DEFAULT_ALLOCATOR_CACHE_CLASS_MAXN];
+
+    // the items count moved from the small allocator to the thread caches
+    tb_atomic_t             cache_refill_count[TB_DEFAULT_ALLOCATOR_CACHE_CLASS_MAXN];
+
+    // the items count moved from the thread caches to the small allocator
+    tb_atomic_t             cache_flush_count[TB_DEFAULT_ALLOCATOR_CACHE_CLASS_MAXN];
+#endif
+
 }tb_default_allocator_t, *tb_default_allocator_ref_t;
 
+#ifdef TB_DEFAULT_ALLOCATOR_CACHE_ENABLE
+/* the thread cache type
+ *
+ * <pre>
+ *
+ *  thread:        [items: 16B] [items: 32B] ... [items: 3072B]    <= malloc and free without lock
+ *                       |            |                 |
+ *                     batch        batch             batch        <= refill and flush without lock
+ *                       |            |                 |
+ *  remote:          [batches]    [batches]   ...  [batches]
+ *                       |            |                 |
+ *                     batch        batch             batch        <= refill and flush with the lock of small allocator
+ *                       |            |                 |
+ *  small allocator: [fixed pool] [fixed pool] ... [fixed pool]
+ *
+ * </pre>
+ *
+ * all items are owned by the fixed pools of small allocator, so the data freed by other threads will be cached in the current thread, 
+ * the surplus batches are passed to the allocating threads by the remote free list and return to the pools only if it is full.
+ */
+typedef struct __tb_default_allocator_cache_t
+{
+    // the owner allocator
+    tb_default_allocator_ref_t  allocator;
+
+    // the owner allocator id
+    tb_size_t                   id;
+
+    // the total cached items count
+    tb_size_t                   total;
+
+    // the cached items of each size class, linked by the first pointer of data
+    tb_pointer_t                items[TB_DEFAULT_ALLOCATOR_CACHE_CLASS_MAXN];
+
+    // the cached items count of each size class
+    tb_uint16_t                 count[TB_DEFAULT_ALLOCATOR_CACHE_CLASS_MAXN];
+
+    // the operations count for merging the stat periodically
+    tb_uint16_t                 merge_ops;
+
+    // the malloc count of each size class, it has not been merged to the allocator
+    tb_size_t                   malloc_count[TB_DEFAULT_ALLOCATOR_CACHE_CLASS_MAXN];
+
+    // the free count of each size class, it has not been merged to the allocator
+    tb_size_t                   free_count[TB_DEFAULT_ALLOCATOR_CACHE_CLASS_MAXN];
+
+}tb_default_allocator_cache_t;
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * declaration
+ */
+#ifdef TB_DEFAULT_ALLOCATOR_CACHE_ENABLE
+static tb_void_t            tb_default_allocator_cache_exit_thread(tb_noarg_t);
+__tb_extern_c__ tb_size_t   tb_small_allocator_malloc_list(tb_allocator_ref_t allocator, tb_size_t space, tb_size_t count, tb_pointer_t* plist);
+__tb_extern_c__ tb_void_t   tb_small_allocator_free_list(tb_allocator_ref_t allocator, tb_size_t space, tb_pointer_t list, tb_size_t count);
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+#ifdef TB_DEFAULT_ALLOCATOR_CACHE_ENABLE
+
+// the data space of each size class, it is the same as the fixed pools of small allocator
+static tb_uint16_t const                            g_default_allocator_cache_space[TB_DEFAULT_ALLOCATOR_CACHE_CLASS_MAXN] = 
+{
+    16, 32, 64, 96, 128, 192, 256, 384, 512, 1024, 2048, 3072
+};
+
+// the size class index of (size + 15) >> 4, it will be inited in tb_default_allocator_init()
+static tb_byte_t                                    g_default_allocator_cache_index[(TB_SMALL_ALLOCATOR_DATA_MAXN >> 4) + 1];
+
+// the batch count of each size class, it will be inited in tb_default_allocator_init()
+static tb_uint16_t                                  g_default_allocator_cache_batch[TB_DEFAULT_ALLOCATOR_CACHE_CLASS_MAXN];
+
+// the allocator id
+static tb_atomic_t                                  g_default_allocator_cache_id = 0;
+
+// the live allocators, the thread caches can only be flushed to them
+static tb_default_allocator_ref_t                   g_default_allocator_cache_list = tb_null;
+
+// the lock of the live allocators
+static tb_spinlock_t                                g_default_allocator_cache_lock = TB_SPINLOCK_INIT;
+
+// the thread cache
+static __tb_thread_local__ tb_default_allocator_cache_t g_default_allocator_cache;
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
+#ifdef TB_DEFAULT_ALLOCATOR_CACHE_ENABLE
+static tb_void_t tb_default_allocator_cache_init()
+{
+    // have been inited?
+    tb_check_return(!g_default_allocator_cache_batch[0]);
+
+    // init the size class index and batch count
+    tb_size_t i = 0;
+    tb_size_t k = 0;
+    for (i = 1; i < tb_arrayn(g_default_allocator_cache_index); i++)
+    {
+        while ((i << 4) > g_default_allocator_cache_space[k]) k++;
+        g_default_allocator_cache_index[i] = (tb_byte_t)k;
+    }
+    for (i = 0; i < TB_DEFAULT_ALLOCATOR_CACHE_CLASS_MAXN; i++)
+    {
+        tb_size_t batch = TB_DEFAULT_ALLOCATOR_CACHE_BATCH_SIZE / g_default_allocator_cache_space[i];
+        g_default_allocator_cache_batch[i] = (tb_uint16_t)tb_max(tb_min(batch, 32), 2);
+    }
+}
+static tb_bool_t tb_default_allocator_cache_live(tb_default_allocator_ref_t allocator, tb_size_t id)
+{
+    // check
+    tb_assert(allocator);
+
+    // is this allocator still alive? it must be called in the lock of the live allocators
+    tb_default_allocator_ref_t live = g_default_allocator_cache_list;
+    while (live && (live != allocator || live->id != id)) live = live->next;
+    return live != tb_null;
+}
+static tb_void_t tb_default_allocator_cache_merge(tb_default_allocator_cache_t* cache, tb_size_t index)
+{
+    // merge the malloc and free count of this size class to the allocator
+    tb_default_allocator_ref_t allocator = cache->allocator;
+    if (cache->malloc_count[index])
+    {
+        tb_atomic_fetch_and_add(&allocator->cache_malloc_count[index], (tb_long_t)cache->malloc_count[index]);
+        cache->malloc_count[index] = 0;
+    }
+    if (cache->free_count[index])
+    {
+        tb_atomic_fetch_and_add(&allocator->cache_free_count[index], (tb_long_t)cache->free_count[index]);
+        cache->free_count[index] = 0;
+    }
+
+    // update the peak live count
+    tb_long_t live = tb_atomic_get(&allocator->cache_malloc_count[index]) - tb_atomic_get(&allocator->cache_free_count[index]);
+    tb_long_t peak = tb_atomic_get(&allocator->cache_peak_count[index]);
+    while (live > peak && tb_atomic_fetch_and_pset(&allocator->cache_peak_count[index], peak, live) != peak)
+        peak = tb_atomic_get(&allocator->cache_peak_count[index]);
+}
+static tb_void_t tb_default_allocator_cache_merge_all(tb_default_allocator_cache_t* cache)
+{
+    // merge the stat of all size classes
+    tb_size_t i = 0;
+    for (i = 0; i < TB_DEFAULT_ALLOCATOR_CACHE_CLASS_MAXN; i++)
+        tb_default_allocator_cache_merge(cache, i);
+    cache->merge_ops = 0;
+}
+static tb_default_allocator_cache_t* tb_default_allocator_cache_bind(tb_default_allocator_ref_t allocator)
+{
+    // the thread cache
+    tb_default_allocator_cache_t* cache = &g_default_allocator_cache;
+    if (cache->allocator)
+    {
+        // it still caches the items of other live allocator? we use the small allocator directly
+        tb_spinlock_enter(&g_default_allocator_cache_lock);
+        tb_bool_t live = tb_default_allocator_cache_live(cache->allocator, cache->id);
+        if (live && cache->total)
+        {
+            tb_spinlock_leave(&g_default_allocator_cache_lock);
+            return tb_null;
+        }
+
+        // merge the stat to the previous allocator if it is still alive
+        if (live) tb_default_allocator_cache_merge_all(cache);
+        tb_spinlock_leave(&g_default_allocator_cache_lock);
+
+        // the previous allocator has no cached items, or it has been exited and the cached items have been freed with its pools, drop them
+        tb_memset_(cache, 0, sizeof(tb_default_allocator_cache_t));
+    }
+
+    // flush this thread cache on exit
+    tb_thread_exit_attach(tb_default_allocator_cache_exit_thread);
+
+    // bind it to this allocator
+    cache->allocator    = allocator;
+    cache->id           = allocator->id;
+    return cache;
+}
+static __tb_inline__ tb_default_allocator_cache_t* tb_default_allocator_cache(tb_default_allocator_ref_t allocator)
+{
+    // the thread cache of this allocator?
+    tb_default_allocator_cache_t* cache = &g_default_allocator_cache;
+    return cache->id == allocator->id? cache : tb_default_allocator_cache_bind(allocator);
+}
+static tb_void_t tb_default_allocator_cache_push(tb_default_allocator_ref_t allocator, tb_size_t index, tb_pointer_t list)
+{
+    // the remote free list is full? return this batch to the small allocator
+    if (tb_atomic_fetch_and_inc(&allocator->remote_count[index]) >= TB_DEFAULT_ALLOCATOR_CACHE_REMOTE_MAXN)
+    {
+        tb_atomic_fetch_and_dec(&allocator->remote_count[index]);
+        tb_atomic_fetch_and_add(&allocator->cache_flush_count[index], g_default_allocator_cache_batch[index]);
+        tb_small_allocator_free_list(allocator->small_allocator, g_default_allocator_cache_space[index], list, g_default_allocator_cache_batch[index]);
+        return ;
+    }
+
+    // push this batch to the remote free list
+    tb_long_t head = 0;
+    do
+    {
+        head = tb_atomic_get(&allocator->remote[index]);
+        ((tb_pointer_t*)list)[1] = (tb_pointer_t)head;
+
+    } while (tb_atomic_fetch_and_pset(&allocator->remote[index], head, (tb_long_t)list) != head);
+}
+static tb_size_t tb_default_allocator_cache_pop(tb_default_allocator_ref_t allocator, tb_size_t index, tb_pointer_t* plist)
+{
+    /* take all batches of the remote free list
+     *
+     * we need not pop them one by one, so it will not be the ABA problem
+     */
+    tb_pointer_t list = (tb_pointer_t)tb_atomic_fetch_and_set0(&allocator->remote[index]);
+    tb_check_return_val(list, 0);
+
+    // link all batches to one list
+    tb_size_t       i = 0;
+    tb_size_t       n = 0;
+    tb_size_t       batch = g_default_allocator_cache_batch[index];
+    tb_pointer_t    item = list;
+    while (item)
+    {
+        // the next batch
+        tb_pointer_t next = ((tb_pointer_t*)item)[1];
+
+        // link the last item of this batch to the next batch
+        for (i = 1; i < batch; i++) item = *((tb_pointer_t*)item);
+        *((tb_pointer_t*)item) = next;
+        item = next;
+        n++;
+    }
+
+    // update the batches count
+    tb_atomic_fetch_and_sub(&allocator->remote_count[index], n);
+
+    // ok
+    *plist = list;
+    return n * batch;
+}
+static tb_pointer_t tb_default_allocator_cache_malloc(tb_default_allocator_cache_t* cache, tb_size_t size __tb_debug_decl__)
+{
+    // the size class
+    tb_size_t index = g_default_allocator_cache_index[(size + 15) >> 4];
+
+    // no cached items? refill them from the remote free list or a batch of items from the small allocator
+    tb_pointer_t data = cache->items[index];
+    if (!data)
+    {
+        tb_size_t count = tb_default_allocator_cache_pop(cache->allocator, index, &cache->items[index]);
+        if (!count) 
+        {
+            count = tb_small_allocator_malloc_list(cache->allocator->small_allocator, g_default_allocator_cache_space[index], g_default_allocator_cache_batch[index], &cache->items[index]);
+            if (count) tb_atomic_fetch_and_add(&cache->allocator->cache_refill_count[index], (tb_long_t)count);
+        }
+        tb_check_return_val(count, tb_null);
+
+        // merge the stat of this size class
+        tb_default_allocator_cache_merge(cache, index);
+
+        // update count
+        cache->count[index] = (tb_uint16_t)count;
+        cache->total += count;
+        data = cache->items[index];
+    }
+
+    // pop it
+    cache->items[index] = *((tb_pointer_t*)data);
+    cache->count[index]--;
+    cache->total--;
+
+    // update the stat, we merge it periodically if the cache is not refilled or flushed for a long time
+    cache->malloc_count[index]++;
+    if (!++cache->merge_ops) tb_default_allocator_cache_merge_all(cache);
+
+    // update size
+    tb_pool_data_head_t* data_head = &(((tb_pool_data_head_t*)data)[-1]);
+    data_head->size = size;
+
+#ifdef __tb_debug__
+    // check
+    tb_assertf(data_head->debug.magic == TB_POOL_DATA_MAGIC, "invalid cached data: %p", data);
+
+    // update the debug info of the cached data
+    data_head->debug.file      = file_;
+    data_head->debug.func      = func_;
+    data_head->debug.line      = (tb_uint16_t)line_;
+
+    // save backtrace
+    tb_pool_data_save_backtrace(&data_head->debug, 3);
+
+    // make the dirty data and patch 0xcc for checking underflow
+    tb_memset_(data, TB_POOL_DATA_PATCH, g_default_allocator_cache_space[index]);
+#endif
+
+    // ok
+    return data;
+}
+static tb_void_t tb_default_allocator_cache_free(tb_default_allocator_cache_t* cache, tb_pointer_t data, tb_size_t size)
+{
+    // the size class
+    tb_size_t index = g_default_allocator_cache_index[(size + 15) >> 4];
+
+#ifdef __tb_debug__
+    // check underflow
+    tb_pool_data_head_t* data_head = &(((tb_pool_data_head_t*)data)[-1]);
+    tb_size_t            space = g_default_allocator_cache_space[index];
+    tb_assertf(space == data_head->size || ((tb_byte_t*)data)[data_head->size] == TB_POOL_DATA_PATCH, "data underflow");
+
+    // check double free in the thread cache
+    tb_pointer_t item = cache->items[index];
+    while (item && item != data) item = *((tb_pointer_t*)item);
+    tb_assertf(!item, "double free data: %p", data);
+
+    // the links of cached items will overwrite the patch bytes, so we mark it as a full item
+    data_head->size = space;
+#endif
+
+    // push it
+    *((tb_pointer_t*)data) = cache->items[index];
+    cache->items[index] = data;
+    cache->count[index]++;
+    cache->total++;
+
+    // update the stat
+    cache->free_count[index]++;
+    if (!++cache->merge_ops) tb_default_allocator_cache_merge_all(cache);
+
+    // too many cached items? flush a batch of items to the remote free list
+    tb_size_t batch = g_default_allocator_cache_batch[index];
+    if (cache->count[index] > (batch << 1))
+    {
+        // split the flushed items
+        tb_size_t       i = 1;
+        tb_pointer_t    list = cache->items[index];
+        tb_pointer_t    last = list;
+        for (i = 1; i < batch; i++) last = *((tb_pointer_t*)last);
+        cache->items[index] = *((tb_pointer_t*)last);
+        cache->count[index] -= (tb_uint16_t)batch;
+        cache->total -= batch;
+
+        // flush them
+        *((tb_pointer_t*)last) = tb_null;
+        tb_default_allocator_cache_push(cache->allocator, index, list);
+
+        // merge the stat of this size class
+        tb_default_allocator_cache_merge(cache, index);
+    }
+}
+static tb_void_t tb_default_allocator_cache_flush(tb_default_allocator_cache_t* cache)
+{
+    // merge the stat
+    tb_default_allocator_cache_merge_all(cache);
+
+    // flush all cached items to the small allocator
+    tb_size_t i = 0;
+    for (i = 0; i < TB_DEFAULT_ALLOCATOR_CACHE_CLASS_MAXN && cache->total; i++)
+    {
+        if (cache->items[i])
+        {
+            tb_atomic_fetch_and_add(&cache->allocator->cache_flush_count[i], cache->count[i]);
+            tb_small_allocator_free_list(cache->allocator->small_allocator, g_default_allocator_cache_space[i], cache->items[i], cache->count[i]);
+            cache->total -= cache->count[i];
+            cache->items[i] = tb_null;
+            cache->count[i] = 0;
+        }
+    }
+}
+#ifdef __tb_debug__
+static tb_void_t tb_default_allocator_cache_clear(tb_default_allocator_ref_t allocator)
+{
+    // flush the thread cache of the current thread
+    if (g_default_allocator_cache.id == allocator->id) tb_default_allocator_cache_flush(&g_default_allocator_cache);
+
+    // return all batches of the remote free lists to the small allocator
+    tb_size_t i = 0;
+    for (i = 0; i < TB_DEFAULT_ALLOCATOR_CACHE_CLASS_MAXN; i++)
+    {
+        tb_pointer_t    list = tb_null;
+        tb_size_t       count = tb_default_allocator_cache_pop(allocator, i, &list);
+        if (count)
+        {
+            tb_atomic_fetch_and_add(&allocator->cache_flush_count[i], (tb_long_t)count);
+            tb_small_allocator_free_list(allocator->small_allocator, g_default_allocator_cache_space[i], list, count);
+        }
+    }
+}
+#endif
+static tb_void_t tb_default_allocator_cache_exit_thread()
+{
+    /* flush the thread cache of the current thread
+     *
+     * the allocator may have been exited on other thread, so we need flush it in the lock of the live allocators
+     */
+    tb_default_allocator_cache_t* cache = &g_default_allocator_cache;
+    if (cache->allocator) 
+    {
+        tb_spinlock_enter(&g_default_allocator_cache_lock);
+        if (tb_default_allocator_cache_live(cache->allocator, cache->id)) tb_default_allocator_cache_flush(cache);
+        tb_spinlock_leave(&g_default_allocator_cache_lock);
+    }
+
+    // clear it
+    tb_memset_(cache, 0, sizeof(tb_default_allocator_cache_t));
+}
+#endif
 static tb_void_t tb_default_allocator_exit(tb_allocator_ref_t self)
 {
     // check
     tb_default_allocator_ref_t allocator = (tb_default_allocator_ref_t)self;
     tb_assert_and_check_return(allocator);
 
+#ifdef TB_DEFAULT_ALLOCATOR_CACHE_ENABLE
+    /* drop the thread cache of the current thread
+     *
+     * the cached items will be freed with the fixed pools of small allocator
+     */
+    if (g_default_allocator_cache.id == allocator->id) tb_memset_(&g_default_allocator_cache, 0, sizeof(tb_default_allocator_cache_t));
+
+    // remove it from the live allocators, the thread caches of other threads will not be flushed to it
+    tb_spinlock_enter(&g_default_allocator_cache_lock);
+    tb_default_allocator_ref_t* plive = &g_default_allocator_cache_list;
+    while (*plive && *plive != allocator) plive = &(*plive)->next;
+    if (*plive) *plive = allocator->next;
+    tb_spinlock_leave(&g_default_allocator_cache_lock);
+#endif
+
     // enter
     tb_spinlock_enter(&allocator->base.lock);
 
@@ -91,6 +572,13 @@ static tb_pointer_t tb_default_allocator_malloc(tb_allocator_ref_t self, tb_size
     // check
     tb_assert_and_check_return_val(allocator->large_allocator && allocator->small_allocator && size, tb_null);
 
+#ifdef TB_DEFAULT_ALLOCATOR_CACHE_ENABLE
+    // malloc the small data from the thread cache
+    tb_default_allocator_cache_t* cache = tb_null;
+    if (size <= TB_SMALL_ALLOCATOR_DATA_MAXN && (cache = tb_default_allocator_cache(allocator)))
+        return tb_default_allocator_cache_malloc(cache, size __tb_debug_args__);
+#endif
+
     // done
     return size <= TB_SMALL_ALLOCATOR_DATA_MAXN? tb_allocator_malloc_(allocator->small_allocator, size __tb_debug_args__) : tb_allocator_large_malloc_(allocator->large_allocator, size, tb_null __tb_debug_args__);
 }
@@ -111,7 +599,7 @@ static tb_pointer_t tb_default_allocator_ralloc(tb_allocator_ref_t self, tb_poin
         if (!data)
         {
             // malloc it directly
-            data_new = size <= TB_SMALL_ALLOCATOR_DATA_MAXN? tb_allocator_malloc_(allocator->small_allocator, size __tb_debug_args__) : tb_allocator_large_malloc_(allocator->large_allocator, size, tb_null __tb_debug_args__);
+            data_new = tb_default_allocator_malloc(self, size __tb_debug_args__);
             break;
         }
 
@@ -120,6 +608,40 @@ static tb_pointer_t tb_default_allocator_ralloc(tb_allocator_ref_t self, tb_poin
         tb_assertf(data_head->debug.magic == TB_POOL_DATA_MAGIC, "ralloc invalid data: %p", data);
         tb_assert_and_check_break(data_head->size);
 
+#ifdef TB_DEFAULT_ALLOCATOR_CACHE_ENABLE
+        // small => small with the thread cache
+        tb_default_allocator_cache_t* cache = tb_null;
+        if (data_head->size <= TB_SMALL_ALLOCATOR_DATA_MAXN && size <= TB_SMALL_ALLOCATOR_DATA_MAXN && (cache = tb_default_allocator_cache(allocator)))
+        {
+            // the same size class? update size only
+            if (g_default_allocator_cache_index[(data_head->size + 15) >> 4] == g_default_allocator_cache_index[(size + 15) >> 4])
+            {
+#ifdef __tb_debug__
+                // check underflow
+                tb_size_t space = g_default_allocator_cache_space[g_default_allocator_cache_index[(size + 15) >> 4]];
+                tb_assertf(space == data_head->size || ((tb_byte_t*)data)[data_head->size] == TB_POOL_DATA_PATCH, "data underflow");
+
+                // fill the patch bytes
+                if (data_head->size > size) tb_memset_((tb_byte_t*)data + size, TB_POOL_DATA_PATCH, data_head->size - size);
+#endif
+                data_head->size = size;
+                data_new = data;
+                break;
+            }
+
+            // make the new data
+            data_new = tb_default_allocator_cache_malloc(cache, size __tb_debug_args__);
+            tb_assert_and_check_break(data_new);
+
+            // copy the old data
+            tb_memcpy_(data_new, data, tb_min(data_head->size, size));
+
+            // free the old data
+            tb_default_allocator_cache_free(cache, data, data_head->size);
+            break;
+        }
+#endif
+
         // small => small
         if (data_head->size <= TB_SMALL_ALLOCATOR_DATA_MAXN && size <= TB_SMALL_ALLOCATOR_DATA_MAXN)
             data_new = tb_allocator_ralloc_(allocator->small_allocator, data, size __tb_debug_args__);
@@ -174,6 +696,17 @@ static tb_bool_t tb_default_allocator_free(tb_allocator_ref_t self, tb_pointer_t
         tb_pool_data_head_t* data_head = &(((tb_pool_data_head_t*)data)[-1]);
         tb_assertf(data_head->debug.magic == TB_POOL_DATA_MAGIC, "free invalid data: %p", data);
 
+#ifdef TB_DEFAULT_ALLOCATOR_CACHE_ENABLE
+        // free the small data to the thread cache
+        tb_default_allocator_cache_t* cache = tb_null;
+        if (data_head->size <= TB_SMALL_ALLOCATOR_DATA_MAXN && (cache = tb_default_allocator_cache(allocator)))
+        {
+            tb_default_allocator_cache_free(cache, data, data_head->size);
+            ok = tb_true;
+            break;
+        }
+#endif
+
         // free it
         ok = (data_head->size <= TB_SMALL_ALLOCATOR_DATA_MAXN)? tb_allocator_free_(allocator->small_allocator, data __tb_debug_args__) : tb_allocator_large_free_(allocator->large_allocator, data __tb_debug_args__);
 
@@ -182,6 +715,67 @@ static tb_bool_t tb_default_allocator_free(tb_allocator_ref_t self, tb_pointer_t
     // ok?
     return ok;
 }
+static tb_bool_t tb_default_allocator_stat(tb_allocator_ref_t self, tb_allocator_stat_ref_t stat)
+{
+    // check
+    tb_default_allocator_ref_t allocator = (tb_default_allocator_ref_t)self;
+    tb_assert_and_check_return_val(allocator && allocator->small_allocator && allocator->large_allocator && stat, tb_false);
+
+    // append the small classes and the large class
+    tb_allocator_stat_t stat_sub;
+    tb_allocator_ref_t  allocators[] = {allocator->small_allocator, allocator->large_allocator};
+    tb_size_t           i = 0;
+    for (i = 0; i < tb_arrayn(allocators); i++)
+    {
+        if (tb_allocator_stat(allocators[i], &stat_sub))
+        {
+            tb_size_t n = tb_min(stat_sub.class_count, tb_arrayn(stat->classes) - stat->class_count);
+            tb_memcpy_(stat->classes + stat->class_count, stat_sub.classes, n * sizeof(tb_allocator_class_stat_t));
+            stat->class_count += n;
+        }
+    }
+
+#ifdef TB_DEFAULT_ALLOCATOR_CACHE_ENABLE
+    // merge the stat of the current thread cache first
+    if (g_default_allocator_cache.id == allocator->id) tb_default_allocator_cache_merge_all(&g_default_allocator_cache);
+
+    /* count the user calls of the thread caches instead of the batches of the small allocator
+     *
+     * malloc: the small allocator malloc - refilled items + the thread caches malloc
+     * free:   the small allocator free - flushed items + the thread caches free
+     *
+     * so the cached items in the thread caches and the remote free lists are not live,
+     * but the stat of other threads may be delayed until they refill, flush or do 65536 operations.
+     */
+    tb_size_t k = 0;
+    for (i = 0; i < stat->class_count; i++)
+    {
+        // find the size class of this thread cache
+        tb_allocator_class_stat_ref_t cstat = &stat->classes[i];
+        for (k = 0; k < TB_DEFAULT_ALLOCATOR_CACHE_CLASS_MAXN; k++)
+        {
+            if (g_default_allocator_cache_space[k] == cstat->item_size) break;
+        }
+        tb_check_continue(cstat->item_size && k < TB_DEFAULT_ALLOCATOR_CACHE_CLASS_MAXN);
+
+        // update the malloc and free count
+        cstat->malloc_count = cstat->malloc_count - (tb_size_t)tb_atomic_get(&allocator->cache_refill_count[k]) + (tb_size_t)tb_atomic_get(&allocator->cache_malloc_count[k]);
+        cstat->free_count   = cstat->free_count - (tb_size_t)tb_atomic_get(&allocator->cache_flush_count[k]) + (tb_size_t)tb_atomic_get(&allocator->cache_free_count[k]);
+
+        // update the live count, the unmerged stat may be negative
+        tb_long_t live = (tb_long_t)(cstat->malloc_count - cstat->free_count);
+        cstat->live_count   = live > 0? (tb_size_t)live : 0;
+        cstat->live_size    = cstat->live_count * cstat->item_size;
+
+        // update the peak size, the peak of the small allocator contains the cached items
+        tb_size_t peak = (tb_size_t)tb_atomic_get(&allocator->cache_peak_count[k]);
+        cstat->peak_size    = tb_max(peak, cstat->live_count) * cstat->item_size;
+    }
+#endif
+
+    // ok?
+    return stat->class_count != 0;
+}
 #ifdef __tb_debug__
 static tb_void_t tb_default_allocator_dump(tb_allocator_ref_t self)
 {
@@ -189,6 +783,14 @@ static tb_void_t tb_default_allocator_dump(tb_allocator_ref_t self)
     tb_default_allocator_ref_t allocator = (tb_default_allocator_ref_t)self;
     tb_assert_and_check_return(allocator && allocator->small_allocator);
 
+#ifdef TB_DEFAULT_ALLOCATOR_CACHE_ENABLE
+    /* return the cached items to the small allocator first, they are not leaks
+     *
+     * but the items cached by other running threads will still be dumped.
+     */
+    tb_default_allocator_cache_clear(allocator);
+#endif
+
     // dump allocator
     tb_allocator_dump(allocator->small_allocator);
 }
@@ -321,10 +923,12 @@ tb_allocator_ref_t tb_default_allocator_init(tb_allocator_ref_t large_allocator)
 
         // init base
         allocator->base.type            = TB_ALLOCATOR_DEFAULT;
+        allocator->base.flag            = TB_ALLOCATOR_FLAG_NOLOCK;
         allocator->base.malloc          = tb_default_allocator_malloc;
         allocator->base.ralloc          = tb_default_allocator_ralloc;
         allocator->base.free            = tb_default_allocator_free;
         allocator->base.exit            = tb_default_allocator_exit;
+        allocator->base.stat            = tb_default_allocator_stat;
 #ifdef __tb_debug__
         allocator->base.dump            = tb_default_allocator_dump;
         allocator->base.have            = tb_default_allocator_have;
@@ -338,6 +942,18 @@ tb_allocator_ref_t tb_default_allocator_init(tb_allocator_ref_t large_allocator)
         allocator->small_allocator = tb_small_allocator_init(large_allocator);
         tb_assert_and_check_break(allocator->small_allocator);
 
+#ifdef TB_DEFAULT_ALLOCATOR_CACHE_ENABLE
+        // init the thread cache
+        tb_default_allocator_cache_init();
+        allocator->id = (tb_size_t)tb_atomic_inc_and_fetch(&g_default_allocator_cache_id);
+
+        // add it to the live allocators
+        tb_spinlock_enter(&g_default_allocator_cache_lock);
+        allocator->next = g_default_allocator_cache_list;
+        g_default_allocator_cache_list = allocator;
+        tb_spinlock_leave(&g_default_allocator_cache_lock);
+#endif
+
         // register lock profiler
 #ifdef TB_LOCK_PROFILER_ENABLE
         tb_lock_profiler_register(tb_lock_profiler(), (tb_pointer_t)&allocator->base.lock, TB_TRACE_MODULE_NAME);
@@ -358,4 +974,3 @@ tb_allocator_ref_t tb_default_allocator_init(tb_allocator_ref_t large_allocator)
     // ok?
     return (tb_allocator_ref_t)allocator;
 }
-
@@ -106,12 +106,22 @@ typedef struct __tb_fixed_pool_impl_t
     // for small allocator
     tb_bool_t                       for_small;
 
+    // the peak item count
+    tb_size_t                       peak_count;
+
+    // the malloc count
+    tb_size_t                       malloc_count;
+
+    // the free count
+    tb_size_t                       free_count;
+
 }tb_fixed_pool_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * declaration
  */
 __tb_extern_c__ tb_fixed_pool_ref_t tb_fixed_pool_init_(tb_allocator_ref_t large_allocator, tb_size_t slot_size, tb_size_t item_size, tb_bool_t for_small, tb_fixed_pool_item_init_func_t item_init, tb_fixed_pool_item_exit_func_t item_exit, tb_cpointer_t priv);
+__tb_extern_c__ tb_void_t           tb_fixed_pool_stat_(tb_fixed_pool_ref_t pool, tb_allocator_class_stat_ref_t stat);
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
@@ -556,6 +566,12 @@ tb_pointer_t tb_fixed_pool_malloc_(tb_fixed_pool_ref_t self __tb_debug_decl__)
         // update the item count
         pool->item_count++;
 
+        // update the peak count
+        if (pool->item_count > pool->peak_count) pool->peak_count = pool->item_count;
+
+        // update the malloc count
+        pool->malloc_count++;
+
         // ok
         ok = tb_true;
 
@@ -638,6 +654,9 @@ tb_bool_t tb_fixed_pool_free_(tb_fixed_pool_ref_t self, tb_pointer_t data __tb_d
 
         // update the item count
         pool->item_count--;
+
+        // update the free count
+        pool->free_count++;
  
         // ok
         ok = tb_true;
@@ -692,6 +711,35 @@ tb_void_t tb_fixed_pool_walk(tb_fixed_pool_ref_t self, tb_fixed_pool_item_walk_f
         tb_static_fixed_pool_walk(full_slot->pool, func, priv);
     }
 }
+tb_void_t tb_fixed_pool_stat_(tb_fixed_pool_ref_t self, tb_allocator_class_stat_ref_t stat)
+{
+    // check
+    tb_fixed_pool_t* pool = (tb_fixed_pool_t*)self;
+    tb_assert_and_check_return(pool && stat);
+
+    // the items stat
+    stat->item_size     = pool->item_size;
+    stat->live_count    = pool->item_count;
+    stat->live_size     = pool->item_count * pool->item_size;
+    stat->peak_size     = pool->peak_count * pool->item_size;
+    stat->malloc_count  = pool->malloc_count;
+    stat->free_count    = pool->free_count;
+
+    // the slots stat, the slot list contains the current, partial and full slots
+    stat->slot_count    = pool->slot_count;
+    stat->slot_items    = 0;
+    stat->slot_size     = 0;
+    tb_size_t i = 0;
+    for (i = 0; i < pool->slot_count; i++)
+    {
+        tb_fixed_pool_slot_t* slot = pool->slot_list[i];
+        if (slot && slot->pool)
+        {
+            stat->slot_items += tb_static_fixed_pool_maxn(slot->pool);
+            stat->slot_size  += slot->size;
+        }
+    }
+}
 #ifdef __tb_debug__
 tb_void_t tb_fixed_pool_dump(tb_fixed_pool_ref_t self)
 { 
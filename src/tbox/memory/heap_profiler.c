@@ -0,0 +1,424 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        heap_profiler.c
+ * @ingroup     memory
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "heap_profiler"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "heap_profiler.h"
+#include "../libc/libc.h"
+#include "../platform/file.h"
+#include "../platform/memory.h"
+#include "../platform/spinlock.h"
+#include "../platform/backtrace.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the max frames count of the sampled call-stack
+#define TB_HEAP_PROFILER_FRAME_MAXN         (32)
+
+// the skipped frames count: tb_backtrace_frames() and tb_heap_profiler_leave()
+#define TB_HEAP_PROFILER_FRAME_SKIP         (2)
+
+// the max samples count, must be power of 2
+#define TB_HEAP_PROFILER_SAMPLE_MAXN        (4096)
+
+// the max probe count for finding the sample
+#define TB_HEAP_PROFILER_PROBE_MAXN         (16)
+
+// the line maxn of the folded stacks file
+#define TB_HEAP_PROFILER_LINE_MAXN          (8192)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the heap profiler sample type
+typedef struct __tb_heap_profiler_sample_t
+{
+    // the hash of the call-stack, this sample is unused if be zero
+    tb_size_t                   hash;
+
+    // the sampled count
+    tb_size_t                   count;
+
+    // the estimated allocated bytes
+    tb_hize_t                   size;
+
+    // the frames count
+    tb_size_t                   frame_count;
+
+    // the frames, the leaf frame is the first one
+    tb_pointer_t                frames[TB_HEAP_PROFILER_FRAME_MAXN];
+
+}tb_heap_profiler_sample_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the sampling rate, it is stopped if be zero
+__tb_extern_c__ tb_size_t               g_heap_profiler_rate = 0;
+
+// the lock of samples
+static tb_spinlock_t                    g_heap_profiler_lock = TB_SPINLOCK_INIT;
+
+// the samples
+static tb_heap_profiler_sample_t*       g_heap_profiler_samples = tb_null;
+
+// the dropped bytes if there are too many call-stacks
+static tb_hize_t                        g_heap_profiler_dropped = 0;
+
+#ifdef __tb_thread_local__
+// the nested depth of the allocations in the current thread
+static __tb_thread_local__ tb_size_t    g_heap_profiler_depth = 0;
+
+// the bytes left until the next sample in the current thread
+static __tb_thread_local__ tb_long_t    g_heap_profiler_left = 0;
+
+// the random seed of the sampling interval in the current thread
+static __tb_thread_local__ tb_uint32_t  g_heap_profiler_seed = 0;
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * declaration
+ */
+__tb_extern_c__ tb_size_t               tb_heap_profiler_enter(tb_noarg_t);
+__tb_extern_c__ tb_void_t               tb_heap_profiler_leave(tb_size_t state, tb_size_t size);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+#ifdef __tb_thread_local__
+static tb_long_t tb_heap_profiler_interval(tb_size_t rate)
+{
+    // init seed
+    tb_uint32_t seed = g_heap_profiler_seed;
+    if (!seed) seed = (tb_uint32_t)(tb_size_t)&g_heap_profiler_seed | 1;
+
+    // xorshift32
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    g_heap_profiler_seed = seed;
+
+    /* randomize the interval in [rate / 2, rate * 3 / 2) to avoid sampling the periodic allocations with the same call-stack
+     *
+     * the average interval is still the given rate
+     */
+    return (tb_long_t)((rate >> 1) + (seed % rate));
+}
+static tb_void_t tb_heap_profiler_save(tb_pointer_t* frames, tb_size_t frame_count, tb_hize_t size)
+{
+    // compute the hash of the call-stack
+    tb_size_t hash = 2166136261u;
+    tb_size_t i = 0;
+    for (i = 0; i < frame_count; i++) hash = (hash ^ (tb_size_t)frames[i]) * 16777619u;
+    hash |= 1;
+
+    // enter
+    tb_spinlock_enter(&g_heap_profiler_lock);
+
+    // find the sample of this call-stack
+    tb_heap_profiler_sample_t* sample = tb_null;
+    if (g_heap_profiler_samples)
+    {
+        for (i = 0; i < TB_HEAP_PROFILER_PROBE_MAXN; i++)
+        {
+            tb_heap_profiler_sample_t* item = &g_heap_profiler_samples[(hash + i) & (TB_HEAP_PROFILER_SAMPLE_MAXN - 1)];
+
+            // the new sample?
+            if (!item->hash)
+            {
+                item->hash          = hash;
+                item->frame_count   = frame_count;
+                tb_memcpy_(item->frames, frames, frame_count * sizeof(tb_pointer_t));
+                sample = item;
+                break;
+            }
+
+            // this sample?
+            if (item->hash == hash && item->frame_count == frame_count && !tb_memcmp_(item->frames, frames, frame_count * sizeof(tb_pointer_t)))
+            {
+                sample = item;
+                break;
+            }
+        }
+
+        // save it
+        if (sample)
+        {
+            sample->count++;
+            sample->size += size;
+        }
+        // too many call-stacks? drop it
+        else g_heap_profiler_dropped += size;
+    }
+
+    // leave
+    tb_spinlock_leave(&g_heap_profiler_lock);
+}
+static tb_size_t tb_heap_profiler_frame_name(tb_char_t const* symbol, tb_pointer_t frame, tb_char_t* data, tb_size_t maxn)
+{
+    /* get the function name from the symbol
+     *
+     * e.g. 
+     * module(func+0x1a) [0x7f0000001000] => func
+     * module(+0x1a) [0x7f0000001000] => module+0x1a
+     */
+    tb_long_t           size = 0;
+    tb_char_t const*    p = symbol? tb_strchr(symbol, '(') : tb_null;
+    tb_char_t const*    e = p? tb_strchr(p, ')') : tb_null;
+    if (p && e && p[1] != '+' && p[1] != ')')
+    {
+        // only the function name
+        tb_char_t const* f = p + 1;
+        tb_char_t const* q = f;
+        while (q < e && *q != '+') q++;
+        size = tb_snprintf(data, maxn, "%.*s", (tb_int_t)(q - f), f);
+    }
+    else if (p && e && p > symbol)
+    {
+        // the module name and offset
+        tb_char_t const* m = p;
+        while (m > symbol && m[-1] != '/' && m[-1] != '\\') m--;
+        size = tb_snprintf(data, maxn, "%.*s%.*s", (tb_int_t)(p - m), m, (tb_int_t)(e - p - 1), p + 1);
+    }
+    else size = tb_snprintf(data, maxn, "%p", frame);
+    tb_check_return_val(size > 0, 0);
+    if ((tb_size_t)size >= maxn) size = maxn - 1;
+
+    // replace the separators of the folded stacks
+    tb_long_t i = 0;
+    for (i = 0; i < size; i++)
+    {
+        if (data[i] == ';' || data[i] == ' ') data[i] = '_';
+    }
+    return (tb_size_t)size;
+}
+static tb_bool_t tb_heap_profiler_writ(tb_file_ref_t file, tb_char_t const* data, tb_size_t size)
+{
+    // writ all data
+    tb_size_t writ = 0;
+    while (writ < size)
+    {
+        tb_long_t real = tb_file_writ(file, (tb_byte_t const*)data + writ, size - writ);
+        tb_check_break(real > 0);
+        writ += real;
+    }
+    return writ == size;
+}
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_size_t tb_heap_profiler_enter()
+{
+#ifdef __tb_thread_local__
+    // the outermost allocation?
+    return g_heap_profiler_depth++? 2 : 1;
+#else
+    return 0;
+#endif
+}
+tb_void_t tb_heap_profiler_leave(tb_size_t state, tb_size_t size)
+{
+#ifdef __tb_thread_local__
+    // leave it
+    g_heap_profiler_depth--;
+
+    // only sample the outermost allocation
+    tb_check_return(state == 1 && size);
+
+    // stopped?
+    tb_size_t rate = g_heap_profiler_rate;
+    tb_check_return(rate);
+
+    // not sample it?
+    g_heap_profiler_left -= (tb_long_t)size;
+    tb_check_return(g_heap_profiler_left <= 0);
+
+    // update the next sampling interval
+    g_heap_profiler_left = tb_heap_profiler_interval(rate);
+
+    // get the call-stack, the allocations in it will not be sampled
+    g_heap_profiler_depth++;
+    tb_pointer_t frames[TB_HEAP_PROFILER_FRAME_MAXN];
+    tb_size_t    frame_count = tb_backtrace_frames(frames, TB_HEAP_PROFILER_FRAME_MAXN, TB_HEAP_PROFILER_FRAME_SKIP);
+    g_heap_profiler_depth--;
+
+    // save it, this sample presents the allocated bytes of the whole interval
+    tb_heap_profiler_save(frames, frame_count, tb_max(size, rate));
+#endif
+}
+tb_bool_t tb_heap_profiler_start(tb_size_t rate)
+{
+#ifdef __tb_thread_local__
+    // init samples
+    tb_bool_t ok = tb_false;
+    tb_spinlock_enter(&g_heap_profiler_lock);
+    if (!g_heap_profiler_samples) 
+        g_heap_profiler_samples = (tb_heap_profiler_sample_t*)tb_native_memory_malloc0(TB_HEAP_PROFILER_SAMPLE_MAXN * sizeof(tb_heap_profiler_sample_t));
+    ok = g_heap_profiler_samples != tb_null;
+    tb_spinlock_leave(&g_heap_profiler_lock);
+    tb_assert_and_check_return_val(ok, tb_false);
+
+    // start it
+    g_heap_profiler_rate = rate? rate : TB_HEAP_PROFILER_RATE_DEFAULT;
+
+    // trace
+    tb_trace_d("start: rate: %lu", g_heap_profiler_rate);
+    return tb_true;
+#else
+    // trace
+    tb_trace_noimpl();
+    return tb_false;
+#endif
+}
+tb_void_t tb_heap_profiler_stop()
+{
+    // stop it
+    g_heap_profiler_rate = 0;
+
+    // exit samples
+    tb_spinlock_enter(&g_heap_profiler_lock);
+    tb_heap_profiler_sample_t* samples = g_heap_profiler_samples;
+    g_heap_profiler_samples = tb_null;
+    g_heap_profiler_dropped = 0;
+    tb_spinlock_leave(&g_heap_profiler_lock);
+    if (samples) tb_native_memory_free(samples);
+
+    // trace
+    tb_trace_d("stop");
+}
+tb_bool_t tb_heap_profiler_dump(tb_char_t const* path)
+{
+    // check
+    tb_assert_and_check_return_val(path, tb_false);
+
+#ifdef __tb_thread_local__
+    // the allocations in dump will not be sampled
+    g_heap_profiler_depth++;
+
+    // done
+    tb_bool_t                   ok = tb_false;
+    tb_file_ref_t               file = tb_null;
+    tb_char_t*                  line = tb_null;
+    tb_heap_profiler_sample_t*  samples = tb_null;
+    do
+    {
+        // make the samples and line buffer
+        samples = (tb_heap_profiler_sample_t*)tb_native_memory_malloc(TB_HEAP_PROFILER_SAMPLE_MAXN * sizeof(tb_heap_profiler_sample_t));
+        line = (tb_char_t*)tb_native_memory_malloc(TB_HEAP_PROFILER_LINE_MAXN);
+        tb_assert_and_check_break(samples && line);
+
+        // copy the used samples
+        tb_size_t   i = 0;
+        tb_size_t   count = 0;
+        tb_hize_t   dropped = 0;
+        tb_spinlock_enter(&g_heap_profiler_lock);
+        if (g_heap_profiler_samples)
+        {
+            for (i = 0; i < TB_HEAP_PROFILER_SAMPLE_MAXN; i++)
+            {
+                if (g_heap_profiler_samples[i].hash) samples[count++] = g_heap_profiler_samples[i];
+            }
+        }
+        dropped = g_heap_profiler_dropped;
+        tb_spinlock_leave(&g_heap_profiler_lock);
+
+        // init file
+        file = tb_file_init(path, TB_FILE_MODE_RW | TB_FILE_MODE_CREAT | TB_FILE_MODE_TRUNC | TB_FILE_MODE_BINARY);
+        tb_assert_and_check_break(file);
+
+        // writ all call-stacks
+        for (i = 0; i < count; i++)
+        {
+            // the sample
+            tb_heap_profiler_sample_t* sample = &samples[i];
+
+            // make line: root;...;leaf bytes
+            tb_size_t   size = 0;
+            tb_size_t   maxn = TB_HEAP_PROFILER_LINE_MAXN - 64;
+            tb_handle_t symbols = tb_backtrace_symbols_init(sample->frames, sample->frame_count);
+            tb_size_t   j = sample->frame_count;
+            while (j-- && size + 1 < maxn)
+            {
+                if (size) line[size++] = ';';
+                tb_char_t const* symbol = symbols? tb_backtrace_symbols_name(symbols, sample->frames, sample->frame_count, j) : tb_null;
+                size += tb_heap_profiler_frame_name(symbol, sample->frames[j], line + size, maxn - size);
+            }
+            if (symbols) tb_backtrace_symbols_exit(symbols);
+            if (!size) size = tb_snprintf(line, maxn, "[unknown]");
+            size += tb_snprintf(line + size, TB_HEAP_PROFILER_LINE_MAXN - size, " %llu\n", sample->size);
+
+            // writ it
+            if (!tb_heap_profiler_writ(file, line, size)) break;
+        }
+        tb_check_break(i == count);
+
+        // writ the dropped bytes
+        if (dropped)
+        {
+            tb_size_t size = tb_snprintf(line, TB_HEAP_PROFILER_LINE_MAXN, "[dropped] %llu\n", dropped);
+            if (!tb_heap_profiler_writ(file, line, size)) break;
+        }
+
+        // trace
+        tb_trace_d("dump: %lu call-stacks to %s", count, path);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // exit file
+    if (file) tb_file_exit(file);
+    file = tb_null;
+
+    // exit data
+    if (line) tb_native_memory_free(line);
+    if (samples) tb_native_memory_free(samples);
+
+    // leave
+    g_heap_profiler_depth--;
+
+    // ok?
+    return ok;
+#else
+    // trace
+    tb_trace_noimpl();
+    return tb_false;
+#endif
+}
@@ -0,0 +1,104 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        heap_profiler.h
+ * @ingroup     memory
+ *
+ */
+#ifndef TB_MEMORY_HEAP_PROFILER_H
+#define TB_MEMORY_HEAP_PROFILER_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// the default sampling rate of the heap profiler, sample one allocation per 512K bytes on average
+#define TB_HEAP_PROFILER_RATE_DEFAULT       (512 * 1024)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! start the heap profiler
+ *
+ * it samples the allocations of all allocators and it is also available in the release mode, 
+ * one allocation will be sampled per the given bytes on average, 
+ * and the call-stack of the sampled allocation will be captured by tb_backtrace_frames().
+ *
+ * each sample is weighted by max(size, rate) bytes, so the total bytes of each call-stack 
+ * is the estimated allocated bytes (not the live bytes) after the profiler has been started.
+ *
+ * @note only the outermost allocation of the nested allocators will be sampled,
+ * and it is not supported if the compiler has not the thread local storage.
+ *
+ * @code
+    
+    // start the heap profiler
+    tb_heap_profiler_start(0);
+
+    // ...
+
+    // dump the folded stacks, and make the flamegraph: flamegraph.pl heap.folded > heap.svg
+    tb_heap_profiler_dump("/tmp/heap.folded");
+
+    // stop the heap profiler
+    tb_heap_profiler_stop();
+
+ * @endcode
+ *
+ * @param rate          the average sampling bytes, uses TB_HEAP_PROFILER_RATE_DEFAULT if be zero
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_heap_profiler_start(tb_size_t rate);
+
+/*! stop the heap profiler and clear all samples
+ */
+tb_void_t               tb_heap_profiler_stop(tb_noarg_t);
+
+/*! dump the samples to the folded stacks file
+ *
+ * one call-stack per line: "root;...;leaf bytes", it can be used by flamegraph.pl directly.
+ *
+ * @note the frame is dumped as "module+offset" if the symbol is not exported, e.g. without -rdynamic
+ *
+ * @param path          the file path
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_heap_profiler_dump(tb_char_t const* path);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
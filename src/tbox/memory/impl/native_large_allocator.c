@@ -41,6 +41,9 @@
 // the native large allocator data size
 #define tb_native_large_allocator_data_base(data_head)   (&(((tb_pool_data_head_t*)((tb_native_large_data_head_t*)(data_head) + 1))[-1]))
 
+// the minimum data size for mapping and binding it to the numa node
+#define TB_NATIVE_LARGE_ALLOCATOR_BIND_MINN             (64 * 1024)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -54,6 +57,15 @@ typedef __tb_pool_data_aligned__ struct __tb_native_large_data_head_t
     // the entry
     tb_list_entry_t                 entry;
 
+    // the mapped size, the data is allocated from the native memory if be zero
+    tb_size_t                       mapped;
+
+    // the huge page mode of the mapped data
+    tb_uint32_t                     huge;
+
+    // is bound to the numa node?
+    tb_uint32_t                     bound;
+
     // the data head base
     tb_byte_t                       base[sizeof(tb_pool_data_head_t)];
 
@@ -77,19 +89,21 @@ typedef struct __tb_native_large_allocator_t
     // the data list
     tb_list_entry_head_t            data_list;
 
-#ifdef __tb_debug__
+    // the huge page size, does not map data on the huge pages if be zero
+    tb_size_t                       huge_page_size;
+
+    // the numa node index, does not bind it if be -1
+    tb_long_t                       node;
+
+    // the stat
+    tb_large_allocator_stat_t       stat;
+
     // the peak size
     tb_size_t                       peak_size;
 
     // the total size
     tb_size_t                       total_size;
 
-    // the real size
-    tb_size_t                       real_size;
-
-    // the occupied size
-    tb_size_t                       occupied_size;
-
     // the malloc count
     tb_size_t                       malloc_count;
 
@@ -98,13 +112,134 @@ typedef struct __tb_native_large_allocator_t
 
     // the free count
     tb_size_t                       free_count;
+
+#ifdef __tb_debug__
+    // the real size
+    tb_size_t                       real_size;
+
+    // the occupied size
+    tb_size_t                       occupied_size;
 #endif
 
 }tb_native_large_allocator_t, *tb_native_large_allocator_ref_t;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * declaration
+ */
+static tb_pointer_t tb_native_large_allocator_malloc(tb_allocator_ref_t self, tb_size_t size, tb_size_t* real __tb_debug_decl__);
+static tb_bool_t tb_native_large_allocator_free(tb_allocator_ref_t self, tb_pointer_t data __tb_debug_decl__);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
+static __tb_inline__ tb_size_t tb_native_large_allocator_mapped_size(tb_native_large_allocator_ref_t allocator, tb_size_t need)
+{
+    // map it on the huge pages?
+    if (allocator->huge_page_size && need >= (allocator->huge_page_size >> 1)) 
+        return tb_align(need, allocator->huge_page_size);
+
+    // map it for binding the numa node?
+    if (allocator->node >= 0 && need >= TB_NATIVE_LARGE_ALLOCATOR_BIND_MINN) 
+        return tb_align(need, tb_page_size());
+
+    // allocate it from the native memory
+    return 0;
+}
+static tb_native_large_data_head_t* tb_native_large_allocator_data_make(tb_native_large_allocator_ref_t allocator, tb_size_t need)
+{
+    // the mapped size
+    tb_size_t mapped = tb_native_large_allocator_mapped_size(allocator, need);
+
+    // allocate it from the native memory?
+    tb_native_large_data_head_t* data_head = tb_null;
+    if (!mapped)
+    {
+        // make data
+        data_head = (tb_native_large_data_head_t*)tb_native_memory_malloc(need);
+        tb_check_return_val(data_head, tb_null);
+
+        // init data
+        data_head->mapped   = 0;
+        data_head->huge     = TB_VIRTUAL_MEMORY_HUGE_NONE;
+        data_head->bound    = 0;
+
+        // update the total size
+        allocator->stat.total_size += need;
+        return data_head;
+    }
+
+    // map data, uses the huge pages if the mapped size is aligned by the huge page size
+    tb_size_t huge = TB_VIRTUAL_MEMORY_HUGE_NONE;
+    if (allocator->huge_page_size && !(mapped & (allocator->huge_page_size - 1)))
+        data_head = (tb_native_large_data_head_t*)tb_virtual_memory_malloc_huge(mapped, &huge);
+    else data_head = (tb_native_large_data_head_t*)tb_virtual_memory_malloc(mapped);
+    tb_check_return_val(data_head, tb_null);
+
+    // bind it to the numa node before accessing it
+    tb_bool_t bound = allocator->node >= 0 && tb_virtual_memory_bind(data_head, mapped, (tb_size_t)allocator->node);
+
+    // init data
+    data_head->mapped   = mapped;
+    data_head->huge     = (tb_uint32_t)huge;
+    data_head->bound    = (tb_uint32_t)bound;
+
+    // update the stat
+    allocator->stat.total_size  += mapped;
+    allocator->stat.mapped_size += mapped;
+    if (huge == TB_VIRTUAL_MEMORY_HUGE_EXPLICIT) allocator->stat.huge_size += mapped;
+    else if (huge == TB_VIRTUAL_MEMORY_HUGE_ADVISED) allocator->stat.huge_advised_size += mapped;
+    if (bound) allocator->stat.bound_size += mapped;
+
+    // ok
+    return data_head;
+}
+static tb_void_t tb_native_large_allocator_data_exit(tb_native_large_allocator_ref_t allocator, tb_native_large_data_head_t* data_head, tb_size_t need)
+{
+    // allocated from the native memory?
+    tb_size_t mapped = data_head->mapped;
+    if (!mapped)
+    {
+        // update the total size
+        allocator->stat.total_size -= need;
+
+        // free it
+        tb_native_memory_free(data_head);
+        return ;
+    }
+
+    // update the stat
+    allocator->stat.total_size  -= mapped;
+    allocator->stat.mapped_size -= mapped;
+    if (data_head->huge == TB_VIRTUAL_MEMORY_HUGE_EXPLICIT) allocator->stat.huge_size -= mapped;
+    else if (data_head->huge == TB_VIRTUAL_MEMORY_HUGE_ADVISED) allocator->stat.huge_advised_size -= mapped;
+    if (data_head->bound) allocator->stat.bound_size -= mapped;
+
+    // unmap it
+    tb_virtual_memory_free(data_head, mapped);
+}
+static tb_pointer_t tb_native_large_allocator_ralloc_mapped(tb_native_large_allocator_ref_t allocator, tb_pointer_t data, tb_size_t size, tb_size_t* real __tb_debug_decl__)
+{
+    // the previous size
+    tb_size_t prev_size = tb_native_large_allocator_data_base(&(((tb_native_large_data_head_t*)data)[-1]))->size;
+
+    // make a new data
+    tb_pointer_t data_new = tb_native_large_allocator_malloc(&allocator->base, size, real __tb_debug_args__);
+    tb_check_return_val(data_new, tb_null);
+
+    // copy data
+    tb_memcpy_(data_new, data, tb_min(prev_size, size));
+
+    // free the previous data
+    tb_native_large_allocator_free(&allocator->base, data __tb_debug_args__);
+
+    // update the malloc, free and ralloc count
+    allocator->malloc_count--;
+    allocator->free_count--;
+    allocator->ralloc_count++;
+
+    // ok
+    return data_new;
+}
 #ifdef __tb_debug__
 static tb_void_t tb_native_large_allocator_check_data(tb_native_large_allocator_ref_t allocator, tb_native_large_data_head_t const* data_head)
 {
@@ -221,16 +356,14 @@ static tb_pointer_t tb_native_large_allocator_malloc(tb_allocator_ref_t self, tb
 #endif
 
         // make data
-        data = (tb_byte_t*)tb_native_memory_malloc(need);
-        tb_assert_and_check_break(data);
-        tb_assert_and_check_break(!(((tb_size_t)data) & 0x1));
+        data_head = tb_native_large_allocator_data_make(allocator, need);
+        tb_assert_and_check_break(data_head);
+        tb_assert_and_check_break(!(((tb_size_t)data_head) & 0x1));
 
         // make the real data
+        data = (tb_byte_t*)data_head;
         data_real = data + sizeof(tb_native_large_data_head_t);
 
-        // init the data head
-        data_head = (tb_native_large_data_head_t*)data;
-
         // the base head
         tb_pool_data_head_t* base_head = tb_native_large_allocator_data_base(data_head);
 
@@ -265,6 +398,7 @@ static tb_pointer_t tb_native_large_allocator_malloc(tb_allocator_ref_t self, tb
 
         // update the occupied size
         allocator->occupied_size += need - TB_POOL_DATA_HEAD_DIFF_SIZE - patch;
+#endif
 
         // update the total size
         allocator->total_size    += size;
@@ -274,7 +408,6 @@ static tb_pointer_t tb_native_large_allocator_malloc(tb_allocator_ref_t self, tb
 
         // update the malloc count
         allocator->malloc_count++;
-#endif
 
         // ok
         ok = tb_true;
@@ -285,8 +418,8 @@ static tb_pointer_t tb_native_large_allocator_malloc(tb_allocator_ref_t self, tb
     if (!ok)
     {
         // exit the data
-        if (data) tb_native_memory_free(data);
-        data = tb_null;
+        if (data_head) tb_native_large_allocator_data_exit(allocator, data_head, need);
+        data_head = tb_null;
         data_real = tb_null;
     }
 
@@ -324,6 +457,18 @@ static tb_pointer_t tb_native_large_allocator_ralloc(tb_allocator_ref_t self, tb
         tb_assertf_and_check_break(data_head->allocator == (tb_pointer_t)allocator, "the data: %p not belong to allocator: %p", data, allocator);
         tb_assertf(((tb_byte_t*)data)[base_head->size] == TB_POOL_DATA_PATCH, "data underflow");
 
+        // the mapped data? we need make a new data and copy it
+        if (data_head->mapped || tb_native_large_allocator_mapped_size(allocator, need))
+        {
+            data_real = (tb_byte_t*)tb_native_large_allocator_ralloc_mapped(allocator, data, size, real __tb_debug_args__);
+            data_head = tb_null;
+            ok = data_real != tb_null;
+            break;
+        }
+
+        // the previous need size
+        tb_size_t prev_need = sizeof(tb_native_large_data_head_t) + base_head->size + patch;
+
 #ifdef __tb_debug__
         // check the last data
         tb_native_large_allocator_check_last(allocator);
@@ -339,14 +484,14 @@ static tb_pointer_t tb_native_large_allocator_ralloc(tb_allocator_ref_t self, tb
 
         // update the occupied size
         allocator->occupied_size -= base_head->size;
- 
-        // update the total size
-        allocator->total_size -= base_head->size;
 
         // the previous size
         tb_size_t prev_size = base_head->size;
 #endif
 
+        // update the total size
+        allocator->total_size -= base_head->size;
+
         // remove the data from the data_list
         tb_list_entry_remove(&allocator->data_list, &data_head->entry);
         removed = tb_true;
@@ -390,6 +535,9 @@ static tb_pointer_t tb_native_large_allocator_ralloc(tb_allocator_ref_t self, tb
         tb_list_entry_insert_tail(&allocator->data_list, &data_head->entry);
         removed = tb_false;
 
+        // update the total size
+        allocator->stat.total_size += need - prev_need;
+
         // save the real size
         if (real) *real = size;
 
@@ -399,6 +547,7 @@ static tb_pointer_t tb_native_large_allocator_ralloc(tb_allocator_ref_t self, tb
 
         // update the occupied size
         allocator->occupied_size += size;
+#endif
 
         // update the total size
         allocator->total_size    += size;
@@ -408,7 +557,6 @@ static tb_pointer_t tb_native_large_allocator_ralloc(tb_allocator_ref_t self, tb
 
         // update the ralloc count
         allocator->ralloc_count++;
-#endif
 
         // ok
         ok = tb_true;
@@ -436,6 +584,11 @@ static tb_bool_t tb_native_large_allocator_free(tb_allocator_ref_t self, tb_poin
     tb_assert_and_check_return_val(allocator && data, tb_false);
 
     // done
+#ifdef __tb_debug__
+    tb_size_t                       patch = 1; // patch 0xcc
+#else
+    tb_size_t                       patch = 0;
+#endif
     tb_bool_t                       ok = tb_false;
     tb_native_large_data_head_t*    data_head = tb_null;
     do
@@ -443,10 +596,8 @@ static tb_bool_t tb_native_large_allocator_free(tb_allocator_ref_t self, tb_poin
         // the data head
         data_head = &(((tb_native_large_data_head_t*)data)[-1]);
 
-#ifdef __tb_debug__
         // the base head
         tb_pool_data_head_t* base_head = tb_native_large_allocator_data_base(data_head);
-#endif
 
         // check
         tb_assertf(base_head->debug.magic != (tb_uint16_t)~TB_POOL_DATA_MAGIC, "double free data: %p", data);
@@ -466,19 +617,19 @@ static tb_bool_t tb_native_large_allocator_free(tb_allocator_ref_t self, tb_poin
 
         // for checking double-free
         base_head->debug.magic = (tb_uint16_t)~TB_POOL_DATA_MAGIC;
+#endif
 
         // update the total size
         allocator->total_size    -= base_head->size;
    
         // update the free count
         allocator->free_count++;
-#endif
 
         // remove the data from the data_list
         tb_list_entry_remove(&allocator->data_list, &data_head->entry);
 
         // free it
-        tb_native_memory_free(data_head);
+        tb_native_large_allocator_data_exit(allocator, data_head, sizeof(tb_native_large_data_head_t) + base_head->size + patch);
 
         // ok
         ok = tb_true;
@@ -522,14 +673,14 @@ static tb_void_t tb_native_large_allocator_clear(tb_allocator_ref_t self)
     } while (0);
 
     // clear info
-#ifdef __tb_debug__
     allocator->peak_size     = 0;
     allocator->total_size    = 0;
-    allocator->real_size     = 0;
-    allocator->occupied_size = 0;
     allocator->malloc_count  = 0;
     allocator->ralloc_count  = 0;
     allocator->free_count    = 0;
+#ifdef __tb_debug__
+    allocator->real_size     = 0;
+    allocator->occupied_size = 0;
 #endif
 }
 static tb_void_t tb_native_large_allocator_exit(tb_allocator_ref_t self)
@@ -544,6 +695,26 @@ static tb_void_t tb_native_large_allocator_exit(tb_allocator_ref_t self)
     // exit it
     tb_native_memory_free(allocator);
 }
+static tb_bool_t tb_native_large_allocator_stat_class(tb_allocator_ref_t self, tb_allocator_stat_ref_t stat)
+{
+    // check
+    tb_native_large_allocator_ref_t allocator = (tb_native_large_allocator_ref_t)self;
+    tb_assert_and_check_return_val(allocator && stat, tb_false);
+    tb_check_return_val(stat->class_count < tb_arrayn(stat->classes), tb_false);
+
+    // get the stat of the large class
+    tb_allocator_class_stat_ref_t cstat = &stat->classes[stat->class_count++];
+    cstat->item_size    = 0;
+    cstat->live_count   = allocator->malloc_count - allocator->free_count;
+    cstat->live_size    = allocator->total_size;
+    cstat->peak_size    = allocator->peak_size;
+    cstat->malloc_count = allocator->malloc_count;
+    cstat->free_count   = allocator->free_count;
+    cstat->slot_size    = allocator->stat.total_size;
+
+    // ok
+    return tb_true;
+}
 #ifdef __tb_debug__
 static tb_void_t tb_native_large_allocator_dump(tb_allocator_ref_t self)
 {
@@ -573,6 +744,15 @@ static tb_void_t tb_native_large_allocator_dump(tb_allocator_ref_t self)
     tb_trace_i("free_count: %lu",           allocator->free_count);
     tb_trace_i("malloc_count: %lu",         allocator->malloc_count);
     tb_trace_i("ralloc_count: %lu",         allocator->ralloc_count);
+
+    // trace the mapped data info
+    if (allocator->stat.mapped_size)
+    {
+        tb_trace_i("mapped_size: %lu",          allocator->stat.mapped_size);
+        tb_trace_i("huge_size: %lu",            allocator->stat.huge_size);
+        tb_trace_i("huge_advised_size: %lu",    allocator->stat.huge_advised_size);
+        tb_trace_i("bound_size: %lu",           allocator->stat.bound_size);
+    }
 }
 static tb_bool_t tb_native_large_allocator_have(tb_allocator_ref_t self, tb_cpointer_t data)
 {
@@ -592,6 +772,10 @@ static tb_bool_t tb_native_large_allocator_have(tb_allocator_ref_t self, tb_cpoi
  * implementation
  */
 tb_allocator_ref_t tb_native_large_allocator_init()
+{
+    return tb_native_large_allocator_init_with_option(TB_LARGE_ALLOCATOR_FLAG_NONE, -1);
+}
+tb_allocator_ref_t tb_native_large_allocator_init_with_option(tb_size_t flags, tb_long_t node)
 {
     // done
     tb_bool_t                           ok = tb_false;
@@ -612,6 +796,7 @@ tb_allocator_ref_t tb_native_large_allocator_init()
         allocator->base.large_free       = tb_native_large_allocator_free;
         allocator->base.clear            = tb_native_large_allocator_clear;
         allocator->base.exit             = tb_native_large_allocator_exit;
+        allocator->base.stat             = tb_native_large_allocator_stat_class;
 #ifdef __tb_debug__
         allocator->base.dump             = tb_native_large_allocator_dump;
         allocator->base.have             = tb_native_large_allocator_have;
@@ -623,6 +808,12 @@ tb_allocator_ref_t tb_native_large_allocator_init()
         // init data_list
         tb_list_entry_init(&allocator->data_list, tb_native_large_data_head_t, entry, tb_null);
 
+        // init the huge page size, it will be zero if the huge pages are not supported
+        if (flags & TB_LARGE_ALLOCATOR_FLAG_HUGEPAGE) allocator->huge_page_size = tb_virtual_memory_huge_page_size();
+
+        // init the numa node
+        allocator->node = node;
+
         // register lock profiler
 #ifdef TB_LOCK_PROFILER_ENABLE
         tb_lock_profiler_register(tb_lock_profiler(), (tb_pointer_t)&allocator->base.lock, TB_TRACE_MODULE_NAME);
@@ -644,4 +835,20 @@ tb_allocator_ref_t tb_native_large_allocator_init()
     // ok?
     return (tb_allocator_ref_t)allocator;
 }
+tb_bool_t tb_native_large_allocator_stat(tb_allocator_ref_t self, tb_large_allocator_stat_ref_t stat)
+{
+    // check
+    tb_native_large_allocator_ref_t allocator = (tb_native_large_allocator_ref_t)self;
+    tb_assert_and_check_return_val(allocator && stat, tb_false);
+
+    // is the native large allocator?
+    tb_check_return_val(self->type == TB_ALLOCATOR_LARGE && self->exit == tb_native_large_allocator_exit, tb_false);
 
+    // get stat
+    tb_spinlock_enter(&self->lock);
+    *stat = allocator->stat;
+    tb_spinlock_leave(&self->lock);
+
+    // ok
+    return tb_true;
+}
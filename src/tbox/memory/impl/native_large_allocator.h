@@ -45,6 +45,24 @@ __tb_extern_c_enter__
  */
 tb_allocator_ref_t      tb_native_large_allocator_init(tb_noarg_t);
 
+/* init the native large allocator with the given option
+ *
+ * @param flags         the flags, .e.g TB_LARGE_ALLOCATOR_FLAG_HUGEPAGE
+ * @param node          the numa node index, does not bind it if be -1
+ * 
+ * @return              the allocator 
+ */
+tb_allocator_ref_t      tb_native_large_allocator_init_with_option(tb_size_t flags, tb_long_t node);
+
+/* get the stat of the native large allocator
+ *
+ * @param allocator     the allocator
+ * @param stat          the stat
+ *
+ * @return              tb_true or tb_false, return tb_false if it is not a native large allocator
+ */
+tb_bool_t               tb_native_large_allocator_stat(tb_allocator_ref_t allocator, tb_large_allocator_stat_ref_t stat);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
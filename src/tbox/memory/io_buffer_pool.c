@@ -0,0 +1,439 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        io_buffer_pool.c
+ * @ingroup     memory
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "io_buffer_pool"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "io_buffer_pool.h"
+#include "impl/prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the minimum size class: 4KB
+#define TB_IO_BUFFER_POOL_CLASS_MINB        (12)
+
+// the size classes count: 4KB, 8KB, 16KB, 32KB, 64KB
+#define TB_IO_BUFFER_POOL_CLASS_MAXN        (5)
+
+// the slab size
+#ifdef __tb_small__
+#   define TB_IO_BUFFER_POOL_SLAB_SIZE      (64 * 1024)
+#else
+#   define TB_IO_BUFFER_POOL_SLAB_SIZE      (256 * 1024)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the io buffer type
+typedef struct __tb_io_buffer_t
+{
+    // the reference count, it is free if be zero
+    tb_atomic_t                     refn;
+
+    // the buffer data
+    tb_byte_t*                      data;
+
+    // the slab
+    struct __tb_io_buffer_slab_t*   slab;
+
+    // the next free buffer
+    struct __tb_io_buffer_t*        next;
+
+}tb_io_buffer_t;
+
+// the io buffer slab type
+typedef struct __tb_io_buffer_slab_t
+{
+    // the list entry
+    tb_list_entry_t                 entry;
+
+    // the size class
+    struct __tb_io_buffer_class_t*  klass;
+
+    // the slab data, it is allocated from the large allocator
+    tb_byte_t*                      data;
+
+    // the used buffers count
+    tb_size_t                       used;
+
+    // the free buffers
+    tb_io_buffer_t*                 free;
+
+    // the buffers
+    tb_io_buffer_t                  buffers[1];
+
+}tb_io_buffer_slab_t;
+
+// the io buffer size class type
+typedef struct __tb_io_buffer_class_t
+{
+    // the lock
+    tb_spinlock_t                   lock;
+
+    // the buffer size
+    tb_size_t                       size;
+
+    // the buffers count of each slab
+    tb_size_t                       count;
+
+    // the empty slabs count
+    tb_size_t                       empty;
+
+    // the borrowed buffers count
+    tb_size_t                       used;
+
+    // the peak borrowed buffers count
+    tb_size_t                       peak;
+
+    // the partial slabs, the empty slabs are at the tail
+    tb_list_entry_head_t            partial_slabs;
+
+    // the full slabs
+    tb_list_entry_head_t            full_slabs;
+
+}tb_io_buffer_class_t;
+
+// the io buffer pool type
+typedef struct __tb_io_buffer_pool_t
+{
+    // the size classes
+    tb_io_buffer_class_t            classes[TB_IO_BUFFER_POOL_CLASS_MAXN];
+
+}tb_io_buffer_pool_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_handle_t tb_io_buffer_pool_instance_init(tb_cpointer_t* ppriv)
+{
+    return (tb_handle_t)tb_io_buffer_pool_init();
+}
+static tb_void_t tb_io_buffer_pool_instance_exit(tb_handle_t pool, tb_cpointer_t priv)
+{
+    tb_io_buffer_pool_exit((tb_io_buffer_pool_ref_t)pool);
+}
+static tb_io_buffer_slab_t* tb_io_buffer_pool_slab_init(tb_io_buffer_class_t* klass)
+{
+    // check
+    tb_assert(klass && klass->size && klass->count);
+
+    // done
+    tb_bool_t               ok = tb_false;
+    tb_io_buffer_slab_t*    slab = tb_null;
+    do
+    {
+        // make slab
+        slab = (tb_io_buffer_slab_t*)tb_malloc0(sizeof(tb_io_buffer_slab_t) + (klass->count - 1) * sizeof(tb_io_buffer_t));
+        tb_assert_and_check_break(slab);
+
+        // make slab data
+        slab->data = (tb_byte_t*)tb_large_malloc(klass->size * klass->count, tb_null);
+        tb_assert_and_check_break(slab->data);
+
+        // init buffers
+        tb_size_t i = klass->count;
+        while (i--)
+        {
+            tb_io_buffer_t* buffer = &slab->buffers[i];
+            buffer->data    = slab->data + i * klass->size;
+            buffer->slab    = slab;
+            buffer->next    = slab->free;
+            slab->free      = buffer;
+        }
+        slab->klass = klass;
+
+        // trace
+        tb_trace_d("slab[%lu]: init: %p", klass->size, slab->data);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok && slab)
+    {
+        if (slab->data) tb_large_free(slab->data);
+        tb_free(slab);
+        slab = tb_null;
+    }
+
+    // ok?
+    return slab;
+}
+static tb_void_t tb_io_buffer_pool_slab_exit(tb_io_buffer_slab_t* slab)
+{
+    // check
+    tb_assert_and_check_return(slab && slab->klass);
+
+    // trace
+    tb_trace_d("slab[%lu]: exit: %p", slab->klass->size, slab->data);
+
+    // exit it
+    if (slab->data) tb_large_free(slab->data);
+    tb_free(slab);
+}
+static tb_void_t tb_io_buffer_pool_slabs_exit(tb_list_entry_head_ref_t slabs)
+{
+    // exit all slabs
+    while (!tb_list_entry_is_null(slabs))
+    {
+        tb_list_entry_ref_t entry = tb_list_entry_head(slabs);
+        tb_list_entry_remove_head(slabs);
+        tb_io_buffer_pool_slab_exit((tb_io_buffer_slab_t*)tb_list_entry(slabs, entry));
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_io_buffer_pool_ref_t tb_io_buffer_pool()
+{
+    return (tb_io_buffer_pool_ref_t)tb_singleton_instance(TB_SINGLETON_TYPE_IO_BUFFER_POOL, tb_io_buffer_pool_instance_init, tb_io_buffer_pool_instance_exit, tb_null, tb_null);
+}
+tb_io_buffer_pool_ref_t tb_io_buffer_pool_init()
+{
+    // make pool
+    tb_io_buffer_pool_t* pool = tb_malloc0_type(tb_io_buffer_pool_t);
+    tb_assert_and_check_return_val(pool, tb_null);
+
+    // init size classes
+    tb_size_t i = 0;
+    for (i = 0; i < TB_IO_BUFFER_POOL_CLASS_MAXN; i++)
+    {
+        tb_io_buffer_class_t* klass = &pool->classes[i];
+        klass->size     = (tb_size_t)1 << (TB_IO_BUFFER_POOL_CLASS_MINB + i);
+        klass->count    = tb_max(TB_IO_BUFFER_POOL_SLAB_SIZE / klass->size, 1);
+        tb_spinlock_init(&klass->lock);
+        tb_list_entry_init(&klass->partial_slabs, tb_io_buffer_slab_t, entry, tb_null);
+        tb_list_entry_init(&klass->full_slabs, tb_io_buffer_slab_t, entry, tb_null);
+    }
+
+    // ok
+    return (tb_io_buffer_pool_ref_t)pool;
+}
+tb_void_t tb_io_buffer_pool_exit(tb_io_buffer_pool_ref_t self)
+{
+    // check
+    tb_io_buffer_pool_t* pool = (tb_io_buffer_pool_t*)self;
+    tb_assert_and_check_return(pool);
+
+    // exit size classes
+    tb_size_t i = 0;
+    for (i = 0; i < TB_IO_BUFFER_POOL_CLASS_MAXN; i++)
+    {
+        // check leaks
+        tb_io_buffer_class_t* klass = &pool->classes[i];
+        if (klass->used) tb_trace_e("%lu buffers(%lu) are not released!", klass->used, klass->size);
+
+        // exit slabs
+        tb_spinlock_enter(&klass->lock);
+        tb_io_buffer_pool_slabs_exit(&klass->partial_slabs);
+        tb_io_buffer_pool_slabs_exit(&klass->full_slabs);
+        tb_spinlock_leave(&klass->lock);
+
+        // exit lock
+        tb_spinlock_exit(&klass->lock);
+    }
+
+    // exit pool
+    tb_free(pool);
+}
+tb_io_buffer_ref_t tb_io_buffer_pool_borrow(tb_io_buffer_pool_ref_t self, tb_size_t size)
+{
+    // check
+    tb_io_buffer_pool_t* pool = (tb_io_buffer_pool_t*)self;
+    tb_assert_and_check_return_val(pool, tb_null);
+
+    // too large?
+    tb_check_return_val(size <= TB_IO_BUFFER_POOL_MAXN, tb_null);
+
+    // get the size class
+    tb_size_t index = 0;
+    while (((tb_size_t)1 << (TB_IO_BUFFER_POOL_CLASS_MINB + index)) < size) index++;
+    tb_assert_and_check_return_val(index < TB_IO_BUFFER_POOL_CLASS_MAXN, tb_null);
+    tb_io_buffer_class_t* klass = &pool->classes[index];
+
+    // enter
+    tb_spinlock_enter(&klass->lock);
+
+    // done
+    tb_io_buffer_t* buffer = tb_null;
+    do
+    {
+        // get a partial slab or make a new slab
+        tb_io_buffer_slab_t* slab = tb_null;
+        if (!tb_list_entry_is_null(&klass->partial_slabs))
+        {
+            slab = (tb_io_buffer_slab_t*)tb_list_entry(&klass->partial_slabs, tb_list_entry_head(&klass->partial_slabs));
+            if (!slab->used) klass->empty--;
+        }
+        else
+        {
+            slab = tb_io_buffer_pool_slab_init(klass);
+            tb_assert_and_check_break(slab);
+            tb_list_entry_insert_head(&klass->partial_slabs, &slab->entry);
+        }
+        tb_assert_and_check_break(slab->free);
+
+        // get a free buffer
+        buffer = slab->free;
+        slab->free = buffer->next;
+        slab->used++;
+        buffer->next = tb_null;
+        tb_atomic_set(&buffer->refn, 1);
+
+        // the slab is full? move it to the full slabs
+        if (!slab->free)
+        {
+            tb_list_entry_remove(&klass->partial_slabs, &slab->entry);
+            tb_list_entry_insert_tail(&klass->full_slabs, &slab->entry);
+        }
+
+        // update the borrowed count
+        klass->used++;
+        if (klass->used > klass->peak) klass->peak = klass->used;
+
+    } while (0);
+
+    // leave
+    tb_spinlock_leave(&klass->lock);
+
+    // ok?
+    return (tb_io_buffer_ref_t)buffer;
+}
+#ifdef __tb_debug__
+tb_void_t tb_io_buffer_pool_dump(tb_io_buffer_pool_ref_t self)
+{
+    // check
+    tb_io_buffer_pool_t* pool = (tb_io_buffer_pool_t*)self;
+    tb_assert_and_check_return(pool);
+
+    // dump size classes
+    tb_size_t i = 0;
+    for (i = 0; i < TB_IO_BUFFER_POOL_CLASS_MAXN; i++)
+    {
+        tb_io_buffer_class_t* klass = &pool->classes[i];
+        tb_spinlock_enter(&klass->lock);
+        tb_trace_i("class[%lu]: used: %lu, peak: %lu, slabs: %lu, empty: %lu", klass->size, klass->used, klass->peak
+                   , tb_list_entry_size(&klass->partial_slabs) + tb_list_entry_size(&klass->full_slabs), klass->empty);
+        tb_spinlock_leave(&klass->lock);
+    }
+}
+#endif
+tb_io_buffer_ref_t tb_io_buffer_retain(tb_io_buffer_ref_t self)
+{
+    // check
+    tb_io_buffer_t* buffer = (tb_io_buffer_t*)self;
+    tb_assert_and_check_return_val(buffer, tb_null);
+
+    // retain it
+    tb_long_t refn = tb_atomic_fetch_and_inc(&buffer->refn);
+    tb_assertf(refn > 0, "retain the released buffer: %p", buffer);
+    tb_used(refn);
+
+    // ok
+    return self;
+}
+tb_void_t tb_io_buffer_release(tb_io_buffer_ref_t self)
+{
+    // check
+    tb_io_buffer_t* buffer = (tb_io_buffer_t*)self;
+    tb_assert_and_check_return(buffer && buffer->slab && buffer->slab->klass);
+
+    // release it
+    tb_long_t refn = tb_atomic_fetch_and_dec(&buffer->refn);
+    tb_assertf(refn > 0, "double release the buffer: %p", buffer);
+    tb_check_return(refn == 1);
+
+    // enter
+    tb_io_buffer_slab_t*    slab = buffer->slab;
+    tb_io_buffer_class_t*   klass = slab->klass;
+    tb_spinlock_enter(&klass->lock);
+
+    // the slab is full? move it to the head of partial slabs
+    if (!slab->free)
+    {
+        tb_list_entry_remove(&klass->full_slabs, &slab->entry);
+        tb_list_entry_insert_head(&klass->partial_slabs, &slab->entry);
+    }
+
+    // return the buffer to the slab
+    buffer->next = slab->free;
+    slab->free = buffer;
+    slab->used--;
+    klass->used--;
+
+    // the slab is empty now?
+    tb_io_buffer_slab_t* slab_empty = tb_null;
+    if (!slab->used)
+    {
+        // remove it from the partial slabs
+        tb_list_entry_remove(&klass->partial_slabs, &slab->entry);
+
+        // keep only one empty slab for borrowing quickly, and return the other empty slabs to the system
+        if (!klass->empty)
+        {
+            tb_list_entry_insert_tail(&klass->partial_slabs, &slab->entry);
+            klass->empty++;
+        }
+        else slab_empty = slab;
+    }
+
+    // leave
+    tb_spinlock_leave(&klass->lock);
+
+    // exit the empty slab
+    if (slab_empty) tb_io_buffer_pool_slab_exit(slab_empty);
+}
+tb_byte_t* tb_io_buffer_data(tb_io_buffer_ref_t self)
+{
+    // check
+    tb_io_buffer_t* buffer = (tb_io_buffer_t*)self;
+    tb_assert_and_check_return_val(buffer, tb_null);
+
+    // the data
+    return buffer->data;
+}
+tb_size_t tb_io_buffer_size(tb_io_buffer_ref_t self)
+{
+    // check
+    tb_io_buffer_t* buffer = (tb_io_buffer_t*)self;
+    tb_assert_and_check_return_val(buffer && buffer->slab && buffer->slab->klass, 0);
+
+    // the size
+    return buffer->slab->klass->size;
+}
@@ -0,0 +1,167 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        io_buffer_pool.h
+ * @ingroup     memory
+ *
+ */
+#ifndef TB_MEMORY_IO_BUFFER_POOL_H
+#define TB_MEMORY_IO_BUFFER_POOL_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// the minimum buffer size of the io buffer pool
+#define TB_IO_BUFFER_POOL_MINN          (4096)
+
+/// the maximum buffer size of the io buffer pool
+#define TB_IO_BUFFER_POOL_MAXN          (65536)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the io buffer pool ref type
+ *
+ * <pre>
+ *
+ * class: 4KB:  | slab | <=> | slab | <=> ...     slab: | buffer | buffer | ... | buffer |  (large allocator)
+ * class: 8KB:  | slab | <=> ...
+ * class: 16KB: | slab | <=> ...
+ * class: 32KB: | slab | <=> ...
+ * class: 64KB: | slab | <=> ...
+ *
+ * </pre>
+ *
+ * the buffers are borrowed only when the data is in flight and returned after the connection becomes idle,
+ * so many idle connections will not hold any buffers.
+ *
+ * the empty slab will be returned to the system if there is another empty slab in the same class.
+ */
+typedef __tb_typeref__(io_buffer_pool);
+
+/// the io buffer ref type, it is reference-counted
+typedef __tb_typeref__(io_buffer);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! the global io buffer pool instance
+ *
+ * @return              the io buffer pool
+ */
+tb_io_buffer_pool_ref_t tb_io_buffer_pool(tb_noarg_t);
+
+/*! init the io buffer pool
+ *
+ * @return              the io buffer pool
+ */
+tb_io_buffer_pool_ref_t tb_io_buffer_pool_init(tb_noarg_t);
+
+/*! exit the io buffer pool
+ *
+ * @note all borrowed buffers need be released before exiting it
+ *
+ * @param pool          the io buffer pool
+ */
+tb_void_t               tb_io_buffer_pool_exit(tb_io_buffer_pool_ref_t pool);
+
+/*! borrow a buffer from the io buffer pool, it is thread-safe
+ *
+ * @code
+ 
+    // borrow a buffer after the socket is readable
+    tb_io_buffer_ref_t buffer = tb_io_buffer_pool_borrow(tb_io_buffer_pool(), 8192);
+    if (buffer)
+    {
+        // recv data
+        tb_long_t real = tb_socket_recv(sock, tb_io_buffer_data(buffer), tb_io_buffer_size(buffer));
+
+        // ...
+
+        // return it
+        tb_io_buffer_release(buffer);
+    }
+ * @endcode
+ *
+ * @param pool          the io buffer pool
+ * @param size          the buffer size, it will be aligned to the size class (4KB, 8KB, .., 64KB)
+ *
+ * @return              the buffer, return tb_null if the size is larger than TB_IO_BUFFER_POOL_MAXN
+ */
+tb_io_buffer_ref_t      tb_io_buffer_pool_borrow(tb_io_buffer_pool_ref_t pool, tb_size_t size);
+
+#ifdef __tb_debug__
+/*! dump the io buffer pool
+ *
+ * @param pool          the io buffer pool
+ */
+tb_void_t               tb_io_buffer_pool_dump(tb_io_buffer_pool_ref_t pool);
+#endif
+
+/*! retain the buffer, it need be released by tb_io_buffer_release()
+ *
+ * @param buffer        the buffer
+ *
+ * @return              the buffer
+ */
+tb_io_buffer_ref_t      tb_io_buffer_retain(tb_io_buffer_ref_t buffer);
+
+/*! release the buffer, it will be returned to the pool if the reference count is zero
+ *
+ * @param buffer        the buffer
+ */
+tb_void_t               tb_io_buffer_release(tb_io_buffer_ref_t buffer);
+
+/*! the buffer data
+ *
+ * @param buffer        the buffer
+ *
+ * @return              the buffer data
+ */
+tb_byte_t*              tb_io_buffer_data(tb_io_buffer_ref_t buffer);
+
+/*! the buffer size of the size class
+ *
+ * @param buffer        the buffer
+ *
+ * @return              the buffer size
+ */
+tb_size_t               tb_io_buffer_size(tb_io_buffer_ref_t buffer);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
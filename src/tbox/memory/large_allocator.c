@@ -40,5 +40,16 @@ tb_allocator_ref_t tb_large_allocator_init(tb_byte_t* data, tb_size_t size)
     // init pool
     return (data && size)? tb_static_large_allocator_init(data, size, tb_page_size()) : tb_native_large_allocator_init();
 }
+tb_allocator_ref_t tb_large_allocator_init_with_option(tb_size_t flags, tb_long_t node)
+{
+    // init pool
+    return tb_native_large_allocator_init_with_option(flags, node);
+}
+tb_bool_t tb_large_allocator_stat(tb_allocator_ref_t allocator, tb_large_allocator_stat_ref_t stat)
+{
+    // check
+    tb_assert_and_check_return_val(allocator && stat, tb_false);
 
-
+    // get stat
+    return tb_native_large_allocator_stat(allocator, stat);
+}
@@ -36,6 +36,38 @@
  */
 __tb_extern_c_enter__
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the large allocator flag enum
+typedef enum __tb_large_allocator_flag_e
+{
+    TB_LARGE_ALLOCATOR_FLAG_NONE        = 0
+,   TB_LARGE_ALLOCATOR_FLAG_HUGEPAGE    = 1     //!< map the large data (>= huge page size / 2) on the huge pages 
+
+}tb_large_allocator_flag_e;
+
+/// the large allocator stat type
+typedef struct __tb_large_allocator_stat_t
+{
+    /// the total size of all data, includes the data heads and the aligned space of the mapped data
+    tb_size_t               total_size;
+
+    /// the size of the data mapped from the virtual memory directly
+    tb_size_t               mapped_size;
+
+    /// the size of the data on the reserved huge pages
+    tb_size_t               huge_size;
+
+    /// the size of the data advised to use the transparent huge pages, it is not guaranteed by the kernel
+    tb_size_t               huge_advised_size;
+
+    /// the size of the data bound to the numa node
+    tb_size_t               bound_size;
+
+}tb_large_allocator_stat_t, *tb_large_allocator_stat_ref_t;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -65,6 +97,58 @@ __tb_extern_c_enter__
  */
 tb_allocator_ref_t      tb_large_allocator_init(tb_byte_t* data, tb_size_t size);
 
+/*! init the large allocator of the native memory with the given option
+ *
+ * the large data (>= huge page size / 2) will be mapped on the huge pages if TB_LARGE_ALLOCATOR_FLAG_HUGEPAGE is set, 
+ * it uses the reserved huge pages first and falls back to the transparent huge pages.
+ *
+ * the data (>= 64K) will be mapped and bound to the given numa node if node >= 0,
+ * and the smaller data are still allocated from the native memory.
+ *
+ * @code
+    
+    // init the large allocator on huge pages and bind it to the numa node 0
+    tb_allocator_ref_t allocator = tb_large_allocator_init_with_option(TB_LARGE_ALLOCATOR_FLAG_HUGEPAGE, 0);
+    if (allocator)
+    {
+        // make a large hash table
+        tb_pointer_t data = tb_allocator_large_malloc(allocator, 16 * 1024 * 1024, tb_null);
+        if (data)
+        {
+            // ...
+
+            // get the stat
+            tb_large_allocator_stat_t stat;
+            if (tb_large_allocator_stat(allocator, &stat))
+                tb_trace_i("huge: %lu, advised: %lu", stat.huge_size, stat.huge_advised_size);
+
+            // free it
+            tb_allocator_large_free(allocator, data);
+        }
+
+        // exit allocator
+        tb_allocator_exit(allocator);
+    }
+ * @endcode
+ *
+ * @param flags         the flags, .e.g TB_LARGE_ALLOCATOR_FLAG_HUGEPAGE
+ * @param node          the numa node index, does not bind it if be -1
+ *
+ * @return              the allocator 
+ */
+tb_allocator_ref_t      tb_large_allocator_init_with_option(tb_size_t flags, tb_long_t node);
+
+/*! get the stat of the large allocator
+ *
+ * @note it is always available in the release mode
+ *
+ * @param allocator     the allocator
+ * @param stat          the stat
+ *
+ * @return              tb_true or tb_false, return tb_false if the allocator is not a native large allocator
+ */
+tb_bool_t               tb_large_allocator_stat(tb_allocator_ref_t allocator, tb_large_allocator_stat_ref_t stat);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
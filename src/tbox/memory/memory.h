@@ -33,6 +33,9 @@
 #include "buffer.h"
 #include "allocator.h"
 #include "fixed_pool.h"
+#include "concurrent_fixed_pool.h"
+#include "heap_profiler.h"
+#include "io_buffer_pool.h"
 #include "string_pool.h"
 #include "queue_buffer.h"
 #include "static_buffer.h"
@@ -40,6 +43,7 @@
 #include "small_allocator.h"
 #include "native_allocator.h"
 #include "static_allocator.h"
+#include "region_allocator.h"
 #include "default_allocator.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -31,6 +31,34 @@
 #include "../libc/libc.h"
 #include "../utils/utils.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_byte_t* tb_queue_buffer_data_make(tb_size_t maxn, tb_io_buffer_ref_t* ppooled)
+{
+    // check
+    tb_assert(ppooled);
+
+    // borrow data from the io buffer pool first
+    tb_io_buffer_ref_t pooled = maxn <= TB_IO_BUFFER_POOL_MAXN? tb_io_buffer_pool_borrow(tb_io_buffer_pool(), maxn) : tb_null;
+    *ppooled = pooled;
+
+    // ok?
+    return pooled? tb_io_buffer_data(pooled) : tb_malloc_bytes(maxn);
+}
+static tb_void_t tb_queue_buffer_data_free(tb_queue_buffer_ref_t buffer)
+{
+    // check
+    tb_assert(buffer);
+
+    // free data
+    if (buffer->pooled) tb_io_buffer_release(buffer->pooled);
+    else if (buffer->data) tb_free(buffer->data);
+    buffer->pooled  = tb_null;
+    buffer->data    = tb_null;
+    buffer->head    = tb_null;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -44,6 +72,7 @@ tb_bool_t tb_queue_buffer_init(tb_queue_buffer_ref_t buffer, tb_size_t maxn)
     buffer->head = tb_null;
     buffer->size = 0;
     buffer->maxn = maxn;
+    buffer->pooled = tb_null;
 
     // ok
     return tb_true;
@@ -52,7 +81,7 @@ tb_void_t tb_queue_buffer_exit(tb_queue_buffer_ref_t buffer)
 {
     if (buffer)
     {
-        if (buffer->data) tb_free(buffer->data);
+        tb_queue_buffer_data_free(buffer);
         tb_memset(buffer, 0, sizeof(tb_queue_buffer_t));
     }
 }
@@ -129,6 +158,14 @@ tb_void_t tb_queue_buffer_clear(tb_queue_buffer_ref_t buffer)
     buffer->size = 0;
     buffer->head = buffer->data;
 }
+tb_void_t tb_queue_buffer_idle(tb_queue_buffer_ref_t buffer)
+{
+    // check
+    tb_assert_and_check_return(buffer);
+
+    // release the data if be null
+    if (!buffer->size) tb_queue_buffer_data_free(buffer);
+}
 tb_byte_t* tb_queue_buffer_resize(tb_queue_buffer_ref_t buffer, tb_size_t maxn)
 {
     // check
@@ -144,8 +181,27 @@ tb_byte_t* tb_queue_buffer_resize(tb_queue_buffer_ref_t buffer, tb_size_t maxn)
             buffer->head = buffer->data;
         }
 
+        // the pooled data is too small? move data to the new data
+        if (buffer->pooled && maxn > tb_io_buffer_size(buffer->pooled))
+        {
+            // make data
+            tb_io_buffer_ref_t  pooled = tb_null;
+            tb_byte_t*          data = tb_queue_buffer_data_make(maxn, &pooled);
+            tb_assert_and_check_return_val(data, tb_null);
+
+            // copy data
+            if (buffer->size) tb_memcpy(data, buffer->data, buffer->size);
+
+            // free the old data
+            tb_io_buffer_release(buffer->pooled);
+
+            // save data
+            buffer->data    = data;
+            buffer->head    = data;
+            buffer->pooled  = pooled;
+        }
         // realloc
-        if (maxn > buffer->maxn)
+        else if (!buffer->pooled && maxn > buffer->maxn)
         {
             // init head
             buffer->head = tb_null;
@@ -215,7 +271,7 @@ tb_long_t tb_queue_buffer_writ(tb_queue_buffer_ref_t buffer, tb_byte_t const* da
     if (!buffer->data)
     {
         // make data
-        buffer->data = tb_malloc_bytes(buffer->maxn);
+        buffer->data = tb_queue_buffer_data_make(buffer->maxn, &buffer->pooled);
         tb_assert_and_check_return_val(buffer->data, -1);
 
         // init it
@@ -279,7 +335,7 @@ tb_byte_t* tb_queue_buffer_push_init(tb_queue_buffer_ref_t buffer, tb_size_t* si
     if (!buffer->data)
     {
         // make data
-        buffer->data = tb_malloc_bytes(buffer->maxn);
+        buffer->data = tb_queue_buffer_data_make(buffer->maxn, &buffer->pooled);
         tb_assert_and_check_return_val(buffer->data, tb_null);
 
         // init 
@@ -30,6 +30,7 @@
  * includes
  */
 #include "prefix.h"
+#include "io_buffer_pool.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
@@ -55,6 +56,9 @@ typedef struct __tb_queue_buffer_t
     // the buffer maxn
     tb_size_t       maxn;
 
+    // the pooled io buffer of data, the data is allocated from the heap if be null
+    tb_io_buffer_ref_t pooled;
+
 }tb_queue_buffer_t, *tb_queue_buffer_ref_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -146,6 +150,17 @@ tb_bool_t           tb_queue_buffer_null(tb_queue_buffer_ref_t buffer);
  */
 tb_void_t           tb_queue_buffer_clear(tb_queue_buffer_ref_t buffer);
 
+/*! release the buffer data if the buffer is null
+ *
+ * the buffer data will be borrowed from the io buffer pool again when writing data,
+ * so the idle buffers of the streams and connections will not hold memory.
+ *
+ * @note the pointers returned by tb_queue_buffer_pull_init() will be invalid after calling it
+ *
+ * @param buffer    the buffer
+ */
+tb_void_t           tb_queue_buffer_idle(tb_queue_buffer_ref_t buffer);
+
 /*! resize buffer size
  *
  * @param buffer    the buffer
@@ -0,0 +1,455 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        region_allocator.c
+ * @ingroup     memory
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "region_allocator"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "region_allocator.h"
+#include "impl/prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default chunk size
+#ifdef __tb_small__
+#   define TB_REGION_ALLOCATOR_CHUNK_SIZE       (16 * 1024)
+#else
+#   define TB_REGION_ALLOCATOR_CHUNK_SIZE       (64 * 1024)
+#endif
+
+// the chunk head size
+#define TB_REGION_ALLOCATOR_CHUNK_HEAD_SIZE     tb_align(sizeof(tb_region_allocator_chunk_t), TB_POOL_DATA_ALIGN)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the region allocator chunk type
+typedef struct __tb_region_allocator_chunk_t
+{
+    // the next chunk
+    struct __tb_region_allocator_chunk_t*   next;
+
+    // the chunk size (include head)
+    tb_size_t                               size;
+
+}tb_region_allocator_chunk_t;
+
+// the region allocator type
+typedef struct __tb_region_allocator_t
+{
+    // the base
+    tb_allocator_t                  base;
+
+    // the large allocator
+    tb_allocator_ref_t              large_allocator;
+
+    // the chunk size
+    tb_size_t                       chunk_size;
+
+    // the chunks, the first chunk is the current chunk
+    tb_region_allocator_chunk_t*    chunks;
+
+    // the current position of the current chunk
+    tb_byte_t*                      pos;
+
+    // the end of the current chunk
+    tb_byte_t*                      end;
+
+    // the last data for reclaiming it in free() and ralloc()
+    tb_byte_t*                      last;
+
+#ifdef __tb_debug__
+    // the chunks count
+    tb_size_t                       chunk_count;
+
+    // the malloc count
+    tb_size_t                       malloc_count;
+
+    // the total used size
+    tb_size_t                       used_size;
+#endif
+
+}tb_region_allocator_t, *tb_region_allocator_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_region_allocator_chunk_t* tb_region_allocator_chunk_init(tb_region_allocator_ref_t allocator, tb_size_t size)
+{
+    // check
+    tb_assert(allocator && allocator->large_allocator);
+
+    // make chunk
+    tb_size_t                       real = 0;
+    tb_region_allocator_chunk_t*    chunk = (tb_region_allocator_chunk_t*)tb_allocator_large_malloc(allocator->large_allocator, size, &real);
+    tb_assert_and_check_return_val(chunk, tb_null);
+
+    // init chunk
+    chunk->next = tb_null;
+    chunk->size = real;
+
+#ifdef __tb_debug__
+    // update the chunks count
+    allocator->chunk_count++;
+#endif
+
+    // ok
+    return chunk;
+}
+static tb_void_t tb_region_allocator_chunk_exit(tb_region_allocator_ref_t allocator, tb_region_allocator_chunk_t* chunk)
+{
+    // check
+    tb_assert(allocator && allocator->large_allocator && chunk);
+
+#ifdef __tb_debug__
+    // update the chunks count
+    allocator->chunk_count--;
+#endif
+
+    // exit it
+    tb_allocator_large_free(allocator->large_allocator, chunk);
+}
+static tb_pointer_t tb_region_allocator_malloc(tb_allocator_ref_t self, tb_size_t size __tb_debug_decl__)
+{
+    // check
+    tb_region_allocator_ref_t allocator = (tb_region_allocator_ref_t)self;
+    tb_assert_and_check_return_val(allocator && size && size <= TB_POOL_DATA_SIZE_MAXN, tb_null);
+
+    // the need size
+    tb_size_t need = tb_align(sizeof(tb_pool_data_head_t) + size, TB_POOL_DATA_ALIGN);
+
+    // done
+    tb_byte_t* base = tb_null;
+    do
+    {
+        // enough space in the current chunk? move the position directly
+        if (allocator->pos + need <= allocator->end)
+        {
+            base = allocator->pos;
+            allocator->pos += need;
+            break;
+        }
+
+        // the large data? make a single chunk for it and keep the current chunk
+        tb_size_t chunk_size = allocator->chunk_size;
+        if (need > (chunk_size >> 2))
+        {
+            // make chunk
+            tb_region_allocator_chunk_t* chunk = tb_region_allocator_chunk_init(allocator, TB_REGION_ALLOCATOR_CHUNK_HEAD_SIZE + need);
+            tb_assert_and_check_break(chunk);
+
+            // insert it after the current chunk
+            if (allocator->chunks)
+            {
+                chunk->next = allocator->chunks->next;
+                allocator->chunks->next = chunk;
+            }
+            else allocator->chunks = chunk;
+
+            // the data base, it cannot be reclaimed
+            base = (tb_byte_t*)chunk + TB_REGION_ALLOCATOR_CHUNK_HEAD_SIZE;
+            allocator->last = tb_null;
+            break;
+        }
+
+        // make a new current chunk
+        tb_region_allocator_chunk_t* chunk = tb_region_allocator_chunk_init(allocator, chunk_size);
+        tb_assert_and_check_break(chunk);
+
+        // insert it to the head
+        chunk->next         = allocator->chunks;
+        allocator->chunks   = chunk;
+        allocator->pos      = (tb_byte_t*)chunk + TB_REGION_ALLOCATOR_CHUNK_HEAD_SIZE;
+        allocator->end      = (tb_byte_t*)chunk + chunk->size;
+        tb_assert_and_check_break(allocator->pos + need <= allocator->end);
+
+        // make data
+        base = allocator->pos;
+        allocator->pos += need;
+
+    } while (0);
+
+    // failed?
+    tb_check_return_val(base, tb_null);
+
+    // init the data head
+    tb_pool_data_head_t* data_head = (tb_pool_data_head_t*)base;
+    data_head->size = size;
+
+#ifdef __tb_debug__
+    data_head->debug.magic     = TB_POOL_DATA_MAGIC;
+    data_head->debug.file      = file_;
+    data_head->debug.func      = func_;
+    data_head->debug.line      = (tb_uint16_t)line_;
+
+    // save backtrace
+    tb_pool_data_save_backtrace(&data_head->debug, 5);
+
+    // update the malloc count and used size
+    allocator->malloc_count++;
+    allocator->used_size += need;
+#endif
+
+    // save the last data if it is in the current chunk
+    if (allocator->pos == base + need) allocator->last = base;
+
+    // ok
+    return (tb_pointer_t)&data_head[1];
+}
+static tb_pointer_t tb_region_allocator_ralloc(tb_allocator_ref_t self, tb_pointer_t data, tb_size_t size __tb_debug_decl__)
+{
+    // check
+    tb_region_allocator_ref_t allocator = (tb_region_allocator_ref_t)self;
+    tb_assert_and_check_return_val(allocator && size && size <= TB_POOL_DATA_SIZE_MAXN, tb_null);
+
+    // no data? malloc it directly
+    if (!data) return tb_region_allocator_malloc(self, size __tb_debug_args__);
+
+    // the data head
+    tb_pool_data_head_t* data_head = &(((tb_pool_data_head_t*)data)[-1]);
+    tb_assertf(data_head->debug.magic == TB_POOL_DATA_MAGIC, "ralloc invalid data: %p", data);
+
+    // the old size
+    tb_size_t osize = data_head->size;
+
+    // the last data? resize it in the current chunk directly
+    if ((tb_byte_t*)data_head == allocator->last)
+    {
+        tb_byte_t* pos = (tb_byte_t*)data_head + tb_align(sizeof(tb_pool_data_head_t) + size, TB_POOL_DATA_ALIGN);
+        if (pos <= allocator->end)
+        {
+#ifdef __tb_debug__
+            // update the used size
+            allocator->used_size -= allocator->pos - (tb_byte_t*)data_head;
+            allocator->used_size += pos - (tb_byte_t*)data_head;
+#endif
+
+            // update size
+            allocator->pos  = pos;
+            data_head->size = size;
+            return data;
+        }
+    }
+    // the smaller size? update size only
+    else if (size <= osize)
+    {
+        data_head->size = size;
+        return data;
+    }
+
+    // make the new data
+    tb_pointer_t data_new = tb_region_allocator_malloc(self, size __tb_debug_args__);
+    tb_assert_and_check_return_val(data_new, tb_null);
+
+    // copy the old data, the old data will be freed with this region
+    tb_memcpy_(data_new, data, tb_min(osize, size));
+
+    // ok
+    return data_new;
+}
+static tb_bool_t tb_region_allocator_free(tb_allocator_ref_t self, tb_pointer_t data __tb_debug_decl__)
+{
+    // check
+    tb_region_allocator_ref_t allocator = (tb_region_allocator_ref_t)self;
+    tb_assert_and_check_return_val(allocator && data, tb_false);
+
+    // the data head
+    tb_pool_data_head_t* data_head = &(((tb_pool_data_head_t*)data)[-1]);
+    tb_assertf(data_head->debug.magic == TB_POOL_DATA_MAGIC, "free invalid data: %p", data);
+
+    // the last data? reclaim it, otherwise we do nothing and it will be freed with this region
+    if ((tb_byte_t*)data_head == allocator->last)
+    {
+#ifdef __tb_debug__
+        // update the used size
+        allocator->used_size -= allocator->pos - (tb_byte_t*)data_head;
+#endif
+
+        // reclaim it
+        allocator->pos  = (tb_byte_t*)data_head;
+        allocator->last = tb_null;
+    }
+
+#ifdef __tb_debug__
+    // mark it as freed
+    data_head->debug.magic = (tb_uint16_t)~TB_POOL_DATA_MAGIC;
+#endif
+
+    // ok
+    return tb_true;
+}
+static tb_void_t tb_region_allocator_clear(tb_allocator_ref_t self)
+{
+    // check
+    tb_region_allocator_ref_t allocator = (tb_region_allocator_ref_t)self;
+    tb_assert_and_check_return(allocator);
+
+    // keep the current chunk for reusing it if it is not a single large chunk
+    tb_region_allocator_chunk_t* chunk = allocator->chunks;
+    tb_region_allocator_chunk_t* keep = (chunk && (tb_byte_t*)chunk + chunk->size == allocator->end)? chunk : tb_null;
+    if (keep) chunk = chunk->next;
+
+    // free all other chunks
+    while (chunk)
+    {
+        tb_region_allocator_chunk_t* next = chunk->next;
+        tb_region_allocator_chunk_exit(allocator, chunk);
+        chunk = next;
+    }
+
+    // reset the current chunk
+    allocator->chunks   = keep;
+    allocator->pos      = keep? (tb_byte_t*)keep + TB_REGION_ALLOCATOR_CHUNK_HEAD_SIZE : tb_null;
+    allocator->end      = keep? (tb_byte_t*)keep + keep->size : tb_null;
+    allocator->last     = tb_null;
+    if (keep) keep->next = tb_null;
+
+#ifdef __tb_debug__
+    // reset the used size
+    allocator->used_size = 0;
+#endif
+}
+static tb_void_t tb_region_allocator_exit(tb_allocator_ref_t self)
+{
+    // check
+    tb_region_allocator_ref_t allocator = (tb_region_allocator_ref_t)self;
+    tb_assert_and_check_return(allocator && allocator->large_allocator);
+
+    // enter
+    tb_spinlock_enter(&allocator->base.lock);
+
+    // free all chunks
+    tb_region_allocator_chunk_t* chunk = allocator->chunks;
+    while (chunk)
+    {
+        tb_region_allocator_chunk_t* next = chunk->next;
+        tb_region_allocator_chunk_exit(allocator, chunk);
+        chunk = next;
+    }
+    allocator->chunks = tb_null;
+
+    // leave
+    tb_spinlock_leave(&allocator->base.lock);
+
+    // exit lock
+    tb_spinlock_exit(&allocator->base.lock);
+
+    // exit it
+    tb_allocator_large_free(allocator->large_allocator, allocator);
+}
+#ifdef __tb_debug__
+static tb_void_t tb_region_allocator_dump(tb_allocator_ref_t self)
+{
+    // check
+    tb_region_allocator_ref_t allocator = (tb_region_allocator_ref_t)self;
+    tb_assert_and_check_return(allocator);
+
+    // trace
+    tb_trace_i("");
+    tb_trace_i("chunk_size: %lu", allocator->chunk_size);
+    tb_trace_i("chunk_count: %lu", allocator->chunk_count);
+    tb_trace_i("malloc_count: %lu", allocator->malloc_count);
+    tb_trace_i("used_size: %lu", allocator->used_size);
+}
+static tb_bool_t tb_region_allocator_have(tb_allocator_ref_t self, tb_cpointer_t data)
+{
+    // check
+    tb_region_allocator_ref_t allocator = (tb_region_allocator_ref_t)self;
+    tb_assert_and_check_return_val(allocator, tb_false);
+
+    // find the chunk of this data
+    tb_region_allocator_chunk_t* chunk = allocator->chunks;
+    for (; chunk; chunk = chunk->next)
+    {
+        if ((tb_byte_t const*)data > (tb_byte_t const*)chunk && (tb_byte_t const*)data < (tb_byte_t const*)chunk + chunk->size)
+            return tb_true;
+    }
+
+    // no
+    return tb_false;
+}
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_allocator_ref_t tb_region_allocator_init(tb_allocator_ref_t large_allocator, tb_size_t chunk_size)
+{
+    // done
+    tb_bool_t                   ok = tb_false;
+    tb_region_allocator_ref_t   allocator = tb_null;
+    do
+    {
+        // no allocator? uses the global allocator
+        if (!large_allocator) large_allocator = tb_allocator();
+        tb_assert_and_check_break(large_allocator);
+
+        // make allocator
+        allocator = (tb_region_allocator_ref_t)tb_allocator_large_malloc0(large_allocator, sizeof(tb_region_allocator_t), tb_null);
+        tb_assert_and_check_break(allocator);
+
+        // init allocator
+        allocator->large_allocator      = large_allocator;
+        allocator->chunk_size           = tb_max(chunk_size? chunk_size : TB_REGION_ALLOCATOR_CHUNK_SIZE, TB_REGION_ALLOCATOR_CHUNK_HEAD_SIZE + 256);
+
+        // init base
+        allocator->base.type            = TB_ALLOCATOR_REGION;
+        allocator->base.malloc          = tb_region_allocator_malloc;
+        allocator->base.ralloc          = tb_region_allocator_ralloc;
+        allocator->base.free            = tb_region_allocator_free;
+        allocator->base.clear           = tb_region_allocator_clear;
+        allocator->base.exit            = tb_region_allocator_exit;
+#ifdef __tb_debug__
+        allocator->base.dump            = tb_region_allocator_dump;
+        allocator->base.have            = tb_region_allocator_have;
+#endif
+
+        // init lock
+        if (!tb_spinlock_init(&allocator->base.lock)) break;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        if (allocator) tb_region_allocator_exit((tb_allocator_ref_t)allocator);
+        allocator = tb_null;
+    }
+
+    // ok?
+    return (tb_allocator_ref_t)allocator;
+}
@@ -0,0 +1,101 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        region_allocator.h
+ * @ingroup     memory
+ *
+ */
+#ifndef TB_MEMORY_REGION_ALLOCATOR_H
+#define TB_MEMORY_REGION_ALLOCATOR_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "allocator.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init the region allocator
+ *
+ * <pre>
+ *
+ *  ---------------------------------------------------------------
+ * |                        large allocator                        |
+ *  ---------------------------------------------------------------
+ *             |                     |                     |
+ *  ---------------------  ---------------------  ---------------------
+ * | chunk: data0 data1 .. | chunk: data2 data3 .. | chunk: data4 .. ->  | <= pos
+ *  ---------------------  ---------------------  ---------------------
+ *             |                     |                     |
+ *  ---------------------------------------------------------------
+ * |                        region allocator                       |
+ *  ---------------------------------------------------------------
+ *
+ * </pre>
+ *
+ * the data will be allocated by moving the position of the current chunk, 
+ * and a new chunk will be allocated from the large allocator if the current chunk is full.
+ *
+ * tb_allocator_free() does nothing (only the last data will be reclaimed), 
+ * all data will be freed at once by tb_allocator_clear() or tb_allocator_exit().
+ *
+ * it is suitable for making many small objects with the same lifetime, e.g. parsing one request.
+ *
+ * @code
+ 
+    // init region allocator
+    tb_allocator_ref_t region = tb_region_allocator_init(tb_null, 0);
+    if (region)
+    {
+        // make data for parsing request
+        tb_pointer_t data0 = tb_allocator_malloc(region, 16);
+        tb_pointer_t data1 = tb_allocator_malloc(region, 32);
+        // ...
+
+        // free all data of this request at once
+        tb_allocator_clear(region);
+
+        // exit region allocator
+        tb_allocator_exit(region);
+    }
+ * @endcode
+ *
+ * @param large_allocator   the large allocator for the chunks, uses the global allocator if be null
+ * @param chunk_size        the chunk size, uses the default size if be zero
+ *
+ * @return                  the allocator 
+ */
+tb_allocator_ref_t          tb_region_allocator_init(tb_allocator_ref_t large_allocator, tb_size_t chunk_size);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -60,6 +60,7 @@ typedef struct __tb_small_allocator_t
  * declaration
  */
 __tb_extern_c__ tb_fixed_pool_ref_t tb_fixed_pool_init_(tb_allocator_ref_t large_allocator, tb_size_t slot_size, tb_size_t item_size, tb_bool_t for_small_allocator, tb_fixed_pool_item_init_func_t item_init, tb_fixed_pool_item_exit_func_t item_exit, tb_cpointer_t priv);
+__tb_extern_c__ tb_void_t           tb_fixed_pool_stat_(tb_fixed_pool_ref_t pool, tb_allocator_class_stat_ref_t stat);
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
@@ -382,6 +383,29 @@ static tb_bool_t tb_small_allocator_free(tb_allocator_ref_t self, tb_pointer_t d
     // ok?
     return ok;
 }
+static tb_bool_t tb_small_allocator_stat(tb_allocator_ref_t self, tb_allocator_stat_ref_t stat)
+{
+    // check
+    tb_small_allocator_ref_t allocator = (tb_small_allocator_ref_t)self;
+    tb_assert_and_check_return_val(allocator && stat, tb_false);
+
+    // the item sizes of all fixed pools
+    static tb_uint16_t const s_sizes[] = {16, 32, 64, 96, 128, 192, 256, 384, 512, 1024, 2048, 3072};
+    tb_assert_static(tb_arrayn(s_sizes) == tb_arrayn(allocator->fixed_pool));
+
+    // get the stat of all fixed pools, the fixed pool may be not created
+    tb_size_t i = 0;
+    tb_size_t n = tb_arrayn(allocator->fixed_pool);
+    for (i = 0; i < n && stat->class_count < tb_arrayn(stat->classes); i++)
+    {
+        tb_allocator_class_stat_ref_t cstat = &stat->classes[stat->class_count++];
+        if (allocator->fixed_pool[i]) tb_fixed_pool_stat_(allocator->fixed_pool[i], cstat);
+        else cstat->item_size = s_sizes[i];
+    }
+
+    // ok
+    return tb_true;
+}
 #ifdef __tb_debug__
 static tb_void_t tb_small_allocator_dump(tb_allocator_ref_t self)
 {
@@ -446,6 +470,7 @@ tb_allocator_ref_t tb_small_allocator_init(tb_allocator_ref_t large_allocator)
         allocator->base.free            = tb_small_allocator_free;
         allocator->base.clear           = tb_small_allocator_clear;
         allocator->base.exit            = tb_small_allocator_exit;
+        allocator->base.stat            = tb_small_allocator_stat;
 #ifdef __tb_debug__
         allocator->base.dump            = tb_small_allocator_dump;
         allocator->base.have            = tb_small_allocator_have;
@@ -470,3 +495,68 @@ tb_allocator_ref_t tb_small_allocator_init(tb_allocator_ref_t large_allocator)
     return (tb_allocator_ref_t)allocator;
 }
 
+tb_size_t tb_small_allocator_malloc_list(tb_allocator_ref_t self, tb_size_t space, tb_size_t count, tb_pointer_t* plist)
+{
+    // check
+    tb_small_allocator_ref_t allocator = (tb_small_allocator_ref_t)self;
+    tb_assert_and_check_return_val(allocator && space && space <= TB_SMALL_ALLOCATOR_DATA_MAXN && plist, 0);
+
+    // enter
+    tb_spinlock_enter(&allocator->base.lock);
+
+    // make the given count of items from the same fixed pool at once
+    tb_size_t       i = 0;
+    tb_pointer_t    list = tb_null;
+    do
+    {
+        // the fixed pool
+        tb_fixed_pool_ref_t fixed_pool = tb_small_allocator_find_fixed(allocator, space);
+        tb_assert_and_check_break(fixed_pool);
+
+        // make items and link them by the first pointer of data
+        for (i = 0; i < count; i++)
+        {
+            tb_pointer_t data = tb_fixed_pool_malloc_(fixed_pool __tb_debug_vals__);
+            tb_check_break(data);
+
+            *((tb_pointer_t*)data) = list;
+            list = data;
+        }
+
+    } while (0);
+
+    // leave
+    tb_spinlock_leave(&allocator->base.lock);
+
+    // ok
+    *plist = list;
+    return i;
+}
+tb_void_t tb_small_allocator_free_list(tb_allocator_ref_t self, tb_size_t space, tb_pointer_t list, tb_size_t count)
+{
+    // check
+    tb_small_allocator_ref_t allocator = (tb_small_allocator_ref_t)self;
+    tb_assert_and_check_return(allocator && space && space <= TB_SMALL_ALLOCATOR_DATA_MAXN);
+
+    // enter
+    tb_spinlock_enter(&allocator->base.lock);
+
+    // the fixed pool
+    tb_fixed_pool_ref_t fixed_pool = tb_small_allocator_find_fixed(allocator, space);
+    if (fixed_pool)
+    {
+        // free the given count of linked items
+        while (list && count--)
+        {
+            // get the next item first, the data will be overwritten after freeing it
+            tb_pointer_t next = *((tb_pointer_t*)list);
+
+            // free it
+            tb_fixed_pool_free_(fixed_pool, list __tb_debug_vals__);
+            list = next;
+        }
+    }
+
+    // leave
+    tb_spinlock_leave(&allocator->base.lock);
+}
@@ -38,24 +38,279 @@
 #include "../libc/libc.h"
 #include "../utils/utils.h"
 #include "../platform/platform.h"
-#include "../container/container.h"
-#include "../algorithm/algorithm.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the shards count, must be power of 2
+#ifdef __tb_small__
+#   define TB_STRING_POOL_SHARD_MAXN            (8)
+#else
+#   define TB_STRING_POOL_SHARD_MAXN            (32)
+#endif
+
+// the initial buckets count of each shard, must be power of 2
+#define TB_STRING_POOL_BUCKET_INIT              (64)
+
+// the size class align of the small entries
+#define TB_STRING_POOL_CLASS_ALIGN              (16)
+
+// the size classes count of the small entries, the larger entries will be allocated from the heap
+#define TB_STRING_POOL_CLASS_MAXN               (16)
+
+// the arena chunk size
+#ifdef __tb_small__
+#   define TB_STRING_POOL_CHUNK_SIZE            (4096)
+#else
+#   define TB_STRING_POOL_CHUNK_SIZE            (16384)
+#endif
+
+// the entry of the interned string
+#define tb_string_pool_entry(data)              ((tb_string_pool_entry_t*)(data) - 1)
+
+// the shard index of the given hash, uses the high bits because the bucket index uses the low bits
+#define tb_string_pool_shard_index(hash)        ((tb_size_t)(((tb_uint32_t)(hash) * 2654435761u) >> 16) & (TB_STRING_POOL_SHARD_MAXN - 1))
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
 
+// the string pool entry type, the string data follows it
+typedef struct __tb_string_pool_entry_t
+{
+    // the next entry in the bucket or free list
+    struct __tb_string_pool_entry_t*    next;
+
+    // the hash
+    tb_size_t                           hash;
+
+    // the reference count
+    tb_uint32_t                         refn;
+
+    // the string size, not including '\0'
+    tb_uint32_t                         size;
+
+    // the size class index, it is allocated from the heap if be TB_STRING_POOL_CLASS_MAXN
+    tb_uint32_t                         klass;
+
+}tb_string_pool_entry_t;
+
+// the string pool shard type
+typedef struct __tb_string_pool_shard_t
+{
+    // the lock
+    tb_spinlock_t                       lock;
+
+    // the buckets
+    tb_string_pool_entry_t**            buckets;
+
+    // the buckets count
+    tb_size_t                           bucket_size;
+
+    // the entries count
+    tb_size_t                           count;
+
+    // the arena of the small entries
+    tb_allocator_ref_t                  arena;
+
+    // the free entries of each size class
+    tb_string_pool_entry_t*             frees[TB_STRING_POOL_CLASS_MAXN];
+
+    // padding for avoiding the false sharing
+    tb_byte_t                           padding[TB_SMP_CACHE_BYTES];
+
+}tb_string_pool_shard_t;
+
 // the string pool type
 typedef struct __tb_string_pool_t
 {
-    // the cache
-    tb_hash_map_ref_t           cache;
+    // is case?
+    tb_bool_t                           bcase;
+
+    // the shards
+    tb_string_pool_shard_t              shards[TB_STRING_POOL_SHARD_MAXN];
 
 }tb_string_pool_t;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_handle_t tb_string_pool_instance_init(tb_cpointer_t* ppriv)
+{
+    return (tb_handle_t)tb_string_pool_init(tb_true);
+}
+static tb_void_t tb_string_pool_instance_exit(tb_handle_t pool, tb_cpointer_t priv)
+{
+    tb_string_pool_exit((tb_string_pool_ref_t)pool);
+}
+static tb_size_t tb_string_pool_hash_make(tb_char_t const* data, tb_bool_t bcase, tb_size_t* psize)
+{
+    // make the bkdr hash (including '\0'), it is same as tb_bkdr_make_from_cstr() if the pool is case sensitive
+    tb_size_t           hash = 0;
+    tb_char_t const*    p = data;
+    if (bcase) while (*p) hash = (hash * 131313) + (tb_byte_t)*p++;
+    else while (*p) hash = (hash * 131313) + (tb_byte_t)tb_tolower(*p++);
+    hash = hash * 131313;
+
+    // save size
+    *psize = p - data;
+    return hash;
+}
+static tb_bool_t tb_string_pool_shard_init(tb_string_pool_shard_t* shard)
+{
+    // check
+    tb_assert(shard);
+
+    // init lock
+    if (!tb_spinlock_init(&shard->lock)) return tb_false;
+
+    // init buckets
+    shard->bucket_size = TB_STRING_POOL_BUCKET_INIT;
+    shard->buckets = tb_nalloc0_type(shard->bucket_size, tb_string_pool_entry_t*);
+    tb_assert_and_check_return_val(shard->buckets, tb_false);
+
+    // init arena
+    shard->arena = tb_region_allocator_init(tb_null, TB_STRING_POOL_CHUNK_SIZE);
+    tb_assert_and_check_return_val(shard->arena, tb_false);
+
+    // ok
+    return tb_true;
+}
+static tb_void_t tb_string_pool_shard_clear(tb_string_pool_shard_t* shard)
+{
+    // check
+    tb_assert(shard);
+
+    // free the large entries
+    if (shard->buckets)
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < shard->bucket_size; i++)
+        {
+            tb_string_pool_entry_t* entry = shard->buckets[i];
+            while (entry)
+            {
+                tb_string_pool_entry_t* next = entry->next;
+                if (entry->klass == TB_STRING_POOL_CLASS_MAXN) tb_free(entry);
+                entry = next;
+            }
+            shard->buckets[i] = tb_null;
+        }
+    }
+
+    // clear the arena and the free entries
+    if (shard->arena) tb_allocator_clear(shard->arena);
+    tb_memset(shard->frees, 0, sizeof(shard->frees));
+    shard->count = 0;
+}
+static tb_void_t tb_string_pool_shard_exit(tb_string_pool_shard_t* shard)
+{
+    // check
+    tb_assert(shard);
+
+    // clear it
+    tb_string_pool_shard_clear(shard);
+
+    // exit buckets
+    if (shard->buckets) tb_free(shard->buckets);
+    shard->buckets = tb_null;
+
+    // exit arena
+    if (shard->arena) tb_allocator_exit(shard->arena);
+    shard->arena = tb_null;
+
+    // exit lock
+    tb_spinlock_exit(&shard->lock);
+}
+static tb_void_t tb_string_pool_shard_grow(tb_string_pool_shard_t* shard)
+{
+    // check
+    tb_assert(shard && shard->buckets && shard->bucket_size);
+
+    // make the new buckets
+    tb_size_t                   bucket_size = shard->bucket_size << 1;
+    tb_string_pool_entry_t**    buckets = tb_nalloc0_type(bucket_size, tb_string_pool_entry_t*);
+    tb_check_return(buckets);
+
+    // move the entries to the new buckets
+    tb_size_t i = 0;
+    for (i = 0; i < shard->bucket_size; i++)
+    {
+        tb_string_pool_entry_t* entry = shard->buckets[i];
+        while (entry)
+        {
+            tb_string_pool_entry_t* next = entry->next;
+            tb_size_t               index = entry->hash & (bucket_size - 1);
+            entry->next = buckets[index];
+            buckets[index] = entry;
+            entry = next;
+        }
+    }
+
+    // update buckets
+    tb_free(shard->buckets);
+    shard->buckets      = buckets;
+    shard->bucket_size  = bucket_size;
+}
+static tb_string_pool_entry_t** tb_string_pool_shard_find(tb_string_pool_shard_t* shard, tb_char_t const* data, tb_size_t size, tb_size_t hash, tb_bool_t bcase)
+{
+    // check
+    tb_assert(shard && shard->buckets);
+
+    // find the entry, the compared hash and size will skip the most different strings
+    tb_string_pool_entry_t** pentry = &shard->buckets[hash & (shard->bucket_size - 1)];
+    while (*pentry)
+    {
+        tb_string_pool_entry_t* entry = *pentry;
+        if (    entry->hash == hash 
+            &&  entry->size == size
+            &&  !(bcase? tb_memcmp(entry + 1, data, size) : tb_strnicmp((tb_char_t const*)(entry + 1), data, size)))
+            break;
+        pentry = &entry->next;
+    }
+
+    // the entry pointer, *pentry is null if not found
+    return pentry;
+}
+static tb_string_pool_entry_t* tb_string_pool_shard_entry_make(tb_string_pool_shard_t* shard, tb_size_t size)
+{
+    // check
+    tb_assert(shard && shard->arena);
+
+    // the entry space
+    tb_size_t space = tb_align(sizeof(tb_string_pool_entry_t) + size + 1, TB_STRING_POOL_CLASS_ALIGN);
+
+    // the size class
+    tb_size_t               klass = space / TB_STRING_POOL_CLASS_ALIGN - 1;
+    tb_string_pool_entry_t* entry = tb_null;
+    if (klass < TB_STRING_POOL_CLASS_MAXN)
+    {
+        // reuse the free entry first, otherwise make it from the arena
+        entry = shard->frees[klass];
+        if (entry) shard->frees[klass] = entry->next;
+        else entry = (tb_string_pool_entry_t*)tb_allocator_malloc(shard->arena, space);
+    }
+    // make the large entry from the heap
+    else 
+    {
+        klass = TB_STRING_POOL_CLASS_MAXN;
+        entry = (tb_string_pool_entry_t*)tb_malloc(space);
+    }
+    tb_assert_and_check_return_val(entry, tb_null);
+
+    // init it
+    entry->klass = (tb_uint32_t)klass;
+    return entry;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
+tb_string_pool_ref_t tb_string_pool()
+{
+    return (tb_string_pool_ref_t)tb_singleton_instance(TB_SINGLETON_TYPE_STRING_POOL, tb_string_pool_instance_init, tb_string_pool_instance_exit, tb_null, tb_null);
+}
 tb_string_pool_ref_t tb_string_pool_init(tb_bool_t bcase)
 {
     // done
@@ -67,9 +322,16 @@ tb_string_pool_ref_t tb_string_pool_init(tb_bool_t bcase)
         pool = tb_malloc0_type(tb_string_pool_t);
         tb_assert_and_check_break(pool);
 
-        // init hash
-        pool->cache = tb_hash_map_init(0, tb_element_str(bcase), tb_element_size());
-        tb_assert_and_check_break(pool->cache);
+        // init pool
+        pool->bcase = bcase;
+
+        // init shards
+        tb_size_t i = 0;
+        for (i = 0; i < TB_STRING_POOL_SHARD_MAXN; i++)
+        {
+            if (!tb_string_pool_shard_init(&pool->shards[i])) break;
+        }
+        tb_assert_and_check_break(i == TB_STRING_POOL_SHARD_MAXN);
 
         // ok
         ok = tb_true;
@@ -93,9 +355,10 @@ tb_void_t tb_string_pool_exit(tb_string_pool_ref_t self)
     tb_string_pool_t* pool = (tb_string_pool_t*)self;
     tb_assert_and_check_return(pool);
 
-    // exit cache
-    if (pool->cache) tb_hash_map_exit(pool->cache);
-    pool->cache = tb_null;
+    // exit shards
+    tb_size_t i = 0;
+    for (i = 0; i < TB_STRING_POOL_SHARD_MAXN; i++)
+        tb_string_pool_shard_exit(&pool->shards[i]);
 
     // exit it
     tb_free(pool);
@@ -106,8 +369,15 @@ tb_void_t tb_string_pool_clear(tb_string_pool_ref_t self)
     tb_string_pool_t* pool = (tb_string_pool_t*)self;
     tb_assert_and_check_return(pool);
 
-    // clear cache
-    if (pool->cache) tb_hash_map_clear(pool->cache);
+    // clear shards
+    tb_size_t i = 0;
+    for (i = 0; i < TB_STRING_POOL_SHARD_MAXN; i++)
+    {
+        tb_string_pool_shard_t* shard = &pool->shards[i];
+        tb_spinlock_enter(&shard->lock);
+        tb_string_pool_shard_clear(shard);
+        tb_spinlock_leave(&shard->lock);
+    }
 }
 tb_char_t const* tb_string_pool_insert(tb_string_pool_ref_t self, tb_char_t const* data)
 {
@@ -115,47 +385,52 @@ tb_char_t const* tb_string_pool_insert(tb_string_pool_ref_t self, tb_char_t cons
     tb_string_pool_t* pool = (tb_string_pool_t*)self;
     tb_assert_and_check_return_val(pool && data, tb_null);
 
+    // make hash 
+    tb_size_t size = 0;
+    tb_size_t hash = tb_string_pool_hash_make(data, pool->bcase, &size);
+    tb_assert_and_check_return_val(size <= TB_MAXU32, tb_null);
+
+    // enter
+    tb_string_pool_shard_t* shard = &pool->shards[tb_string_pool_shard_index(hash)];
+    tb_spinlock_enter(&shard->lock);
+
     // done
-    tb_char_t const* cstr = tb_null;
-    if (pool->cache)
+    tb_string_pool_entry_t* entry = tb_null;
+    do
     {
-        // exists?
-        tb_size_t               itor;
-        tb_hash_map_item_ref_t  item = tb_null;
-        if (    ((itor = tb_hash_map_find(pool->cache, data)) != tb_iterator_tail(pool->cache))
-            &&  (item = (tb_hash_map_item_ref_t)tb_iterator_item(pool->cache, itor)))
+        // exists? refn++
+        entry = *tb_string_pool_shard_find(shard, data, size, hash, pool->bcase);
+        if (entry)
         {
-            // refn
-            tb_size_t refn = (tb_size_t)item->data;
+            entry->refn++;
+            break;
+        }
 
-            // refn++
-            if (refn) tb_iterator_copy(pool->cache, itor, (tb_pointer_t)(refn + 1));
-            // no refn? remove it
-            else
-            {
-                // assert
-                tb_assert(0);
+        // make entry
+        entry = tb_string_pool_shard_entry_make(shard, size);
+        tb_assert_and_check_break(entry);
 
-                // del it
-                tb_iterator_remove(pool->cache, itor);
-                item = tb_null;
-            }
-        }
-        
-        // no item? insert it
-        if (!item)
-        {
-            // insert it
-            if ((itor = tb_hash_map_insert(pool->cache, data, (tb_pointer_t)1)) != tb_iterator_tail(pool->cache))
-                item = (tb_hash_map_item_ref_t)tb_iterator_item(pool->cache, itor);
-        }
+        // init entry
+        entry->hash = hash;
+        entry->refn = 1;
+        entry->size = (tb_uint32_t)size;
+        tb_memcpy(entry + 1, data, size + 1);
 
-        // save the cstr
-        if (item) cstr = (tb_char_t const*)item->name;
-    }
+        // insert it to the bucket
+        tb_size_t index = hash & (shard->bucket_size - 1);
+        entry->next = shard->buckets[index];
+        shard->buckets[index] = entry;
+
+        // grow buckets if the load factor is too large
+        if (++shard->count > shard->bucket_size) tb_string_pool_shard_grow(shard);
+
+    } while (0);
+
+    // leave
+    tb_spinlock_leave(&shard->lock);
 
     // ok?
-    return cstr;
+    return entry? (tb_char_t const*)(entry + 1) : tb_null;
 }
 tb_void_t tb_string_pool_remove(tb_string_pool_ref_t self, tb_char_t const* data)
 {
@@ -163,37 +438,84 @@ tb_void_t tb_string_pool_remove(tb_string_pool_ref_t self, tb_char_t const* data
     tb_string_pool_t* pool = (tb_string_pool_t*)self;
     tb_assert_and_check_return(pool && data);
 
-    // done
-    tb_hash_map_item_ref_t item = tb_null;
-    if (pool->cache)
+    // make hash 
+    tb_size_t size = 0;
+    tb_size_t hash = tb_string_pool_hash_make(data, pool->bcase, &size);
+
+    // enter
+    tb_string_pool_shard_t* shard = &pool->shards[tb_string_pool_shard_index(hash)];
+    tb_spinlock_enter(&shard->lock);
+
+    // exists? refn--
+    tb_string_pool_entry_t* entry_large = tb_null;
+    tb_string_pool_entry_t** pentry = tb_string_pool_shard_find(shard, data, size, hash, pool->bcase);
+    tb_string_pool_entry_t* entry = *pentry;
+    if (entry && !--entry->refn)
     {
-        // exists?
-        tb_size_t itor;
-        if (    ((itor = tb_hash_map_find(pool->cache, data)) != tb_iterator_tail(pool->cache))
-            &&  (item = (tb_hash_map_item_ref_t)tb_iterator_item(pool->cache, itor)))
-        {
-            // refn
-            tb_size_t refn = (tb_size_t)item->data;
+        // remove it from the bucket
+        *pentry = entry->next;
+        shard->count--;
 
-            // refn--
-            if (refn > 1) tb_iterator_copy(pool->cache, itor, (tb_pointer_t)(refn - 1));
-            // del it
-            else tb_iterator_remove(pool->cache, itor);
+        // free it later if it is large, otherwise reuse it for the next inserting
+        if (entry->klass == TB_STRING_POOL_CLASS_MAXN) entry_large = entry;
+        else
+        {
+            entry->next = shard->frees[entry->klass];
+            shard->frees[entry->klass] = entry;
         }
     }
+
+    // leave
+    tb_spinlock_leave(&shard->lock);
+
+    // free the large entry
+    if (entry_large) tb_free(entry_large);
+}
+tb_size_t tb_string_pool_hash(tb_char_t const* data)
+{
+    // check
+    tb_assert_and_check_return_val(data, 0);
+
+    // the hash
+    return tb_string_pool_entry(data)->hash;
+}
+tb_size_t tb_string_pool_size(tb_char_t const* data)
+{
+    // check
+    tb_assert_and_check_return_val(data, 0);
+
+    // the size
+    return tb_string_pool_entry(data)->size;
 }
 #ifdef __tb_debug__
 tb_void_t tb_string_pool_dump(tb_string_pool_ref_t self)
 {
     // check
     tb_string_pool_t* pool = (tb_string_pool_t*)self;
-    tb_assert_and_check_return(pool && pool->cache);
+    tb_assert_and_check_return(pool);
 
-    // dump cache
-    tb_for_all_if (tb_hash_map_item_ref_t, item, pool->cache, item)
+    // dump shards
+    tb_size_t i = 0;
+    for (i = 0; i < TB_STRING_POOL_SHARD_MAXN; i++)
     {
+        // enter
+        tb_string_pool_shard_t* shard = &pool->shards[i];
+        tb_spinlock_enter(&shard->lock);
+
         // trace
-        tb_trace_i("item: refn: %lu, cstr: %s", (tb_size_t)item->data, item->name);
+        tb_trace_i("shard[%lu]: count: %lu, buckets: %lu", i, shard->count, shard->bucket_size);
+
+        // dump entries
+        tb_size_t j = 0;
+        for (j = 0; j < shard->bucket_size; j++)
+        {
+            tb_string_pool_entry_t* entry = shard->buckets[j];
+            for (; entry; entry = entry->next)
+                tb_trace_i("    item: refn: %u, cstr: %s", entry->refn, (tb_char_t const*)(entry + 1));
+        }
+
+        // leave
+        tb_spinlock_leave(&shard->lock);
     }
 }
 #endif
@@ -40,17 +40,42 @@ __tb_extern_c_enter__
  * types
  */
 
-/// the string pool ref type
+/*! the string pool ref type
+ *
+ * <pre>
+ *
+ * shards: | shard0 | shard1 | ... | shardN |    (lock striping, one spinlock per shard)
+ *              |
+ *           buckets: | entry | entry | ...
+ *                        |
+ *                      entry: | hash | refn | size | "string\0" |  (arena chunks)
+ *
+ * </pre>
+ *
+ * the string is placed into the shard by its hash, so the different strings can be interned in parallel.
+ *
+ * the string data of the small entries are stored in the arena chunks of each shard,
+ * and the removed entries will be reused by the new strings with the same size class,
+ * so the pool only grows to the peak of the interned strings.
+ */
 typedef __tb_typeref__(string_pool);
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
 
+/*! the global string pool instance (case sensitive)
+ *
+ * @return                  the string pool
+ */
+tb_string_pool_ref_t        tb_string_pool(tb_noarg_t);
+
 /*! init string pool for small, readonly and repeat strings
  *
  * readonly, strip repeat strings and decrease memory fragmens
  *
+ * @note it is thread-safe, the strings can be inserted and removed from multiple threads
+ *
  * @param bcase             is case?
  *
  * @return                  the string pool
@@ -64,6 +89,8 @@ tb_string_pool_ref_t        tb_string_pool_init(tb_bool_t bcase);
 tb_void_t                   tb_string_pool_exit(tb_string_pool_ref_t pool);
 
 /*! clear the string pool
+ *
+ * @note all interned strings will be invalid
  *
  * @param pool              the string pool
  */
@@ -74,7 +101,7 @@ tb_void_t                   tb_string_pool_clear(tb_string_pool_ref_t pool);
  * @param pool              the string pool
  * @param data              the string data
  *
- * @return                  the string data
+ * @return                  the interned string data, it is stable until it has been removed
  */
 tb_char_t const*            tb_string_pool_insert(tb_string_pool_ref_t pool, tb_char_t const* data);
 
@@ -85,6 +112,26 @@ tb_char_t const*            tb_string_pool_insert(tb_string_pool_ref_t pool, tb_
  */
 tb_void_t                   tb_string_pool_remove(tb_string_pool_ref_t pool, tb_char_t const* data);
 
+/*! get the precomputed hash of the interned string
+ *
+ * the hash is the bkdr hash of the string (lower case if the pool is not case sensitive),
+ * and the same strings from the same pool have the same address, 
+ * so the interned strings can be compared by the pointers, e.g. tb_element_istr()
+ *
+ * @param data              the interned string data returned by tb_string_pool_insert()
+ *
+ * @return                  the hash value
+ */
+tb_size_t                   tb_string_pool_hash(tb_char_t const* data);
+
+/*! get the size of the interned string
+ *
+ * @param data              the interned string data returned by tb_string_pool_insert()
+ *
+ * @return                  the string size
+ */
+tb_size_t                   tb_string_pool_size(tb_char_t const* data);
+
 #ifdef __tb_debug__
 /*! dump the string pool
  *
@@ -52,6 +52,9 @@ typedef struct __tb_oc_array_t
     // is increase refn?
     tb_bool_t           incr;
 
+    // the allocator
+    tb_allocator_ref_t  allocator;
+
 }tb_oc_array_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -72,7 +75,7 @@ static tb_object_ref_t tb_oc_array_copy(tb_object_ref_t object)
     tb_assert_and_check_return_val(array && array->vector, tb_null);
 
     // init copy
-    tb_oc_array_t* copy = (tb_oc_array_t*)tb_oc_array_init(tb_vector_grow(array->vector), array->incr);
+    tb_oc_array_t* copy = (tb_oc_array_t*)tb_oc_array_init_with_allocator(array->allocator, tb_vector_grow(array->vector), array->incr);
     tb_assert_and_check_return_val(copy && copy->vector, tb_null);
 
     // refn++
@@ -98,7 +101,7 @@ static tb_void_t tb_oc_array_exit(tb_object_ref_t object)
     array->vector = tb_null;
 
     // exit it
-    tb_free(array);
+    tb_allocator_free(array->allocator, array);
 }
 static tb_void_t tb_oc_array_clear(tb_object_ref_t object)
 {
@@ -108,7 +111,7 @@ static tb_void_t tb_oc_array_clear(tb_object_ref_t object)
     // clear vector
     tb_vector_clear(array->vector);
 }
-static tb_oc_array_t* tb_oc_array_init_base()
+static tb_oc_array_t* tb_oc_array_init_base(tb_allocator_ref_t allocator)
 {
     // done
     tb_bool_t       ok = tb_false;
@@ -116,9 +119,12 @@ static tb_oc_array_t* tb_oc_array_init_base()
     do
     {
         // make array
-        array = tb_malloc0_type(tb_oc_array_t);
+        array = (tb_oc_array_t*)tb_allocator_malloc0(allocator, sizeof(tb_oc_array_t));
         tb_assert_and_check_break(array);
 
+        // init allocator
+        array->allocator = allocator;
+
         // init array
         if (!tb_object_init((tb_object_ref_t)array, TB_OBJECT_FLAG_NONE, TB_OBJECT_TYPE_ARRAY)) break;
 
@@ -149,20 +155,27 @@ static tb_oc_array_t* tb_oc_array_init_base()
  */
 tb_object_ref_t tb_oc_array_init(tb_size_t grow, tb_bool_t incr)
 {
+    return tb_oc_array_init_with_allocator(tb_null, grow, incr);
+}
+tb_object_ref_t tb_oc_array_init_with_allocator(tb_allocator_ref_t allocator, tb_size_t grow, tb_bool_t incr)
+{
+    // uses the global allocator by default
+    if (!allocator) allocator = tb_allocator();
+
     // done
     tb_bool_t       ok = tb_false;
     tb_oc_array_t*  array = tb_null;
     do
     {
         // make array
-        array = tb_oc_array_init_base();
+        array = tb_oc_array_init_base(allocator);
         tb_assert_and_check_break(array);
 
         // init element
         tb_element_t element = tb_element_obj();
 
         // init vector
-        array->vector = tb_vector_init(grow, element);
+        array->vector = tb_vector_init_with_allocator(allocator, grow, element);
         tb_assert_and_check_break(array->vector);
 
         // init incr
@@ -49,6 +49,19 @@ __tb_extern_c_enter__
  */
 tb_object_ref_t     tb_oc_array_init(tb_size_t grow, tb_bool_t incr);
 
+/*! init array with the given allocator
+ *
+ * the array object and its vector will be allocated from this allocator,
+ * but the items are still the objects allocated from the global allocator.
+ *
+ * @param allocator the allocator, uses the global allocator if be null
+ * @param grow      the array grow
+ * @param incr      is increase refn?
+ *
+ * @return          the array object
+ */
+tb_object_ref_t     tb_oc_array_init_with_allocator(tb_allocator_ref_t allocator, tb_size_t grow, tb_bool_t incr);
+
 /*! the array size
  *
  * @param array     the array object
@@ -47,7 +47,10 @@ typedef struct __tb_oc_data_t
     tb_object_t     base;
 
     // the data buffer
-    tb_buffer_t     buffer;
+    tb_buffer_t         buffer;
+
+    // the allocator
+    tb_allocator_ref_t  allocator;
 
 }tb_oc_data_t;
 
@@ -64,7 +67,8 @@ static __tb_inline__ tb_oc_data_t* tb_oc_data_cast(tb_object_ref_t object)
 }
 static tb_object_ref_t tb_oc_data_copy(tb_object_ref_t object)
 {
-    return tb_oc_data_init_from_data(tb_oc_data_getp(object), tb_oc_data_size(object));
+    tb_oc_data_t* data = tb_oc_data_cast(object);
+    return data? tb_oc_data_init_with_allocator(data->allocator, tb_oc_data_getp(object), tb_oc_data_size(object)) : tb_null;
 }
 static tb_void_t tb_oc_data_exit(tb_object_ref_t object)
 {
@@ -72,7 +76,7 @@ static tb_void_t tb_oc_data_exit(tb_object_ref_t object)
     if (data) 
     {
         tb_buffer_exit(&data->buffer);
-        tb_free(data);
+        tb_allocator_free(data->allocator, data);
     }
 }
 static tb_void_t tb_oc_data_clear(tb_object_ref_t object)
@@ -80,7 +84,7 @@ static tb_void_t tb_oc_data_clear(tb_object_ref_t object)
     tb_oc_data_t* data = tb_oc_data_cast(object);
     if (data) tb_buffer_clear(&data->buffer);
 }
-static tb_oc_data_t* tb_oc_data_init_base()
+static tb_oc_data_t* tb_oc_data_init_base(tb_allocator_ref_t allocator)
 {
     // done
     tb_bool_t       ok = tb_false;
@@ -88,9 +92,12 @@ static tb_oc_data_t* tb_oc_data_init_base()
     do
     {
         // make data
-        data = tb_malloc0_type(tb_oc_data_t);
+        data = (tb_oc_data_t*)tb_allocator_malloc0(allocator, sizeof(tb_oc_data_t));
         tb_assert_and_check_break(data);
 
+        // init allocator
+        data->allocator = allocator;
+
         // init data
         if (!tb_object_init((tb_object_ref_t)data, TB_OBJECT_FLAG_NONE, TB_OBJECT_TYPE_DATA)) break;
 
@@ -153,12 +160,19 @@ tb_object_ref_t tb_oc_data_init_from_url(tb_char_t const* url)
 }
 tb_object_ref_t tb_oc_data_init_from_data(tb_pointer_t addr, tb_size_t size)
 {
+    return tb_oc_data_init_with_allocator(tb_null, addr, size);
+}
+tb_object_ref_t tb_oc_data_init_with_allocator(tb_allocator_ref_t allocator, tb_pointer_t addr, tb_size_t size)
+{
+    // uses the global allocator by default
+    if (!allocator) allocator = tb_allocator();
+
     // make
-    tb_oc_data_t* data = tb_oc_data_init_base();
+    tb_oc_data_t* data = tb_oc_data_init_base(allocator);
     tb_assert_and_check_return_val(data, tb_null);
 
     // init buffer
-    if (!tb_buffer_init(&data->buffer))
+    if (!tb_buffer_init_with_allocator(&data->buffer, allocator))
     {
         tb_oc_data_exit((tb_object_ref_t)data);
         return tb_null;
@@ -173,7 +187,7 @@ tb_object_ref_t tb_oc_data_init_from_data(tb_pointer_t addr, tb_size_t size)
 tb_object_ref_t tb_oc_data_init_from_buffer(tb_buffer_ref_t pbuf)
 {   
     // make
-    tb_oc_data_t* data = tb_oc_data_init_base();
+    tb_oc_data_t* data = tb_oc_data_init_base(tb_allocator());
     tb_assert_and_check_return_val(data, tb_null);
 
     // init buffer
@@ -58,6 +58,18 @@ tb_object_ref_t     tb_oc_data_init_from_url(tb_char_t const* url);
  */
 tb_object_ref_t     tb_oc_data_init_from_data(tb_pointer_t data, tb_size_t size);
 
+/*! init data from data with the given allocator
+ *
+ * the data object and its buffer will be allocated from this allocator
+ *
+ * @param allocator the allocator, uses the global allocator if be null
+ * @param data      the data
+ * @param size      the size
+ *
+ * @return          the data object
+ */
+tb_object_ref_t     tb_oc_data_init_with_allocator(tb_allocator_ref_t allocator, tb_pointer_t data, tb_size_t size);
+
 /*! init data from buffer
  *
  * @param buffer    the buffer
@@ -49,6 +49,9 @@ typedef struct __tb_oc_date_t
     // the date time
     tb_time_t           time;
 
+    // the allocator
+    tb_allocator_ref_t  allocator;
+
 }tb_oc_date_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -64,18 +67,20 @@ static __tb_inline__ tb_oc_date_t* tb_oc_date_cast(tb_object_ref_t object)
 }
 static tb_object_ref_t tb_oc_date_copy(tb_object_ref_t object)
 {
-    return tb_oc_date_init_from_time(tb_oc_date_time(object));
+    tb_oc_date_t* date = tb_oc_date_cast(object);
+    return date? tb_oc_date_init_with_allocator(date->allocator, tb_oc_date_time(object)) : tb_null;
 }
 static tb_void_t tb_oc_date_exit(tb_object_ref_t object)
 {
-    if (object) tb_free(object);
+    tb_oc_date_t* date = tb_oc_date_cast(object);
+    if (date) tb_allocator_free(date->allocator, date);
 }
 static tb_void_t tb_oc_date_clear(tb_object_ref_t object)
 {
     tb_oc_date_t* date = tb_oc_date_cast(object);
     if (date) date->time = 0;
 }
-static tb_oc_date_t* tb_oc_date_init_base()
+static tb_oc_date_t* tb_oc_date_init_base(tb_allocator_ref_t allocator)
 {
     // done
     tb_bool_t       ok = tb_false;
@@ -83,9 +88,12 @@ static tb_oc_date_t* tb_oc_date_init_base()
     do
     {
         // make date
-        date = tb_malloc0_type(tb_oc_date_t);
+        date = (tb_oc_date_t*)tb_allocator_malloc0(allocator, sizeof(tb_oc_date_t));
         tb_assert_and_check_break(date);
 
+        // init allocator
+        date->allocator = allocator;
+
         // init date
         if (!tb_object_init((tb_object_ref_t)date, TB_OBJECT_FLAG_NONE, TB_OBJECT_TYPE_DATE)) break;
 
@@ -116,7 +124,7 @@ static tb_oc_date_t* tb_oc_date_init_base()
 tb_object_ref_t tb_oc_date_init_from_now()
 {
     // make
-    tb_oc_date_t* date = tb_oc_date_init_base();
+    tb_oc_date_t* date = tb_oc_date_init_base(tb_allocator());
     tb_assert_and_check_return_val(date, tb_null);
 
     // init time
@@ -127,8 +135,15 @@ tb_object_ref_t tb_oc_date_init_from_now()
 }
 tb_object_ref_t tb_oc_date_init_from_time(tb_time_t time)
 {
+    return tb_oc_date_init_with_allocator(tb_null, time);
+}
+tb_object_ref_t tb_oc_date_init_with_allocator(tb_allocator_ref_t allocator, tb_time_t time)
+{
+    // uses the global allocator by default
+    if (!allocator) allocator = tb_allocator();
+
     // make
-    tb_oc_date_t* date = tb_oc_date_init_base();
+    tb_oc_date_t* date = tb_oc_date_init_base(allocator);
     tb_assert_and_check_return_val(date, tb_null);
 
     // init time
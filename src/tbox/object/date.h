@@ -54,6 +54,15 @@ tb_object_ref_t     tb_oc_date_init_from_now(tb_noarg_t);
  */
 tb_object_ref_t     tb_oc_date_init_from_time(tb_time_t time);
 
+/*! init date from time with the given allocator
+ *
+ * @param allocator the allocator, uses the global allocator if be null
+ * @param time      the date time
+ *
+ * @return          the date object
+ */
+tb_object_ref_t     tb_oc_date_init_with_allocator(tb_allocator_ref_t allocator, tb_time_t time);
+
 /*! the date time
  *
  * @param           the date object
@@ -65,6 +65,9 @@ typedef struct __tb_oc_dictionary_t
     // increase refn?
     tb_bool_t           incr;
 
+    // the allocator
+    tb_allocator_ref_t  allocator;
+
 }tb_oc_dictionary_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -85,7 +88,7 @@ static tb_object_ref_t tb_oc_dictionary_copy(tb_object_ref_t object)
     tb_assert_and_check_return_val(dictionary, tb_null);
 
     // init copy
-    tb_oc_dictionary_t* copy = (tb_oc_dictionary_t*)tb_oc_dictionary_init(dictionary->size, dictionary->incr);
+    tb_oc_dictionary_t* copy = (tb_oc_dictionary_t*)tb_oc_dictionary_init_with_allocator(dictionary->allocator, dictionary->size, dictionary->incr);
     tb_assert_and_check_return_val(copy, tb_null);
 
     // walk copy
@@ -115,7 +118,7 @@ static tb_void_t tb_oc_dictionary_exit(tb_object_ref_t object)
     dictionary->hash = tb_null;
 
     // exit it
-    tb_free(dictionary);
+    tb_allocator_free(dictionary->allocator, dictionary);
 }
 static tb_void_t tb_oc_dictionary_clear(tb_object_ref_t object)
 {
@@ -125,7 +128,7 @@ static tb_void_t tb_oc_dictionary_clear(tb_object_ref_t object)
     // clear
     if (dictionary->hash) tb_hash_map_clear(dictionary->hash);
 }
-static tb_oc_dictionary_t* tb_oc_dictionary_init_base()
+static tb_oc_dictionary_t* tb_oc_dictionary_init_base(tb_allocator_ref_t allocator)
 {
     // done
     tb_bool_t           ok = tb_false;
@@ -133,9 +136,12 @@ static tb_oc_dictionary_t* tb_oc_dictionary_init_base()
     do
     {
         // make dictionary
-        dictionary = tb_malloc0_type(tb_oc_dictionary_t);
+        dictionary = (tb_oc_dictionary_t*)tb_allocator_malloc0(allocator, sizeof(tb_oc_dictionary_t));
         tb_assert_and_check_break(dictionary);
 
+        // init allocator
+        dictionary->allocator = allocator;
+
         // init dictionary
         if (!tb_object_init((tb_object_ref_t)dictionary, TB_OBJECT_FLAG_NONE, TB_OBJECT_TYPE_DICTIONARY)) break;
 
@@ -166,24 +172,31 @@ static tb_oc_dictionary_t* tb_oc_dictionary_init_base()
  */
 tb_object_ref_t tb_oc_dictionary_init(tb_size_t size, tb_bool_t incr)
 {
+    return tb_oc_dictionary_init_with_allocator(tb_null, size, incr);
+}
+tb_object_ref_t tb_oc_dictionary_init_with_allocator(tb_allocator_ref_t allocator, tb_size_t size, tb_bool_t incr)
+{
+    // uses the global allocator by default
+    if (!allocator) allocator = tb_allocator();
+
     // done
     tb_bool_t           ok = tb_false;
     tb_oc_dictionary_t* dictionary = tb_null;
     do
     {
         // make dictionary
-        dictionary = tb_oc_dictionary_init_base();
+        dictionary = tb_oc_dictionary_init_base(allocator);
         tb_assert_and_check_break(dictionary);
 
-        // using the default size
-        if (!size) size = TB_OC_DICTIONARY_SIZE_DEFAULT;
+        // using the default size, the growing flag is kept
+        if (!(size & ~TB_OC_DICTIONARY_SIZE_GROW)) size |= TB_OC_DICTIONARY_SIZE_DEFAULT;
 
         // init
         dictionary->size = size;
         dictionary->incr = incr;
 
         // init hash
-        dictionary->hash = tb_hash_map_init(size, tb_element_str(tb_true), tb_element_obj());
+        dictionary->hash = tb_hash_map_init_with_allocator(allocator, size, tb_element_str(tb_true), tb_element_obj());
         tb_assert_and_check_break(dictionary->hash);
 
         // ok
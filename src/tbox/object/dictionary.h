@@ -30,6 +30,7 @@
  * includes
  */
 #include "prefix.h"
+#include "../container/hash_map.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
@@ -43,6 +44,9 @@ __tb_extern_c_enter__
 #define TB_OC_DICTIONARY_SIZE_SMALL                (256)
 #define TB_OC_DICTIONARY_SIZE_LARGE                (65536)
 
+/// the growing flag of the dictionary size, the dictionary will grow and rehash items incrementally
+#define TB_OC_DICTIONARY_SIZE_GROW                 TB_HASH_MAP_BUCKET_GROW
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -87,13 +91,26 @@ typedef struct __tb_oc_dictionary_item_t
     }
  * @endcode
  *
- * @param size          the dictionary size, using the default size if be zero
+ * @param size          the dictionary size, using the default size if be zero, or with TB_OC_DICTIONARY_SIZE_GROW for growing
  * @param incr          is increase refn?
  *
  * @return              the dictionary object
  */
 tb_object_ref_t         tb_oc_dictionary_init(tb_size_t size, tb_bool_t incr);
 
+/*! init dictionary with the given allocator
+ *
+ * the dictionary object, its hash map and the duplicated keys will be allocated from this allocator,
+ * but the values are still the objects allocated from the global allocator.
+ *
+ * @param allocator     the allocator, uses the global allocator if be null
+ * @param size          the dictionary size, using the default size if be zero, or with TB_OC_DICTIONARY_SIZE_GROW for growing
+ * @param incr          is increase refn?
+ *
+ * @return              the dictionary object
+ */
+tb_object_ref_t         tb_oc_dictionary_init_with_allocator(tb_allocator_ref_t allocator, tb_size_t size, tb_bool_t incr);
+
 /*! the dictionary size
  *
  * @param dictionary    the dictionary object
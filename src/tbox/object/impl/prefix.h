@@ -58,8 +58,8 @@ typedef struct __tb_oc_reader_t
     /// probe format
     tb_size_t                   (*probe)(tb_stream_ref_t stream);
 
-    /// read it
-    tb_object_ref_t          (*read)(tb_stream_ref_t stream);
+    /// read it, the objects are allocated from the given allocator or the global allocator if be null
+    tb_object_ref_t          (*read)(tb_stream_ref_t stream, tb_allocator_ref_t allocator);
 
 }tb_oc_reader_t;
 
@@ -64,7 +64,7 @@ static tb_object_ref_t tb_oc_bin_reader_func_date(tb_oc_bin_reader_t* reader, tb
     tb_assert_and_check_return_val(reader && reader->stream && reader->list, tb_null);
 
     // ok
-    return tb_oc_date_init_from_time((tb_time_t)size);
+    return tb_oc_date_init_with_allocator(reader->allocator, (tb_time_t)size);
 }
 static tb_object_ref_t tb_oc_bin_reader_func_data(tb_oc_bin_reader_t* reader, tb_size_t type, tb_uint64_t size)
 {
@@ -72,7 +72,7 @@ static tb_object_ref_t tb_oc_bin_reader_func_data(tb_oc_bin_reader_t* reader, tb
     tb_assert_and_check_return_val(reader && reader->stream && reader->list, tb_null);
 
     // empty?
-    if (!size) return tb_oc_data_init_from_data(tb_null, 0);
+    if (!size) return tb_oc_data_init_with_allocator(reader->allocator, tb_null, 0);
 
     // make data
     tb_char_t* data = tb_malloc0_cstr((tb_size_t)size);
@@ -94,7 +94,7 @@ static tb_object_ref_t tb_oc_bin_reader_func_data(tb_oc_bin_reader_t* reader, tb
     }
 
     // make the data object
-    tb_object_ref_t object = tb_oc_data_init_from_data(data, (tb_size_t)size); 
+    tb_object_ref_t object = tb_oc_data_init_with_allocator(reader->allocator, data, (tb_size_t)size); 
 
     // exit data
     tb_free(data);
@@ -108,10 +108,10 @@ static tb_object_ref_t tb_oc_bin_reader_func_array(tb_oc_bin_reader_t* reader, t
     tb_assert_and_check_return_val(reader && reader->stream && reader->list, tb_null);
 
     // empty?
-    if (!size) return tb_oc_array_init(TB_OC_BIN_READER_ARRAY_GROW, tb_false);
+    if (!size) return tb_oc_array_init_with_allocator(reader->allocator, TB_OC_BIN_READER_ARRAY_GROW, tb_false);
 
     // init array
-    tb_object_ref_t array = tb_oc_array_init(TB_OC_BIN_READER_ARRAY_GROW, tb_false);
+    tb_object_ref_t array = tb_oc_array_init_with_allocator(reader->allocator, TB_OC_BIN_READER_ARRAY_GROW, tb_false);
     tb_assert_and_check_return_val(array, tb_null);
 
     // walk
@@ -179,7 +179,7 @@ static tb_object_ref_t tb_oc_bin_reader_func_string(tb_oc_bin_reader_t* reader,
     tb_assert_and_check_return_val(reader && reader->stream && reader->list, tb_null);
 
     // empty?
-    if (!size) return tb_oc_string_init_from_cstr(tb_null);
+    if (!size) return tb_oc_string_init_with_allocator(reader->allocator, tb_null);
 
     // make data
     tb_char_t* data = tb_malloc0_cstr((tb_size_t)size + 1);
@@ -201,7 +201,7 @@ static tb_object_ref_t tb_oc_bin_reader_func_string(tb_oc_bin_reader_t* reader,
     }
 
     // make string
-    tb_object_ref_t string = tb_oc_string_init_from_cstr(data); 
+    tb_object_ref_t string = tb_oc_string_init_with_allocator(reader->allocator, data); 
 
     // exit data
     tb_free(data);
@@ -226,56 +226,56 @@ static tb_object_ref_t tb_oc_bin_reader_func_number(tb_oc_bin_reader_t* reader,
         {
             // read and init number
             if (tb_stream_bread_u64_be(reader->stream, &value.u64))
-                number = tb_oc_number_init_from_uint64(value.u64);
+                number = tb_oc_number_init_with_allocator(reader->allocator, TB_OC_NUMBER_TYPE_UINT64, &value.u64);
         }
         break;
     case TB_OC_NUMBER_TYPE_SINT64:
         {
             // read and init number
             if (tb_stream_bread_s64_be(reader->stream, &value.s64))
-                number = tb_oc_number_init_from_sint64(value.s64);
+                number = tb_oc_number_init_with_allocator(reader->allocator, TB_OC_NUMBER_TYPE_SINT64, &value.s64);
         }
         break;
     case TB_OC_NUMBER_TYPE_UINT32:
         {
             // read and init number
             if (tb_stream_bread_u32_be(reader->stream, &value.u32))
-                number = tb_oc_number_init_from_uint32(value.u32);
+                number = tb_oc_number_init_with_allocator(reader->allocator, TB_OC_NUMBER_TYPE_UINT32, &value.u32);
         }
         break;
     case TB_OC_NUMBER_TYPE_SINT32:
         {
             // read and init number
             if (tb_stream_bread_s32_be(reader->stream, &value.s32))
-                number = tb_oc_number_init_from_sint32(value.s32);
+                number = tb_oc_number_init_with_allocator(reader->allocator, TB_OC_NUMBER_TYPE_SINT32, &value.s32);
         }
         break;
     case TB_OC_NUMBER_TYPE_UINT16:
         {
             // read and init number
             if (tb_stream_bread_u16_be(reader->stream, &value.u16))
-                number = tb_oc_number_init_from_uint16(value.u16);
+                number = tb_oc_number_init_with_allocator(reader->allocator, TB_OC_NUMBER_TYPE_UINT16, &value.u16);
         }
         break;
     case TB_OC_NUMBER_TYPE_SINT16:
         {
             // read and init number
             if (tb_stream_bread_s16_be(reader->stream, &value.s16))
-                number = tb_oc_number_init_from_sint16(value.s16);
+                number = tb_oc_number_init_with_allocator(reader->allocator, TB_OC_NUMBER_TYPE_SINT16, &value.s16);
         }
         break;
     case TB_OC_NUMBER_TYPE_UINT8:
         {
             // read and init number
             if (tb_stream_bread_u8(reader->stream, &value.u8))
-                number = tb_oc_number_init_from_uint8(value.u8);
+                number = tb_oc_number_init_with_allocator(reader->allocator, TB_OC_NUMBER_TYPE_UINT8, &value.u8);
         }
         break;
     case TB_OC_NUMBER_TYPE_SINT8:
         {
             // read and init number
             if (tb_stream_bread_s8(reader->stream, &value.s8))
-                number = tb_oc_number_init_from_sint8(value.s8);
+                number = tb_oc_number_init_with_allocator(reader->allocator, TB_OC_NUMBER_TYPE_SINT8, &value.s8);
         }
         break;
 #ifdef TB_CONFIG_TYPE_HAVE_FLOAT
@@ -283,14 +283,14 @@ static tb_object_ref_t tb_oc_bin_reader_func_number(tb_oc_bin_reader_t* reader,
         {
             // read and init number
             if (tb_stream_bread_float_be(reader->stream, &value.f))
-                number = tb_oc_number_init_from_float(value.f);
+                number = tb_oc_number_init_with_allocator(reader->allocator, TB_OC_NUMBER_TYPE_FLOAT, &value.f);
         }
         break;
     case TB_OC_NUMBER_TYPE_DOUBLE:
         {
             // read and init number
             if (tb_stream_bread_double_bbe(reader->stream, &value.d))
-                number = tb_oc_number_init_from_double(value.d);
+                number = tb_oc_number_init_with_allocator(reader->allocator, TB_OC_NUMBER_TYPE_DOUBLE, &value.d);
         }
         break;
 #endif
@@ -316,10 +316,10 @@ static tb_object_ref_t tb_oc_bin_reader_func_dictionary(tb_oc_bin_reader_t* read
     tb_assert_and_check_return_val(reader && reader->stream && reader->list, tb_null);
 
     // empty?
-    if (!size) return tb_oc_dictionary_init(TB_OC_DICTIONARY_SIZE_MICRO, tb_false);
+    if (!size) return tb_oc_dictionary_init_with_allocator(reader->allocator, TB_OC_DICTIONARY_SIZE_MICRO, tb_false);
 
     // init dictionary
-    tb_object_ref_t dictionary = tb_oc_dictionary_init(0, tb_false);
+    tb_object_ref_t dictionary = tb_oc_dictionary_init_with_allocator(reader->allocator, 0, tb_false);
     tb_assert_and_check_return_val(dictionary, tb_null);
 
     // walk
@@ -436,7 +436,7 @@ static tb_object_ref_t tb_oc_bin_reader_func_dictionary(tb_oc_bin_reader_t* read
     // ok?
     return dictionary;
 }
-static tb_object_ref_t tb_oc_bin_reader_done(tb_stream_ref_t stream)
+static tb_object_ref_t tb_oc_bin_reader_done(tb_stream_ref_t stream, tb_allocator_ref_t allocator)
 {
     // read bin header
     tb_byte_t data[32] = {0};
@@ -451,6 +451,7 @@ static tb_object_ref_t tb_oc_bin_reader_done(tb_stream_ref_t stream)
 
     // init reader
     reader.stream           = stream;
+    reader.allocator        = allocator;
     reader.list             = tb_vector_init(256, tb_element_obj());
     tb_assert_and_check_return_val(reader.list, tb_null);
 
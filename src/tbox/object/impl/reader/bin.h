@@ -49,6 +49,9 @@ typedef struct __tb_oc_bin_reader_t
     /// the object list
     tb_vector_ref_t             list;
 
+    /// the allocator of the read objects, uses the global allocator if be null
+    tb_allocator_ref_t          allocator;
+
 }tb_oc_bin_reader_t;
 
 /// the bin reader func type
@@ -164,9 +164,9 @@ static tb_object_ref_t tb_oc_bplist_reader_func_data(tb_oc_bplist_reader_t* read
 
         // read data
         if (tb_stream_bread(reader->stream, data, size))
-            object = tb_oc_data_init_from_data(data, size);
+            object = tb_oc_data_init_with_allocator(reader->allocator, data, size);
     }
-    else object = tb_oc_data_init_from_data(tb_null, 0);
+    else object = tb_oc_data_init_with_allocator(reader->allocator, tb_null, 0);
 
     // exit
     if (data) tb_free(data);
@@ -192,7 +192,7 @@ static tb_object_ref_t tb_oc_bplist_reader_func_array(tb_oc_bplist_reader_t* rea
     }
 
     // init array
-    object = tb_oc_array_init(size? size : 16, tb_false);
+    object = tb_oc_array_init_with_allocator(reader->allocator, size? size : 16, tb_false);
     tb_assert_and_check_return_val(object, tb_null);
 
     // init items data
@@ -252,7 +252,7 @@ static tb_object_ref_t tb_oc_bplist_reader_func_string(tb_oc_bplist_reader_t* re
             }
 
             // init object
-            object = tb_oc_string_init_from_cstr(utf8);
+            object = tb_oc_string_init_with_allocator(reader->allocator, utf8);
         }
         break;
     case TB_OC_BPLIST_TYPE_UNICODE:
@@ -284,7 +284,7 @@ static tb_object_ref_t tb_oc_bplist_reader_func_string(tb_oc_bplist_reader_t* re
                 utf8[osize] = '\0';
 
                 // init object
-                object = tb_oc_string_init_from_cstr(utf8);
+                object = tb_oc_string_init_with_allocator(reader->allocator, utf8);
             }
 #else
             // trace
@@ -320,14 +320,14 @@ static tb_object_ref_t tb_oc_bplist_reader_func_number(tb_oc_bplist_reader_t* re
         {
             // read and init object
             if (tb_stream_bread_u8(reader->stream, &value.u8))
-                object = tb_oc_number_init_from_uint8(value.u8);
+                object = tb_oc_number_init_with_allocator(reader->allocator, TB_OC_NUMBER_TYPE_UINT8, &value.u8);
         }
         break;
     case 2:
         {
             // read and init object
             if (tb_stream_bread_u16_be(reader->stream, &value.u16))
-                object = tb_oc_number_init_from_uint16(value.u16);
+                object = tb_oc_number_init_with_allocator(reader->allocator, TB_OC_NUMBER_TYPE_UINT16, &value.u16);
         }
         break;
     case 4:
@@ -339,7 +339,7 @@ static tb_object_ref_t tb_oc_bplist_reader_func_number(tb_oc_bplist_reader_t* re
                 {
                     // read and init object
                     if (tb_stream_bread_u32_be(reader->stream, &value.u32))
-                        object = tb_oc_number_init_from_uint32(value.u32);
+                        object = tb_oc_number_init_with_allocator(reader->allocator, TB_OC_NUMBER_TYPE_UINT32, &value.u32);
                 }
                 break;
             case TB_OC_BPLIST_TYPE_REAL:
@@ -347,7 +347,7 @@ static tb_object_ref_t tb_oc_bplist_reader_func_number(tb_oc_bplist_reader_t* re
 #ifdef TB_CONFIG_TYPE_HAVE_FLOAT
                     // read and init object
                     if (tb_stream_bread_float_be(reader->stream, &value.f))
-                        object = tb_oc_number_init_from_float(value.f);
+                        object = tb_oc_number_init_with_allocator(reader->allocator, TB_OC_NUMBER_TYPE_FLOAT, &value.f);
 #else
                     tb_trace_e("real type is not supported! please enable float config.");
 #endif
@@ -368,7 +368,7 @@ static tb_object_ref_t tb_oc_bplist_reader_func_number(tb_oc_bplist_reader_t* re
                 {
                     // read and init object
                     if (tb_stream_bread_u64_be(reader->stream, &value.u64))
-                        object = tb_oc_number_init_from_uint64(value.u64);
+                        object = tb_oc_number_init_with_allocator(reader->allocator, TB_OC_NUMBER_TYPE_UINT64, &value.u64);
                 }
                 break;
             case TB_OC_BPLIST_TYPE_REAL:
@@ -376,7 +376,7 @@ static tb_object_ref_t tb_oc_bplist_reader_func_number(tb_oc_bplist_reader_t* re
 #ifdef TB_CONFIG_TYPE_HAVE_FLOAT
                     // read and init object
                     if (tb_stream_bread_double_bbe(reader->stream, &value.d))
-                        object = tb_oc_number_init_from_double(value.d);
+                        object = tb_oc_number_init_with_allocator(reader->allocator, TB_OC_NUMBER_TYPE_DOUBLE, &value.d);
 #else
                     tb_trace_e("real type is not supported! please enable float config.");
 #endif
@@ -412,7 +412,7 @@ static tb_object_ref_t tb_oc_bplist_reader_func_uid(tb_oc_bplist_reader_t* reade
         tb_assert_and_check_break(value);
 
         // init uid object
-        uid = tb_oc_dictionary_init(8, tb_false);
+        uid = tb_oc_dictionary_init_with_allocator(reader->allocator, 8, tb_false);
         tb_assert_and_check_break(uid);
 
         // save this uid value
@@ -444,7 +444,7 @@ static tb_object_ref_t tb_oc_bplist_reader_func_date(tb_oc_bplist_reader_t* read
     tb_assert_and_check_return_val(data, tb_null);
 
     // init date
-    tb_object_ref_t date = tb_oc_date_init_from_time(tb_oc_bplist_reader_time_apple2host((tb_time_t)tb_oc_number_uint64(data)));
+    tb_object_ref_t date = tb_oc_date_init_with_allocator(reader->allocator, tb_oc_bplist_reader_time_apple2host((tb_time_t)tb_oc_number_uint64(data)));
 
     // exit data
     tb_object_exit(data);
@@ -490,7 +490,7 @@ static tb_object_ref_t tb_oc_bplist_reader_func_dictionary(tb_oc_bplist_reader_t
     }
 
     // init dictionary
-    object = tb_oc_dictionary_init(TB_OC_DICTIONARY_SIZE_MICRO, tb_false);
+    object = tb_oc_dictionary_init_with_allocator(reader->allocator, TB_OC_DICTIONARY_SIZE_MICRO, tb_false);
     tb_assert_and_check_return_val(object, tb_null);
 
     // init items data
@@ -512,7 +512,7 @@ static tb_object_ref_t tb_oc_bplist_reader_func_dictionary(tb_oc_bplist_reader_t
     // ok?
     return object;
 }
-static tb_object_ref_t tb_oc_bplist_reader_done(tb_stream_ref_t stream)
+static tb_object_ref_t tb_oc_bplist_reader_done(tb_stream_ref_t stream, tb_allocator_ref_t allocator)
 {
     // check
     tb_assert_and_check_return_val(stream, tb_null);
@@ -523,6 +523,7 @@ static tb_object_ref_t tb_oc_bplist_reader_done(tb_stream_ref_t stream)
     // init reader
     tb_oc_bplist_reader_t reader = {0};
     reader.stream = stream;
+    reader.allocator = allocator;
 
     // init size
     tb_hize_t size = tb_stream_size(stream);
@@ -46,6 +46,9 @@ typedef struct __tb_oc_bplist_reader_t
     /// the stream
     tb_stream_ref_t             stream;
 
+    /// the allocator of the read objects, uses the global allocator if be null
+    tb_allocator_ref_t          allocator;
+
 }tb_oc_bplist_reader_t;
 
 /// the bplist reader func type
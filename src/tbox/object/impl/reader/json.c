@@ -116,7 +116,7 @@ static tb_object_ref_t tb_oc_json_reader_func_array(tb_oc_json_reader_t* reader,
     tb_assert_and_check_return_val(reader && reader->stream && type == '[', tb_null);
 
     // init array
-    tb_object_ref_t array = tb_oc_array_init(TB_OC_JSON_READER_ARRAY_GROW, tb_false);
+    tb_object_ref_t array = tb_oc_array_init_with_allocator(reader->allocator, TB_OC_JSON_READER_ARRAY_GROW, tb_false);
     tb_assert_and_check_return_val(array, tb_null);
 
     // done
@@ -220,7 +220,7 @@ static tb_object_ref_t tb_oc_json_reader_func_string(tb_oc_json_reader_t* reader
     }
 
     // init string
-    tb_object_ref_t string = tb_oc_string_init_from_cstr(tb_string_cstr(&data));
+    tb_object_ref_t string = tb_oc_string_init_with_allocator(reader->allocator, tb_string_cstr(&data));
 
     // trace
     tb_trace_d("string: %s", tb_string_cstr(&data));
@@ -293,7 +293,11 @@ static tb_object_ref_t tb_oc_json_reader_func_number(tb_oc_json_reader_t* reader
 
         // init number 
 #ifdef TB_CONFIG_TYPE_HAVE_FLOAT
-        if (bf) number = tb_oc_number_init_from_float(tb_stof(tb_static_string_cstr(&data)));
+        if (bf) 
+        {
+            tb_float_t value = tb_stof(tb_static_string_cstr(&data));
+            number = tb_oc_number_init_with_allocator(reader->allocator, TB_OC_NUMBER_TYPE_FLOAT, &value);
+        }
 #else
         if (bf) tb_trace_noimpl();
 #endif
@@ -303,10 +307,10 @@ static tb_object_ref_t tb_oc_json_reader_func_number(tb_oc_json_reader_t* reader
             tb_size_t   bytes = tb_object_need_bytes(-value);
             switch (bytes)
             {
-            case 1: number = tb_oc_number_init_from_sint8((tb_sint8_t)value); break;
-            case 2: number = tb_oc_number_init_from_sint16((tb_sint16_t)value); break;
-            case 4: number = tb_oc_number_init_from_sint32((tb_sint32_t)value); break;
-            case 8: number = tb_oc_number_init_from_sint64((tb_sint64_t)value); break;
+            case 1: { tb_sint8_t  v = (tb_sint8_t)value;  number = tb_oc_number_init_with_allocator(reader->allocator, TB_OC_NUMBER_TYPE_SINT8, &v); } break;
+            case 2: { tb_sint16_t v = (tb_sint16_t)value; number = tb_oc_number_init_with_allocator(reader->allocator, TB_OC_NUMBER_TYPE_SINT16, &v); } break;
+            case 4: { tb_sint32_t v = (tb_sint32_t)value; number = tb_oc_number_init_with_allocator(reader->allocator, TB_OC_NUMBER_TYPE_SINT32, &v); } break;
+            case 8: number = tb_oc_number_init_with_allocator(reader->allocator, TB_OC_NUMBER_TYPE_SINT64, &value); break;
             default: break;
             }
             
@@ -317,10 +321,10 @@ static tb_object_ref_t tb_oc_json_reader_func_number(tb_oc_json_reader_t* reader
             tb_size_t   bytes = tb_object_need_bytes(value);
             switch (bytes)
             {
-            case 1: number = tb_oc_number_init_from_uint8((tb_uint8_t)value); break;
-            case 2: number = tb_oc_number_init_from_uint16((tb_uint16_t)value); break;
-            case 4: number = tb_oc_number_init_from_uint32((tb_uint32_t)value); break;
-            case 8: number = tb_oc_number_init_from_uint64((tb_uint64_t)value); break;
+            case 1: { tb_uint8_t  v = (tb_uint8_t)value;  number = tb_oc_number_init_with_allocator(reader->allocator, TB_OC_NUMBER_TYPE_UINT8, &v); } break;
+            case 2: { tb_uint16_t v = (tb_uint16_t)value; number = tb_oc_number_init_with_allocator(reader->allocator, TB_OC_NUMBER_TYPE_UINT16, &v); } break;
+            case 4: { tb_uint32_t v = (tb_uint32_t)value; number = tb_oc_number_init_with_allocator(reader->allocator, TB_OC_NUMBER_TYPE_UINT32, &v); } break;
+            case 8: number = tb_oc_number_init_with_allocator(reader->allocator, TB_OC_NUMBER_TYPE_UINT64, &value); break;
             default: break;
             }
         }
@@ -406,7 +410,7 @@ static tb_object_ref_t tb_oc_json_reader_func_dictionary(tb_oc_json_reader_t* re
     if (!tb_static_string_init(&kname, kdata, 8192)) return tb_null;
 
     // init dictionary
-    tb_object_ref_t dictionary = tb_oc_dictionary_init(0, tb_false);
+    tb_object_ref_t dictionary = tb_oc_dictionary_init_with_allocator(reader->allocator, 0, tb_false);
     tb_assert_and_check_return_val(dictionary, tb_null);
 
     // walk
@@ -473,14 +477,15 @@ static tb_object_ref_t tb_oc_json_reader_func_dictionary(tb_oc_json_reader_t* re
     // ok?
     return dictionary;
 }
-static tb_object_ref_t tb_oc_json_reader_done(tb_stream_ref_t stream)
+static tb_object_ref_t tb_oc_json_reader_done(tb_stream_ref_t stream, tb_allocator_ref_t allocator)
 {
     // check
     tb_assert_and_check_return_val(stream, tb_null);
 
     // init reader
     tb_oc_json_reader_t reader = {0};
-    reader.stream = stream;
+    reader.stream       = stream;
+    reader.allocator    = allocator;
 
     // skip spaces
     tb_char_t type = '\0';
@@ -80,7 +80,7 @@ tb_oc_reader_t* tb_oc_reader_get(tb_size_t format)
     // ok
     return g_reader[format];
 }
-tb_object_ref_t tb_oc_reader_done(tb_stream_ref_t stream)
+tb_object_ref_t tb_oc_reader_done(tb_stream_ref_t stream, tb_allocator_ref_t allocator)
 {
     // check
     tb_assert_and_check_return_val(stream, tb_null);
@@ -107,5 +107,5 @@ tb_object_ref_t tb_oc_reader_done(tb_stream_ref_t stream)
     }
 
     // ok? read it
-    return (m && g_reader[f] && g_reader[f]->read)? g_reader[f]->read(stream) : tb_null;
+    return (m && g_reader[f] && g_reader[f]->read)? g_reader[f]->read(stream, allocator) : tb_null;
 }
@@ -70,10 +70,11 @@ tb_void_t               tb_oc_reader_remove(tb_size_t format);
 /*! done reader
  *
  * @param stream        the stream
+ * @param allocator     the allocator of the read objects, uses the global allocator if be null
  *
  * @return              the object
  */
-tb_object_ref_t      tb_oc_reader_done(tb_stream_ref_t stream);
+tb_object_ref_t      tb_oc_reader_done(tb_stream_ref_t stream, tb_allocator_ref_t allocator);
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
@@ -57,7 +57,7 @@ static tb_object_ref_t tb_oc_xplist_reader_func_date(tb_oc_xplist_reader_t* read
 
     // empty?
     if (event == TB_XML_READER_EVENT_ELEMENT_EMPTY) 
-        return tb_oc_date_init_from_time(0);
+        return tb_oc_date_init_with_allocator(reader->allocator, 0);
 
     // done
     tb_bool_t       leave = tb_false;
@@ -76,7 +76,7 @@ static tb_object_ref_t tb_oc_xplist_reader_func_date(tb_oc_xplist_reader_t* read
                 if (!tb_stricmp(name, "date"))
                 {
                     // empty?
-                    if (!date) date = tb_oc_date_init_from_time(0);
+                    if (!date) date = tb_oc_date_init_with_allocator(reader->allocator, 0);
 
                     // leave it
                     leave = tb_true;
@@ -135,7 +135,7 @@ static tb_object_ref_t tb_oc_xplist_reader_func_date(tb_oc_xplist_reader_t* read
                 tb_assert_and_check_break_state(time >= 0, leave, tb_true);
 
                 // date
-                date = tb_oc_date_init_from_time(time);
+                date = tb_oc_date_init_with_allocator(reader->allocator, time);
             }
             break;
         default:
@@ -153,7 +153,7 @@ static tb_object_ref_t tb_oc_xplist_reader_func_data(tb_oc_xplist_reader_t* read
 
     // empty?
     if (event == TB_XML_READER_EVENT_ELEMENT_EMPTY) 
-        return tb_oc_data_init_from_data(tb_null, 0);
+        return tb_oc_data_init_with_allocator(reader->allocator, tb_null, 0);
 
     // done
     tb_bool_t           leave = tb_false;
@@ -173,7 +173,7 @@ static tb_object_ref_t tb_oc_xplist_reader_func_data(tb_oc_xplist_reader_t* read
                 if (!tb_stricmp(name, "data"))
                 {
                     // empty?
-                    if (!data) data = tb_oc_data_init_from_data(tb_null, 0);
+                    if (!data) data = tb_oc_data_init_with_allocator(reader->allocator, tb_null, 0);
                     
                     // leave it
                     leave = tb_true;
@@ -206,9 +206,9 @@ static tb_object_ref_t tb_oc_xplist_reader_func_data(tb_oc_xplist_reader_t* read
                     tb_trace_d("base64: %u => %u", in, on);
 
                     // init data
-                    data = tb_oc_data_init_from_data(ob, on); tb_free(ob);
+                    data = tb_oc_data_init_with_allocator(reader->allocator, ob, on); tb_free(ob);
                 }
-                else data = tb_oc_data_init_from_data(tb_null, 0);
+                else data = tb_oc_data_init_with_allocator(reader->allocator, tb_null, 0);
                 tb_assert_and_check_break_state(data, leave, tb_true);
             }
             break;
@@ -230,10 +230,10 @@ static tb_object_ref_t tb_oc_xplist_reader_func_array(tb_oc_xplist_reader_t* rea
 
     // empty?
     if (event == TB_XML_READER_EVENT_ELEMENT_EMPTY) 
-        return tb_oc_array_init(TB_OC_XPLIST_READER_ARRAY_GROW, tb_false);
+        return tb_oc_array_init_with_allocator(reader->allocator, TB_OC_XPLIST_READER_ARRAY_GROW, tb_false);
 
     // init array
-    tb_object_ref_t array = tb_oc_array_init(TB_OC_XPLIST_READER_ARRAY_GROW, tb_false);
+    tb_object_ref_t array = tb_oc_array_init_with_allocator(reader->allocator, TB_OC_XPLIST_READER_ARRAY_GROW, tb_false);
     tb_assert_and_check_return_val(array, tb_null);
 
     // done
@@ -294,7 +294,7 @@ static tb_object_ref_t tb_oc_xplist_reader_func_string(tb_oc_xplist_reader_t* re
 
     // empty?
     if (event == TB_XML_READER_EVENT_ELEMENT_EMPTY) 
-        return tb_oc_string_init_from_cstr(tb_null);
+        return tb_oc_string_init_with_allocator(reader->allocator, tb_null);
 
     // done
     tb_bool_t       leave = tb_false;
@@ -313,7 +313,7 @@ static tb_object_ref_t tb_oc_xplist_reader_func_string(tb_oc_xplist_reader_t* re
                 if (!tb_stricmp(name, "string"))
                 {
                     // empty?
-                    if (!string) string = tb_oc_string_init_from_cstr(tb_null);
+                    if (!string) string = tb_oc_string_init_with_allocator(reader->allocator, tb_null);
                     
                     // leave it
                     leave = tb_true;
@@ -328,7 +328,7 @@ static tb_object_ref_t tb_oc_xplist_reader_func_string(tb_oc_xplist_reader_t* re
                 tb_trace_d("string: %s", text);
                 
                 // string
-                string = tb_oc_string_init_from_cstr(text);
+                string = tb_oc_string_init_with_allocator(reader->allocator, text);
                 tb_assert_and_check_break_state(string, leave, tb_true);
             }
             break;
@@ -347,7 +347,10 @@ static tb_object_ref_t tb_oc_xplist_reader_func_number(tb_oc_xplist_reader_t* re
 
     // empty?
     if (event == TB_XML_READER_EVENT_ELEMENT_EMPTY) 
-        return tb_oc_number_init_from_uint32(0);
+    {
+        tb_uint32_t value = 0;
+        return tb_oc_number_init_with_allocator(reader->allocator, TB_OC_NUMBER_TYPE_UINT32, &value);
+    }
 
     // done
     tb_bool_t           leave = tb_false;
@@ -386,11 +389,24 @@ static tb_object_ref_t tb_oc_xplist_reader_func_number(tb_oc_xplist_reader_t* re
                 
                 // number
 #ifdef TB_CONFIG_TYPE_HAVE_FLOAT
-                if (f) number = tb_oc_number_init_from_double(tb_atof(text));
+                if (f) 
+                {
+                    tb_double_t value = tb_atof(text);
+                    number = tb_oc_number_init_with_allocator(reader->allocator, TB_OC_NUMBER_TYPE_DOUBLE, &value);
+                }
 #else
                 if (f) tb_trace_noimpl();
 #endif
-                else number = s? tb_oc_number_init_from_sint64(tb_stoi64(text)) : tb_oc_number_init_from_uint64(tb_stou64(text));
+                else if (s)
+                {
+                    tb_sint64_t value = tb_stoi64(text);
+                    number = tb_oc_number_init_with_allocator(reader->allocator, TB_OC_NUMBER_TYPE_SINT64, &value);
+                }
+                else
+                {
+                    tb_uint64_t value = tb_stou64(text);
+                    number = tb_oc_number_init_with_allocator(reader->allocator, TB_OC_NUMBER_TYPE_UINT64, &value);
+                }
                 tb_assert_and_check_break_state(number, leave, tb_true);
             }
             break;
@@ -428,7 +444,7 @@ static tb_object_ref_t tb_oc_xplist_reader_func_dictionary(tb_oc_xplist_reader_t
 
     // empty?
     if (event == TB_XML_READER_EVENT_ELEMENT_EMPTY) 
-        return tb_oc_dictionary_init(TB_OC_DICTIONARY_SIZE_MICRO, tb_false);
+        return tb_oc_dictionary_init_with_allocator(reader->allocator, TB_OC_DICTIONARY_SIZE_MICRO, tb_false);
 
     // init key name
     tb_static_string_t  kname;
@@ -436,7 +452,7 @@ static tb_object_ref_t tb_oc_xplist_reader_func_dictionary(tb_oc_xplist_reader_t
     if (!tb_static_string_init(&kname, kdata, 8192)) return tb_null;
 
     // init dictionary
-    tb_object_ref_t dictionary = tb_oc_dictionary_init(0, tb_false);
+    tb_object_ref_t dictionary = tb_oc_dictionary_init_with_allocator(reader->allocator, 0, tb_false);
     tb_assert_and_check_return_val(dictionary, tb_null);
 
     // done
@@ -519,10 +535,11 @@ static tb_object_ref_t tb_oc_xplist_reader_func_dictionary(tb_oc_xplist_reader_t
     // ok?
     return dictionary;
 }
-static tb_object_ref_t tb_oc_xplist_reader_done(tb_stream_ref_t stream)
+static tb_object_ref_t tb_oc_xplist_reader_done(tb_stream_ref_t stream, tb_allocator_ref_t allocator)
 {
     // init reader 
     tb_oc_xplist_reader_t reader = {0};
+    reader.allocator = allocator;
     reader.reader = tb_xml_reader_init();
     tb_assert_and_check_return_val(reader.reader, tb_null);
 
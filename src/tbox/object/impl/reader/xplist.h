@@ -46,6 +46,9 @@ typedef struct __tb_oc_xplist_reader_t
     // the xplist reader
     tb_xml_reader_ref_t         reader;
 
+    // the allocator of the read objects, uses the global allocator if be null
+    tb_allocator_ref_t          allocator;
+
 }tb_oc_xplist_reader_t;
 
 // the xplist reader func type
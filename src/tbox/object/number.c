@@ -85,6 +85,9 @@ typedef struct __tb_oc_number_t
     
     }v;
 
+    // the allocator
+    tb_allocator_ref_t  allocator;
+
 }tb_oc_number_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -104,40 +107,13 @@ static tb_object_ref_t tb_oc_number_copy(tb_object_ref_t object)
     tb_oc_number_t* number = (tb_oc_number_t*)object;
     tb_assert_and_check_return_val(number, tb_null);
 
-    // copy
-    switch (number->type)
-    {
-    case TB_OC_NUMBER_TYPE_UINT64:
-        return tb_oc_number_init_from_uint64(number->v.u64);
-    case TB_OC_NUMBER_TYPE_SINT64:
-        return tb_oc_number_init_from_sint64(number->v.s64);
-    case TB_OC_NUMBER_TYPE_UINT32:
-        return tb_oc_number_init_from_uint32(number->v.u32);
-    case TB_OC_NUMBER_TYPE_SINT32:
-        return tb_oc_number_init_from_sint32(number->v.s32);
-    case TB_OC_NUMBER_TYPE_UINT16:
-        return tb_oc_number_init_from_uint16(number->v.u16);
-    case TB_OC_NUMBER_TYPE_SINT16:
-        return tb_oc_number_init_from_sint16(number->v.s16);
-    case TB_OC_NUMBER_TYPE_UINT8:
-        return tb_oc_number_init_from_uint8(number->v.u8);
-    case TB_OC_NUMBER_TYPE_SINT8:
-        return tb_oc_number_init_from_sint8(number->v.s8);
-#ifdef TB_CONFIG_TYPE_HAVE_FLOAT
-    case TB_OC_NUMBER_TYPE_FLOAT:
-        return tb_oc_number_init_from_float(number->v.f);
-    case TB_OC_NUMBER_TYPE_DOUBLE:
-        return tb_oc_number_init_from_double(number->v.d);
-#endif
-    default:
-        break;
-    }
-
-    return tb_null;
+    // copy it, all values of the union have the same address
+    return tb_oc_number_init_with_allocator(number->allocator, number->type, &number->v);
 }
 static tb_void_t tb_oc_number_exit(tb_object_ref_t object)
 {
-    if (object) tb_free(object);
+    tb_oc_number_t* number = (tb_oc_number_t*)object;
+    if (number) tb_allocator_free(number->allocator, number);
 }
 static tb_void_t tb_oc_number_clear(tb_object_ref_t object)
 {
@@ -184,7 +160,7 @@ static tb_void_t tb_oc_number_clear(tb_object_ref_t object)
         break;
     }
 }
-static tb_oc_number_t* tb_oc_number_init_base()
+static tb_oc_number_t* tb_oc_number_init_base(tb_allocator_ref_t allocator)
 {
     // done
     tb_bool_t       ok = tb_false;
@@ -192,9 +168,12 @@ static tb_oc_number_t* tb_oc_number_init_base()
     do
     {
         // make number
-        number = tb_malloc0_type(tb_oc_number_t);
+        number = (tb_oc_number_t*)tb_allocator_malloc0(allocator, sizeof(tb_oc_number_t));
         tb_assert_and_check_break(number);
 
+        // init allocator
+        number->allocator = allocator;
+
         // init number
         if (!tb_object_init((tb_object_ref_t)number, TB_OBJECT_FLAG_NONE, TB_OBJECT_TYPE_NUMBER)) break;
 
@@ -222,10 +201,76 @@ static tb_oc_number_t* tb_oc_number_init_base()
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
+tb_object_ref_t tb_oc_number_init_with_allocator(tb_allocator_ref_t allocator, tb_size_t type, tb_cpointer_t value)
+{
+    // check
+    tb_assert_and_check_return_val(value, tb_null);
+
+    // uses the global allocator by default
+    if (!allocator) allocator = tb_allocator();
+
+    // make
+    tb_oc_number_t* number = tb_oc_number_init_base(allocator);
+    tb_assert_and_check_return_val(number, tb_null);
+
+    // init value
+    tb_bool_t ok = tb_true;
+    switch (type)
+    {
+    case TB_OC_NUMBER_TYPE_UINT64:
+        number->v.u64 = *((tb_uint64_t const*)value);
+        break;
+    case TB_OC_NUMBER_TYPE_SINT64:
+        number->v.s64 = *((tb_sint64_t const*)value);
+        break;
+    case TB_OC_NUMBER_TYPE_UINT32:
+        number->v.u32 = *((tb_uint32_t const*)value);
+        break;
+    case TB_OC_NUMBER_TYPE_SINT32:
+        number->v.s32 = *((tb_sint32_t const*)value);
+        break;
+    case TB_OC_NUMBER_TYPE_UINT16:
+        number->v.u16 = *((tb_uint16_t const*)value);
+        break;
+    case TB_OC_NUMBER_TYPE_SINT16:
+        number->v.s16 = *((tb_sint16_t const*)value);
+        break;
+    case TB_OC_NUMBER_TYPE_UINT8:
+        number->v.u8 = *((tb_uint8_t const*)value);
+        break;
+    case TB_OC_NUMBER_TYPE_SINT8:
+        number->v.s8 = *((tb_sint8_t const*)value);
+        break;
+#ifdef TB_CONFIG_TYPE_HAVE_FLOAT
+    case TB_OC_NUMBER_TYPE_FLOAT:
+        number->v.f = *((tb_float_t const*)value);
+        break;
+    case TB_OC_NUMBER_TYPE_DOUBLE:
+        number->v.d = *((tb_double_t const*)value);
+        break;
+#endif
+    default:
+        ok = tb_false;
+        break;
+    }
+
+    // invalid type?
+    if (!ok)
+    {
+        tb_oc_number_exit((tb_object_ref_t)number);
+        return tb_null;
+    }
+
+    // init type
+    number->type = type;
+
+    // ok
+    return (tb_object_ref_t)number;
+}
 tb_object_ref_t tb_oc_number_init_from_uint8(tb_uint8_t value)
 {
     // make
-    tb_oc_number_t* number = tb_oc_number_init_base();
+    tb_oc_number_t* number = tb_oc_number_init_base(tb_allocator());
     tb_assert_and_check_return_val(number, tb_null);
 
     // init value
@@ -239,7 +284,7 @@ tb_object_ref_t tb_oc_number_init_from_uint8(tb_uint8_t value)
 tb_object_ref_t tb_oc_number_init_from_sint8(tb_sint8_t value)
 {
     // make
-    tb_oc_number_t* number = tb_oc_number_init_base();
+    tb_oc_number_t* number = tb_oc_number_init_base(tb_allocator());
     tb_assert_and_check_return_val(number, tb_null);
 
     // init value
@@ -253,7 +298,7 @@ tb_object_ref_t tb_oc_number_init_from_sint8(tb_sint8_t value)
 tb_object_ref_t tb_oc_number_init_from_uint16(tb_uint16_t value)
 {
     // make
-    tb_oc_number_t* number = tb_oc_number_init_base();
+    tb_oc_number_t* number = tb_oc_number_init_base(tb_allocator());
     tb_assert_and_check_return_val(number, tb_null);
 
     // init value
@@ -267,7 +312,7 @@ tb_object_ref_t tb_oc_number_init_from_uint16(tb_uint16_t value)
 tb_object_ref_t tb_oc_number_init_from_sint16(tb_sint16_t value)
 {
     // make
-    tb_oc_number_t* number = tb_oc_number_init_base();
+    tb_oc_number_t* number = tb_oc_number_init_base(tb_allocator());
     tb_assert_and_check_return_val(number, tb_null);
 
     // init value
@@ -281,7 +326,7 @@ tb_object_ref_t tb_oc_number_init_from_sint16(tb_sint16_t value)
 tb_object_ref_t tb_oc_number_init_from_uint32(tb_uint32_t value)
 {
     // make
-    tb_oc_number_t* number = tb_oc_number_init_base();
+    tb_oc_number_t* number = tb_oc_number_init_base(tb_allocator());
     tb_assert_and_check_return_val(number, tb_null);
 
     // init value
@@ -295,7 +340,7 @@ tb_object_ref_t tb_oc_number_init_from_uint32(tb_uint32_t value)
 tb_object_ref_t tb_oc_number_init_from_sint32(tb_sint32_t value)
 {
     // make
-    tb_oc_number_t* number = tb_oc_number_init_base();
+    tb_oc_number_t* number = tb_oc_number_init_base(tb_allocator());
     tb_assert_and_check_return_val(number, tb_null);
 
     // init value
@@ -309,7 +354,7 @@ tb_object_ref_t tb_oc_number_init_from_sint32(tb_sint32_t value)
 tb_object_ref_t tb_oc_number_init_from_uint64(tb_uint64_t value)
 {
     // make
-    tb_oc_number_t* number = tb_oc_number_init_base();
+    tb_oc_number_t* number = tb_oc_number_init_base(tb_allocator());
     tb_assert_and_check_return_val(number, tb_null);
 
     // init value
@@ -323,7 +368,7 @@ tb_object_ref_t tb_oc_number_init_from_uint64(tb_uint64_t value)
 tb_object_ref_t tb_oc_number_init_from_sint64(tb_sint64_t value)
 {
     // make
-    tb_oc_number_t* number = tb_oc_number_init_base();
+    tb_oc_number_t* number = tb_oc_number_init_base(tb_allocator());
     tb_assert_and_check_return_val(number, tb_null);
 
     // init value
@@ -338,7 +383,7 @@ tb_object_ref_t tb_oc_number_init_from_sint64(tb_sint64_t value)
 tb_object_ref_t tb_oc_number_init_from_float(tb_float_t value)
 {
     // make
-    tb_oc_number_t* number = tb_oc_number_init_base();
+    tb_oc_number_t* number = tb_oc_number_init_base(tb_allocator());
     tb_assert_and_check_return_val(number, tb_null);
 
     // init value
@@ -352,7 +397,7 @@ tb_object_ref_t tb_oc_number_init_from_float(tb_float_t value)
 tb_object_ref_t tb_oc_number_init_from_double(tb_double_t value)
 {
     // make
-    tb_oc_number_t* number = tb_oc_number_init_base();
+    tb_oc_number_t* number = tb_oc_number_init_base(tb_allocator());
     tb_assert_and_check_return_val(number, tb_null);
 
     // init value
@@ -61,6 +61,21 @@ typedef enum __tb_oc_number_type_e
  * interfaces
  */
 
+/*! init number with the given allocator
+ *
+ * @code
+    tb_sint32_t     value = 10;
+    tb_object_ref_t number = tb_oc_number_init_with_allocator(allocator, TB_OC_NUMBER_TYPE_SINT32, &value);
+ * @endcode
+ *
+ * @param allocator the allocator, uses the global allocator if be null
+ * @param type      the number type
+ * @param value     the value pointer of the given type
+ *
+ * @return          the number object
+ */
+tb_object_ref_t     tb_oc_number_init_with_allocator(tb_allocator_ref_t allocator, tb_size_t type, tb_cpointer_t value);
+
 /*! init number from uint8
  *
  * @param value     the value
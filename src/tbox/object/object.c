@@ -296,12 +296,16 @@ tb_void_t tb_object_retain(tb_object_ref_t object)
     object->refn++;
 }
 tb_object_ref_t tb_object_read(tb_stream_ref_t stream)
+{
+    return tb_object_read_with_allocator(stream, tb_null);
+}
+tb_object_ref_t tb_object_read_with_allocator(tb_stream_ref_t stream, tb_allocator_ref_t allocator)
 {
     // check
     tb_assert_and_check_return_val(stream, tb_null);
 
     // done reader
-    return tb_oc_reader_done(stream);
+    return tb_oc_reader_done(stream, allocator);
 }
 tb_object_ref_t tb_object_read_from_url(tb_char_t const* url)
 {
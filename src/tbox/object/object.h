@@ -99,6 +99,17 @@ tb_cpointer_t       tb_object_getp(tb_object_ref_t object);
  */
 tb_object_ref_t     tb_object_read(tb_stream_ref_t stream);
 
+/*! read object with the given allocator
+ *
+ * all objects of the read tree are allocated from this allocator
+ *
+ * @param stream    the stream
+ * @param allocator the allocator, uses the global allocator if be null
+ *
+ * @return          the object
+ */
+tb_object_ref_t     tb_object_read_with_allocator(tb_stream_ref_t stream, tb_allocator_ref_t allocator);
+
 /*! read object from url
  *
  * @param url       the url
@@ -56,6 +56,9 @@ typedef struct __tb_oc_string_t
     // the string
     tb_string_t         str;
 
+    // the allocator
+    tb_allocator_ref_t  allocator;
+
 }tb_oc_string_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -71,7 +74,8 @@ static __tb_inline__ tb_oc_string_t* tb_oc_string_cast(tb_object_ref_t object)
 }
 static tb_object_ref_t tb_oc_string_copy(tb_object_ref_t object)
 {
-    return tb_oc_string_init_from_cstr(tb_oc_string_cstr(object));
+    tb_oc_string_t* string = tb_oc_string_cast(object);
+    return string? tb_oc_string_init_with_allocator(string->allocator, tb_oc_string_cstr(object)) : tb_null;
 }
 static tb_void_t tb_oc_string_exit(tb_object_ref_t object)
 {
@@ -82,7 +86,7 @@ static tb_void_t tb_oc_string_exit(tb_object_ref_t object)
         tb_string_exit(&string->str);
 
         // exit the object
-        tb_free(object);
+        tb_allocator_free(string->allocator, string);
     }
 }
 static tb_void_t tb_oc_string_clear(tb_object_ref_t object)
@@ -94,7 +98,7 @@ static tb_void_t tb_oc_string_clear(tb_object_ref_t object)
         tb_string_clear(&string->str);
     }
 }
-static tb_oc_string_t* tb_oc_string_init_base()
+static tb_oc_string_t* tb_oc_string_init_base(tb_allocator_ref_t allocator)
 {
     // done
     tb_bool_t       ok = tb_false;
@@ -102,9 +106,12 @@ static tb_oc_string_t* tb_oc_string_init_base()
     do
     {
         // make string
-        string = tb_malloc0_type(tb_oc_string_t);
+        string = (tb_oc_string_t*)tb_allocator_malloc0(allocator, sizeof(tb_oc_string_t));
         tb_assert_and_check_break(string);
 
+        // init allocator
+        string->allocator = allocator;
+
         // init string
         if (!tb_object_init((tb_object_ref_t)string, TB_OBJECT_FLAG_NONE, TB_OBJECT_TYPE_STRING)) break;
 
@@ -135,17 +142,24 @@ static tb_oc_string_t* tb_oc_string_init_base()
  */
 tb_object_ref_t tb_oc_string_init_from_cstr(tb_char_t const* cstr)
 {
+    return tb_oc_string_init_with_allocator(tb_null, cstr);
+}
+tb_object_ref_t tb_oc_string_init_with_allocator(tb_allocator_ref_t allocator, tb_char_t const* cstr)
+{
+    // uses the global allocator by default
+    if (!allocator) allocator = tb_allocator();
+
     // done
     tb_bool_t       ok = tb_false;
     tb_oc_string_t* string = tb_null;
     do
     {
         // make string
-        string = tb_oc_string_init_base();
+        string = tb_oc_string_init_base(allocator);
         tb_assert_and_check_break(string);
 
         // init str
-        if (!tb_string_init(&string->str)) break;
+        if (!tb_string_init_with_allocator(&string->str, allocator)) break;
 
         // copy string
         if (cstr) tb_string_cstrcpy(&string->str, cstr);
@@ -174,7 +188,7 @@ tb_object_ref_t tb_oc_string_init_from_str(tb_string_ref_t str)
     do
     {
         // make string
-        string = tb_oc_string_init_base();
+        string = tb_oc_string_init_base(tb_allocator());
         tb_assert_and_check_break(string);
 
         // init str
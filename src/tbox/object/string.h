@@ -48,6 +48,17 @@ __tb_extern_c_enter__
  */
 tb_object_ref_t     tb_oc_string_init_from_cstr(tb_char_t const* cstr);
 
+/*! init string from c-string with the given allocator
+ *
+ * the string object and its data will be allocated from this allocator
+ *
+ * @param allocator the allocator, uses the global allocator if be null
+ * @param cstr      the c-string
+ *
+ * @return          the string object
+ */
+tb_object_ref_t     tb_oc_string_init_with_allocator(tb_allocator_ref_t allocator, tb_char_t const* cstr);
+
 /*! init string from string
  *
  * @param str       the string
@@ -31,6 +31,7 @@
 #include "dns.h"
 #include "socket.h"
 #include "exception.h"
+#include "thread.h"
 #include "thread_local.h"
 #include "platform.h"
 
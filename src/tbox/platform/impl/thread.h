@@ -0,0 +1,67 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        thread.h
+ *
+ */
+#ifndef TB_PLATFORM_IMPL_THREAD_H
+#define TB_PLATFORM_IMPL_THREAD_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the thread exit function type, it will be called on the exiting thread
+typedef tb_void_t   (*tb_thread_exit_func_t)(tb_noarg_t);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* attach the exit function to the current thread
+ *
+ * the module can release its per-thread caches in this function when the current thread is exited,
+ * it works for the threads created by tb_thread_init() and the foreign threads (.e.g created by pthread_create() directly).
+ *
+ * @note the same function will be attached only once and they will be called in the reverse order
+ *
+ * @param func      the exit function
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_thread_exit_attach(tb_thread_exit_func_t func);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -0,0 +1,274 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        poller.c
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// enable the io_uring poller?
+#ifdef TB_CONFIG_POSIX_HAVE_IO_URING_SETUP
+#   define TB_POLLER_HAVE_IO_URING
+#endif
+
+// the poller has the dump implementation
+#define TB_POLLER_HAVE_DUMP
+
+// the poller has the post implementation
+#define TB_POLLER_HAVE_POST
+
+// the poller has the stat implementation
+#define TB_POLLER_HAVE_STAT
+
+// is the io_uring poller?
+#define tb_poller_linux_is_io_uring(poller)     (((tb_poller_linux_t*)(poller))->type == TB_POLLER_LINUX_TYPE_IO_URING)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the linux poller type enum
+typedef enum __tb_poller_linux_type_e
+{
+    TB_POLLER_LINUX_TYPE_NONE       = 0
+,   TB_POLLER_LINUX_TYPE_EPOLL      = 1
+,   TB_POLLER_LINUX_TYPE_IO_URING   = 2
+
+}tb_poller_linux_type_e;
+
+// the linux poller type, the common head of all linux pollers
+typedef struct __tb_poller_linux_t
+{
+    // the poller type
+    tb_size_t               type;
+
+}tb_poller_linux_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+#include "poller_epoll.c"
+#ifdef TB_POLLER_HAVE_IO_URING
+#   include "poller_io_uring.c"
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_poller_ref_t tb_poller_init(tb_cpointer_t priv)
+{
+#ifdef TB_POLLER_HAVE_IO_URING
+    /* attempt to use io_uring first
+     *
+     * it will be failed if the current kernel does not support it (< 5.11) or it is disabled,
+     * and we fall back to epoll
+     */
+    tb_poller_ref_t poller = tb_poller_io_uring_init(priv);
+    if (poller) return poller;
+#endif
+
+    // init epoll poller
+    return tb_poller_epoll_init(priv);
+}
+tb_void_t tb_poller_exit(tb_poller_ref_t poller)
+{
+    // check
+    tb_assert_and_check_return(poller);
+
+#ifdef TB_POLLER_HAVE_IO_URING
+    if (tb_poller_linux_is_io_uring(poller)) 
+    {
+        tb_poller_io_uring_exit(poller);
+        return ;
+    }
+#endif
+    tb_poller_epoll_exit(poller);
+}
+tb_void_t tb_poller_clear(tb_poller_ref_t poller)
+{
+    // check
+    tb_assert_and_check_return(poller);
+
+#ifdef TB_POLLER_HAVE_IO_URING
+    if (tb_poller_linux_is_io_uring(poller)) 
+    {
+        tb_poller_io_uring_clear(poller);
+        return ;
+    }
+#endif
+    tb_poller_epoll_clear(poller);
+}
+tb_cpointer_t tb_poller_priv(tb_poller_ref_t poller)
+{
+    // check
+    tb_assert_and_check_return_val(poller, tb_null);
+
+#ifdef TB_POLLER_HAVE_IO_URING
+    if (tb_poller_linux_is_io_uring(poller)) return tb_poller_io_uring_priv(poller);
+#endif
+    return tb_poller_epoll_priv(poller);
+}
+tb_void_t tb_poller_kill(tb_poller_ref_t poller)
+{
+    // check
+    tb_assert_and_check_return(poller);
+
+#ifdef TB_POLLER_HAVE_IO_URING
+    if (tb_poller_linux_is_io_uring(poller)) 
+    {
+        tb_poller_io_uring_kill(poller);
+        return ;
+    }
+#endif
+    tb_poller_epoll_kill(poller);
+}
+tb_void_t tb_poller_spak(tb_poller_ref_t poller)
+{
+    // check
+    tb_assert_and_check_return(poller);
+
+#ifdef TB_POLLER_HAVE_IO_URING
+    if (tb_poller_linux_is_io_uring(poller)) 
+    {
+        tb_poller_io_uring_spak(poller);
+        return ;
+    }
+#endif
+    tb_poller_epoll_spak(poller);
+}
+tb_bool_t tb_poller_support(tb_poller_ref_t poller, tb_size_t events)
+{
+#ifdef TB_POLLER_HAVE_IO_URING
+    if (poller && tb_poller_linux_is_io_uring(poller)) return tb_poller_io_uring_support(poller, events);
+#endif
+    return tb_poller_epoll_support(poller, events);
+}
+tb_bool_t tb_poller_insert(tb_poller_ref_t poller, tb_socket_ref_t sock, tb_size_t events, tb_cpointer_t priv)
+{
+    // check
+    tb_assert_and_check_return_val(poller, tb_false);
+
+#ifdef TB_POLLER_HAVE_IO_URING
+    if (tb_poller_linux_is_io_uring(poller)) return tb_poller_io_uring_insert(poller, sock, events, priv);
+#endif
+    return tb_poller_epoll_insert(poller, sock, events, priv);
+}
+tb_bool_t tb_poller_remove(tb_poller_ref_t poller, tb_socket_ref_t sock)
+{
+    // check
+    tb_assert_and_check_return_val(poller, tb_false);
+
+#ifdef TB_POLLER_HAVE_IO_URING
+    if (tb_poller_linux_is_io_uring(poller)) return tb_poller_io_uring_remove(poller, sock);
+#endif
+    return tb_poller_epoll_remove(poller, sock);
+}
+tb_bool_t tb_poller_modify(tb_poller_ref_t poller, tb_socket_ref_t sock, tb_size_t events, tb_cpointer_t priv)
+{
+    // check
+    tb_assert_and_check_return_val(poller, tb_false);
+
+#ifdef TB_POLLER_HAVE_IO_URING
+    if (tb_poller_linux_is_io_uring(poller)) return tb_poller_io_uring_modify(poller, sock, events, priv);
+#endif
+    return tb_poller_epoll_modify(poller, sock, events, priv);
+}
+tb_bool_t tb_poller_post(tb_poller_ref_t poller, tb_poller_op_ref_t op)
+{
+    // check
+    tb_assert_and_check_return_val(poller && op, tb_false);
+
+#ifdef TB_POLLER_HAVE_IO_URING
+    if (tb_poller_linux_is_io_uring(poller)) return tb_poller_io_uring_post(poller, op);
+#endif
+
+    // epoll only notifies the readiness, the caller need do io by itself
+    return tb_false;
+}
+tb_bool_t tb_poller_post_cancel(tb_poller_ref_t poller, tb_poller_op_ref_t op)
+{
+    // check
+    tb_assert_and_check_return_val(poller && op, tb_false);
+
+#ifdef TB_POLLER_HAVE_IO_URING
+    if (tb_poller_linux_is_io_uring(poller)) return tb_poller_io_uring_post_cancel(poller, op);
+#endif
+    return tb_false;
+}
+tb_void_t tb_poller_cancel(tb_poller_ref_t poller, tb_socket_ref_t sock)
+{
+    // check
+    tb_assert_and_check_return(poller && sock);
+
+#ifdef TB_POLLER_HAVE_IO_URING
+    if (tb_poller_linux_is_io_uring(poller)) 
+    {
+        tb_poller_io_uring_cancel(poller, sock);
+        return ;
+    }
+#endif
+
+    // epoll will remove the closed socket automatically
+}
+tb_long_t tb_poller_wait(tb_poller_ref_t poller, tb_poller_event_func_t func, tb_long_t timeout)
+{
+    // check
+    tb_assert_and_check_return_val(poller, -1);
+
+#ifdef TB_POLLER_HAVE_IO_URING
+    if (tb_poller_linux_is_io_uring(poller)) return tb_poller_io_uring_wait(poller, func, timeout);
+#endif
+    return tb_poller_epoll_wait(poller, func, timeout);
+}
+tb_bool_t tb_poller_stat(tb_poller_ref_t poller, tb_poller_stat_t* stat)
+{
+    // check
+    tb_assert_and_check_return_val(poller && stat, tb_false);
+
+#ifdef TB_POLLER_HAVE_IO_URING
+    if (tb_poller_linux_is_io_uring(poller)) return tb_poller_io_uring_stat(poller, stat);
+#endif
+    return tb_poller_epoll_stat(poller, stat);
+}
+#ifdef __tb_debug__
+tb_void_t tb_poller_dump(tb_poller_ref_t poller)
+{
+    // check
+    tb_assert_and_check_return(poller);
+
+#ifdef TB_POLLER_HAVE_IO_URING
+    if (tb_poller_linux_is_io_uring(poller)) 
+    {
+        tb_poller_io_uring_dump(poller);
+        return ;
+    }
+#endif
+    tb_poller_epoll_dump(poller);
+}
+#endif
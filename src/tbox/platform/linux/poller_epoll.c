@@ -40,9 +40,32 @@
  * types
  */
 
+// the epoll poller socket entry type
+typedef struct __tb_poller_epoll_entry_t
+{
+    // the user private data
+    tb_cpointer_t           priv;
+
+    // the waited events, be zero if this socket has not been inserted
+    tb_uint16_t             events;
+
+    // the events registered to the kernel, be zero if this socket has not been added to epoll
+    tb_uint16_t             events_kernel;
+
+    // this socket has been removed and need be deleted from epoll before re-adding it
+    tb_uint16_t             reset   : 1;
+
+    // this socket has been queued to the changes
+    tb_uint16_t             queued  : 1;
+
+}tb_poller_epoll_entry_t;
+
 // the epoll poller type
 typedef struct __tb_poller_epoll_t
 {
+    // the poller type, must be the first member
+    tb_size_t               type;
+
     // the maxn
     tb_size_t               maxn;
 
@@ -61,18 +84,42 @@ typedef struct __tb_poller_epoll_t
     // the events count
     tb_size_t               events_count;
 
-    // the user private data hash (socket => priv)
-    tb_cpointer_t*          hash;
+    // the socket entries (socket fd => entry)
+    tb_poller_epoll_entry_t* entries;
+
+    // the socket entries size
+    tb_size_t               entries_size;
+
+    // the changed sockets, they will be applied to epoll in the next wait()
+    tb_int_t*               changes;
+
+    // the changed sockets count
+    tb_size_t               changes_count;
+
+    // the changed sockets maxn
+    tb_size_t               changes_maxn;
+
+    // the insert, remove and modify requests count
+    tb_size_t               ctl_requests;
+
+    // the real epoll_ctl calls count
+    tb_size_t               ctl_calls;
+
+    // the epoll_wait calls count
+    tb_size_t               wait_calls;
 
-    // the user private data hash size
-    tb_size_t               hash_size;
-    
 }tb_poller_epoll_t, *tb_poller_epoll_ref_t;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * declaration
+ */
+static tb_void_t tb_poller_epoll_exit(tb_poller_ref_t self);
+static tb_bool_t tb_poller_epoll_insert(tb_poller_ref_t self, tb_socket_ref_t sock, tb_size_t events, tb_cpointer_t priv);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
-static tb_size_t tb_poller_maxfds()
+static tb_size_t tb_poller_epoll_maxfds()
 {
     // attempt to get it from getdtablesize
     tb_size_t maxfds = 0;
@@ -93,65 +140,177 @@ static tb_size_t tb_poller_maxfds()
     // ok?
     return maxfds;
 }
-static tb_void_t tb_poller_hash_set(tb_poller_epoll_ref_t poller, tb_long_t fd, tb_cpointer_t priv)
+static tb_poller_epoll_entry_t* tb_poller_epoll_entry(tb_poller_epoll_ref_t poller, tb_long_t fd, tb_bool_t grow)
 {
     // check
     tb_assert(poller && fd > 0 && fd < TB_MAXS32);
 
-    // not null?
-    if (priv)
+    // exists?
+    if (fd < poller->entries_size) return &poller->entries[fd];
+    tb_check_return_val(grow, tb_null);
+
+    // grow entries
+    tb_size_t need = tb_align8(fd + 1);
+    poller->entries = (tb_poller_epoll_entry_t*)tb_ralloc(poller->entries, need * sizeof(tb_poller_epoll_entry_t));
+    tb_assert_and_check_return_val(poller->entries, tb_null);
+
+    // init the grown entries
+    tb_memset(poller->entries + poller->entries_size, 0, (need - poller->entries_size) * sizeof(tb_poller_epoll_entry_t));
+    poller->entries_size = need;
+
+    // ok
+    return &poller->entries[fd];
+}
+static tb_bool_t tb_poller_epoll_change(tb_poller_epoll_ref_t poller, tb_long_t fd, tb_poller_epoll_entry_t* entry)
+{
+    // check
+    tb_assert(poller && entry);
+
+    // this socket has been queued? it will be coalesced
+    tb_check_return_val(!entry->queued, tb_true);
+
+    // grow changes
+    if (poller->changes_count >= poller->changes_maxn)
     {
-        // no hash? init it first
-        tb_size_t need = fd + 1;
-        if (!poller->hash)
+        poller->changes_maxn = tb_align8(poller->changes_count + 1 + (poller->changes_count >> 1));
+        poller->changes = (tb_int_t*)tb_ralloc(poller->changes, poller->changes_maxn * sizeof(tb_int_t));
+        tb_assert_and_check_return_val(poller->changes, tb_false);
+    }
+
+    // queue this socket
+    poller->changes[poller->changes_count++] = (tb_int_t)fd;
+    entry->queued = 1;
+
+    // ok
+    return tb_true;
+}
+static tb_long_t tb_poller_epoll_ctl(tb_poller_epoll_ref_t poller, tb_int_t op, tb_long_t fd, tb_size_t events)
+{
+    // check
+    tb_assert(poller && poller->epfd > 0);
+
+    // init event
+    struct epoll_event e = {0};
+    if (events & TB_POLLER_EVENT_RECV) e.events |= EPOLLIN;
+    if (events & TB_POLLER_EVENT_SEND) e.events |= EPOLLOUT;
+    if (events & TB_POLLER_EVENT_CLEAR) e.events |= EPOLLET;
+#ifdef EPOLLONESHOT 
+    if (events & TB_POLLER_EVENT_ONESHOT) e.events |= EPOLLONESHOT;
+#endif
+
+    // save fd
+    e.data.fd = (tb_int_t)fd;
+
+    // update the epoll_ctl calls count
+    poller->ctl_calls++;
+
+    // control it
+    return epoll_ctl(poller->epfd, op, (tb_int_t)fd, &e) < 0? errno : 0;
+}
+static tb_void_t tb_poller_epoll_apply(tb_poller_epoll_ref_t poller, tb_poller_ref_t self, tb_poller_event_func_t func)
+{
+    // check
+    tb_assert(poller && poller->epfd > 0);
+
+    /* apply all changed sockets
+     *
+     * the error notification may queue new changes in the event function, 
+     * so we need get the changes count again and apply them in this pass
+     */
+    tb_size_t i = 0;
+    for (i = 0; i < poller->changes_count; i++)
+    {
+        // the socket entry, skip it if it has been dequeued (e.g. cleared)
+        tb_long_t                   fd = poller->changes[i];
+        tb_poller_epoll_entry_t*    entry = tb_poller_epoll_entry(poller, fd, tb_false);
+        tb_check_continue(entry && entry->queued);
+
+        // dequeue it
+        entry->queued = 0;
+
+        /* delete the previous socket first if it has been removed and re-inserted
+         *
+         * the previous socket may have been closed and this fd has been reused by the new socket,
+         * so we cannot only modify it
+         */
+        if (entry->reset && entry->events_kernel)
         {
-            // init hash
-            poller->hash = tb_nalloc0_type(need, tb_cpointer_t);
-            tb_assert_and_check_return(poller->hash);
+            tb_poller_epoll_ctl(poller, EPOLL_CTL_DEL, fd, 0);
+            entry->events_kernel = 0;
+        }
+        entry->reset = 0;
 
-            // init hash size
-            poller->hash_size = need;
+        // apply it
+        tb_long_t error = 0;
+        if (!entry->events)
+        {
+            /* delete it from epoll
+             *
+             * it may have been closed and removed by the kernel, so we ignore the error
+             */
+            if (entry->events_kernel) tb_poller_epoll_ctl(poller, EPOLL_CTL_DEL, fd, 0);
         }
-        else if (need > poller->hash_size)
+        else if (!entry->events_kernel)
         {
-            // grow hash
-            poller->hash = (tb_cpointer_t*)tb_ralloc(poller->hash, need * sizeof(tb_cpointer_t));
-            tb_assert_and_check_return(poller->hash);
-
-            // init growed space
-            tb_memset(poller->hash + poller->hash_size, 0, (need - poller->hash_size) * sizeof(tb_cpointer_t));
-
-            // grow hash size
-            poller->hash_size = need;
+            // add it to epoll, modify it if this fd has been added (e.g. dup)
+            error = tb_poller_epoll_ctl(poller, EPOLL_CTL_ADD, fd, entry->events);
+            if (error == EEXIST) error = tb_poller_epoll_ctl(poller, EPOLL_CTL_MOD, fd, entry->events);
+        }
+        else if (entry->events != entry->events_kernel || (entry->events & TB_POLLER_EVENT_ONESHOT))
+        {
+            // modify it, add it if the previous socket has been closed and removed by the kernel
+            error = tb_poller_epoll_ctl(poller, EPOLL_CTL_MOD, fd, entry->events);
+            if (error == ENOENT) error = tb_poller_epoll_ctl(poller, EPOLL_CTL_ADD, fd, entry->events);
         }
 
-        // save the user private data
-        poller->hash[fd] = priv;
+        // failed?
+        if (error)
+        {
+            // trace
+            tb_trace_e("apply socket(%p) events: %u failed, errno: %ld", tb_fd2sock(fd), entry->events, error);
+
+            // notify the error to the user, the caller will get it from recv/send
+            tb_cpointer_t priv = entry->priv;
+            entry->events           = 0;
+            entry->events_kernel    = 0;
+            entry->priv             = tb_null;
+            if (priv && func) func(self, tb_fd2sock(fd), TB_POLLER_EVENT_RECV | TB_POLLER_EVENT_SEND, priv);
+        }
+        // update the events registered to the kernel
+        else entry->events_kernel = entry->events;
     }
+
+    // all changes have been applied
+    poller->changes_count = 0;
 }
-static __tb_inline__ tb_cpointer_t tb_poller_hash_get(tb_poller_epoll_ref_t poller, tb_long_t fd)
+static tb_bool_t tb_poller_epoll_stat(tb_poller_ref_t self, tb_poller_stat_t* stat)
 {
     // check
-    tb_assert(poller && poller->hash);
-    tb_assert(fd > 0 && fd < TB_MAXS32);
+    tb_poller_epoll_ref_t poller = (tb_poller_epoll_ref_t)self;
+    tb_assert_and_check_return_val(poller && stat, tb_false);
 
-    // get the user private data
-    return fd < poller->hash_size? poller->hash[fd] : tb_null;
+    // get the statistics
+    stat->requests      = poller->ctl_requests;
+    stat->ctl_calls     = poller->ctl_calls;
+    stat->wait_calls    = poller->wait_calls;
+    return tb_true;
 }
-static __tb_inline__ tb_void_t tb_poller_hash_del(tb_poller_epoll_ref_t poller, tb_long_t fd)
+#ifdef __tb_debug__
+static tb_void_t tb_poller_epoll_dump(tb_poller_ref_t self)
 {
     // check
-    tb_assert(poller && poller->hash);
-    tb_assert(fd > 0 && fd < TB_MAXS32);
+    tb_poller_epoll_ref_t poller = (tb_poller_epoll_ref_t)self;
+    tb_assert_and_check_return(poller);
 
-    // remove the user private data
-    if (fd < poller->hash_size) poller->hash[fd] = tb_null;
+    // dump it
+    tb_trace_i("epoll: requests: %lu, epoll_ctl: %lu, saved: %ld, epoll_wait: %lu", poller->ctl_requests, poller->ctl_calls, (tb_long_t)(poller->ctl_requests - poller->ctl_calls), poller->wait_calls);
 }
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
-tb_poller_ref_t tb_poller_init(tb_cpointer_t priv)
+static tb_poller_ref_t tb_poller_epoll_init(tb_cpointer_t priv)
 {
     // done
     tb_bool_t               ok = tb_false;
@@ -162,8 +321,11 @@ tb_poller_ref_t tb_poller_init(tb_cpointer_t priv)
         poller = tb_malloc0_type(tb_poller_epoll_t);
         tb_assert_and_check_break(poller);
 
+        // init type
+        poller->type = TB_POLLER_LINUX_TYPE_EPOLL;
+
         // init maxn
-        poller->maxn = tb_poller_maxfds();
+        poller->maxn = tb_poller_epoll_maxfds();
         tb_assert_and_check_break(poller->maxn);
 
         // init epoll
@@ -177,7 +339,7 @@ tb_poller_ref_t tb_poller_init(tb_cpointer_t priv)
         if (!tb_socket_pair(TB_SOCKET_TYPE_TCP, poller->pair)) break;
 
         // insert pair socket first
-        if (!tb_poller_insert((tb_poller_ref_t)poller, poller->pair[1], TB_POLLER_EVENT_RECV, tb_null)) break;  
+        if (!tb_poller_epoll_insert((tb_poller_ref_t)poller, poller->pair[1], TB_POLLER_EVENT_RECV, tb_null)) break;  
 
         // ok
         ok = tb_true;
@@ -188,14 +350,14 @@ tb_poller_ref_t tb_poller_init(tb_cpointer_t priv)
     if (!ok)
     {
         // exit it
-        if (poller) tb_poller_exit((tb_poller_ref_t)poller);
+        if (poller) tb_poller_epoll_exit((tb_poller_ref_t)poller);
         poller = tb_null;
     }
 
     // ok?
     return (tb_poller_ref_t)poller;
 }
-tb_void_t tb_poller_exit(tb_poller_ref_t self)
+static tb_void_t tb_poller_epoll_exit(tb_poller_ref_t self)
 {
     // check
     tb_poller_epoll_ref_t poller = (tb_poller_epoll_ref_t)self;
@@ -207,10 +369,16 @@ tb_void_t tb_poller_exit(tb_poller_ref_t self)
     poller->pair[0] = tb_null;
     poller->pair[1] = tb_null;
 
-    // exit hash
-    if (poller->hash) tb_free(poller->hash);
-    poller->hash        = tb_null;
-    poller->hash_size   = 0;
+    // exit entries
+    if (poller->entries) tb_free(poller->entries);
+    poller->entries         = tb_null;
+    poller->entries_size    = 0;
+
+    // exit changes
+    if (poller->changes) tb_free(poller->changes);
+    poller->changes         = tb_null;
+    poller->changes_count   = 0;
+    poller->changes_maxn    = 0;
 
     // exit events
     if (poller->events) tb_free(poller->events);
@@ -224,7 +392,7 @@ tb_void_t tb_poller_exit(tb_poller_ref_t self)
     // free it
     tb_free(poller);
 }
-tb_void_t tb_poller_clear(tb_poller_ref_t self)
+static tb_void_t tb_poller_epoll_clear(tb_poller_ref_t self)
 {
     // check
     tb_poller_epoll_ref_t poller = (tb_poller_epoll_ref_t)self;
@@ -236,8 +404,18 @@ tb_void_t tb_poller_clear(tb_poller_ref_t self)
     // recreate a new epoll
     poller->epfd = epoll_create(poller->maxn);
     tb_assert(poller->epfd > 0);
+
+    /* clear all sockets
+     *
+     * the queued changes will be skipped in the next apply() because they have been dequeued, 
+     * and we need not drop them here if it is cleared in the event function of apply()
+     */
+    if (poller->entries) tb_memset(poller->entries, 0, poller->entries_size * sizeof(tb_poller_epoll_entry_t));
+
+    // re-insert the pair socket
+    if (poller->pair[1]) tb_poller_epoll_insert(self, poller->pair[1], TB_POLLER_EVENT_RECV, tb_null);
 }
-tb_cpointer_t tb_poller_priv(tb_poller_ref_t self)
+static tb_cpointer_t tb_poller_epoll_priv(tb_poller_ref_t self)
 {
     // check
     tb_poller_epoll_ref_t poller = (tb_poller_epoll_ref_t)self;
@@ -246,7 +424,7 @@ tb_cpointer_t tb_poller_priv(tb_poller_ref_t self)
     // get the user private data
     return poller->priv;
 }
-tb_void_t tb_poller_kill(tb_poller_ref_t self)
+static tb_void_t tb_poller_epoll_kill(tb_poller_ref_t self)
 {
     // check
     tb_poller_epoll_ref_t poller = (tb_poller_epoll_ref_t)self;
@@ -255,7 +433,7 @@ tb_void_t tb_poller_kill(tb_poller_ref_t self)
     // kill it
     if (poller->pair[0]) tb_socket_send(poller->pair[0], (tb_byte_t const*)"k", 1);
 }
-tb_void_t tb_poller_spak(tb_poller_ref_t self)
+static tb_void_t tb_poller_epoll_spak(tb_poller_ref_t self)
 {
     // check
     tb_poller_epoll_ref_t poller = (tb_poller_epoll_ref_t)self;
@@ -264,7 +442,7 @@ tb_void_t tb_poller_spak(tb_poller_ref_t self)
     // post it
     if (poller->pair[0]) tb_socket_send(poller->pair[0], (tb_byte_t const*)"p", 1);
 }
-tb_bool_t tb_poller_support(tb_poller_ref_t self, tb_size_t events)
+static tb_bool_t tb_poller_epoll_support(tb_poller_ref_t self, tb_size_t events)
 {
     // all supported events 
 #ifdef EPOLLONESHOT 
@@ -276,110 +454,116 @@ tb_bool_t tb_poller_support(tb_poller_ref_t self, tb_size_t events)
     // is supported?
     return (events_supported & events) == events;
 }
-tb_bool_t tb_poller_insert(tb_poller_ref_t self, tb_socket_ref_t sock, tb_size_t events, tb_cpointer_t priv)
+static tb_bool_t tb_poller_epoll_insert(tb_poller_ref_t self, tb_socket_ref_t sock, tb_size_t events, tb_cpointer_t priv)
 {
     // check
     tb_poller_epoll_ref_t poller = (tb_poller_epoll_ref_t)self;
-    tb_assert_and_check_return_val(poller && poller->epfd > 0 && sock, tb_false);
+    tb_assert_and_check_return_val(poller && poller->epfd > 0 && sock && (events & TB_POLLER_EVENT_EALL), tb_false);
 
-    // init event
-    struct epoll_event e = {0};
-    if (events & TB_POLLER_EVENT_RECV) e.events |= EPOLLIN;
-    if (events & TB_POLLER_EVENT_SEND) e.events |= EPOLLOUT;
-    if (events & TB_POLLER_EVENT_CLEAR) e.events |= EPOLLET;
-#ifdef EPOLLONESHOT 
-    if (events & TB_POLLER_EVENT_ONESHOT) e.events |= EPOLLONESHOT;
-#else
+#ifndef EPOLLONESHOT 
     // oneshot is not supported now
     tb_assertf(!(events & TB_POLLER_EVENT_ONESHOT), "cannot insert events with oneshot, not supported!");
 #endif
 
-    // save fd
-    e.data.fd = (tb_int_t)tb_sock2fd(sock);
-    
-    // bind user private data to socket
-    tb_poller_hash_set(poller, e.data.fd, priv);
-
-    // add socket and events
-    if (epoll_ctl(poller->epfd, EPOLL_CTL_ADD, e.data.fd, &e) < 0)
+    // get the socket entry
+    tb_long_t                   fd = tb_sock2fd(sock);
+    tb_poller_epoll_entry_t*    entry = tb_poller_epoll_entry(poller, fd, tb_true);
+    tb_assert_and_check_return_val(entry, tb_false);
+
+    /* exists? 
+     *
+     * the previous socket may have been closed without removing it and this fd has been reused by the new socket,
+     * so we override this stale entry and delete it from epoll before re-adding it
+     */
+    if (entry->events)
     {
         // trace
-        tb_trace_e("insert socket(%p) events: %lu failed, errno: %d", sock, events, errno);
-
-        // failed
-        return tb_false;
+        tb_trace_d("insert socket(%p) events: %lu, override the stale socket events: %u", sock, events, entry->events);
+        if (entry->events_kernel) entry->reset = 1;
     }
 
-    // ok
-    return tb_true;
+    // update the requests count
+    poller->ctl_requests++;
+
+    // bind events and user private data to socket
+    entry->events   = (tb_uint16_t)events;
+    entry->priv     = priv;
+
+    // queue this change, it will be applied in the next wait()
+    return tb_poller_epoll_change(poller, fd, entry);
 }
-tb_bool_t tb_poller_remove(tb_poller_ref_t self, tb_socket_ref_t sock)
+static tb_bool_t tb_poller_epoll_remove(tb_poller_ref_t self, tb_socket_ref_t sock)
 {
     // check
     tb_poller_epoll_ref_t poller = (tb_poller_epoll_ref_t)self;
     tb_assert_and_check_return_val(poller && poller->epfd > 0 && sock, tb_false);
 
-    // remove socket and events
-    struct epoll_event  e = {0};
-    tb_long_t           fd = tb_sock2fd(sock);
-    if (epoll_ctl(poller->epfd, EPOLL_CTL_DEL, fd, &e) < 0)
+    // get the socket entry
+    tb_long_t                   fd = tb_sock2fd(sock);
+    tb_poller_epoll_entry_t*    entry = tb_poller_epoll_entry(poller, fd, tb_false);
+    if (!entry || !entry->events)
     {
         // trace
-        tb_trace_e("remove socket(%p) failed, errno: %d", sock, errno);
-
-        // failed
+        tb_trace_e("remove socket(%p) failed, this socket has not been inserted!", sock);
         return tb_false;
     }
 
-    // remove user private data from this socket
-    tb_poller_hash_del(poller, fd);
-    
-    // ok
-    return tb_true;
+    // update the requests count
+    poller->ctl_requests++;
+
+    // remove events and user private data from this socket
+    entry->events   = 0;
+    entry->priv     = tb_null;
+    entry->reset    = entry->events_kernel? 1 : 0;
+
+    // queue this change, it will be applied in the next wait()
+    return tb_poller_epoll_change(poller, fd, entry);
 }
-tb_bool_t tb_poller_modify(tb_poller_ref_t self, tb_socket_ref_t sock, tb_size_t events, tb_cpointer_t priv)
+static tb_bool_t tb_poller_epoll_modify(tb_poller_ref_t self, tb_socket_ref_t sock, tb_size_t events, tb_cpointer_t priv)
 {
     // check
     tb_poller_epoll_ref_t poller = (tb_poller_epoll_ref_t)self;
-    tb_assert_and_check_return_val(poller && poller->epfd > 0 && sock, tb_false);
+    tb_assert_and_check_return_val(poller && poller->epfd > 0 && sock && (events & TB_POLLER_EVENT_EALL), tb_false);
 
-    // init event
-    struct epoll_event e = {0};
-    if (events & TB_POLLER_EVENT_RECV) e.events |= EPOLLIN;
-    if (events & TB_POLLER_EVENT_SEND) e.events |= EPOLLOUT;
-    if (events & TB_POLLER_EVENT_CLEAR) e.events |= EPOLLET;
-#ifdef EPOLLONESHOT 
-    if (events & TB_POLLER_EVENT_ONESHOT) e.events |= EPOLLONESHOT;
-#else
+#ifndef EPOLLONESHOT 
     // oneshot is not supported now
     tb_assertf(!(events & TB_POLLER_EVENT_ONESHOT), "cannot insert events with oneshot, not supported!");
 #endif
 
-    // save fd
-    e.data.fd = (tb_int_t)tb_sock2fd(sock);
-    
-    // modify user private data to socket
-    tb_poller_hash_set(poller, e.data.fd, priv);
-
-    // modify events
-    if (epoll_ctl(poller->epfd, EPOLL_CTL_MOD, e.data.fd, &e) < 0) 
+    // get the socket entry
+    tb_long_t                   fd = tb_sock2fd(sock);
+    tb_poller_epoll_entry_t*    entry = tb_poller_epoll_entry(poller, fd, tb_false);
+    if (!entry || !entry->events)
     {
         // trace
-        tb_trace_e("modify socket(%p) events: %lu failed, errno: %d", sock, events, errno);
-
-        // failed
+        tb_trace_e("modify socket(%p) events: %lu failed, this socket has not been inserted!", sock, events);
         return tb_false;
     }
 
-    // ok
-    return tb_true;
+    // update the requests count
+    poller->ctl_requests++;
+
+    // modify user private data to socket
+    entry->priv = priv;
+
+    // the events have not been changed? we need not modify it (except for re-arming oneshot)
+    if (entry->events == events && !(events & TB_POLLER_EVENT_ONESHOT)) return tb_true;
+
+    // modify events
+    entry->events = (tb_uint16_t)events;
+
+    // queue this change, it will be applied in the next wait()
+    return tb_poller_epoll_change(poller, fd, entry);
 }
-tb_long_t tb_poller_wait(tb_poller_ref_t self, tb_poller_event_func_t func, tb_long_t timeout)
+static tb_long_t tb_poller_epoll_wait(tb_poller_ref_t self, tb_poller_event_func_t func, tb_long_t timeout)
 {
     // check
     tb_poller_epoll_ref_t poller = (tb_poller_epoll_ref_t)self;
     tb_assert_and_check_return_val(poller && poller->epfd > 0 && poller->maxn && func, -1);
 
+    // apply the changed sockets first
+    if (poller->changes_count) tb_poller_epoll_apply(poller, self, func);
+
     // init events
     tb_size_t grow = tb_align8((poller->maxn >> 3) + 1);
     if (!poller->events)
@@ -388,6 +572,9 @@ tb_long_t tb_poller_wait(tb_poller_ref_t self, tb_poller_event_func_t func, tb_l
         poller->events = tb_nalloc_type(poller->events_count, struct epoll_event);
         tb_assert_and_check_return_val(poller->events, -1);
     }
+
+    // update the epoll_wait calls count
+    poller->wait_calls++;
     
     // wait events
     tb_long_t events_count = epoll_wait(poller->epfd, poller->events, poller->events_count, timeout);
@@ -451,6 +638,10 @@ tb_long_t tb_poller_wait(tb_poller_ref_t self, tb_poller_event_func_t func, tb_l
         // skip spak
         tb_check_continue(sock != pair);
 
+        // the socket entry, skip it if this socket has been removed in the previous event function
+        tb_poller_epoll_entry_t* entry = tb_poller_epoll_entry(poller, fd, tb_false);
+        tb_check_continue(entry && entry->events);
+
         // init events 
         tb_size_t events = TB_POLLER_EVENT_NONE;
         if (epoll_events & EPOLLIN) events |= TB_POLLER_EVENT_RECV;
@@ -464,7 +655,7 @@ tb_long_t tb_poller_wait(tb_poller_ref_t self, tb_poller_event_func_t func, tb_l
 #endif
 
         // call event function
-        func(self, sock, events, tb_poller_hash_get(poller, fd));
+        func(self, sock, events, entry->priv);
 
         // update the events count
         wait++;
@@ -473,4 +664,3 @@ tb_long_t tb_poller_wait(tb_poller_ref_t self, tb_poller_event_func_t func, tb_l
     // ok
     return wait;
 }
-
@@ -0,0 +1,888 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        poller_io_uring.c
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../barrier.h"
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <sys/poll.h>
+#include <signal.h>
+#include <errno.h>
+#include <unistd.h>
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the submission queue entries count
+#ifdef __tb_small__
+#   define TB_POLLER_IO_URING_ENTRIES           (64)
+#else
+#   define TB_POLLER_IO_URING_ENTRIES           (1024)
+#endif
+
+// the user data flag of the internal requests (e.g. poll remove), their completions will be ignored
+#define TB_POLLER_IO_URING_DATA_SKIP            ((tb_uint64_t)1 << 63)
+
+// the user data flag of the io operation, the operation address is aligned and we use the lowest bit for it
+#define TB_POLLER_IO_URING_DATA_OP              ((tb_uint64_t)1)
+
+// make the user data of the poll request from the socket fd and the request sequence
+#define tb_poller_io_uring_data(fd, seq)        ((((tb_uint64_t)(seq) & 0x7fffffff) << 32) | ((tb_uint64_t)(tb_uint32_t)(fd) << 1))
+
+// get the socket fd from the user data of the poll request
+#define tb_poller_io_uring_data_fd(data)        ((tb_long_t)(((tb_uint32_t)(data)) >> 1))
+
+// make the user data of the io operation
+#define tb_poller_io_uring_data_op(op)          ((tb_uint64_t)(tb_size_t)(op) | TB_POLLER_IO_URING_DATA_OP)
+
+// get the fd of the io operation
+#define tb_poller_io_uring_op_fd(op)            (((op)->code == TB_POLLER_OP_CODE_READ || (op)->code == TB_POLLER_OP_CODE_WRITE)? (tb_long_t)tb_file2fd((tb_file_ref_t)(op)->ref) : tb_sock2fd((tb_socket_ref_t)(op)->ref))
+
+// load the ring index updated by kernel
+#define tb_poller_io_uring_load(p)              tb_poller_io_uring_load_impl(p)
+
+// store the ring index for kernel
+#define tb_poller_io_uring_store(p, v)          do { tb_barrier(); *(p) = (v); } while (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the io_uring poller socket entry type
+typedef struct __tb_poller_io_uring_entry_t
+{
+    // the user private data
+    tb_cpointer_t               priv;
+
+    // the sequence of the current poll request, the completions of the stale requests will be ignored
+    tb_uint32_t                 seq;
+
+    // the waited events, be zero if this socket has not been inserted
+    tb_uint16_t                 events;
+
+    // has the poll request been armed?
+    tb_uint16_t                 armed;
+
+    // the pending io operations count of this fd
+    tb_uint32_t                 ops;
+
+}tb_poller_io_uring_entry_t;
+
+// the io_uring poller type
+typedef struct __tb_poller_io_uring_t
+{
+    // the poller type, must be the first member
+    tb_size_t                   type;
+
+    // the user private data
+    tb_cpointer_t               priv;
+
+    // the pair sockets for spak, kill ..
+    tb_socket_ref_t             pair[2];
+
+    // the ring fd
+    tb_long_t                   fd;
+
+    // the supported events
+    tb_size_t                   events_supported;
+
+    // the submission queue ring
+    tb_byte_t*                  sq_ring;
+    tb_size_t                   sq_ring_size;
+    tb_uint32_t volatile*       sq_head;
+    tb_uint32_t volatile*       sq_tail;
+    tb_uint32_t                 sq_mask;
+    tb_uint32_t                 sq_entries;
+
+    // the local tail of submission queue, the pending requests will be submitted in batches in wait()
+    tb_uint32_t                 sq_tail_local;
+
+    // the submission queue entries
+    struct io_uring_sqe*        sqes;
+    tb_size_t                   sqes_size;
+
+    // the completion queue ring, it may be shared with the submission queue ring
+    tb_byte_t*                  cq_ring;
+    tb_size_t                   cq_ring_size;
+    tb_uint32_t volatile*       cq_head;
+    tb_uint32_t volatile*       cq_tail;
+    tb_uint32_t                 cq_mask;
+    struct io_uring_cqe*        cqes;
+
+    // the socket entries (socket fd => entry)
+    tb_poller_io_uring_entry_t* entries;
+
+    // the socket entries size
+    tb_size_t                   entries_size;
+
+    // the insert, remove and modify requests count
+    tb_size_t                   ctl_requests;
+
+    // the posted io operations count
+    tb_size_t                   op_requests;
+
+    // the posted submission entries count
+    tb_size_t                   sqe_count;
+
+    // the io_uring_enter calls count for submitting the requests only, e.g. the submission queue is full
+    tb_size_t                   submit_calls;
+
+    // the io_uring_enter calls count in wait()
+    tb_size_t                   wait_calls;
+
+}tb_poller_io_uring_t, *tb_poller_io_uring_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * declaration
+ */
+static tb_void_t tb_poller_io_uring_exit(tb_poller_ref_t self);
+static tb_bool_t tb_poller_io_uring_insert(tb_poller_ref_t self, tb_socket_ref_t sock, tb_size_t events, tb_cpointer_t priv);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_uint32_t tb_poller_io_uring_load_impl(tb_uint32_t volatile* p)
+{
+    tb_uint32_t v = *p;
+    tb_barrier();
+    return v;
+}
+static __tb_inline__ tb_long_t tb_poller_io_uring_enter(tb_poller_io_uring_ref_t poller, tb_uint32_t to_submit, tb_uint32_t min_complete, tb_uint32_t flags, tb_pointer_t arg, tb_size_t argsz)
+{
+    return (tb_long_t)syscall(__NR_io_uring_enter, (tb_int_t)poller->fd, to_submit, min_complete, flags, arg, argsz);
+}
+static tb_bool_t tb_poller_io_uring_submit(tb_poller_io_uring_ref_t poller)
+{
+    // check
+    tb_assert(poller && poller->fd >= 0);
+
+    // publish the pending requests
+    tb_poller_io_uring_store(poller->sq_tail, poller->sq_tail_local);
+
+    // submit them
+    tb_uint32_t to_submit = 0;
+    while ((to_submit = poller->sq_tail_local - tb_poller_io_uring_load(poller->sq_head)))
+    {
+        // update the submitting calls count
+        poller->submit_calls++;
+
+        // submit it
+        if (tb_poller_io_uring_enter(poller, to_submit, 0, 0, tb_null, 0) < 0)
+        {
+            // interrupted? continue it
+            if (errno == EINTR) continue;
+
+            // the completion queue is overflow? we need reap the completions first
+            if (errno == EBUSY || errno == EAGAIN) return tb_false;
+
+            // trace
+            tb_trace_e("submit %u requests failed, errno: %d", to_submit, errno);
+            return tb_false;
+        }
+    }
+
+    // ok
+    return tb_true;
+}
+static struct io_uring_sqe* tb_poller_io_uring_sqe(tb_poller_io_uring_ref_t poller)
+{
+    // check
+    tb_assert(poller && poller->sqes);
+
+    // the submission queue is full? submit the pending requests first
+    if (poller->sq_tail_local - tb_poller_io_uring_load(poller->sq_head) >= poller->sq_entries)
+    {
+        tb_poller_io_uring_submit(poller);
+        tb_check_return_val(poller->sq_tail_local - tb_poller_io_uring_load(poller->sq_head) < poller->sq_entries, tb_null);
+    }
+
+    // get a free entry, the sq array has been mapped to the entries one by one in init()
+    struct io_uring_sqe* sqe = &poller->sqes[poller->sq_tail_local & poller->sq_mask];
+
+    // clear it, the sqes are mapped from kernel and we cannot use the checked tb_memset() for them
+    tb_memset_(sqe, 0, sizeof(struct io_uring_sqe));
+    poller->sq_tail_local++;
+
+    // update the posted submission entries count
+    poller->sqe_count++;
+    return sqe;
+}
+static tb_poller_io_uring_entry_t* tb_poller_io_uring_entry(tb_poller_io_uring_ref_t poller, tb_long_t fd, tb_bool_t grow)
+{
+    // check
+    tb_assert(poller && fd > 0 && fd < TB_MAXS32);
+
+    // exists?
+    if (fd < poller->entries_size) return &poller->entries[fd];
+    tb_check_return_val(grow, tb_null);
+
+    // grow entries
+    tb_size_t need = tb_align8(fd + 1);
+    poller->entries = (tb_poller_io_uring_entry_t*)tb_ralloc(poller->entries, need * sizeof(tb_poller_io_uring_entry_t));
+    tb_assert_and_check_return_val(poller->entries, tb_null);
+
+    // init the grown entries
+    tb_memset(poller->entries + poller->entries_size, 0, (need - poller->entries_size) * sizeof(tb_poller_io_uring_entry_t));
+    poller->entries_size = need;
+
+    // ok
+    return &poller->entries[fd];
+}
+static tb_bool_t tb_poller_io_uring_poll_add(tb_poller_io_uring_ref_t poller, tb_long_t fd, tb_poller_io_uring_entry_t* entry)
+{
+    // check
+    tb_assert(poller && entry && entry->events && !entry->armed);
+
+    // get a submission entry
+    struct io_uring_sqe* sqe = tb_poller_io_uring_sqe(poller);
+    tb_assert_and_check_return_val(sqe, tb_false);
+
+    // init the poll events
+    tb_uint32_t events = 0;
+    if (entry->events & TB_POLLER_EVENT_RECV) events |= POLLIN;
+    if (entry->events & TB_POLLER_EVENT_SEND) events |= POLLOUT;
+#ifdef TB_WORDS_BIGENDIAN
+    events = (events << 16) | (events >> 16);
+#endif
+
+    // init the poll request
+    sqe->opcode         = IORING_OP_POLL_ADD;
+    sqe->fd             = (tb_int_t)fd;
+    sqe->poll32_events  = events;
+    sqe->user_data      = tb_poller_io_uring_data(fd, entry->seq);
+
+#ifdef IORING_POLL_ADD_MULTI
+    /* use the multishot poll request for the edge trigger
+     *
+     * it will post a completion once the socket becomes ready and we need not re-arm it
+     */
+    if ((entry->events & TB_POLLER_EVENT_CLEAR) && !(entry->events & TB_POLLER_EVENT_ONESHOT))
+        sqe->len = IORING_POLL_ADD_MULTI;
+#endif
+
+    // armed
+    entry->armed = 1;
+    return tb_true;
+}
+static tb_bool_t tb_poller_io_uring_poll_del(tb_poller_io_uring_ref_t poller, tb_long_t fd, tb_poller_io_uring_entry_t* entry)
+{
+    // check
+    tb_assert(poller && entry);
+
+    // cancel the armed poll request
+    if (entry->armed)
+    {
+        // get a submission entry
+        struct io_uring_sqe* sqe = tb_poller_io_uring_sqe(poller);
+        tb_assert_and_check_return_val(sqe, tb_false);
+
+        // init the poll remove request
+        sqe->opcode     = IORING_OP_POLL_REMOVE;
+        sqe->fd         = -1;
+        sqe->addr       = tb_poller_io_uring_data(fd, entry->seq);
+        sqe->user_data  = TB_POLLER_IO_URING_DATA_SKIP;
+        entry->armed    = 0;
+    }
+
+    // the pending completions of the previous request will be stale
+    entry->seq++;
+    return tb_true;
+}
+static tb_bool_t tb_poller_io_uring_stat(tb_poller_ref_t self, tb_poller_stat_t* stat)
+{
+    // check
+    tb_poller_io_uring_ref_t poller = (tb_poller_io_uring_ref_t)self;
+    tb_assert_and_check_return_val(poller && stat, tb_false);
+
+    // get the statistics, the requests are submitted in wait() and only the full submission queue need be submitted directly
+    stat->requests      = poller->ctl_requests + poller->op_requests;
+    stat->ctl_calls     = poller->submit_calls;
+    stat->wait_calls    = poller->wait_calls;
+    return tb_true;
+}
+#ifdef __tb_debug__
+static tb_void_t tb_poller_io_uring_dump(tb_poller_ref_t self)
+{
+    // check
+    tb_poller_io_uring_ref_t poller = (tb_poller_io_uring_ref_t)self;
+    tb_assert_and_check_return(poller);
+
+    // dump it
+    tb_trace_i("io_uring: requests: %lu, ops: %lu, sqes: %lu, io_uring_enter: %lu (submit: %lu, wait: %lu)", poller->ctl_requests, poller->op_requests, poller->sqe_count, poller->submit_calls + poller->wait_calls, poller->submit_calls, poller->wait_calls);
+}
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tb_poller_ref_t tb_poller_io_uring_init(tb_cpointer_t priv)
+{
+    // done
+    tb_bool_t                   ok = tb_false;
+    tb_poller_io_uring_ref_t    poller = tb_null;
+    do
+    {
+        // make poller
+        poller = tb_malloc0_type(tb_poller_io_uring_t);
+        tb_assert_and_check_break(poller);
+
+        // init type
+        poller->type = TB_POLLER_LINUX_TYPE_IO_URING;
+
+        // init user private data
+        poller->priv = priv;
+
+        // init io_uring, it may be not supported or disabled by the current kernel
+        struct io_uring_params params;
+        tb_memset(&params, 0, sizeof(params));
+        poller->fd = (tb_long_t)syscall(__NR_io_uring_setup, TB_POLLER_IO_URING_ENTRIES, &params);
+        if (poller->fd < 0)
+        {
+            // trace
+            tb_trace_d("io_uring is not supported, errno: %d", errno);
+            break;
+        }
+
+        // we need wait completions with timeout (>= linux 5.11)
+        if (!(params.features & IORING_FEAT_EXT_ARG))
+        {
+            // trace
+            tb_trace_d("io_uring is too old, features: %x", params.features);
+            break;
+        }
+
+        // map the submission queue ring
+        poller->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(tb_uint32_t);
+        poller->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+        if (params.features & IORING_FEAT_SINGLE_MMAP) 
+            poller->sq_ring_size = poller->cq_ring_size = tb_max(poller->sq_ring_size, poller->cq_ring_size);
+        poller->sq_ring = (tb_byte_t*)mmap(tb_null, poller->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, poller->fd, IORING_OFF_SQ_RING);
+        if (poller->sq_ring == MAP_FAILED) 
+        {
+            poller->sq_ring = tb_null;
+            break;
+        }
+
+        // map the completion queue ring
+        if (params.features & IORING_FEAT_SINGLE_MMAP) poller->cq_ring = poller->sq_ring;
+        else
+        {
+            poller->cq_ring = (tb_byte_t*)mmap(tb_null, poller->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, poller->fd, IORING_OFF_CQ_RING);
+            if (poller->cq_ring == MAP_FAILED) 
+            {
+                poller->cq_ring = tb_null;
+                break;
+            }
+        }
+
+        // map the submission queue entries
+        poller->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+        poller->sqes = (struct io_uring_sqe*)mmap(tb_null, poller->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, poller->fd, IORING_OFF_SQES);
+        if (poller->sqes == MAP_FAILED) 
+        {
+            poller->sqes = tb_null;
+            break;
+        }
+
+        // init the submission queue
+        poller->sq_head         = (tb_uint32_t volatile*)(poller->sq_ring + params.sq_off.head);
+        poller->sq_tail         = (tb_uint32_t volatile*)(poller->sq_ring + params.sq_off.tail);
+        poller->sq_mask         = *(tb_uint32_t*)(poller->sq_ring + params.sq_off.ring_mask);
+        poller->sq_entries      = *(tb_uint32_t*)(poller->sq_ring + params.sq_off.ring_entries);
+        poller->sq_tail_local   = *poller->sq_tail;
+
+        // map the sq array to the submission queue entries one by one
+        tb_uint32_t  i = 0;
+        tb_uint32_t* sq_array = (tb_uint32_t*)(poller->sq_ring + params.sq_off.array);
+        for (i = 0; i < poller->sq_entries; i++) sq_array[i] = i;
+
+        // init the completion queue
+        poller->cq_head         = (tb_uint32_t volatile*)(poller->cq_ring + params.cq_off.head);
+        poller->cq_tail         = (tb_uint32_t volatile*)(poller->cq_ring + params.cq_off.tail);
+        poller->cq_mask         = *(tb_uint32_t*)(poller->cq_ring + params.cq_off.ring_mask);
+        poller->cqes            = (struct io_uring_cqe*)(poller->cq_ring + params.cq_off.cqes);
+
+        // init the supported events, the multishot poll request is supported since linux 5.13 (with rsrc tags)
+        poller->events_supported = TB_POLLER_EVENT_EALL | TB_POLLER_EVENT_ONESHOT | TB_POLLER_EVENT_COMP;
+#if defined(IORING_POLL_ADD_MULTI) && defined(IORING_FEAT_RSRC_TAGS)
+        if (params.features & IORING_FEAT_RSRC_TAGS) poller->events_supported |= TB_POLLER_EVENT_CLEAR;
+#endif
+
+        // init pair sockets
+        if (!tb_socket_pair(TB_SOCKET_TYPE_TCP, poller->pair)) break;
+
+        // insert pair socket first
+        if (!tb_poller_io_uring_insert((tb_poller_ref_t)poller, poller->pair[1], TB_POLLER_EVENT_RECV, tb_null)) break;  
+
+        // trace
+        tb_trace_d("init io_uring: sq: %u, cq: %u, features: %x", params.sq_entries, params.cq_entries, params.features);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (poller) tb_poller_io_uring_exit((tb_poller_ref_t)poller);
+        poller = tb_null;
+    }
+
+    // ok?
+    return (tb_poller_ref_t)poller;
+}
+static tb_void_t tb_poller_io_uring_exit(tb_poller_ref_t self)
+{
+    // check
+    tb_poller_io_uring_ref_t poller = (tb_poller_io_uring_ref_t)self;
+    tb_assert_and_check_return(poller);
+
+    // exit pair sockets
+    if (poller->pair[0]) tb_socket_exit(poller->pair[0]);
+    if (poller->pair[1]) tb_socket_exit(poller->pair[1]);
+    poller->pair[0] = tb_null;
+    poller->pair[1] = tb_null;
+
+    // exit entries
+    if (poller->entries) tb_free(poller->entries);
+    poller->entries         = tb_null;
+    poller->entries_size    = 0;
+
+    // unmap the rings
+    if (poller->sqes) munmap(poller->sqes, poller->sqes_size);
+    if (poller->cq_ring && poller->cq_ring != poller->sq_ring) munmap(poller->cq_ring, poller->cq_ring_size);
+    if (poller->sq_ring) munmap(poller->sq_ring, poller->sq_ring_size);
+    poller->sqes    = tb_null;
+    poller->cq_ring = tb_null;
+    poller->sq_ring = tb_null;
+
+    // close the ring fd, all armed poll requests will be cancelled
+    if (poller->fd >= 0) close(poller->fd);
+    poller->fd = -1;
+
+    // free it
+    tb_free(poller);
+}
+static tb_void_t tb_poller_io_uring_clear(tb_poller_ref_t self)
+{
+    // check
+    tb_poller_io_uring_ref_t poller = (tb_poller_io_uring_ref_t)self;
+    tb_assert_and_check_return(poller);
+
+    // remove all sockets
+    tb_size_t i = 0;
+    for (i = 0; i < poller->entries_size; i++)
+    {
+        tb_poller_io_uring_entry_t* entry = &poller->entries[i];
+        if (entry->events)
+        {
+            tb_poller_io_uring_poll_del(poller, i, entry);
+            entry->events   = 0;
+            entry->priv     = tb_null;
+        }
+    }
+
+    // re-insert the pair socket
+    if (poller->pair[1]) tb_poller_io_uring_insert(self, poller->pair[1], TB_POLLER_EVENT_RECV, tb_null);
+}
+static tb_cpointer_t tb_poller_io_uring_priv(tb_poller_ref_t self)
+{
+    // check
+    tb_poller_io_uring_ref_t poller = (tb_poller_io_uring_ref_t)self;
+    tb_assert_and_check_return_val(poller, tb_null);
+
+    // get the user private data
+    return poller->priv;
+}
+static tb_void_t tb_poller_io_uring_kill(tb_poller_ref_t self)
+{
+    // check
+    tb_poller_io_uring_ref_t poller = (tb_poller_io_uring_ref_t)self;
+    tb_assert_and_check_return(poller);
+
+    // kill it
+    if (poller->pair[0]) tb_socket_send(poller->pair[0], (tb_byte_t const*)"k", 1);
+}
+static tb_void_t tb_poller_io_uring_spak(tb_poller_ref_t self)
+{
+    // check
+    tb_poller_io_uring_ref_t poller = (tb_poller_io_uring_ref_t)self;
+    tb_assert_and_check_return(poller);
+
+    // post it
+    if (poller->pair[0]) tb_socket_send(poller->pair[0], (tb_byte_t const*)"p", 1);
+}
+static tb_bool_t tb_poller_io_uring_support(tb_poller_ref_t self, tb_size_t events)
+{
+    // check
+    tb_poller_io_uring_ref_t poller = (tb_poller_io_uring_ref_t)self;
+    tb_assert_and_check_return_val(poller, tb_false);
+
+    // is supported?
+    return (poller->events_supported & events) == events;
+}
+static tb_bool_t tb_poller_io_uring_insert(tb_poller_ref_t self, tb_socket_ref_t sock, tb_size_t events, tb_cpointer_t priv)
+{
+    // check
+    tb_poller_io_uring_ref_t poller = (tb_poller_io_uring_ref_t)self;
+    tb_assert_and_check_return_val(poller && poller->fd >= 0 && sock && (events & TB_POLLER_EVENT_EALL), tb_false);
+
+    // get the socket entry
+    tb_long_t                   fd = tb_sock2fd(sock);
+    tb_poller_io_uring_entry_t* entry = tb_poller_io_uring_entry(poller, fd, tb_true);
+    tb_assert_and_check_return_val(entry, tb_false);
+
+    /* exists?
+     *
+     * the previous socket may have been closed without removing it and this fd has been reused by the new socket,
+     * so we override this stale entry and cancel its poll request before posting the new one
+     */
+    if (entry->events)
+    {
+        // trace
+        tb_trace_d("insert socket(%p) events: %lu, override the stale socket events: %u", sock, events, entry->events);
+        if (!tb_poller_io_uring_poll_del(poller, fd, entry)) return tb_false;
+    }
+
+    // update the requests count
+    poller->ctl_requests++;
+
+    // save events and the user private data
+    entry->events   = (tb_uint16_t)events;
+    entry->priv     = priv;
+
+    // post the poll request, it will be submitted in wait()
+    return tb_poller_io_uring_poll_add(poller, fd, entry);
+}
+static tb_bool_t tb_poller_io_uring_remove(tb_poller_ref_t self, tb_socket_ref_t sock)
+{
+    // check
+    tb_poller_io_uring_ref_t poller = (tb_poller_io_uring_ref_t)self;
+    tb_assert_and_check_return_val(poller && poller->fd >= 0 && sock, tb_false);
+
+    // get the socket entry
+    tb_long_t                   fd = tb_sock2fd(sock);
+    tb_poller_io_uring_entry_t* entry = tb_poller_io_uring_entry(poller, fd, tb_false);
+    if (!entry || !entry->events)
+    {
+        // trace
+        tb_trace_e("remove socket(%p) failed, this socket has not been inserted!", sock);
+        return tb_false;
+    }
+
+    // update the requests count
+    poller->ctl_requests++;
+
+    // remove the user private data from this socket
+    entry->events   = 0;
+    entry->priv     = tb_null;
+
+    // cancel the poll request
+    return tb_poller_io_uring_poll_del(poller, fd, entry);
+}
+static tb_bool_t tb_poller_io_uring_modify(tb_poller_ref_t self, tb_socket_ref_t sock, tb_size_t events, tb_cpointer_t priv)
+{
+    // check
+    tb_poller_io_uring_ref_t poller = (tb_poller_io_uring_ref_t)self;
+    tb_assert_and_check_return_val(poller && poller->fd >= 0 && sock && (events & TB_POLLER_EVENT_EALL), tb_false);
+
+    // get the socket entry
+    tb_long_t                   fd = tb_sock2fd(sock);
+    tb_poller_io_uring_entry_t* entry = tb_poller_io_uring_entry(poller, fd, tb_false);
+    if (!entry || !entry->events)
+    {
+        // trace
+        tb_trace_e("modify socket(%p) events: %lu failed, this socket has not been inserted!", sock, events);
+        return tb_false;
+    }
+
+    // update the requests count
+    poller->ctl_requests++;
+
+    // modify the user private data
+    entry->priv = priv;
+
+    // the events have not been changed and the poll request is armed? ok
+    if (entry->events == events && entry->armed) return tb_true;
+
+    // cancel the previous poll request
+    if (!tb_poller_io_uring_poll_del(poller, fd, entry)) return tb_false;
+
+    // post the new poll request
+    entry->events = (tb_uint16_t)events;
+    return tb_poller_io_uring_poll_add(poller, fd, entry);
+}
+static tb_bool_t tb_poller_io_uring_post(tb_poller_ref_t self, tb_poller_op_ref_t op)
+{
+    // check
+    tb_poller_io_uring_ref_t poller = (tb_poller_io_uring_ref_t)self;
+    tb_assert_and_check_return_val(poller && poller->fd >= 0 && op && op->ref && op->data, tb_false);
+    tb_assert_and_check_return_val(op->code > TB_POLLER_OP_CODE_NONE && op->code <= TB_POLLER_OP_CODE_WRITE, tb_false);
+    tb_assert_and_check_return_val(!((tb_size_t)op & TB_POLLER_IO_URING_DATA_OP), tb_false);
+
+    // get the fd entry
+    tb_long_t                   fd = tb_poller_io_uring_op_fd(op);
+    tb_poller_io_uring_entry_t* entry = tb_poller_io_uring_entry(poller, fd, tb_true);
+    tb_assert_and_check_return_val(entry, tb_false);
+
+    // get a submission entry
+    struct io_uring_sqe* sqe = tb_poller_io_uring_sqe(poller);
+    tb_check_return_val(sqe, tb_false);
+
+    // init the io request
+    switch (op->code)
+    {
+    case TB_POLLER_OP_CODE_RECV:
+        sqe->opcode     = IORING_OP_RECV;
+        break;
+    case TB_POLLER_OP_CODE_SEND:
+        sqe->opcode     = IORING_OP_SEND;
+        break;
+    case TB_POLLER_OP_CODE_READ:
+        sqe->opcode     = IORING_OP_READ;
+        sqe->off        = op->offset;
+        break;
+    case TB_POLLER_OP_CODE_WRITE:
+        sqe->opcode     = IORING_OP_WRITE;
+        sqe->off        = op->offset;
+        break;
+    default:
+        break;
+    }
+    sqe->fd         = (tb_int_t)fd;
+    sqe->addr       = (tb_uint64_t)(tb_size_t)op->data;
+    sqe->len        = (tb_uint32_t)tb_min(op->size, TB_MAXU32);
+    sqe->user_data  = tb_poller_io_uring_data_op(op);
+
+    // it will be submitted with the other pending requests in wait()
+    op->real = -1;
+    entry->ops++;
+
+    // update the io operations count
+    poller->op_requests++;
+
+    // ok
+    return tb_true;
+}
+static tb_bool_t tb_poller_io_uring_post_cancel(tb_poller_ref_t self, tb_poller_op_ref_t op)
+{
+    // check
+    tb_poller_io_uring_ref_t poller = (tb_poller_io_uring_ref_t)self;
+    tb_assert_and_check_return_val(poller && poller->fd >= 0 && op, tb_false);
+
+    // get a submission entry
+    struct io_uring_sqe* sqe = tb_poller_io_uring_sqe(poller);
+    tb_check_return_val(sqe, tb_false);
+
+    /* cancel it, the operation will be completed with -ECANCELED
+     *
+     * it may have been finished before cancelling and we only ignore the completion of the cancel request
+     */
+    sqe->opcode     = IORING_OP_ASYNC_CANCEL;
+    sqe->fd         = -1;
+    sqe->addr       = tb_poller_io_uring_data_op(op);
+    sqe->user_data  = TB_POLLER_IO_URING_DATA_SKIP;
+    return tb_true;
+}
+static tb_void_t tb_poller_io_uring_cancel(tb_poller_ref_t self, tb_socket_ref_t sock)
+{
+    // check
+    tb_poller_io_uring_ref_t poller = (tb_poller_io_uring_ref_t)self;
+    tb_assert_and_check_return(poller && poller->fd >= 0 && sock);
+
+    // get the socket entry
+    tb_long_t                   fd = tb_sock2fd(sock);
+    tb_poller_io_uring_entry_t* entry = tb_poller_io_uring_entry(poller, fd, tb_false);
+    if (entry)
+    {
+        // cancel the armed poll request, the waited events are still kept and it will be re-armed after modifying it
+        if (entry->armed) tb_poller_io_uring_poll_del(poller, fd, entry);
+
+#ifdef IORING_ASYNC_CANCEL_FD
+        // cancel all pending io operations of this socket (>= linux 5.19)
+        struct io_uring_sqe* sqe = tb_null;
+        if (entry->ops && (sqe = tb_poller_io_uring_sqe(poller)))
+        {
+            sqe->opcode         = IORING_OP_ASYNC_CANCEL;
+            sqe->fd             = (tb_int_t)fd;
+            sqe->cancel_flags   = IORING_ASYNC_CANCEL_FD | IORING_ASYNC_CANCEL_ALL;
+            sqe->user_data      = TB_POLLER_IO_URING_DATA_SKIP;
+        }
+#endif
+    }
+
+    /* submit the pending requests (e.g. the poll remove requests from tb_poller_remove()) now,
+     * the requests hold the socket reference and this socket will be closed soon
+     */
+    if (poller->sq_tail_local != *poller->sq_tail) tb_poller_io_uring_submit(poller);
+}
+static tb_long_t tb_poller_io_uring_wait(tb_poller_ref_t self, tb_poller_event_func_t func, tb_long_t timeout)
+{
+    // check
+    tb_poller_io_uring_ref_t poller = (tb_poller_io_uring_ref_t)self;
+    tb_assert_and_check_return_val(poller && poller->fd >= 0 && func, -1);
+
+    // publish the pending requests
+    tb_poller_io_uring_store(poller->sq_tail, poller->sq_tail_local);
+
+    // the pending requests count
+    tb_uint32_t to_submit = poller->sq_tail_local - tb_poller_io_uring_load(poller->sq_head);
+
+    // need wait completions? 
+    tb_uint32_t flags = 0;
+    tb_uint32_t min_complete = 0;
+    struct __kernel_timespec ts;
+    struct io_uring_getevents_arg arg;
+    tb_memset(&arg, 0, sizeof(arg));
+    if (timeout && tb_poller_io_uring_load(poller->cq_tail) == *poller->cq_head)
+    {
+        // init timeout, wait it infinitely if timeout < 0
+        if (timeout > 0)
+        {
+            ts.tv_sec   = timeout / 1000;
+            ts.tv_nsec  = (timeout % 1000) * 1000000;
+            arg.ts      = (tb_uint64_t)(tb_size_t)&ts;
+        }
+        arg.sigmask_sz  = _NSIG / 8;
+
+        // wait one completion at least
+        min_complete    = 1;
+        flags           = IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG;
+    }
+
+    // update the waiting calls count
+    if (to_submit || min_complete) poller->wait_calls++;
+
+    // submit the pending requests and wait completions in one system call
+    if ((to_submit || min_complete) && tb_poller_io_uring_enter(poller, to_submit, min_complete, flags, flags? &arg : tb_null, flags? sizeof(arg) : 0) < 0)
+    {
+        // interrupted?(for gdb?) continue it
+        if (errno == EINTR) return 0;
+
+        // check error? ETIME: timeout, EBUSY: the completion queue is overflow, we need reap completions first
+        tb_assert_and_check_return_val(errno == ETIME || errno == EBUSY || errno == EAGAIN, -1);
+    }
+
+    // handle completions
+    tb_size_t                   wait = 0;
+    tb_bool_t                   killed = tb_false;
+    tb_socket_ref_t             pair = poller->pair[1];
+    tb_uint32_t                 head = *poller->cq_head;
+    tb_uint32_t                 tail = tb_poller_io_uring_load(poller->cq_tail);
+    for (; head != tail && !killed; head++)
+    {
+        // the completion entry
+        struct io_uring_cqe* cqe = &poller->cqes[head & poller->cq_mask];
+        tb_uint64_t user_data   = cqe->user_data;
+        tb_int_t    res         = cqe->res;
+        tb_uint32_t cflags      = cqe->flags;
+
+        // the io operation has been completed?
+        if (user_data & TB_POLLER_IO_URING_DATA_OP)
+        {
+            // save the result
+            tb_poller_op_ref_t op = (tb_poller_op_ref_t)(tb_size_t)(user_data & ~TB_POLLER_IO_URING_DATA_OP);
+            op->real = res >= 0? (tb_long_t)res : -1;
+
+            // update the pending io operations count
+            tb_poller_io_uring_entry_t* entry = tb_poller_io_uring_entry(poller, tb_poller_io_uring_op_fd(op), tb_false);
+            if (entry && entry->ops) entry->ops--;
+
+            // call event function, the operation may be freed in it
+            func(self, (tb_socket_ref_t)op->ref, TB_POLLER_EVENT_COMP, op);
+
+            // update the events count
+            wait++;
+            continue;
+        }
+
+        // skip the completions of the internal requests
+        tb_check_continue(!(user_data & TB_POLLER_IO_URING_DATA_SKIP));
+
+        // the socket entry, skip the completions of the stale requests
+        tb_long_t                   fd = tb_poller_io_uring_data_fd(user_data);
+        tb_poller_io_uring_entry_t* entry = tb_poller_io_uring_entry(poller, fd, tb_false);
+        tb_check_continue(entry && entry->events && tb_poller_io_uring_data(fd, entry->seq) == user_data);
+
+        // the poll request has been finished? it need be re-armed
+        if (!(cflags & IORING_CQE_F_MORE)) entry->armed = 0;
+
+        // init events
+        tb_size_t events = TB_POLLER_EVENT_NONE;
+        if (res >= 0)
+        {
+            if (res & POLLIN) events |= TB_POLLER_EVENT_RECV;
+            if (res & POLLOUT) events |= TB_POLLER_EVENT_SEND;
+            if ((res & (POLLHUP | POLLERR)) && !(events & (TB_POLLER_EVENT_RECV | TB_POLLER_EVENT_SEND))) 
+                events |= TB_POLLER_EVENT_RECV | TB_POLLER_EVENT_SEND;
+        }
+        // failed? notify it and the caller will get the error from recv/send
+        else events |= TB_POLLER_EVENT_RECV | TB_POLLER_EVENT_SEND;
+
+        // the socket
+        tb_socket_ref_t sock = tb_fd2sock(fd);
+
+        // spak?
+        if (sock == pair)
+        {
+            // read spak
+            tb_char_t spak = '\0';
+            if ((events & TB_POLLER_EVENT_RECV) && 1 != tb_socket_recv(pair, (tb_byte_t*)&spak, 1)) 
+                killed = tb_true;
+
+            // killed?
+            if (spak == 'k') killed = tb_true;
+        }
+        else 
+        {
+            // call event function
+            func(self, sock, events, entry->priv);
+
+            // update the events count
+            wait++;
+
+            // get the socket entry again, it may be modified or removed in the event function
+            entry = tb_poller_io_uring_entry(poller, fd, tb_false);
+            tb_check_continue(entry && entry->events && tb_poller_io_uring_data(fd, entry->seq) == user_data);
+        }
+
+        // re-arm the poll request for the level trigger, it will be submitted in the next wait()
+        if (!entry->armed && !(entry->events & TB_POLLER_EVENT_ONESHOT) && res >= 0)
+            tb_poller_io_uring_poll_add(poller, fd, entry);
+    }
+
+    // update the completion queue head
+    tb_poller_io_uring_store(poller->cq_head, head);
+
+    // ok?
+    return killed? -1 : wait;
+}
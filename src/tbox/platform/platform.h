@@ -62,6 +62,7 @@
 #include "environment.h"
 #include "thread_pool.h"
 #include "thread_local.h"
+#include "virtual_memory.h"
 #ifdef TB_CONFIG_API_HAVE_DEPRECATED
 #   include "deprecated/deprecated.h"
 #endif
@@ -23,6 +23,12 @@
  * @ingroup     platform
  */
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME                "poller"
+#define TB_TRACE_MODULE_DEBUG               (0)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * includes
  */
@@ -35,7 +41,7 @@
 #   include "posix/poller_select.c"
 #elif defined(TB_CONFIG_POSIX_HAVE_EPOLL_CREATE) \
     && defined(TB_CONFIG_POSIX_HAVE_EPOLL_WAIT)
-#   include "linux/poller_epoll.c"
+#   include "linux/poller.c"
 #elif defined(TB_CONFIG_OS_MACOSX)
 #   include "mach/poller_kqueue.c"
 #elif defined(TB_CONFIG_POSIX_HAVE_POLL) \
@@ -96,4 +102,37 @@ tb_long_t tb_poller_wait(tb_poller_ref_t poller, tb_poller_event_func_t func, tb
     return 0;
 }
 #endif
+#ifndef TB_POLLER_HAVE_POST
+tb_bool_t tb_poller_post(tb_poller_ref_t poller, tb_poller_op_ref_t op)
+{
+    // the completion-based io operations are not supported
+    return tb_false;
+}
+tb_bool_t tb_poller_post_cancel(tb_poller_ref_t poller, tb_poller_op_ref_t op)
+{
+    // the completion-based io operations are not supported
+    return tb_false;
+}
+tb_void_t tb_poller_cancel(tb_poller_ref_t poller, tb_socket_ref_t sock)
+{
+    // the closed socket will be removed automatically or it need be removed by the user
+}
+#endif
+#ifndef TB_POLLER_HAVE_STAT
+tb_bool_t tb_poller_stat(tb_poller_ref_t poller, tb_poller_stat_t* stat)
+{
+    // check
+    tb_assert_and_check_return_val(stat, tb_false);
+
+    // the statistics are not supported
+    tb_memset(stat, 0, sizeof(tb_poller_stat_t));
+    return tb_false;
+}
+#endif
+#if defined(__tb_debug__) && !defined(TB_POLLER_HAVE_DUMP)
+tb_void_t tb_poller_dump(tb_poller_ref_t poller)
+{
+    tb_trace_noimpl();
+}
+#endif
 
@@ -55,6 +55,12 @@ typedef enum __tb_poller_event_e
 ,   TB_POLLER_EVENT_CLEAR       = 0x0010 //!< edge trigger. after the event is retrieved by the user, its state is reset
 ,   TB_POLLER_EVENT_ONESHOT     = 0x0020 //!< causes the event to return only the first occurrence of the filter being triggered
 
+    /*! the completion of the posted io operation, see tb_poller_post()
+     *
+     * it is also used to check whether the completion-based io operations are supported by tb_poller_support()
+     */
+,   TB_POLLER_EVENT_COMP        = 0x0040
+
     /*! the event flag will be marked if the connection be closed in the edge trigger (TB_POLLER_EVENT_CLEAR)
      *
      * be similar to epoll.EPOLLRDHUP and kqueue.EV_EOF
@@ -63,6 +69,63 @@ typedef enum __tb_poller_event_e
 
 }tb_poller_event_e;
 
+/// the poller io operation code enum
+typedef enum __tb_poller_op_code_e
+{
+    TB_POLLER_OP_CODE_NONE      = 0
+,   TB_POLLER_OP_CODE_RECV      = 1 //!< recv data from the socket
+,   TB_POLLER_OP_CODE_SEND      = 2 //!< send data to the socket
+,   TB_POLLER_OP_CODE_READ      = 3 //!< read data from the file at the given offset
+,   TB_POLLER_OP_CODE_WRITE     = 4 //!< write data to the file at the given offset
+
+}tb_poller_op_code_e;
+
+/*! the poller io operation type
+ *
+ * it will be completed in tb_poller_wait(), the data buffer and this operation need be kept until it is completed.
+ */
+typedef struct __tb_poller_op_t
+{
+    /// the operation code
+    tb_size_t               code;
+
+    /// the socket or file
+    tb_handle_t             ref;
+
+    /// the data buffer
+    tb_byte_t*              data;
+
+    /// the data size
+    tb_size_t               size;
+
+    /// the file offset, only for reading and writing file
+    tb_hize_t               offset;
+
+    /// the result after completion, >= 0: the real size (0: closed for recv or end of file for read), -1: failed or cancelled
+    tb_long_t               real;
+
+    /// the user private data
+    tb_cpointer_t           priv;
+
+}tb_poller_op_t, *tb_poller_op_ref_t;
+
+/// the poller statistics type
+typedef struct __tb_poller_stat_t
+{
+    /// the insert, remove, modify and post requests count
+    tb_size_t               requests;
+
+    /*! the system calls count for applying these requests, e.g. epoll_ctl
+     *
+     * the requests are coalesced and applied in batches, so (requests - ctl_calls) system calls have been avoided
+     */
+    tb_size_t               ctl_calls;
+
+    /// the system calls count for waiting events, e.g. epoll_wait
+    tb_size_t               wait_calls;
+
+}tb_poller_stat_t;
+
 /// the poller ref type
 typedef __tb_typeref__(poller);
 
@@ -71,7 +134,7 @@ typedef __tb_typeref__(poller);
  * @param poller    the poller
  * @param sock      the socket
  * @param events    the poller events
- * @param priv      the user private data for this socket
+ * @param priv      the user private data for this socket, it is the completed io operation if events is TB_POLLER_EVENT_COMP
  */
 typedef tb_void_t   (*tb_poller_event_func_t)(tb_poller_ref_t poller, tb_socket_ref_t sock, tb_size_t events, tb_cpointer_t priv);
 
@@ -159,7 +222,44 @@ tb_bool_t           tb_poller_remove(tb_poller_ref_t poller, tb_socket_ref_t soc
  */
 tb_bool_t           tb_poller_modify(tb_poller_ref_t poller, tb_socket_ref_t sock, tb_size_t events, tb_cpointer_t priv);
 
+/*! post an io operation, it will be completed in tb_poller_wait()
+ *
+ * the event function will be called with TB_POLLER_EVENT_COMP and this operation after it has been completed,
+ * it is only supported by the completion-based poller (e.g. io_uring), see tb_poller_support(poller, TB_POLLER_EVENT_COMP)
+ *
+ * @param poller    the poller
+ * @param op        the io operation
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_poller_post(tb_poller_ref_t poller, tb_poller_op_ref_t op);
+
+/*! cancel the posted io operation
+ *
+ * it will be still completed in tb_poller_wait() and the result will be -1 if it has been cancelled
+ *
+ * @param poller    the poller
+ * @param op        the posted io operation
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_poller_post_cancel(tb_poller_ref_t poller, tb_poller_op_ref_t op);
+
+/*! cancel all pending requests of the given socket in kernel before closing it
+ *
+ * the completion-based poller (e.g. io_uring) keeps the socket open until all pending requests of it are finished,
+ * so we need cancel them if this socket will be closed without removing it, just like epoll removes the closed socket automatically.
+ * the waited events of this socket are still kept and the posted io operations will be completed with -1.
+ *
+ * @param poller    the poller
+ * @param sock      the socket
+ */
+tb_void_t           tb_poller_cancel(tb_poller_ref_t poller, tb_socket_ref_t sock);
+
 /*! wait all sockets
+ *
+ * @note the inserted, removed and modified sockets may be applied in batches before waiting,
+ * so all interfaces except spak and kill must be called in the same thread
  *
  * @param poller    the poller
  * @param func      the events function
@@ -169,6 +269,23 @@ tb_bool_t           tb_poller_modify(tb_poller_ref_t poller, tb_socket_ref_t soc
  */
 tb_long_t           tb_poller_wait(tb_poller_ref_t poller, tb_poller_event_func_t func, tb_long_t timeout);
 
+/*! get the poller statistics, e.g. the system calls count
+ *
+ * @param poller    the poller
+ * @param stat      the statistics
+ *
+ * @return          tb_true or tb_false (not supported)
+ */
+tb_bool_t           tb_poller_stat(tb_poller_ref_t poller, tb_poller_stat_t* stat);
+
+#ifdef __tb_debug__
+/*! dump the poller statistics, e.g. the system calls count
+ *
+ * @param poller    the poller
+ */
+tb_void_t           tb_poller_dump(tb_poller_ref_t poller);
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
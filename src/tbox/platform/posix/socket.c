@@ -72,6 +72,10 @@ tb_socket_ref_t tb_socket_init(tb_size_t type, tb_size_t family)
     // check
     tb_assert_and_check_return_val(type, tb_null);
     
+    // close it on exec()?
+    tb_bool_t cloexec = (type & TB_SOCKET_TYPE_CLOEXEC)? tb_true : tb_false;
+    type &= ~TB_SOCKET_TYPE_CLOEXEC;
+
     // done
     tb_socket_ref_t sock = tb_null;
     do
@@ -94,6 +98,11 @@ tb_socket_ref_t tb_socket_init(tb_size_t type, tb_size_t family)
         // init socket family
         tb_int_t f = (family == TB_IPADDR_FAMILY_IPV6)? AF_INET6 : AF_INET;
 
+#if defined(SOCK_NONBLOCK) && defined(SOCK_CLOEXEC)
+        // sock, set non-block and close-on-exec mode directly
+        tb_int_t fd = socket(f, t | SOCK_NONBLOCK | (cloexec? SOCK_CLOEXEC : 0), p);
+        tb_assert_and_check_break(fd >= 0);
+#else
         // sock
         tb_int_t fd = socket(f, t, p);
         tb_assert_and_check_break(fd >= 0);
@@ -101,6 +110,10 @@ tb_socket_ref_t tb_socket_init(tb_size_t type, tb_size_t family)
         // set non-block mode
         fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
 
+        // set close-on-exec mode
+        if (cloexec) fcntl(fd, F_SETFD, fcntl(fd, F_GETFD) | FD_CLOEXEC);
+#endif
+
         // save socket
         sock = tb_fd2sock(fd);
 
@@ -389,7 +402,14 @@ tb_socket_ref_t tb_socket_accept(tb_socket_ref_t sock, tb_ipaddr_ref_t addr)
 
     // done  
     struct sockaddr_storage d = {0};
-    socklen_t               n = sizeof(struct sockaddr_in);
+    socklen_t               n = sizeof(d);
+#ifdef TB_CONFIG_POSIX_HAVE_ACCEPT4
+    // accept it and set non-block mode in one syscall
+    tb_long_t               fd = accept4(tb_sock2fd(sock), (struct sockaddr *)&d, &n, SOCK_NONBLOCK);
+
+    // no client?
+    tb_check_return_val(fd > 0, tb_null);
+#else
     tb_long_t               fd = accept(tb_sock2fd(sock), (struct sockaddr *)&d, &n);
 
     // no client?
@@ -397,6 +417,7 @@ tb_socket_ref_t tb_socket_accept(tb_socket_ref_t sock, tb_ipaddr_ref_t addr)
 
     // non-block
     fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+#endif
 
 #ifdef TB_CONFIG_OS_LINUX
     /* disable the nagle's algorithm to fix 40ms ack delay in some case (.e.g send-send-40ms-recv)
@@ -417,7 +438,7 @@ tb_socket_ref_t tb_socket_accept(tb_socket_ref_t sock, tb_ipaddr_ref_t addr)
      * 
      * so we set TCP_NODELAY to reduce response delay for the accepted socket in the server by default
      */
-    tb_socket_ctrl(sock, TB_SOCKET_CTRL_SET_TCP_NODELAY, tb_true);
+    tb_socket_ctrl(tb_fd2sock(fd), TB_SOCKET_CTRL_SET_TCP_NODELAY, tb_true);
 #endif
 
     // save address
@@ -0,0 +1,223 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        virtual_memory.c
+ * @ingroup     platform
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../atomic.h"
+#include "../../libc/libc.h"
+#include <sys/mman.h>
+#ifdef TB_CONFIG_OS_LINUX
+#   include <fcntl.h>
+#   include <unistd.h>
+#endif
+#ifdef TB_CONFIG_POSIX_HAVE_MBIND
+#   include <sys/syscall.h>
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// for macosx
+#if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+#   define MAP_ANONYMOUS    MAP_ANON
+#endif
+
+// the default huge page size
+#if defined(TB_ARCH_x86) || defined(TB_ARCH_x64) || defined(TB_ARCH_ARM64)
+#   define TB_VIRTUAL_MEMORY_HUGE_PAGE_SIZE_DEFAULT     (2 * 1024 * 1024)
+#else
+#   define TB_VIRTUAL_MEMORY_HUGE_PAGE_SIZE_DEFAULT     (0)
+#endif
+
+// the numa policy for mbind
+#ifndef MPOL_BIND
+#   define MPOL_BIND        (2)
+#endif
+
+// the max numa nodes count for mbind
+#define TB_VIRTUAL_MEMORY_NODE_MAXN                     (1024)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the huge page size, -1: not inited
+static tb_atomic_t          g_huge_page_size = -1;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_size_t tb_virtual_memory_huge_page_size_load()
+{
+#if defined(TB_CONFIG_OS_LINUX) && defined(MAP_HUGETLB)
+    // read the huge page size from /proc/meminfo, .e.g "Hugepagesize:       2048 kB"
+    tb_size_t size = 0;
+    tb_int_t  fd = open("/proc/meminfo", O_RDONLY);
+    if (fd >= 0)
+    {
+        // read it
+        tb_char_t   data[4096];
+        tb_long_t   real = read(fd, data, sizeof(data) - 1);
+        if (real > 0)
+        {
+            // find the huge page size
+            data[real] = '\0';
+            tb_char_t const* p = tb_strstr(data, "Hugepagesize:");
+            if (p) size = tb_s10tou32(p + 13) * 1024;
+        }
+
+        // exit it
+        close(fd);
+    }
+
+    // uses the default size if the transparent huge pages are enabled only
+    return size? size : TB_VIRTUAL_MEMORY_HUGE_PAGE_SIZE_DEFAULT;
+#else
+    // not supported
+    return 0;
+#endif
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_pointer_t tb_virtual_memory_malloc(tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(size, tb_null);
+
+    // map the anonymous pages
+    tb_pointer_t data = mmap(tb_null, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    // ok?
+    return data != MAP_FAILED? data : tb_null;
+}
+tb_bool_t tb_virtual_memory_free(tb_pointer_t data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(data && size, tb_false);
+
+    // unmap it
+    return !munmap(data, size);
+}
+tb_bool_t tb_virtual_memory_protect(tb_pointer_t data, tb_size_t size, tb_size_t prot)
+{
+    // check
+    tb_assert_and_check_return_val(data && size, tb_false);
+
+    // init protection
+    tb_int_t flags = PROT_NONE;
+    if (prot & TB_VIRTUAL_MEMORY_PROT_READ) flags |= PROT_READ;
+    if ((prot & TB_VIRTUAL_MEMORY_PROT_RW) == TB_VIRTUAL_MEMORY_PROT_RW) flags |= PROT_WRITE;
+
+    // protect it
+    return !mprotect(data, size, flags);
+}
+tb_bool_t tb_virtual_memory_reset(tb_pointer_t data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(data && size, tb_false);
+
+    // discard the physical pages
+#if defined(TB_CONFIG_POSIX_HAVE_MADVISE) && defined(MADV_DONTNEED)
+    return !madvise(data, size, MADV_DONTNEED);
+#else
+    return tb_true;
+#endif
+}
+tb_size_t tb_virtual_memory_huge_page_size()
+{
+    // get the cached huge page size
+    tb_long_t size = (tb_long_t)tb_atomic_get(&g_huge_page_size);
+    if (size < 0)
+    {
+        // load and cache it
+        size = (tb_long_t)tb_virtual_memory_huge_page_size_load();
+        tb_atomic_set(&g_huge_page_size, size);
+    }
+
+    // ok
+    return (tb_size_t)size;
+}
+tb_pointer_t tb_virtual_memory_malloc_huge(tb_size_t size, tb_size_t* mode)
+{
+    // check
+    tb_assert_and_check_return_val(size, tb_null);
+
+    // init mode
+    if (mode) *mode = TB_VIRTUAL_MEMORY_HUGE_NONE;
+
+    // not supported? only uses the normal pages
+    tb_size_t huge_size = tb_virtual_memory_huge_page_size();
+    tb_check_return_val(huge_size && !(size & (huge_size - 1)), tb_virtual_memory_malloc(size));
+
+#ifdef MAP_HUGETLB
+    // map the reserved huge pages first, it will be failed if no free huge pages
+    tb_pointer_t data = mmap(tb_null, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (data != MAP_FAILED)
+    {
+        if (mode) *mode = TB_VIRTUAL_MEMORY_HUGE_EXPLICIT;
+        return data;
+    }
+#endif
+
+    // map more pages for aligning the data address by the huge page size
+    tb_byte_t* base = (tb_byte_t*)mmap(tb_null, size + huge_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    tb_check_return_val(base != MAP_FAILED, tb_null);
+
+    // unmap the unaligned head and tail pages
+    tb_byte_t* aligned = (tb_byte_t*)tb_align((tb_size_t)base, huge_size);
+    if (aligned > base) munmap(base, aligned - base);
+    if (base + huge_size > aligned) munmap(aligned + size, base + huge_size - aligned);
+
+    // advise the transparent huge pages
+#if defined(TB_CONFIG_POSIX_HAVE_MADVISE) && defined(MADV_HUGEPAGE)
+    if (!madvise(aligned, size, MADV_HUGEPAGE) && mode) *mode = TB_VIRTUAL_MEMORY_HUGE_ADVISED;
+#endif
+
+    // ok
+    return aligned;
+}
+tb_bool_t tb_virtual_memory_bind(tb_pointer_t data, tb_size_t size, tb_size_t node)
+{
+    // check
+    tb_assert_and_check_return_val(data && size && node < TB_VIRTUAL_MEMORY_NODE_MAXN, tb_false);
+
+#ifdef TB_CONFIG_POSIX_HAVE_MBIND
+    // init the node mask
+    tb_ulong_t mask[TB_VIRTUAL_MEMORY_NODE_MAXN / (sizeof(tb_ulong_t) << 3)] = {0};
+    mask[node / (sizeof(tb_ulong_t) << 3)] = (tb_ulong_t)1 << (node % (sizeof(tb_ulong_t) << 3));
+
+    // bind it, the kernel will decrease the max node count first
+    return !syscall(SYS_mbind, data, size, MPOL_BIND, mask, TB_VIRTUAL_MEMORY_NODE_MAXN + 1, 0);
+#else
+    // not supported
+    return tb_false;
+#endif
+}
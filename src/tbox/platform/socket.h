@@ -48,6 +48,9 @@ typedef enum __tb_socket_type_e
 ,   TB_SOCKET_TYPE_TCP                  = 1
 ,   TB_SOCKET_TYPE_UDP                  = 2
 
+    /// the type flag: close this socket on exec(), .e.g TB_SOCKET_TYPE_TCP | TB_SOCKET_TYPE_CLOEXEC
+,   TB_SOCKET_TYPE_CLOEXEC              = 0x0100
+
 }tb_socket_type_e;
 
 /// the socket kill enum
@@ -91,7 +94,10 @@ typedef enum __tb_socket_event_e
 
 /*! init socket
  *
- * @param type      the socket type
+ * the socket is non-blocking and will be inherited by the child process of exec() by default,
+ * we can pass TB_SOCKET_TYPE_CLOEXEC with the type to close it on exec()
+ *
+ * @param type      the socket type, .e.g TB_SOCKET_TYPE_TCP or TB_SOCKET_TYPE_TCP | TB_SOCKET_TYPE_CLOEXEC
  * @param family    the address family, default: ipv4
  *
  * @return          the socket 
@@ -135,6 +141,9 @@ tb_long_t           tb_socket_connect(tb_socket_ref_t sock, tb_ipaddr_ref_t addr
  *
  * you can call tb_socket_local for the bound address
  *
+ * @note SO_REUSEADDR is always enabled and SO_REUSEPORT is enabled for the non-zero port if supported,
+ * so multiple sockets can listen the same port, e.g. tb_co_scheduler_group_listen()
+ *
  * @param sock      the socket 
  * @param addr      the address
  *                  - bind any port if port == 0
@@ -31,7 +31,25 @@
 #include "time.h"
 #include "thread_local.h"
 #include "../utils/utils.h"
+#include "impl/thread.h"
 #include "impl/thread_local.h"
+#if !defined(TB_CONFIG_MICRO_ENABLE) && \
+    defined(TB_CONFIG_POSIX_HAVE_PTHREAD_KEY_CREATE) && \
+    defined(TB_CONFIG_POSIX_HAVE_PTHREAD_SETSPECIFIC) && \
+    defined(TB_CONFIG_POSIX_HAVE_PTHREAD_GETSPECIFIC)
+#   include <pthread.h>
+#   define TB_THREAD_EXIT_KEY_ENABLE
+#endif
+#if !defined(TB_CONFIG_MICRO_ENABLE) && defined(__tb_thread_local__)
+#   define TB_THREAD_EXIT_FUNC_ENABLE
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the exit functions maxn of each thread
+#define TB_THREAD_EXIT_FUNC_MAXN        (8)
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
@@ -45,12 +63,51 @@ typedef tb_pointer_t    tb_thread_retval_t;
 #endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
- * declaration
+ * globals
  */
+#ifdef TB_THREAD_EXIT_KEY_ENABLE
+
+// the thread exit key for the threads not created by tb_thread_init()
+static pthread_key_t    g_thread_exit_key;
+
+// the once lock of the thread exit key
+static tb_atomic_t      g_thread_exit_key_once = 0;
+#endif
+
+#ifdef TB_THREAD_EXIT_FUNC_ENABLE
+
+// the exit functions of the current thread
+static __tb_thread_local__ tb_thread_exit_func_t    g_thread_exit_funcs[TB_THREAD_EXIT_FUNC_MAXN];
+
+// the exit functions count of the current thread
+static __tb_thread_local__ tb_size_t                g_thread_exit_funcs_count = 0;
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
+static tb_void_t tb_thread_exit_funcs_done()
+{
+#ifdef TB_THREAD_EXIT_FUNC_ENABLE
+    // call the exit functions in the reverse order, they may attach new exit functions
+    while (g_thread_exit_funcs_count)
+    {
+        tb_thread_exit_func_t func = g_thread_exit_funcs[--g_thread_exit_funcs_count];
+        if (func) func();
+    }
+#endif
+}
+#ifdef TB_THREAD_EXIT_KEY_ENABLE
+static tb_void_t tb_thread_exit_key_free(tb_pointer_t priv)
+{
+    // the foreign thread is exiting, call its exit functions
+    tb_thread_exit_funcs_done();
+}
+static tb_bool_t tb_thread_exit_key_init(tb_cpointer_t priv)
+{
+    return pthread_key_create(&g_thread_exit_key, tb_thread_exit_key_free) == 0;
+}
+#endif
 #ifndef TB_CONFIG_MICRO_ENABLE
 static tb_bool_t tb_thread_local_free(tb_iterator_ref_t iterator, tb_pointer_t item, tb_cpointer_t priv)
 {
@@ -103,10 +160,50 @@ static tb_thread_retval_t tb_thread_func(tb_pointer_t priv)
     if (args) tb_free(args);
     args = tb_null;
 
+    // call the exit functions of the current thread
+    tb_thread_exit_funcs_done();
+
     // return the return value
     return retval;
 }
 
+tb_bool_t tb_thread_exit_attach(tb_thread_exit_func_t func)
+{
+    // check
+    tb_assert_and_check_return_val(func, tb_false);
+
+#ifdef TB_THREAD_EXIT_FUNC_ENABLE
+    // have been attached?
+    tb_size_t i = 0;
+    tb_size_t n = g_thread_exit_funcs_count;
+    for (i = 0; i < n; i++)
+    {
+        if (g_thread_exit_funcs[i] == func) return tb_true;
+    }
+
+    // no more free slots?
+    tb_assertf(n < TB_THREAD_EXIT_FUNC_MAXN, "too many thread exit functions!");
+    tb_check_return_val(n < TB_THREAD_EXIT_FUNC_MAXN, tb_false);
+
+#   ifdef TB_THREAD_EXIT_KEY_ENABLE
+    /* attach the thread exit key
+     *
+     * the threads created by tb_thread_init() call the exit functions in tb_thread_func(), 
+     * but the foreign threads will only be notified by the destructor of the thread exit key.
+     */
+    if (!tb_thread_once(&g_thread_exit_key_once, tb_thread_exit_key_init, tb_null)) return tb_false;
+    if (!pthread_getspecific(g_thread_exit_key)) pthread_setspecific(g_thread_exit_key, (tb_pointer_t)tb_true);
+#   endif
+
+    // attach it
+    g_thread_exit_funcs[n] = func;
+    g_thread_exit_funcs_count = n + 1;
+    return tb_true;
+#else
+    return tb_false;
+#endif
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
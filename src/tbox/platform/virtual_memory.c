@@ -0,0 +1,76 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        virtual_memory.c
+ * @ingroup     platform
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "virtual_memory.h"
+#include "memory.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+#ifdef TB_CONFIG_OS_WINDOWS
+#   include "windows/virtual_memory.c"
+#elif defined(TB_CONFIG_POSIX_HAVE_MMAP)
+#   include "posix/virtual_memory.c"
+#else
+tb_pointer_t tb_virtual_memory_malloc(tb_size_t size)
+{
+    // only uses the native memory, it is not page-aligned and cannot be protected
+    return tb_native_memory_malloc(size);
+}
+tb_bool_t tb_virtual_memory_free(tb_pointer_t data, tb_size_t size)
+{
+    return tb_native_memory_free(data);
+}
+tb_bool_t tb_virtual_memory_protect(tb_pointer_t data, tb_size_t size, tb_size_t prot)
+{
+    // not supported
+    return tb_false;
+}
+tb_bool_t tb_virtual_memory_reset(tb_pointer_t data, tb_size_t size)
+{
+    // do nothing
+    return tb_true;
+}
+tb_size_t tb_virtual_memory_huge_page_size()
+{
+    // not supported
+    return 0;
+}
+tb_pointer_t tb_virtual_memory_malloc_huge(tb_size_t size, tb_size_t* mode)
+{
+    // only uses the normal pages
+    if (mode) *mode = TB_VIRTUAL_MEMORY_HUGE_NONE;
+    return tb_virtual_memory_malloc(size);
+}
+tb_bool_t tb_virtual_memory_bind(tb_pointer_t data, tb_size_t size, tb_size_t node)
+{
+    // not supported
+    return tb_false;
+}
+#endif
@@ -0,0 +1,142 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        virtual_memory.h
+ * @ingroup     platform
+ *
+ */
+#ifndef TB_PLATFORM_VIRTUAL_MEMORY_H
+#define TB_PLATFORM_VIRTUAL_MEMORY_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the virtual memory protection enum
+typedef enum __tb_virtual_memory_prot_e
+{
+    TB_VIRTUAL_MEMORY_PROT_NONE     = 0     //!< no access, .e.g the guard page
+,   TB_VIRTUAL_MEMORY_PROT_READ     = 1     //!< readonly
+,   TB_VIRTUAL_MEMORY_PROT_RW       = 3     //!< read and write
+
+}tb_virtual_memory_prot_e;
+
+/// the huge page mode enum of the virtual memory
+typedef enum __tb_virtual_memory_huge_e
+{
+    TB_VIRTUAL_MEMORY_HUGE_NONE     = 0     //!< only the normal pages
+,   TB_VIRTUAL_MEMORY_HUGE_EXPLICIT = 1     //!< the reserved huge pages, .e.g MAP_HUGETLB
+,   TB_VIRTUAL_MEMORY_HUGE_ADVISED  = 2     //!< the transparent huge pages have been advised, .e.g MADV_HUGEPAGE, but the kernel may not use them
+
+}tb_virtual_memory_huge_e;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! malloc the page-aligned virtual memory with read and write access
+ *
+ * the physical pages will be committed lazily when they are accessed at the first time
+ *
+ * @param size          the size, must be aligned by the page size
+ *
+ * @return              the data address
+ */
+tb_pointer_t            tb_virtual_memory_malloc(tb_size_t size);
+
+/*! free the virtual memory
+ *
+ * @param data          the data address
+ * @param size          the size
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_virtual_memory_free(tb_pointer_t data, tb_size_t size);
+
+/*! change the access protection of the virtual memory pages
+ *
+ * @param data          the page-aligned data address
+ * @param size          the size
+ * @param prot          the protection, .e.g TB_VIRTUAL_MEMORY_PROT_NONE for the guard page
+ *
+ * @return              tb_true or tb_false, return tb_false if not be supported
+ */
+tb_bool_t               tb_virtual_memory_protect(tb_pointer_t data, tb_size_t size, tb_size_t prot);
+
+/*! reset the virtual memory pages and return the physical pages to the system
+ *
+ * the address range is still valid and the pages will be committed again lazily,
+ * but their contents will be lost
+ *
+ * @param data          the page-aligned data address
+ * @param size          the size
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_virtual_memory_reset(tb_pointer_t data, tb_size_t size);
+
+/*! get the huge page size
+ *
+ * @return              the huge page size, return zero if huge pages are not supported
+ */
+tb_size_t               tb_virtual_memory_huge_page_size(tb_noarg_t);
+
+/*! malloc the virtual memory on the huge pages
+ *
+ * it uses the reserved huge pages first, 
+ * and falls back to the normal pages aligned by the huge page size and advises the transparent huge pages.
+ *
+ * @param size          the size, must be aligned by the huge page size
+ * @param mode          return the huge page mode of the data, optional
+ *
+ * @return              the data address, it need be freed by tb_virtual_memory_free()
+ */
+tb_pointer_t            tb_virtual_memory_malloc_huge(tb_size_t size, tb_size_t* mode);
+
+/*! bind the virtual memory pages to the given numa node
+ *
+ * the pages which have not been accessed will be allocated from this node only,
+ * so it should be called before accessing the data at the first time.
+ *
+ * @param data          the page-aligned data address
+ * @param size          the size
+ * @param node          the numa node index
+ *
+ * @return              tb_true or tb_false, return tb_false if not be supported
+ */
+tb_bool_t               tb_virtual_memory_bind(tb_pointer_t data, tb_size_t size, tb_size_t node);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
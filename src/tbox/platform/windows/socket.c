@@ -103,6 +103,9 @@ tb_socket_ref_t tb_socket_init(tb_size_t type, tb_size_t family)
 {
     // check
     tb_assert_and_check_return_val(type, tb_null);
+
+    // the socket will not be inherited by the child process without bInheritHandles, so ignore the close-on-exec flag
+    type &= ~TB_SOCKET_TYPE_CLOEXEC;
     
     // done
     tb_socket_ref_t sock = tb_null;
@@ -0,0 +1,90 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2017, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        virtual_memory.c
+ * @ingroup     platform
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_pointer_t tb_virtual_memory_malloc(tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(size, tb_null);
+
+    // reserve and commit pages, the physical pages will be allocated lazily
+    return (tb_pointer_t)VirtualAlloc(tb_null, (SIZE_T)size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+}
+tb_bool_t tb_virtual_memory_free(tb_pointer_t data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(data && size, tb_false);
+
+    // release it
+    return VirtualFree((LPVOID)data, 0, MEM_RELEASE)? tb_true : tb_false;
+}
+tb_bool_t tb_virtual_memory_protect(tb_pointer_t data, tb_size_t size, tb_size_t prot)
+{
+    // check
+    tb_assert_and_check_return_val(data && size, tb_false);
+
+    // init protection
+    DWORD flags = PAGE_NOACCESS;
+    if ((prot & TB_VIRTUAL_MEMORY_PROT_RW) == TB_VIRTUAL_MEMORY_PROT_RW) flags = PAGE_READWRITE;
+    else if (prot & TB_VIRTUAL_MEMORY_PROT_READ) flags = PAGE_READONLY;
+
+    // protect it
+    DWORD oldflags = 0;
+    return VirtualProtect((LPVOID)data, (SIZE_T)size, flags, &oldflags)? tb_true : tb_false;
+}
+tb_bool_t tb_virtual_memory_reset(tb_pointer_t data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(data && size, tb_false);
+
+    // discard the physical pages
+    return VirtualAlloc((LPVOID)data, (SIZE_T)size, MEM_RESET, PAGE_READWRITE)? tb_true : tb_false;
+}
+tb_size_t tb_virtual_memory_huge_page_size()
+{
+    /* the large pages need the SeLockMemoryPrivilege and cannot be released to the system partially,
+     * so we do not use them now
+     */
+    return 0;
+}
+tb_pointer_t tb_virtual_memory_malloc_huge(tb_size_t size, tb_size_t* mode)
+{
+    // only uses the normal pages
+    if (mode) *mode = TB_VIRTUAL_MEMORY_HUGE_NONE;
+    return tb_virtual_memory_malloc(size);
+}
+tb_bool_t tb_virtual_memory_bind(tb_pointer_t data, tb_size_t size, tb_size_t node)
+{
+    // not supported, VirtualAllocExNuma can only select the node when allocating
+    return tb_false;
+}
@@ -655,8 +655,9 @@ tb_bool_t tb_stream_clos(tb_stream_ref_t self)
     stream->state = TB_STATE_OK;
     tb_atomic_set(&stream->istate, TB_STATE_CLOSED);
 
-    // clear cache
+    // clear cache and release it
     tb_queue_buffer_clear(&stream->cache);
+    tb_queue_buffer_idle(&stream->cache);
 
     // ok
     return tb_true;
@@ -817,6 +818,9 @@ tb_long_t tb_stream_read(tb_stream_ref_t self, tb_byte_t* data, tb_size_t size)
     }
     while (0);
 
+    // the read cache is null now? release it until the next reading
+    if (read > 0 && !stream->bwrited) tb_queue_buffer_idle(&stream->cache);
+
     // update offset
     stream->offset += read;
 
@@ -1031,6 +1035,9 @@ tb_bool_t tb_stream_sync(tb_stream_ref_t self, tb_bool_t bclosing)
                 // failed
                 return tb_false;
             }
+
+            // the writ cache is null now, release it until the next writing
+            tb_queue_buffer_idle(&stream->cache);
         }
         else stream->bwrited = 1;
     }
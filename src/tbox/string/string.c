@@ -45,12 +45,16 @@
  * implementation
  */
 tb_bool_t tb_string_init(tb_string_ref_t string)
+{
+    return tb_string_init_with_allocator(string, tb_null);
+}
+tb_bool_t tb_string_init_with_allocator(tb_string_ref_t string, tb_allocator_ref_t allocator)
 {
     // check
     tb_assert_and_check_return_val(string, tb_false);
 
     // init
-    tb_bool_t ok = tb_buffer_init(string);
+    tb_bool_t ok = tb_buffer_init_with_allocator(string, allocator);
 
     // clear it
     tb_string_clear(string);
@@ -89,8 +89,17 @@ typedef enum __tb_singleton_type_e
     /// the cookies type
 ,   TB_SINGLETON_TYPE_COOKIES               = 12
 
+    /// the coroutine stack pool type
+,   TB_SINGLETON_TYPE_CO_STACK_POOL         = 13
+
+    /// the io buffer pool type
+,   TB_SINGLETON_TYPE_IO_BUFFER_POOL        = 14
+
+    /// the string pool type
+,   TB_SINGLETON_TYPE_STRING_POOL           = 15
+
     /// the user defined type
-,   TB_SINGLETON_TYPE_USER                  = 13
+,   TB_SINGLETON_TYPE_USER                  = 16
 
 #endif
 
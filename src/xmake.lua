@@ -164,13 +164,17 @@ function check_interfaces()
     add_cfuncs("posix", nil,        "ifaddrs.h",                        "getifaddrs")
     add_cfuncs("posix", nil,        "semaphore.h",                      "sem_init")
     add_cfuncs("posix", nil,        "unistd.h",                         "getpagesize", "sysconf")
+    add_cfuncs("posix", nil,        "sys/mman.h",                       "mmap", "mprotect", "madvise")
+    add_cfuncs("posix", nil,        {"sys/syscall.h", "unistd.h"},      "mbind{syscall(SYS_mbind, 0, 0, 0, 0, 0, 0);}")
     add_cfuncs("posix", nil,        "sched.h",                          "sched_yield")
     add_cfuncs("posix", nil,        "regex.h",                          "regcomp", "regexec")
     add_cfuncs("posix", nil,        "sys/uio.h",                        "readv", "writev", "preadv", "pwritev")
     add_cfuncs("posix", nil,        "unistd.h",                         "pread64", "pwrite64")
     add_cfuncs("posix", nil,        "unistd.h",                         "fdatasync")
     add_cfuncs("posix", nil,        "sys/sendfile.h",                   "sendfile")
+    add_cfuncs("posix", nil,        "sys/socket.h",                     "accept4")
     add_cfuncs("posix", nil,        "sys/epoll.h",                      "epoll_create", "epoll_wait")
+    add_cfuncs("posix", nil,        {"linux/io_uring.h", "sys/syscall.h", "unistd.h"}, "io_uring_setup{struct io_uring_getevents_arg arg = {0}; syscall(__NR_io_uring_setup, 0, &arg);}")
     add_cfuncs("posix", nil,        "spawn.h",                          "posix_spawnp")
     add_cfuncs("posix", nil,        "unistd.h",                         "execvp", "execvpe", "fork", "vfork")
     add_cfuncs("posix", nil,        "sys/wait.h",                       "waitpid")